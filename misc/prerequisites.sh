@@ -4,6 +4,7 @@ PREFIX=/opt/ovenmediaengine
 TEMP_PATH=/tmp
 
 OME_VERSION=temp/alpine
+# kTLS (HttpsServer) needs OpenSSL 3.0+ built with enable-ktls, so it is compiled out with this version
 OPENSSL_VERSION=1.1.0g
 SRTP_VERSION=2.2.0
 SRT_VERSION=1.3.3
@@ -35,6 +35,8 @@ endif
 # Rules
 #===============================================================================
 BUILD_TARGET_LIST :=
+# Executables of projects/tests (built and run by "make tests" only)
+TEST_TARGET_LIST :=
 # File list to delete
 BUILD_FILES_TO_CLEAN :=
 
@@ -50,6 +52,7 @@ help:
 	@echo "   Commands:"
 	@echo "       $(ANSI_YELLOW)help$(ANSI_RESET): show this page"
 	@echo "       $(ANSI_YELLOW)release$(ANSI_RESET): make project to release"
+	@echo "       $(ANSI_YELLOW)tests$(ANSI_RESET): build and run the tests in projects/tests"
 	@echo ""
 
 # clean할 때 target이 삭제될 수 있도록 함
@@ -68,6 +71,15 @@ build_target_list: $(BUILD_TARGET_LIST)
 	@$(TARGET_COUNTER)
 	@echo $(CURRENT_PROGRESS)"$(CONFIG_COMPLETE_COLOR)Completed.$(ANSI_RESET)"$(INCREASE_COUNT)
 
+.PHONY: tests
+tests: directories_to_prepare $(TEST_TARGET_LIST)
+	@for test in $(TEST_TARGET_LIST); \
+	do \
+		echo "    $(CONFIG_BUILDING_COLOR)Running$(ANSI_RESET) $$test..."; \
+		$$test || exit 1; \
+	done
+	@echo "$(CONFIG_COMPLETE_COLOR)All tests are passed.$(ANSI_RESET)"
+
 .PHONY: directories_to_prepare
 directories_to_prepare:
 	@$(TARGET_COUNTER)
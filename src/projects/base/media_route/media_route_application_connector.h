@@ -62,6 +62,13 @@ public:
 		return ConnectorType::Provider;
 	}
 
+	// MediaRouteApplication -> Key frame is requested by the observers of the stream
+	// Returns false if the connector cannot generate a key frame on demand (e.g. the stream is just relayed)
+	virtual bool OnRequestKeyFrame(const std::shared_ptr<info::Stream> &stream)
+	{
+		return false;
+	}
+
 public:
 	// @see: media_router_application.cpp / MediaRouteApplication::RegisterConnectorApp
 	inline void SetMediaRouterApplication(const std::shared_ptr<MediaRouteApplicationInterface> &route_application)
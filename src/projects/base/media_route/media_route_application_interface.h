@@ -22,6 +22,9 @@ public:
 	virtual bool OnDeleteStream(const std::shared_ptr<MediaRouteApplicationConnector> &application, const std::shared_ptr<info::Stream> &stream) = 0;
 	virtual bool OnReceiveBuffer(const std::shared_ptr<MediaRouteApplicationConnector> &application, const std::shared_ptr<info::Stream> &stream, const std::shared_ptr<MediaPacket> &packet) = 0;
 
+	// Observer(Publisher/Transcoder) -> Connector(Transcoder/Provider) that creates the stream
+	virtual bool OnRequestKeyFrame(const std::shared_ptr<MediaRouteApplicationObserver> &application, const std::shared_ptr<info::Stream> &stream) = 0;
+
 	virtual const std::map<uint32_t, std::shared_ptr<MediaRouteStream>> GetStreams() const = 0;
 };
 
@@ -49,5 +49,32 @@ public:
 	{
 		return ObserverType::Publisher;
 	}
+
+	// MediaRouteApplication -> Ask the connector that creates the stream for a key frame
+	inline bool RequestKeyFrame(const std::shared_ptr<info::Stream> &stream)
+	{
+		if(GetMediaRouteApplication() == nullptr)
+		{
+			return false;
+		}
+
+		return GetMediaRouteApplication()->OnRequestKeyFrame(this->GetSharedPtr(), stream);
+	}
+
+public:
+	// @see: media_router_application.cpp / MediaRouteApplication::RegisterObserverApp
+	inline void SetMediaRouterApplication(const std::shared_ptr<MediaRouteApplicationInterface> &route_application)
+	{
+		_media_route_application = route_application;
+	}
+
+	inline std::shared_ptr<MediaRouteApplicationInterface> GetMediaRouteApplication()
+	{
+		return _media_route_application.lock();
+	}
+
+private:
+	// The observer does not own MediaRouteApplication (MediaRouteApplication owns the observers)
+	std::weak_ptr<MediaRouteApplicationInterface> _media_route_application;
 };
 
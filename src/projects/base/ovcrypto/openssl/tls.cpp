@@ -8,11 +8,18 @@
 //==============================================================================
 #include "tls.h"
 
+#include "tls_context.h"
+
+#include <poll.h>
+
 #include <utility>
 
 #define OV_LOG_TAG "OpenSSL"
 
 #define MAX_TLS_WRITE_SIZE (16 * 1024)
+// While accepting with kTLS, the handshake records are written to the socket directly,
+// so Accept() waits for the socket to be writable up to this time when the socket buffer is full
+#define TLS_KTLS_HANDSHAKE_WRITE_TIMEOUT (5 * 1000)
 #define DO_CALLBACK_IF_AVAILBLE(return_type, default_value, object, callback_name, ...) \
 	Tls::DoCallback<return_type, default_value, decltype(&TlsCallback::callback_name), &TlsCallback::callback_name>(object, ##__VA_ARGS__)
 
@@ -73,6 +80,35 @@ namespace ov
 		return result;
 	};
 
+	bool Tls::Initialize(const std::shared_ptr<TlsContext> &tls_context, TlsCallback callback)
+	{
+		if (tls_context == nullptr)
+		{
+			OV_ASSERT2(false);
+			return false;
+		}
+
+		OV_ASSERT(callback.verify_callback == nullptr, "verify_callback is not supported for the shared context");
+
+		bool result = true;
+
+		_callback = std::move(callback);
+		_tls_context = tls_context;
+
+		// Create BIO
+		result = result && PrepareBio();
+		// Create SSL (TlsContext::OnServerName() finds this instance using app data)
+		result = result && PrepareSsl(this);
+
+		if (result == false)
+		{
+			_callback = TlsCallback();
+			_tls_context = nullptr;
+		}
+
+		return result;
+	}
+
 	bool Tls::Uninitialize()
 	{
 		if (_ssl != nullptr)
@@ -83,6 +119,10 @@ namespace ov
 		_bio = nullptr;
 		_ssl = nullptr;
 		_ssl_ctx = nullptr;
+		_tls_context = nullptr;
+
+		_kernel_tls_socket = -1;
+		_is_kernel_tls_send_enabled = false;
 
 		return true;
 	}
@@ -266,11 +306,13 @@ namespace ov
 
 	bool Tls::PrepareSsl(void *app_data)
 	{
-		OV_ASSERT2(_ssl_ctx != nullptr);
+		OV_ASSERT2((_ssl_ctx != nullptr) || (_tls_context != nullptr));
 		OV_ASSERT2(_bio != nullptr);
 
+		SSL_CTX *ssl_ctx = (_tls_context != nullptr) ? _tls_context->GetSslContext() : static_cast<SSL_CTX *>(_ssl_ctx);
+
 		// SSL 세션 생성
-		decltype(_ssl) ssl(::SSL_new(_ssl_ctx));
+		decltype(_ssl) ssl(::SSL_new(ssl_ctx));
 
 		if (ssl == nullptr)
 		{
@@ -279,29 +321,116 @@ namespace ov
 
 		// 세션 설정
 		SSL_set_app_data(ssl, app_data);
-		::SSL_set_bio(ssl, _bio, _bio);
-		::SSL_set_read_ahead(ssl, 1);
-		::SSL_set_mode(ssl, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
 
-		EC_KEY *ecdh = ::EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+#if OV_TLS_KTLS_SUPPORTED
+		if (_kernel_tls_socket >= 0)
+		{
+			BIO *socket_bio = ::BIO_new_socket(_kernel_tls_socket, BIO_NOCLOSE);
+
+			if (socket_bio == nullptr)
+			{
+				return false;
+			}
 
-		if (ecdh == nullptr)
+			// Received data is still passed by read_callback, but the records are written to the socket directly
+			// because OpenSSL configures kTLS only for a socket BIO
+			::SSL_set0_rbio(ssl, _bio);
+			::SSL_set0_wbio(ssl, socket_bio);
+			::SSL_set_options(ssl, SSL_OP_ENABLE_KTLS);
+		}
+		else
+#endif  // OV_TLS_KTLS_SUPPORTED
 		{
-			return false;
+			::SSL_set_bio(ssl, _bio, _bio);
 		}
 
+		::SSL_set_read_ahead(ssl, 1);
+		::SSL_set_mode(ssl, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+
 		// To prevent double free (_bio will be freed when calling SSL_free())
 		::BIO_up_ref(_bio);
 
-		::SSL_set_options(ssl, SSL_OP_SINGLE_ECDH_USE);
-		::SSL_set_tmp_ecdh(ssl, ecdh);
-		::EC_KEY_free(ecdh);
+		if (_tls_context == nullptr)
+		{
+			// The shared context already has the ECDH parameters (See TlsContext::CreateServerContext())
+			EC_KEY *ecdh = ::EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+
+			if (ecdh == nullptr)
+			{
+				return false;
+			}
+
+			::SSL_set_options(ssl, SSL_OP_SINGLE_ECDH_USE);
+			::SSL_set_tmp_ecdh(ssl, ecdh);
+			::EC_KEY_free(ecdh);
+		}
 
 		_ssl = std::move(ssl);
 
 		return true;
 	}
 
+	void Tls::UpdateKernelTlsState()
+	{
+#if OV_TLS_KTLS_SUPPORTED
+		if (_kernel_tls_socket < 0)
+		{
+			return;
+		}
+
+		if (BIO_get_ktls_send(::SSL_get_wbio(_ssl)))
+		{
+			_is_kernel_tls_send_enabled = true;
+
+			// close_notify must not be sent ahead of the data that is queued in ov::Socket
+			::SSL_set_quiet_shutdown(_ssl, 1);
+
+			logtd("kTLS is enabled for socket #%d (%s)", _kernel_tls_socket, ::SSL_get_cipher_name(_ssl));
+			return;
+		}
+
+		// The kernel doesn't support kTLS (or the cipher), so OpenSSL encrypts the records
+		logtd("kTLS is not available for socket #%d (%s), OpenSSL will be used", _kernel_tls_socket, ::SSL_get_cipher_name(_ssl));
+
+		// Write the records through write_callback again
+		::BIO_up_ref(_bio);
+		::SSL_set0_wbio(_ssl, _bio);
+
+		_kernel_tls_socket = -1;
+#endif  // OV_TLS_KTLS_SUPPORTED
+	}
+
+	bool Tls::WaitForKernelTlsSocketWritable()
+	{
+		struct pollfd poll_fd
+		{
+		};
+
+		poll_fd.fd = _kernel_tls_socket;
+		poll_fd.events = POLLOUT;
+
+		while (true)
+		{
+			int result = ::poll(&poll_fd, 1, TLS_KTLS_HANDSHAKE_WRITE_TIMEOUT);
+
+			if (result > 0)
+			{
+				return (OV_CHECK_FLAG(poll_fd.revents, POLLERR) || OV_CHECK_FLAG(poll_fd.revents, POLLHUP) || OV_CHECK_FLAG(poll_fd.revents, POLLNVAL)) == false;
+			}
+
+			if ((result == 0) || (errno != EINTR))
+			{
+				return false;
+			}
+		}
+	}
+
+	void Tls::OnServerNameSelected(const std::shared_ptr<TlsContext> &tls_context)
+	{
+		// Keep the selected context alive while this session is using it
+		_tls_context = tls_context;
+	}
+
 	int Tls::GetError(int code)
 	{
 		OV_ASSERT2(_ssl != nullptr);
@@ -319,10 +448,27 @@ namespace ov
 
 		int result = ::SSL_accept(_ssl);
 
+#if OV_TLS_KTLS_SUPPORTED
+		// Nobody retries the write later, since the handshake is driven by the received data.
+		// (The server sends its flight only after it receives the ClientHello, so nothing is queued in ov::Socket yet,
+		// and writing to the socket directly does not reorder the data)
+		while ((result <= 0) && (_kernel_tls_socket >= 0) && (GetError(result) == SSL_ERROR_WANT_WRITE))
+		{
+			if (WaitForKernelTlsSocketWritable() == false)
+			{
+				logte("Could not send the handshake to socket #%d: timed out", _kernel_tls_socket);
+				break;
+			}
+
+			result = ::SSL_accept(_ssl);
+		}
+#endif  // OV_TLS_KTLS_SUPPORTED
+
 		switch (result)
 		{
 			case 1:
 				// The TLS/SSL handshake was successfully completed, a TLS/SSL connection has been established.
+				UpdateKernelTlsState();
 				return SSL_ERROR_NONE;
 
 			case 0:
@@ -496,9 +642,24 @@ namespace ov
 
 	void Tls::SetVerify(int mode)
 	{
+		if (_tls_context != nullptr)
+		{
+			// The shared context must not be modified
+			OV_ASSERT2(_ssl != nullptr);
+			::SSL_set_verify(_ssl, mode, nullptr);
+			return;
+		}
+
 		::SSL_CTX_set_verify(_ssl_ctx, mode, nullptr);
 	}
 
+	bool Tls::IsSessionReused() const
+	{
+		OV_ASSERT2(_ssl != nullptr);
+
+		return (::SSL_session_reused(const_cast<SSL *>(static_cast<const SSL *>(_ssl))) == 1);
+	}
+
 	std::shared_ptr<Certificate> Tls::GetPeerCertificate() const
 	{
 		OV_ASSERT2(_ssl != nullptr);
@@ -27,9 +27,19 @@
 
 #include <base/ovlibrary/ovlibrary.h>
 
+// kTLS can be used only when OpenSSL 3.0+ is built with it (enable-ktls).
+// The OpenSSL installed by misc/prerequisites.sh (1.1.0g) does not have it, so kTLS is compiled out with it,
+// and HttpsServer::SetKernelTlsEnabled(true) only logs a warning
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#	define OV_TLS_KTLS_SUPPORTED 1
+#else
+#	define OV_TLS_KTLS_SUPPORTED 0
+#endif
+
 namespace ov
 {
 	class Tls;
+	class TlsContext;
 
 	struct TlsCallback
 	{
@@ -122,8 +132,32 @@ namespace ov
 
 		// method: DTLS_server_method(), TLS_server_method()
 		bool Initialize(const SSL_METHOD *method, const std::shared_ptr<Certificate> &certificate, const std::shared_ptr<Certificate> &chain_certificate, const ov::String &cipher_list, TlsCallback callback);
+		// Use the shared context instead of creating a new one
+		// (create_callback and verify_callback are not called, because the context must not be modified)
+		bool Initialize(const std::shared_ptr<TlsContext> &tls_context, TlsCallback callback);
 		bool Uninitialize();
 
+		static bool IsKernelTlsSupported()
+		{
+			return OV_TLS_KTLS_SUPPORTED;
+		}
+
+		// Try to hand the encryption of outgoing records over to the kernel (kTLS) after handshake
+		//
+		// Must be called before Initialize(). While accepting, the handshake records are written to the socket directly
+		// (instead of write_callback), so that OpenSSL can configure the kernel when the keys are negotiated.
+		// If the kernel doesn't support it, records are written through write_callback again after handshake.
+		void SetKernelTlsSocket(int native_socket)
+		{
+			_kernel_tls_socket = native_socket;
+		}
+
+		// If true, the plain data written to the socket is encrypted by the kernel (Do not call Write())
+		bool IsKernelTlsSendEnabled() const
+		{
+			return _is_kernel_tls_send_enabled;
+		}
+
 		// @return Returns SSL_ERROR_NONE on success
 		int Accept();
 
@@ -146,6 +180,15 @@ namespace ov
 
 		void SetVerify(int flags);
 
+		// @return Returns true if the session was reused (resumed by session cache or ticket)
+		bool IsSessionReused() const;
+
+		// @return The shared context that is selected for this session (after SNI), or nullptr if the session has its own context
+		std::shared_ptr<TlsContext> GetTlsContext() const
+		{
+			return _tls_context;
+		}
+
 		std::shared_ptr<Certificate> GetPeerCertificate() const;
 		bool ExportKeyingMaterial(unsigned long crypto_suite, const ov::String &label, std::shared_ptr<ov::Data> &server_key, std::shared_ptr<ov::Data> &client_key);
 
@@ -155,6 +198,8 @@ namespace ov
 		bool GetKeySaltLen(unsigned long crypto_suite, size_t *key_len, size_t *salt_len) const;
 
 	protected:
+		friend class TlsContext;
+
 		static BIO_METHOD *PrepareBioMethod();
 
 		bool PrepareSslContext(const SSL_METHOD *method, const std::shared_ptr<Certificate> &certificate, const std::shared_ptr<Certificate> &chain_certificate, const ov::String &cipher_list);
@@ -163,6 +208,14 @@ namespace ov
 
 		int GetError(int code);
 
+		// Called when the handshake is completed
+		void UpdateKernelTlsState();
+		// Waits until the handshake records can be written to _kernel_tls_socket
+		bool WaitForKernelTlsSocketWritable();
+
+		// Called by TlsContext when another context is selected by SNI
+		void OnServerNameSelected(const std::shared_ptr<TlsContext> &tls_context);
+
 		template <typename Treturn, Treturn default_value, class Tmember, Tmember member, typename... Targuments>
 		static Treturn DoCallback(void *obj, Targuments... args)
 		{
@@ -196,6 +249,10 @@ namespace ov
 		TlsUniquePtr<SSL, void, ::SSL_free> _ssl = nullptr;
 		TlsUniquePtr<SSL_CTX, void, ::SSL_CTX_free> _ssl_ctx = nullptr;
 		TlsUniquePtr<BIO, int, ::BIO_free> _bio = nullptr;
+		std::shared_ptr<TlsContext> _tls_context;
+
+		int _kernel_tls_socket = -1;
+		bool _is_kernel_tls_send_enabled = false;
 
 		TlsCallback _callback;
 	};
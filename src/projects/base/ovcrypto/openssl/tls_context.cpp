@@ -0,0 +1,343 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "tls_context.h"
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#	include <openssl/core_names.h>
+#else
+#	include <openssl/hmac.h>
+#endif
+
+#include <mutex>
+
+#include "../../ovlibrary/ovlibrary.h"
+#include "./tls.h"
+
+#define OV_LOG_TAG "OpenSSL"
+
+// Used to distinguish the sessions of OME from others in the session cache
+#define TLS_SESSION_ID_CONTEXT "OvenMediaEngine"
+// Maximum number of sessions in the server-side session cache of each context
+#define TLS_SESSION_CACHE_SIZE (20 * 1024)
+// Lifetime of a session (in seconds)
+#define TLS_SESSION_TIMEOUT (2 * 60 * 60)
+
+// The ticket key is renewed every hour (in milliseconds)
+#define TLS_TICKET_KEY_ROTATION_INTERVAL (60 * 60 * 1000)
+// Number of ticket keys that can decrypt a ticket (current key + previous keys)
+// NOTE: (TLS_TICKET_KEY_COUNT - 1) * TLS_TICKET_KEY_ROTATION_INTERVAL should be longer than TLS_SESSION_TIMEOUT
+#define TLS_TICKET_KEY_COUNT 3
+
+namespace ov
+{
+	struct TlsTicketKey
+	{
+		uint8_t name[16];
+		uint8_t aes_key[32];
+		uint8_t hmac_key[32];
+	};
+
+	class TlsTicketKeyStore
+	{
+	public:
+		static TlsTicketKeyStore *GetInstance()
+		{
+			// Never released, because the tickets can be issued while the static objects are being destroyed
+			static auto instance = new TlsTicketKeyStore();
+
+			return instance;
+		}
+
+		// Returns the key to encrypt a new ticket
+		bool GetCurrentKey(TlsTicketKey *key)
+		{
+			std::lock_guard<std::mutex> lock(_key_list_mutex);
+
+			RotateIfNeeded();
+
+			if (_key_list.empty())
+			{
+				return false;
+			}
+
+			*key = _key_list.front();
+			return true;
+		}
+
+		// Returns the key that issued the ticket
+		//
+		// is_current: false if the key is old (the ticket should be renewed)
+		bool FindKey(const uint8_t *name, TlsTicketKey *key, bool *is_current)
+		{
+			std::lock_guard<std::mutex> lock(_key_list_mutex);
+
+			RotateIfNeeded();
+
+			for (size_t index = 0; index < _key_list.size(); index++)
+			{
+				auto &item = _key_list[index];
+
+				if (::memcmp(item.name, name, sizeof(item.name)) == 0)
+				{
+					*key = item;
+					*is_current = (index == 0);
+
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+	protected:
+		void RotateIfNeeded()
+		{
+			if ((_key_list.empty() == false) && (_rotation_timer.IsElapsed(TLS_TICKET_KEY_ROTATION_INTERVAL) == false))
+			{
+				return;
+			}
+
+			TlsTicketKey key;
+
+			if ((::RAND_bytes(key.name, sizeof(key.name)) != 1) ||
+				(::RAND_bytes(key.aes_key, sizeof(key.aes_key)) != 1) ||
+				(::RAND_bytes(key.hmac_key, sizeof(key.hmac_key)) != 1))
+			{
+				logte("Could not generate a TLS ticket key: %s", ov::Error::CreateErrorFromOpenSsl()->ToString().CStr());
+				return;
+			}
+
+			_key_list.insert(_key_list.begin(), key);
+
+			if (_key_list.size() > TLS_TICKET_KEY_COUNT)
+			{
+				_key_list.resize(TLS_TICKET_KEY_COUNT);
+			}
+
+			_rotation_timer.Start();
+
+			logtd("TLS ticket key is rotated (%zu keys are available)", _key_list.size());
+		}
+
+		std::mutex _key_list_mutex;
+		// The newest key is placed at the front
+		std::vector<TlsTicketKey> _key_list;
+		ov::StopWatch _rotation_timer;
+	};
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+	typedef EVP_MAC_CTX TlsTicketMacContext;
+
+	static bool InitializeTicketMac(TlsTicketMacContext *mac_context, const TlsTicketKey &key)
+	{
+		OSSL_PARAM params[] = {
+			::OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, const_cast<uint8_t *>(key.hmac_key), sizeof(key.hmac_key)),
+			::OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char *>("SHA256"), 0),
+			::OSSL_PARAM_construct_end()};
+
+		return (::EVP_MAC_CTX_set_params(mac_context, params) == 1);
+	}
+#else
+	typedef HMAC_CTX TlsTicketMacContext;
+
+	static bool InitializeTicketMac(TlsTicketMacContext *mac_context, const TlsTicketKey &key)
+	{
+		return (::HMAC_Init_ex(mac_context, key.hmac_key, sizeof(key.hmac_key), ::EVP_sha256(), nullptr) == 1);
+	}
+#endif
+
+	// Return value (See SSL_CTX_set_tlsext_ticket_key_cb()):
+	//   -1: error, 0: the ticket cannot be decrypted (full handshake), 1: success, 2: success and the ticket should be renewed
+	static int OnTicketKey(SSL *ssl, unsigned char key_name[16], unsigned char *iv, EVP_CIPHER_CTX *cipher_context, TlsTicketMacContext *mac_context, int encrypt)
+	{
+		auto key_store = TlsTicketKeyStore::GetInstance();
+		TlsTicketKey key;
+
+		if (encrypt)
+		{
+			if ((key_store->GetCurrentKey(&key) == false) ||
+				(::RAND_bytes(iv, EVP_MAX_IV_LENGTH) != 1))
+			{
+				return -1;
+			}
+
+			::memcpy(key_name, key.name, sizeof(key.name));
+
+			if ((::EVP_EncryptInit_ex(cipher_context, ::EVP_aes_256_cbc(), nullptr, key.aes_key, iv) != 1) ||
+				(InitializeTicketMac(mac_context, key) == false))
+			{
+				return -1;
+			}
+
+			return 1;
+		}
+
+		bool is_current = false;
+
+		if (key_store->FindKey(key_name, &key, &is_current) == false)
+		{
+			// The ticket was issued by an expired key (or another server)
+			return 0;
+		}
+
+		if ((::EVP_DecryptInit_ex(cipher_context, ::EVP_aes_256_cbc(), nullptr, key.aes_key, iv) != 1) ||
+			(InitializeTicketMac(mac_context, key) == false))
+		{
+			return -1;
+		}
+
+		return is_current ? 1 : 2;
+	}
+
+	std::shared_ptr<TlsContext> TlsContext::CreateServerContext(const SSL_METHOD *method,
+																const std::shared_ptr<Certificate> &certificate,
+																const std::shared_ptr<Certificate> &chain_certificate,
+																const ov::String &cipher_list)
+	{
+		OV_ASSERT2(certificate != nullptr);
+
+		if (certificate == nullptr)
+		{
+			logte("Invalid TLS certificate");
+			return nullptr;
+		}
+
+		TlsUniquePtr<SSL_CTX, void, ::SSL_CTX_free> ctx(::SSL_CTX_new(method));
+
+		if (ctx == nullptr)
+		{
+			logte("Cannot create SSL context: %s", ov::Error::CreateErrorFromOpenSsl()->ToString().CStr());
+			return nullptr;
+		}
+
+		if (::SSL_CTX_use_certificate(ctx, certificate->GetX509()) != 1)
+		{
+			logte("Cannot use certficate: %s", ov::Error::CreateErrorFromOpenSsl()->ToString().CStr());
+			return nullptr;
+		}
+
+		if ((chain_certificate != nullptr) && (::SSL_CTX_add1_chain_cert(ctx, chain_certificate->GetX509()) != 1))
+		{
+			logte("Cannot use chain certificate: %s", ov::Error::CreateErrorFromOpenSsl()->ToString().CStr());
+			return nullptr;
+		}
+
+		if (::SSL_CTX_use_PrivateKey(ctx, certificate->GetPkey()) != 1)
+		{
+			logte("Cannot use private key: %s", ov::Error::CreateErrorFromOpenSsl()->ToString().CStr());
+			return nullptr;
+		}
+
+		// https://curl.haxx.se/docs/ssl-ciphers.html
+		// https://wiki.mozilla.org/Security/Server_Side_TLS
+		::SSL_CTX_set_cipher_list(ctx, cipher_list.CStr());
+
+		// Configured once here instead of every session (See Tls::PrepareSsl())
+		EC_KEY *ecdh = ::EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+
+		if (ecdh == nullptr)
+		{
+			logte("Cannot create ECDH key: %s", ov::Error::CreateErrorFromOpenSsl()->ToString().CStr());
+			return nullptr;
+		}
+
+		::SSL_CTX_set_options(ctx, SSL_OP_SINGLE_ECDH_USE);
+		::SSL_CTX_set_tmp_ecdh(ctx, ecdh);
+		::EC_KEY_free(ecdh);
+
+		// Session resumption using session IDs
+		::SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER);
+		::SSL_CTX_set_session_id_context(ctx, reinterpret_cast<const unsigned char *>(TLS_SESSION_ID_CONTEXT), OV_COUNTOF(TLS_SESSION_ID_CONTEXT) - 1);
+		::SSL_CTX_sess_set_cache_size(ctx, TLS_SESSION_CACHE_SIZE);
+		::SSL_CTX_set_timeout(ctx, TLS_SESSION_TIMEOUT);
+
+		// Session resumption using session tickets (RFC 5077)
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+		::SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, OnTicketKey);
+#else
+		::SSL_CTX_set_tlsext_ticket_key_cb(ctx, OnTicketKey);
+#endif
+
+		auto tls_context = std::make_shared<TlsContext>(ctx);
+
+		// Now, tls_context owns the SSL_CTX
+		::SSL_CTX_up_ref(ctx);
+
+		return tls_context;
+	}
+
+	TlsContext::TlsContext(SSL_CTX *ssl_ctx)
+		: _ssl_ctx(ssl_ctx)
+	{
+	}
+
+	TlsContext::~TlsContext()
+	{
+		if (_ssl_ctx != nullptr)
+		{
+			// The sessions that are still using the context hold their own references
+			::SSL_CTX_free(_ssl_ctx);
+			_ssl_ctx = nullptr;
+		}
+	}
+
+	void TlsContext::SetServerNameResolver(TlsServerNameResolver resolver)
+	{
+		_server_name_resolver = std::move(resolver);
+
+		if (_server_name_resolver != nullptr)
+		{
+			::SSL_CTX_set_tlsext_servername_callback(_ssl_ctx, OnServerName);
+			::SSL_CTX_set_tlsext_servername_arg(_ssl_ctx, this);
+		}
+		else
+		{
+			::SSL_CTX_set_tlsext_servername_callback(_ssl_ctx, nullptr);
+			::SSL_CTX_set_tlsext_servername_arg(_ssl_ctx, nullptr);
+		}
+	}
+
+	int TlsContext::OnServerName(SSL *ssl, int *alert, void *arg)
+	{
+		auto tls_context = static_cast<TlsContext *>(arg);
+		auto server_name = ::SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+
+		if ((tls_context == nullptr) || (server_name == nullptr) || (tls_context->_server_name_resolver == nullptr))
+		{
+			// Use the default context
+			return SSL_TLSEXT_ERR_NOACK;
+		}
+
+		auto selected_context = tls_context->_server_name_resolver(server_name);
+
+		if (selected_context == nullptr)
+		{
+			logtd("Could not find a certificate for %s, the default certificate will be used", server_name);
+			return SSL_TLSEXT_ERR_NOACK;
+		}
+
+		if (selected_context.get() != tls_context)
+		{
+			// The session cache and ticket keys of the default context are still used (OpenSSL uses the initial context for them)
+			::SSL_set_SSL_CTX(ssl, selected_context->GetSslContext());
+
+			auto tls = static_cast<Tls *>(SSL_get_app_data(ssl));
+
+			if (tls != nullptr)
+			{
+				tls->OnServerNameSelected(selected_context);
+			}
+		}
+
+		return SSL_TLSEXT_ERR_OK;
+	}
+}  // namespace ov
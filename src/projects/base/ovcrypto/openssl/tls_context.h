@@ -0,0 +1,55 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <openssl/ssl.h>
+
+#include <functional>
+
+#include "../certificate.h"
+
+namespace ov
+{
+	class TlsContext;
+
+	// Returns the context to use for the server name (SNI), or nullptr to keep the default context
+	using TlsServerNameResolver = std::function<std::shared_ptr<TlsContext>(const ov::String &server_name)>;
+
+	// An SSL_CTX that is shared by all the TLS sessions which use the same certificate
+	//
+	// Creating an SSL_CTX (parsing/verifying the certificate, key and cipher list) for every connection is expensive,
+	// so the context is created once and treated as immutable after it is created.
+	// Also, the sessions can be resumed using the server-side session cache or session tickets.
+	// The ticket keys are shared by all the contexts and rotated periodically.
+	class TlsContext
+	{
+	public:
+		// method: TLS_server_method()
+		static std::shared_ptr<TlsContext> CreateServerContext(const SSL_METHOD *method,
+															   const std::shared_ptr<Certificate> &certificate,
+															   const std::shared_ptr<Certificate> &chain_certificate,
+															   const ov::String &cipher_list);
+
+		explicit TlsContext(SSL_CTX *ssl_ctx);
+		~TlsContext();
+
+		// Must be called before the context is used by any session
+		void SetServerNameResolver(TlsServerNameResolver resolver);
+
+		SSL_CTX *GetSslContext() const
+		{
+			return _ssl_ctx;
+		}
+
+	protected:
+		static int OnServerName(SSL *ssl, int *alert, void *arg);
+
+		SSL_CTX *_ssl_ctx = nullptr;
+		TlsServerNameResolver _server_name_resolver;
+	};
+}  // namespace ov
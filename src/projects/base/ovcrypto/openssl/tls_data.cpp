@@ -14,7 +14,47 @@ namespace ov
 {
 	TlsData::TlsData(Method method, const std::shared_ptr<Certificate> &certificate, const std::shared_ptr<Certificate> &chain_certificate, const ov::String &cipher_list)
 	{
-		ov::TlsCallback callback =
+		const SSL_METHOD *tls_method = nullptr;
+
+		switch (method)
+		{
+			case Method::TlsServerMethod:
+				tls_method = TLS_server_method();
+				break;
+
+			case Method::DtlsServerMethod:
+				tls_method = DTLS_server_method();
+				break;
+		}
+
+		if (_tls.Initialize(tls_method, certificate, chain_certificate, cipher_list, CreateCallback()) == false)
+		{
+			logte("Could not initialize TLS: %s", ov::Error::CreateErrorFromOpenSsl()->ToString().CStr());
+		}
+
+		_state = State::WaitingForAccept;
+	}
+
+	TlsData::TlsData(const std::shared_ptr<TlsContext> &tls_context, int kernel_tls_socket)
+	{
+		_tls.SetKernelTlsSocket(kernel_tls_socket);
+
+		if (_tls.Initialize(tls_context, CreateCallback()) == false)
+		{
+			logte("Could not initialize TLS: %s", ov::Error::CreateErrorFromOpenSsl()->ToString().CStr());
+		}
+
+		_state = State::WaitingForAccept;
+	}
+
+	TlsData::~TlsData()
+	{
+		_tls.Uninitialize();
+	}
+
+	TlsCallback TlsData::CreateCallback()
+	{
+		return
 			{
 				.create_callback = [](ov::Tls *tls, SSL_CTX *context) -> bool {
 					return true;
@@ -41,31 +81,6 @@ namespace ov
 					}
 				},
 				.verify_callback = nullptr};
-
-		const SSL_METHOD *tls_method = nullptr;
-
-		switch (method)
-		{
-			case Method::TlsServerMethod:
-				tls_method = TLS_server_method();
-				break;
-
-			case Method::DtlsServerMethod:
-				tls_method = DTLS_server_method();
-				break;
-		}
-
-		if (_tls.Initialize(tls_method, certificate, chain_certificate, cipher_list, callback) == false)
-		{
-			logte("Could not initialize TLS: %s", ov::Error::CreateErrorFromOpenSsl()->ToString().CStr());
-		}
-
-		_state = State::WaitingForAccept;
-	}
-
-	TlsData::~TlsData()
-	{
-		_tls.Uninitialize();
 	}
 
 	bool TlsData::Decrypt(const std::shared_ptr<const ov::Data> &cipher_data, std::shared_ptr<const ov::Data> *plain_data)
@@ -140,6 +155,13 @@ namespace ov
 			return false;
 		}
 
+		if (_tls.IsKernelTlsSendEnabled())
+		{
+			// The kernel will encrypt the data while sending it
+			*cipher_data = plain_data;
+			return true;
+		}
+
 		logtd("Trying to encrypt the data for TLS\n%s", plain_data->Dump(32).CStr());
 
 		size_t written_bytes = 0;
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "./tls.h"
+#include "./tls_context.h"
 
 namespace ov
 {
@@ -33,6 +34,10 @@ namespace ov
 		};
 
 		TlsData(Method method, const std::shared_ptr<Certificate> &certificate, const std::shared_ptr<Certificate> &chain_certificate, const String &cipher_list);
+		// Use the shared context (TLS only)
+		//
+		// kernel_tls_socket: If a TCP socket is specified, the records are encrypted by the kernel (kTLS) after handshake if possible
+		explicit TlsData(const std::shared_ptr<TlsContext> &tls_context, int kernel_tls_socket = -1);
 		~TlsData();
 
 		State GetState() const
@@ -51,10 +56,30 @@ namespace ov
 		// cipher_data can be null even if successful (It indicates accepting a new client)
 		bool Encrypt(const std::shared_ptr<const Data> &plain_data, std::shared_ptr<const Data> *cipher_data);
 
+		// Valid after the state becomes State::Accepted
+		bool IsKernelTlsEnabled() const
+		{
+			return _tls.IsKernelTlsSendEnabled();
+		}
+
+		// Valid after the state becomes State::Accepted
+		bool IsSessionReused() const
+		{
+			return _tls.IsSessionReused();
+		}
+
+		// The context that is selected by SNI (nullptr if TlsData is not created with the shared context)
+		std::shared_ptr<TlsContext> GetTlsContext() const
+		{
+			return _tls.GetTlsContext();
+		}
+
 		size_t GetDataLength() const;
 		std::shared_ptr<const Data> GetData() const;
 
 	protected:
+		TlsCallback CreateCallback();
+
 		//--------------------------------------------------------------------
 		// Called by TLS module
 		//--------------------------------------------------------------------
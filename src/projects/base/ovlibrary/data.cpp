@@ -51,7 +51,7 @@ namespace ov
 		_reference_data = data._reference_data;
 		if (data._allocated_data != nullptr)
 		{
-			_allocated_data = std::make_shared<std::vector<uint8_t>>();
+			_allocated_data = std::make_shared<DataBuffer>();
 			Append(&data);
 		}
 		_offset = data._offset;
@@ -246,7 +246,7 @@ namespace ov
 		// Reset the offset
 		_offset = 0L;
 
-		_allocated_data = std::make_shared<std::vector<uint8_t>>(begin, end);
+		_allocated_data = std::make_shared<DataBuffer>(begin, end);
 		_allocated_data->reserve(old_data->capacity() - old_offset);
 
 		return (_allocated_data != nullptr);
@@ -265,7 +265,7 @@ namespace ov
 		}
 		else
 		{
-			_allocated_data = std::make_shared<std::vector<uint8_t>>();
+			_allocated_data = std::make_shared<DataBuffer>();
 		}
 
 		_allocated_data->reserve(capacity);
@@ -277,7 +277,7 @@ namespace ov
 	{
 		// Reallocate the buffer (this method is faster than Detach() & clear());
 		_reference_data = nullptr;
-		_allocated_data = std::make_shared<std::vector<uint8_t>>();
+		_allocated_data = std::make_shared<DataBuffer>();
 		_offset = 0;
 		_length = 0;
 
@@ -11,7 +11,7 @@
 #include "./string.h"
 #include "./assert.h"
 #include "./memory_utilities.h"
-#include "./data.h"
+#include "./data_pool.h"
 
 #include <memory>
 #include <algorithm>
@@ -214,7 +214,7 @@ namespace ov
 		const void *_reference_data = nullptr;
 
 		// Allocated data. If this data is subdata, _current_data and _data can be different.
-		std::shared_ptr<std::vector<uint8_t>> _allocated_data = nullptr;
+		std::shared_ptr<DataBuffer> _allocated_data = nullptr;
 		// Offset from _allocated_data
 		off_t _offset = 0;
 
@@ -0,0 +1,417 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "data_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#include "./memory_utilities.h"
+
+namespace ov
+{
+	// Power-of-two classes from 256B to 64KB, so a block wastes less than half of its size.
+	// Bigger blocks (e.g. segments) are rare compared to packets and frames, and are allocated by malloc() directly
+	static constexpr size_t DATA_POOL_MIN_CLASS_SHIFT = 8;
+	static constexpr size_t DATA_POOL_MAX_CLASS_SHIFT = 16;
+	static constexpr size_t DATA_POOL_CLASS_COUNT = DATA_POOL_MAX_CLASS_SHIFT - DATA_POOL_MIN_CLASS_SHIFT + 1;
+
+	// Idle bytes that a thread keeps for each class (between 4 and 256 blocks)
+	static constexpr size_t DATA_POOL_THREAD_CACHE_BYTES = 256 * 1024;
+	// The shared list of each class can hold the blocks of this number of thread caches
+	static constexpr size_t DATA_POOL_SHARED_CACHE_MULTIPLIER = 8;
+
+	static constexpr size_t GetClassSize(size_t class_index)
+	{
+		return static_cast<size_t>(1) << (class_index + DATA_POOL_MIN_CLASS_SHIFT);
+	}
+
+	static constexpr size_t GetThreadCacheLimit(size_t class_index)
+	{
+		return std::min<size_t>(std::max<size_t>(DATA_POOL_THREAD_CACHE_BYTES / GetClassSize(class_index), 4), 256);
+	}
+
+	static constexpr size_t GetSharedLimit(size_t class_index)
+	{
+		return GetThreadCacheLimit(class_index) * DATA_POOL_SHARED_CACHE_MULTIPLIER;
+	}
+
+	// Counters of a thread, which are updated only by the owner thread (so they need no atomic read-modify-write),
+	// and are read by GetStats() from other threads
+	struct Counters
+	{
+		std::atomic<uint64_t> hit_count{0};
+		std::atomic<uint64_t> miss_count{0};
+		std::atomic<int64_t> bytes_in_use{0};
+		std::atomic<int64_t> bytes_pooled{0};
+
+		template <typename T>
+		static void Add(std::atomic<T> &counter, T value)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		void Accumulate(const Counters &other)
+		{
+			hit_count.fetch_add(other.hit_count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			miss_count.fetch_add(other.miss_count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			bytes_in_use.fetch_add(other.bytes_in_use.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			bytes_pooled.fetch_add(other.bytes_pooled.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+	};
+
+	struct SharedPool
+	{
+		std::mutex mutex;
+		std::vector<void *> block_list;
+	};
+
+	static SharedPool *GetSharedPoolList()
+	{
+		// Never released, because a Data can be freed while the static objects are being destroyed
+		static auto shared_pool_list = new SharedPool[DATA_POOL_CLASS_COUNT];
+
+		return shared_pool_list;
+	}
+
+	struct ThreadCache;
+
+	// The thread caches that are alive, and the counters of the caches that have been destroyed
+	// (Never released for the same reason as the shared pools)
+	struct ThreadCacheRegistry
+	{
+		std::mutex mutex;
+		std::vector<ThreadCache *> cache_list;
+
+		// Also used by the threads that have no cache (updated atomically)
+		Counters retired_counters;
+	};
+
+	static ThreadCacheRegistry *GetThreadCacheRegistry()
+	{
+		static auto registry = new ThreadCacheRegistry();
+
+		return registry;
+	}
+
+	enum class ThreadCacheState : uint8_t
+	{
+		NotCreated,
+		Created,
+		Destroyed
+	};
+
+	// Trivially destructible, so they are accessible while the thread is exiting
+	static thread_local ThreadCacheState _thread_cache_state = ThreadCacheState::NotCreated;
+	static thread_local ThreadCache *_thread_cache_pointer = nullptr;
+
+	struct ThreadCache
+	{
+		ThreadCache()
+		{
+			for (size_t index = 0; index < DATA_POOL_CLASS_COUNT; index++)
+			{
+				block_list[index].reserve(GetThreadCacheLimit(index) + 1);
+			}
+
+			auto registry = GetThreadCacheRegistry();
+			std::lock_guard<std::mutex> lock(registry->mutex);
+			registry->cache_list.push_back(this);
+		}
+
+		~ThreadCache()
+		{
+			_thread_cache_pointer = nullptr;
+			_thread_cache_state = ThreadCacheState::Destroyed;
+
+			// Hand over the idle blocks to other threads
+			for (size_t index = 0; index < DATA_POOL_CLASS_COUNT; index++)
+			{
+				Spill(index, block_list[index].size());
+			}
+
+			auto registry = GetThreadCacheRegistry();
+			std::lock_guard<std::mutex> lock(registry->mutex);
+
+			registry->retired_counters.Accumulate(counters);
+			registry->cache_list.erase(std::remove(registry->cache_list.begin(), registry->cache_list.end(), this), registry->cache_list.end());
+		}
+
+		// Move <count> blocks to the shared pool
+		void Spill(size_t class_index, size_t count)
+		{
+			auto &list = block_list[class_index];
+			auto &shared_pool = GetSharedPoolList()[class_index];
+			int64_t freed_bytes = 0;
+
+			{
+				std::lock_guard<std::mutex> lock(shared_pool.mutex);
+
+				for (size_t released = 0; (released < count) && (list.empty() == false); released++)
+				{
+					auto block = list.back();
+					list.pop_back();
+
+					if (shared_pool.block_list.size() < GetSharedLimit(class_index))
+					{
+						shared_pool.block_list.push_back(block);
+					}
+					else
+					{
+						::free(block);
+						freed_bytes += GetClassSize(class_index);
+					}
+				}
+			}
+
+			Counters::Add<int64_t>(counters.bytes_pooled, -freed_bytes);
+		}
+
+		// Move up to <count> blocks from the shared pool
+		void Refill(size_t class_index, size_t count)
+		{
+			auto &list = block_list[class_index];
+			auto &shared_pool = GetSharedPoolList()[class_index];
+
+			std::lock_guard<std::mutex> lock(shared_pool.mutex);
+
+			for (size_t acquired = 0; (acquired < count) && (shared_pool.block_list.empty() == false); acquired++)
+			{
+				list.push_back(shared_pool.block_list.back());
+				shared_pool.block_list.pop_back();
+			}
+		}
+
+		std::vector<void *> block_list[DATA_POOL_CLASS_COUNT];
+
+		Counters counters;
+	};
+
+	// Returns nullptr if the cache of the thread has been destroyed (the thread is exiting)
+	static inline ThreadCache *GetThreadCache()
+	{
+		if ((_thread_cache_pointer == nullptr) && (_thread_cache_state == ThreadCacheState::NotCreated))
+		{
+			static thread_local ThreadCache thread_cache;
+
+			_thread_cache_pointer = &thread_cache;
+			_thread_cache_state = ThreadCacheState::Created;
+		}
+
+		return _thread_cache_pointer;
+	}
+
+	// The counters of the thread, or the shared counters if the thread is exiting
+	static inline void AddCounter(ThreadCache *thread_cache, std::atomic<uint64_t> Counters::*counter, uint64_t value)
+	{
+		if (thread_cache != nullptr)
+		{
+			Counters::Add(thread_cache->counters.*counter, value);
+		}
+		else
+		{
+			(GetThreadCacheRegistry()->retired_counters.*counter).fetch_add(value, std::memory_order_relaxed);
+		}
+	}
+
+	static inline void AddCounter(ThreadCache *thread_cache, std::atomic<int64_t> Counters::*counter, int64_t value)
+	{
+		if (thread_cache != nullptr)
+		{
+			Counters::Add(thread_cache->counters.*counter, value);
+		}
+		else
+		{
+			(GetThreadCacheRegistry()->retired_counters.*counter).fetch_add(value, std::memory_order_relaxed);
+		}
+	}
+
+	static int GetClassIndex(size_t size)
+	{
+		if (size <= GetClassSize(0))
+		{
+			return 0;
+		}
+
+		if (size > GetClassSize(DATA_POOL_CLASS_COUNT - 1))
+		{
+			return -1;
+		}
+
+		// The smallest class that is not less than size: ceil(log2(size)) - DATA_POOL_MIN_CLASS_SHIFT
+		auto shift = (sizeof(unsigned long long) * 8) - __builtin_clzll(static_cast<unsigned long long>(size - 1));
+
+		return static_cast<int>(shift - DATA_POOL_MIN_CLASS_SHIFT);
+	}
+
+	size_t DataPool::GetAllocationSize(size_t size)
+	{
+		auto class_index = GetClassIndex(size);
+
+		return (class_index >= 0) ? GetClassSize(class_index) : size;
+	}
+
+	void *DataPool::Allocate(size_t size)
+	{
+		auto class_index = GetClassIndex(size);
+		auto thread_cache = GetThreadCache();
+
+		if (class_index < 0)
+		{
+			// Too big to be pooled
+			auto block = ::malloc(size);
+
+			if (block == nullptr)
+			{
+				throw std::bad_alloc();
+			}
+
+			AddCounter(thread_cache, &Counters::miss_count, 1);
+			AddCounter(thread_cache, &Counters::bytes_in_use, static_cast<int64_t>(size));
+
+			return block;
+		}
+
+		auto class_size = static_cast<int64_t>(GetClassSize(class_index));
+
+		if (thread_cache != nullptr)
+		{
+			auto &list = thread_cache->block_list[class_index];
+
+			if (list.empty())
+			{
+				thread_cache->Refill(class_index, GetThreadCacheLimit(class_index) / 2);
+			}
+
+			if (list.empty() == false)
+			{
+				auto block = list.back();
+				list.pop_back();
+
+				auto &counters = thread_cache->counters;
+				Counters::Add<uint64_t>(counters.hit_count, 1);
+				Counters::Add(counters.bytes_pooled, -class_size);
+				Counters::Add(counters.bytes_in_use, class_size);
+
+				return block;
+			}
+		}
+
+		auto block = ::malloc(class_size);
+
+		if (block == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+
+		AddCounter(thread_cache, &Counters::miss_count, 1);
+		AddCounter(thread_cache, &Counters::bytes_in_use, class_size);
+
+		return block;
+	}
+
+	void DataPool::Free(void *block, size_t size) noexcept
+	{
+		if (block == nullptr)
+		{
+			return;
+		}
+
+		auto class_index = GetClassIndex(size);
+		// A thread that only frees the blocks (e.g. the consumer of the packets) also gets a cache,
+		// so that it does not lock the shared pool for every block
+		auto thread_cache = GetThreadCache();
+
+		if (class_index < 0)
+		{
+			::free(block);
+			AddCounter(thread_cache, &Counters::bytes_in_use, -static_cast<int64_t>(size));
+
+			return;
+		}
+
+		auto class_size = static_cast<int64_t>(GetClassSize(class_index));
+
+		if (thread_cache != nullptr)
+		{
+			auto &list = thread_cache->block_list[class_index];
+			auto &counters = thread_cache->counters;
+
+			Counters::Add(counters.bytes_in_use, -class_size);
+			Counters::Add(counters.bytes_pooled, class_size);
+
+			list.push_back(block);
+
+			if (list.size() > GetThreadCacheLimit(class_index))
+			{
+				thread_cache->Spill(class_index, list.size() / 2);
+			}
+
+			return;
+		}
+
+		// The thread is exiting
+		AddCounter(thread_cache, &Counters::bytes_in_use, -class_size);
+
+		auto &shared_pool = GetSharedPoolList()[class_index];
+		std::unique_lock<std::mutex> lock(shared_pool.mutex);
+
+		if (shared_pool.block_list.size() < GetSharedLimit(class_index))
+		{
+			shared_pool.block_list.push_back(block);
+			AddCounter(thread_cache, &Counters::bytes_pooled, class_size);
+
+			return;
+		}
+
+		lock.unlock();
+
+		::free(block);
+	}
+
+	DataPool::Stats DataPool::GetStats()
+	{
+		auto registry = GetThreadCacheRegistry();
+		std::lock_guard<std::mutex> lock(registry->mutex);
+
+		auto &retired = registry->retired_counters;
+
+		Stats stats{
+			retired.hit_count.load(std::memory_order_relaxed),
+			retired.miss_count.load(std::memory_order_relaxed),
+			retired.bytes_in_use.load(std::memory_order_relaxed),
+			retired.bytes_pooled.load(std::memory_order_relaxed)};
+
+		for (auto thread_cache : registry->cache_list)
+		{
+			auto &counters = thread_cache->counters;
+
+			stats.hit_count += counters.hit_count.load(std::memory_order_relaxed);
+			stats.miss_count += counters.miss_count.load(std::memory_order_relaxed);
+			stats.bytes_in_use += counters.bytes_in_use.load(std::memory_order_relaxed);
+			stats.bytes_pooled += counters.bytes_pooled.load(std::memory_order_relaxed);
+		}
+
+		return stats;
+	}
+
+	String DataPool::GetStatsString()
+	{
+		auto stats = GetStats();
+		auto total_count = stats.hit_count + stats.miss_count;
+
+		return String::FormatString(
+			"<DataPool: hit: %" PRIu64 ", miss: %" PRIu64 " (hit ratio: %.2f%%), in use: %" PRId64 " bytes, pooled: %" PRId64 " bytes>",
+			stats.hit_count, stats.miss_count,
+			(total_count > 0) ? (static_cast<double>(stats.hit_count) * 100.0 / total_count) : 0.0,
+			stats.bytes_in_use, stats.bytes_pooled);
+	}
+}  // namespace ov
@@ -0,0 +1,87 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "./string.h"
+
+namespace ov
+{
+	// Size-classed buffer pool that backs ov::Data
+	//
+	// Freed blocks are kept in a per-thread cache of each size class and reused by the next allocation of the same class,
+	// so the packets and segments that are allocated and released over and over do not hit malloc() every time.
+	// When a thread cache overflows, half of it is moved to a shared list so that other threads can reuse them.
+	// The classes are powers of two from 256B to 64KB. A block larger than that is allocated by malloc() directly.
+	class DataPool
+	{
+	public:
+		struct Stats
+		{
+			// Number of allocations served from a pool
+			uint64_t hit_count;
+			// Number of allocations that have called malloc()
+			uint64_t miss_count;
+			// Bytes of the blocks that are being used (including the blocks which are not pooled)
+			int64_t bytes_in_use;
+			// Bytes of the idle blocks held by the pools
+			int64_t bytes_pooled;
+		};
+
+		// Returns the number of bytes actually allocated for the size
+		static size_t GetAllocationSize(size_t size);
+
+		// Allocate()/Free() must be called with the same size
+		static void *Allocate(size_t size);
+		static void Free(void *block, size_t size) noexcept;
+
+		static Stats GetStats();
+		static String GetStatsString();
+	};
+
+	template <typename T>
+	class DataPoolAllocator
+	{
+	public:
+		typedef T value_type;
+
+		DataPoolAllocator() noexcept = default;
+
+		template <typename U>
+		DataPoolAllocator(const DataPoolAllocator<U> &) noexcept
+		{
+		}
+
+		T *allocate(size_t count)
+		{
+			return static_cast<T *>(DataPool::Allocate(count * sizeof(T)));
+		}
+
+		void deallocate(T *block, size_t count) noexcept
+		{
+			DataPool::Free(block, count * sizeof(T));
+		}
+
+		template <typename U>
+		bool operator==(const DataPoolAllocator<U> &) const noexcept
+		{
+			return true;
+		}
+
+		template <typename U>
+		bool operator!=(const DataPoolAllocator<U> &) const noexcept
+		{
+			return false;
+		}
+	};
+
+	typedef std::vector<uint8_t, DataPoolAllocator<uint8_t>> DataBuffer;
+}  // namespace ov
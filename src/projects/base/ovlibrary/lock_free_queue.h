@@ -0,0 +1,568 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "./assert.h"
+#include "./ovdata_structure.h"
+
+// Number of times that a consumer polls an empty queue before it goes to sleep
+#define OV_LOCK_FREE_QUEUE_SPIN_COUNT 64
+#define OV_CACHE_LINE_SIZE 64
+
+namespace ov
+{
+	// What to do when an item is enqueued to a full queue
+	enum class QueueOverflowPolicy : int8_t
+	{
+		// Reject the new item, so that the caller can apply backpressure
+		RejectNewest,
+		// Discard the oldest item to keep the latency bounded (supported by MpscQueue only)
+		DropOldest
+	};
+
+	// Lets the consumers of a lock-free queue sleep while the queue is empty.
+	//
+	// The producers take the mutex only when somebody is sleeping,
+	// so a busy queue never touches the mutex and the condition variable.
+	class QueueWaiter
+	{
+	public:
+		// Called by the producers after an item is published
+		void Notify()
+		{
+			// Pairs with the fence in Wait(): either the producer sees the waiter, or the waiter sees the item
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			if (_waiter_count.load(std::memory_order_relaxed) > 0)
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_condition.notify_one();
+			}
+		}
+
+		void NotifyAll()
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_condition.notify_all();
+		}
+
+		// Waits until try_pop() succeeds, stop_requested() becomes true, or the timeout expires
+		//
+		// @return true if try_pop() has succeeded
+		template <typename TryPop, typename IsStopRequested>
+		bool Wait(int timeout, TryPop try_pop, IsStopRequested is_stop_requested)
+		{
+			for (int count = 0; count < OV_LOCK_FREE_QUEUE_SPIN_COUNT; count++)
+			{
+				if (try_pop())
+				{
+					return true;
+				}
+
+				if (is_stop_requested())
+				{
+					return false;
+				}
+
+				std::this_thread::yield();
+			}
+
+			auto expire = (timeout == Infinite) ? std::chrono::steady_clock::time_point::max() : std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+			std::unique_lock<std::mutex> lock(_mutex);
+
+			while (true)
+			{
+				_waiter_count.fetch_add(1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				if (try_pop())
+				{
+					_waiter_count.fetch_sub(1, std::memory_order_relaxed);
+					return true;
+				}
+
+				if (is_stop_requested())
+				{
+					_waiter_count.fetch_sub(1, std::memory_order_relaxed);
+					return false;
+				}
+
+				auto status = (timeout == Infinite) ? (_condition.wait(lock), std::cv_status::no_timeout) : _condition.wait_until(lock, expire);
+
+				_waiter_count.fetch_sub(1, std::memory_order_relaxed);
+
+				if (status == std::cv_status::timeout)
+				{
+					// An item may have arrived just before the timeout
+					return try_pop();
+				}
+			}
+		}
+
+	private:
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		std::atomic<int> _waiter_count{0};
+	};
+
+	// Bounded lock-free ring buffer for exactly one producer thread and one consumer thread at a time
+	//
+	// The producer (or consumer) may move to another thread as long as the handover is synchronized
+	// (e.g. a task that is run by one pool thread at a time).
+	template <typename T>
+	class SpscQueue
+	{
+	public:
+		// The capacity is rounded up to a power of two.
+		// QueueOverflowPolicy::DropOldest is not supported because the producer cannot pop the queue.
+		explicit SpscQueue(size_t capacity, [[maybe_unused]] QueueOverflowPolicy policy = QueueOverflowPolicy::RejectNewest)
+			: _capacity(RoundUpToPowerOfTwo(capacity)),
+			  _mask(_capacity - 1),
+			  _buffer(new T[_capacity])
+		{
+			OV_ASSERT(policy == QueueOverflowPolicy::RejectNewest, "SpscQueue cannot drop the oldest item");
+		}
+
+		// Called by the producer
+		//
+		// @return false if the queue is full or stopped
+		bool Enqueue(T &&item)
+		{
+			if (_stop.load(std::memory_order_relaxed))
+			{
+				return false;
+			}
+
+			auto tail = _tail.load(std::memory_order_relaxed);
+
+			if ((tail - _cached_head) >= _capacity)
+			{
+				_cached_head = _head.load(std::memory_order_acquire);
+
+				if ((tail - _cached_head) >= _capacity)
+				{
+					_rejected_count.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+			}
+
+			_buffer[tail & _mask] = std::move(item);
+			_tail.store(tail + 1, std::memory_order_release);
+
+			UpdateHighWaterMark(Size());
+
+			_waiter.Notify();
+
+			return true;
+		}
+
+		// Called by the consumer
+		std::optional<T> TryDequeue()
+		{
+			T item;
+
+			if (TryPop(item))
+			{
+				return item;
+			}
+
+			return {};
+		}
+
+		// Called by the consumer, timeout in milliseconds
+		std::optional<T> Dequeue(int timeout = Infinite)
+		{
+			T item;
+
+			if (_waiter.Wait(
+					timeout,
+					[&]() -> bool { return TryPop(item); },
+					[&]() -> bool { return _stop.load(std::memory_order_relaxed); }))
+			{
+				return item;
+			}
+
+			return {};
+		}
+
+		// Called by the consumer
+		void Clear()
+		{
+			T item;
+
+			while (TryPop(item))
+			{
+			}
+		}
+
+		void Stop()
+		{
+			_stop = true;
+			_waiter.NotifyAll();
+		}
+
+		bool IsStopped() const
+		{
+			return _stop;
+		}
+
+		bool IsEmpty() const
+		{
+			return Size() == 0;
+		}
+
+		size_t Size() const
+		{
+			auto head = _head.load(std::memory_order_acquire);
+			auto tail = _tail.load(std::memory_order_acquire);
+
+			return (tail > head) ? (tail - head) : 0;
+		}
+
+		size_t GetCapacity() const
+		{
+			return _capacity;
+		}
+
+		// The largest number of items that have been queued at once
+		size_t GetHighWaterMark() const
+		{
+			return _high_water_mark.load(std::memory_order_relaxed);
+		}
+
+		uint64_t GetRejectedCount() const
+		{
+			return _rejected_count.load(std::memory_order_relaxed);
+		}
+
+		uint64_t GetDroppedCount() const
+		{
+			return 0;
+		}
+
+	private:
+		static size_t RoundUpToPowerOfTwo(size_t value)
+		{
+			size_t result = 2;
+
+			while (result < value)
+			{
+				result <<= 1;
+			}
+
+			return result;
+		}
+
+		bool TryPop(T &item)
+		{
+			auto head = _head.load(std::memory_order_relaxed);
+
+			if (head == _cached_tail)
+			{
+				_cached_tail = _tail.load(std::memory_order_acquire);
+
+				if (head == _cached_tail)
+				{
+					return false;
+				}
+			}
+
+			auto &slot = _buffer[head & _mask];
+			item = std::move(slot);
+			// Release the resources of the item (e.g. std::shared_ptr) as soon as possible
+			slot = T();
+
+			_head.store(head + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		void UpdateHighWaterMark(size_t size)
+		{
+			if (size > _high_water_mark.load(std::memory_order_relaxed))
+			{
+				_high_water_mark.store(size, std::memory_order_relaxed);
+			}
+		}
+
+		const size_t _capacity;
+		const size_t _mask;
+		std::unique_ptr<T[]> _buffer;
+
+		// Written by the consumer
+		alignas(OV_CACHE_LINE_SIZE) std::atomic<size_t> _head{0};
+		size_t _cached_tail = 0;
+
+		// Written by the producer
+		alignas(OV_CACHE_LINE_SIZE) std::atomic<size_t> _tail{0};
+		size_t _cached_head = 0;
+		std::atomic<size_t> _high_water_mark{0};
+		std::atomic<uint64_t> _rejected_count{0};
+
+		alignas(OV_CACHE_LINE_SIZE) std::atomic<bool> _stop{false};
+		QueueWaiter _waiter;
+	};
+
+	// Bounded lock-free ring buffer for multiple producers
+	//
+	// Each slot has a sequence number that tells whether it is ready to be written or read,
+	// so the producers only compete for the enqueue position with a CAS and never block each other.
+	// Dequeuing is also safe from any thread, which is used to drop the oldest item when the queue is full.
+	template <typename T>
+	class MpscQueue
+	{
+	public:
+		// The capacity is rounded up to a power of two
+		explicit MpscQueue(size_t capacity, QueueOverflowPolicy policy = QueueOverflowPolicy::RejectNewest)
+			: _capacity(RoundUpToPowerOfTwo(capacity)),
+			  _mask(_capacity - 1),
+			  _policy(policy),
+			  _buffer(new Slot[_capacity])
+		{
+			for (size_t index = 0; index < _capacity; index++)
+			{
+				_buffer[index].sequence.store(index, std::memory_order_relaxed);
+			}
+		}
+
+		// @return false if the item is rejected or the queue is stopped
+		bool Enqueue(T &&item)
+		{
+			if (_stop.load(std::memory_order_relaxed))
+			{
+				return false;
+			}
+
+			while (TryPush(item) == false)
+			{
+				if (_policy == QueueOverflowPolicy::RejectNewest)
+				{
+					_rejected_count.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+
+				// Make room for the new item
+				T oldest;
+
+				if (TryPop(oldest))
+				{
+					_dropped_count.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+
+			UpdateHighWaterMark(Size());
+
+			_waiter.Notify();
+
+			return true;
+		}
+
+		std::optional<T> TryDequeue()
+		{
+			T item;
+
+			if (TryPop(item))
+			{
+				return item;
+			}
+
+			return {};
+		}
+
+		// Timeout in milliseconds
+		std::optional<T> Dequeue(int timeout = Infinite)
+		{
+			T item;
+
+			if (_waiter.Wait(
+					timeout,
+					[&]() -> bool { return TryPop(item); },
+					[&]() -> bool { return _stop.load(std::memory_order_relaxed); }))
+			{
+				return item;
+			}
+
+			return {};
+		}
+
+		void Clear()
+		{
+			T item;
+
+			while (TryPop(item))
+			{
+			}
+		}
+
+		void Stop()
+		{
+			_stop = true;
+			_waiter.NotifyAll();
+		}
+
+		bool IsStopped() const
+		{
+			return _stop;
+		}
+
+		bool IsEmpty() const
+		{
+			return Size() == 0;
+		}
+
+		size_t Size() const
+		{
+			auto dequeue_position = _dequeue_position.load(std::memory_order_acquire);
+			auto enqueue_position = _enqueue_position.load(std::memory_order_acquire);
+
+			return (enqueue_position > dequeue_position) ? (enqueue_position - dequeue_position) : 0;
+		}
+
+		size_t GetCapacity() const
+		{
+			return _capacity;
+		}
+
+		// The largest number of items that have been queued at once
+		size_t GetHighWaterMark() const
+		{
+			return _high_water_mark.load(std::memory_order_relaxed);
+		}
+
+		uint64_t GetRejectedCount() const
+		{
+			return _rejected_count.load(std::memory_order_relaxed);
+		}
+
+		uint64_t GetDroppedCount() const
+		{
+			return _dropped_count.load(std::memory_order_relaxed);
+		}
+
+	private:
+		struct Slot
+		{
+			std::atomic<size_t> sequence;
+			T item;
+		};
+
+		static size_t RoundUpToPowerOfTwo(size_t value)
+		{
+			size_t result = 2;
+
+			while (result < value)
+			{
+				result <<= 1;
+			}
+
+			return result;
+		}
+
+		// item is moved only if it succeeds
+		bool TryPush(T &item)
+		{
+			auto position = _enqueue_position.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				auto &slot = _buffer[position & _mask];
+				auto sequence = slot.sequence.load(std::memory_order_acquire);
+				auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+				if (diff == 0)
+				{
+					if (_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						slot.item = std::move(item);
+						slot.sequence.store(position + 1, std::memory_order_release);
+
+						return true;
+					}
+
+					// position is updated by compare_exchange_weak()
+				}
+				else if (diff < 0)
+				{
+					// Full
+					return false;
+				}
+				else
+				{
+					position = _enqueue_position.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		bool TryPop(T &item)
+		{
+			auto position = _dequeue_position.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				auto &slot = _buffer[position & _mask];
+				auto sequence = slot.sequence.load(std::memory_order_acquire);
+				auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+				if (diff == 0)
+				{
+					if (_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						item = std::move(slot.item);
+						// Release the resources of the item (e.g. std::shared_ptr) as soon as possible
+						slot.item = T();
+						slot.sequence.store(position + _mask + 1, std::memory_order_release);
+
+						return true;
+					}
+				}
+				else if (diff < 0)
+				{
+					// Empty
+					return false;
+				}
+				else
+				{
+					position = _dequeue_position.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		void UpdateHighWaterMark(size_t size)
+		{
+			auto high_water_mark = _high_water_mark.load(std::memory_order_relaxed);
+
+			while ((size > high_water_mark) && (_high_water_mark.compare_exchange_weak(high_water_mark, size, std::memory_order_relaxed) == false))
+			{
+			}
+		}
+
+		const size_t _capacity;
+		const size_t _mask;
+		const QueueOverflowPolicy _policy;
+		std::unique_ptr<Slot[]> _buffer;
+
+		alignas(OV_CACHE_LINE_SIZE) std::atomic<size_t> _enqueue_position{0};
+		alignas(OV_CACHE_LINE_SIZE) std::atomic<size_t> _dequeue_position{0};
+
+		alignas(OV_CACHE_LINE_SIZE) std::atomic<size_t> _high_water_mark{0};
+		std::atomic<uint64_t> _rejected_count{0};
+		std::atomic<uint64_t> _dropped_count{0};
+
+		std::atomic<bool> _stop{false};
+		QueueWaiter _waiter;
+	};
+}  // namespace ov
@@ -12,6 +12,7 @@
 #include "./log.h"
 #include "./assert.h"
 #include "./log_write.h"
+#include "./log_queue.h"
 
 #include <unistd.h>
 #include <sys/syscall.h>
@@ -22,6 +23,7 @@
 #include <chrono>
 #include <regex>
 #include <mutex>
+#include <unordered_map>
 
 #if DEBUG
 #   define OV_LOG_SHOW_FILE_NAME                1
@@ -80,6 +82,13 @@ namespace ov
 		{
 		}
 
+		~LogInternal()
+		{
+			// Write the logs that are still queued, and write the next logs directly
+			_is_async = false;
+			LogQueue::GetInstance()->Flush();
+		}
+
 		/// 모든 log에 1차적으로 적용되는 filter 규칙
 		///
 		/// @param level level 이상의 로그만 표시함
@@ -95,6 +104,9 @@ namespace ov
 			_enable_map.clear();
 
 			_enable_list.clear();
+
+			// Invalidate the caches of the threads
+			_enable_generation++;
 		}
 
 		/// @param tag_regex tag 패턴
@@ -115,6 +127,7 @@ namespace ov
 
 			// 캐시 모두 삭제
 			_enable_map.clear();
+			_enable_generation++;
 
 			try
 			{
@@ -149,10 +162,79 @@ namespace ov
 
 		inline int64_t GetThreadId()
 		{
-			return (int64_t)::syscall(SYS_gettid); // NOLINT
+			static thread_local int64_t thread_id = (int64_t)::syscall(SYS_gettid); // NOLINT
+
+			return thread_id;
 		}
 
 		inline bool IsEnabled(const char *tag, OVLogLevel level)
+		{
+			// Look up the cache of the current thread first, so the logs do not contend for _mutex.
+			// The cache is keyed by the address of the tag (it is usually a string literal),
+			// and is invalidated when the settings are changed (_enable_generation)
+			struct CacheKey
+			{
+				bool operator==(const CacheKey &key) const
+				{
+					return (log_internal == key.log_internal) && (tag == key.tag);
+				}
+
+				const LogInternal *log_internal;
+				const char *tag;
+			};
+
+			struct CacheKeyHash
+			{
+				size_t operator()(const CacheKey &key) const
+				{
+					return std::hash<const void *>()(key.log_internal) ^ std::hash<const void *>()(key.tag);
+				}
+			};
+
+			struct CachedItem
+			{
+				uint32_t generation = 0;
+				// To check if the tag is changed at the same address
+				std::string tag;
+				OVLogLevel level = OVLogLevelInformation;
+				bool is_enabled = true;
+			};
+
+			static thread_local std::unordered_map<CacheKey, CachedItem, CacheKeyHash> cache;
+
+			auto generation = _enable_generation.load(std::memory_order_acquire);
+			auto &cached_item = cache[{this, tag}];
+
+			if ((cached_item.generation != generation) || (cached_item.tag != tag))
+			{
+				auto enable_item = GetEnableItem(tag);
+
+				cached_item.generation = generation;
+				cached_item.tag = tag;
+				cached_item.level = enable_item.level;
+				cached_item.is_enabled = enable_item.is_enabled;
+			}
+
+			if(level >= cached_item.level)
+			{
+				// 지정한 log level에 대해, 입력된 활성화 여부 반환
+				return cached_item.is_enabled;
+			}
+
+			// level 미만의 레벨은 활성화 여부와 반대로 동작
+			return !cached_item.is_enabled;
+		}
+
+	protected:
+		struct EnableItem
+		{
+			std::shared_ptr<std::regex> regex;
+			OVLogLevel level;
+			bool is_enabled;
+			ov::String regex_string;
+		};
+
+		inline EnableItem GetEnableItem(const char *tag)
 		{
 			std::lock_guard<std::mutex> lock(_mutex);
 
@@ -189,20 +271,60 @@ namespace ov
 				{
 					// 위에서 항목을 추가하였으므로, 절대로 여기로 진입하면 안됨
 					OV_ASSERT2(false);
-					return false;
+					return (EnableItem){
+						.regex = nullptr,
+						.level = OVLogLevelInformation,
+						.is_enabled = true
+					};
 				}
 			}
 
-			if(level >= item->second.level)
+			return item->second;
+		}
+
+		// Formats the date and time ([yyyy-mm-dd hh:mm:ss.sss]) of now.
+		// localtime_r() is called only once per second in each thread
+		inline const char *GetTimeString()
+		{
+			struct TimeCache
 			{
-				// 지정한 log level에 대해, 입력된 활성화 여부 반환
-				return item->second.is_enabled;
+				std::time_t time = -1;
+				// Length of "[yyyy-mm-dd hh:mm:ss" (or "[mm-dd hh:mm:ss")
+				int length = 0;
+				char buffer[64] {};
+			};
+
+			static thread_local TimeCache time_cache;
+
+			auto current = std::chrono::system_clock::now();
+			auto mseconds = std::chrono::duration_cast<std::chrono::milliseconds>(current.time_since_epoch()).count();
+			std::time_t time = static_cast<std::time_t>(mseconds / 1000);
+
+			if(time != time_cache.time)
+			{
+				std::tm local_time {};
+				::localtime_r(&time, &local_time);
+
+				time_cache.time = time;
+				time_cache.length = ::snprintf(time_cache.buffer, sizeof(time_cache.buffer),
+#if DEBUG
+											   // DEBUG 모드일 땐 년도 표시 안함
+											   "[%02d-%02d %02d:%02d:%02d",
+											   local_time.tm_mon + 1, local_time.tm_mday,
+#else // DEBUG
+											   // DEBUG 모드가 아닐 땐 년도 표시
+											   "[%04d-%02d-%02d %02d:%02d:%02d",
+											   1900 + local_time.tm_year, local_time.tm_mon + 1, local_time.tm_mday,
+#endif // DEBUG
+											   local_time.tm_hour, local_time.tm_min, local_time.tm_sec);
 			}
 
-			// level 미만의 레벨은 활성화 여부와 반대로 동작
-			return !item->second.is_enabled;
+			::snprintf(time_cache.buffer + time_cache.length, sizeof(time_cache.buffer) - time_cache.length, ".%03d]", static_cast<int>(mseconds % 1000));
+
+			return time_cache.buffer;
 		}
 
+	public:
 		inline void Log(bool show_format, OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, va_list &arg_list)
 		{
 			if(level < _level)
@@ -230,44 +352,11 @@ namespace ov
 				"C"
 			};
 
-			const char *color_prefix[] = {
-				OV_LOG_COLOR_FG_CYAN,
-				OV_LOG_COLOR_FG_WHITE,
-				OV_LOG_COLOR_FG_YELLOW,
-				OV_LOG_COLOR_FG_BR_RED,
-				OV_LOG_COLOR_FG_BR_WHITE OV_LOG_COLOR_BG_RED // NOLINT
-			};
-
-			const char *color_suffix[] = {
-				OV_LOG_COLOR_RESET,
-				OV_LOG_COLOR_RESET,
-				OV_LOG_COLOR_RESET,
-				OV_LOG_COLOR_RESET,
-				OV_LOG_COLOR_RESET
-			};
-
-			// 현재 시각의 milliseconds를 얻어옴
-			auto current = std::chrono::system_clock::now();
-			auto mseconds = std::chrono::duration_cast<std::chrono::milliseconds>(current.time_since_epoch()).count() % 1000;
-
-			// 시/분/초를 얻어옴
-			std::time_t time = std::time(nullptr);
-			std::tm localTime {};
-			::localtime_r(&time, &localTime);
-
 			ov::String log;
 
 #if OV_LOG_SHOW_FILE_NAME
-			ov::String fileName = file;
-
-			{
-				ssize_t position = fileName.IndexOfRev('/');
-
-				if(position >= 0)
-				{
-					fileName = fileName.Substring(position + 1);
-				}
-			}
+			const char *fileName = ::strrchr(file, '/');
+			fileName = (fileName != nullptr) ? (fileName + 1) : file;
 #endif // OV_LOG_SHOW_FILE_NAME
 
 #if OV_LOG_SHOW_FUNCTION_NAME
@@ -298,13 +387,7 @@ namespace ov
 						   // color
 						   "%s"
 						   // date, time ([mm-dd hh:mm:ss.sss])
-						   #if DEBUG
-						   // DEBUG 모드일 땐 년도 표시 안함
-						   "[%02d-%02d %02d:%02d:%02d.%03d]"
-						   #else // DEBUG
-						   // DEBUG 모드가 아닐 땐 년도 표시
-		           "[%04d-%02d-%02d %02d:%02d:%02d.%03d]"
-						   #endif // DEBUG
+						   "%s"
 						   // <log level>
 						   " %s"
 						   // <thread id>
@@ -323,18 +406,13 @@ namespace ov
 #endif // OV_LOG_SHOW_FUNCTION_NAME
 						,
 						   "",
-#if DEBUG
-						   localTime.tm_mon + 1, localTime.tm_mday,
-#else // DEBUG
-						1900 + localTime.tm_year, localTime.tm_mon + 1, localTime.tm_mday,
-#endif // DEBUG
-						   localTime.tm_hour, localTime.tm_min, localTime.tm_sec, mseconds,
+						   GetTimeString(),
 						   log_level[level],
 						   GetThreadId(),
 						   (tag[0] == '\0') ? "" : " ", tag
 
 #if OV_LOG_SHOW_FILE_NAME
-						, fileName.CStr(), line
+						, fileName, line
 #endif // OV_LOG_SHOW_FILE_NAME
 #if OV_LOG_SHOW_FUNCTION_NAME
 						, func.CStr()
@@ -344,21 +422,55 @@ namespace ov
 
 			// 맨 뒤에 <message> 추가
 			log.AppendVFormat(format, &(arg_list[0]));
-			if(show_format)
+
+			LogRecord record {
+				.target = this,
+				.level = level,
+				.show_format = show_format,
+				.log = std::move(log)
+			};
+
+			// The critical logs are written immediately, since the process may not be able to continue
+			if((level >= OVLogLevelCritical) || (_is_async == false) || (LogQueue::GetInstance()->Push(std::move(record)) == false))
 			{
-				if(level < OVLogLevelWarning)
+				Write(record);
+			}
+		}
+
+		// Writes the log to the console and the file (Called by the writer thread of LogQueue)
+		inline void Write(const LogRecord &record)
+		{
+			const char *color_prefix[] = {
+				OV_LOG_COLOR_FG_CYAN,
+				OV_LOG_COLOR_FG_WHITE,
+				OV_LOG_COLOR_FG_YELLOW,
+				OV_LOG_COLOR_FG_BR_RED,
+				OV_LOG_COLOR_FG_BR_WHITE OV_LOG_COLOR_BG_RED // NOLINT
+			};
+
+			const char *color_suffix[] = {
+				OV_LOG_COLOR_RESET,
+				OV_LOG_COLOR_RESET,
+				OV_LOG_COLOR_RESET,
+				OV_LOG_COLOR_RESET,
+				OV_LOG_COLOR_RESET
+			};
+
+			if(record.show_format)
+			{
+				if(record.level < OVLogLevelWarning)
 				{
-					fprintf(stdout, "%s%s%s\n", color_prefix[level], log.CStr(), color_suffix[level]);
+					fprintf(stdout, "%s%s%s\n", color_prefix[record.level], record.log.CStr(), color_suffix[record.level]);
 					fflush(stdout);
 				}
 				else
 				{
-					fprintf(stderr, "%s%s%s\n", color_prefix[level], log.CStr(), color_suffix[level]);
+					fprintf(stderr, "%s%s%s\n", color_prefix[record.level], record.log.CStr(), color_suffix[record.level]);
 					fflush(stderr);
 				}
 			}
 
-            _log_file.Write(log.CStr());
+            _log_file.Write(record.log.CStr());
 		}
 
         inline void SetLogPath(const char* log_path)
@@ -367,21 +479,17 @@ namespace ov
         }
 
 	protected:
-		OVLogLevel _level;
+		std::atomic<OVLogLevel> _level;
 
 		std::mutex _mutex;
 
         LogWrite _log_file;
 
-		struct EnableItem
-		{
-			std::shared_ptr<std::regex> regex;
-			OVLogLevel level;
-			bool is_enabled;
-			ov::String regex_string;
-		};
+		std::atomic<bool> _is_async{true};
 
 		std::vector<EnableItem> _enable_list;
+		// Increased whenever the settings are changed (the caches of the threads are invalidated)
+		std::atomic<uint32_t> _enable_generation{1};
 
 		// 캐시 용도
 		// key: tag
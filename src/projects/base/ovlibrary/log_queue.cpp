@@ -0,0 +1,161 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "log_queue.h"
+
+#include "log_internal.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+// How long the writer sleeps when there is no log (The producers wake it up)
+#define OV_LOG_QUEUE_WRITER_INTERVAL (100)
+
+namespace ov
+{
+	LogQueue *LogQueue::GetInstance()
+	{
+		// Never released, because the logs can be written while the static objects are being destroyed
+		static auto instance = new LogQueue();
+
+		return instance;
+	}
+
+	LogQueue::LogQueue()
+	{
+		_is_running = true;
+
+		_writer_thread = std::thread(&LogQueue::WriterThread, this);
+		_writer_thread.detach();
+	}
+
+	std::shared_ptr<LogQueue::ThreadQueue> LogQueue::GetThreadQueue()
+	{
+		struct ThreadQueueHolder
+		{
+			~ThreadQueueHolder()
+			{
+				if (queue != nullptr)
+				{
+					queue->is_detached = true;
+				}
+			}
+
+			std::shared_ptr<ThreadQueue> queue;
+		};
+
+		static thread_local ThreadQueueHolder holder;
+
+		if (holder.queue == nullptr)
+		{
+			holder.queue = std::make_shared<ThreadQueue>();
+
+			std::lock_guard<std::mutex> lock_guard(_queue_list_mutex);
+			_queue_list.push_back(holder.queue);
+		}
+
+		return holder.queue;
+	}
+
+	bool LogQueue::Push(LogRecord &&record)
+	{
+		if (_is_running == false)
+		{
+			return false;
+		}
+
+		auto thread_queue = GetThreadQueue();
+
+		// If the queue is full, the log is dropped (SpscQueue counts it)
+		if (thread_queue->queue.Enqueue(std::move(record)))
+		{
+			_pending_count.fetch_add(1, std::memory_order_relaxed);
+			_waiter.Notify();
+		}
+
+		return true;
+	}
+
+	void LogQueue::Flush()
+	{
+		while (Drain())
+		{
+		}
+	}
+
+	bool LogQueue::Drain()
+	{
+		std::lock_guard<std::mutex> drain_lock_guard(_drain_mutex);
+
+		std::vector<std::shared_ptr<ThreadQueue>> queue_list;
+
+		{
+			std::lock_guard<std::mutex> lock_guard(_queue_list_mutex);
+			queue_list = _queue_list;
+		}
+
+		bool is_written = false;
+		bool has_detached_queue = false;
+
+		for (auto &thread_queue : queue_list)
+		{
+			while (true)
+			{
+				auto record = thread_queue->queue.TryDequeue();
+
+				if (record.has_value() == false)
+				{
+					break;
+				}
+
+				_pending_count.fetch_sub(1, std::memory_order_relaxed);
+
+				record->target->Write(record.value());
+				is_written = true;
+			}
+
+			auto dropped_count = thread_queue->queue.GetRejectedCount();
+
+			if (dropped_count != thread_queue->reported_dropped_count)
+			{
+				// This log is queued to the queue of the current thread, and written in the next turn
+				logw("Log", "%" PRIu64 " logs are dropped since the log queue is full", dropped_count - thread_queue->reported_dropped_count);
+				thread_queue->reported_dropped_count = dropped_count;
+			}
+
+			has_detached_queue = has_detached_queue || thread_queue->is_detached;
+		}
+
+		if (has_detached_queue)
+		{
+			std::lock_guard<std::mutex> lock_guard(_queue_list_mutex);
+
+			_queue_list.erase(std::remove_if(_queue_list.begin(), _queue_list.end(), [](const std::shared_ptr<ThreadQueue> &thread_queue) -> bool {
+								  return thread_queue->is_detached && thread_queue->queue.IsEmpty();
+							  }),
+							  _queue_list.end());
+		}
+
+		return is_written;
+	}
+
+	void LogQueue::WriterThread()
+	{
+		while (_is_running)
+		{
+			// The logs are written outside of the waiter, so the producers that notify it are not blocked by the I/O
+			while (Drain())
+			{
+			}
+
+			_waiter.Wait(
+				OV_LOG_QUEUE_WRITER_INTERVAL,
+				[this]() -> bool { return _pending_count.load(std::memory_order_relaxed) > 0; },
+				[this]() -> bool { return _is_running == false; });
+		}
+	}
+}  // namespace ov
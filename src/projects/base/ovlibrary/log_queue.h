@@ -0,0 +1,84 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "./lock_free_queue.h"
+#include "./log.h"
+#include "./string.h"
+
+#include <vector>
+
+// Number of the logs that can be queued by a thread
+#define OV_LOG_QUEUE_SIZE (4096)
+
+namespace ov
+{
+	class LogInternal;
+
+	struct LogRecord
+	{
+		LogInternal *target = nullptr;
+		OVLogLevel level = OVLogLevelDebug;
+		bool show_format = false;
+		ov::String log;
+	};
+
+	// Writes the logs (console and file) in a dedicated thread
+	//
+	// Each thread that writes a log has its own SpscQueue, so the threads do not contend with each other
+	// or wait for the I/O. If the queue of a thread is full, the log is dropped and counted,
+	// and the writer reports how many logs are dropped.
+	class LogQueue
+	{
+	public:
+		static LogQueue *GetInstance();
+
+		// @return false if the writer is not running (the caller should write the log by itself)
+		bool Push(LogRecord &&record);
+
+		// Writes all the queued logs
+		void Flush();
+
+	protected:
+		struct ThreadQueue
+		{
+			ThreadQueue()
+				: queue(OV_LOG_QUEUE_SIZE)
+			{
+			}
+
+			SpscQueue<LogRecord> queue;
+			// The thread is terminated (the queue is removed after it is drained)
+			std::atomic<bool> is_detached{false};
+
+			// Used by the writer only
+			uint64_t reported_dropped_count = 0;
+		};
+
+		LogQueue();
+
+		std::shared_ptr<ThreadQueue> GetThreadQueue();
+
+		// @return true if any log is written
+		bool Drain();
+		void WriterThread();
+
+		std::mutex _queue_list_mutex;
+		std::vector<std::shared_ptr<ThreadQueue>> _queue_list;
+
+		// Serializes the consumers (the writer thread and Flush())
+		std::mutex _drain_mutex;
+
+		// Number of the logs that are queued but not written yet (The writer waits until it becomes non-zero)
+		std::atomic<int64_t> _pending_count{0};
+
+		QueueWaiter _waiter;
+		std::atomic<bool> _is_running{false};
+		std::thread _writer_thread;
+	};
+}  // namespace ov
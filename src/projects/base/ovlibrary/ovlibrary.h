@@ -14,11 +14,13 @@
 #include "./byte_ordering.h"
 #include "./byte_stream.h"
 #include "./data.h"
+#include "./data_pool.h"
 #include "./delay_queue.h"
 #include "./dump_utilities.h"
 #include "./enable_shared_from_this.h"
 #include "./error.h"
 #include "./json.h"
+#include "./lock_free_queue.h"
 #include "./log.h"
 #include "./memory_utilities.h"
 #include "./path_manager.h"
@@ -37,8 +37,8 @@ std::string_view Trim(const std::string_view &value)
     {
         ++back;
     }
-    const size_t length = back.base() == front ? 1 : back.base() - front + 1;
-    return std::string_view(front, length);
+    // back.base() is the position next to the last character that is not a space
+    return std::string_view(front, back.base() - front);
 }
 
 std::string_view operator "" _str_v(const char *str, size_t length)
@@ -14,8 +14,10 @@
 #include <cstdarg>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <memory>
 #include <map>
+#include <string_view>
 #include <vector>
 
 namespace ov
@@ -150,3 +152,16 @@ namespace ov
 		}
 	};
 }
+
+namespace std
+{
+	// To use ov::String as a key of std::unordered_map/std::unordered_set
+	template <>
+	struct hash<ov::String>
+	{
+		size_t operator()(const ov::String &string) const noexcept
+		{
+			return std::hash<std::string_view>()(std::string_view(string.CStr(), string.GetLength()));
+		}
+	};
+}  // namespace std
@@ -112,25 +112,31 @@ namespace ov
 
 		object->_source = url.c_str();
 
-		// <scheme>://<domain>[:<port>][/<path/to/resource>][?<query string>]
+		// <scheme>://[<id>[:<password>]@]<domain>[:<port>][/<path/to/resource>][?<query string>]
 		// Group 1: <scheme>
-		// Group 2: <domain>
-		// Group 3: :<port>
-		// Group 4: <port>
-		// Group 5: /<path>
-		// Group 6: <path>
-		// Group 7: ?<query string>
-		// Group 8: <query string>
-		if (std::regex_search(url, matches, std::regex(R"((.+?)://([^:/]+)(:([0-9]+))?(/([^\?]+)?)?(\?([^\?]+)?(.+)?)?)")) == false)
+		// Group 2: <id>[:<password>]@
+		// Group 3: <id>
+		// Group 4: :<password>
+		// Group 5: <password>
+		// Group 6: <domain>
+		// Group 7: :<port>
+		// Group 8: <port>
+		// Group 9: /<path>
+		// Group 10: <path>
+		// Group 11: ?<query string>
+		// Group 12: <query string>
+		if (std::regex_search(url, matches, std::regex(R"((.+?)://(([^:@/]+)(:([^@/]*))?@)?([^:/]+)(:([0-9]+))?(/([^\?]+)?)?(\?([^\?]+)?(.+)?)?)")) == false)
 		{
 			return nullptr;
 		}
 
 		object->_scheme = std::string(matches[1]).c_str();
-		object->_domain = std::string(matches[2]).c_str();
-		object->_port = ov::Converter::ToUInt32(std::string(matches[4]).c_str());
-		object->_path = std::string(matches[5]).c_str();
-		object->_query_string = std::string(matches[8]).c_str();
+		object->_id = Decode(std::string(matches[3]).c_str());
+		object->_password = Decode(std::string(matches[5]).c_str());
+		object->_domain = std::string(matches[6]).c_str();
+		object->_port = ov::Converter::ToUInt32(std::string(matches[8]).c_str());
+		object->_path = std::string(matches[9]).c_str();
+		object->_query_string = std::string(matches[12]).c_str();
 
 		// split <path> to /<app>/<stream>/<file> (4 tokens)
 		auto tokens = object->_path.Split("/");
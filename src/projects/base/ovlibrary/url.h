@@ -19,7 +19,7 @@ namespace ov
 		static ov::String Encode(const ov::String &value);
 		static ov::String Decode(const ov::String &value);
 
-		// <scheme>://<domain>[:<port>][/<path/to/resource>][?<query string>]
+		// <scheme>://[<id>[:<password>]@]<domain>[:<port>][/<path/to/resource>][?<query string>]
 		static std::shared_ptr<const Url> Parse(const std::string &url, bool make_query_map = false);
 
 		const ov::String &Source() const
@@ -32,6 +32,16 @@ namespace ov
 			return _scheme;
 		}
 
+		const ov::String &Id() const
+		{
+			return _id;
+		}
+
+		const ov::String &Password() const
+		{
+			return _password;
+		}
+
 		const ov::String &Domain() const
 		{
 			return _domain;
@@ -80,6 +90,8 @@ namespace ov
 		// Full URL
 		ov::String _source;
 		ov::String _scheme;
+		ov::String _id;
+		ov::String _password;
 		ov::String _domain;
 		uint32_t _port;
 		ov::String _path;
@@ -13,13 +13,24 @@
 
 // If no packet is sent during this time, the connection is disconnected
 #define CLIENT_SOCKET_SEND_TIMEOUT (60 * 1000)
+// How long the dispatch thread waits for POLLOUT at once, to check the timeout and the stop flag
+#define CLIENT_SOCKET_POLL_INTERVAL (100)
+
+// Default limits of the send queue
+#define CLIENT_SOCKET_SEND_QUEUE_LOW_WATERMARK (1 * 1024 * 1024)
+#define CLIENT_SOCKET_SEND_QUEUE_HIGH_WATERMARK (4 * 1024 * 1024)
+#define CLIENT_SOCKET_SEND_QUEUE_MAX_BYTES (32 * 1024 * 1024)
 
 namespace ov
 {
 	ClientSocket::ClientSocket(ServerSocket *server_socket)
 		: Socket(),
 
-		  _server_socket(server_socket)
+		  _server_socket(server_socket),
+
+		  _send_queue_low_watermark(CLIENT_SOCKET_SEND_QUEUE_LOW_WATERMARK),
+		  _send_queue_high_watermark(CLIENT_SOCKET_SEND_QUEUE_HIGH_WATERMARK),
+		  _send_queue_max_bytes(CLIENT_SOCKET_SEND_QUEUE_MAX_BYTES)
 	{
 		OV_ASSERT2(_server_socket != nullptr);
 
@@ -29,7 +40,11 @@ namespace ov
 	ClientSocket::ClientSocket(ServerSocket *server_socket, SocketWrapper socket, const SocketAddress &remote_address)
 		: Socket(socket, remote_address),
 
-		  _server_socket(server_socket)
+		  _server_socket(server_socket),
+
+		  _send_queue_low_watermark(CLIENT_SOCKET_SEND_QUEUE_LOW_WATERMARK),
+		  _send_queue_high_watermark(CLIENT_SOCKET_SEND_QUEUE_HIGH_WATERMARK),
+		  _send_queue_max_bytes(CLIENT_SOCKET_SEND_QUEUE_MAX_BYTES)
 	{
 		OV_ASSERT2(_server_socket != nullptr);
 
@@ -90,6 +105,11 @@ namespace ov
 
 	bool ClientSocket::SendAsync(const ClientSocket::DispatchCommand &send_item)
 	{
+		if (send_item.data_list.empty() == false)
+		{
+			return SendListAsync(send_item);
+		}
+
 		// An item is dequeued successfully
 		auto data = send_item.data->GetDataAs<uint8_t>();
 		auto remained = send_item.data->GetLength();
@@ -119,11 +139,61 @@ namespace ov
 			data += sent_bytes;
 			total_sent_bytes += sent_bytes;
 
+			OnDataSent(sent_bytes);
+
 			if (remained == 0)
 			{
 				// All data are sent
 				break;
 			}
+
+			// The socket buffer is full, wait until the client reads the data
+			WaitForWritable(CLIENT_SOCKET_POLL_INTERVAL);
+		}
+
+		return true;
+	}
+
+	bool ClientSocket::SendListAsync(const ClientSocket::DispatchCommand &send_item)
+	{
+		std::vector<struct iovec> iov_list;
+		size_t iov_index = 0;
+		size_t total_sent_bytes = 0ULL;
+
+		iov_list.reserve(send_item.data_list.size());
+
+		for (auto &data : send_item.data_list)
+		{
+			iov_list.push_back({const_cast<void *>(data->GetData()), data->GetLength()});
+		}
+
+		while ((_force_stop == false) && (iov_index < iov_list.size()))
+		{
+			// Wait for transmission up to CLIENT_SOCKET_SEND_TIMEOUT
+			if (send_item.IsExpired(CLIENT_SOCKET_SEND_TIMEOUT))
+			{
+				logtw("[%p] [#%d] Expired (%zu bytes sent)", this, _socket.GetSocket(), total_sent_bytes);
+				return false;
+			}
+
+			auto sent_bytes = SendInternal(iov_list, &iov_index);
+
+			if (sent_bytes < 0)
+			{
+				// An error occurred
+				logtw("[%p] [#%d] Could not send data (%zu bytes sent)", this, _socket.GetSocket(), total_sent_bytes);
+				return false;
+			}
+
+			total_sent_bytes += sent_bytes;
+
+			OnDataSent(sent_bytes);
+
+			if (iov_index < iov_list.size())
+			{
+				// The socket buffer is full, wait until the client reads the data
+				WaitForWritable(CLIENT_SOCKET_POLL_INTERVAL);
+			}
 		}
 
 		return true;
@@ -183,15 +253,125 @@ namespace ov
 
 		Socket::CloseInternal();
 
+		// Do not keep the caller of CallWhenSendQueueRelieved() waiting for the socket that is closed while it is congested
+		std::function<void()> callback;
+
+		{
+			std::lock_guard<std::mutex> lock_guard(_relieved_callback_mutex);
+			_is_dispatch_stopped = true;
+			callback = std::move(_relieved_callback);
+			_relieved_callback = nullptr;
+		}
+
+		if (callback != nullptr)
+		{
+			callback();
+		}
+
 		logtd("[%p] [#%d] Thread is stopped, queue: %zu", this, sock, _dispatch_queue.Size());
 	}
 
-	ssize_t ClientSocket::Send(const std::shared_ptr<const Data> &data)
+	void ClientSocket::SetSendQueueLimit(size_t low_watermark, size_t high_watermark, size_t max_bytes, SendQueuePolicy policy)
+	{
+		OV_ASSERT2((low_watermark <= high_watermark) && (high_watermark <= max_bytes));
+
+		_send_queue_low_watermark = low_watermark;
+		_send_queue_high_watermark = high_watermark;
+		_send_queue_max_bytes = max_bytes;
+		_send_queue_policy = policy;
+	}
+
+	size_t ClientSocket::GetSendQueueBytes() const
+	{
+		return _send_queue_bytes;
+	}
+
+	bool ClientSocket::IsSendQueueCongested() const
+	{
+		return _is_send_queue_congested;
+	}
+
+	void ClientSocket::CallWhenSendQueueRelieved(std::function<void()> callback)
+	{
+		{
+			std::lock_guard<std::mutex> lock_guard(_relieved_callback_mutex);
+
+			if (_is_send_queue_congested && (_is_dispatch_stopped == false))
+			{
+				// OnDataSent() will call it
+				_relieved_callback = std::move(callback);
+				return;
+			}
+		}
+
+		callback();
+	}
+
+	ssize_t ClientSocket::EnqueueSendCommand(DispatchCommand &&command, size_t length)
 	{
-		logtd("[%p] [#%d] Trying to enqueue data: %zu...", this, _socket.GetSocket(), data->GetLength());
-		_dispatch_queue.Enqueue(data);
+		// Reserves the bytes first, so that the concurrent senders cannot exceed max_bytes together
+		auto queued_bytes = _send_queue_bytes.fetch_add(length) + length;
+
+		if (queued_bytes > _send_queue_max_bytes)
+		{
+			// Roll back the reservation
+			queued_bytes = (_send_queue_bytes -= length);
+
+			switch (_send_queue_policy)
+			{
+				case SendQueuePolicy::Disconnect:
+					logtw("[%p] [#%d] The client is too slow to receive data (%zu bytes queued), disconnecting...", this, _socket.GetSocket(), queued_bytes);
+
+					// Let the epoll thread of the server detect the disconnection and notify the observers as usual
+					::shutdown(_socket.GetSocket(), SHUT_RDWR);
+					break;
+
+				case SendQueuePolicy::RejectNewest:
+					logtd("[%p] [#%d] The send queue is full (%zu bytes queued), %zu bytes are rejected", this, _socket.GetSocket(), queued_bytes, length);
+					break;
+			}
+
+			return -1LL;
+		}
+
+		if ((queued_bytes >= _send_queue_high_watermark) && (_is_send_queue_congested.exchange(true) == false))
+		{
+			logtd("[%p] [#%d] The send queue is congested (%zu bytes queued)", this, _socket.GetSocket(), queued_bytes);
+		}
+
+		logtd("[%p] [#%d] Trying to enqueue data: %zu...", this, _socket.GetSocket(), length);
+		_dispatch_queue.Enqueue(std::move(command));
 		logtd("[%p] [#%d] Enqueued", this, _socket.GetSocket());
-		return data->GetLength();
+
+		return length;
+	}
+
+	void ClientSocket::OnDataSent(size_t sent_bytes)
+	{
+		auto queued_bytes = (_send_queue_bytes -= sent_bytes);
+
+		if ((queued_bytes <= _send_queue_low_watermark) && _is_send_queue_congested.exchange(false))
+		{
+			logtd("[%p] [#%d] The send queue is relieved (%zu bytes queued)", this, _socket.GetSocket(), queued_bytes);
+
+			std::function<void()> callback;
+
+			{
+				std::lock_guard<std::mutex> lock_guard(_relieved_callback_mutex);
+				callback = std::move(_relieved_callback);
+				_relieved_callback = nullptr;
+			}
+
+			if (callback != nullptr)
+			{
+				callback();
+			}
+		}
+	}
+
+	ssize_t ClientSocket::Send(const std::shared_ptr<const Data> &data)
+	{
+		return EnqueueSendCommand(DispatchCommand(data), data->GetLength());
 	}
 
 	ssize_t ClientSocket::Send(const void *data, size_t length)
@@ -200,6 +380,19 @@ namespace ov
 		return Send(std::make_shared<const ov::Data>(data, length));
 	}
 
+	ssize_t ClientSocket::Send(const std::vector<std::shared_ptr<const Data>> &data_list)
+	{
+		size_t length = 0;
+
+		for (auto &data : data_list)
+		{
+			length += data->GetLength();
+		}
+
+		// The buffers are referenced until they are sent, so they must not be modified after this call
+		return EnqueueSendCommand(DispatchCommand(data_list), length);
+	}
+
 	ssize_t ClientSocket::Send(const ov::String &string, bool include_null_char)
 	{
 		return Send(string.ToData(include_null_char));
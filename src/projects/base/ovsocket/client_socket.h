@@ -10,8 +10,20 @@
 
 #include "socket.h"
 
+#include <atomic>
+
 namespace ov
 {
+	// What to do when the send queue of a client exceeds its limit (See ClientSocket::SetSendQueueLimit())
+	enum class SendQueuePolicy
+	{
+		// Disconnect the client, so that a slow consumer does not hold the memory
+		Disconnect,
+		// Reject the data (Send() returns -1) and keep the connection. The data is never sent partially,
+		// so the caller can skip it or switch to a lower bitrate
+		RejectNewest
+	};
+
 	// 일반적으로 사용되는 소켓 (server에서 생성한 client socket)
 	class ClientSocket : public Socket
 	{
@@ -24,8 +36,11 @@ namespace ov
 		~ClientSocket() override;
 
 		// 데이터 송신
+		// The data is queued and sent by the dispatch thread whenever the socket is writable.
+		// Returns -1 if the data is rejected by the send queue policy
 		ssize_t Send(const std::shared_ptr<const Data> &data) override;
 		ssize_t Send(const void *data, size_t length) override;
+		ssize_t Send(const std::vector<std::shared_ptr<const Data>> &data_list) override;
 
 		ssize_t Send(const ov::String &string, bool include_null_char = false);
 
@@ -46,6 +61,20 @@ namespace ov
 
 		bool Close() override;
 
+		// Backpressure
+		//
+		// The queue becomes congested when the queued bytes exceed high_watermark, and is relieved when they drop below low_watermark.
+		// When they would exceed max_bytes, policy is applied.
+		void SetSendQueueLimit(size_t low_watermark, size_t high_watermark, size_t max_bytes, SendQueuePolicy policy);
+		// Number of bytes that are queued but not sent yet
+		size_t GetSendQueueBytes() const;
+		bool IsSendQueueCongested() const;
+		// Calls the callback once when the send queue is relieved (by the dispatch thread), or when the socket is closed
+		// (the callback should check the state of the socket).
+		// If the queue is not congested or the socket is already closed, the callback is called immediately.
+		// Only one callback can be registered at a time (the previous one is replaced)
+		void CallWhenSendQueueRelieved(std::function<void()> callback);
+
 		using Socket::GetState;
 
 		String ToString() const override;
@@ -67,6 +96,13 @@ namespace ov
 			{
 			}
 
+			DispatchCommand(const std::vector<std::shared_ptr<const ov::Data>> &data_list)
+				: type(Type::SendData),
+				  data_list(data_list),
+				  enqueued_time(std::chrono::system_clock::now())
+			{
+			}
+
 			DispatchCommand(Type type)
 				: type(type),
 				  enqueued_time(std::chrono::system_clock::now())
@@ -82,13 +118,19 @@ namespace ov
 
 			Type type = Type::Unknown;
 			std::shared_ptr<const ov::Data> data;
+			// Used instead of data to send several buffers at once (scatter-gather)
+			std::vector<std::shared_ptr<const ov::Data>> data_list;
 			std::chrono::time_point<std::chrono::system_clock> enqueued_time;
 		};
 
 		bool StartDispatchThread();
 		bool StopDispatchThread(bool stop_immediately);
 
+		ssize_t EnqueueSendCommand(DispatchCommand &&command, size_t length);
+		void OnDataSent(size_t sent_bytes);
+
 		bool SendAsync(const ClientSocket::DispatchCommand &send_item);
+		bool SendListAsync(const ClientSocket::DispatchCommand &send_item);
 		void DispatchThreadStub(std::shared_ptr<ClientSocket> client_socket);
 		void DispatchThread();
 
@@ -103,6 +145,19 @@ namespace ov
 		ov::Queue<DispatchCommand> _dispatch_queue;
 		bool _is_thread_running = false;
 
+		size_t _send_queue_low_watermark;
+		size_t _send_queue_high_watermark;
+		size_t _send_queue_max_bytes;
+		SendQueuePolicy _send_queue_policy = SendQueuePolicy::Disconnect;
+
+		std::atomic<size_t> _send_queue_bytes{0};
+		std::atomic<bool> _is_send_queue_congested{false};
+
+		std::mutex _relieved_callback_mutex;
+		std::function<void()> _relieved_callback;
+		// The dispatch thread is stopped, so the send queue will never be relieved
+		bool _is_dispatch_stopped = false;
+
 		std::shared_ptr<ClientSocket> _instance;
 	};
 }  // namespace ov
@@ -0,0 +1,92 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "datagram_send_batch.h"
+
+#include "socket_private.h"
+
+namespace ov
+{
+	thread_local DatagramSendBatch *DatagramSendBatch::_current_batch = nullptr;
+
+	DatagramSendBatch::DatagramSendBatch()
+	{
+		if (_current_batch == nullptr)
+		{
+			_current_batch = this;
+			_is_outermost = true;
+		}
+	}
+
+	DatagramSendBatch::~DatagramSendBatch()
+	{
+		if (_is_outermost)
+		{
+			Flush();
+
+			_current_batch = nullptr;
+		}
+	}
+
+	ssize_t DatagramSendBatch::SendTo(const std::shared_ptr<DatagramSocket> &socket, const SocketAddress &address, const std::shared_ptr<const Data> &data)
+	{
+		OV_ASSERT2(socket != nullptr);
+		OV_ASSERT2(data != nullptr);
+
+		if (_current_batch == nullptr)
+		{
+			return socket->SendTo(address, data);
+		}
+
+		_current_batch->Enqueue(socket, address, data);
+
+		return data->GetLength();
+	}
+
+	void DatagramSendBatch::Enqueue(const std::shared_ptr<DatagramSocket> &socket, const SocketAddress &address, const std::shared_ptr<const Data> &data)
+	{
+		SocketBatch *socket_batch = nullptr;
+
+		for (auto &item : _socket_batch_list)
+		{
+			if (item.socket == socket)
+			{
+				socket_batch = &item;
+				break;
+			}
+		}
+
+		if (socket_batch == nullptr)
+		{
+			_socket_batch_list.push_back({socket, {}});
+			socket_batch = &(_socket_batch_list.back());
+			socket_batch->packet_list.reserve(DatagramBatchCount);
+		}
+
+		socket_batch->packet_list.push_back({address, data});
+
+		if (socket_batch->packet_list.size() >= static_cast<size_t>(DatagramBatchCount))
+		{
+			// Do not hold the packets longer than one sendmmsg() can carry
+			socket_batch->socket->SendTo(socket_batch->packet_list);
+			socket_batch->packet_list.clear();
+		}
+	}
+
+	void DatagramSendBatch::Flush()
+	{
+		for (auto &item : _socket_batch_list)
+		{
+			if (item.packet_list.empty() == false)
+			{
+				item.socket->SendTo(item.packet_list);
+			}
+		}
+
+		_socket_batch_list.clear();
+	}
+}  // namespace ov
@@ -0,0 +1,54 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "datagram_socket.h"
+
+namespace ov
+{
+	// Collects the datagrams sent by the current thread while the batch is alive,
+	// and sends them with DatagramSocket::SendTo(packet_list) when it goes out of scope.
+	//
+	//   {
+	//       ov::DatagramSendBatch batch;
+	//
+	//       // Queued
+	//       ov::DatagramSendBatch::SendTo(socket, address, data);
+	//       ...
+	//   }  // Sent here
+	//
+	// A nested batch does nothing, so the datagrams are sent by the outermost one.
+	// The data must not be modified until it is sent.
+	class DatagramSendBatch
+	{
+	public:
+		DatagramSendBatch();
+		~DatagramSendBatch();
+
+		// If a batch is active on the current thread, the datagram is queued to it. Otherwise it is sent immediately
+		static ssize_t SendTo(const std::shared_ptr<DatagramSocket> &socket, const SocketAddress &address, const std::shared_ptr<const Data> &data);
+
+		void Flush();
+
+	protected:
+		struct SocketBatch
+		{
+			std::shared_ptr<DatagramSocket> socket;
+			std::vector<DatagramPacket> packet_list;
+		};
+
+		void Enqueue(const std::shared_ptr<DatagramSocket> &socket, const SocketAddress &address, const std::shared_ptr<const Data> &data);
+
+		static thread_local DatagramSendBatch *_current_batch;
+
+		bool _is_outermost = false;
+
+		// A thread usually sends to a few sockets, so a linear search is enough
+		std::vector<SocketBatch> _socket_batch_list;
+	};
+}  // namespace ov
@@ -11,6 +11,59 @@
 #include "client_socket.h"
 #include "socket_private.h"
 
+#include <netinet/udp.h>
+
+#ifndef SOL_UDP
+#	define SOL_UDP IPPROTO_UDP
+#endif  // SOL_UDP
+
+#ifndef UDP_SEGMENT
+// Linux 4.18+ (include/uapi/linux/udp.h)
+#	define UDP_SEGMENT 103
+#endif  // UDP_SEGMENT
+
+#if defined(__APPLE__)
+int recvmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout)
+{
+	unsigned int index = 0;
+
+	for (; index < vlen; index++)
+	{
+		// Do not block after the first message, like recvmmsg() without MSG_WAITFORONE
+		ssize_t length = ::recvmsg(sockfd, &(msgvec[index].msg_hdr), (index == 0) ? flags : (flags | MSG_DONTWAIT));
+
+		if (length < 0)
+		{
+			// Reports the error only if nothing is received, the others are reported by the next call
+			return (index == 0) ? -1 : static_cast<int>(index);
+		}
+
+		msgvec[index].msg_len = static_cast<unsigned int>(length);
+	}
+
+	return static_cast<int>(index);
+}
+
+int sendmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+	unsigned int index = 0;
+
+	for (; index < vlen; index++)
+	{
+		ssize_t length = ::sendmsg(sockfd, &(msgvec[index].msg_hdr), flags);
+
+		if (length < 0)
+		{
+			return (index == 0) ? -1 : static_cast<int>(index);
+		}
+
+		msgvec[index].msg_len = static_cast<unsigned int>(length);
+	}
+
+	return static_cast<int>(index);
+}
+#endif  // defined(__APPLE__)
+
 namespace ov
 {
 	bool DatagramSocket::Prepare(int port)
@@ -18,7 +71,7 @@ namespace ov
 		return Prepare(SocketAddress(port));
 	}
 
-	bool DatagramSocket::Prepare(const SocketAddress &address)
+	bool DatagramSocket::Prepare(const SocketAddress &address, bool reuse_port)
 	{
 		CHECK_STATE(== SocketState::Closed, false);
 
@@ -29,6 +82,7 @@ namespace ov
 				PrepareEpoll() &&
 				AddToEpoll(this, static_cast<void *>(this)) &&
 				SetSockOpt<int>(SO_REUSEADDR, 1) &&
+				((reuse_port == false) || SetSockOpt<int>(SO_REUSEPORT, 1)) &&
 				Bind(address)
 			) == false)
 		{
@@ -77,33 +131,7 @@ namespace ov
 				{
 					logtd("Trying to read UDP packets...");
 
-					while(true)
-					{
-						std::shared_ptr<Data> data = std::make_shared<ov::Data>(UdpBufferSize);
-
-						// socket에서 이벤트 발생
-						std::shared_ptr<SocketAddress> remote;
-						std::shared_ptr<ov::Error> error = RecvFrom(data, &remote);
-
-						if(data->GetLength() > 0L)
-						{
-							data_callback(this->GetSharedPtrAs<DatagramSocket>(), *(remote.get()), data);
-						}
-
-						if(error != nullptr)
-						{
-							logtw("[#%d] An error occurred: %s", GetSocket(), error->ToString().CStr());
-							break;
-						}
-						else
-						{
-							if(data->GetLength() == 0L)
-							{
-								// 다음 데이터를 기다려야 함
-								break;
-							}
-						}
-					}
+					RecvBatch(data_callback);
 
 					logtd("All UDP data are processed");
 				}
@@ -128,6 +156,249 @@ namespace ov
 		return true;
 	}
 
+	void DatagramSocket::PrepareRecvBuffers()
+	{
+		if(_recv_buffer_list.empty() == false)
+		{
+			return;
+		}
+
+		_recv_buffer_list.resize(DatagramBatchCount);
+		_recv_message_list.resize(DatagramBatchCount);
+		_recv_iov_list.resize(DatagramBatchCount);
+		_recv_address_list.resize(DatagramBatchCount);
+
+		for(int index = 0; index < DatagramBatchCount; index++)
+		{
+			ResetRecvBuffer(index);
+		}
+	}
+
+	void DatagramSocket::ResetRecvBuffer(int index)
+	{
+		auto &data = _recv_buffer_list[index];
+
+		if((data == nullptr) || (data.use_count() > 1))
+		{
+			// The previous datagram is still referenced by an observer, so it cannot be overwritten
+			data = std::make_shared<Data>(UdpBufferSize);
+		}
+
+		data->SetLength(UdpBufferSize);
+
+		auto &iov = _recv_iov_list[index];
+		iov.iov_base = data->GetWritableData();
+		iov.iov_len = data->GetLength();
+
+		// recvmmsg() overwrites msg_namelen and msg_len
+		auto &message = _recv_message_list[index];
+		message = {};
+		message.msg_hdr.msg_name = &(_recv_address_list[index]);
+		message.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+		message.msg_hdr.msg_iov = &iov;
+		message.msg_hdr.msg_iovlen = 1;
+	}
+
+	bool DatagramSocket::RecvBatch(const DatagramCallback &data_callback)
+	{
+		PrepareRecvBuffers();
+
+		auto self = this->GetSharedPtrAs<DatagramSocket>();
+
+		while(true)
+		{
+			int count = ::recvmmsg(_socket.GetSocket(), _recv_message_list.data(), DatagramBatchCount, (_is_nonblock ? MSG_DONTWAIT : 0), nullptr);
+
+			if(count < 0)
+			{
+				auto error = Error::CreateErrorFromErrno();
+
+				if((error->GetCode() == EAGAIN) || (error->GetCode() == EWOULDBLOCK))
+				{
+					// 다음 데이터를 기다려야 함
+					return true;
+				}
+
+				logtw("[#%d] An error occurred: %s", GetSocket(), error->ToString().CStr());
+				SetState(SocketState::Error);
+
+				return false;
+			}
+
+			logtd("[%p] [#%d] %d datagrams read", this, _socket.GetSocket(), count);
+
+			for(int index = 0; index < count; index++)
+			{
+				auto &data = _recv_buffer_list[index];
+				data->SetLength(_recv_message_list[index].msg_len);
+
+				if(data->GetLength() > 0L)
+				{
+					data_callback(self, SocketAddress(_recv_address_list[index]), data);
+				}
+
+				ResetRecvBuffer(index);
+			}
+
+			if(count < DatagramBatchCount)
+			{
+				// The socket buffer is drained
+				return true;
+			}
+		}
+	}
+
+	size_t DatagramSocket::SendTo(const std::vector<DatagramPacket> &packet_list)
+	{
+		CHECK_STATE2(>= SocketState::Created, <= SocketState::Bound, 0);
+
+		size_t packet_index = 0;
+		size_t sent_count = 0;
+
+		while(packet_index < packet_list.size())
+		{
+			auto processed_count = SendBatch(packet_list, packet_index, &sent_count);
+
+			if(processed_count < 0)
+			{
+				// Retry
+				continue;
+			}
+
+			packet_index += processed_count;
+		}
+
+		return sent_count;
+	}
+
+	ssize_t DatagramSocket::SendBatch(const std::vector<DatagramPacket> &packet_list, size_t packet_index, size_t *sent_count)
+	{
+		mmsghdr message_list[DatagramBatchCount]{};
+		// Number of packets that each message contains
+		int packet_count_list[DatagramBatchCount];
+		char control_list[DatagramBatchCount][CMSG_SPACE(sizeof(uint16_t))]{};
+
+		// Enough iovecs for all the remaining packets, so that the pointers in message_list stay valid
+		thread_local std::vector<iovec> iov_list;
+		iov_list.resize(packet_list.size() - packet_index);
+
+		bool is_gso_enabled = _is_gso_enabled;
+		size_t iov_index = 0;
+		int message_count = 0;
+		bool has_gso_message = false;
+
+		while((message_count < DatagramBatchCount) && (packet_index + iov_index < packet_list.size()))
+		{
+			auto &first_packet = packet_list[packet_index + iov_index];
+			auto segment_size = first_packet.data->GetLength();
+			size_t total_bytes = segment_size;
+			int packet_count = 1;
+
+			if(is_gso_enabled && (segment_size > 0))
+			{
+				// The kernel splits a GSO message into segment_size chunks, so only the last packet can be smaller
+				while((packet_count < DatagramGsoMaxSegments) && (packet_index + iov_index + packet_count < packet_list.size()))
+				{
+					auto &packet = packet_list[packet_index + iov_index + packet_count];
+					auto length = packet.data->GetLength();
+
+					if((packet.address != first_packet.address) || (length == 0) || (length > segment_size) || ((total_bytes + length) > DatagramGsoMaxBytes))
+					{
+						break;
+					}
+
+					packet_count++;
+					total_bytes += length;
+
+					if(length < segment_size)
+					{
+						break;
+					}
+				}
+			}
+
+			auto &header = message_list[message_count].msg_hdr;
+
+			header.msg_name = const_cast<sockaddr *>(first_packet.address.Address());
+			header.msg_namelen = first_packet.address.AddressLength();
+			header.msg_iov = &(iov_list[iov_index]);
+			header.msg_iovlen = packet_count;
+
+			for(int index = 0; index < packet_count; index++)
+			{
+				auto &data = packet_list[packet_index + iov_index + index].data;
+
+				iov_list[iov_index + index].iov_base = const_cast<void *>(data->GetData());
+				iov_list[iov_index + index].iov_len = data->GetLength();
+			}
+
+			if(packet_count > 1)
+			{
+				header.msg_control = control_list[message_count];
+				header.msg_controllen = sizeof(control_list[message_count]);
+
+				auto cmsg = CMSG_FIRSTHDR(&header);
+				cmsg->cmsg_level = SOL_UDP;
+				cmsg->cmsg_type = UDP_SEGMENT;
+				cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+				*(reinterpret_cast<uint16_t *>(CMSG_DATA(cmsg))) = static_cast<uint16_t>(segment_size);
+
+				has_gso_message = true;
+			}
+
+			packet_count_list[message_count] = packet_count;
+			iov_index += packet_count;
+			message_count++;
+		}
+
+		// sendmmsg() fails only when the first message cannot be sent. If a later message fails, the messages before it are
+		// reported as sent, and the failed one becomes the first message of the next call, so it is handled below as well
+		int sent_message_count = ::sendmmsg(_socket.GetSocket(), message_list, message_count, MSG_NOSIGNAL | (_is_nonblock ? MSG_DONTWAIT : 0));
+
+		if(sent_message_count < 0)
+		{
+			auto error = Error::CreateErrorFromErrno();
+
+			switch(error->GetCode())
+			{
+				case EAGAIN:
+					// Same as Socket::SendTo(), wait until the socket buffer has room
+					return -1;
+
+				case EIO:
+				case EINVAL:
+					if(has_gso_message)
+					{
+						// The kernel or the NIC does not support UDP GSO.
+						// Nothing in this batch has been sent, so all of its messages are rebuilt without GSO and retried
+						logtw("[#%d] UDP GSO is not available, datagrams will be sent one by one: %s", GetSocket(), error->ToString().CStr());
+						_is_gso_enabled = false;
+						return -1;
+					}
+					break;
+
+				default:
+					break;
+			}
+
+			// Skip the message that cannot be sent (e.g. unreachable destination) not to block the others
+			logtd("[#%d] Could not send a datagram to %s: %s", GetSocket(), packet_list[packet_index].address.ToString().CStr(), error->ToString().CStr());
+
+			return packet_count_list[0];
+		}
+
+		ssize_t processed_count = 0;
+
+		for(int index = 0; index < sent_message_count; index++)
+		{
+			processed_count += packet_count_list[index];
+		}
+
+		*sent_count += processed_count;
+
+		return processed_count;
+	}
+
 	String DatagramSocket::ToString() const
 	{
 		return Socket::ToString("DatagramSocket");
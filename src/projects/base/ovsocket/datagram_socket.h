@@ -11,8 +11,31 @@
 #include "socket.h"
 #include "socket_datastructure.h"
 
+#include <sys/socket.h>
+
+#include <atomic>
+
+#if defined(__APPLE__)
+// macOS does not have recvmmsg()/sendmmsg(), they are emulated with recvmsg()/sendmsg() for each message
+struct mmsghdr
+{
+	struct msghdr msg_hdr;
+	unsigned int msg_len;
+};
+
+int recvmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout);
+int sendmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags);
+#endif  // defined(__APPLE__)
+
 namespace ov
 {
+	// A datagram to be sent with DatagramSocket::SendTo(const std::vector<DatagramPacket> &)
+	struct DatagramPacket
+	{
+		SocketAddress address;
+		std::shared_ptr<const Data> data;
+	};
+
 	class DatagramSocket : public Socket
 	{
 	public:
@@ -22,10 +45,20 @@ namespace ov
 		// 특정 port로 bind
 		bool Prepare(int port);
 		// address에 해당하는 주소로 bind
-		bool Prepare(const SocketAddress &address);
+		// reuse_port: set SO_REUSEPORT to let several sockets receive datagrams of the same address
+		bool Prepare(const SocketAddress &address, bool reuse_port = false);
 
+		// Received datagrams are read with recvmmsg() into a ring of DatagramBatchCount buffers.
+		// A buffer is reused for the next datagram unless data_callback keeps a reference to it
 		bool DispatchEvent(const DatagramCallback& data_callback, int timeout = Infinite);
 
+		// Sends the packets with sendmmsg(), DatagramBatchCount messages per system call.
+		// Consecutive packets to the same address are coalesced into one UDP GSO message
+		// when their sizes allow it (all the same except the last one), if the kernel supports UDP_SEGMENT (never on macOS).
+		//
+		// Returns the number of packets sent
+		size_t SendTo(const std::vector<DatagramPacket> &packet_list);
+
 		using Socket::Connect;
 		using Socket::GetState;
 		using Socket::Recv;
@@ -37,5 +70,25 @@ namespace ov
 		String ToString() const override;
 
 	protected:
+		void PrepareRecvBuffers();
+		void ResetRecvBuffer(int index);
+		bool RecvBatch(const DatagramCallback &data_callback);
+
+		// Builds up to DatagramBatchCount messages from packet_list[packet_index] and sends them.
+		// Returns the number of packets processed (sent, or skipped due to an error), or -1 if it should be retried.
+		// The number of packets actually sent is added to *sent_count
+		ssize_t SendBatch(const std::vector<DatagramPacket> &packet_list, size_t packet_index, size_t *sent_count);
+
+		std::vector<std::shared_ptr<Data>> _recv_buffer_list;
+		std::vector<mmsghdr> _recv_message_list;
+		std::vector<iovec> _recv_iov_list;
+		std::vector<sockaddr_in> _recv_address_list;
+
+		// Turned off when the kernel rejects a GSO message
+#if defined(__APPLE__)
+		std::atomic<bool> _is_gso_enabled{false};
+#else   // defined(__APPLE__)
+		std::atomic<bool> _is_gso_enabled{true};
+#endif  // defined(__APPLE__)
 	};
 }
@@ -17,4 +17,5 @@
 #include "client_socket.h"
 
 // UDP socket
-#include "datagram_socket.h"
\ No newline at end of file
+#include "datagram_socket.h"
+#include "datagram_send_batch.h"
\ No newline at end of file
@@ -31,7 +31,8 @@ namespace ov
 							   const SocketAddress &address,
 							   int send_buffer_size,
 							   int recv_buffer_size,
-							   int backlog)
+							   int backlog,
+							   bool reuse_port)
 	{
 		CHECK_STATE(== SocketState::Closed, false);
 
@@ -41,7 +42,7 @@ namespace ov
 				MakeNonBlocking() &&
 				PrepareEpoll() &&
 				AddToEpoll(this, static_cast<void *>(this)) &&
-				SetSocketOptions(type, send_buffer_size, recv_buffer_size) &&
+				SetSocketOptions(type, send_buffer_size, recv_buffer_size, reuse_port) &&
 				Bind(address) &&
 				Listen(backlog)) == false)
 		{
@@ -352,7 +353,7 @@ namespace ov
 		return false;
 	}
 
-	bool ServerSocket::SetSocketOptions(SocketType type, int send_buffer_size, int recv_buffer_size)
+	bool ServerSocket::SetSocketOptions(SocketType type, int send_buffer_size, int recv_buffer_size, bool reuse_port)
 	{
 		// SRT socket is already non-block mode
 		bool result = true;
@@ -360,6 +361,12 @@ namespace ov
 		if (type == SocketType::Tcp)
 		{
 			result &= SetSockOpt<int>(SO_REUSEADDR, 1);
+
+			if (reuse_port)
+			{
+				// The kernel balances the incoming connections among the sockets bound to the same address
+				result &= SetSockOpt<int>(SO_REUSEPORT, 1);
+			}
 			// result &= SetSockOpt<int>(IPPROTO_TCP, TCP_NODELAY, 1);
 
 			int current_send_buffer_size;
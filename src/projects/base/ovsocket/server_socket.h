@@ -29,11 +29,13 @@ namespace ov
 					 int backlog = SOMAXCONN);
 
 		// address에 해당하는 주소로 bind
+		// reuse_port: set SO_REUSEPORT to let several sockets listen on the same address (TCP only)
 		bool Prepare(SocketType type,
 					 const SocketAddress &address,
 					 int send_buffer_size,
 					 int recv_buffer_size,
-					 int backlog = SOMAXCONN);
+					 int backlog = SOMAXCONN,
+					 bool reuse_port = false);
 
 		virtual bool DispatchEvent(ClientConnectionCallback connection_callback, ClientDataCallback data_callback, int timeout = Infinite);
 
@@ -50,7 +52,7 @@ namespace ov
 		virtual bool DisconnectClient(ClientSocket *client_socket, SocketConnectionState state, const std::shared_ptr<Error> &error = nullptr);
 
 	protected:
-		virtual bool SetSocketOptions(SocketType type, int send_buffer_size, int recv_buffer_size);
+		virtual bool SetSocketOptions(SocketType type, int send_buffer_size, int recv_buffer_size, bool reuse_port);
 
 		void DispatchAccept();
 		void DispatchEvents(const void *key, const epoll_event *event);
@@ -10,6 +10,7 @@
 #include "socket_private.h"
 
 #include <arpa/inet.h>
+#include <poll.h>
 #include <sys/fcntl.h>
 #include <unistd.h>
 #include <algorithm>
@@ -1211,8 +1212,7 @@ namespace ov
 					{
 						if (errno == EAGAIN)
 						{
-							// Suppress 'Resource temporarily available' error
-							::usleep(100);
+							// The socket buffer is full, the caller will send the rest when it becomes writable
 							return total_sent;
 						}
 						else if (errno == EBADF)
@@ -1293,9 +1293,142 @@ namespace ov
 		return total_sent;
 	}
 
+	ssize_t Socket::SendInternal(std::vector<struct iovec> &iov_list, size_t *iov_index)
+	{
+		OV_ASSERT2(iov_index != nullptr);
+
+		size_t remained = 0L;
+
+		for (size_t index = *iov_index; index < iov_list.size(); index++)
+		{
+			remained += iov_list[index].iov_len;
+		}
+
+		if (GetType() == SocketType::Srt)
+		{
+			// SRT does not support scatter-gather I/O, so the buffers are merged to keep the message boundary
+			Data data(remained);
+
+			for (size_t index = *iov_index; index < iov_list.size(); index++)
+			{
+				data.Append(iov_list[index].iov_base, iov_list[index].iov_len);
+			}
+
+			*iov_index = iov_list.size();
+
+			return SendInternal(data.GetData(), data.GetLength());
+		}
+
+		logtd("[%p] [#%d] Trying to send data %zu bytes (%zu buffers)...", this, _socket.GetSocket(), remained, iov_list.size() - *iov_index);
+
+		size_t total_sent = 0L;
+
+		while ((remained > 0L) && (_force_stop == false))
+		{
+			struct msghdr message {};
+
+			message.msg_iov = iov_list.data() + *iov_index;
+			message.msg_iovlen = iov_list.size() - *iov_index;
+
+			int sock = _socket.GetSocket();
+			ssize_t sent = ::sendmsg(sock, &message, MSG_NOSIGNAL | (_is_nonblock ? MSG_DONTWAIT : 0));
+
+			if (sent < 0L)
+			{
+				if (errno == EAGAIN)
+				{
+					// The socket buffer is full, the caller will send the rest when it becomes writable
+					return total_sent;
+				}
+				else if ((errno != EBADF) && (errno != EPIPE))
+				{
+					// Suppress 'Bad file descriptor' and 'Broken pipe' error
+					logtw("[%p] [#%d] Could not send data: %zd (%s)", this, sock, sent, ov::Error::CreateErrorFromErrno()->ToString().CStr());
+				}
+
+				return sent;
+			}
+
+			OV_ASSERT2(static_cast<ssize_t>(remained) >= sent);
+
+			remained -= sent;
+			total_sent += sent;
+
+			// Skip the buffers that have been sent, and move the start of the partially sent buffer
+			auto sent_bytes = static_cast<size_t>(sent);
+
+			while ((*iov_index < iov_list.size()) && (sent_bytes >= iov_list[*iov_index].iov_len))
+			{
+				sent_bytes -= iov_list[*iov_index].iov_len;
+				(*iov_index)++;
+			}
+
+			if (sent_bytes > 0L)
+			{
+				auto &current = iov_list[*iov_index];
+
+				current.iov_base = static_cast<uint8_t *>(current.iov_base) + sent_bytes;
+				current.iov_len -= sent_bytes;
+			}
+		}
+
+		logtd("[%p] [#%d] %zu bytes sent", this, _socket.GetSocket(), total_sent);
+
+		return total_sent;
+	}
+
+	bool Socket::WaitForWritable(int timeout)
+	{
+		if (GetType() == SocketType::Srt)
+		{
+			// SRT has its own send buffer, and SendInternal() waits for it
+			return true;
+		}
+
+		struct pollfd poll_fd
+		{
+		};
+
+		poll_fd.fd = _socket.GetSocket();
+		poll_fd.events = POLLOUT;
+
+		while (_force_stop == false)
+		{
+			int result = ::poll(&poll_fd, 1, timeout);
+
+			if (result > 0)
+			{
+				return (OV_CHECK_FLAG(poll_fd.revents, POLLERR) || OV_CHECK_FLAG(poll_fd.revents, POLLHUP) || OV_CHECK_FLAG(poll_fd.revents, POLLNVAL)) == false;
+			}
+
+			if (result == 0)
+			{
+				// Timed out
+				return false;
+			}
+
+			if (errno != EINTR)
+			{
+				logtw("[%p] [#%d] Could not wait for the socket to be writable: %s", this, _socket.GetSocket(), Error::CreateErrorFromErrno()->ToString().CStr());
+				return false;
+			}
+		}
+
+		return false;
+	}
+
 	ssize_t Socket::Send(const void *data, size_t length)
 	{
-		return SendInternal(data, length);
+		auto sent = SendInternal(data, length);
+
+		if ((sent == 0L) && (length > 0L))
+		{
+			// The socket buffer is full
+			errno = EAGAIN;
+			return -1L;
+		}
+
+		return sent;
 	}
 
 	ssize_t Socket::Send(const std::shared_ptr<const Data> &data)
@@ -1310,6 +1443,32 @@ namespace ov
 		return Send(data->GetData(), data->GetLength());
 	}
 
+	ssize_t Socket::Send(const std::vector<std::shared_ptr<const Data>> &data_list)
+	{
+		std::vector<struct iovec> iov_list;
+		size_t iov_index = 0;
+
+		iov_list.reserve(data_list.size());
+
+		for (auto &data : data_list)
+		{
+			OV_ASSERT2(data != nullptr);
+
+			iov_list.push_back({const_cast<void *>(data->GetData()), data->GetLength()});
+		}
+
+		auto sent = SendInternal(iov_list, &iov_index);
+
+		if ((sent == 0L) && (iov_index < iov_list.size()))
+		{
+			// The socket buffer is full
+			errno = EAGAIN;
+			return -1L;
+		}
+
+		return sent;
+	}
+
 	ssize_t Socket::SendTo(const ov::SocketAddress &address, const void *data, size_t length)
 	{
 		//OV_ASSERT2(_socket.IsValid());
@@ -60,6 +60,7 @@ int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout)
 #include <sys/epoll.h>
 #endif
 #include <sys/socket.h>
+#include <sys/uio.h>
 
 #include <functional>
 #include <map>
@@ -298,8 +299,13 @@ namespace ov
 		SocketType GetType() const;
 
 		// 데이터 송신
+		// Does not block: returns the number of bytes the socket buffer took, which can be less than the length.
+		// If the socket buffer is full, returns -1 with errno EAGAIN.
+		// ClientSocket overrides them to queue the data and send the rest when the socket becomes writable
 		virtual ssize_t Send(const void *data, size_t length);
 		virtual ssize_t Send(const std::shared_ptr<const Data> &data);
+		// Scatter-gather send. The buffers are sent with one system call in order, as if they were one contiguous buffer
+		virtual ssize_t Send(const std::vector<std::shared_ptr<const Data>> &data_list);
 
 		virtual ssize_t SendTo(const ov::SocketAddress &address, const void *data, size_t length);
 		virtual ssize_t SendTo(const ov::SocketAddress &address, const std::shared_ptr<const Data> &data);
@@ -325,7 +331,14 @@ namespace ov
 		static String StringFromEpollEvent(const epoll_event *event);
 		static String StringFromEpollEvent(const epoll_event &event);
 
+		// Sends as much as the socket buffer can take without blocking, and returns the number of bytes sent.
+		// If it is less than length, the caller should wait for WaitForWritable() and send the rest
 		ssize_t SendInternal(const void *data, size_t length);
+		// Sends the buffers from iov_list[*iov_index]. iov_list and iov_index are advanced by the bytes sent,
+		// so the caller can call it again with the same arguments to send the rest
+		ssize_t SendInternal(std::vector<struct iovec> &iov_list, size_t *iov_index);
+		// Waits until the socket buffer has room (POLLOUT). Returns false if timed out or an error occurred
+		bool WaitForWritable(int timeout);
 		std::shared_ptr<ov::Error> RecvInternal(void *data, size_t length, size_t *received_length);
 		
 		virtual String ToString(const char *class_name) const;
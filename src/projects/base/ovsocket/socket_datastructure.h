@@ -48,4 +48,10 @@ namespace ov
 
 	const ssize_t TcpBufferSize = 4096;
 	const ssize_t UdpBufferSize = 4096;
+
+	// Maximum number of datagrams per recvmmsg()/sendmmsg()
+	const int DatagramBatchCount = 32;
+	// Limits of a UDP GSO message (UDP_MAX_SEGMENTS of the kernel, and the maximum UDP payload)
+	const int DatagramGsoMaxSegments = 64;
+	const size_t DatagramGsoMaxBytes = 65000;
 }  // namespace ov
@@ -46,16 +46,19 @@ namespace pvd
 	{
 		_run_thread = false;
 
-		auto it = _applications.begin();
+		std::map<info::application_id_t, std::shared_ptr<Application>> applications;
 
-		while(it != _applications.end())
 		{
-			auto application = it->second;
+			std::unique_lock<std::shared_mutex> lock(_application_map_guard);
+			applications.swap(_applications);
+		}
+
+		for(auto &item : applications)
+		{
+			auto application = item.second;
 
 			_router->UnregisterConnectorApp(*application.get(), application);
 			application->Stop();
-
-			it = _applications.erase(it);
 		}
 
 		logti("%s has been stopped.", GetProviderName());
@@ -118,7 +121,10 @@ namespace pvd
 		}
 
 		// Store created application
-		_applications[application->GetId()] = application;
+		{
+			std::unique_lock<std::shared_mutex> lock(_application_map_guard);
+			_applications[application->GetId()] = application;
+		}
 
 		return true;
 	}
@@ -126,17 +132,17 @@ namespace pvd
 	// Delete Application
 	bool Provider::OnDeleteApplication(const info::Application &app_info)
 	{
-		auto item = _applications.find(app_info.GetId());
+		auto application = GetApplicationById(app_info.GetId());
 
 		logti("Deleting the application: [%s]", app_info.GetName().CStr());
 
-		if(item == _applications.end())
+		if(application == nullptr)
 		{
 			logte("The application does not exists: [%s]", app_info.GetName().CStr());
 			return false;
 		}
 
-		bool result = OnDeleteProviderApplication(item->second);
+		bool result = OnDeleteProviderApplication(application);
 
 		if(result == false)
 		{
@@ -144,13 +150,25 @@ namespace pvd
 			return false;
 		}
 
-		_applications.erase(app_info.GetId());
+		{
+			std::unique_lock<std::shared_mutex> lock(_application_map_guard);
+			_applications.erase(app_info.GetId());
+		}
 
 		return true;
 	}
 
+	std::map<info::application_id_t, std::shared_ptr<Application>> Provider::GetApplications()
+	{
+		std::shared_lock<std::shared_mutex> lock(_application_map_guard);
+
+		return _applications;
+	}
+
 	std::shared_ptr<Application> Provider::GetApplicationByName(ov::String app_name)
 	{
+		std::shared_lock<std::shared_mutex> lock(_application_map_guard);
+
 		for(auto const &x : _applications)
 		{
 			auto application = x.second;
@@ -177,6 +195,8 @@ namespace pvd
 
 	std::shared_ptr<Application> Provider::GetApplicationById(info::application_id_t application_id)
 	{
+		std::shared_lock<std::shared_mutex> lock(_application_map_guard);
+
 		auto application = _applications.find(application_id);
 
 		if(application != _applications.end())
@@ -203,7 +223,7 @@ namespace pvd
 	{
 		while(_run_thread)
 		{
-			for(auto const &x : _applications)
+			for(auto const &x : GetApplications())
 			{
 				auto app = x.second;
 
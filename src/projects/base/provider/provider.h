@@ -12,6 +12,8 @@
 #include <base/media_route/media_route_interface.h>
 #include <orchestrator/data_structure.h>
 
+#include <shared_mutex>
+
 namespace pvd
 {
 	class Application;
@@ -61,7 +63,12 @@ namespace pvd
 		}
 
 	private:
+		// Returns a copy of _applications, to call the applications without holding the lock
+		std::map<info::application_id_t, std::shared_ptr<Application>> GetApplications();
+
 		const cfg::Server _server_config;
+		// The applications are looked up by the workers of the providers (e.g. the shards of RTMP) at the same time
+		std::shared_mutex _application_map_guard;
 		std::map<info::application_id_t, std::shared_ptr<Application>> _applications;
 		std::shared_ptr<MediaRouteInterface> _router;
 
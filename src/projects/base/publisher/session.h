@@ -28,7 +28,9 @@ namespace pub
 		virtual bool Stop();
 
 		// 패킷을 전송한다.
-		virtual bool SendOutgoingData(uint32_t packet_type, const std::shared_ptr<ov::Data> &packet) = 0;
+		// The packet is shared by all sessions of the stream, so a session must not modify it.
+		// If a session needs to change the packet, it should write the changed part into its own buffer.
+		virtual bool SendOutgoingData(uint32_t packet_type, const std::shared_ptr<const ov::Data> &packet) = 0;
 		// 상위 Layer에서 Packet을 수신받는다.
 		virtual void OnPacketReceived(const std::shared_ptr<info::Session> &session_info, const std::shared_ptr<const ov::Data> &data) = 0;
 
@@ -4,9 +4,9 @@
 
 namespace pub
 {
-	StreamWorker::StreamWorker()
+	StreamWorker::StreamWorker(uint32_t home_core)
 	{
-		_stop_thread_flag = true;
+		_home_core = home_core;
 	}
 
 	StreamWorker::~StreamWorker()
@@ -16,30 +16,20 @@ namespace pub
 
 	bool StreamWorker::Start()
 	{
-		if (!_stop_thread_flag)
-		{
-			return true;
-		}
 		_stop_thread_flag = false;
-		_worker_thread = std::thread(&StreamWorker::WorkerThread, this);
 
 		return true;
 	}
 
 	bool StreamWorker::Stop()
 	{
-		if (_stop_thread_flag)
+		if (_stop_thread_flag.exchange(true))
 		{
 			return true;
 		}
 
-		_stop_thread_flag = true;
-		// Generate Event
-		_queue_event.Notify();
-		if(_worker_thread.joinable())
-		{
-			_worker_thread.join();
-		}
+		// If Run() is in progress on a pool thread, wait for it to finish sending the current packet
+		std::unique_lock<std::mutex> lock(_session_map_guard);
 
 		for (auto const &x : _sessions)
 		{
@@ -92,6 +82,11 @@ namespace pub
 
 	void StreamWorker::SendPacket(uint32_t type, std::shared_ptr<ov::Data> packet)
 	{
+		if (_stop_thread_flag)
+		{
+			return;
+		}
+
 		// Queue에 패킷을 집어넣는다.
 		auto stream_packet = std::make_shared<StreamWorker::StreamPacket>(type, packet);
 
@@ -99,7 +94,11 @@ namespace pub
 		_packet_queue.push(stream_packet);
 		lock.unlock();
 
-		_queue_event.Notify();
+		// If this worker is already scheduled, the packet will be sent by that run
+		if (_scheduled.exchange(true) == false)
+		{
+			StreamWorkerPool::Instance()->Schedule(_home_core, GetSharedPtr());
+		}
 	}
 
 	std::shared_ptr<StreamWorker::StreamPacket> StreamWorker::PopStreamPacket()
@@ -117,35 +116,46 @@ namespace pub
 		return std::move(data);
 	}
 
-	void StreamWorker::WorkerThread()
+	void StreamWorker::Run()
 	{
-		std::unique_lock<std::mutex> session_lock(_session_map_guard, std::defer_lock);
-		// Queue Event를 기다린다.
-		while (!_stop_thread_flag)
+		// Only one pool thread runs this worker at a time (guarded by _scheduled),
+		// so the packets are delivered to each session in order even if the worker is stolen by another core.
 		{
-			// Queue에 이벤트가 들어올때까지 무한 대기 한다.
-			// TODO: 향후 App 재시작 등의 기능을 위해 WaitFor(time) 기능을 구현한다.
-			_queue_event.Wait();
+			// Datagrams of all sessions are sent together at the end of the batch
+			ov::DatagramSendBatch send_batch;
 
-			// Queue에서 패킷을 꺼낸다.
-			std::shared_ptr<StreamWorker::StreamPacket> packet = PopStreamPacket();
-			if (packet == nullptr)
+			for (int count = 0; (count < STREAM_WORKER_PACKET_BATCH_COUNT) && (_stop_thread_flag == false); count++)
 			{
-				continue;
+				// Queue에서 패킷을 꺼낸다.
+				std::shared_ptr<StreamWorker::StreamPacket> packet = PopStreamPacket();
+				if (packet == nullptr)
+				{
+					break;
+				}
+
+				std::unique_lock<std::mutex> session_lock(_session_map_guard);
+
+				// 모든 Session에 전송한다.
+				// The payload is shared by all sessions, each session writes only the changed part into its own buffer
+				for (auto const &x : _sessions)
+				{
+					auto session = std::static_pointer_cast<Session>(x.second);
+
+					session->SendOutgoingData(packet->_type, packet->_data);
+				}
 			}
+		}
 
-			session_lock.lock();
-			
-			// 모든 Session에 전송한다.
-			for (auto const &x : _sessions)
-			{
-				auto session = std::static_pointer_cast<Session>(x.second);
+		_scheduled = false;
 
-				// Session will change data
-				std::shared_ptr<ov::Data> session_data = packet->_data->Clone();
-				session->SendOutgoingData(packet->_type, session_data);
-			}
-			session_lock.unlock();
+		// A packet may have been queued after the last pop, while _scheduled was still true
+		std::unique_lock<std::mutex> lock(_packet_queue_guard);
+		bool has_packet = (_packet_queue.empty() == false);
+		lock.unlock();
+
+		if (has_packet && (_stop_thread_flag == false) && (_scheduled.exchange(true) == false))
+		{
+			StreamWorkerPool::Instance()->Schedule(_home_core, GetSharedPtr());
 		}
 	}
 
@@ -155,6 +165,7 @@ namespace pub
 	{
 		_application = application;
 		_run_flag = false;
+		_worker_count = 0;
 		_last_issued_session_id = 100;
 	}
 
@@ -170,16 +181,25 @@ namespace pub
 			return false;
 		}
 
-		if (worker_count > MAX_STREAM_THREAD_COUNT)
+		// The workers of all streams share the cores of StreamWorkerPool,
+		// so worker_count is the number of session shards of this stream (never more than the number of cores).
+		auto core_count = StreamWorkerPool::Instance()->GetCoreCount();
+
+		worker_count = std::min(worker_count, static_cast<uint32_t>(MAX_STREAM_THREAD_COUNT));
+		worker_count = std::max(std::min(worker_count, core_count), 1U);
+
+		_worker_count = worker_count;
+		_stream_workers.clear();
+
+		for (uint32_t i = 0; i < _worker_count; i++)
 		{
-			worker_count = MAX_STREAM_THREAD_COUNT;
+			// Spread the shards of the streams over the cores
+			_stream_workers.push_back(std::make_shared<StreamWorker>((GetId() + i) % core_count));
 		}
 
-		_worker_count = worker_count;
-		// Create WorkerThread
 		for (uint32_t i = 0; i < _worker_count; i++)
 		{
-			if (!_stream_workers[i].Start())
+			if (!_stream_workers[i]->Start())
 			{
 				logte("Cannot create stream thread (%d)", i);
 
@@ -204,9 +224,9 @@ namespace pub
 
 		_run_flag = false;
 
-		for (uint32_t i = 0; i < _worker_count; i++)
+		for (auto &stream_worker : _stream_workers)
 		{
-			_stream_workers[i].Stop();
+			stream_worker->Stop();
 		}
 
 		_sessions.clear();
@@ -221,18 +241,32 @@ namespace pub
 		return _application;
 	}
 
-	StreamWorker &Stream::GetWorkerByStreamID(session_id_t session_id)
+	std::shared_ptr<StreamWorker> Stream::GetWorkerByStreamID(session_id_t session_id)
 	{
+		// There is no worker before Start() (or after Start() is failed)
+		if ((_worker_count == 0) || (_stream_workers.size() < _worker_count))
+		{
+			return nullptr;
+		}
+
 		return _stream_workers[session_id % _worker_count];
 	}
 
 	bool Stream::AddSession(std::shared_ptr<Session> session)
 	{
 		// For getting session, all sessions
+		auto stream_worker = GetWorkerByStreamID(session->GetId());
+
+		if (stream_worker == nullptr)
+		{
+			logte("[%s(%u)] stream is not started", GetName().CStr(), GetId());
+			return false;
+		}
+
 		_sessions[session->GetId()] = session;
 		// 가장 적은 Session을 처리하는 Worker를 찾아서 Session을 넣는다.
 		// session id로 hash를 만들어서 분배한다.
-		return GetWorkerByStreamID(session->GetId()).AddSession(session);
+		return stream_worker->AddSession(session);
 	}
 
 	bool Stream::RemoveSession(session_id_t id)
@@ -247,12 +281,16 @@ namespace pub
 
 		_sessions.erase(id);
 
-		return GetWorkerByStreamID(id).RemoveSession(id);
+		auto stream_worker = GetWorkerByStreamID(id);
+
+		return (stream_worker != nullptr) ? stream_worker->RemoveSession(id) : false;
 	}
 
 	std::shared_ptr<Session> Stream::GetSession(session_id_t id)
 	{
-		return GetWorkerByStreamID(id).GetSession(id);
+		auto stream_worker = GetWorkerByStreamID(id);
+
+		return (stream_worker != nullptr) ? stream_worker->GetSession(id) : nullptr;
 	}
 
 	const std::map<session_id_t, std::shared_ptr<Session>> &Stream::GetAllSessions()
@@ -263,14 +301,31 @@ namespace pub
 	bool Stream::BroadcastPacket(uint32_t packet_type, std::shared_ptr<ov::Data> packet)
 	{
 		// 모든 StreamWorker에 나눠준다.
-		for (uint32_t i = 0; i < _worker_count; i++)
+		for (auto &stream_worker : _stream_workers)
 		{
-			_stream_workers[i].SendPacket(packet_type, packet);
+			stream_worker->SendPacket(packet_type, packet);
 		}
 
 		return true;
 	}
 
+	bool Stream::RequestKeyFrame()
+	{
+		{
+			std::lock_guard<std::mutex> lock_guard(_key_frame_request_guard);
+
+			if ((_key_frame_request_timer.Elapsed() >= 0) && (_key_frame_request_timer.IsElapsed(STREAM_KEY_FRAME_REQUEST_INTERVAL) == false))
+			{
+				// The key frame that is requested by another session will be delivered soon
+				return true;
+			}
+
+			_key_frame_request_timer.Start();
+		}
+
+		return _application->RequestKeyFrame(std::static_pointer_cast<info::Stream>(GetSharedPtr()));
+	}
+
 	uint32_t Stream::IssueUniqueSessionId()
 	{
 		auto new_session_id = _last_issued_session_id++;
@@ -4,17 +4,26 @@
 #include "base/info/stream.h"
 #include "base/media_route/media_buffer.h"
 #include "session.h"
+#include "stream_worker_pool.h"
 
 #define MIN_STREAM_THREAD_COUNT 2
 #define MAX_STREAM_THREAD_COUNT 72
 
+// Maximum number of packets that a StreamWorker sends at once before yielding the core to other streams
+#define STREAM_WORKER_PACKET_BATCH_COUNT 32
+
+// The key frame requests of the sessions are aggregated, and sent to the producer once in this interval (in milliseconds)
+#define STREAM_KEY_FRAME_REQUEST_INTERVAL 500
+
 namespace pub
 {
-	class StreamWorker
+	// StreamWorker does not own a thread anymore. It is a shard of sessions of a stream,
+	// and it is scheduled onto the home core of StreamWorkerPool whenever packets are queued.
+	class StreamWorker : public StreamWorkerTask, public ov::EnableSharedFromThis<StreamWorker>
 	{
 	public:
-		StreamWorker();
-		~StreamWorker();
+		StreamWorker(uint32_t home_core);
+		~StreamWorker() override;
 
 		bool Start();
 		bool Stop();
@@ -25,12 +34,12 @@ namespace pub
 
 		void SendPacket(uint32_t type, std::shared_ptr<ov::Data> packet);
 
-	private:
-		void WorkerThread();
+		// Called by StreamWorkerPool
+		void Run() override;
 
+	private:
 		std::map<session_id_t, std::shared_ptr<Session>> _sessions;
 		std::mutex _session_map_guard;
-		ov::Semaphore _queue_event;
 
 		class StreamPacket
 		{
@@ -38,11 +47,14 @@ namespace pub
 			StreamPacket(uint32_t type, std::shared_ptr<ov::Data> data)
 			{
 				_type = type;
+				// Clone() is copy-on-write, so the payload is not copied here.
+				// It only keeps the packet from being changed by the packetizer afterward.
 				_data = data->Clone();
 			}
 
 			uint32_t _type;
-			std::shared_ptr<ov::Data> _data;
+			// Shared by all sessions of this worker (read only)
+			std::shared_ptr<const ov::Data> _data;
 		};
 
 		std::shared_ptr<StreamPacket> PopStreamPacket();
@@ -50,10 +62,10 @@ namespace pub
 		std::queue<std::shared_ptr<StreamPacket>> _packet_queue;
 		std::mutex _packet_queue_guard;
 
-		bool _stop_thread_flag;
-		std::thread _worker_thread;
-
-		std::shared_ptr<Stream> _parent;
+		uint32_t _home_core;
+		// true while this worker is in a run queue of the pool or is running
+		std::atomic<bool> _scheduled{false};
+		std::atomic<bool> _stop_thread_flag{true};
 	};
 
 	class Application;
@@ -78,6 +90,9 @@ namespace pub
 
 		uint32_t IssueUniqueSessionId();
 
+		// Called when a session needs a key frame (e.g. PLI/FIR of WebRTC) to ask the producer of the stream (transcoder) for it
+		bool RequestKeyFrame();
+
 	protected:
 		Stream(const std::shared_ptr<Application> application, const info::Stream &info);
 		virtual ~Stream();
@@ -85,14 +100,18 @@ namespace pub
 		std::shared_ptr<Application> GetApplication();
 
 	private:
-		StreamWorker &GetWorkerByStreamID(session_id_t session_id);
+		// nullptr if the stream is not started
+		std::shared_ptr<StreamWorker> GetWorkerByStreamID(session_id_t session_id);
 		std::map<session_id_t, std::shared_ptr<Session>> _sessions;
 
 		uint32_t _worker_count;
 		bool _run_flag;
-		StreamWorker _stream_workers[MAX_STREAM_THREAD_COUNT];
+		std::vector<std::shared_ptr<StreamWorker>> _stream_workers;
 		std::shared_ptr<Application> _application;
 
 		session_id_t _last_issued_session_id;
+
+		std::mutex _key_frame_request_guard;
+		ov::StopWatch _key_frame_request_timer;
 	};
 }  // namespace pub
\ No newline at end of file
@@ -0,0 +1,260 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "stream_worker_pool.h"
+
+#include <pthread.h>
+
+#include "publisher_private.h"
+
+// An idle core wakes up periodically to look for tasks to steal, even when nobody signals it
+#define STREAM_WORKER_POOL_IDLE_TIMEOUT_MS 100
+
+namespace pub
+{
+	static thread_local int32_t _current_core_index = -1;
+
+	StreamWorkerPool::~StreamWorkerPool()
+	{
+		Stop();
+	}
+
+	bool StreamWorkerPool::Start(uint32_t core_count, bool work_stealing)
+	{
+		std::lock_guard<std::mutex> lock(_start_guard);
+
+		if (_cores.empty() == false)
+		{
+			// Already started
+			return true;
+		}
+
+		auto hardware_concurrency = std::max(std::thread::hardware_concurrency(), 1U);
+
+		if (core_count == 0)
+		{
+			core_count = hardware_concurrency;
+		}
+
+		std::unique_lock<std::shared_mutex> cores_lock(_cores_guard);
+
+		_stop_thread_flag = false;
+		_work_stealing = work_stealing;
+
+		for (uint32_t index = 0; index < core_count; index++)
+		{
+			auto core = std::make_unique<Core>();
+			core->index = index;
+			_cores.push_back(std::move(core));
+		}
+
+		for (auto &core : _cores)
+		{
+			core->thread = std::thread(&StreamWorkerPool::CoreThread, this, core.get());
+
+#if !defined(__APPLE__)
+			// Pin the thread to a core so that the sessions sharded to it stay cache-hot
+			// (macOS does not support pinning a thread to a core)
+			cpu_set_t cpu_set;
+			CPU_ZERO(&cpu_set);
+			CPU_SET(core->index % hardware_concurrency, &cpu_set);
+
+			if (::pthread_setaffinity_np(core->thread.native_handle(), sizeof(cpu_set), &cpu_set) != 0)
+			{
+				logtw("Could not pin the stream worker #%u to a core", core->index);
+			}
+#endif
+		}
+
+		_core_count = core_count;
+
+		logti("Stream worker pool has started with %u cores (work stealing: %s)", core_count, work_stealing ? "enabled" : "disabled");
+
+		return true;
+	}
+
+	bool StreamWorkerPool::Stop()
+	{
+		std::lock_guard<std::mutex> lock(_start_guard);
+
+		if (_cores.empty())
+		{
+			return true;
+		}
+
+		_stop_thread_flag = true;
+
+		for (auto &core : _cores)
+		{
+			std::unique_lock<std::mutex> queue_lock(core->queue_guard);
+			core->queue_event.notify_all();
+		}
+
+		// The threads read _cores until they are joined, so _cores is cleared after that
+		for (auto &core : _cores)
+		{
+			if (core->thread.joinable())
+			{
+				core->thread.join();
+			}
+		}
+
+		std::unique_lock<std::shared_mutex> cores_lock(_cores_guard);
+
+		_core_count = 0;
+		_cores.clear();
+
+		return true;
+	}
+
+	uint32_t StreamWorkerPool::GetCoreCount()
+	{
+		if (_core_count == 0)
+		{
+			Start();
+		}
+
+		return _core_count;
+	}
+
+	void StreamWorkerPool::Schedule(uint32_t core_index, const std::shared_ptr<StreamWorkerTask> &task)
+	{
+		if (_core_count == 0)
+		{
+			Start();
+		}
+
+		std::shared_lock<std::shared_mutex> cores_lock(_cores_guard);
+
+		if (_stop_thread_flag || _cores.empty())
+		{
+			return;
+		}
+
+		auto &core = _cores[core_index % _cores.size()];
+
+		std::unique_lock<std::mutex> lock(core->queue_guard);
+		core->run_queue.push_back(task);
+		bool has_backlog = (core->run_queue.size() > 1);
+		core->queue_event.notify_one();
+		lock.unlock();
+
+		// The home core is busy, let an idle core steal the backlog
+		if (_work_stealing && has_backlog && (_idle_core_count > 0))
+		{
+			WakeUpIdleCore(core->index);
+		}
+	}
+
+	int32_t StreamWorkerPool::GetCurrentCoreIndex()
+	{
+		return _current_core_index;
+	}
+
+	void StreamWorkerPool::CoreThread(Core *core)
+	{
+		_current_core_index = static_cast<int32_t>(core->index);
+
+		while (_stop_thread_flag == false)
+		{
+			auto task = PopLocalTask(core);
+
+			if ((task == nullptr) && _work_stealing)
+			{
+				task = StealTask(core);
+			}
+
+			if (task != nullptr)
+			{
+				task->Run();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(core->queue_guard);
+
+			if (core->run_queue.empty() && (_stop_thread_flag == false))
+			{
+				core->idle = true;
+				_idle_core_count++;
+
+				if (_work_stealing)
+				{
+					core->queue_event.wait_for(lock, std::chrono::milliseconds(STREAM_WORKER_POOL_IDLE_TIMEOUT_MS));
+				}
+				else
+				{
+					core->queue_event.wait(lock, [this, core]() -> bool {
+						return (core->run_queue.empty() == false) || _stop_thread_flag;
+					});
+				}
+
+				_idle_core_count--;
+				core->idle = false;
+			}
+		}
+	}
+
+	std::shared_ptr<StreamWorkerTask> StreamWorkerPool::PopLocalTask(Core *core)
+	{
+		std::lock_guard<std::mutex> lock(core->queue_guard);
+
+		if (core->run_queue.empty())
+		{
+			return nullptr;
+		}
+
+		auto task = std::move(core->run_queue.front());
+		core->run_queue.pop_front();
+
+		return task;
+	}
+
+	std::shared_ptr<StreamWorkerTask> StreamWorkerPool::StealTask(Core *thief)
+	{
+		auto core_count = _cores.size();
+
+		for (size_t offset = 1; offset < core_count; offset++)
+		{
+			auto &victim = _cores[(thief->index + offset) % core_count];
+
+			// Do not wait for a busy queue, just try the next one
+			std::unique_lock<std::mutex> lock(victim->queue_guard, std::try_to_lock);
+
+			if ((lock.owns_lock() == false) || victim->run_queue.empty())
+			{
+				continue;
+			}
+
+			// The owner pops from the front, so steal from the back to avoid touching the same tasks
+			auto task = std::move(victim->run_queue.back());
+			victim->run_queue.pop_back();
+
+			return task;
+		}
+
+		return nullptr;
+	}
+
+	void StreamWorkerPool::WakeUpIdleCore(uint32_t except_index)
+	{
+		for (auto &core : _cores)
+		{
+			if (core->index == except_index)
+			{
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(core->queue_guard, std::try_to_lock);
+
+			if (lock.owns_lock() && core->idle)
+			{
+				core->queue_event.notify_one();
+				break;
+			}
+		}
+	}
+}  // namespace pub
@@ -0,0 +1,90 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/common_types.h>
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <shared_mutex>
+
+namespace pub
+{
+	// A unit of work that can be scheduled onto StreamWorkerPool.
+	// The pool guarantees nothing about ordering between tasks, so the task itself must make sure that
+	// it is not scheduled twice at the same time (See StreamWorker).
+	class StreamWorkerTask
+	{
+	public:
+		virtual ~StreamWorkerTask() = default;
+
+		virtual void Run() = 0;
+	};
+
+	// Process-wide worker pool shared by all publisher streams.
+	//
+	// There is one thread per core, each with its own run queue. A task is always pushed to the queue of its home core,
+	// so a task (and the sessions it serves) runs on the same core.
+	// If work stealing is enabled, a core that runs out of work runs tasks from the tail of the other queues.
+	// A stolen task is run only once on the thief, and it goes back to its home core when it is scheduled again.
+	class StreamWorkerPool : public ov::Singleton<StreamWorkerPool>
+	{
+	public:
+		friend class ov::Singleton<StreamWorkerPool>;
+
+		~StreamWorkerPool() override;
+
+		// core_count == 0 means the number of hardware threads
+		// work_stealing trades the session-to-core affinity for the latency of a busy core
+		bool Start(uint32_t core_count = 0, bool work_stealing = false);
+		bool Stop();
+
+		// Starts the pool with the default core count if it is not started yet
+		uint32_t GetCoreCount();
+
+		void Schedule(uint32_t core_index, const std::shared_ptr<StreamWorkerTask> &task);
+
+		// Returns the index of the core that runs the current thread, or -1 if it is not a thread of the pool
+		static int32_t GetCurrentCoreIndex();
+
+	protected:
+		StreamWorkerPool() = default;
+
+	private:
+		struct Core
+		{
+			uint32_t index = 0;
+			std::thread thread;
+
+			std::mutex queue_guard;
+			std::condition_variable queue_event;
+			std::deque<std::shared_ptr<StreamWorkerTask>> run_queue;
+
+			bool idle = false;
+		};
+
+		void CoreThread(Core *core);
+
+		std::shared_ptr<StreamWorkerTask> PopLocalTask(Core *core);
+		std::shared_ptr<StreamWorkerTask> StealTask(Core *thief);
+
+		void WakeUpIdleCore(uint32_t except_index);
+
+		std::mutex _start_guard;
+		// Schedule() reads _cores while Start()/Stop() changes it
+		std::shared_mutex _cores_guard;
+		std::vector<std::unique_ptr<Core>> _cores;
+		bool _work_stealing = false;
+		std::atomic<uint32_t> _core_count{0};
+
+		std::atomic<bool> _stop_thread_flag{true};
+		std::atomic<uint32_t> _idle_core_count{0};
+	};
+}  // namespace pub
@@ -15,14 +15,21 @@ namespace cfg
 	struct IceCandidates : public Item
 	{
 		CFG_DECLARE_REF_GETTER_OF(GetIceCandidateList, _ice_candidate_list);
+		// Number of listeners per ICE port (See cfg::Port::GetWorkerCount())
+		CFG_DECLARE_GETTER_OF(GetWorkerCount, _worker_count);
 
 	protected:
 		void MakeParseList() override
 		{
 			RegisterValue<Optional>("IceCandidate", &_ice_candidate_list);
+			RegisterValue<Optional>("WorkerCount", &_worker_count, nullptr, [this]() -> bool {
+				return (_worker_count >= 1);
+			});
 		}
 
 		std::vector<IceCandidate> _ice_candidate_list{
 			IceCandidate("*:10000-10005/udp")};
+
+		int _worker_count = 1;
 	};
 }  // namespace cfg
\ No newline at end of file
@@ -22,6 +22,8 @@ namespace cfg
 
 		CFG_DECLARE_VIRTUAL_GETTER_OF(int, GetPort, _port_value)
 		CFG_DECLARE_VIRTUAL_GETTER_OF(ov::SocketType, GetSocketType, _socket_type)
+		// Number of listeners (each with its own thread) that share the port using SO_REUSEPORT
+		CFG_DECLARE_VIRTUAL_GETTER_OF(int, GetWorkerCount, _worker_count)
 
 	protected:
 		void MakeParseList() override
@@ -63,11 +65,17 @@ namespace cfg
 
 				return _socket_type != ov::SocketType::Unknown;
 			});
+
+			RegisterValue<Optional>("WorkerCount", &_worker_count, nullptr, [this]() -> bool {
+				return (_worker_count >= 1);
+			});
 		}
 
 		ov::String _port;
 
 		int _port_value = 0;
 		ov::SocketType _socket_type = ov::SocketType::Unknown;
+
+		int _worker_count = 1;
 	};
 }  // namespace cfg
\ No newline at end of file
@@ -28,6 +28,8 @@ namespace cfg
 
 		CFG_DECLARE_VIRTUAL_GETTER_OF(int, GetTlsPort, _tls_port_value)
 		CFG_DECLARE_VIRTUAL_GETTER_OF(ov::SocketType, GetTlsSocketType, _tls_socket_type)
+		// Hand the encryption over to the kernel (kTLS) after handshake if possible
+		CFG_DECLARE_VIRTUAL_GETTER_OF(bool, IsKernelTlsEnabled, _kernel_tls)
 
 	protected:
 		void MakeParseList() override
@@ -71,11 +73,15 @@ namespace cfg
 
 				return _tls_socket_type != ov::SocketType::Unknown;
 			});
+
+			RegisterValue<Optional>("KernelTLS", &_kernel_tls);
 		}
 
 		ov::String _tls_port;
 
 		int _tls_port_value = 0;
 		ov::SocketType _tls_socket_type = ov::SocketType::Unknown;
+
+		bool _kernel_tls = false;
 	};
 }  // namespace cfg
\ No newline at end of file
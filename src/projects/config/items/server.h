@@ -9,6 +9,7 @@
 #pragma once
 
 #include "bind/bind.h"
+#include "stream_workers.h"
 #include "virtual_hosts/virtual_hosts.h"
 
 namespace cfg
@@ -32,6 +33,8 @@ namespace cfg
 		CFG_DECLARE_REF_GETTER_OF(GetIp, _ip)
 		CFG_DECLARE_REF_GETTER_OF(GetBind, _bind)
 
+		CFG_DECLARE_REF_GETTER_OF(GetStreamWorkers, _stream_workers)
+
 		CFG_DECLARE_REF_GETTER_OF(GetVirtualHostList, _virtual_hosts.GetVirtualHostList())
 
 		// Deprecated - It has a bug
@@ -75,6 +78,8 @@ namespace cfg
 			RegisterValue("IP", &_ip);
 			RegisterValue("Bind", &_bind);
 
+			RegisterValue<Optional>("StreamWorkers", &_stream_workers);
+
 			RegisterValue<Optional>("VirtualHosts", &_virtual_hosts);
 		}
 
@@ -88,6 +93,8 @@ namespace cfg
 		ov::String _ip;
 		Bind _bind;
 
+		StreamWorkers _stream_workers;
+
 		VirtualHosts _virtual_hosts;
 	};
 }  // namespace cfg
\ No newline at end of file
@@ -0,0 +1,32 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+namespace cfg
+{
+	// Settings of the worker pool shared by the publisher streams (See pub::StreamWorkerPool)
+	struct StreamWorkers : public Item
+	{
+		// 0 means the number of hardware threads
+		CFG_DECLARE_GETTER_OF(GetCoreCount, _core_count)
+		// Let an idle core run the tasks queued on a busy core
+		CFG_DECLARE_GETTER_OF(IsWorkStealingEnabled, _work_stealing)
+
+	protected:
+		void MakeParseList() override
+		{
+			RegisterValue<Optional>("CoreCount", &_core_count, nullptr, [this]() -> bool {
+				return (_core_count >= 0);
+			});
+			RegisterValue<Optional>("WorkStealing", &_work_stealing);
+		}
+
+		int _core_count = 0;
+		bool _work_stealing = false;
+	};
+}  // namespace cfg
@@ -17,6 +17,8 @@ namespace cfg
 		CFG_DECLARE_OVERRIDED_GETTER_OF(ProviderType, GetType, ProviderType::RtspPull)
 
 		CFG_DECLARE_GETTER_OF(IsBlockDuplicateStreamName, _is_block_duplicate_stream_name)
+		// How to receive RTP from the camera ("TCP": interleaved in the RTSP connection, or "UDP")
+		CFG_DECLARE_REF_GETTER_OF(GetTransport, _transport)
 
 	protected:
 		void MakeParseList() override
@@ -24,10 +26,12 @@ namespace cfg
 			Provider::MakeParseList();
 
 			RegisterValue<Optional>("BlockDuplicateStreamName", &_is_block_duplicate_stream_name);
+			RegisterValue<Optional>("Transport", &_transport);
 		}
 
 		// true: block(disconnect) new incoming stream
 		// false: don't block new incoming stream
 		bool _is_block_duplicate_stream_name = true;
+		ov::String _transport = "TCP";
 	};
 }  // namespace cfg
\ No newline at end of file
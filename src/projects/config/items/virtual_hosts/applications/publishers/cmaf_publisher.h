@@ -20,6 +20,10 @@ namespace cfg
 		CFG_DECLARE_GETTER_OF(GetSegmentDuration, _segment_duration)
 		CFG_DECLARE_GETTER_OF(GetCrossDomains, _cross_domain.GetUrls())
 		CFG_DECLARE_GETTER_OF(GetThreadCount, _thread_count > 0 ? _thread_count : 1)
+		// What to do with a client that cannot receive the chunks as fast as they are created ("SkipToLive" or "Disconnect")
+		CFG_DECLARE_REF_GETTER_OF(GetLaggingClientPolicy, _lagging_client_policy)
+		// Number of the chunks that can be queued for a client before the policy is applied
+		CFG_DECLARE_GETTER_OF(GetMaxPendingChunks, _max_pending_chunks > 0 ? _max_pending_chunks : 1)
 
 	protected:
 		void MakeParseList() override
@@ -30,11 +34,15 @@ namespace cfg
 			RegisterValue<Optional>("SegmentDuration", &_segment_duration);
 			RegisterValue<Optional>("CrossDomain", &_cross_domain);
 			RegisterValue<Optional>("ThreadCount", &_thread_count);
+			RegisterValue<Optional>("LaggingClientPolicy", &_lagging_client_policy);
+			RegisterValue<Optional>("MaxPendingChunks", &_max_pending_chunks);
 		}
 
 		int _segment_count = 3;
 		int _segment_duration = 5;
 		CrossDomain _cross_domain;
 		int _thread_count = 4;
+		ov::String _lagging_client_policy = "SkipToLive";
+		int _max_pending_chunks = 60;
 	};
 }  // namespace cfg
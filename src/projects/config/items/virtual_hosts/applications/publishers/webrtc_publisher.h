@@ -18,6 +18,8 @@ namespace cfg
 		CFG_DECLARE_OVERRIDED_GETTER_OF(PublisherType, GetType, PublisherType::Webrtc)
 
 		CFG_DECLARE_REF_GETTER_OF(GetP2P, _p2p)
+		// Consecutive or Interleaved (See UlpfecMaskType)
+		CFG_DECLARE_GETTER_OF(GetFecMask, _fec_mask)
 
 	protected:
 		void MakeParseList() override
@@ -26,9 +28,11 @@ namespace cfg
 
 			RegisterValue<Optional>("Timeout", &_timeout);
 			RegisterValue<Optional>("P2P", &_p2p);
+			RegisterValue<Optional>("FECMask", &_fec_mask);
 		}
 
 		int _timeout = 0;
+		ov::String _fec_mask = "Consecutive";
 		P2P _p2p;
 	};
 }  // namespace cfg
\ No newline at end of file
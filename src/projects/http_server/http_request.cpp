@@ -11,6 +11,8 @@
 #include "http_private.h"
 
 #include <algorithm>
+#include <charconv>
+#include <strings.h>
 
 HttpRequest::HttpRequest(const std::shared_ptr<ov::ClientSocket> &client_socket, const std::shared_ptr<HttpRequestInterceptor> &interceptor)
 	: _client_socket(client_socket),
@@ -48,78 +50,85 @@ ssize_t HttpRequest::ProcessData(const std::shared_ptr<const ov::Data> &data)
 		return 0L;
 	}
 
-	const char NewLines[] = "\r\n\r\n";
-	// Exclude null character
-	const int NewLinesLength = OV_COUNTOF(NewLines) - 1;
-
-	ssize_t used_length = data->GetLength();
-
-	// Since the header has not been parsed yet, try to parse the header every time data comes in
-	ssize_t previous_length = _request_string.GetLength();
+	if (_header_buffer == nullptr)
+	{
+		_header_buffer = std::make_shared<ov::Data>();
+	}
 
-	// ov::String is binary-safe
-	_request_string.Append(data->GetDataAs<char>(), data->GetLength());
-	ssize_t newline_position = _request_string.IndexOf(&(NewLines[0]));
+	auto buffer = data->GetDataAs<char>();
+	size_t length = data->GetLength();
+	size_t used_length = 0;
 
-	if (newline_position >= 0)
+	// Find "\r\n\r\n" byte by byte, so the end of the header is found even if it is split into several data
+	//
+	// _header_terminator_matched
+	//   0: nothing matched, 1: "\r", 2: "\r\n", 3: "\r\n\r", 4: "\r\n\r\n"
+	while ((used_length < length) && (_header_terminator_matched < 4))
 	{
-		// If the parser find "\r\n\r\n", start parsing
-		_request_string.SetLength(newline_position);
+		char character = buffer[used_length];
+		used_length++;
 
-		// Used length =
-		//             [Length of string after finding "\r\n\r\n"] -
-		//             [Length of string before finding] +
-		//             [Length of string "\r\n\r\n"]
-		used_length = _request_string.GetLength() - previous_length + NewLinesLength;
+		switch (character)
+		{
+			case '\r':
+				_header_terminator_matched = (_header_terminator_matched == 2) ? 3 : 1;
+				break;
 
-		_is_header_found = true;
-		_parse_status = ParseMessage();
+			case '\n':
+				_header_terminator_matched = (_header_terminator_matched == 1) ? 2 : ((_header_terminator_matched == 3) ? 4 : 0);
+				break;
 
-		if (_parse_status == HttpStatusCode::OK)
-		{
-			// Calculate some informations such as Content length
-			PostProcess();
-		}
-		else
-		{
-			// An error occurred during parsing
-			used_length = -1L;
-			_parse_status = HttpStatusCode::BadRequest;
+			default:
+				_header_terminator_matched = 0;
+
+				// Check if data consists of non-binary data
+				//
+				// isprint(): 32 <= character <= 126
+				// isspace(): 9 <= character <= 13
+				// obs-text (0x80-0xFF) is allowed in the field-value
+				// reference: https://en.cppreference.com/w/cpp/string/byte/isprint
+				if ((::isprint(character) || ::isspace(character) || (static_cast<uint8_t>(character) >= 0x80)) == false)
+				{
+					// Binary data found
+					_parse_status = HttpStatusCode::BadRequest;
+					return -1L;
+				}
+				break;
 		}
 	}
-	else
+
+	if ((_header_buffer->GetLength() + used_length) > HTTP_MAX_HEADER_SIZE)
 	{
-		// Need more data
+		logtw("Too large header: %zu bytes (max: %d)", _header_buffer->GetLength() + used_length, HTTP_MAX_HEADER_SIZE);
+		_parse_status = HttpStatusCode::BadRequest;
+		return -1L;
+	}
 
-		// Check if data consists of non-binary data
-		auto data_to_check = data->GetDataAs<char>();
-		auto remained = data->GetLength();
+	_header_buffer->Append(buffer, used_length);
 
-		while (remained > 0)
-		{
-			char character = *data_to_check;
+	if (_header_terminator_matched < 4)
+	{
+		// Need more data
+		return static_cast<ssize_t>(used_length);
+	}
 
-			// isprint(): 32 <= character <= 126
-			// isspace(): 9 <= character <= 13
-			// reference: https://en.cppreference.com/w/cpp/string/byte/isprint
-			if (::isprint(character) || ::isspace(character))
-			{
-				character++;
-				remained--;
+	// If the parser find "\r\n\r\n", start parsing
+	_is_header_found = true;
+	_parse_status = ParseMessage();
 
-				continue;
-			}
-			else
-			{
-				// Binary data found
-				used_length = -1;
-				_parse_status = HttpStatusCode::BadRequest;
-				break;
-			}
-		}
+	if (_parse_status == HttpStatusCode::OK)
+	{
+		// Calculate some informations such as Content length
+		_parse_status = PostProcess();
 	}
 
-	return used_length;
+	if (_parse_status != HttpStatusCode::OK)
+	{
+		// An error occurred during parsing
+		return -1L;
+	}
+
+	return static_cast<ssize_t>(used_length);
 }
 
 HttpStatusCode HttpRequest::ParseMessage()
@@ -130,37 +139,54 @@ HttpStatusCode HttpRequest::ParseMessage()
 	//                  CRLF
 	//                  [ message-body ]
 
+	// Exclude the last "\r\n\r\n" (the empty line is not needed)
+	std::string_view message(_header_buffer->GetDataAs<char>(), _header_buffer->GetLength() - 4);
+
+	// RFC7230 - 3.5. Message Parsing Robustness
+	// In the interest of robustness, a server that is expecting to receive
+	// and parse a request-line SHOULD ignore at least one empty line (CRLF)
+	// received prior to the request-line.
+	while ((message.size() >= 2) && (message[0] == '\r') && (message[1] == '\n'))
+	{
+		message.remove_prefix(2);
+	}
+
 	// RFC7230 - 3.1. Start Line
 	// start-line     = request-line / status-line
+	bool is_request_line = true;
 
-	// Tokenize by "\r\n"
-	std::vector<ov::String> tokens = _request_string.Split("\r\n");
-
-	HttpStatusCode status_code;
+	while (true)
+	{
+		auto newline_position = message.find("\r\n");
+		auto line = message.substr(0, newline_position);
 
-	status_code = ParseRequestLine(tokens[0]);
-	tokens.erase(tokens.begin());
+		HttpStatusCode status_code = is_request_line ? ParseRequestLine(line) : ParseHeader(line);
 
-	if (status_code == HttpStatusCode::OK)
-	{
-		for (const ov::String &token : tokens)
+		if (status_code != HttpStatusCode::OK)
 		{
-			status_code = ParseHeader(token);
+			return status_code;
+		}
 
-			if (status_code != HttpStatusCode::OK)
-			{
-				break;
-			}
+		is_request_line = false;
+
+		if (newline_position == std::string_view::npos)
+		{
+			break;
 		}
+
+		message.remove_prefix(newline_position + 2);
 	}
 
-	logtd("Request Headers: %ld:", _request_header.size());
+	logtd("Request Headers: %zu:", _header_count);
 
-	std::for_each(_request_header.begin(), _request_header.end(), [](const auto &pair) -> void {
-		logtd("\t>> %s: %s", pair.first.CStr(), pair.second.CStr());
-	});
+	for (size_t index = 0; index < _header_count; index++)
+	{
+		[[maybe_unused]] auto &field = GetHeaderField(index);
 
-	return status_code;
+		logtd("\t>> %.*s: %.*s", static_cast<int>(field.name.size()), field.name.data(), static_cast<int>(field.value.size()), field.value.data());
+	}
+
+	return HttpStatusCode::OK;
 }
 
 #define HTTP_COMPARE_METHOD(text, value_if_matches) \
@@ -169,23 +195,23 @@ HttpStatusCode HttpRequest::ParseMessage()
 		_method = value_if_matches;                 \
 	}
 
-HttpStatusCode HttpRequest::ParseRequestLine(const ov::String &line)
+HttpStatusCode HttpRequest::ParseRequestLine(const std::string_view &line)
 {
 	// RFC7230 - 3.1.1. Request Line
 	// request-line   = method SP request-target SP HTTP-version CRLF
-	ssize_t first_space_index = line.IndexOf(' ');
-	ssize_t last_space_index = line.IndexOfRev(' ');
+	auto first_space_index = line.find(' ');
+	auto last_space_index = line.rfind(' ');
 
-	if ((first_space_index < 0) || (last_space_index < 0) || (first_space_index == last_space_index))
+	if ((first_space_index == std::string_view::npos) || (first_space_index == last_space_index))
 	{
-		logtw("Invalid space index: first: %d, last: %d, line: %s", first_space_index, last_space_index, line.CStr());
+		logtw("Invalid request line: %.*s", static_cast<int>(line.size()), line.data());
 		return HttpStatusCode::BadRequest;
 	}
 
 	_method = HttpMethod::Unknown;
 
 	// RFC7231 - 4. Request Methods
-	ov::String method = line.Left(static_cast<size_t>(first_space_index));
+	auto method = line.substr(0, first_space_index);
 
 	HTTP_COMPARE_METHOD("GET", HttpMethod::Get);
 	HTTP_COMPARE_METHOD("HEAD", HttpMethod::Head);
@@ -198,7 +224,7 @@ HttpStatusCode HttpRequest::ParseRequestLine(const ov::String &line)
 
 	if (_method == HttpMethod::Unknown)
 	{
-		logtw("Unknown method: %s", method.CStr());
+		logtw("Unknown method: %.*s", static_cast<int>(method.size()), method.data());
 		return HttpStatusCode::MethodNotAllowed;
 	}
 
@@ -207,18 +233,45 @@ HttpStatusCode HttpRequest::ParseRequestLine(const ov::String &line)
 	//            / absolute-form
 	//            / authority-form
 	//            / asterisk-form
-	_request_target = line.Substring(first_space_index + 1, static_cast<size_t>(last_space_index - first_space_index - 1));
+	auto request_target = line.substr(first_space_index + 1, last_space_index - first_space_index - 1);
+	_request_target = ov::String(request_target.data(), request_target.size());
 
 	// RFC7230 - 2.6. Protocol Versioning
 	// HTTP-version  = HTTP-name "/" DIGIT "." DIGIT
 	// HTTP-name     = %x48.54.54.50 ; "HTTP", case-sensitive
-	_http_version = line.Substring(last_space_index + 1);
+	auto http_version = line.substr(last_space_index + 1);
+	_http_version = ov::String(http_version.data(), http_version.size());
+
+	if ((http_version.size() != 8) || (http_version.compare(0, 5, "HTTP/") != 0) ||
+		(::isdigit(http_version[5]) == false) || (http_version[6] != '.') || (::isdigit(http_version[7]) == false))
+	{
+		logtw("Invalid HTTP version: %s", _http_version.CStr());
+		return HttpStatusCode::BadRequest;
+	}
+
+	_http_version_number = (http_version[5] - '0') + ((http_version[7] - '0') / 10.0);
 
-	logtd("Method: [%s], uri: [%s], version: [%s]", method.CStr(), _request_target.CStr(), _http_version.CStr());
+	logtd("Method: [%.*s], uri: [%s], version: [%s]", static_cast<int>(method.size()), method.data(), _request_target.CStr(), _http_version.CStr());
 	return HttpStatusCode::OK;
 }
 
-HttpStatusCode HttpRequest::ParseHeader(const ov::String &line)
+static inline std::string_view TrimOws(std::string_view value)
+{
+	// OWS = *( SP / HTAB )
+	while ((value.empty() == false) && ((value.front() == ' ') || (value.front() == '\t')))
+	{
+		value.remove_prefix(1);
+	}
+
+	while ((value.empty() == false) && ((value.back() == ' ') || (value.back() == '\t')))
+	{
+		value.remove_suffix(1);
+	}
+
+	return value;
+}
+
+HttpStatusCode HttpRequest::ParseHeader(const std::string_view &line)
 {
 	// RFC7230 - 3.2.  Header Fields
 	// header-field   = field-name ":" OWS field-value OWS
@@ -244,24 +297,69 @@ HttpStatusCode HttpRequest::ParseHeader(const ov::String &line)
 	// the obs-fold rule) unless the message is intended for packaging
 	// within the message/http media type.
 
-	ssize_t colon_index = line.IndexOf(':');
+	auto colon_index = line.find(':');
+
+	if ((colon_index == std::string_view::npos) || (colon_index == 0))
+	{
+		logtw("Invalid header (could not find colon): %.*s", static_cast<int>(line.size()), line.data());
+		return HttpStatusCode::BadRequest;
+	}
 
-	if (colon_index == -1)
+	// RFC7230 - 3.2.4.  Field Parsing
+	// No whitespace is allowed between the header field-name and colon.
+	auto field_name = line.substr(0, colon_index);
+
+	if ((field_name.back() == ' ') || (field_name.back() == '\t'))
 	{
-		logtw("Invalid header (could not find colon): %s", line.CStr());
+		logtw("Invalid header (whitespace before colon): %.*s", static_cast<int>(line.size()), line.data());
 		return HttpStatusCode::BadRequest;
 	}
 
-	// Convert all header names to uppercase
-	ov::String field_name = line.Left(static_cast<size_t>(colon_index)).UpperCaseString();
 	// Eliminate OWS(optional white space) to simplify processing
-	ov::String field_value = line.Substring(colon_index + 1).Trim();
+	HttpHeaderField field{field_name, TrimOws(line.substr(colon_index + 1))};
+
+	if (_header_count < HTTP_INLINE_HEADER_COUNT)
+	{
+		_inline_header_list[_header_count] = field;
+	}
+	else
+	{
+		_extra_header_list.push_back(field);
+	}
 
-	_request_header[field_name] = field_value;
+	_header_count++;
 
 	return HttpStatusCode::OK;
 }
 
+static inline bool IsEqualIgnoreCase(const std::string_view &value1, const std::string_view &value2)
+{
+	return (value1.size() == value2.size()) && (::strncasecmp(value1.data(), value2.data(), value1.size()) == 0);
+}
+
+const HttpHeaderField *HttpRequest::FindHeaderField(const std::string_view &key) const noexcept
+{
+	// If the same field is received several times, the last one is used (same as the previous implementation)
+	for (size_t index = _header_count; index > 0; index--)
+	{
+		auto &field = GetHeaderField(index - 1);
+
+		if (IsEqualIgnoreCase(field.name, key))
+		{
+			return &field;
+		}
+	}
+
+	return nullptr;
+}
+
+std::string_view HttpRequest::GetHeaderView(const std::string_view &key) const noexcept
+{
+	auto field = FindHeaderField(key);
+
+	return (field != nullptr) ? field->value : std::string_view();
+}
+
 ov::String HttpRequest::GetHeader(const ov::String &key) const noexcept
 {
 	return GetHeader(key, "");
@@ -269,23 +367,46 @@ ov::String HttpRequest::GetHeader(const ov::String &key) const noexcept
 
 ov::String HttpRequest::GetHeader(const ov::String &key, ov::String default_value) const noexcept
 {
-	auto item = _request_header.find(key.UpperCaseString());
+	auto field = FindHeaderField(std::string_view(key.CStr(), key.GetLength()));
 
-	if (item == _request_header.cend())
+	if (field == nullptr)
 	{
 		return std::move(default_value);
 	}
 
-	return item->second;
+	return ov::String(field->value.data(), field->value.size());
 }
 
 const bool HttpRequest::IsHeaderExists(const ov::String &key) const noexcept
 {
-	return _request_header.find(key.UpperCaseString()) != _request_header.cend();
+	return FindHeaderField(std::string_view(key.CStr(), key.GetLength())) != nullptr;
+}
+
+bool HttpRequest::IsKeepAlive() const noexcept
+{
+	// The connection is taken over by another protocol
+	if (FindHeaderField("Upgrade") != nullptr)
+	{
+		return false;
+	}
+
+	auto connection = GetHeaderView("Connection");
+
+	// RFC7230 - 6.3. Persistence
+	// HTTP/1.1 defaults to the use of "persistent connections",
+	// HTTP/1.0 requires "keep-alive" connection option
+	if (_http_version_number > 1.0)
+	{
+		return IsEqualIgnoreCase(connection, "close") == false;
+	}
+
+	return IsEqualIgnoreCase(connection, "keep-alive");
 }
 
-void HttpRequest::PostProcess()
+HttpStatusCode HttpRequest::PostProcess()
 {
+	auto content_length = GetHeaderView("Content-Length");
+
 	switch (_method)
 	{
 		case HttpMethod::Get:
@@ -293,25 +414,35 @@ void HttpRequest::PostProcess()
 			_content_length = 0L;
 			break;
 
-		case HttpMethod::Post:
+		default:
 			// TODO(dimiden): Need to parse HTTP body if needed
-			_content_length = ov::Converter::ToInt64(GetHeader("CONTENT-LENGTH", "0"));
-			break;
+			_content_length = 0L;
 
-		default:
-			// Another method
-			_content_length = ov::Converter::ToInt64(GetHeader("CONTENT-LENGTH", "0"));
+			if (content_length.empty() == false)
+			{
+				auto result = std::from_chars(content_length.data(), content_length.data() + content_length.size(), _content_length);
+
+				if ((result.ec != std::errc()) || (result.ptr != (content_length.data() + content_length.size())) || (_content_length < 0L))
+				{
+					logtw("Invalid Content-Length: %.*s", static_cast<int>(content_length.size()), content_length.data());
+					return HttpStatusCode::BadRequest;
+				}
+			}
 			break;
 	}
 
-	auto host = GetHeader("Host");
+	auto host = GetHeaderView("Host");
 
-	if (host.IsEmpty())
+	if (host.empty())
 	{
-		host = _client_socket->GetLocalAddress()->GetIpAddress();
+		_request_uri.Format("http%s://%s%s", (_tls_data != nullptr) ? "s" : "", _client_socket->GetLocalAddress()->GetIpAddress().CStr(), _request_target.CStr());
+	}
+	else
+	{
+		_request_uri.Format("http%s://%.*s%s", (_tls_data != nullptr) ? "s" : "", static_cast<int>(host.size()), host.data(), _request_target.CStr());
 	}
 
-	_request_uri.Format("http%s://%s%s", (_tls_data != nullptr) ? "s" : "", host.CStr(), _request_target.CStr());
+	return HttpStatusCode::OK;
 }
 
 ov::String HttpRequest::ToString() const
@@ -11,8 +11,23 @@
 #include "http_datastructure.h"
 #include "interceptors/http_request_interceptor.h"
 
+#include <array>
+#include <string_view>
+
+// Maximum size of the request line and header fields
+#define HTTP_MAX_HEADER_SIZE (64 * 1024)
+// Number of the header fields that are stored without allocation
+#define HTTP_INLINE_HEADER_COUNT (24)
+
 class HttpClient;
 
+// A header field of the request (Points to the header buffer of HttpRequest)
+struct HttpHeaderField
+{
+	std::string_view name;
+	std::string_view value;
+};
+
 class HttpRequest : public ov::EnableSharedFromThis<HttpRequest>
 {
 public:
@@ -29,6 +44,9 @@ public:
 
 	/// HttpRequest 객체 초기화를 위해, client에서 보낸 데이터를 처리함
 	///
+	/// The data is parsed incrementally: only the bytes up to the end of the header ("\r\n\r\n") are consumed,
+	/// so the rest of the data (body or the next pipelined request) can be processed by the caller.
+	///
 	/// @param data 수신한 데이터
 	///
 	/// @return HTTP 파싱에 사용한 데이터 크기. 만약 파싱 도중 오류가 발생하면 -1L을 반환함
@@ -56,14 +74,7 @@ public:
 
 	double GetHttpVersionAsNumber() const noexcept
 	{
-		auto tokens = _http_version.Split("/");
-
-		if (tokens.size() != 2)
-		{
-			return 0.0;
-		}
-
-		return ov::Converter::ToDouble(tokens[1]);
+		return _http_version_number;
 	}
 
 	// Full URI (including domain and port)
@@ -93,11 +104,37 @@ public:
 		return _request_body;
 	}
 
-	const std::map<ov::String, ov::String, ov::CaseInsensitiveComparator> &GetRequestHeader() const noexcept
+	// Number of the body bytes that are not received yet (Updated by HttpServer)
+	size_t GetRemainingBodyLength() const noexcept
+	{
+		return (_content_length > 0L) ? (static_cast<size_t>(_content_length) - _received_body_length) : 0;
+	}
+
+	void OnBodyReceived(size_t length) noexcept
+	{
+		_received_body_length += std::min(length, GetRemainingBodyLength());
+	}
+
+	// Whether the next request can be received through the connection after this request
+	// (false if the connection is closed after the response, or upgraded to another protocol such as WebSocket)
+	bool IsKeepAlive() const noexcept;
+
+	size_t GetHeaderCount() const noexcept
 	{
-		return _request_header;
+		return _header_count;
 	}
 
+	const HttpHeaderField &GetHeaderField(size_t index) const noexcept
+	{
+		return (index < HTTP_INLINE_HEADER_COUNT) ? _inline_header_list[index] : _extra_header_list[index - HTTP_INLINE_HEADER_COUNT];
+	}
+
+	// Finds the header without allocation (case-insensitive)
+	// The returned view is valid while the request is alive
+	//
+	// @return The value of the header, or an empty view if the header does not exist
+	std::string_view GetHeaderView(const std::string_view &key) const noexcept;
+
 	ov::String GetHeader(const ov::String &key) const noexcept;
 	ov::String GetHeader(const ov::String &key, ov::String default_value) const noexcept;
 	const bool IsHeaderExists(const ov::String &key) const noexcept;
@@ -131,19 +168,6 @@ public:
 
 	ov::String ToString() const;
 
-	void InitParseInfo()
-	{
-		_parse_status = HttpStatusCode::PartialContent;
-
-		_is_header_found = false;
-		_request_string = "";
-		_request_header.clear();
-
-		_method = HttpMethod::Unknown;
-		_request_target = "";
-		_http_version = "";
-	}
-
 protected:
 	// HttpRequestInterceptorInterface를 통해, 다른 interceptor에서 사용됨
 	const std::shared_ptr<ov::Data> &GetRequestBodyInternal()
@@ -157,10 +181,12 @@ protected:
 	}
 
 	HttpStatusCode ParseMessage();
-	HttpStatusCode ParseRequestLine(const ov::String &line);
-	HttpStatusCode ParseHeader(const ov::String &line);
+	HttpStatusCode ParseRequestLine(const std::string_view &line);
+	HttpStatusCode ParseHeader(const std::string_view &line);
+
+	const HttpHeaderField *FindHeaderField(const std::string_view &key) const noexcept;
 
-	void PostProcess();
+	HttpStatusCode PostProcess();
 
 	std::shared_ptr<ov::ClientSocket> _client_socket;
 	std::shared_ptr<ov::TlsData> _tls_data;
@@ -175,15 +201,23 @@ protected:
 	ov::String _request_uri;
 	ov::String _request_target;
 	ov::String _http_version;
+	double _http_version_number = 0.0;
 
 	// request 헤더
 	bool _is_header_found = false;
-	// 헤더 영역을 추출해내기 위해 임시로 사용되는 문자열 버퍼
-	ov::String _request_string;
-	std::map<ov::String, ov::String, ov::CaseInsensitiveComparator> _request_header;
+	// The request line and header fields (the header fields point into this buffer)
+	std::shared_ptr<ov::Data> _header_buffer;
+	// How many bytes of "\r\n\r\n" are matched at the end of _header_buffer (the end of the header can be split into several data)
+	int _header_terminator_matched = 0;
+
+	std::array<HttpHeaderField, HTTP_INLINE_HEADER_COUNT> _inline_header_list;
+	// Used only if the request has more than HTTP_INLINE_HEADER_COUNT header fields
+	std::vector<HttpHeaderField> _extra_header_list;
+	size_t _header_count = 0;
 
 	// 자주 사용하는 헤더 값은 미리 저장해놓음
 	ssize_t _content_length = 0L;
+	size_t _received_body_length = 0;
 
 	// HTTP body
 	std::shared_ptr<ov::Data> _request_body;
@@ -22,6 +22,31 @@ HttpResponse::HttpResponse(const std::shared_ptr<ov::ClientSocket> &client_socke
 	OV_ASSERT2(_client_socket != nullptr);
 }
 
+HttpResponse::~HttpResponse()
+{
+	// The next response must not wait for a response that is discarded without being completed
+	Complete();
+}
+
+void HttpResponse::SetPreviousResponse(const std::shared_ptr<HttpResponse> &previous_response)
+{
+	if (previous_response == nullptr)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(previous_response->_order_mutex);
+
+	if (previous_response->_is_completed && previous_response->_is_previous_response_completed)
+	{
+		// All data of the previous response has been sent
+		return;
+	}
+
+	_is_previous_response_completed = false;
+	previous_response->_next_response = GetSharedPtr();
+}
+
 void HttpResponse::SetTlsData(const std::shared_ptr<ov::TlsData> &tls_data)
 {
 	_tls_data = tls_data;
@@ -99,7 +124,15 @@ uint32_t HttpResponse::Response()
 {
 	std::lock_guard<decltype(_response_mutex)> lock(_response_mutex);
 
-	return SendHeaderIfNeeded() + SendResponse();
+	auto sent_bytes = SendHeaderIfNeeded() + SendResponse();
+
+	if (_chunked_transfer == false)
+	{
+		// The response has Content-Length, so it is completed (a chunked response is completed by the last chunk)
+		Complete();
+	}
+
+	return sent_bytes;
 }
 
 uint32_t HttpResponse::SendHeaderIfNeeded()
@@ -159,6 +192,16 @@ bool HttpResponse::Send(const std::shared_ptr<const ov::Data> &data)
 		return false;
 	}
 
+	if (QueueIfPreviousResponseNotCompleted(data))
+	{
+		return true;
+	}
+
+	return SendToSocket(data);
+}
+
+bool HttpResponse::SendToSocket(const std::shared_ptr<const ov::Data> &data)
+{
 	std::shared_ptr<const ov::Data> send_data;
 
 	if (_tls_data == nullptr)
@@ -182,6 +225,115 @@ bool HttpResponse::Send(const std::shared_ptr<const ov::Data> &data)
 	return (_client_socket->Send(send_data) == static_cast<ssize_t>(send_data->GetLength()));
 }
 
+bool HttpResponse::Send(const std::vector<std::shared_ptr<const ov::Data>> &data_list)
+{
+	{
+		std::lock_guard<std::mutex> lock(_order_mutex);
+
+		if (_is_previous_response_completed == false)
+		{
+			_pending_data_list.insert(_pending_data_list.end(), data_list.begin(), data_list.end());
+			return true;
+		}
+	}
+
+	return SendToSocket(data_list);
+}
+
+bool HttpResponse::SendToSocket(const std::vector<std::shared_ptr<const ov::Data>> &data_list)
+{
+	if (_tls_data == nullptr)
+	{
+		// The socket sends the buffers with one system call
+		size_t length = 0;
+
+		for (auto &data : data_list)
+		{
+			length += data->GetLength();
+		}
+
+		return (_client_socket->Send(data_list) == static_cast<ssize_t>(length));
+	}
+
+	// Encrypt the buffers as one record instead of encrypting each of them
+	auto data = std::make_shared<ov::Data>();
+
+	for (auto &item : data_list)
+	{
+		data->Append(item);
+	}
+
+	return SendToSocket(data);
+}
+
+bool HttpResponse::QueueIfPreviousResponseNotCompleted(const std::shared_ptr<const ov::Data> &data)
+{
+	std::lock_guard<std::mutex> lock(_order_mutex);
+
+	if (_is_previous_response_completed)
+	{
+		return false;
+	}
+
+	_pending_data_list.push_back(data);
+
+	return true;
+}
+
+void HttpResponse::Complete()
+{
+	std::shared_ptr<HttpResponse> next_response;
+
+	{
+		std::lock_guard<std::mutex> lock(_order_mutex);
+
+		if (_is_completed)
+		{
+			return;
+		}
+
+		_is_completed = true;
+
+		if (_is_previous_response_completed)
+		{
+			next_response = std::move(_next_response);
+		}
+	}
+
+	if (next_response != nullptr)
+	{
+		next_response->OnPreviousResponseCompleted();
+	}
+}
+
+void HttpResponse::OnPreviousResponseCompleted()
+{
+	std::shared_ptr<HttpResponse> next_response;
+
+	{
+		// Send the pending data under the lock, so that the data sent by Send() from now on follows them
+		std::lock_guard<std::mutex> lock(_order_mutex);
+
+		if (_pending_data_list.empty() == false)
+		{
+			SendToSocket(_pending_data_list);
+			_pending_data_list.clear();
+		}
+
+		_is_previous_response_completed = true;
+
+		if (_is_completed)
+		{
+			next_response = std::move(_next_response);
+		}
+	}
+
+	if (next_response != nullptr)
+	{
+		next_response->OnPreviousResponseCompleted();
+	}
+}
+
 bool HttpResponse::SendChunkedData(const void *data, size_t length)
 {
 	return SendChunkedData(std::make_shared<ov::Data>(data, length));
@@ -192,18 +344,28 @@ bool HttpResponse::SendChunkedData(const std::shared_ptr<const ov::Data> &data)
 	if ((data == nullptr) || data->IsEmpty())
 	{
 		// Send a empty chunk
-		return Send("0\r\n\r\n", 5);
+		auto result = Send("0\r\n\r\n", 5);
+
+		// The last chunk completes the response
+		Complete();
+
+		return result;
 	}
 
-	bool result =
-		// Send the chunk header
-		Send(ov::String::FormatString("%x\r\n", data->GetLength()).ToData(false)) &&
-		// Send the chunk payload
-		Send(data) &&
-		// Send a last data of chunk
-		Send("\r\n", 2);
+	return Send(MakeChunk(data));
+}
 
-	return result;
+std::vector<std::shared_ptr<const ov::Data>> HttpResponse::MakeChunk(const std::shared_ptr<const ov::Data> &data)
+{
+	static const auto chunk_trailer = std::make_shared<const ov::Data>("\r\n", 2);
+
+	return {
+		// The chunk header
+		ov::String::FormatString("%zx\r\n", data->GetLength()).ToData(false),
+		// The chunk payload
+		data,
+		// A last data of chunk
+		chunk_trailer};
 }
 
 uint32_t HttpResponse::SendResponse()
@@ -252,5 +414,10 @@ bool HttpResponse::Close()
 		return false;
 	}
 
-	return _client_socket->Close();
+	auto result = _client_socket->Close();
+
+	// The pipelined responses after this can not be sent anymore, but they must not be kept waiting
+	Complete();
+
+	return result;
 }
@@ -23,7 +23,11 @@ public:
 	};
 
 	HttpResponse(const std::shared_ptr<ov::ClientSocket> &client_socket);
-	~HttpResponse() override = default;
+	~HttpResponse() override;
+
+	// Pipelined responses must be sent in the order of the requests,
+	// so the data of this response is queued until the previous response is completed
+	void SetPreviousResponse(const std::shared_ptr<HttpResponse> &previous_response);
 
 	std::shared_ptr<ov::ClientSocket> GetRemote();
 	std::shared_ptr<const ov::ClientSocket> GetRemote() const;
@@ -72,10 +76,16 @@ public:
 	}
 	virtual bool Send(const void *data, size_t length);
 	virtual bool Send(const std::shared_ptr<const ov::Data> &data);
+	// Sends the buffers at once, as if they were one contiguous buffer
+	virtual bool Send(const std::vector<std::shared_ptr<const ov::Data>> &data_list);
 
 	bool SendChunkedData(const void *data, size_t length);
 	bool SendChunkedData(const std::shared_ptr<const ov::Data> &data);
 
+	// Makes a chunk of the chunked transfer encoding ([size in hex]\r\n[data]\r\n) without copying the data.
+	// The chunk can be shared by several responses, and sent with Send(data_list)
+	static std::vector<std::shared_ptr<const ov::Data>> MakeChunk(const std::shared_ptr<const ov::Data> &data);
+
 	uint32_t Response();
 
 	bool Close();
@@ -100,6 +110,15 @@ protected:
 	uint32_t SendHeaderIfNeeded();
 	uint32_t SendResponse();
 
+	// Returns true if the data is queued to be sent after the previous response
+	bool QueueIfPreviousResponseNotCompleted(const std::shared_ptr<const ov::Data> &data);
+	bool SendToSocket(const std::shared_ptr<const ov::Data> &data);
+	bool SendToSocket(const std::vector<std::shared_ptr<const ov::Data>> &data_list);
+
+	// Called when the whole response is sent (Content-Length is sent, the last chunk is sent, or the socket is closed)
+	void Complete();
+	void OnPreviousResponseCompleted();
+
 	std::shared_ptr<ov::ClientSocket> _client_socket;
 	std::shared_ptr<ov::TlsData> _tls_data;
 
@@ -120,4 +139,12 @@ protected:
 	ov::String _default_value = "";
 
 	bool _chunked_transfer = false;
+
+	// Guards the order of the pipelined responses (See SetPreviousResponse())
+	std::mutex _order_mutex;
+	bool _is_previous_response_completed = true;
+	bool _is_completed = false;
+	// The data that is waiting for the previous response (not encrypted yet)
+	std::vector<std::shared_ptr<const ov::Data>> _pending_data_list;
+	std::shared_ptr<HttpResponse> _next_response;
 };
@@ -17,7 +17,7 @@ HttpServer::~HttpServer()
 	OV_ASSERT2(_physical_port == nullptr);
 }
 
-bool HttpServer::Start(const ov::SocketAddress &address)
+bool HttpServer::Start(const ov::SocketAddress &address, int worker_count)
 {
 	if (_physical_port != nullptr)
 	{
@@ -25,7 +25,7 @@ bool HttpServer::Start(const ov::SocketAddress &address)
 		return false;
 	}
 
-	_physical_port = PhysicalPortManager::Instance()->CreatePort(ov::SocketType::Tcp, address);
+	_physical_port = PhysicalPortManager::Instance()->CreatePort(ov::SocketType::Tcp, address, worker_count);
 
 	if (_physical_port != nullptr)
 	{
@@ -103,26 +103,58 @@ std::shared_ptr<HttpClient> HttpServer::FindClient(const std::shared_ptr<ov::Soc
 	return nullptr;
 }
 
-void HttpServer::ProcessData(const std::shared_ptr<HttpClient> &client, const std::shared_ptr<const ov::Data> &data)
+std::shared_ptr<HttpClient> HttpServer::RenewClient(const std::shared_ptr<HttpClient> &client)
 {
-	if (client != nullptr)
+	// Create a new request for the next request of the persistent connection.
+	// The previous request is not reused, because it can be still referenced by the interceptor
+	// (e.g. the segment worker that is making a response of the request)
+	auto prev_request = client->GetRequest();
+	auto prev_response = client->GetResponse();
+
+	auto request = std::make_shared<HttpRequest>(prev_request->GetRemote(), _default_interceptor);
+	request->SetTlsData(prev_request->GetTlsData());
+
+	// The response is not reused either, since the worker can be still sending the previous response through it.
+	// The new response is sent after the previous one is completed, to keep the order of the pipelined requests
+	auto response = std::make_shared<HttpResponse>(prev_response->GetRemote());
+	response->SetTlsData(prev_response->GetTlsData());
+	response->SetHeader("Server", "OvenMediaEngine");
+	response->SetHeader("Content-Type", "text/html");
+	response->SetPreviousResponse(prev_response);
+
+	auto http_client = std::make_shared<HttpClient>(GetSharedPtr(), request, response);
+
+	std::lock_guard<std::mutex> guard(_client_list_mutex);
+
+	auto item = _client_list.find(request->GetRemote().get());
+
+	if (item != _client_list.end())
 	{
-		std::shared_ptr<HttpRequest> request = client->GetRequest();
-		std::shared_ptr<HttpResponse> response = client->GetResponse();
+		item->second = http_client;
+	}
 
-		bool need_to_disconnect = false;
+	return http_client;
+}
 
-		// header parse (temp)
-		// - http1.0 Connection default : close
-		// - http1.1 Connection default : keep-alive
-		if (request->ParseStatus() == HttpStatusCode::OK && request->GetRequestInterceptor() != nullptr)
-		{
-			if ((request->GetHttpVersionAsNumber() > 1.0 && request->GetHeader("Connection", "keep-alive") == "keep-alive") ||
-				(request->GetHttpVersionAsNumber() <= 1.0 && request->GetHeader("Connection", "close") == "keep-alive"))
-			{
-				request->InitParseInfo();
-			}
-		}
+void HttpServer::ProcessData(const std::shared_ptr<HttpClient> &http_client, const std::shared_ptr<const ov::Data> &data)
+{
+	if (http_client == nullptr)
+	{
+		return;
+	}
+
+	auto client = http_client;
+	auto remained_data = data;
+	bool need_to_disconnect = false;
+
+	// The data can contain several requests (pipelining), so process the data until it is consumed
+	//
+	// - http1.0 Connection default : close
+	// - http1.1 Connection default : keep-alive
+	while ((need_to_disconnect == false) && (remained_data->GetLength() > 0))
+	{
+		std::shared_ptr<HttpRequest> request = client->GetRequest();
+		std::shared_ptr<HttpResponse> response = client->GetResponse();
 
 		switch (request->ParseStatus())
 		{
@@ -130,15 +162,35 @@ void HttpServer::ProcessData(const std::shared_ptr<HttpClient> &client, const st
 			{
 				auto &interceptor = request->GetRequestInterceptor();
 
-				if (interceptor != nullptr)
+				if (interceptor == nullptr)
 				{
-					// If the request is parsed, bypass to the interceptor
-					need_to_disconnect = (interceptor->OnHttpData(client, data) == HttpInterceptorResult::Disconnect);
+					OV_ASSERT2(false);
+					need_to_disconnect = true;
+					break;
+				}
+
+				size_t remaining_body_length = request->GetRemainingBodyLength();
+
+				if (remaining_body_length > 0)
+				{
+					// The body of the request
+					size_t length = std::min(remaining_body_length, remained_data->GetLength());
+
+					request->OnBodyReceived(length);
+					need_to_disconnect = (interceptor->OnHttpData(client, remained_data->Subdata(0L, length)) == HttpInterceptorResult::Disconnect);
+					remained_data = remained_data->Subdata(length);
+				}
+				else if (request->IsKeepAlive())
+				{
+					// The next request of the persistent connection
+					client = RenewClient(client);
 				}
 				else
 				{
-					OV_ASSERT2(false);
-					need_to_disconnect = true;
+					// If the request is parsed, bypass to the interceptor
+					// (The connection is upgraded to another protocol, or will be closed after the response)
+					need_to_disconnect = (interceptor->OnHttpData(client, remained_data) == HttpInterceptorResult::Disconnect);
+					remained_data = remained_data->Subdata(remained_data->GetLength());
 				}
 
 				break;
@@ -147,10 +199,12 @@ void HttpServer::ProcessData(const std::shared_ptr<HttpClient> &client, const st
 			case HttpStatusCode::PartialContent:
 			{
 				// Need to parse HTTP header
-				ssize_t processed_length = TryParseHeader(client, data);
+				ssize_t processed_length = TryParseHeader(client, remained_data);
 
 				if (processed_length >= 0)
 				{
+					remained_data = remained_data->Subdata(processed_length);
+
 					if (request->ParseStatus() == HttpStatusCode::OK)
 					{
 						// Parsing is completed
@@ -177,6 +231,7 @@ void HttpServer::ProcessData(const std::shared_ptr<HttpClient> &client, const st
 
 							need_to_disconnect = true;
 							OV_ASSERT2(false);
+							break;
 						}
 
 						auto remote = request->GetRemote();
@@ -186,8 +241,23 @@ void HttpServer::ProcessData(const std::shared_ptr<HttpClient> &client, const st
 							logti("Client(%s) is requested uri: [%s]", remote->GetRemoteAddress()->ToString().CStr(), request->GetUri().CStr());
 						}
 
-						need_to_disconnect = need_to_disconnect || (interceptor->OnHttpPrepare(client) == HttpInterceptorResult::Disconnect);
-						need_to_disconnect = need_to_disconnect || (interceptor->OnHttpData(client, data->Subdata(processed_length)) == HttpInterceptorResult::Disconnect);
+						need_to_disconnect = (interceptor->OnHttpPrepare(client) == HttpInterceptorResult::Disconnect);
+
+						if (need_to_disconnect == false)
+						{
+							// OnHttpData() is called once even if there is no body, since some interceptors make a response in it
+							size_t length = remained_data->GetLength();
+
+							if (request->IsKeepAlive())
+							{
+								// Pass the body only - the rest is the next request
+								length = std::min(request->GetRemainingBodyLength(), length);
+								request->OnBodyReceived(length);
+							}
+
+							need_to_disconnect = (interceptor->OnHttpData(client, remained_data->Subdata(0L, length)) == HttpInterceptorResult::Disconnect);
+							remained_data = remained_data->Subdata(length);
+						}
 					}
 					else if (request->ParseStatus() == HttpStatusCode::PartialContent)
 					{
@@ -197,7 +267,7 @@ void HttpServer::ProcessData(const std::shared_ptr<HttpClient> &client, const st
 				else
 				{
 					// An error occurred with the request
-					request->GetRequestInterceptor()->OnHttpError(client, HttpStatusCode::BadRequest);
+					request->GetRequestInterceptor()->OnHttpError(client, request->ParseStatus());
 					need_to_disconnect = true;
 				}
 
@@ -211,13 +281,15 @@ void HttpServer::ProcessData(const std::shared_ptr<HttpClient> &client, const st
 				need_to_disconnect = true;
 				break;
 		}
+	}
 
-		if (need_to_disconnect)
-		{
-			// 연결을 종료해야 함
-			response->Response();
-			response->Close();
-		}
+	if (need_to_disconnect)
+	{
+		// 연결을 종료해야 함
+		auto response = client->GetResponse();
+
+		response->Response();
+		response->Close();
 	}
 }
 
@@ -29,7 +29,7 @@ public:
 	HttpServer() = default;
 	~HttpServer() override;
 
-	virtual bool Start(const ov::SocketAddress &address);
+	virtual bool Start(const ov::SocketAddress &address, int worker_count = 1);
 	virtual bool Stop();
 
 	bool AddInterceptor(const std::shared_ptr<HttpRequestInterceptor> &interceptor);
@@ -48,7 +48,9 @@ protected:
 	std::shared_ptr<HttpClient> FindClient(const std::shared_ptr<ov::Socket> &remote);
 
 	std::shared_ptr<HttpClient> ProcessConnect(const std::shared_ptr<ov::Socket> &remote);
-	void ProcessData(const std::shared_ptr<HttpClient> &client, const std::shared_ptr<const ov::Data> &data);
+	void ProcessData(const std::shared_ptr<HttpClient> &http_client, const std::shared_ptr<const ov::Data> &data);
+	// Replaces the request of the client with a new one, to receive the next request of the persistent connection
+	std::shared_ptr<HttpClient> RenewClient(const std::shared_ptr<HttpClient> &client);
 
 	//--------------------------------------------------------------------
 	// Implementation of PhysicalPortObserver
@@ -9,6 +9,8 @@
 #include "https_server.h"
 #include "http_private.h"
 
+#include <monitoring/monitoring.h>
+
 // Reference: https://wiki.mozilla.org/Security/Server_Side_TLS
 
 // Modern compatibility
@@ -20,7 +22,125 @@
 
 void HttpsServer::SetVirtualHostList(std::vector<std::shared_ptr<Orchestrator::VirtualHost>>& vhost_list)
 {
-	_virtual_host_list = vhost_list;
+	auto tls_host_list = std::make_shared<TlsHostList>();
+
+	for (auto &vhost_info : vhost_list)
+	{
+		auto &host_info = vhost_info->host_info;
+
+		if (host_info.GetCertificate() == nullptr)
+		{
+			continue;
+		}
+
+		auto tls_host = std::make_shared<TlsHost>(host_info);
+
+		// The context is created once per certificate and shared by all the clients
+		tls_host->tls_context = ov::TlsContext::CreateServerContext(
+			TLS_server_method(),
+			host_info.GetCertificate(), host_info.GetChainCertificate(),
+			HTTP_INTERMEDIATE_COMPATIBILITY);
+
+		if (tls_host->tls_context == nullptr)
+		{
+			logte("Could not create TLS context for %s", host_info.GetName().CStr());
+			continue;
+		}
+
+		for (auto &domain : vhost_info->domain_list)
+		{
+			if (domain.IsValid())
+			{
+				tls_host->domain_regex_list.push_back(domain.regex_for_domain);
+			}
+		}
+
+		tls_host_list->push_back(tls_host);
+	}
+
+	if (tls_host_list->empty() == false)
+	{
+		// Select a certificate using SNI (Only the default context receives the ClientHello)
+		std::weak_ptr<const TlsHostList> weak_tls_host_list = tls_host_list;
+
+		tls_host_list->front()->tls_context->SetServerNameResolver([weak_tls_host_list](const ov::String &server_name) -> std::shared_ptr<ov::TlsContext> {
+			auto tls_host_list = weak_tls_host_list.lock();
+
+			if (tls_host_list != nullptr)
+			{
+				for (auto &tls_host : *tls_host_list)
+				{
+					for (auto &domain_regex : tls_host->domain_regex_list)
+					{
+						if (std::regex_match(server_name.CStr(), domain_regex))
+						{
+							return tls_host->tls_context;
+						}
+					}
+				}
+			}
+
+			return nullptr;
+		});
+	}
+
+	std::atomic_store(&_tls_host_list, std::shared_ptr<const TlsHostList>(tls_host_list));
+}
+
+void HttpsServer::SetKernelTlsEnabled(bool enabled)
+{
+	if (enabled && (ov::Tls::IsKernelTlsSupported() == false))
+	{
+		logtw("kTLS is not supported by OpenSSL (OpenSSL must be built with enable-ktls), TLS records will be encrypted by OpenSSL");
+		enabled = false;
+	}
+
+	_is_kernel_tls_enabled = enabled;
+}
+
+std::shared_ptr<const HttpsServer::TlsHostList> HttpsServer::GetTlsHostList() const
+{
+	return std::atomic_load(&_tls_host_list);
+}
+
+std::shared_ptr<HttpsServer::TlsHost> HttpsServer::FindTlsHost(const std::shared_ptr<ov::TlsContext> &tls_context) const
+{
+	auto tls_host_list = GetTlsHostList();
+
+	for (auto &tls_host : *tls_host_list)
+	{
+		if (tls_host->tls_context == tls_context)
+		{
+			return tls_host;
+		}
+	}
+
+	return nullptr;
+}
+
+void HttpsServer::UpdateTlsMetrics(const std::shared_ptr<ov::TlsData> &tls_data, bool is_succeeded)
+{
+	auto tls_host = FindTlsHost(tls_data->GetTlsContext());
+
+	if (tls_host == nullptr)
+	{
+		// The list was changed while the handshake was in progress
+		return;
+	}
+
+	auto host_metrics = HostMetrics(tls_host->host_info);
+
+	if (host_metrics != nullptr)
+	{
+		if (is_succeeded)
+		{
+			host_metrics->OnTlsHandshakeCompleted(tls_data->IsSessionReused());
+		}
+		else
+		{
+			host_metrics->OnTlsHandshakeFailed();
+		}
+	}
 }
 
 void HttpsServer::OnConnected(const std::shared_ptr<ov::Socket> &remote)
@@ -29,23 +149,22 @@ void HttpsServer::OnConnected(const std::shared_ptr<ov::Socket> &remote)
 
 	if (client != nullptr)
 	{
-		// TODO(Dimiden): OME doesn't support SNI yet, so we will use the first certificate for all requests until SNI development is complete.
-		// When SNI works, you need to put a certificate by domain to TlsData
-		if(_virtual_host_list.size() == 0)
+		auto tls_host_list = GetTlsHostList();
+
+		if (tls_host_list->empty())
 		{
 			return;
 		}
 
-		auto vhost_info = _virtual_host_list[0];
-		if(vhost_info->host_info.GetCertificate() == nullptr)
+		int kernel_tls_socket = -1;
+
+		if (_is_kernel_tls_enabled && (remote->GetType() == ov::SocketType::Tcp))
 		{
-			return;
+			kernel_tls_socket = remote->GetSocket().GetSocket();
 		}
 
-		auto tls_data = std::make_shared<ov::TlsData>(
-			ov::TlsData::Method::TlsServerMethod,
-			vhost_info->host_info.GetCertificate(), vhost_info->host_info.GetChainCertificate(),
-			HTTP_INTERMEDIATE_COMPATIBILITY);
+		// Starts with the default context, and then it can be changed by SNI while accepting
+		auto tls_data = std::make_shared<ov::TlsData>(tls_host_list->front()->tls_context, kernel_tls_socket);
 
 		tls_data->SetWriteCallback([remote](const void *data, size_t length) -> ssize_t {
 			return remote->Send(data, length);
@@ -72,9 +191,15 @@ void HttpsServer::OnDataReceived(const std::shared_ptr<ov::Socket> &remote, cons
 	if (tls_data != nullptr)
 	{
 		std::shared_ptr<const ov::Data> plain_data;
+		bool is_accepting = (tls_data->GetState() == ov::TlsData::State::WaitingForAccept);
 
 		if (tls_data->Decrypt(data, &plain_data))
 		{
+			if (is_accepting && (tls_data->GetState() == ov::TlsData::State::Accepted))
+			{
+				UpdateTlsMetrics(tls_data, true);
+			}
+
 			if ((plain_data != nullptr) && (plain_data->GetLength() > 0))
 			{
 				// plain_data is HTTP data
@@ -90,6 +215,11 @@ void HttpsServer::OnDataReceived(const std::shared_ptr<ov::Socket> &remote, cons
 			return;
 		}
 
+		if (is_accepting)
+		{
+			UpdateTlsMetrics(tls_data, false);
+		}
+
 		// Error
 		logtd("Could not decrypt data");
 	}
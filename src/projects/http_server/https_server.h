@@ -15,8 +15,12 @@
 class HttpsServer : public HttpServer
 {
 public:
+	// Creates a TLS context for each certificate (the first one is used when the client doesn't send SNI)
 	void SetVirtualHostList(std::vector<std::shared_ptr<Orchestrator::VirtualHost>>& vhost_list);
 
+	// Encrypt the responses in the kernel (kTLS) if possible, to avoid encrypting/copying the segments in user space
+	void SetKernelTlsEnabled(bool enabled);
+
 protected:
 	//--------------------------------------------------------------------
 	// Implementation of PhysicalPortObserver
@@ -25,5 +29,31 @@ protected:
 	void OnDataReceived(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddress &address, const std::shared_ptr<const ov::Data> &data) override;
 
 protected:
-	std::vector<std::shared_ptr<Orchestrator::VirtualHost>> 	_virtual_host_list;
+	struct TlsHost
+	{
+		TlsHost(const info::Host &host_info)
+			: host_info(host_info)
+		{
+		}
+
+		info::Host host_info;
+		// Copied from Orchestrator::VirtualHost::domain_list, because it can be changed by Orchestrator
+		std::vector<std::regex> domain_regex_list;
+		std::shared_ptr<ov::TlsContext> tls_context;
+	};
+
+	using TlsHostList = std::vector<std::shared_ptr<TlsHost>>;
+
+	std::shared_ptr<const TlsHostList> GetTlsHostList() const;
+
+	// Finds the host that uses the context to update the metrics
+	std::shared_ptr<TlsHost> FindTlsHost(const std::shared_ptr<ov::TlsContext> &tls_context) const;
+
+	void UpdateTlsMetrics(const std::shared_ptr<ov::TlsData> &tls_data, bool is_succeeded);
+
+protected:
+	// Replaced as a whole when the list is changed, so the clients can read it without locking
+	std::shared_ptr<const TlsHostList> _tls_host_list = std::make_shared<TlsHostList>();
+
+	bool _is_kernel_tls_enabled = false;
 };
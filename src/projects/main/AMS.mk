@@ -7,8 +7,8 @@ LOCAL_STATIC_LIBRARIES := \
 	ovt_publisher \
 	ovt_provider \
 	rtmp_provider \
-	rtsp_provider \
 	rtspc_provider \
+	rtsp_provider \
 	transcoder \
 	rtc_signalling \
 	ice \
@@ -18,9 +18,9 @@ LOCAL_STATIC_LIBRARIES := \
 	dtls_srtp \
 	rtp_rtcp \
 	sdp \
-	h264 \
 	web_console \
 	mediarouter \
+	h264 \
 	ovt_packetizer \
 	orchestrator \
 	publisher \
@@ -16,6 +16,7 @@
 
 #include <base/ovlibrary/daemon.h>
 #include <base/ovlibrary/log_write.h>
+#include <base/publisher/stream_worker_pool.h>
 #include <config/config_manager.h>
 
 #include <media_router/media_router.h>
@@ -116,6 +117,16 @@ int main(int argc, char *argv[])
 	}
 
 	orchestrator->ApplyOriginMap(host_info_list);
+
+	// Start the worker pool of the publisher streams before the streams are created (otherwise it starts with the defaults)
+	auto &stream_workers_config = server_config->GetStreamWorkers();
+
+	if (pub::StreamWorkerPool::Instance()->Start(stream_workers_config.GetCoreCount(), stream_workers_config.IsWorkStealingEnabled()) == false)
+	{
+		logte("Could not start the stream worker pool");
+		return 1;
+	}
+
 	// Create an HTTP Manager for Segment Publishers
 	std::map<int, std::shared_ptr<HttpServer>> http_server_manager;
 
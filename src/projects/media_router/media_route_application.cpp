@@ -56,7 +56,7 @@ bool MediaRouteApplication::Start()
 bool MediaRouteApplication::Stop()
 {
 	_kill_flag = true;
-	_indicator.abort();
+	_indicator.Stop();
 	if(_thread.joinable())
 	{
 		_thread.join();
@@ -120,6 +120,8 @@ bool MediaRouteApplication::RegisterObserverApp(
 
 	logtd("Register observer. app(%s/%p) type(%d)", _application_info.GetName().CStr(), app_obsrv.get(), app_obsrv->GetObserverType());
 
+	app_obsrv->SetMediaRouterApplication(GetSharedPtr());
+
 	std::unique_lock<std::mutex> lock(_mutex);
 	_observers.push_back(app_obsrv);
 	lock.unlock();
@@ -190,6 +192,7 @@ bool MediaRouteApplication::OnCreateStream(
 		std::lock_guard<std::mutex> lock_guard(_mutex);
 
 		new_stream->SetConnectorType(app_conn->GetConnectorType());
+		new_stream->SetConnector(app_conn);
 
 		_streams.insert(std::make_pair(new_stream_info->GetId(), new_stream));
 	}
@@ -329,14 +332,63 @@ bool MediaRouteApplication::OnReceiveBuffer(
 	// MainTask에 전달한다. 패킷이 수신되어 처리(재분배)되는 속도가 0.001초 이하의 초저지연으로 동작하나, 효율적인 구조는
 	// 아닌것으로 판단되므로, 향후에 개선이 필요하다
 	bool ret = stream->Push(std::move(packet));
-	if(ret == true)
+	if ((ret == true) && stream->MarkIndicated())
 	{
-		_indicator.push(std::make_shared<BufferIndicator>(stream_info->GetId()));
+		if (_indicator.Enqueue(std::make_shared<BufferIndicator>(stream_info->GetId())) == false)
+		{
+			// The packets will be delivered with the next indicator of the stream
+			stream->UnmarkIndicated();
+
+			if (_indicator.IsStopped() == false)
+			{
+				logtw("Indicator queue is full. application(%s), stream(%s)", _application_info.GetName().CStr(), stream_info->GetName().CStr());
+			}
+		}
 	}
 	
 	return ret;
 }
 
+// 옵저버(Publisher)에서 키프레임을 요청함
+// @from pub::Stream (PLI/FIR of WebRTC)
+// @from TranscodeApplication (bypassed track)
+bool MediaRouteApplication::OnRequestKeyFrame(
+	const std::shared_ptr<MediaRouteApplicationObserver> &app_obsrv,
+	const std::shared_ptr<info::Stream> &stream_info)
+{
+	if (app_obsrv == nullptr || stream_info == nullptr)
+	{
+		return false;
+	}
+
+	std::shared_ptr<MediaRouteApplicationConnector> connector;
+
+	{
+		std::lock_guard<decltype(_mutex)> lock_guard(_mutex);
+
+		auto stream_bucket = _streams.find(stream_info->GetId());
+		if (stream_bucket == _streams.end())
+		{
+			logtd("cannot find stream from router. appication(%s), stream(%s)", _application_info.GetName().CStr(), stream_info->GetName().CStr());
+			return false;
+		}
+
+		connector = stream_bucket->second->GetConnector();
+	}
+
+	if (connector == nullptr)
+	{
+		return false;
+	}
+
+	logtd("Key frame is requested. app(%s) stream(%s/%u) observer type(%d) connector type(%d)",
+		  _application_info.GetName().CStr(), stream_info->GetName().CStr(), stream_info->GetId(),
+		  app_obsrv->GetObserverType(), connector->GetConnectorType());
+
+	// The connector is called without the lock, because it may request a key frame of its source stream again
+	return connector->OnRequestKeyFrame(stream_info);
+}
+
 void MediaRouteApplication::OnGarbageCollector()
 {
 	// _indicator.push(std::make_shared<BufferIndicator>(BUFFFER_INDICATOR_UNIQUEID_GC));
@@ -395,13 +447,15 @@ void MediaRouteApplication::MainTask()
 {
 	while (!_kill_flag)
 	{
-		auto indicator = _indicator.pop_unique();
-		if (indicator == nullptr)
+		auto item = _indicator.Dequeue();
+		if (item.has_value() == false)
 		{
-			logte("invalid indicator");
+			// Stopped
 			continue;
 		}
 
+		auto indicator = std::move(item.value());
+
 		// GC 수행
 		if (indicator->_stream_id == BUFFFER_INDICATOR_UNIQUEID_GC)
 		{
@@ -425,6 +479,9 @@ void MediaRouteApplication::MainTask()
 			continue;
 		}
 
+		// Must be unmarked before popping, so that the packets pushed from now on make a new indicator
+		stream->UnmarkIndicated();
+
 		while(auto media_packet = stream->Pop())
 		{
 			MediaRouteApplicationConnector::ConnectorType connector_type = stream->GetConnectorType();
@@ -17,12 +17,14 @@
 #include "base/media_route/media_route_application_connector.h"
 #include "base/media_route/media_route_interface.h"
 #include "base/media_route/media_route_application_interface.h"
-#include "base/media_route/media_queue.h"
 
 #include "media_route_stream.h"
 
 #include <config/items/items.h>
 
+// Maximum number of streams that can be waiting for the main task at once
+#define MEDIA_ROUTE_INDICATOR_QUEUE_SIZE 4096
+
 class ApplicationInfo;
 class Stream;
 
@@ -91,6 +93,11 @@ public:
 	bool UnregisterObserverApp(
 		std::shared_ptr<MediaRouteApplicationObserver> observer);
 
+	// 키프레임 요청
+	bool OnRequestKeyFrame(
+		const std::shared_ptr<MediaRouteApplicationObserver> &app_obsrv,
+		const std::shared_ptr<info::Stream> &stream) override;
+
 
 public:
 	// Application information from configuration file
@@ -143,7 +150,8 @@ public:
 
 protected:
 	// 버퍼를 처리할 인디게이터
-	MediaQueue<std::shared_ptr<BufferIndicator>> _indicator;
+	// Each stream has at most one indicator in the queue (See MediaRouteStream::MarkIndicated())
+	ov::MpscQueue<std::shared_ptr<BufferIndicator>> _indicator{MEDIA_ROUTE_INDICATOR_QUEUE_SIZE};
 
 	//std::shared_ptr<RelayServer>    _relay_server;
 	//std::shared_ptr<RelayClient>    _relay_client;
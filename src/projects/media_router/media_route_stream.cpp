@@ -48,9 +48,22 @@ MediaRouteApplicationConnector::ConnectorType MediaRouteStream::GetConnectorType
 	return _application_connector_type;
 }
 
+void MediaRouteStream::SetConnector(const std::shared_ptr<MediaRouteApplicationConnector> &connector)
+{
+	_application_connector = connector;
+}
+
+std::shared_ptr<MediaRouteApplicationConnector> MediaRouteStream::GetConnector()
+{
+	return _application_connector.lock();
+}
+
 // 비트스트림 컨버팅 기능을.. 어디에 넣는게 좋을까? Push? Pop?
 bool MediaRouteStream::Push(std::shared_ptr<MediaPacket> media_packet)
 {	
+	// Push() can be called by several transcoder threads while Pop() is called by the router thread
+	std::lock_guard<std::mutex> lock_guard(_media_packets_guard);
+
 	auto track_id = media_packet->GetTrackId();
 
 	// Accumulate Packet duplication
@@ -92,6 +105,8 @@ bool MediaRouteStream::Push(std::shared_ptr<MediaPacket> media_packet)
 
 std::shared_ptr<MediaPacket> MediaRouteStream::Pop()
 {
+	std::unique_lock<std::mutex> lock(_media_packets_guard);
+
 	if(_media_packets.empty())
 	{
 		return nullptr;
@@ -100,6 +115,8 @@ std::shared_ptr<MediaPacket> MediaRouteStream::Pop()
 	auto media_packet = std::move(_media_packets.front());
 	_media_packets.pop();
 
+	lock.unlock();
+
 	auto media_type = media_packet->GetMediaType();
 
 	auto track_id = media_packet->GetTrackId();
@@ -290,7 +307,19 @@ std::shared_ptr<MediaPacket> MediaRouteStream::Pop()
 
 uint32_t MediaRouteStream::Size()
 {
+	std::lock_guard<std::mutex> lock_guard(_media_packets_guard);
+
 	return _media_packets.size();
 }
 
+bool MediaRouteStream::MarkIndicated()
+{
+	return (_is_indicated.exchange(true) == false);
+}
+
+void MediaRouteStream::UnmarkIndicated()
+{
+	_is_indicated = false;
+}
+
 
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <queue>
@@ -34,21 +35,36 @@ public:
 	std::shared_ptr<info::Stream> GetStream();
 	void SetConnectorType(MediaRouteApplicationConnector::ConnectorType type);
 	MediaRouteApplicationConnector::ConnectorType GetConnectorType();
+	// The connector that creates this stream
+	void SetConnector(const std::shared_ptr<MediaRouteApplicationConnector> &connector);
+	std::shared_ptr<MediaRouteApplicationConnector> GetConnector();
 
 	// Queue interfaces
 	bool Push(std::shared_ptr<MediaPacket> media_packet);
 	std::shared_ptr<MediaPacket> Pop();
 	uint32_t Size();
 
+	// Marks that an indicator of this stream is queued in MediaRouteApplication,
+	// so that one indicator wakes the main task up for all the packets pushed until it is handled
+	//
+	// @return false if the stream is already marked
+	bool MarkIndicated();
+	// Called by the main task before popping the packets
+	void UnmarkIndicated();
+
 private:
 	std::shared_ptr<info::Stream> _stream;
 	MediaRouteApplicationConnector::ConnectorType _application_connector_type;
+	std::weak_ptr<MediaRouteApplicationConnector> _application_connector;
 
 	std::map<uint8_t, std::shared_ptr<MediaPacket>> _media_packet_stored;
 
 	// 2019/11/22 Getroot
 	// Change shared_ptr to shared_ptr
 	std::queue<std::shared_ptr<MediaPacket>> _media_packets;
+	std::mutex _media_packets_guard;
+
+	std::atomic<bool> _is_indicated{false};
 
 	////////////////////////////
 	// bitstream filters
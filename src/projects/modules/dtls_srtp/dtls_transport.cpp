@@ -290,17 +290,21 @@ bool DtlsTransport::OnDataReceived(pub::SessionNodeType from_node, const std::sh
 				// 	break;
 				// }
 
-				// pass to srtp
-				// TODO(getroot): 나중에 RTCP 구현 할 것
-				// auto node = GetUpperNode();
+				// The SRTP keys are not ready until the handshake is completed
+				if(_state != SSL_CONNECTED)
+				{
+					return false;
+				}
 
-                // if(node == nullptr)
-                // {
-                //     return false;
-                // }
-                // node->OnDataReceived(GetNodeType(), data);
+				// pass to srtp (RTCP feedback: RR, NACK, ...)
+				auto node = GetUpperNode();
 
-				return true;
+				if(node == nullptr)
+				{
+					return false;
+				}
+
+				return node->OnDataReceived(GetNodeType(), data);
 			}
 			break;
 		case SSL_ERROR:
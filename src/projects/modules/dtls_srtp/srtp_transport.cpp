@@ -75,25 +75,36 @@ bool SrtpTransport::OnDataReceived(pub::SessionNodeType from_node, const std::sh
 		return false;
 	}
 
-	// TODO(getroot): _recv_session가 생성되기 전에 호출되는 경우가 있음. 확인 필요
-	// auto decode_data = data->Clone();
+	// The packets can be received before the keys are negotiated
+	if(_recv_session == nullptr)
+	{
+		return false;
+	}
+
+	// This server doesn't receive RTP, so only RTCP is expected (RFC 5761: PT of RTCP is 192~223)
+	if((data->GetLength() < 2) || (data->GetDataAs<uint8_t>()[1] < 192) || (data->GetDataAs<uint8_t>()[1] > 223))
+	{
+		return false;
+	}
 
-    // if(!_recv_session->UnprotectRtcp(decode_data))
-    // {
-    //     logtd("stcp unprotected fail");
-    //     return false;
-    // }
+	// Unprotect in place
+	auto decode_data = data->Clone();
 
-	// // pass to rtcp
-    // auto node = GetUpperNode();
+	if(!_recv_session->UnprotectRtcp(decode_data))
+	{
+		logtd("srtcp unprotected fail");
+		return false;
+	}
 
-    // if(node == nullptr)
-    // {
-    //     return false;
-    // }
-    // node->OnDataReceived(GetNodeType(), decode_data);
+	// pass to rtcp
+	auto node = GetUpperNode();
 
-	return true;
+	if(node == nullptr)
+	{
+		return false;
+	}
+
+	return node->OnDataReceived(GetNodeType(), decode_data);
 }
 
 // SRTP 를 초기화 한다.
@@ -1,35 +1,13 @@
 #include "h264_nal_unit_bitstream_parser.h"
 
+#include "h264_nal_unit_scanner.h"
+
 H264NalUnitBitstreamParser::H264NalUnitBitstreamParser(const uint8_t *bitstream, size_t length)
 {
-    /*
-        Parse the bitstream and skip emulation_prevention_three_byte instances along the way
-
-        7.3.1 NAL unit syntax
+    // Parse the bitstream and skip emulation_prevention_three_byte instances along the way
+    bitstream_.resize(length);
+    bitstream_.resize(H264NalUnitScanner::RemoveEmulationPrevention(bitstream, length, bitstream_.data()));
 
-        for( i = nalUnitHeaderBytes; i < NumBytesInNALunit; i++ ) {
-            if( i + 2 < NumBytesInNALunit && next_bits( 24 ) = = 0x000003 ) {
-                rbsp_byte[ NumBytesInRBSP++ ] All b(8)
-                rbsp_byte[ NumBytesInRBSP++ ] All b(8)
-                i += 2
-                emulation_prevention_three_byte // equal to 0x03 All f(8)
-            } else
-                rbsp_byte[ NumBytesInRBSP++ ] All b(8)
-        }
-    */
-    for (size_t original_bitstream_offset = 0; original_bitstream_offset < length;)
-    {
-        if (original_bitstream_offset < length + 2 && bitstream[original_bitstream_offset] == 0x00 && bitstream[original_bitstream_offset + 1] == 0x00 && bitstream[original_bitstream_offset + 2] == 0x03)
-        {
-            bitstream_.emplace_back(bitstream[original_bitstream_offset++]);
-            bitstream_.emplace_back(bitstream[original_bitstream_offset++]);
-            original_bitstream_offset++;
-        }
-        else
-        {
-            bitstream_.emplace_back(bitstream[original_bitstream_offset++]);
-        }
-    }
     total_bits_ = bitstream_.size() * 8;
 }
 
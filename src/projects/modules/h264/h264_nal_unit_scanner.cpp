@@ -0,0 +1,186 @@
+#include "h264_nal_unit_scanner.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // Returns the offset of the first "00 00 [last_byte]", or length if there is none
+    using FindPatternFunction = size_t (*)(const uint8_t *bitstream, size_t length, uint8_t last_byte);
+
+    size_t FindPatternScalar(const uint8_t *bitstream, size_t length, uint8_t last_byte)
+    {
+        for (size_t offset = 0; offset + 2 < length; offset++)
+        {
+            // If bitstream[offset + 2] is neither 00 nor last_byte, the pattern cannot start at offset ~ offset + 2
+            if (bitstream[offset + 2] != 0x00 && bitstream[offset + 2] != last_byte)
+            {
+                offset += 2;
+                continue;
+            }
+
+            if (bitstream[offset] == 0x00 && bitstream[offset + 1] == 0x00 && bitstream[offset + 2] == last_byte)
+            {
+                return offset;
+            }
+        }
+
+        return length;
+    }
+
+#if defined(__x86_64__)
+    // SSE2 is a part of x86-64, so it is always available
+    size_t FindPatternSse2(const uint8_t *bitstream, size_t length, uint8_t last_byte)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i last = _mm_set1_epi8(static_cast<char>(last_byte));
+        size_t offset = 0;
+
+        // Compares 16 positions at once: bitstream[i] == 0 && bitstream[i + 1] == 0 && bitstream[i + 2] == last_byte
+        for (; offset + 16 + 2 <= length; offset += 16)
+        {
+            auto first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bitstream + offset));
+            auto second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bitstream + offset + 1));
+            auto third = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bitstream + offset + 2));
+
+            auto matched = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(first, zero), _mm_cmpeq_epi8(second, zero)), _mm_cmpeq_epi8(third, last));
+            auto mask = static_cast<uint32_t>(_mm_movemask_epi8(matched));
+
+            if (mask != 0)
+            {
+                return offset + __builtin_ctz(mask);
+            }
+        }
+
+        return offset + FindPatternScalar(bitstream + offset, length - offset, last_byte);
+    }
+
+    __attribute__((target("avx2"))) size_t FindPatternAvx2(const uint8_t *bitstream, size_t length, uint8_t last_byte)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i last = _mm256_set1_epi8(static_cast<char>(last_byte));
+        size_t offset = 0;
+
+        for (; offset + 32 + 2 <= length; offset += 32)
+        {
+            auto first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bitstream + offset));
+            auto second = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bitstream + offset + 1));
+            auto third = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bitstream + offset + 2));
+
+            auto matched = _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(first, zero), _mm256_cmpeq_epi8(second, zero)), _mm256_cmpeq_epi8(third, last));
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(matched));
+
+            if (mask != 0)
+            {
+                return offset + __builtin_ctz(mask);
+            }
+        }
+
+        // The rest (less than 34 bytes) is scanned with SSE2
+        return offset + FindPatternSse2(bitstream + offset, length - offset, last_byte);
+    }
+#endif
+
+    FindPatternFunction GetFindPatternFunction()
+    {
+#if defined(__x86_64__)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return FindPatternAvx2;
+        }
+
+        return FindPatternSse2;
+#else
+        return FindPatternScalar;
+#endif
+    }
+
+    size_t FindPattern(const uint8_t *bitstream, size_t length, uint8_t last_byte)
+    {
+        static const FindPatternFunction find_pattern = GetFindPatternFunction();
+
+        return find_pattern(bitstream, length, last_byte);
+    }
+}  // namespace
+
+size_t H264NalUnitScanner::FindStartCode(const uint8_t *bitstream, size_t length)
+{
+    return FindPattern(bitstream, length, 0x01);
+}
+
+size_t H264NalUnitScanner::MakeNalUnitIndex(const uint8_t *bitstream, size_t length, FragmentationHeader *header)
+{
+    size_t count = 0;
+    size_t start_code_offset = FindStartCode(bitstream, length);
+    // Offset of the NAL unit that is found last
+    size_t nal_unit_offset = 0;
+
+    while (start_code_offset < length)
+    {
+        size_t next_nal_unit_offset = start_code_offset + 3;
+
+        if (count > 0)
+        {
+            // 00 00 00 01
+            size_t nal_unit_end = ((start_code_offset > nal_unit_offset) && (bitstream[start_code_offset - 1] == 0x00)) ? (start_code_offset - 1) : start_code_offset;
+
+            header->fragmentation_offset.emplace_back(nal_unit_offset);
+            header->fragmentation_length.emplace_back(nal_unit_end - nal_unit_offset);
+        }
+
+        nal_unit_offset = next_nal_unit_offset;
+        count++;
+
+        start_code_offset = next_nal_unit_offset + FindStartCode(bitstream + next_nal_unit_offset, length - next_nal_unit_offset);
+    }
+
+    if (count > 0)
+    {
+        header->fragmentation_offset.emplace_back(nal_unit_offset);
+        header->fragmentation_length.emplace_back(length - nal_unit_offset);
+    }
+
+    return count;
+}
+
+size_t H264NalUnitScanner::RemoveEmulationPrevention(const uint8_t *nal_unit, size_t length, uint8_t *rbsp)
+{
+    /*
+        7.3.1 NAL unit syntax
+
+        for( i = nalUnitHeaderBytes; i < NumBytesInNALunit; i++ ) {
+            if( i + 2 < NumBytesInNALunit && next_bits( 24 ) = = 0x000003 ) {
+                rbsp_byte[ NumBytesInRBSP++ ] All b(8)
+                rbsp_byte[ NumBytesInRBSP++ ] All b(8)
+                i += 2
+                emulation_prevention_three_byte // equal to 0x03 All f(8)
+            } else
+                rbsp_byte[ NumBytesInRBSP++ ] All b(8)
+        }
+
+        00 00 03 cannot overlap with itself, so the bytes between the patterns are copied as is
+    */
+    size_t read_offset = 0;
+    size_t write_offset = 0;
+
+    while (read_offset < length)
+    {
+        size_t pattern_offset = read_offset + FindPattern(nal_unit + read_offset, length - read_offset, 0x03);
+        // Includes 00 00 of the pattern
+        size_t copy_end = std::min(pattern_offset + 2, length);
+
+        // memmove() for the in-place removal
+        ::memmove(rbsp + write_offset, nal_unit + read_offset, copy_end - read_offset);
+        write_offset += copy_end - read_offset;
+
+        read_offset = copy_end + 1;
+    }
+
+    return write_offset;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <base/common_types.h>
+
+#include <cstdint>
+
+/*
+    Scans Annex-B bitstreams for the start codes (00 00 01) and the emulation prevention bytes (00 00 03)
+
+    The scan is the hot loop of every H.264 path (a 1080p key frame is hundreds of kilobytes), so the patterns are
+    searched 16/32 bytes at a time with SSE2/AVX2. The kernel is selected once by the CPU features at runtime,
+    and the byte-by-byte loop is used on the other architectures.
+*/
+class H264NalUnitScanner
+{
+public:
+    // Returns the offset of the first start code (00 00 01) in the bitstream, or length if there is none
+    static size_t FindStartCode(const uint8_t *bitstream, size_t length);
+
+    /*
+        Appends the offset/length of each NAL unit (without the start code) of the Annex-B bitstream to the header
+
+        00 00 00 01 (4 bytes start code) is not counted in the previous NAL unit, and the bytes before the first
+        start code are ignored. Returns the number of NAL units found
+    */
+    static size_t MakeNalUnitIndex(const uint8_t *bitstream, size_t length, FragmentationHeader *header);
+
+    /*
+        Copies the NAL unit to rbsp without emulation_prevention_three_byte (00 00 03 => 00 00)
+
+        rbsp must have room for length bytes, and may be the same as nal_unit (in-place).
+        Returns the length of rbsp
+    */
+    static size_t RemoveEmulationPrevention(const uint8_t *nal_unit, size_t length, uint8_t *rbsp);
+};
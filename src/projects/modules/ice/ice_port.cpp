@@ -13,11 +13,15 @@
 #include "modules/ice/stun/stun_message.h"
 
 #include <algorithm>
+#include <chrono>
 
 #include <base/ovlibrary/ovlibrary.h>
 #include <config/config.h>
 #include <modules/rtc_signalling/rtc_ice_candidate.h>
 
+// Measure the lookup time of one in every N media packets
+#define ICE_PORT_LOOKUP_SAMPLING_INTERVAL (64)
+
 IcePort::IcePort()
 {
 	_timer.Push(
@@ -36,7 +40,7 @@ IcePort::~IcePort()
 	Close();
 }
 
-bool IcePort::Create(std::vector<RtcIceCandidate> ice_candidate_list)
+bool IcePort::Create(std::vector<RtcIceCandidate> ice_candidate_list, int worker_count)
 {
 	std::lock_guard<std::recursive_mutex> lock_guard(_physical_port_list_mutex);
 
@@ -77,7 +81,7 @@ bool IcePort::Create(std::vector<RtcIceCandidate> ice_candidate_list)
 		address.SetHostname(nullptr);
 
 		// Create an ICE port using candidate information
-		auto physical_port = CreatePhysicalPort(address, socket_type);
+		auto physical_port = CreatePhysicalPort(address, socket_type, worker_count);
 
 		if (physical_port == nullptr)
 		{
@@ -107,9 +111,9 @@ const std::vector<RtcIceCandidate> &IcePort::GetIceCandidateList() const
 	return _ice_candidate_list;
 }
 
-std::shared_ptr<PhysicalPort> IcePort::CreatePhysicalPort(const ov::SocketAddress &address, ov::SocketType type)
+std::shared_ptr<PhysicalPort> IcePort::CreatePhysicalPort(const ov::SocketAddress &address, ov::SocketType type, int worker_count)
 {
-	auto physical_port = PhysicalPortManager::Instance()->CreatePort(type, address);
+	auto physical_port = PhysicalPortManager::Instance()->CreatePort(type, address, worker_count);
 
 	if (physical_port != nullptr)
 	{
@@ -270,7 +274,7 @@ bool IcePort::RemoveSession(const session_id_t session_id)
 		ice_port_info = item->second;
 
 		_session_table.erase(item);
-		_ice_port_info.erase(ice_port_info->address);
+		_ice_port_info_table.Erase(ice_port_info->tuple, ice_port_info);
 	}
 
 	{
@@ -318,6 +322,12 @@ bool IcePort::Send(const std::shared_ptr<info::Session> &session_info, const std
 	}
 
 	// logtd("Sending data to remote for session #%d", session_info->GetId());
+	if (ice_port_info->remote->GetType() == ov::SocketType::Udp)
+	{
+		// If the caller is in a DatagramSendBatch (e.g. StreamWorker), the packets of all sessions are sent together with sendmmsg()
+		return ov::DatagramSendBatch::SendTo(std::static_pointer_cast<ov::DatagramSocket>(ice_port_info->remote), ice_port_info->address, data) >= 0;
+	}
+
 	return ice_port_info->remote->SendTo(ice_port_info->address, data) >= 0;
 }
 
@@ -333,85 +343,132 @@ void IcePort::OnDataReceived(const std::shared_ptr<ov::Socket> &remote, const ov
 	// TODO: 지금은 data 안에 하나의 STUN 메시지만 있을 것으로 간주하고 작성되어 있음
 	// TODO: TCP의 경우, 데이터가 많이 들어올 수 있기 때문에 별도 처리 필요
 
+	if (data->GetLength() == 0)
+	{
+		return;
+	}
+
+	// Demultiplex the packet using the first byte (RFC 7983), instead of trying to parse every packet as STUN
+	//
+	//              +----------------+
+	//              |        [0..3] -+--> forward to STUN
+	//              |                |
+	//              |      [16..19] -+--> forward to ZRTP
+	//              |                |
+	//  packet -->  |      [20..63] -+--> forward to DTLS
+	//              |                |
+	//              |      [64..79] -+--> forward to TURN Channel
+	//              |                |
+	//              |    [128..191] -+--> forward to RTP/RTCP
+	//              +----------------+
+	auto first_byte = data->GetDataAs<uint8_t>()[0];
+
+	if (first_byte <= 3)
+	{
+		OnStunPacketReceived(remote, address, data);
+	}
+	else if (((first_byte >= 20) && (first_byte <= 63)) || ((first_byte >= 128) && (first_byte <= 191)))
+	{
+		OnMediaPacketReceived(remote, address, data);
+	}
+	else
+	{
+		// ZRTP, TURN Channel or unknown
+		logtd("Unsupported packet (first byte: %d) is received from %s. Dropping...", first_byte, address.ToString().CStr());
+	}
+}
+
+void IcePort::OnStunPacketReceived(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddress &address, const std::shared_ptr<const ov::Data> &data)
+{
 	ov::ByteStream stream(data.get());
 	StunMessage message;
 
-	if (message.Parse(stream))
+	if (message.Parse(stream) == false)
 	{
-		// STUN 패킷이 맞음
-		logtd("Received message:\n%s", message.ToString().CStr());
+		logtd("Invalid STUN packet is received from %s. Dropping...", address.ToString().CStr());
+		return;
+	}
 
-		if (message.GetMethod() == StunMethod::Binding)
-		{
-			switch (message.GetClass())
-			{
-				case StunClass::Request:
-					if (ProcessBindingRequest(remote, address, message) == false)
-					{
-						ResponseError(remote);
-					}
-					break;
-
-				case StunClass::SuccessResponse:
-					if (ProcessBindingResponse(remote, address, message) == false)
-					{
-						ResponseError(remote);
-					}
-					break;
-
-				case StunClass::ErrorResponse:
-					// TODO: 구현 예정
-					logtw("Error Response received");
-					break;
-
-				case StunClass::Indication:
-					// indication은 언제/어떻게 사용하는지 spec을 더 봐야함
-					logtw("Indication - not implemented");
-					break;
-			}
-		}
-		else
+	// STUN 패킷이 맞음
+	logtd("Received message:\n%s", message.ToString().CStr());
+
+	if (message.GetMethod() == StunMethod::Binding)
+	{
+		switch (message.GetClass())
 		{
-			// binding 이외의 method는 구현되어 있지 않음
-			OV_ASSERT(false, "Not implemented method: %d", message.GetMethod());
-			logtw("Unknown method: %d", message.GetMethod());
-			ResponseError(remote);
+			case StunClass::Request:
+				if (ProcessBindingRequest(remote, address, message) == false)
+				{
+					ResponseError(remote);
+				}
+				break;
+
+			case StunClass::SuccessResponse:
+				if (ProcessBindingResponse(remote, address, message) == false)
+				{
+					ResponseError(remote);
+				}
+				break;
+
+			case StunClass::ErrorResponse:
+				// TODO: 구현 예정
+				logtw("Error Response received");
+				break;
+
+			case StunClass::Indication:
+				// indication은 언제/어떻게 사용하는지 spec을 더 봐야함
+				logtw("Indication - not implemented");
+				break;
 		}
 	}
 	else
 	{
-		logtd("Not Stun packet. Passing data to observer...");
+		// binding 이외의 method는 구현되어 있지 않음
+		OV_ASSERT(false, "Not implemented method: %d", message.GetMethod());
+		logtw("Unknown method: %d", message.GetMethod());
+		ResponseError(remote);
+	}
+}
 
-		std::shared_ptr<IcePortInfo> ice_port_info;
+void IcePort::OnMediaPacketReceived(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddress &address, const std::shared_ptr<const ov::Data> &data)
+{
+	std::shared_ptr<IcePortInfo> ice_port_info;
 
-		{
-			std::lock_guard<std::mutex> lock_guard(_ice_port_info_mutex);
+	if (((_lookup_count++) % ICE_PORT_LOOKUP_SAMPLING_INTERVAL) == 0)
+	{
+		auto start = std::chrono::steady_clock::now();
 
-			auto item = _ice_port_info.find(address);
+		ice_port_info = _ice_port_info_table.Find(IceTupleKey(remote, address));
 
-			if (item != _ice_port_info.end())
-			{
-				ice_port_info = item->second;
-			}
-		}
+		int64_t elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+		_sampled_lookup_count++;
+		_total_lookup_time_ns += elapsed_ns;
 
-		if (ice_port_info == nullptr)
+		int64_t max_lookup_time_ns = _max_lookup_time_ns;
+		while ((elapsed_ns > max_lookup_time_ns) && (_max_lookup_time_ns.compare_exchange_weak(max_lookup_time_ns, elapsed_ns) == false))
 		{
-			// 포트 정보가 없음
-			// 이전 단계에서 관련 정보가 저장되어 있어야 함
-			logtd("Could not find client information. Dropping...");
-			return;
 		}
+	}
+	else
+	{
+		ice_port_info = _ice_port_info_table.Find(IceTupleKey(remote, address));
+	}
 
-		// TODO: 이걸 IcePort에서 할 것이 아니라 PhysicalPort에서 하는 것이 좋아보임
+	if (ice_port_info == nullptr)
+	{
+		// 포트 정보가 없음
+		// 이전 단계에서 관련 정보가 저장되어 있어야 함
+		logtd("Could not find client information. Dropping...");
+		return;
+	}
 
-		// observer들에게 알림
-		for (auto &observer : _observers)
-		{
-			logtd("Trying to callback OnDataReceived() to %p...", observer.get());
-			observer->OnDataReceived(*this, ice_port_info->session_info, data);
-			logtd("OnDataReceived() is returned (%p)", observer.get());
-		}
+	// TODO: 이걸 IcePort에서 할 것이 아니라 PhysicalPort에서 하는 것이 좋아보임
+
+	// observer들에게 알림
+	for (auto &observer : _observers)
+	{
+		observer->OnDataReceived(*this, ice_port_info->session_info, data);
 	}
 }
 
@@ -446,7 +503,7 @@ void IcePort::CheckTimedoutItem()
 		for (auto &deleted_ice_port : delete_list)
 		{
 			_session_table.erase(deleted_ice_port->session_info->GetId());
-			_ice_port_info.erase(deleted_ice_port->address);
+			_ice_port_info_table.Erase(deleted_ice_port->tuple, deleted_ice_port);
 		}
 	}
 }
@@ -507,7 +564,7 @@ bool IcePort::ProcessBindingRequest(const std::shared_ptr<ov::Socket> &remote, c
 		{
 			std::lock_guard<std::mutex> lock_guard(_ice_port_info_mutex);
 
-			_ice_port_info.erase(ice_port_info->address);
+			_ice_port_info_table.Erase(ice_port_info->tuple, ice_port_info);
 			_session_table.erase(ice_port_info->session_info->GetId());
 		}
 
@@ -563,7 +620,9 @@ bool IcePort::SendBindingResponse(const std::shared_ptr<ov::Socket> &remote, con
 		{
 			logtd("Add the client to the port list: %s", address.ToString().CStr());
 
-			_ice_port_info[address] = info;
+			info->tuple = IceTupleKey(remote, address);
+
+			_ice_port_info_table.Insert(info->tuple, info);
 			_session_table[info->session_info->GetId()] = info;
 		}
 		else
@@ -650,24 +709,16 @@ bool IcePort::ProcessBindingResponse(const std::shared_ptr<ov::Socket> &remote,
 {
 	// TODO: state가 checking 상태인지 확인
 
-	std::shared_ptr<IcePortInfo> ice_port_info;
+	auto ice_port_info = _ice_port_info_table.Find(IceTupleKey(remote, address));
 
+	if (ice_port_info == nullptr)
 	{
-		std::lock_guard<std::mutex> lock_guard(_ice_port_info_mutex);
+		// 포트 정보가 없음
+		// 이전 단계에서 관련 정보가 저장되어 있어야 함
 
-		auto item = _ice_port_info.find(address);
-
-		if (item == _ice_port_info.end())
-		{
-			// 포트 정보가 없음
-			// 이전 단계에서 관련 정보가 저장되어 있어야 함
-
-			// 같은 ufrag에 대해 서로 다른 ICE candidate로 부터 동시에 접속 요청이 왔다면, 첫 번째로 도착한 ICE candidate가 저장됨
-			// 따라서 두 번째 address는 처리하지 않으므로, 없다고 간주
-			return false;
-		}
-
-		ice_port_info = item->second;
+		// 같은 ufrag에 대해 서로 다른 ICE candidate로 부터 동시에 접속 요청이 왔다면, 첫 번째로 도착한 ICE candidate가 저장됨
+		// 따라서 두 번째 address는 처리하지 않으므로, 없다고 간주
+		return false;
 	}
 
 	// SDP의 password로 무결성 검사를 한 뒤
@@ -708,7 +759,25 @@ void IcePort::ResponseError(const std::shared_ptr<ov::Socket> &remote)
 	// TOOD: 구현 필요 - chrome에서는 오류가 발생했을 때, 별다른 조치를 취하지 않는 것 같음
 }
 
+double IcePort::GetAverageLookupTimeUSec() const
+{
+	uint64_t sampled_lookup_count = _sampled_lookup_count;
+
+	if (sampled_lookup_count == 0)
+	{
+		return 0.0;
+	}
+
+	return static_cast<double>(_total_lookup_time_ns) / sampled_lookup_count / 1000.0;
+}
+
+double IcePort::GetMaxLookupTimeUSec() const
+{
+	return static_cast<double>(_max_lookup_time_ns) / 1000.0;
+}
+
 ov::String IcePort::ToString() const
 {
-	return ov::String::FormatString("<IcePort: %p, %zu ports>", this, _physical_port_list.size());
+	return ov::String::FormatString("<IcePort: %p, %zu ports, lookup(avg %.3f us, max %.3f us)>",
+									this, _physical_port_list.size(), GetAverageLookupTimeUSec(), GetMaxLookupTimeUSec());
 }
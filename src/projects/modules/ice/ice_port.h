@@ -9,8 +9,10 @@
 #pragma once
 
 #include "ice_port_observer.h"
+#include "ice_tuple_table.h"
 #include "modules/ice/stun/stun_message.h"
 
+#include <atomic>
 #include <vector>
 #include <memory>
 
@@ -35,6 +37,8 @@ protected:
 
 		std::shared_ptr<ov::Socket> remote;
 		ov::SocketAddress address;
+		// Key of _ice_port_info_table (valid after the binding request is processed)
+		IceTupleKey tuple;
 
 		IcePortConnectionState state;
 
@@ -55,7 +59,7 @@ public:
 	IcePort();
 	~IcePort() override;
 
-	bool Create(std::vector<RtcIceCandidate> ice_candidate_list);
+	bool Create(std::vector<RtcIceCandidate> ice_candidate_list, int worker_count = 1);
 
 	const std::vector<RtcIceCandidate> &GetIceCandidateList() const;
 
@@ -95,10 +99,14 @@ public:
 	bool Send(const std::shared_ptr<info::Session> &session_info, std::unique_ptr<RtcpPacket> packet);
 	bool Send(const std::shared_ptr<info::Session> &session_info, const std::shared_ptr<const ov::Data> &data);
 
+	// Time to find the session of a non-STUN packet (sampled)
+	double GetAverageLookupTimeUSec() const;
+	double GetMaxLookupTimeUSec() const;
+
 	ov::String ToString() const;
 
 protected:
-	std::shared_ptr<PhysicalPort> CreatePhysicalPort(const ov::SocketAddress &address, ov::SocketType type);
+	std::shared_ptr<PhysicalPort> CreatePhysicalPort(const ov::SocketAddress &address, ov::SocketType type, int worker_count);
 	bool ParseIceCandidate(const ov::String &ice_candidate, std::vector<ov::String> *ip_list, ov::SocketType *socket_type, int *start_port, int *end_port);
 
 	//--------------------------------------------------------------------
@@ -109,6 +117,10 @@ protected:
 	void OnDisconnected(const std::shared_ptr<ov::Socket> &remote, PhysicalPortDisconnectReason reason, const std::shared_ptr<const ov::Error> &error) override;
 	//--------------------------------------------------------------------
 
+	void OnStunPacketReceived(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddress &address, const std::shared_ptr<const ov::Data> &data);
+	// DTLS, RTP/RTCP
+	void OnMediaPacketReceived(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddress &address, const std::shared_ptr<const ov::Data> &data);
+
 	void SetIceState(std::shared_ptr<IcePortInfo> &info, IcePortConnectionState state);
 	// STUN 오류를 반환함
 	void ResponseError(const std::shared_ptr<ov::Socket> &remote);
@@ -147,13 +159,22 @@ private:
 	// STUN nego가 완료되면 생성되는 mapping table
 
 	// 상대방의 ip:port로 IcePortInfo를 바로 찾을 수 있게 함
-	// key: SocketAddress
+	// The media packets are looked up without locking (See IceTupleTable)
+	// key: 5-tuple of the client
 	// value: IcePortInfo
+	IceTupleTable<IcePortInfo> _ice_port_info_table;
+
+	// Serializes the updates of _session_table and _ice_port_info_table
 	std::mutex _ice_port_info_mutex;
-	std::map<ov::SocketAddress, std::shared_ptr<IcePortInfo>> _ice_port_info;
 	// session_id로 IcePortInfo를 바로 찾을 수 있게 함
 	std::map<session_id_t, std::shared_ptr<IcePortInfo>> _session_table;
 
+	// Statistics of the lookups of the media packets
+	std::atomic<uint64_t> _lookup_count{0};
+	std::atomic<uint64_t> _sampled_lookup_count{0};
+	std::atomic<int64_t> _total_lookup_time_ns{0};
+	std::atomic<int64_t> _max_lookup_time_ns{0};
+
 	// 마지막으로 STUN 메시지가 온 시점을 기억함
 	ov::DelayQueue _timer;
 };
@@ -0,0 +1,172 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <base/ovsocket/ovsocket.h>
+
+#include <array>
+#include <mutex>
+#include <unordered_map>
+
+// Number of the shards of IceTupleTable (power of 2)
+#define ICE_TUPLE_TABLE_SHARD_COUNT (32)
+
+// 5-tuple (protocol, local port, remote address and port) of a packet, packed to be hashed and compared quickly
+//
+// The local address is not included, because the ICE port is bound to 0.0.0.0
+struct IceTupleKey
+{
+	IceTupleKey() = default;
+
+	IceTupleKey(const std::shared_ptr<ov::Socket> &socket, const ov::SocketAddress &remote_address)
+	{
+		// IPv4 address is stored as an IPv4-mapped IPv6 address (::ffff:a.b.c.d)
+		uint8_t ip[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+
+		if (remote_address.GetFamily() == ov::SocketFamily::Inet6)
+		{
+			::memcpy(ip, remote_address.AddrInForIPv6(), sizeof(ip));
+		}
+		else
+		{
+			::memcpy(&ip[12], remote_address.AddrInForIPv4(), 4);
+		}
+
+		::memcpy(words, ip, sizeof(ip));
+
+		auto local_address = (socket != nullptr) ? socket->GetLocalAddress() : nullptr;
+		uint64_t local_port = (local_address != nullptr) ? local_address->Port() : 0;
+		uint64_t protocol = (socket != nullptr) ? static_cast<uint64_t>(socket->GetType()) : 0;
+
+		words[2] = remote_address.Port() | (local_port << 16) | (protocol << 32);
+	}
+
+	bool operator==(const IceTupleKey &key) const
+	{
+		return (words[0] == key.words[0]) && (words[1] == key.words[1]) && (words[2] == key.words[2]);
+	}
+
+	size_t Hash() const
+	{
+		// splitmix64 finalizer of each word
+		uint64_t hash = 0;
+
+		for (auto word : words)
+		{
+			uint64_t value = word + hash + 0x9E3779B97F4A7C15ULL;
+
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+			hash = value ^ (value >> 31);
+		}
+
+		return static_cast<size_t>(hash);
+	}
+
+	uint64_t words[3] = {0, 0, 0};
+};
+
+struct IceTupleKeyHash
+{
+	size_t operator()(const IceTupleKey &key) const
+	{
+		return key.Hash();
+	}
+};
+
+// Hash table that maps the 5-tuple to T, for the media path (read-mostly)
+//
+// The entries are added/removed only when the sessions are connected/disconnected, but looked up for every packet.
+// So each shard publishes an immutable snapshot of the map, and the readers look up the snapshot without locking
+// (copy-on-write). The writers of a shard are serialized by the mutex of the shard.
+template <typename T>
+class IceTupleTable
+{
+public:
+	using Map = std::unordered_map<IceTupleKey, std::shared_ptr<T>, IceTupleKeyHash>;
+
+	IceTupleTable()
+	{
+		for (auto &shard : _shards)
+		{
+			shard.map = std::make_shared<const Map>();
+		}
+	}
+
+	std::shared_ptr<T> Find(const IceTupleKey &key) const
+	{
+		auto map = std::atomic_load(&(GetShard(key).map));
+		auto item = map->find(key);
+
+		return (item != map->end()) ? item->second : nullptr;
+	}
+
+	void Insert(const IceTupleKey &key, const std::shared_ptr<T> &value)
+	{
+		auto &shard = GetShard(key);
+		std::lock_guard<std::mutex> lock_guard(shard.mutex);
+
+		auto map = std::make_shared<Map>(*(shard.map));
+		(*map)[key] = value;
+
+		std::atomic_store(&(shard.map), std::shared_ptr<const Map>(std::move(map)));
+	}
+
+	// Removes the entry only if it is mapped to the value (nullptr: any value)
+	bool Erase(const IceTupleKey &key, const std::shared_ptr<T> &value = nullptr)
+	{
+		auto &shard = GetShard(key);
+		std::lock_guard<std::mutex> lock_guard(shard.mutex);
+
+		auto item = shard.map->find(key);
+
+		if ((item == shard.map->end()) || ((value != nullptr) && (item->second != value)))
+		{
+			return false;
+		}
+
+		auto map = std::make_shared<Map>(*(shard.map));
+		map->erase(key);
+
+		std::atomic_store(&(shard.map), std::shared_ptr<const Map>(std::move(map)));
+
+		return true;
+	}
+
+	void Clear()
+	{
+		for (auto &shard : _shards)
+		{
+			std::lock_guard<std::mutex> lock_guard(shard.mutex);
+
+			std::atomic_store(&(shard.map), std::make_shared<const Map>());
+		}
+	}
+
+private:
+	// Each shard is placed in its own cache line, since the snapshots are read by many threads
+	struct alignas(64) Shard
+	{
+		std::mutex mutex;
+		std::shared_ptr<const Map> map;
+	};
+
+	Shard &GetShard(const IceTupleKey &key)
+	{
+		// The upper bits are used, because the lower bits are used for the buckets of the map
+		return _shards[(key.Hash() >> 48) & (ICE_TUPLE_TABLE_SHARD_COUNT - 1)];
+	}
+
+	const Shard &GetShard(const IceTupleKey &key) const
+	{
+		return _shards[(key.Hash() >> 48) & (ICE_TUPLE_TABLE_SHARD_COUNT - 1)];
+	}
+
+	std::array<Shard, ICE_TUPLE_TABLE_SHARD_COUNT> _shards;
+};
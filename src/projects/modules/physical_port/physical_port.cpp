@@ -14,38 +14,54 @@
 
 PhysicalPort::PhysicalPort()
 	: _type(ov::SocketType::Unknown),
-	  _server_socket(nullptr),
-	  _datagram_socket(nullptr),
+	  _worker_count(0),
 
-	  _need_to_stop(true)
+	  _need_to_stop(true),
+
+	  _observer_list(std::make_shared<std::vector<PhysicalPortObserver *>>())
 {
 }
 
 PhysicalPort::~PhysicalPort()
 {
-	OV_ASSERT2(_observer_list.empty());
+	OV_ASSERT2(GetObserverList()->empty());
 }
 
 bool PhysicalPort::Create(ov::SocketType type,
 						  const ov::SocketAddress &address,
 						  int send_buffer_size,
-						  int recv_buffer_size)
+						  int recv_buffer_size,
+						  int worker_count)
 {
-	OV_ASSERT2((_server_socket == nullptr) && (_datagram_socket == nullptr));
+	OV_ASSERT2(_server_socket_list.empty() && _datagram_socket_list.empty());
 
 	logtd("Trying to start server...");
 
+	if (worker_count < 1)
+	{
+		worker_count = 1;
+	}
+
 	switch (type)
 	{
 		case ov::SocketType::Srt:
+			if (worker_count > 1)
+			{
+				// SRT manages its own listener, so SO_REUSEPORT cannot be applied to it
+				logtw("SRT port does not support multiple workers, %s will be served by one worker", address.ToString().CStr());
+				worker_count = 1;
+			}
+
+			[[fallthrough]];
+
 		case ov::SocketType::Tcp:
 		{
-			return CreateServerSocket(type, address, send_buffer_size, recv_buffer_size);
+			return CreateServerSocket(type, address, send_buffer_size, recv_buffer_size, worker_count);
 		}
 
 		case ov::SocketType::Udp:
 		{
-			return CreateDatagramSocket(type, address);
+			return CreateDatagramSocket(type, address, worker_count);
 		}
 
 		case ov::SocketType::Unknown:
@@ -58,213 +74,308 @@ bool PhysicalPort::Create(ov::SocketType type,
 bool PhysicalPort::CreateServerSocket(ov::SocketType type,
 									  const ov::SocketAddress &address,
 									  int send_buffer_size,
-									  int recv_buffer_size)
+									  int recv_buffer_size,
+									  int worker_count)
 {
-	auto socket = std::make_shared<ov::ServerSocket>();
+	bool reuse_port = (worker_count > 1);
 
-	if (socket->Prepare(type, address, send_buffer_size, recv_buffer_size, 1024))
+	// All the sockets must be bound before any worker starts to accept,
+	// otherwise the kernel may balance the connections over an incomplete reuseport group
+	for (int index = 0; index < worker_count; index++)
 	{
-		_type = type;
-		_server_socket = socket;
+		auto socket = std::make_shared<ov::ServerSocket>();
+
+		if (socket->Prepare(type, address, send_buffer_size, recv_buffer_size, 1024, reuse_port) == false)
+		{
+			logte("Could not prepare the worker #%d of %s", index, address.ToString().CStr());
+
+			for (auto &prepared_socket : _server_socket_list)
+			{
+				prepared_socket->Close();
+			}
 
-		_need_to_stop = false;
+			_server_socket_list.clear();
 
-		auto proc = [&, socket]() -> void {
-			auto client_callback = [&](const std::shared_ptr<ov::ClientSocket> &client, ov::SocketConnectionState state, const std::shared_ptr<ov::Error> &error) -> ov::SocketConnectionState {
-				switch (state)
-				{
-					case ov::SocketConnectionState::Connected:
-					{
-						logtd("New client is connected: %s", client->ToString().CStr());
+			return false;
+		}
 
-						// observer들에게 알림
-						auto func = std::bind(&PhysicalPortObserver::OnConnected, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client));
-						for_each(_observer_list.begin(), _observer_list.end(), func);
-						
-						break;
-					}
+		_server_socket_list.push_back(socket);
+	}
 
-					case ov::SocketConnectionState::Disconnected:
-					{
-						logtd("Client is disconnected: %s", client->ToString().CStr());
+	_type = type;
+	_address = address;
+	_worker_count = worker_count;
 
-						// observer들에게 알림
-						auto func = bind(&PhysicalPortObserver::OnDisconnected, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client), PhysicalPortDisconnectReason::Disconnected, nullptr);
-						for_each(_observer_list.begin(), _observer_list.end(), func);
+	_need_to_stop = false;
 
-						break;
-					}
+	// thread 시작
+	for (auto &socket : _server_socket_list)
+	{
+		_thread_list.emplace_back(&PhysicalPort::ServerSocketThread, this, socket);
+	}
+
+	if (worker_count > 1)
+	{
+		logti("%s is sharded into %d workers", address.ToString().CStr(), worker_count);
+	}
+
+	return true;
+}
 
-					case ov::SocketConnectionState::Error:
-					{
-						logtd("Client is disconnected with error: %s (%s)", client->ToString().CStr(), (error != nullptr) ? error->ToString().CStr() : "N/A");
+void PhysicalPort::ServerSocketThread(std::shared_ptr<ov::ServerSocket> socket)
+{
+	auto client_callback = [&](const std::shared_ptr<ov::ClientSocket> &client, ov::SocketConnectionState state, const std::shared_ptr<ov::Error> &error) -> ov::SocketConnectionState {
+		auto observer_list = GetObserverList();
 
-						// observer들에게 알림
-						auto func = bind(&PhysicalPortObserver::OnDisconnected, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client), PhysicalPortDisconnectReason::Error, error);
-						for_each(_observer_list.begin(), _observer_list.end(), func);
+		switch (state)
+		{
+			case ov::SocketConnectionState::Connected:
+			{
+				logtd("New client is connected: %s", client->ToString().CStr());
 
-						break;
-					}
-				}
+				// observer들에게 알림
+				auto func = std::bind(&PhysicalPortObserver::OnConnected, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client));
+				for_each(observer_list->begin(), observer_list->end(), func);
 
-				return state;
-			};
+				break;
+			}
 
-			auto data_callback = [&](const std::shared_ptr<ov::ClientSocket> &client, const std::shared_ptr<const ov::Data> &data) -> ov::SocketConnectionState {
-				logtd("Received data %d bytes:\n%s", data->GetLength(), data->Dump().CStr());
+			case ov::SocketConnectionState::Disconnected:
+			{
+				logtd("Client is disconnected: %s", client->ToString().CStr());
 
 				// observer들에게 알림
-				auto func = std::bind(&PhysicalPortObserver::OnDataReceived, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client), std::ref(*(client->GetRemoteAddress().get())), ref(data));
-				for_each(_observer_list.begin(), _observer_list.end(), func);
+				auto func = bind(&PhysicalPortObserver::OnDisconnected, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client), PhysicalPortDisconnectReason::Disconnected, nullptr);
+				for_each(observer_list->begin(), observer_list->end(), func);
 
-				return ov::SocketConnectionState::Connected;
-			};
+				break;
+			}
 
-			while ((_need_to_stop == false) && (socket->DispatchEvent(client_callback, data_callback, 500)))
+			case ov::SocketConnectionState::Error:
 			{
+				logtd("Client is disconnected with error: %s (%s)", client->ToString().CStr(), (error != nullptr) ? error->ToString().CStr() : "N/A");
+
+				// observer들에게 알림
+				auto func = bind(&PhysicalPortObserver::OnDisconnected, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client), PhysicalPortDisconnectReason::Error, error);
+				for_each(observer_list->begin(), observer_list->end(), func);
+
+				break;
 			}
+		}
 
-			socket->Close();
+		return state;
+	};
 
-			logtd("Server is stopped");
-		};
+	auto data_callback = [&](const std::shared_ptr<ov::ClientSocket> &client, const std::shared_ptr<const ov::Data> &data) -> ov::SocketConnectionState {
+		logtd("Received data %d bytes:\n%s", data->GetLength(), data->Dump().CStr());
 
-		// thread 시작
-		_thread = std::thread(proc);
+		auto observer_list = GetObserverList();
 
-		_address = address;
+		// observer들에게 알림
+		auto func = std::bind(&PhysicalPortObserver::OnDataReceived, std::placeholders::_1, std::static_pointer_cast<ov::Socket>(client), std::ref(*(client->GetRemoteAddress().get())), ref(data));
+		for_each(observer_list->begin(), observer_list->end(), func);
 
-		return true;
+		return ov::SocketConnectionState::Connected;
+	};
+
+	while ((_need_to_stop == false) && (socket->DispatchEvent(client_callback, data_callback, 500)))
+	{
 	}
 
-	return false;
+	socket->Close();
+
+	logtd("Server is stopped");
 }
 
-bool PhysicalPort::CreateDatagramSocket(ov::SocketType type, const ov::SocketAddress &address)
+bool PhysicalPort::CreateDatagramSocket(ov::SocketType type, const ov::SocketAddress &address, int worker_count)
 {
-	auto socket = std::make_shared<ov::DatagramSocket>();
+	// With SO_REUSEPORT, the kernel picks the socket of a datagram by hashing its 4-tuple (src/dst IP and port),
+	// so all the packets of a flow (e.g. an ICE session) are always delivered to the same worker.
+	// The hash depends on the number of sockets in the group, so the group must not change while the port is running.
+	bool reuse_port = (worker_count > 1);
 
-	if (socket->Prepare(address))
+	for (int index = 0; index < worker_count; index++)
 	{
-		_type = type;
-		_datagram_socket = socket;
+		auto socket = std::make_shared<ov::DatagramSocket>();
 
-		_need_to_stop = false;
+		if (socket->Prepare(address, reuse_port) == false)
+		{
+			logte("Could not prepare the worker #%d of %s", index, address.ToString().CStr());
 
-		auto proc = [&, socket]() -> void {
-			auto data_callback = [&](const std::shared_ptr<ov::DatagramSocket> &socket, const ov::SocketAddress &remote_address, const std::shared_ptr<const ov::Data> &data) -> bool {
-				logtd("Received data %d bytes:\n%s", data->GetLength(), data->Dump().CStr());
+			for (auto &prepared_socket : _datagram_socket_list)
+			{
+				prepared_socket->Close();
+			}
 
-				// observer들에게 알림
-				auto func = std::bind(&PhysicalPortObserver::OnDataReceived, std::placeholders::_1, socket, remote_address, ref(data));
-				for_each(_observer_list.begin(), _observer_list.end(), func);
+			_datagram_socket_list.clear();
 
-				// UDP는 1회용 소켓으로 사용
-				return true;
-			};
+			return false;
+		}
 
-			while ((_need_to_stop == false) && (socket->DispatchEvent(data_callback, 500)))
-			{
-			}
+		_datagram_socket_list.push_back(socket);
+	}
+
+	_type = type;
+	_address = address;
+	_worker_count = worker_count;
+
+	_need_to_stop = false;
+
+	// thread 시작
+	for (auto &socket : _datagram_socket_list)
+	{
+		_thread_list.emplace_back(&PhysicalPort::DatagramSocketThread, this, socket);
+	}
+
+	if (worker_count > 1)
+	{
+		logti("%s is sharded into %d workers", address.ToString().CStr(), worker_count);
+	}
 
-			socket->Close();
+	return true;
+}
 
-			logtd("Server is stopped");
-		};
+void PhysicalPort::DatagramSocketThread(std::shared_ptr<ov::DatagramSocket> socket)
+{
+	auto data_callback = [&](const std::shared_ptr<ov::DatagramSocket> &socket, const ov::SocketAddress &remote_address, const std::shared_ptr<const ov::Data> &data) -> bool {
+		logtd("Received data %d bytes:\n%s", data->GetLength(), data->Dump().CStr());
 
-		// thread 시작
-		_thread = std::thread(proc);
+		auto observer_list = GetObserverList();
 
-		_address = address;
+		// observer들에게 알림
+		auto func = std::bind(&PhysicalPortObserver::OnDataReceived, std::placeholders::_1, socket, remote_address, ref(data));
+		for_each(observer_list->begin(), observer_list->end(), func);
 
+		// UDP는 1회용 소켓으로 사용
 		return true;
+	};
+
+	while ((_need_to_stop == false) && (socket->DispatchEvent(data_callback, 500)))
+	{
 	}
 
-	return false;
+	socket->Close();
+
+	logtd("Server is stopped");
 }
 
 bool PhysicalPort::Close()
 {
 	_need_to_stop = true;
 
-	if (_thread.joinable())
+	for (auto &thread : _thread_list)
 	{
-		_thread.join();
+		if (thread.joinable())
+		{
+			thread.join();
+		}
 	}
 
-	_thread = std::thread();
+	_thread_list.clear();
+
+	bool result = true;
 
 	switch (_type)
 	{
+		case ov::SocketType::Srt:
 		case ov::SocketType::Tcp:
-			if (_server_socket != nullptr)
+			for (auto &socket : _server_socket_list)
 			{
-				if ((_server_socket->GetState() == ov::SocketState::Closed) || (_server_socket->Close()))
-				{
-					_server_socket = nullptr;
-					_observer_list.clear();
-					return true;
-				}
+				result = result && ((socket->GetState() == ov::SocketState::Closed) || (socket->Close()));
 			}
+
+			_server_socket_list.clear();
 			break;
 
 		case ov::SocketType::Udp:
-			if ((_datagram_socket->GetState() == ov::SocketState::Closed) || (_datagram_socket->Close()))
+			for (auto &socket : _datagram_socket_list)
 			{
-				_datagram_socket = nullptr;
-				_observer_list.clear();
-				return true;
+				result = result && ((socket->GetState() == ov::SocketState::Closed) || (socket->Close()));
 			}
+
+			_datagram_socket_list.clear();
 			break;
 
 		default:
-			break;
+			return false;
 	}
 
-	return false;
+	if (result)
+	{
+		std::lock_guard<std::mutex> lock(_observer_list_mutex);
+		std::atomic_store(&_observer_list, std::make_shared<const std::vector<PhysicalPortObserver *>>());
+	}
+
+	return result;
 }
 
 ov::SocketState PhysicalPort::GetState()
 {
+	// All the workers share the same state, so the first one represents the port
 	switch (_type)
 	{
+		case ov::SocketType::Srt:
 		case ov::SocketType::Tcp:
-			OV_ASSERT2(_server_socket != nullptr);
+			OV_ASSERT2(_server_socket_list.empty() == false);
 
-			return _server_socket->GetState();
+			return _server_socket_list.empty() ? ov::SocketState::Closed : _server_socket_list[0]->GetState();
 
 		case ov::SocketType::Udp:
-			OV_ASSERT2(_datagram_socket != nullptr);
+			OV_ASSERT2(_datagram_socket_list.empty() == false);
 
-			return _datagram_socket->GetState();
+			return _datagram_socket_list.empty() ? ov::SocketState::Closed : _datagram_socket_list[0]->GetState();
 
 		default:
 			return ov::SocketState::Closed;
 	}
 }
 
+std::shared_ptr<const std::vector<PhysicalPortObserver *>> PhysicalPort::GetObserverList() const
+{
+	return std::atomic_load(&_observer_list);
+}
+
 bool PhysicalPort::AddObserver(PhysicalPortObserver *observer)
 {
-	_observer_list.push_back(observer);
+	std::lock_guard<std::mutex> lock(_observer_list_mutex);
+
+	auto observer_list = std::make_shared<std::vector<PhysicalPortObserver *>>(*_observer_list);
+	observer_list->push_back(observer);
+
+	std::atomic_store(&_observer_list, std::shared_ptr<const std::vector<PhysicalPortObserver *>>(observer_list));
 
 	return true;
 }
 
 bool PhysicalPort::RemoveObserver(PhysicalPortObserver *observer)
 {
-	auto item = std::find(_observer_list.begin(), _observer_list.end(), observer);
+	std::lock_guard<std::mutex> lock(_observer_list_mutex);
+
+	auto observer_list = std::make_shared<std::vector<PhysicalPortObserver *>>(*_observer_list);
+	auto item = std::find(observer_list->begin(), observer_list->end(), observer);
 
-	if (item == _observer_list.end())
+	if (item == observer_list->end())
 	{
 		return false;
 	}
 
-	_observer_list.erase(item);
+	observer_list->erase(item);
+
+	std::atomic_store(&_observer_list, std::shared_ptr<const std::vector<PhysicalPortObserver *>>(observer_list));
 
 	return true;
 }
 
 bool PhysicalPort::DisconnectClient(ov::ClientSocket *client_socket)
 {
-	return _server_socket->DisconnectClient(client_socket, ov::SocketConnectionState::Disconnected);
+	// The client belongs to the worker that accepted it
+	for (auto &socket : _server_socket_list)
+	{
+		if (socket->DisconnectClient(client_socket, ov::SocketConnectionState::Disconnected))
+		{
+			return true;
+		}
+	}
+
+	return false;
 }
@@ -12,12 +12,17 @@
 
 #include <memory>
 #include <functional>
+#include <mutex>
 #include <thread>
 
 #include <base/ovsocket/ovsocket.h>
 
 // PhysicalPort는 여러 곳에서 공유해서 사용할 수 있음
 // PhysicalPortObserver를 iteration 하면서 callback 할 수 있는 구조 필요
+//
+// When worker_count > 1, the port is sharded into worker_count listeners bound to the same address with SO_REUSEPORT.
+// Each worker has its own socket, epoll instance and thread, and the kernel distributes the incoming connections/datagrams
+// among them. Observers are called on the thread of the worker that received the event, so they must be thread-safe.
 class PhysicalPort
 {
 public:
@@ -27,7 +32,8 @@ public:
 	bool Create(ov::SocketType type,
                 const ov::SocketAddress &address,
                 int send_buffer_size = 0,
-                int recv_buffer_size = 0);
+                int recv_buffer_size = 0,
+                int worker_count = 1);
 
 	bool Close();
 
@@ -43,6 +49,11 @@ public:
 		return _address;
 	}
 
+	int GetWorkerCount() const
+	{
+		return _worker_count;
+	}
+
 	bool AddObserver(PhysicalPortObserver *observer);
 
 	bool RemoveObserver(PhysicalPortObserver *observer);
@@ -53,20 +64,33 @@ protected:
 	bool CreateServerSocket(ov::SocketType type,
 	                        const ov::SocketAddress &address,
 	                        int send_buffer_size,
-                            int recv_buffer_size);
+                            int recv_buffer_size,
+	                        int worker_count);
 
-	bool CreateDatagramSocket(ov::SocketType type, const ov::SocketAddress &address);
+	bool CreateDatagramSocket(ov::SocketType type, const ov::SocketAddress &address, int worker_count);
+
+	void ServerSocketThread(std::shared_ptr<ov::ServerSocket> socket);
+	void DatagramSocketThread(std::shared_ptr<ov::DatagramSocket> socket);
+
+	std::shared_ptr<const std::vector<PhysicalPortObserver *>> GetObserverList() const;
 
 	std::shared_ptr<PhysicalPort> _self;
 
 	ov::SocketType _type;
 	ov::SocketAddress _address;
 
-	std::shared_ptr<ov::ServerSocket> _server_socket;
-	std::shared_ptr<ov::DatagramSocket> _datagram_socket;
+	int _worker_count;
+
+	// One socket per worker
+	std::vector<std::shared_ptr<ov::ServerSocket>> _server_socket_list;
+	std::vector<std::shared_ptr<ov::DatagramSocket>> _datagram_socket_list;
 
 	volatile bool _need_to_stop;
-	std::thread _thread;
+	std::vector<std::thread> _thread_list;
 
-	std::vector<PhysicalPortObserver *> _observer_list;
+	// Copy-on-write list: workers iterate an immutable snapshot without locking,
+	// so an observer may call AddObserver()/DisconnectClient() from its own callback.
+	// Always accessed with std::atomic_load()/std::atomic_store()
+	std::mutex _observer_list_mutex;
+	std::shared_ptr<const std::vector<PhysicalPortObserver *>> _observer_list;
 };
@@ -16,7 +16,7 @@ PhysicalPortManager::~PhysicalPortManager()
 {
 }
 
-std::shared_ptr<PhysicalPort> PhysicalPortManager::CreatePort(ov::SocketType type, const ov::SocketAddress &address)
+std::shared_ptr<PhysicalPort> PhysicalPortManager::CreatePort(ov::SocketType type, const ov::SocketAddress &address, int worker_count)
 {
 	auto key = std::make_pair(type, address);
 	auto item = _port_list.find(key);
@@ -26,7 +26,7 @@ std::shared_ptr<PhysicalPort> PhysicalPortManager::CreatePort(ov::SocketType typ
 	{
 		port = std::make_shared<PhysicalPort>();
 
-		if(port->Create(type, address))
+		if(port->Create(type, address, 0, 0, worker_count))
 		{
 			_port_list[key] = port;
 		}
@@ -20,7 +20,8 @@ public:
 
 	virtual ~PhysicalPortManager();
 
-	std::shared_ptr<PhysicalPort> CreatePort(ov::SocketType type, const ov::SocketAddress &address);
+	// If the port is already created, it is shared regardless of worker_count
+	std::shared_ptr<PhysicalPort> CreatePort(ov::SocketType type, const ov::SocketAddress &address, int worker_count = 1);
 
 	bool DeletePort(std::shared_ptr<PhysicalPort> &port);
 
@@ -21,7 +21,7 @@ RtcSignallingServer::RtcSignallingServer(const cfg::Server &server_config)
 {
 }
 
-bool RtcSignallingServer::Start(const ov::SocketAddress *address, const ov::SocketAddress *tls_address)
+bool RtcSignallingServer::Start(const ov::SocketAddress *address, const ov::SocketAddress *tls_address, int worker_count)
 {
 	if ((_http_server != nullptr) || (_https_server != nullptr))
 	{
@@ -67,8 +67,8 @@ bool RtcSignallingServer::Start(const ov::SocketAddress *address, const ov::Sock
 
 	result = result && InitializeWebSocketServer();
 
-	result = result && ((_http_server == nullptr) || _http_server->Start(*address));
-	result = result && ((_https_server == nullptr) || _https_server->Start(*tls_address));
+	result = result && ((_http_server == nullptr) || _http_server->Start(*address, worker_count));
+	result = result && ((_https_server == nullptr) || _https_server->Start(*tls_address, worker_count));
 
 	if (result == false)
 	{
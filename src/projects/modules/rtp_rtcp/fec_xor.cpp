@@ -0,0 +1,174 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "fec_xor.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#	include <immintrin.h>
+#	define FEC_XOR_X86_SUPPORTED
+#endif
+
+namespace
+{
+	typedef void (*XorFunction)(uint8_t *destination, const uint8_t *source, size_t length);
+
+	struct XorImplementation
+	{
+		XorFunction function;
+		const char *name;
+	};
+
+	void XorScalar(uint8_t *destination, const uint8_t *source, size_t length)
+	{
+		// 8 bytes at a time (memcpy() is used because the payloads are not aligned, and it is compiled to a single load/store)
+		while (length >= sizeof(uint64_t))
+		{
+			uint64_t destination_word;
+			uint64_t source_word;
+
+			::memcpy(&destination_word, destination, sizeof(uint64_t));
+			::memcpy(&source_word, source, sizeof(uint64_t));
+
+			destination_word ^= source_word;
+
+			::memcpy(destination, &destination_word, sizeof(uint64_t));
+
+			destination += sizeof(uint64_t);
+			source += sizeof(uint64_t);
+			length -= sizeof(uint64_t);
+		}
+
+		while (length > 0)
+		{
+			*destination++ ^= *source++;
+			length--;
+		}
+	}
+
+#if defined(FEC_XOR_X86_SUPPORTED)
+	__attribute__((target("sse2"))) void XorSse2(uint8_t *destination, const uint8_t *source, size_t length)
+	{
+		// 64 bytes per iteration
+		while (length >= 64)
+		{
+			auto d0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination));
+			auto d1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination + 16));
+			auto d2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination + 32));
+			auto d3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination + 48));
+
+			auto s0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+			auto s1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + 16));
+			auto s2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + 32));
+			auto s3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + 48));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(destination), _mm_xor_si128(d0, s0));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + 16), _mm_xor_si128(d1, s1));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + 32), _mm_xor_si128(d2, s2));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + 48), _mm_xor_si128(d3, s3));
+
+			destination += 64;
+			source += 64;
+			length -= 64;
+		}
+
+		while (length >= 16)
+		{
+			auto d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination));
+			auto s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(destination), _mm_xor_si128(d, s));
+
+			destination += 16;
+			source += 16;
+			length -= 16;
+		}
+
+		XorScalar(destination, source, length);
+	}
+
+	__attribute__((target("avx2"))) void XorAvx2(uint8_t *destination, const uint8_t *source, size_t length)
+	{
+		// 128 bytes per iteration
+		while (length >= 128)
+		{
+			auto d0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination));
+			auto d1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination + 32));
+			auto d2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination + 64));
+			auto d3 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination + 96));
+
+			auto s0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source));
+			auto s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + 32));
+			auto s2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + 64));
+			auto s3 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + 96));
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(destination), _mm256_xor_si256(d0, s0));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + 32), _mm256_xor_si256(d1, s1));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + 64), _mm256_xor_si256(d2, s2));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + 96), _mm256_xor_si256(d3, s3));
+
+			destination += 128;
+			source += 128;
+			length -= 128;
+		}
+
+		while (length >= 32)
+		{
+			auto d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination));
+			auto s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source));
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(destination), _mm256_xor_si256(d, s));
+
+			destination += 32;
+			source += 32;
+			length -= 32;
+		}
+
+		// Avoid the AVX-SSE transition penalty before returning to the non-VEX code
+		_mm256_zeroupper();
+
+		XorScalar(destination, source, length);
+	}
+#endif  // defined(FEC_XOR_X86_SUPPORTED)
+
+	XorImplementation SelectImplementation()
+	{
+#if defined(FEC_XOR_X86_SUPPORTED)
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx2"))
+		{
+			return {XorAvx2, "AVX2"};
+		}
+
+		if (__builtin_cpu_supports("sse2"))
+		{
+			return {XorSse2, "SSE2"};
+		}
+#endif  // defined(FEC_XOR_X86_SUPPORTED)
+
+		return {XorScalar, "Scalar"};
+	}
+
+	const XorImplementation &GetImplementation()
+	{
+		static const XorImplementation implementation = SelectImplementation();
+
+		return implementation;
+	}
+}  // namespace
+
+void FecXor::Xor(uint8_t *destination, const uint8_t *source, size_t length)
+{
+	GetImplementation().function(destination, source, length);
+}
+
+const char *FecXor::GetImplementationName()
+{
+	return GetImplementation().name;
+}
@@ -0,0 +1,25 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// XOR kernels used to generate FEC packets
+//
+// The fastest implementation supported by the CPU (AVX2 > SSE2 > scalar) is selected at runtime when it is first used.
+class FecXor
+{
+public:
+	// destination[i] ^= source[i] (0 <= i < length)
+	// The buffers don't need to be aligned
+	static void Xor(uint8_t *destination, const uint8_t *source, size_t length);
+
+	// Name of the selected implementation (for logging)
+	static const char *GetImplementationName();
+};
@@ -60,6 +60,23 @@ Receiver Estimated Max Bitrate (REMB)
 |  ...                                                          |
 
 
+ Generic NACK (RFC 4585)
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|V=2|P| FMT=1   |   PT=205      |             length            |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                  SSRC of packet sender                        |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                  SSRC of media source                         |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|            PID                |             BLP               | FCI
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|  ...                                                          |
+ - PID: sequence number of the lost packet
+ - BLP: bitmask of following lost packets (bit i: PID + i + 1 is lost)
+
+
  jitter
  - Si is the RTP timestamp from packet i
  - Ri is the time of arrival in RTP timestamp units for packet i
@@ -102,6 +119,12 @@ ov::String  RtcpPacket::GetPacketTypeString(RtcpPacketType type)
         case RtcpPacketType::APP :
             result = "APP";
             break;
+        case RtcpPacketType::RTPFB :
+            result = "RTPFB";
+            break;
+        case RtcpPacketType::PSFB :
+            result = "PSFB";
+            break;
     }
 
     return result;
@@ -131,7 +154,7 @@ bool RtcpPacket::IsRtcpPacket(const std::shared_ptr<const ov::Data> &data,
     // rtcp rr packet check
     if(version != RTCP_HEADER_VERSION ||
        type < (int)RtcpPacketType::SR ||
-       type > (int)RtcpPacketType::APP ||
+       type > (int)RtcpPacketType::PSFB ||
        data->GetLength() < RTCP_HEADER_SIZE + payload_size)
     {
         return false;
@@ -179,6 +202,241 @@ bool RtcpPacket::RrParseing(int report_count,
     return true;
 }
 
+//====================================================================================================
+// Generic NACK Parsing
+//====================================================================================================
+bool RtcpPacket::NackParsing(int report_count,
+                             const std::shared_ptr<const ov::Data> &data,
+                             RtcpNack &nack)
+{
+    if(report_count != RTCP_RTPFB_FMT_NACK)
+    {
+        return false;
+    }
+
+    ov::ByteStream stream(data.get());
+    stream.Skip(2);
+    size_t payload_size = stream.ReadBE16() * 4;
+
+    // SSRC of packet sender + SSRC of media source + FCI (at least one)
+    if((payload_size < 4 + 4 + 4) || (data->GetLength() < RTCP_HEADER_SIZE + payload_size))
+    {
+        return false;
+    }
+
+    nack.sender_ssrc = stream.ReadBE32();
+    nack.media_ssrc = stream.ReadBE32();
+    nack.lost_sequence_numbers.clear();
+
+    for(size_t fci_count = (payload_size - 8) / 4; fci_count > 0; fci_count--)
+    {
+        uint16_t pid = stream.ReadBE16();
+        uint16_t blp = stream.ReadBE16();
+
+        nack.lost_sequence_numbers.push_back(pid);
+
+        for(int bit = 0; bit < 16; bit++)
+        {
+            if(blp & (1 << bit))
+            {
+                nack.lost_sequence_numbers.push_back(static_cast<uint16_t>(pid + bit + 1));
+            }
+        }
+    }
+
+    return true;
+}
+
+//====================================================================================================
+// Transport-wide Feedback Parsing
+/*
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|V=2|P|  FMT=15 |    PT=205     |           length              |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                     SSRC of packet sender                     |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                      SSRC of media source                     |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|      base sequence number     |      packet status count      |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                 reference time                | fb pkt. count |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|          packet chunk         |         packet chunk          |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+.                                                               .
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|         packet chunk          |  recv delta   |  recv delta   |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+.                                                               .
+*/
+//====================================================================================================
+// Status symbols
+#define TRANSPORT_CC_NOT_RECEIVED           (0)
+#define TRANSPORT_CC_RECEIVED_SMALL_DELTA   (1)
+#define TRANSPORT_CC_RECEIVED_LARGE_DELTA   (2)
+// Units of the reference time and the receive delta
+#define TRANSPORT_CC_REFERENCE_TIME_UNIT_US (64000)
+#define TRANSPORT_CC_DELTA_UNIT_US          (250)
+
+bool RtcpPacket::TransportFeedbackParsing(int report_count,
+                                          const std::shared_ptr<const ov::Data> &data,
+                                          RtcpTransportFeedback &feedback)
+{
+    if(report_count != RTCP_RTPFB_FMT_TRANSPORT_CC)
+    {
+        return false;
+    }
+
+    ov::ByteStream stream(data.get());
+    stream.Skip(2);
+    size_t payload_size = stream.ReadBE16() * 4;
+
+    // SSRC of packet sender + SSRC of media source + base seq + status count + reference time + fb pkt count
+    if((payload_size < 4 + 4 + 2 + 2 + 3 + 1) || (data->GetLength() < RTCP_HEADER_SIZE + payload_size))
+    {
+        return false;
+    }
+
+    feedback.sender_ssrc = stream.ReadBE32();
+    feedback.media_ssrc = stream.ReadBE32();
+
+    uint16_t base_sequence_number = stream.ReadBE16();
+    uint16_t packet_status_count = stream.ReadBE16();
+
+    // 24 bits signed integer
+    int32_t reference_time = static_cast<int32_t>(static_cast<uint32_t>(stream.ReadBE24()) << 8) >> 8;
+    feedback.feedback_packet_count = stream.Read8();
+
+    size_t remained = payload_size - (4 + 4 + 2 + 2 + 3 + 1);
+
+    // Status of each packet
+    std::vector<uint8_t> symbols;
+    symbols.reserve(packet_status_count);
+
+    while(symbols.size() < packet_status_count)
+    {
+        if(remained < 2)
+        {
+            return false;
+        }
+
+        uint16_t chunk = stream.ReadBE16();
+        remained -= 2;
+
+        if((chunk & 0x8000) == 0)
+        {
+            // Run length chunk: |T=0|S(2)|Run Length(13)|
+            uint8_t symbol = (chunk >> 13) & 0x03;
+            size_t run_length = std::min<size_t>(chunk & 0x1FFF, packet_status_count - symbols.size());
+
+            symbols.insert(symbols.end(), run_length, symbol);
+        }
+        else if((chunk & 0x4000) == 0)
+        {
+            // Status vector chunk with 1 bit symbols: |T=1|S=0|symbol list(14)|
+            for(int index = 13; (index >= 0) && (symbols.size() < packet_status_count); index--)
+            {
+                symbols.push_back((chunk >> index) & 0x01);
+            }
+        }
+        else
+        {
+            // Status vector chunk with 2 bits symbols: |T=1|S=1|symbol list(7 * 2)|
+            for(int index = 6; (index >= 0) && (symbols.size() < packet_status_count); index--)
+            {
+                symbols.push_back((chunk >> (index * 2)) & 0x03);
+            }
+        }
+    }
+
+    feedback.packet_results.clear();
+    feedback.packet_results.reserve(packet_status_count);
+
+    int64_t arrival_time_us = static_cast<int64_t>(reference_time) * TRANSPORT_CC_REFERENCE_TIME_UNIT_US;
+    uint16_t sequence_number = base_sequence_number;
+
+    for(auto symbol : symbols)
+    {
+        RtcpTransportFeedback::PacketResult result;
+
+        result.sequence_number = sequence_number++;
+
+        if(symbol == TRANSPORT_CC_RECEIVED_SMALL_DELTA)
+        {
+            if(remained < 1)
+            {
+                return false;
+            }
+
+            arrival_time_us += stream.Read8() * TRANSPORT_CC_DELTA_UNIT_US;
+            remained -= 1;
+        }
+        else if(symbol == TRANSPORT_CC_RECEIVED_LARGE_DELTA)
+        {
+            if(remained < 2)
+            {
+                return false;
+            }
+
+            arrival_time_us += static_cast<int16_t>(stream.ReadBE16()) * TRANSPORT_CC_DELTA_UNIT_US;
+            remained -= 2;
+        }
+        else if(symbol != TRANSPORT_CC_NOT_RECEIVED)
+        {
+            // Reserved
+            return false;
+        }
+
+        result.received = (symbol != TRANSPORT_CC_NOT_RECEIVED);
+        result.arrival_time_us = result.received ? arrival_time_us : 0;
+
+        feedback.packet_results.push_back(result);
+    }
+
+    return true;
+}
+
+//====================================================================================================
+// PLI/FIR Parsing
+//====================================================================================================
+bool RtcpPacket::KeyFrameRequestParsing(int report_count,
+                                        const std::shared_ptr<const ov::Data> &data,
+                                        RtcpKeyFrameRequest &request)
+{
+    if((report_count != RTCP_PSFB_FMT_PLI) && (report_count != RTCP_PSFB_FMT_FIR))
+    {
+        return false;
+    }
+
+    ov::ByteStream stream(data.get());
+    stream.Skip(2);
+    size_t payload_size = stream.ReadBE16() * 4;
+
+    // SSRC of packet sender + SSRC of media source (+ FCI of FIR: SSRC(4) + Seq nr.(1) + Reserved(3))
+    size_t minimum_size = (report_count == RTCP_PSFB_FMT_FIR) ? (4 + 4 + 8) : (4 + 4);
+
+    if((payload_size < minimum_size) || (data->GetLength() < RTCP_HEADER_SIZE + payload_size))
+    {
+        return false;
+    }
+
+    request.is_fir = (report_count == RTCP_PSFB_FMT_FIR);
+    request.sender_ssrc = stream.ReadBE32();
+    request.media_ssrc = stream.ReadBE32();
+
+    if(request.is_fir)
+    {
+        // "SSRC of media source" is not used in FIR, the target is in the FCI
+        // (Only the first entry is used, the others are for other SSRCs that this session does not send)
+        request.media_ssrc = stream.ReadBE32();
+        request.fir_sequence_number = stream.Read8();
+    }
+
+    return true;
+}
+
 //====================================================================================================
 // SR type packet Make
 /*
@@ -22,6 +22,49 @@ enum class RtcpPacketType
     SDES = 202, // Source Description message
     BYE = 203,  // Bye message
     APP = 204,  // Application specfic RTCP
+    RTPFB = 205,    // Transport layer feedback message (RFC 4585)
+    PSFB = 206,     // Payload-specific feedback message (RFC 4585)
+};
+
+// FMT of RTPFB
+#define RTCP_RTPFB_FMT_NACK         (1)     // Generic NACK
+#define RTCP_RTPFB_FMT_TRANSPORT_CC (15)    // Transport-wide congestion control feedback
+
+// Generic NACK (RFC 4585 6.2.1)
+struct RtcpNack
+{
+    uint32_t sender_ssrc = 0;               // SSRC of packet sender
+    uint32_t media_ssrc = 0;                // SSRC of media source
+    std::vector<uint16_t> lost_sequence_numbers;
+};
+
+// Transport-wide congestion control feedback (draft-holmer-rmcat-transport-wide-cc-extensions-01)
+struct RtcpTransportFeedback
+{
+    struct PacketResult
+    {
+        uint16_t sequence_number = 0;       // Transport-wide sequence number
+        bool received = false;
+        int64_t arrival_time_us = 0;        // Valid only if received (the clock of the receiver)
+    };
+
+    uint32_t sender_ssrc = 0;               // SSRC of packet sender
+    uint32_t media_ssrc = 0;                // SSRC of media source
+    uint8_t feedback_packet_count = 0;
+    std::vector<PacketResult> packet_results;
+};
+
+// FMT of PSFB
+#define RTCP_PSFB_FMT_PLI           (1)     // Picture Loss Indication
+#define RTCP_PSFB_FMT_FIR           (4)     // Full Intra Request (RFC 5104)
+
+// PLI (RFC 4585 6.3.1) or FIR (RFC 5104 4.3.1)
+struct RtcpKeyFrameRequest
+{
+    bool is_fir = false;
+    uint32_t sender_ssrc = 0;               // SSRC of packet sender
+    uint32_t media_ssrc = 0;                // SSRC of media source (FIR: SSRC of the FCI entry)
+    uint8_t fir_sequence_number = 0;        // Command sequence number (FIR only)
 };
 
 struct RtcpReceiverReport
@@ -65,6 +108,21 @@ public :
                             const std::shared_ptr<const ov::Data> &data,
                             std::vector<std::shared_ptr<RtcpReceiverReport>> &receiver_reports);
 
+    // report_count: FMT field of the feedback message
+    static bool NackParsing(int report_count,
+                            const std::shared_ptr<const ov::Data> &data,
+                            RtcpNack &nack);
+
+    // Returns false if the packet is not a transport-wide feedback
+    static bool TransportFeedbackParsing(int report_count,
+                                         const std::shared_ptr<const ov::Data> &data,
+                                         RtcpTransportFeedback &feedback);
+
+    // Returns false if the packet is not a PLI/FIR
+    static bool KeyFrameRequestParsing(int report_count,
+                                       const std::shared_ptr<const ov::Data> &data,
+                                       RtcpKeyFrameRequest &request);
+
     static std::shared_ptr<ov::Data> MakeSrPacket(uint32_t ssrc, uint32_t rtp_timestamp, uint32_t packet_count, uint32_t octet_count);
     static std::shared_ptr<ov::Data> MakeSrPacket(uint32_t lsr, uint32_t dlsr, uint32_t ssrc, uint32_t rtp_timestamp, uint32_t packet_count, uint32_t octet_count);
 
@@ -9,9 +9,14 @@ RtcpSRGenerator::RtcpSRGenerator(uint32_t ssrc)
 
 void RtcpSRGenerator::AddRTPPacketAndGenerateRtcpSR(const RtpPacket &rtp_packet)
 {
-    //logc("DEBUG", ">>>> timestamp(%u) ssrc(%u)", rtp_packet.Timestamp(), rtp_packet.Ssrc());
+    AddRTPPacketAndGenerateRtcpSR(rtp_packet.Timestamp(), rtp_packet.PayloadSize());
+}
+
+void RtcpSRGenerator::AddRTPPacketAndGenerateRtcpSR(uint32_t rtp_timestamp, uint32_t payload_size)
+{
+    //logc("DEBUG", ">>>> timestamp(%u) ssrc(%u)", rtp_timestamp, _ssrc);
     _packet_count ++;
-    _octec_count += rtp_packet.PayloadSize();
+    _octec_count += payload_size;
 
     // RTCP Interval
     // Send RTCP SR twice a second for the first 10 seconds so the player can sync AV. 
@@ -19,7 +24,7 @@ void RtcpSRGenerator::AddRTPPacketAndGenerateRtcpSR(const RtpPacket &rtp_packet)
     if((GetElapsedTimeMSFromCreated() < 10000 && GetElapsedTimeMSFromRtcpSRGenerated() > 500) ||
         GetElapsedTimeMSFromRtcpSRGenerated() > 4999)
     {
-        _rtcp_sr_packet = RtcpPacket::MakeSrPacket(_ssrc, rtp_packet.Timestamp(), _packet_count, _octec_count);
+        _rtcp_sr_packet = RtcpPacket::MakeSrPacket(_ssrc, rtp_timestamp, _packet_count, _octec_count);
 
         // Reset RTCP information
         _packet_count = 0;
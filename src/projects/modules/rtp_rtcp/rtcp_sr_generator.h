@@ -10,6 +10,7 @@ public:
     RtcpSRGenerator(uint32_t ssrc);
 
 	void AddRTPPacketAndGenerateRtcpSR(const RtpPacket &rtp_packet);
+	void AddRTPPacketAndGenerateRtcpSR(uint32_t rtp_timestamp, uint32_t payload_size);
 	bool IsAvailableRtcpSRPacket() const;
 	std::shared_ptr<ov::Data>   PopRtcpSRPacket();
 	
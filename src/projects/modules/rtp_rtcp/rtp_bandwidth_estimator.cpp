@@ -0,0 +1,421 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "rtp_bandwidth_estimator.h"
+
+#include <cmath>
+
+#define OV_LOG_TAG "RtpBwe"
+
+// Number of the sent packets to keep until the feedback is received (power of 2)
+#define BWE_SENT_PACKET_HISTORY_SIZE (4096)
+
+// Packets sent within this interval belong to the same group (a burst of a frame)
+#define BWE_BURST_TIME_US (5 * 1000)
+// The delay state is reset if the delay between two groups changes more than this (e.g. the clock of the receiver jumped)
+#define BWE_MAX_DELAY_VARIATION_MS (3000.0)
+
+// Trendline filter
+#define BWE_TRENDLINE_WINDOW_SIZE (20)
+#define BWE_TRENDLINE_SMOOTHING_COEFFICIENT (0.9)
+#define BWE_TRENDLINE_THRESHOLD_GAIN (4.0)
+#define BWE_MAX_NUM_DELTAS (60)
+
+// Overuse detector (adaptive threshold)
+#define BWE_INITIAL_THRESHOLD (12.5)
+#define BWE_MIN_THRESHOLD (6.0)
+#define BWE_MAX_THRESHOLD (600.0)
+#define BWE_THRESHOLD_K_UP (0.0087)
+#define BWE_THRESHOLD_K_DOWN (0.039)
+#define BWE_OVERUSE_TIME_THRESHOLD_MS (10.0)
+
+// AIMD rate controller
+#define BWE_INCREASE_RATE_PER_SECOND (1.08)
+#define BWE_DECREASE_FACTOR (0.85)
+// Assumed round trip time, the estimate is decreased at most once in this interval
+#define BWE_DECREASE_INTERVAL_US (200 * 1000)
+// Measuring interval of the acknowledged throughput
+#define BWE_ACKED_BITRATE_WINDOW_US (500 * 1000)
+
+// Loss based control
+#define BWE_LOSS_HIGH_THRESHOLD (0.10)
+// The loss ratio is measured over at least this number of the reported packets (over several feedbacks if needed)
+#define BWE_MIN_PACKETS_FOR_LOSS (20)
+
+RtpBandwidthEstimator::RtpBandwidthEstimator(uint32_t initial_bitrate, uint32_t min_bitrate, uint32_t max_bitrate)
+	: _sent_packets(BWE_SENT_PACKET_HISTORY_SIZE),
+	  _threshold(BWE_INITIAL_THRESHOLD),
+	  _estimated_bitrate(initial_bitrate),
+	  _min_bitrate(min_bitrate),
+	  _max_bitrate(max_bitrate)
+{
+}
+
+void RtpBandwidthEstimator::OnPacketSent(uint16_t sequence_number, size_t size, int64_t send_time_us)
+{
+	auto &packet = _sent_packets[sequence_number & (BWE_SENT_PACKET_HISTORY_SIZE - 1)];
+
+	packet.is_valid = true;
+	packet.sequence_number = sequence_number;
+	packet.size = size;
+	packet.send_time_us = send_time_us;
+}
+
+bool RtpBandwidthEstimator::OnTransportFeedback(const RtcpTransportFeedback &feedback, int64_t now_us)
+{
+	size_t total_count = 0;
+	size_t lost_count = 0;
+
+	for (const auto &result : feedback.packet_results)
+	{
+		auto &packet = _sent_packets[result.sequence_number & (BWE_SENT_PACKET_HISTORY_SIZE - 1)];
+
+		if ((packet.is_valid == false) || (packet.sequence_number != result.sequence_number))
+		{
+			// Not sent by this session, or too old
+			continue;
+		}
+
+		total_count++;
+
+		if (result.received)
+		{
+			OnPacketArrived(packet.send_time_us, result.arrival_time_us, packet.size);
+
+			// A packet is reported as lost until it arrives, so it is not forgotten here
+			packet.is_valid = false;
+		}
+		else
+		{
+			lost_count++;
+		}
+	}
+
+	if (total_count == 0)
+	{
+		return false;
+	}
+
+	_loss_reported_count += total_count;
+	_loss_lost_count += lost_count;
+
+	double loss_ratio = 0.0;
+
+	if (_loss_reported_count >= BWE_MIN_PACKETS_FOR_LOSS)
+	{
+		loss_ratio = static_cast<double>(_loss_lost_count) / _loss_reported_count;
+
+		_loss_reported_count = 0;
+		_loss_lost_count = 0;
+	}
+
+	return UpdateEstimate(loss_ratio, now_us);
+}
+
+void RtpBandwidthEstimator::OnPacketArrived(int64_t send_time_us, int64_t arrival_time_us, size_t size)
+{
+	UpdateAckedBitrate(arrival_time_us, size);
+
+	if (_current_group.IsValid() == false)
+	{
+		_current_group.first_send_time_us = send_time_us;
+		_current_group.last_send_time_us = send_time_us;
+		_current_group.last_arrival_time_us = arrival_time_us;
+		return;
+	}
+
+	if (send_time_us < _current_group.first_send_time_us)
+	{
+		// Reordered packet
+		return;
+	}
+
+	if ((send_time_us - _current_group.first_send_time_us) <= BWE_BURST_TIME_US)
+	{
+		// Same group
+		_current_group.last_send_time_us = std::max(_current_group.last_send_time_us, send_time_us);
+		_current_group.last_arrival_time_us = std::max(_current_group.last_arrival_time_us, arrival_time_us);
+		return;
+	}
+
+	// A new group is started, so the current group is completed
+	if (_previous_group.IsValid())
+	{
+		double send_delta_ms = (_current_group.last_send_time_us - _previous_group.last_send_time_us) / 1000.0;
+		double arrival_delta_ms = (_current_group.last_arrival_time_us - _previous_group.last_arrival_time_us) / 1000.0;
+		double delay_variation_ms = arrival_delta_ms - send_delta_ms;
+
+		if (std::abs(delay_variation_ms) > BWE_MAX_DELAY_VARIATION_MS)
+		{
+			logtd("The delay is changed too much (%.1fms), reset the delay state", delay_variation_ms);
+			ResetDelayState();
+		}
+		else
+		{
+			UpdateTrendline(delay_variation_ms, send_delta_ms, _current_group.last_arrival_time_us / 1000);
+		}
+	}
+
+	_previous_group = _current_group;
+
+	_current_group.first_send_time_us = send_time_us;
+	_current_group.last_send_time_us = send_time_us;
+	_current_group.last_arrival_time_us = arrival_time_us;
+}
+
+void RtpBandwidthEstimator::UpdateAckedBitrate(int64_t arrival_time_us, size_t size)
+{
+	if ((_acked_window_start_us < 0) || (arrival_time_us < _acked_window_start_us))
+	{
+		_acked_window_start_us = arrival_time_us;
+		_acked_bytes_in_window = 0;
+	}
+
+	_acked_bytes_in_window += size;
+
+	int64_t elapsed_us = arrival_time_us - _acked_window_start_us;
+
+	if (elapsed_us >= BWE_ACKED_BITRATE_WINDOW_US)
+	{
+		auto bitrate = static_cast<uint32_t>(_acked_bytes_in_window * 8 * 1000000 / elapsed_us);
+
+		// Smooth the samples
+		_acked_bitrate = (_acked_bitrate == 0) ? bitrate : static_cast<uint32_t>(_acked_bitrate * 0.5 + bitrate * 0.5);
+
+		_acked_window_start_us = arrival_time_us;
+		_acked_bytes_in_window = 0;
+	}
+}
+
+void RtpBandwidthEstimator::UpdateTrendline(double delay_variation_ms, double send_delta_ms, int64_t arrival_time_ms)
+{
+	_num_deltas = std::min<size_t>(_num_deltas + 1, 1000);
+
+	_accumulated_delay += delay_variation_ms;
+	_smoothed_delay = BWE_TRENDLINE_SMOOTHING_COEFFICIENT * _smoothed_delay + (1.0 - BWE_TRENDLINE_SMOOTHING_COEFFICIENT) * _accumulated_delay;
+
+	if (_first_arrival_time_ms < 0)
+	{
+		_first_arrival_time_ms = arrival_time_ms;
+	}
+
+	_delay_history.emplace_back(static_cast<double>(arrival_time_ms - _first_arrival_time_ms), _smoothed_delay);
+
+	if (_delay_history.size() > BWE_TRENDLINE_WINDOW_SIZE)
+	{
+		_delay_history.pop_front();
+	}
+
+	double trend = _previous_trend;
+
+	if (_delay_history.size() == BWE_TRENDLINE_WINDOW_SIZE)
+	{
+		// Slope of the linear regression: sum((x - avg_x) * (y - avg_y)) / sum((x - avg_x)^2)
+		double sum_x = 0.0;
+		double sum_y = 0.0;
+
+		for (const auto &point : _delay_history)
+		{
+			sum_x += point.first;
+			sum_y += point.second;
+		}
+
+		double average_x = sum_x / _delay_history.size();
+		double average_y = sum_y / _delay_history.size();
+		double numerator = 0.0;
+		double denominator = 0.0;
+
+		for (const auto &point : _delay_history)
+		{
+			numerator += (point.first - average_x) * (point.second - average_y);
+			denominator += (point.first - average_x) * (point.first - average_x);
+		}
+
+		if (denominator != 0.0)
+		{
+			trend = numerator / denominator;
+		}
+	}
+
+	Detect(trend, send_delta_ms, arrival_time_ms);
+}
+
+void RtpBandwidthEstimator::Detect(double trend, double send_delta_ms, int64_t arrival_time_ms)
+{
+	if (_num_deltas < 2)
+	{
+		_usage = BandwidthUsage::Normal;
+		return;
+	}
+
+	double modified_trend = std::min<size_t>(_num_deltas, BWE_MAX_NUM_DELTAS) * trend * BWE_TRENDLINE_THRESHOLD_GAIN;
+
+	if (modified_trend > _threshold)
+	{
+		if (_time_over_using < 0.0)
+		{
+			// Initialize the timer, assuming that the overuse started at the middle of the groups
+			_time_over_using = send_delta_ms / 2.0;
+		}
+		else
+		{
+			_time_over_using += send_delta_ms;
+		}
+
+		_overuse_counter++;
+
+		if ((_time_over_using > BWE_OVERUSE_TIME_THRESHOLD_MS) && (_overuse_counter > 1) && (trend >= _previous_trend))
+		{
+			_time_over_using = 0.0;
+			_overuse_counter = 0;
+			_usage = BandwidthUsage::Overusing;
+		}
+	}
+	else if (modified_trend < -_threshold)
+	{
+		_time_over_using = -1.0;
+		_overuse_counter = 0;
+		_usage = BandwidthUsage::Underusing;
+	}
+	else
+	{
+		_time_over_using = -1.0;
+		_overuse_counter = 0;
+		_usage = BandwidthUsage::Normal;
+	}
+
+	_previous_trend = trend;
+
+	UpdateThreshold(modified_trend, arrival_time_ms);
+}
+
+void RtpBandwidthEstimator::UpdateThreshold(double modified_trend, int64_t arrival_time_ms)
+{
+	if (_last_threshold_update_ms < 0)
+	{
+		_last_threshold_update_ms = arrival_time_ms;
+	}
+
+	double absolute_trend = std::abs(modified_trend);
+
+	if (absolute_trend > _threshold + 15.0)
+	{
+		// Do not adapt to a spike (e.g. a sudden change of the route)
+		_last_threshold_update_ms = arrival_time_ms;
+		return;
+	}
+
+	double k = (absolute_trend < _threshold) ? BWE_THRESHOLD_K_DOWN : BWE_THRESHOLD_K_UP;
+	int64_t time_delta_ms = std::min<int64_t>(arrival_time_ms - _last_threshold_update_ms, 100);
+
+	_threshold += k * (absolute_trend - _threshold) * time_delta_ms;
+	_threshold = std::max(BWE_MIN_THRESHOLD, std::min(_threshold, BWE_MAX_THRESHOLD));
+
+	_last_threshold_update_ms = arrival_time_ms;
+}
+
+bool RtpBandwidthEstimator::UpdateEstimate(double loss_ratio, int64_t now_us)
+{
+	uint32_t previous_bitrate = _estimated_bitrate;
+	double bitrate = _estimated_bitrate;
+
+	if (_last_update_us < 0)
+	{
+		_last_update_us = now_us;
+	}
+
+	double elapsed_seconds = std::min((now_us - _last_update_us) / 1000000.0, 1.0);
+	_last_update_us = now_us;
+
+	switch (_usage)
+	{
+		case BandwidthUsage::Normal:
+			if (_rate_control_state == RateControlState::Hold)
+			{
+				_rate_control_state = RateControlState::Increase;
+			}
+			break;
+
+		case BandwidthUsage::Overusing:
+			_rate_control_state = RateControlState::Decrease;
+			break;
+
+		case BandwidthUsage::Underusing:
+			// The queues of the link are being drained
+			_rate_control_state = RateControlState::Hold;
+			break;
+	}
+
+	bool can_decrease = (_last_decrease_us < 0) || ((now_us - _last_decrease_us) >= BWE_DECREASE_INTERVAL_US);
+
+	switch (_rate_control_state)
+	{
+		case RateControlState::Increase:
+			bitrate *= std::pow(BWE_INCREASE_RATE_PER_SECOND, elapsed_seconds);
+
+			if (_acked_bitrate > 0)
+			{
+				// Do not increase too far from the throughput that is actually delivered
+				bitrate = std::min(bitrate, _acked_bitrate * 1.5 + 10000.0);
+			}
+
+			bitrate = std::max(bitrate, static_cast<double>(_estimated_bitrate));
+			break;
+
+		case RateControlState::Decrease:
+			if (can_decrease)
+			{
+				double decreased = BWE_DECREASE_FACTOR * ((_acked_bitrate > 0) ? _acked_bitrate : _estimated_bitrate);
+
+				bitrate = std::min(bitrate, decreased);
+
+				_last_decrease_us = now_us;
+				can_decrease = false;
+			}
+
+			_rate_control_state = RateControlState::Hold;
+			break;
+
+		case RateControlState::Hold:
+			break;
+	}
+
+	if ((loss_ratio > BWE_LOSS_HIGH_THRESHOLD) && can_decrease)
+	{
+		bitrate *= (1.0 - 0.5 * loss_ratio);
+		_last_decrease_us = now_us;
+	}
+
+	_estimated_bitrate = static_cast<uint32_t>(std::max<double>(_min_bitrate, std::min<double>(bitrate, _max_bitrate)));
+
+	if (_estimated_bitrate != previous_bitrate)
+	{
+		logtd("Estimated bitrate: %u -> %u bps (acked: %u bps, loss: %.1f%%, threshold: %.1f)",
+			  previous_bitrate, _estimated_bitrate, _acked_bitrate, loss_ratio * 100.0, _threshold);
+
+		return true;
+	}
+
+	return false;
+}
+
+void RtpBandwidthEstimator::ResetDelayState()
+{
+	_current_group = PacketGroup();
+	_previous_group = PacketGroup();
+
+	_num_deltas = 0;
+	_accumulated_delay = 0.0;
+	_smoothed_delay = 0.0;
+	_first_arrival_time_ms = -1;
+	_delay_history.clear();
+
+	_time_over_using = -1.0;
+	_overuse_counter = 0;
+	_previous_trend = 0.0;
+	_usage = BandwidthUsage::Normal;
+}
@@ -0,0 +1,135 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <deque>
+
+#include "rtcp_packet.h"
+
+// Delay-based bandwidth estimation using the transport-wide feedback (draft-ietf-rmcat-gcc-02)
+//
+// The packets are grouped by the send time (a burst of packets of a frame), and the variation of the one-way delay
+// between the groups is accumulated and smoothed. The slope (trend) of the delay over a window is compared to
+// an adaptive threshold to detect overuse of the link, then the estimate is controlled by AIMD.
+// The loss ratio reported by the feedback also limits the estimate.
+//
+// All the times are in microseconds, and not thread-safe.
+class RtpBandwidthEstimator
+{
+public:
+	RtpBandwidthEstimator(uint32_t initial_bitrate, uint32_t min_bitrate, uint32_t max_bitrate);
+
+	// Called when a packet with the transport-wide sequence number is sent
+	void OnPacketSent(uint16_t sequence_number, size_t size, int64_t send_time_us);
+
+	// Returns true if the estimate is changed
+	bool OnTransportFeedback(const RtcpTransportFeedback &feedback, int64_t now_us);
+
+	// bps
+	uint32_t GetEstimatedBitrate() const
+	{
+		return _estimated_bitrate;
+	}
+
+	// Throughput acknowledged by the receiver (bps), 0 if it is not measured yet
+	uint32_t GetAckedBitrate() const
+	{
+		return _acked_bitrate;
+	}
+
+private:
+	enum class BandwidthUsage : int8_t
+	{
+		Normal,
+		Underusing,
+		Overusing
+	};
+
+	enum class RateControlState : int8_t
+	{
+		Hold,
+		Increase,
+		Decrease
+	};
+
+	struct SentPacket
+	{
+		bool is_valid = false;
+		uint16_t sequence_number = 0;
+		size_t size = 0;
+		int64_t send_time_us = 0;
+	};
+
+	struct PacketGroup
+	{
+		bool IsValid() const
+		{
+			return first_send_time_us >= 0;
+		}
+
+		int64_t first_send_time_us = -1;
+		int64_t last_send_time_us = 0;
+		int64_t last_arrival_time_us = 0;
+	};
+
+	void OnPacketArrived(int64_t send_time_us, int64_t arrival_time_us, size_t size);
+	void UpdateAckedBitrate(int64_t arrival_time_us, size_t size);
+
+	// delay_variation_ms: (arrival delta - send delta) of two groups
+	void UpdateTrendline(double delay_variation_ms, double send_delta_ms, int64_t arrival_time_ms);
+	void Detect(double trend, double send_delta_ms, int64_t arrival_time_ms);
+	void UpdateThreshold(double modified_trend, int64_t arrival_time_ms);
+
+	bool UpdateEstimate(double loss_ratio, int64_t now_us);
+
+	void ResetDelayState();
+
+	// Sent packets, indexed by the transport-wide sequence number
+	std::vector<SentPacket> _sent_packets;
+
+	// Inter-arrival
+	PacketGroup _current_group;
+	PacketGroup _previous_group;
+
+	// Trendline filter
+	size_t _num_deltas = 0;
+	double _accumulated_delay = 0.0;
+	double _smoothed_delay = 0.0;
+	int64_t _first_arrival_time_ms = -1;
+	// (arrival time, smoothed delay)
+	std::deque<std::pair<double, double>> _delay_history;
+
+	// Overuse detector
+	double _threshold;
+	int64_t _last_threshold_update_ms = -1;
+	double _time_over_using = -1.0;
+	int _overuse_counter = 0;
+	double _previous_trend = 0.0;
+	BandwidthUsage _usage = BandwidthUsage::Normal;
+
+	// Acknowledged throughput
+	int64_t _acked_window_start_us = -1;
+	size_t _acked_bytes_in_window = 0;
+	uint32_t _acked_bitrate = 0;
+
+	// Loss of the packets reported since the last loss ratio
+	// (a feedback of a low bitrate session reports only a few packets)
+	size_t _loss_reported_count = 0;
+	size_t _loss_lost_count = 0;
+
+	// AIMD rate controller
+	RateControlState _rate_control_state = RateControlState::Hold;
+	int64_t _last_update_us = -1;
+	int64_t _last_decrease_us = -1;
+
+	uint32_t _estimated_bitrate;
+	uint32_t _min_bitrate;
+	uint32_t _max_bitrate;
+};
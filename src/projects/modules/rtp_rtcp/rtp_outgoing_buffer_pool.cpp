@@ -0,0 +1,39 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "rtp_outgoing_buffer_pool.h"
+
+RtpOutgoingBufferPool::RtpOutgoingBufferPool(size_t max_count)
+	: _max_count(max_count)
+{
+}
+
+std::shared_ptr<ov::Data> RtpOutgoingBufferPool::GetBuffer(size_t capacity)
+{
+	for (auto &buffer : _buffer_list)
+	{
+		if (buffer.use_count() == 1)
+		{
+			if (buffer->GetCapacity() < capacity)
+			{
+				buffer = std::make_shared<ov::Data>(capacity);
+			}
+
+			return buffer;
+		}
+	}
+
+	// All the buffers are waiting to be sent
+	auto buffer = std::make_shared<ov::Data>(capacity);
+
+	if (_buffer_list.size() < _max_count)
+	{
+		_buffer_list.push_back(buffer);
+	}
+
+	return buffer;
+}
@@ -0,0 +1,30 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+// Writable buffers of a session, into which the packets shared by all the sessions are copied
+// (The lower nodes like SRTP modify the packet in place).
+//
+// A buffer that is passed to the lower node can still be queued after SendData() returns
+// (ClientSocket's send queue, ov::DatagramSendBatch), so a buffer is reused only when nobody else references it.
+// Not thread-safe: the packets of a session are sent by one thread at a time.
+class RtpOutgoingBufferPool
+{
+public:
+	// max_count: Number of the buffers to keep (More buffers are allocated if they are all in use, but not kept)
+	explicit RtpOutgoingBufferPool(size_t max_count);
+
+	// Returns a buffer that can hold capacity bytes, and is not referenced by anyone
+	std::shared_ptr<ov::Data> GetBuffer(size_t capacity);
+
+private:
+	size_t _max_count;
+	std::vector<std::shared_ptr<ov::Data>> _buffer_list;
+};
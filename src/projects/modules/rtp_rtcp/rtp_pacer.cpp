@@ -0,0 +1,209 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "rtp_pacer.h"
+
+#include <base/publisher/stream_worker_pool.h>
+
+#include <thread>
+
+#define OV_LOG_TAG "RtpPacer"
+
+// The packets are sent faster than the estimate, to drain the queue quickly after a burst (key frame)
+#define RTP_PACER_PACING_FACTOR (2.5)
+// Maximum burst, in time of the pacing rate
+#define RTP_PACER_MAX_BURST_US (20 * 1000)
+// Allow at least a few packets to be sent in a burst
+#define RTP_PACER_MIN_BURST_BYTES (2 * 1500)
+// A packet that waits longer than this is sent regardless of the budget
+#define RTP_PACER_MAX_QUEUE_TIME_US (500 * 1000)
+// Measuring interval of the media bitrate
+#define RTP_PACER_MEDIA_BITRATE_WINDOW_US (1000 * 1000)
+
+// Interval of the scheduler (in milliseconds)
+#define RTP_PACER_SCHEDULER_INTERVAL (5)
+
+RtpPacer::RtpPacer(uint32_t initial_bitrate, uint32_t min_bitrate)
+	: _estimated_bitrate(initial_bitrate),
+	  _min_bitrate(min_bitrate)
+{
+	UpdatePacingRate();
+}
+
+void RtpPacer::SetEstimatedBitrate(uint32_t bitrate)
+{
+	_estimated_bitrate = bitrate;
+
+	UpdatePacingRate();
+}
+
+void RtpPacer::UpdatePacingRate()
+{
+	auto pacing_rate = std::max(_estimated_bitrate, _min_bitrate) * RTP_PACER_PACING_FACTOR;
+
+	// Even if the estimate is lower than the bitrate of the media, the media should not be delayed indefinitely
+	// (the queue would grow until RTP_PACER_MAX_QUEUE_TIME_US releases the packets in a burst)
+	_pacing_rate = static_cast<uint32_t>(std::max<double>(pacing_rate, _media_bitrate));
+}
+
+void RtpPacer::UpdateBudget(int64_t now_us)
+{
+	if (_last_update_us < 0)
+	{
+		_last_update_us = now_us;
+		// Allow the first burst
+		_budget = RTP_PACER_MIN_BURST_BYTES;
+		return;
+	}
+
+	int64_t elapsed_us = now_us - _last_update_us;
+
+	if (elapsed_us <= 0)
+	{
+		return;
+	}
+
+	_last_update_us = now_us;
+
+	double max_budget = std::max<double>(RTP_PACER_MIN_BURST_BYTES, _pacing_rate / 8.0 * RTP_PACER_MAX_BURST_US / 1000000.0);
+
+	_budget = std::min(max_budget, _budget + (_pacing_rate / 8.0 * elapsed_us / 1000000.0));
+}
+
+void RtpPacer::Push(const std::shared_ptr<const ov::Data> &packet, int64_t now_us)
+{
+	_queue.push_back({packet, now_us});
+	_queued_bytes += packet->GetLength();
+
+	// Measure the bitrate of the media
+	if ((_media_window_start_us < 0) || (now_us < _media_window_start_us))
+	{
+		_media_window_start_us = now_us;
+		_media_bytes_in_window = 0;
+	}
+
+	_media_bytes_in_window += packet->GetLength();
+
+	int64_t elapsed_us = now_us - _media_window_start_us;
+
+	if (elapsed_us >= RTP_PACER_MEDIA_BITRATE_WINDOW_US)
+	{
+		_media_bitrate = static_cast<uint32_t>(_media_bytes_in_window * 8 * 1000000 / elapsed_us);
+		_media_window_start_us = now_us;
+		_media_bytes_in_window = 0;
+
+		UpdatePacingRate();
+	}
+}
+
+std::shared_ptr<const ov::Data> RtpPacer::Pop(int64_t now_us)
+{
+	if (_queue.empty())
+	{
+		return nullptr;
+	}
+
+	UpdateBudget(now_us);
+
+	auto &front = _queue.front();
+
+	if ((_budget <= 0.0) && ((now_us - front.enqueued_time_us) < RTP_PACER_MAX_QUEUE_TIME_US))
+	{
+		return nullptr;
+	}
+
+	auto packet = std::move(front.packet);
+	_queue.pop_front();
+
+	_queued_bytes -= packet->GetLength();
+	_budget -= packet->GetLength();
+
+	return packet;
+}
+
+void RtpPacer::Consume(size_t bytes, int64_t now_us)
+{
+	UpdateBudget(now_us);
+
+	_budget -= bytes;
+}
+
+RtpPacerScheduler *RtpPacerScheduler::GetInstance()
+{
+	// Never released, because the sessions can be scheduled while the static objects are being destroyed
+	static auto instance = new RtpPacerScheduler();
+
+	return instance;
+}
+
+RtpPacerScheduler::RtpPacerScheduler()
+{
+	auto shard_count = std::max(std::thread::hardware_concurrency(), 1U);
+
+	for (uint32_t index = 0; index < shard_count; index++)
+	{
+		_shard_list.push_back(std::make_unique<Shard>());
+	}
+}
+
+void RtpPacerScheduler::Schedule(const std::shared_ptr<RtpPacerTask> &task)
+{
+	auto core_index = pub::StreamWorkerPool::GetCurrentCoreIndex();
+	size_t shard_index;
+
+	if (core_index >= 0)
+	{
+		shard_index = static_cast<size_t>(core_index) % _shard_list.size();
+	}
+	else
+	{
+		// Not a stream worker (e.g. the stream is not sharded), so spread the sessions
+		shard_index = std::hash<RtpPacerTask *>()(task.get()) % _shard_list.size();
+	}
+
+	auto shard = _shard_list[shard_index].get();
+
+	std::call_once(shard->start_flag, [this, shard]() {
+		shard->timer.Push(std::bind(&RtpPacerScheduler::OnTimer, this, shard), RTP_PACER_SCHEDULER_INTERVAL);
+		shard->timer.Start();
+	});
+
+	std::lock_guard<std::mutex> lock(shard->task_list_mutex);
+
+	shard->task_list.push_back(task);
+}
+
+ov::DelayQueueAction RtpPacerScheduler::OnTimer(Shard *shard)
+{
+	std::vector<std::weak_ptr<RtpPacerTask>> task_list;
+
+	{
+		std::lock_guard<std::mutex> lock(shard->task_list_mutex);
+		task_list.swap(shard->task_list);
+	}
+
+	std::vector<std::weak_ptr<RtpPacerTask>> pending_task_list;
+
+	for (auto &weak_task : task_list)
+	{
+		auto task = weak_task.lock();
+
+		if ((task != nullptr) && task->ProcessPacer())
+		{
+			pending_task_list.push_back(task);
+		}
+	}
+
+	if (pending_task_list.empty() == false)
+	{
+		std::lock_guard<std::mutex> lock(shard->task_list_mutex);
+
+		shard->task_list.insert(shard->task_list.end(), pending_task_list.begin(), pending_task_list.end());
+	}
+
+	return ov::DelayQueueAction::Repeat;
+}
@@ -0,0 +1,121 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Smooths the outgoing packets of a session with a token bucket
+//
+// Sending a key frame (tens of packets) in a burst overflows the queue of a bottleneck and causes losses,
+// so the packets are sent at a rate that is a multiple of the estimated bandwidth.
+// The rate never goes below the bitrate of the media, since the packets are never dropped:
+// the estimate can only take away the burst margin, not slow the media down.
+// The packets are never dropped, and a packet that waits too long is sent regardless of the budget.
+//
+// Not thread-safe (the owner serializes the calls)
+class RtpPacer
+{
+public:
+	RtpPacer(uint32_t initial_bitrate, uint32_t min_bitrate);
+
+	// bps
+	void SetEstimatedBitrate(uint32_t bitrate);
+	uint32_t GetPacingRate() const
+	{
+		return _pacing_rate;
+	}
+
+	void Push(const std::shared_ptr<const ov::Data> &packet, int64_t now_us);
+
+	// Returns the packet that can be sent now, or nullptr if the queue is empty or the budget is exhausted
+	std::shared_ptr<const ov::Data> Pop(int64_t now_us);
+
+	// The packets that are sent without being queued (e.g. retransmissions) also consume the budget
+	void Consume(size_t bytes, int64_t now_us);
+
+	bool IsEmpty() const
+	{
+		return _queue.empty();
+	}
+
+	size_t GetQueuedBytes() const
+	{
+		return _queued_bytes;
+	}
+
+private:
+	struct QueuedPacket
+	{
+		std::shared_ptr<const ov::Data> packet;
+		int64_t enqueued_time_us;
+	};
+
+	void UpdateBudget(int64_t now_us);
+	void UpdatePacingRate();
+
+	std::deque<QueuedPacket> _queue;
+	size_t _queued_bytes = 0;
+
+	// Bytes that can be sent now (negative if the packets are sent in excess)
+	double _budget = 0.0;
+	int64_t _last_update_us = -1;
+
+	uint32_t _estimated_bitrate;
+	uint32_t _min_bitrate;
+	uint32_t _pacing_rate = 0;
+
+	// Bitrate of the media pushed into the pacer
+	int64_t _media_window_start_us = -1;
+	size_t _media_bytes_in_window = 0;
+	uint32_t _media_bitrate = 0;
+};
+
+class RtpPacerTask
+{
+public:
+	virtual ~RtpPacerTask() = default;
+
+	// Sends the queued packets as much as the budget allows
+	// Returns true if there are packets left in the queue
+	virtual bool ProcessPacer() = 0;
+};
+
+// Sends the queued packets of the sessions periodically
+//
+// The packets are usually sent by the thread that pushes them, and only the sessions that have packets left
+// in the queue (the budget is exhausted) are scheduled.
+// There is a timer for each core, and a session is scheduled to the timer of the core of the stream worker
+// that sends its packets (See pub::StreamWorkerPool), so the sessions of a core do not wait for the others.
+class RtpPacerScheduler
+{
+public:
+	static RtpPacerScheduler *GetInstance();
+
+	void Schedule(const std::shared_ptr<RtpPacerTask> &task);
+
+protected:
+	struct Shard
+	{
+		std::mutex task_list_mutex;
+		std::vector<std::weak_ptr<RtpPacerTask>> task_list;
+
+		std::once_flag start_flag;
+		ov::DelayQueue timer;
+	};
+
+	RtpPacerScheduler();
+
+	ov::DelayQueueAction OnTimer(Shard *shard);
+
+	std::vector<std::unique_ptr<Shard>> _shard_list;
+};
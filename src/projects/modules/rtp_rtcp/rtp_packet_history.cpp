@@ -0,0 +1,59 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "rtp_packet_history.h"
+
+RtpPacketHistory::RtpPacketHistory(size_t size)
+{
+	// Up to 65536 entries, since the index is derived from the 16-bit sequence number
+	size_t capacity = 1;
+
+	while((capacity < size) && (capacity < 65536))
+	{
+		capacity <<= 1;
+	}
+
+	_entries.resize(capacity);
+	_index_mask = capacity - 1;
+}
+
+void RtpPacketHistory::Put(uint16_t sequence_number, const std::shared_ptr<const ov::Data> &packet)
+{
+	auto &entry = _entries[sequence_number & _index_mask];
+
+	entry.packet = packet;
+	entry.sequence_number = sequence_number;
+	entry.sent_time = std::chrono::steady_clock::now();
+	entry.retransmitted_time = std::chrono::steady_clock::time_point();
+}
+
+std::shared_ptr<const ov::Data> RtpPacketHistory::GetForRetransmission(uint16_t sequence_number, int64_t max_age_ms, int64_t min_interval_ms)
+{
+	auto &entry = _entries[sequence_number & _index_mask];
+
+	if((entry.packet == nullptr) || (entry.sequence_number != sequence_number))
+	{
+		return nullptr;
+	}
+
+	auto now = std::chrono::steady_clock::now();
+
+	if(std::chrono::duration_cast<std::chrono::milliseconds>(now - entry.sent_time).count() > max_age_ms)
+	{
+		return nullptr;
+	}
+
+	if((entry.retransmitted_time != std::chrono::steady_clock::time_point()) &&
+	   (std::chrono::duration_cast<std::chrono::milliseconds>(now - entry.retransmitted_time).count() < min_interval_ms))
+	{
+		return nullptr;
+	}
+
+	entry.retransmitted_time = now;
+
+	return entry.packet;
+}
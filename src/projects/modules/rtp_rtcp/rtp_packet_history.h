@@ -0,0 +1,45 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <chrono>
+
+// Recently sent RTP packets of a SSRC, to retransmit the packets that are requested by NACK
+//
+// The packets are kept in a ring indexed by the sequence number, so the history is bounded by its size
+// (an old packet is overwritten by a new packet that has the same index).
+// The history holds the packets that are shared by all the sessions of a stream, so it doesn't copy the packets.
+class RtpPacketHistory
+{
+public:
+	// size: Number of the packets to keep (rounded up to a power of 2)
+	explicit RtpPacketHistory(size_t size);
+
+	void Put(uint16_t sequence_number, const std::shared_ptr<const ov::Data> &packet);
+
+	// Returns the packet to retransmit, or nullptr if:
+	//  - the packet is not in the history (not sent yet, or overwritten)
+	//  - the packet was sent more than max_age_ms ago
+	//  - the packet was already retransmitted within min_interval_ms (NACKs for the same packet are repeated until it arrives)
+	std::shared_ptr<const ov::Data> GetForRetransmission(uint16_t sequence_number, int64_t max_age_ms, int64_t min_interval_ms);
+
+private:
+	struct Entry
+	{
+		std::shared_ptr<const ov::Data> packet;
+		uint16_t sequence_number = 0;
+		std::chrono::steady_clock::time_point sent_time;
+		// time_point() if the packet is not retransmitted yet
+		std::chrono::steady_clock::time_point retransmitted_time;
+	};
+
+	std::vector<Entry> _entries;
+	size_t _index_mask;
+};
@@ -52,11 +52,12 @@ void RtpPacketizer::SetCsrcs(const std::vector<uint32_t> &csrcs)
 	_csrcs = csrcs;
 }
 
-void RtpPacketizer::SetUlpfec(uint8_t red_payload_type, uint8_t ulpfec_payload_type)
+void RtpPacketizer::SetUlpfec(uint8_t red_payload_type, uint8_t ulpfec_payload_type, UlpfecMaskType mask_type)
 {
 	_ulpfec_enabled = true;
 	_red_payload_type = red_payload_type;
 	_ulpfec_payload_type = ulpfec_payload_type;
+	_ulpfec_generator.SetMaskType(mask_type);
 }
 
 bool RtpPacketizer::Packetize(FrameType frame_type,
@@ -14,7 +14,7 @@ public:
 
 	void SetVideoCodec(RtpVideoCodecType codec_type);
 	void SetAudioCodec(RtpAudioCodecType codec_type);
-	void SetUlpfec(uint8_t _red_payload_type, uint8_t _ulpfec_payload_type);
+	void SetUlpfec(uint8_t _red_payload_type, uint8_t _ulpfec_payload_type, UlpfecMaskType mask_type = UlpfecMaskType::Consecutive);
 	void SetPayloadType(uint8_t payload_type);
 	void SetSSRC(uint32_t ssrc);
 	void SetCsrcs(const std::vector<uint32_t> &csrcs);
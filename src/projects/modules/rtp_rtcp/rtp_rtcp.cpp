@@ -5,22 +5,133 @@
 
 #define OV_LOG_TAG "RtpRtcp"
 #define RTCP_AA_SEND_SEQUENCE (30)
+// Room for the trailer of SRTP (auth tag, MKI)
+#define RTP_RTCP_OUTGOING_BUFFER_MARGIN (32)
+// Enough for the packets of a session that can be queued at once (ClientSocket send queue, ov::DatagramSendBatch)
+#define RTP_RTCP_MAX_OUTGOING_BUFFER_COUNT (16)
+
+// Number of the sent packets to keep for each SSRC (should not exceed the replay window of SRTP)
+#define RTP_RTCP_PACKET_HISTORY_SIZE (1024)
+// A packet older than this is not retransmitted, since it is too late to be played
+#define RTP_RTCP_RETRANSMISSION_MAX_AGE (1000)
+// Ignore NACKs for a packet that has just been retransmitted (the receiver repeats NACKs until the packet arrives)
+#define RTP_RTCP_RETRANSMISSION_MIN_INTERVAL (20)
+// Retransmissions of a session are limited to (RATIO)% of the bytes sent in the previous window
+#define RTP_RTCP_RETRANSMISSION_WINDOW (1000)
+#define RTP_RTCP_RETRANSMISSION_MAX_RATIO (25)
+// Budget for the first window, or a stream with low bitrate
+#define RTP_RTCP_RETRANSMISSION_MIN_BUDGET (32 * 1024)
+// Original sequence number (OSN) field of RTX
+#define RTX_OSN_SIZE (2)
+
+// One-byte header extension (RFC 8285) that contains only the transport-wide sequence number
+//  0                   1                   2                   3
+//  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// |       0xBE    |    0xDE       |           length=1            |
+// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// |  ID   | L=1   |transport-wide sequence number | zero padding  |
+// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+#define TRANSPORT_CC_EXTENSION_SIZE (8)
+#define RTP_ONE_BYTE_EXTENSION_PROFILE (0xBEDE)
+
+// Bandwidth estimation (bps)
+#define RTP_RTCP_INITIAL_BITRATE (2500 * 1000)
+#define RTP_RTCP_MIN_BITRATE (100 * 1000)
+#define RTP_RTCP_MAX_BITRATE (50 * 1000 * 1000)
+
+// Length of the payload except CSRCs, the header extension and the padding (RFC 3550 5.1)
+// Returns false if the packet is malformed
+static bool GetRtpPayloadLength(const uint8_t *packet, size_t length, size_t &payload_length)
+{
+	size_t header_size = FIXED_HEADER_SIZE + (packet[0] & 0x0F) * 4;
+
+	if(packet[0] & 0x10)
+	{
+		// Extension header: profile (16 bits) + length in 32-bit words (16 bits)
+		if(length < header_size + 4)
+		{
+			return false;
+		}
+
+		header_size += 4 + ByteReader<uint16_t>::ReadBigEndian(&packet[header_size + 2]) * 4;
+	}
+
+	// The last octet of the padding is the number of the padding octets
+	size_t padding_size = (packet[0] & 0x20) ? packet[length - 1] : 0;
+
+	if(length < header_size + padding_size)
+	{
+		return false;
+	}
+
+	payload_length = length - header_size - padding_size;
+
+	return true;
+}
+
+static int64_t GetCurrentTimeUs()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
 RtpRtcp::RtpRtcp(uint32_t id, std::shared_ptr<pub::Session> session, const std::vector<uint32_t> &ssrc_list)
-	        : SessionNode(id, pub::SessionNodeType::Rtp, session)
+	        : SessionNode(id, pub::SessionNodeType::Rtp, session),
+	          _bandwidth_estimator(RTP_RTCP_INITIAL_BITRATE, RTP_RTCP_MIN_BITRATE, RTP_RTCP_MAX_BITRATE),
+	          _pacer(RTP_RTCP_INITIAL_BITRATE, RTP_RTCP_MIN_BITRATE),
+	          _outgoing_buffer_pool(RTP_RTCP_MAX_OUTGOING_BUFFER_COUNT)
 {
     for(auto ssrc : ssrc_list)
     {
         auto rtcp_generator = std::make_shared<RtcpSRGenerator>(ssrc);
         _rtcp_sr_generators[ssrc] = rtcp_generator;
     }
+
+	_retransmission_budget = RTP_RTCP_RETRANSMISSION_MIN_BUDGET;
+	_retransmission_window.Start();
 }
 
 RtpRtcp::~RtpRtcp()
 {
 }
 
-bool RtpRtcp::SendOutgoingData(const std::shared_ptr<ov::Data> &packet)
+void RtpRtcp::EnableRetransmission(uint32_t ssrc, uint32_t rtx_ssrc, const std::map<uint8_t, uint8_t> &rtx_payload_types)
+{
+	auto &context = _retransmission_map[ssrc];
+
+	context.history = std::make_shared<RtpPacketHistory>(RTP_RTCP_PACKET_HISTORY_SIZE);
+	context.rtx_ssrc = rtx_ssrc;
+	context.rtx_payload_types = rtx_payload_types;
+	context.rtx_sequence_number = static_cast<uint16_t>(ov::Random::GenerateUInt32(0, UINT16_MAX));
+}
+
+void RtpRtcp::EnableTransportCc(uint32_t ssrc, uint8_t extension_id)
+{
+	// One-byte header: 1 ~ 14
+	if((extension_id == 0) || (extension_id > 14))
+	{
+		logtw("Invalid transport-cc extension id: %d (ssrc: %u)", extension_id, ssrc);
+		return;
+	}
+
+	_transport_cc_extension_ids[ssrc] = extension_id;
+
+	// RTX packets are sent with the transport-wide sequence number too
+	auto retransmission = _retransmission_map.find(ssrc);
+	if((retransmission != _retransmission_map.end()) && (retransmission->second.rtx_ssrc != 0))
+	{
+		_transport_cc_extension_ids[retransmission->second.rtx_ssrc] = extension_id;
+	}
+}
+
+uint32_t RtpRtcp::GetEstimatedBitrate()
+{
+	std::lock_guard<std::mutex> lock(_send_mutex);
+
+	return _bandwidth_estimator.GetEstimatedBitrate();
+}
+
+bool RtpRtcp::SendOutgoingData(const std::shared_ptr<const ov::Data> &packet)
 {
 	// Lower Node is SRTP
 	auto node = GetLowerNode();
@@ -29,36 +140,188 @@ bool RtpRtcp::SendOutgoingData(const std::shared_ptr<ov::Data> &packet)
 		return false;
 	}
 
-    RtpPacket rtp_packet(packet);
+	// Parse only the fields that are needed instead of using RtpPacket, because RtpPacket makes the buffer writable (copy)
+	if(packet->GetLength() < FIXED_HEADER_SIZE)
+	{
+		return false;
+	}
 
-    // Parsing error
-	if(rtp_packet.Buffer() == nullptr)
-    {
-        return false;
-    }
+	auto buffer = packet->GetDataAs<uint8_t>();
+	if((buffer[0] >> 6) != RTP_VERSION)
+	{
+		return false;
+	}
+
+	size_t payload_length = 0;
+	if(GetRtpPayloadLength(buffer, packet->GetLength(), payload_length) == false)
+	{
+		return false;
+	}
+
+	auto sequence_number = ByteReader<uint16_t>::ReadBigEndian(&buffer[2]);
+	auto timestamp = ByteReader<uint32_t>::ReadBigEndian(&buffer[4]);
+	auto ssrc = ByteReader<uint32_t>::ReadBigEndian(&buffer[8]);
 
-    if(_rtcp_sr_generators.find(rtp_packet.Ssrc()) == _rtcp_sr_generators.end())
+	std::lock_guard<std::mutex> lock(_send_mutex);
+
+    auto item = _rtcp_sr_generators.find(ssrc);
+    if(item == _rtcp_sr_generators.end())
     {
         return false;
     }
-    
-    auto rtcp_sr_generator = _rtcp_sr_generators[rtp_packet.Ssrc()];
-    
-    rtcp_sr_generator->AddRTPPacketAndGenerateRtcpSR(rtp_packet);
+
+    auto &rtcp_sr_generator = item->second;
+
+    rtcp_sr_generator->AddRTPPacketAndGenerateRtcpSR(timestamp, payload_length);
     if(rtcp_sr_generator->IsAvailableRtcpSRPacket())
     {
         auto rtcp_sr_packet = rtcp_sr_generator->PopRtcpSRPacket();
         if(!node->SendData(pub::SessionNodeType::Rtcp, rtcp_sr_packet))
         {
-            logtd("Send RTCP failed : ssrc(%u)", rtp_packet.Ssrc());
+            logtd("Send RTCP failed : ssrc(%u)", ssrc);
         }
 		else
 		{
-			logtd("Send RTCP succeed : ssrc(%u) length(%d)", rtp_packet.Ssrc(), rtcp_sr_packet->GetLength());
+			logtd("Send RTCP succeed : ssrc(%u) length(%d)", ssrc, rtcp_sr_packet->GetLength());
 		}
     }
 
-	if(!node->SendData(pub::SessionNodeType::Rtp, packet))
+	auto retransmission = _retransmission_map.find(ssrc);
+	if(retransmission != _retransmission_map.end())
+	{
+		// The shared packet is kept as it is, so the history doesn't copy the packet
+		retransmission->second.history->Put(sequence_number, packet);
+	}
+
+	// The window is rolled here, since the retransmissions can be absent for a long time
+	RollRetransmissionWindow();
+	_sent_bytes_in_window += packet->GetLength();
+
+	// The packets are sent through the pacer to avoid bursts (most of them are sent immediately)
+	_pacer.Push(packet, GetCurrentTimeUs());
+	SendPacedPackets(node);
+
+	return true;
+}
+
+void RtpRtcp::SendPacedPackets(const std::shared_ptr<pub::SessionNode> &node)
+{
+	auto now = GetCurrentTimeUs();
+
+	while(true)
+	{
+		auto packet = _pacer.Pop(now);
+
+		if(packet == nullptr)
+		{
+			break;
+		}
+
+		SendRtpPacket(node, packet);
+	}
+
+	if((_pacer.IsEmpty() == false) && (_pacer_scheduled == false))
+	{
+		// The rest of the packets are sent by RtpPacerScheduler
+		auto task = GetSharedPtrAs<RtpPacerTask>();
+
+		if(task != nullptr)
+		{
+			_pacer_scheduled = true;
+			RtpPacerScheduler::GetInstance()->Schedule(task);
+		}
+	}
+}
+
+bool RtpRtcp::ProcessPacer()
+{
+	std::lock_guard<std::mutex> lock(_send_mutex);
+
+	auto node = GetLowerNode();
+
+	if((node == nullptr) || (GetState() == SessionNode::NodeState::Stopped))
+	{
+		_pacer_scheduled = false;
+		return false;
+	}
+
+	SendPacedPackets(node);
+
+	_pacer_scheduled = (_pacer.IsEmpty() == false);
+
+	return _pacer_scheduled;
+}
+
+uint8_t RtpRtcp::GetTransportCcExtensionId(const uint8_t *packet)
+{
+	if(_transport_cc_extension_ids.empty() || (packet[0] & 0x10))
+	{
+		// Disabled, or the packet already has a header extension
+		return 0;
+	}
+
+	auto item = _transport_cc_extension_ids.find(ByteReader<uint32_t>::ReadBigEndian(&packet[8]));
+
+	return (item != _transport_cc_extension_ids.end()) ? item->second : 0;
+}
+
+size_t RtpRtcp::WriteTransportCcExtension(uint8_t *buffer, uint8_t extension_id, size_t packet_length)
+{
+	auto sequence_number = _transport_sequence_number++;
+
+	ByteWriter<uint16_t>::WriteBigEndian(&buffer[0], RTP_ONE_BYTE_EXTENSION_PROFILE);
+	// Length in 32-bit words
+	ByteWriter<uint16_t>::WriteBigEndian(&buffer[2], 1);
+	// L: length of the data - 1
+	buffer[4] = static_cast<uint8_t>((extension_id << 4) | 0x01);
+	ByteWriter<uint16_t>::WriteBigEndian(&buffer[5], sequence_number);
+	buffer[7] = 0;
+
+	_bandwidth_estimator.OnPacketSent(sequence_number, packet_length, GetCurrentTimeUs());
+
+	return TRANSPORT_CC_EXTENSION_SIZE;
+}
+
+bool RtpRtcp::SendRtpPacket(const std::shared_ptr<pub::SessionNode> &node, const std::shared_ptr<const ov::Data> &packet)
+{
+	auto source = packet->GetDataAs<uint8_t>();
+	auto extension_id = GetTransportCcExtensionId(source);
+	auto length = packet->GetLength() + ((extension_id != 0) ? TRANSPORT_CC_EXTENSION_SIZE : 0);
+
+	// SRTP needs a writable buffer with room for the auth tag
+	auto capacity = std::max<size_t>(DEFAULT_MAX_PACKET_SIZE, length + RTP_RTCP_OUTGOING_BUFFER_MARGIN);
+	auto outgoing_buffer = _outgoing_buffer_pool.GetBuffer(capacity);
+
+	if(outgoing_buffer->SetLength(length) == false)
+	{
+		return false;
+	}
+
+	auto destination = outgoing_buffer->GetWritableDataAs<uint8_t>();
+
+	if(extension_id == 0)
+	{
+		::memcpy(destination, source, length);
+	}
+	else
+	{
+		// The extension is inserted between the header (with CSRCs) and the payload
+		size_t header_size = FIXED_HEADER_SIZE + (source[0] & 0x0F) * 4;
+
+		if(packet->GetLength() < header_size)
+		{
+			return false;
+		}
+
+		::memcpy(destination, source, header_size);
+		destination[0] |= 0x10;
+
+		header_size += WriteTransportCcExtension(&destination[header_size], extension_id, length);
+
+		::memcpy(&destination[header_size], &source[header_size - TRANSPORT_CC_EXTENSION_SIZE], length - header_size);
+	}
+
+	if(!node->SendData(pub::SessionNodeType::Rtp, outgoing_buffer))
     {
 		return false;
     }
@@ -84,27 +347,61 @@ bool RtpRtcp::OnDataReceived(pub::SessionNodeType from_node, const std::shared_p
 		return false;
 	}
 
-    RtcpPacketType packet_type;
-    uint32_t payload_size;
-    int report_count;
+	// A compound RTCP packet contains several RTCP packets (RR + NACK, ...)
+	bool result = false;
+	size_t offset = 0;
 
-    // rtcp packet check
-    if (!RtcpPacket::IsRtcpPacket(data, packet_type, payload_size, report_count) || report_count <= 0)
-    {
-        logtd("Packet is not RTCP",RtcpPacket::GetPacketTypeString(packet_type).CStr());
-        return false;
-    }
+	while(offset < data->GetLength())
+	{
+		auto rtcp_packet = data->Subdata(offset);
+
+		RtcpPacketType packet_type;
+		uint32_t payload_size;
+		int report_count;
+
+		// rtcp packet check
+		if(!RtcpPacket::IsRtcpPacket(rtcp_packet, packet_type, payload_size, report_count))
+		{
+			logtd("Packet is not RTCP");
+			break;
+		}
+
+		rtcp_packet = rtcp_packet->Subdata(0, RTCP_HEADER_SIZE + payload_size);
 
-    return RtcpPacketProcess(packet_type, payload_size, report_count, data);
+		if(RtcpPacketProcess(packet_type, payload_size, report_count, rtcp_packet))
+		{
+			result = true;
+		}
+
+		offset += RTCP_HEADER_SIZE + payload_size;
+	}
+
+	return result;
 }
 
 // rtcp packet process
-// - current process only RR type
+// - current process only RR, NACK type
 bool RtpRtcp::RtcpPacketProcess(RtcpPacketType packet_type,
                                uint32_t payload_size,
                                int report_count,
                                const std::shared_ptr<const ov::Data> &data)
 {
+    if (packet_type == RtcpPacketType::RTPFB)
+    {
+        // report_count is FMT for the feedback messages
+        if (report_count == RTCP_RTPFB_FMT_TRANSPORT_CC)
+        {
+            return ProcessTransportFeedback(report_count, data);
+        }
+
+        return ProcessNack(report_count, data);
+    }
+
+    if (packet_type == RtcpPacketType::PSFB)
+    {
+        return ProcessKeyFrameRequest(report_count, data);
+    }
+
     // Receiver Report
     if (packet_type != RtcpPacketType::RR)
     {
@@ -112,6 +409,12 @@ bool RtpRtcp::RtcpPacketProcess(RtcpPacketType packet_type,
         return false;
     }
 
+    if (report_count <= 0)
+    {
+        // Empty RR (the receiver has not received any packet yet)
+        return true;
+    }
+
     std::vector<std::shared_ptr<RtcpReceiverReport>> receiver_reports;
 
     if (!RtcpPacket::RrParseing(report_count, data,  receiver_reports) )
@@ -143,3 +446,216 @@ bool RtpRtcp::RtcpPacketProcess(RtcpPacketType packet_type,
 	}
     return true;
 }
+
+bool RtpRtcp::ProcessKeyFrameRequest(int report_count, const std::shared_ptr<const ov::Data> &data)
+{
+	RtcpKeyFrameRequest request;
+
+	if(RtcpPacket::KeyFrameRequestParsing(report_count, data, request) == false)
+	{
+		logtd("RTCP(PSFB) packet is not a PLI/FIR or invalid (fmt: %d)", report_count);
+		return false;
+	}
+
+	if(request.is_fir)
+	{
+		// A FIR is repeated with the same sequence number until the key frame is received (RFC 5104 4.3.1.2)
+		auto item = _last_fir_sequence_numbers.find(request.media_ssrc);
+
+		if((item != _last_fir_sequence_numbers.end()) && (item->second == request.fir_sequence_number))
+		{
+			return true;
+		}
+
+		_last_fir_sequence_numbers[request.media_ssrc] = request.fir_sequence_number;
+	}
+
+	logtd("%s is received: ssrc(%u) session(%u)", request.is_fir ? "FIR" : "PLI", request.media_ssrc, GetSession()->GetId());
+
+	// The requests from the sessions are aggregated by the stream
+	GetSession()->GetStream()->RequestKeyFrame();
+
+	return true;
+}
+
+bool RtpRtcp::ProcessTransportFeedback(int report_count, const std::shared_ptr<const ov::Data> &data)
+{
+	RtcpTransportFeedback feedback;
+
+	if(RtcpPacket::TransportFeedbackParsing(report_count, data, feedback) == false)
+	{
+		logtd("RTCP(RTPFB) packet is not a transport-wide feedback or invalid (fmt: %d)", report_count);
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(_send_mutex);
+
+	if(_bandwidth_estimator.OnTransportFeedback(feedback, GetCurrentTimeUs()))
+	{
+		_pacer.SetEstimatedBitrate(_bandwidth_estimator.GetEstimatedBitrate());
+	}
+
+	return true;
+}
+
+bool RtpRtcp::ProcessNack(int report_count, const std::shared_ptr<const ov::Data> &data)
+{
+	RtcpNack nack;
+
+	if(RtcpPacket::NackParsing(report_count, data, nack) == false)
+	{
+		logtd("RTCP(RTPFB) packet is not a NACK or invalid (fmt: %d)", report_count);
+		return false;
+	}
+
+	auto item = _retransmission_map.find(nack.media_ssrc);
+	if(item == _retransmission_map.end())
+	{
+		logtd("Retransmission is not enabled for ssrc(%u)", nack.media_ssrc);
+		return false;
+	}
+
+	auto &context = item->second;
+
+	std::lock_guard<std::mutex> lock(_send_mutex);
+
+	for(auto sequence_number : nack.lost_sequence_numbers)
+	{
+		auto packet = context.history->GetForRetransmission(sequence_number, RTP_RTCP_RETRANSMISSION_MAX_AGE, RTP_RTCP_RETRANSMISSION_MIN_INTERVAL);
+
+		if(packet == nullptr)
+		{
+			logtd("Could not retransmit the packet: ssrc(%u) seq(%u)", nack.media_ssrc, sequence_number);
+			continue;
+		}
+
+		if(Retransmit(context, packet) == false)
+		{
+			// The budget is exhausted, or the transport is not available
+			break;
+		}
+	}
+
+	return true;
+}
+
+bool RtpRtcp::Retransmit(RetransmissionContext &context, const std::shared_ptr<const ov::Data> &packet)
+{
+	auto node = GetLowerNode();
+	if(!node)
+	{
+		return false;
+	}
+
+	auto original = packet->GetDataAs<uint8_t>();
+	auto original_length = packet->GetLength();
+
+	auto rtx_payload_type = context.rtx_payload_types.find(original[1] & 0x7F);
+
+	if(rtx_payload_type == context.rtx_payload_types.end())
+	{
+		// RTX is not negotiated
+		if(ConsumeRetransmissionBudget(original_length) == false)
+		{
+			return false;
+		}
+
+		_pacer.Consume(original_length, GetCurrentTimeUs());
+
+		return SendRtpPacket(node, packet);
+	}
+
+	// Fixed header + CSRCs (+ Header extension)
+	size_t header_size = FIXED_HEADER_SIZE + (original[0] & 0x0F) * 4;
+
+	if((original[0] & 0x10) && (original_length >= header_size + 4))
+	{
+		header_size += 4 + ByteReader<uint16_t>::ReadBigEndian(&original[header_size + 2]) * 4;
+	}
+
+	if(original_length < header_size)
+	{
+		return false;
+	}
+
+	auto extension_id = GetTransportCcExtensionId(original);
+	size_t extension_size = (extension_id != 0) ? TRANSPORT_CC_EXTENSION_SIZE : 0;
+	size_t rtx_length = original_length + extension_size + RTX_OSN_SIZE;
+
+	if(ConsumeRetransmissionBudget(rtx_length) == false)
+	{
+		return false;
+	}
+
+	// The retransmissions are not queued (they are already late), but they take the budget of the media
+	_pacer.Consume(rtx_length, GetCurrentTimeUs());
+
+	auto capacity = std::max<size_t>(DEFAULT_MAX_PACKET_SIZE, rtx_length + RTP_RTCP_OUTGOING_BUFFER_MARGIN);
+	auto outgoing_buffer = _outgoing_buffer_pool.GetBuffer(capacity);
+
+	if(outgoing_buffer->SetLength(rtx_length) == false)
+	{
+		return false;
+	}
+
+	// RFC 4588
+	// The header is same as the original packet except payload type, sequence number and SSRC,
+	// and the payload starts with the original sequence number
+	auto rtx = outgoing_buffer->GetWritableDataAs<uint8_t>();
+
+	::memcpy(rtx, original, header_size);
+	rtx[1] = (original[1] & 0x80) | rtx_payload_type->second;
+	ByteWriter<uint16_t>::WriteBigEndian(&rtx[2], context.rtx_sequence_number++);
+	ByteWriter<uint32_t>::WriteBigEndian(&rtx[8], context.rtx_ssrc);
+
+	size_t rtx_header_size = header_size;
+
+	if(extension_id != 0)
+	{
+		rtx[0] |= 0x10;
+		rtx_header_size += WriteTransportCcExtension(&rtx[header_size], extension_id, rtx_length);
+	}
+
+	::memcpy(&rtx[rtx_header_size], &original[2], RTX_OSN_SIZE);
+	::memcpy(&rtx[rtx_header_size + RTX_OSN_SIZE], &original[header_size], original_length - header_size);
+
+	return node->SendData(pub::SessionNodeType::Rtp, outgoing_buffer);
+}
+
+void RtpRtcp::RollRetransmissionWindow()
+{
+	auto elapsed = _retransmission_window.Elapsed();
+
+	if(elapsed < RTP_RTCP_RETRANSMISSION_WINDOW)
+	{
+		return;
+	}
+
+	if(elapsed < (RTP_RTCP_RETRANSMISSION_WINDOW * 2))
+	{
+		_retransmission_budget = std::max<size_t>(RTP_RTCP_RETRANSMISSION_MIN_BUDGET, _sent_bytes_in_window * RTP_RTCP_RETRANSMISSION_MAX_RATIO / 100);
+	}
+	else
+	{
+		// Nothing has been sent during the last window
+		_retransmission_budget = RTP_RTCP_RETRANSMISSION_MIN_BUDGET;
+	}
+
+	_sent_bytes_in_window = 0;
+	_retransmission_window.Start();
+}
+
+bool RtpRtcp::ConsumeRetransmissionBudget(size_t bytes)
+{
+	RollRetransmissionWindow();
+
+	if(bytes > _retransmission_budget)
+	{
+		logtd("Retransmission is limited: %zu bytes are requested, but only %zu bytes are left", bytes, _retransmission_budget);
+		return false;
+	}
+
+	_retransmission_budget -= bytes;
+
+	return true;
+}
@@ -4,15 +4,38 @@
 #include "rtp_packetizer.h"
 #include "base/publisher/session_node.h"
 #include "modules/rtp_rtcp/rtcp_sr_generator.h"
+#include "rtp_packet_history.h"
+#include "rtp_bandwidth_estimator.h"
+#include "rtp_pacer.h"
+#include "rtp_outgoing_buffer_pool.h"
 
-class RtpRtcp : public pub::SessionNode
+#include <mutex>
+
+class RtpRtcp : public pub::SessionNode, public RtpPacerTask
 {
 public:
 	RtpRtcp(uint32_t id, std::shared_ptr<pub::Session> session, const std::vector<uint32_t> &ssrc_list);
 	~RtpRtcp() override;
 
 	// 패킷을 전송한다. 성능을 위해 상위에서 Packetizing을 하는 경우 사용한다.
-	bool SendOutgoingData(const std::shared_ptr<ov::Data> &packet);
+	// The packet is shared with the other sessions, so it is not modified.
+	bool SendOutgoingData(const std::shared_ptr<const ov::Data> &packet);
+
+	// Keeps the sent packets of the SSRC to retransmit them when NACK is received.
+	// Must be called before the node is started.
+	//
+	// rtx_payload_types: payload type of the original packet -> payload type of RTX (RFC 4588)
+	// The packet of which payload type is not in rtx_payload_types is retransmitted as it is (same SSRC, sequence number).
+	void EnableRetransmission(uint32_t ssrc, uint32_t rtx_ssrc, const std::map<uint8_t, uint8_t> &rtx_payload_types);
+
+	// Adds the transport-wide sequence number (draft-holmer-rmcat-transport-wide-cc-extensions-01) to the packets of the SSRC,
+	// then the bandwidth is estimated using the transport-wide feedback from the receiver.
+	// Must be called before the node is started.
+	void EnableTransportCc(uint32_t ssrc, uint8_t extension_id);
+
+	// Estimated bandwidth of the path to the receiver (bps)
+	// Valid only if the transport-cc is enabled and the feedback is received
+	uint32_t GetEstimatedBitrate();
 
 	// Implement SessionNode Interface
 	// RtpRtcp는 최상위 노드로 SendData를 사용하지 않는다. SendOutgoingData를 사용한다.
@@ -24,10 +47,69 @@ public:
                             uint32_t payload_size,
                             int report_count,
                             const std::shared_ptr<const ov::Data> &data);
+
+	// Implement RtpPacerTask Interface
+	bool ProcessPacer() override;
+
 private:
     time_t _first_receiver_report_time = 0; // 0 - not received RR packet
     time_t _last_sender_report_time = 0;
     uint64_t _send_packet_sequence_number = 0;
 
     std::map<uint32_t, std::shared_ptr<RtcpSRGenerator>> _rtcp_sr_generators;
+
+    struct RetransmissionContext
+    {
+        std::shared_ptr<RtpPacketHistory> history;
+        uint32_t rtx_ssrc = 0;
+        std::map<uint8_t, uint8_t> rtx_payload_types;
+        uint16_t rtx_sequence_number = 0;
+    };
+
+    // Copies the shared packet into an outgoing buffer and sends it to the lower node
+    bool SendRtpPacket(const std::shared_ptr<pub::SessionNode> &node, const std::shared_ptr<const ov::Data> &packet);
+    // Sends the queued packets as much as the budget of the pacer allows (_send_mutex must be locked)
+    void SendPacedPackets(const std::shared_ptr<pub::SessionNode> &node);
+
+    // Returns the ID of the transport-cc extension for the packet, or 0 if the extension cannot be added
+    uint8_t GetTransportCcExtensionId(const uint8_t *packet);
+    // Writes the header extension that contains the transport-wide sequence number, and returns the size of it
+    size_t WriteTransportCcExtension(uint8_t *buffer, uint8_t extension_id, size_t packet_length);
+
+    bool ProcessNack(int report_count, const std::shared_ptr<const ov::Data> &data);
+    bool ProcessTransportFeedback(int report_count, const std::shared_ptr<const ov::Data> &data);
+    // PLI/FIR
+    bool ProcessKeyFrameRequest(int report_count, const std::shared_ptr<const ov::Data> &data);
+    bool Retransmit(RetransmissionContext &context, const std::shared_ptr<const ov::Data> &packet);
+    // Starts a new window if the current one is elapsed, and sets the budget from the bytes sent in it
+    void RollRetransmissionWindow();
+    // Returns false if the retransmissions exceed the budget of the session
+    bool ConsumeRetransmissionBudget(size_t bytes);
+
+
+    // The retransmissions (from the thread that receives RTCP) are serialized with the packets that are sent by the stream
+    std::mutex _send_mutex;
+
+    // key: SSRC of the media
+    std::map<uint32_t, RetransmissionContext> _retransmission_map;
+
+    // key: SSRC of the media, value: sequence number of the last FIR
+    std::map<uint32_t, uint8_t> _last_fir_sequence_numbers;
+
+    // The retransmitted bytes in a window are limited to a ratio of the bytes sent in the previous window
+    ov::StopWatch _retransmission_window;
+    size_t _sent_bytes_in_window = 0;
+    size_t _retransmission_budget = 0;
+
+    // key: SSRC of the media, value: ID of the transport-cc extension (a=extmap)
+    std::map<uint32_t, uint8_t> _transport_cc_extension_ids;
+    uint16_t _transport_sequence_number = 0;
+    RtpBandwidthEstimator _bandwidth_estimator;
+
+    RtpPacer _pacer;
+    // Whether the session is scheduled to RtpPacerScheduler to send the queued packets
+    bool _pacer_scheduled = false;
+
+    // The lower nodes(SRTP) encrypt the packet in place, so the shared packet is copied into one of these buffers
+    RtpOutgoingBufferPool _outgoing_buffer_pool;
 };
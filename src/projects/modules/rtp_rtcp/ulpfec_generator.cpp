@@ -1,7 +1,9 @@
 #include "ulpfec_generator.h"
+#include "fec_xor.h"
 #include "base/ovlibrary/byte_io.h"
 
 #include <string.h>
+#include <algorithm>
 
 constexpr size_t 	kFecHeaderSize					= 10;
 constexpr size_t 	kMaskSizeLbitClear				= 2;
@@ -27,6 +29,11 @@ void UlpfecGenerator::SetHighRateProtection(bool high_level)
 	_high_level = high_level;
 }
 
+void UlpfecGenerator::SetMaskType(UlpfecMaskType mask_type)
+{
+	_mask_type = mask_type;
+}
+
 bool UlpfecGenerator::AddRtpPacketAndGenerateFec(std::shared_ptr<RedRtpPacket> packet)
 {
 	_media_packets.push_back(packet);
@@ -60,102 +67,159 @@ bool UlpfecGenerator::NextPacket(RtpPacket *packet)
 bool UlpfecGenerator::Encode()
 {
 	size_t media_size = _media_packets.size();
-	//uint32_t rate = static_cast<uint32_t>(kMediaPacketNumMakeFec / (_high_level?2:1));
-	uint32_t fec_packet_count = static_cast<uint32_t>(std::ceil((float)media_size / (float)kMediaPacketNumMakeFec));
-	uint32_t media_packet_idx = 0;
-	size_t mask_len = 0;
 
-	size_t fec_header_size = kFecHeaderSize;
-	if(_media_packets.size() <= kUlpfecMaxMediaPacketsLbitClear)
+	if(media_size == 0)
 	{
-		fec_header_size += kFecLevelHeaderSizeLbitClear;
-		mask_len = kMaskSizeLbitClear;
-	}
-	else
-	{
-		fec_header_size += kFecLevelHeaderSizeLbitSet;
-		mask_len = kMaskSizeLbitSet;
+		return false;
 	}
 
-	for(uint32_t i=0; i<fec_packet_count; i++)
-	{
-		uint16_t sn_base = 0;
-		bool first_media_packet;
-		uint8_t mask[6];
-		int selected_media_count;
+	//uint32_t rate = static_cast<uint32_t>(kMediaPacketNumMakeFec / (_high_level?2:1));
+	bool result = true;
 
-		first_media_packet = true;
+	switch(_mask_type)
+	{
+		case UlpfecMaskType::Interleaved:
+		{
+			// The sequence numbers protected by a FEC packet must fit in the mask (L=1),
+			// so the media packets are split into windows and interleaved in each window.
+			size_t window_count = (media_size + kUlpfecMaxMediaPacketsLbitSet - 1) / kUlpfecMaxMediaPacketsLbitSet;
+			size_t window_begin = 0;
 
-		// TODO(Getroot): A more efficient algorithm should be used like random mask or bursty mask.
-		auto fec_packet = std::make_shared<ov::Data>();
-		fec_packet->SetLength(fec_header_size);
-		auto fec_buffer = fec_packet->GetWritableDataAs<uint8_t>();
+			for(size_t window = 0; window < window_count; window++)
+			{
+				size_t window_size = (media_size - window_begin) / (window_count - window);
+				size_t fec_packet_count = (window_size + kMediaPacketNumMakeFec - 1) / kMediaPacketNumMakeFec;
 
-		// Initialize
-		memset(mask, 0, sizeof(mask));
-		first_media_packet = true;
-		selected_media_count = (media_size-media_packet_idx) / (fec_packet_count - i);
+				for(size_t i = 0; i < fec_packet_count; i++)
+				{
+					_protected_packets.clear();
 
-		for(int j=0; j<selected_media_count; j++)
-		{
-			auto media_packet = _media_packets[media_packet_idx];
+					for(size_t media_packet_idx = window_begin + i; media_packet_idx < window_begin + window_size; media_packet_idx += fec_packet_count)
+					{
+						_protected_packets.push_back(_media_packets[media_packet_idx].get());
+					}
 
-			size_t fec_packet_length = fec_header_size + media_packet->PayloadSize();
+					result = GenerateFecPacket(_protected_packets) && result;
+				}
 
-			if(fec_packet->GetLength() < fec_packet_length)
-			{
-				fec_packet->SetLength(fec_packet_length);
-				fec_buffer = fec_packet->GetWritableDataAs<uint8_t>();
+				window_begin += window_size;
 			}
 
-			if(first_media_packet)
+			break;
+		}
+
+		case UlpfecMaskType::Consecutive:
+		default:
+		{
+			size_t fec_packet_count = (media_size + kMediaPacketNumMakeFec - 1) / kMediaPacketNumMakeFec;
+			size_t media_packet_idx = 0;
+
+			for(size_t i = 0; i < fec_packet_count; i++)
 			{
-				// Write P, X, CC fields.
-				// Bits 0, 1 are overwritten in FinalizeFecHeaders.
-				fec_buffer[0] = media_packet->Buffer()[0];
-
-				// The media_packet is red packet. So buffer[1] of RTP header has red payload type.
-				// We should use media payload type in the red header.
-				// M, and PT recovery
-				fec_buffer[1] = media_packet->Buffer()[media_packet->HeadersSize() - 1];
-				if(media_packet->Marker())
-				{
-					fec_buffer[1] |= 0x80;
-				}
-				else
+				size_t selected_media_count = (media_size - media_packet_idx) / (fec_packet_count - i);
+
+				_protected_packets.clear();
+
+				for(size_t j = 0; j < selected_media_count; j++)
 				{
-					fec_buffer[1] &= 0x7F;
+					_protected_packets.push_back(_media_packets[media_packet_idx].get());
+					media_packet_idx++;
 				}
 
-				// SN Base
-				ByteWriter<uint16_t>::WriteBigEndian(&fec_buffer[2], media_packet->SequenceNumber());
-				// Write timestamp recovery field.
-				ByteWriter<uint32_t>::WriteBigEndian(&fec_buffer[4], media_packet->Timestamp());
-				// Write length recovery field.
-				ByteWriter<uint16_t>::WriteBigEndian(&fec_buffer[8], (uint16_t)media_packet->PayloadSize());
-				// Write Payload.
-				memcpy(&fec_buffer[fec_header_size], media_packet->Payload(), media_packet->PayloadSize());
+				result = GenerateFecPacket(_protected_packets) && result;
+			}
+
+			break;
+		}
+	}
+
+	// clear media packet
+	_protected_packets.clear();
+	_media_packets.clear();
+
+	return result;
+}
+
+bool UlpfecGenerator::GenerateFecPacket(const std::vector<RedRtpPacket *> &protected_packets)
+{
+	if(protected_packets.empty())
+	{
+		return false;
+	}
+
+	uint16_t sn_base = protected_packets.front()->SequenceNumber();
+	uint16_t sn_span = protected_packets.back()->SequenceNumber() - sn_base;
+
+	if(sn_span >= kUlpfecMaxMediaPacketsLbitSet)
+	{
+		// Cannot be represented by the mask
+		return false;
+	}
 
-				sn_base = media_packet->SequenceNumber();
+	// Use the short mask if possible
+	bool l_bit = (sn_span >= kUlpfecMaxMediaPacketsLbitClear);
+	size_t mask_len = l_bit ? kMaskSizeLbitSet : kMaskSizeLbitClear;
+	size_t fec_header_size = kFecHeaderSize + (l_bit ? kFecLevelHeaderSizeLbitSet : kFecLevelHeaderSizeLbitClear);
 
-				first_media_packet = false;
+	size_t fec_payload_size = 0;
+	for(auto media_packet : protected_packets)
+	{
+		fec_payload_size = std::max(fec_payload_size, media_packet->PayloadSize());
+	}
+
+	// The buffer is allocated once from the pool of ov::Data with the final size (zero-filled),
+	// so the shorter payloads can be XORed without growing the buffer.
+	auto fec_packet = std::make_shared<ov::Data>(fec_header_size + fec_payload_size);
+	fec_packet->SetLength(fec_header_size + fec_payload_size);
+	auto fec_buffer = fec_packet->GetWritableDataAs<uint8_t>();
+
+	uint8_t mask[kMaskSizeLbitSet] = {0, };
+	bool first_media_packet = true;
+
+	for(auto media_packet : protected_packets)
+	{
+		if(first_media_packet)
+		{
+			// Write P, X, CC fields.
+			// Bits 0, 1 are overwritten in FinalizeFecHeaders.
+			fec_buffer[0] = media_packet->Buffer()[0];
+
+			// The media_packet is red packet. So buffer[1] of RTP header has red payload type.
+			// We should use media payload type in the red header.
+			// M, and PT recovery
+			fec_buffer[1] = media_packet->Buffer()[media_packet->HeadersSize() - 1];
+			if(media_packet->Marker())
+			{
+				fec_buffer[1] |= 0x80;
 			}
 			else
 			{
-				XorFecPacket(fec_buffer, fec_header_size, media_packet.get());
+				fec_buffer[1] &= 0x7F;
 			}
 
-			uint16_t diff = media_packet->SequenceNumber() - sn_base;
-			mask[diff / 8] |= 1 << (7 - (diff % 8));
-			media_packet_idx++;
-		}
+			// SN Base
+			ByteWriter<uint16_t>::WriteBigEndian(&fec_buffer[2], media_packet->SequenceNumber());
+			// Write timestamp recovery field.
+			ByteWriter<uint32_t>::WriteBigEndian(&fec_buffer[4], media_packet->Timestamp());
+			// Write length recovery field.
+			ByteWriter<uint16_t>::WriteBigEndian(&fec_buffer[8], (uint16_t)media_packet->PayloadSize());
+			// Write Payload.
+			memcpy(&fec_buffer[fec_header_size], media_packet->Payload(), media_packet->PayloadSize());
 
-		FinalizeFecHeader(fec_buffer, fec_packet->GetLength() - fec_header_size, mask, mask_len);
+			first_media_packet = false;
+		}
+		else
+		{
+			XorFecPacket(fec_buffer, fec_header_size, media_packet);
+		}
 
-		_generated_fec_packets.push(fec_packet);
+		uint16_t diff = media_packet->SequenceNumber() - sn_base;
+		mask[diff / 8] |= 1 << (7 - (diff % 8));
 	}
-	// clear media packet
-	_media_packets.clear();
+
+	FinalizeFecHeader(fec_buffer, fec_payload_size, mask, mask_len, l_bit);
+
+	_generated_fec_packets.push(fec_packet);
 
 	return true;
 }
@@ -194,27 +258,24 @@ void UlpfecGenerator::XorFecPacket(uint8_t *fec_packet, size_t fec_header_len, R
 	fec_packet[9] ^= rtp_payload_length_network_order[1];
 
 	// XOR Payload
-	for(size_t i = 0; i < rtp_payload_len; i++)
-	{
-		fec_packet[fec_header_len + i] ^= rtp_payload[i];
-	}
+	FecXor::Xor(&fec_packet[fec_header_len], rtp_payload, rtp_payload_len);
 }
 
-void UlpfecGenerator::FinalizeFecHeader(uint8_t *fec_packet, const size_t fec_payload_len, const uint8_t *mask, const size_t mask_len)
+void UlpfecGenerator::FinalizeFecHeader(uint8_t *fec_packet, const size_t fec_payload_len, const uint8_t *mask, const size_t mask_len, bool l_bit)
 {
 	// Set E bit to zero.
 	fec_packet[0] &= 0x7f;
 
 	// Set L bit
-	if(_media_packets.size() <= kUlpfecMaxMediaPacketsLbitClear)
+	if(l_bit)
 	{
-		// Clear L bit
-		fec_packet[0] &= 0xbf;
+		// Set L bit
+		fec_packet[0] |= 0x40;
 	}
 	else
 	{
-		// Set L bit
-		fec_packet[0] |= 0x40;
+		// Clear L bit
+		fec_packet[0] &= 0xbf;
 	}
 
 	// FEC Level header
@@ -34,13 +34,21 @@
 */
 
 /*
- *	The current version of OME protects all contiguous media packets with one FEC packet,
- *  and one media packet only protects with one FEC packet.
- *  Fec packets is generated by a frame.
- *  Current version generates only one fec packet, near future we will apply bursty mask model.
+ *  One media packet only protects with one FEC packet.
+ *  Fec packets is generated by a frame, and the media packets are grouped according to the mask type.
  *  The session determines whether the FEC PACKET is sent according to the network status (using RTCP RR).
  */
 
+enum class UlpfecMaskType
+{
+	// Each FEC packet protects contiguous media packets (1 2 3 4 | 5 6 7 8)
+	// Good for random losses, but a burst loss in a group cannot be recovered
+	Consecutive,
+	// The media packets are protected by the FEC packets in turn (1 3 5 7 | 2 4 6 8)
+	// A burst loss of up to (number of FEC packets) media packets can be recovered
+	Interleaved
+};
+
 class UlpfecGenerator
 {
 public:
@@ -48,6 +56,7 @@ public:
 	~UlpfecGenerator();
 
 	void SetHighRateProtection(bool high_level);
+	void SetMaskType(UlpfecMaskType mask_type);
 	// Because RTP is already being sent out, we execute ulpfec using the newly created red packet.
 	// I used this technique to reduce the copying and improve performance.
 	bool AddRtpPacketAndGenerateFec(std::shared_ptr<RedRtpPacket> packet);
@@ -56,10 +65,15 @@ public:
 
 private:
 	bool Encode();
+	// Generates a FEC packet that protects the packets (must be sorted by sequence number)
+	bool GenerateFecPacket(const std::vector<RedRtpPacket *> &protected_packets);
 	void XorFecPacket(uint8_t *fec_packet, size_t fec_header_len, RedRtpPacket *packet);
-	void FinalizeFecHeader(uint8_t *fec_packet, const size_t fec_payload_len, const uint8_t *mask, const size_t mask_len);
+	void FinalizeFecHeader(uint8_t *fec_packet, const size_t fec_payload_len, const uint8_t *mask, const size_t mask_len, bool l_bit);
 
 	std::queue<std::shared_ptr<ov::Data>>	    _generated_fec_packets;
 	std::vector<std::shared_ptr<RedRtpPacket>>	_media_packets;
+	// Reused to avoid allocating the list for every FEC packet
+	std::vector<RedRtpPacket *>                 _protected_packets;
 	bool                                        _high_level;
+	UlpfecMaskType                              _mask_type = UlpfecMaskType::Consecutive;
 };
\ No newline at end of file
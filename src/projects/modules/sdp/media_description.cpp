@@ -79,6 +79,11 @@ bool MediaDescription::UpdateData(ov::String &sdp)
 		sdp.AppendFormat("a=rtcp-mux\r\n");
 	}
 
+	for(auto &extmap : _extmap)
+	{
+		sdp.AppendFormat("a=extmap:%d %s\r\n", extmap.first, extmap.second.CStr());
+	}
+
 	// Payloads
 	for(auto &payload : _payload_list)
 	{
@@ -130,7 +135,17 @@ bool MediaDescription::UpdateData(ov::String &sdp)
 	// SSRCs
 	if(_cname.IsEmpty() == false)
 	{
+		if(_rtx_ssrc != 0)
+		{
+			sdp.AppendFormat("a=ssrc-group:FID %u %u\r\n", _ssrc, _rtx_ssrc);
+		}
+
 		sdp.AppendFormat("a=ssrc:%u cname:%s\r\n", _ssrc, _cname.CStr());
+
+		if(_rtx_ssrc != 0)
+		{
+			sdp.AppendFormat("a=ssrc:%u cname:%s\r\n", _rtx_ssrc, _cname.CStr());
+		}
 	}
 
 	return true;
@@ -363,6 +378,20 @@ bool MediaDescription::ParsingMediaLine(char type, std::string content)
 					SetSetup(std::string(matches[1]).c_str());
 				}
 			}
+			else if(content.compare(0, OV_COUNTOF("ssrc-") - 1, "ssrc-") == 0)
+			{
+				// a=ssrc-group:FID 2064629418 1957264311
+				if(std::regex_search(content, matches, std::regex("^ssrc-group:FID (\\d+) (\\d+)")))
+				{
+					if(matches.size() != 2 + 1)
+					{
+						parsing_error = true;
+						break;
+					}
+
+					SetRtxSsrc(stoul(matches[2]));
+				}
+			}
 			else if(content.compare(0, OV_COUNTOF("ss") - 1, "ss") == 0)
 			{
 				// a=ssrc:2064629418 cname:{b2266c86-259f-4853-8662-ea94cf0835a3}
@@ -374,7 +403,28 @@ bool MediaDescription::ParsingMediaLine(char type, std::string content)
 						break;
 					}
 
-					SetCname(stoul(matches[1]), std::string(matches[2]).c_str());
+					uint32_t ssrc = stoul(matches[1]);
+
+					// The SSRC of RTX also has the cname (a=ssrc-group:FID is placed before a=ssrc)
+					if((_rtx_ssrc == 0) || (ssrc != _rtx_ssrc))
+					{
+						SetCname(ssrc, std::string(matches[2]).c_str());
+					}
+				}
+			}
+			else if(content.compare(0, OV_COUNTOF("ext") - 1, "ext") == 0)
+			{
+				// a=extmap:3 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01
+				// a=extmap:4/sendonly urn:3gpp:video-orientation
+				if(std::regex_search(content, matches, std::regex("^extmap:(\\d+)(?:\\/\\w+)? (\\S+)")))
+				{
+					if(matches.size() != 2 + 1)
+					{
+						parsing_error = true;
+						break;
+					}
+
+					AddExtmap(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str());
 				}
 			}
 			else if(content.compare(0, OV_COUNTOF("fra") - 1, "fra") == 0)
@@ -515,6 +565,11 @@ const std::shared_ptr<PayloadAttr> MediaDescription::GetFirstPayload()
 	return _payload_list[0];
 }
 
+const std::vector<std::shared_ptr<PayloadAttr>> &MediaDescription::GetPayloadList()
+{
+	return _payload_list;
+}
+
 // a=rtcp-mux
 void MediaDescription::UseRtcpMux(bool flag)
 {
@@ -643,6 +698,35 @@ const ov::String MediaDescription::GetCname()
 	return _cname;
 }
 
+void MediaDescription::SetRtxSsrc(uint32_t rtx_ssrc)
+{
+	_rtx_ssrc = rtx_ssrc;
+}
+
+uint32_t MediaDescription::GetRtxSsrc()
+{
+	return _rtx_ssrc;
+}
+
+// a=extmap:3 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01
+void MediaDescription::AddExtmap(uint8_t id, const ov::String &uri)
+{
+	_extmap[id] = uri;
+}
+
+uint8_t MediaDescription::GetExtmapId(const ov::String &uri)
+{
+	for(auto &extmap : _extmap)
+	{
+		if(extmap.second == uri)
+		{
+			return extmap.first;
+		}
+	}
+
+	return 0;
+}
+
 // a=rtpmap:96 VP8/50000
 bool MediaDescription::AddRtpmap(uint8_t payload_type, const ov::String &codec,
                                  uint32_t rate, const ov::String &parameters)
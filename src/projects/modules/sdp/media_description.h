@@ -62,6 +62,7 @@ public:
 	void AddPayload(const std::shared_ptr<PayloadAttr> &payload);
 	const std::shared_ptr<PayloadAttr> GetPayload(uint8_t id);
 	const std::shared_ptr<PayloadAttr> GetFirstPayload();
+	const std::vector<std::shared_ptr<PayloadAttr>> &GetPayloadList();
 
 	// a=rtcp-mux
 	void UseRtcpMux(bool flag = true);
@@ -95,12 +96,23 @@ public:
 	bool EnableRtcpFb(uint8_t id, const ov::String &type, bool on);
 	void EnableRtcpFb(uint8_t id, const PayloadAttr::RtcpFbType &type, bool on);
 
+	// a=extmap:3 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01
+	void AddExtmap(uint8_t id, const ov::String &uri);
+	// Returns 0 if the extension is not negotiated
+	uint8_t GetExtmapId(const ov::String &uri);
+
 	// a=ssrc:2064629418 cname:{b2266c86-259f-4853-8662-ea94cf0835a3}
 	void SetCname(uint32_t ssrc, const ov::String &cname);
 
 	uint32_t GetSsrc();
 	const ov::String GetCname();
 
+	// a=ssrc-group:FID 2064629418 1957264311
+	// a=ssrc:1957264311 cname:{b2266c86-259f-4853-8662-ea94cf0835a3}
+	// SSRC of the retransmission stream (RFC 4588), 0 if RTX is not used
+	void SetRtxSsrc(uint32_t rtx_ssrc);
+	uint32_t GetRtxSsrc();
+
 private:
 	bool UpdateData(ov::String &sdp) override;
 	bool ParsingMediaLine(char type, std::string content);
@@ -128,8 +140,11 @@ private:
 	float _framerate = 0.0f;
 
 	uint32_t _ssrc = 0;
+	uint32_t _rtx_ssrc = 0;
 	ov::String _cname;
 
+	// key: ID, value: URI
+	std::map<uint8_t, ov::String> _extmap;
 
 	std::shared_ptr<SessionDescription> _session_description;
 	std::vector<std::shared_ptr<PayloadAttr>> _payload_list;
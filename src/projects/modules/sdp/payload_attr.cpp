@@ -69,7 +69,8 @@ const ov::String PayloadAttr::GetCodecParams()
 
 bool PayloadAttr::EnableRtcpFb(const ov::String &type, const bool on)
 {
-	ov::String type_name = type.UpperCaseString();
+	// "nack pli", "ccm fir", "transport-cc" -> "NACK_PLI", "CCM_FIR", "TRANSPORT_CC"
+	ov::String type_name = type.UpperCaseString().Replace(" ", "_").Replace("-", "_");
 
 	if(type_name == "GOOG_REMB")
 	{
@@ -5,6 +5,8 @@
 #include "monitoring_private.h"
 #include "host_metrics.h"
 
+#include <cinttypes>
+
 namespace mon
 {
 	ov::String HostMetrics::GetInfoString(bool show_children)
@@ -15,6 +17,9 @@ namespace mon
 		
 		out_str.Append(CommonMetrics::GetInfoString());
 
+		out_str.AppendFormat("\tTLS handshakes : full (%" PRIu64 "), resumed (%" PRIu64 "), failed (%" PRIu64 ")\n",
+							 GetTlsFullHandshakeCount(), GetTlsResumedHandshakeCount(), GetTlsFailedHandshakeCount());
+
 		if(show_children)
 		{
 			for(auto const &t : _applications)
@@ -75,4 +80,21 @@ namespace mon
 
 		return _applications[app_info.GetId()];
 	}
+
+	void HostMetrics::OnTlsHandshakeCompleted(bool is_resumed)
+	{
+		if (is_resumed)
+		{
+			_tls_resumed_handshake_count++;
+		}
+		else
+		{
+			_tls_full_handshake_count++;
+		}
+	}
+
+	void HostMetrics::OnTlsHandshakeFailed()
+	{
+		_tls_failed_handshake_count++;
+	}
 }  // namespace mon
\ No newline at end of file
@@ -27,7 +27,30 @@ namespace mon
 
 		std::shared_ptr<ApplicationMetrics> GetApplicationMetrics(const info::Application &app_info);
 
+		// TLS handshakes of HTTPS/WSS
+		void OnTlsHandshakeCompleted(bool is_resumed);
+		void OnTlsHandshakeFailed();
+
+		uint64_t GetTlsFullHandshakeCount() const
+		{
+			return _tls_full_handshake_count;
+		}
+
+		uint64_t GetTlsResumedHandshakeCount() const
+		{
+			return _tls_resumed_handshake_count;
+		}
+
+		uint64_t GetTlsFailedHandshakeCount() const
+		{
+			return _tls_failed_handshake_count;
+		}
+
 	private:
+		std::atomic<uint64_t> _tls_full_handshake_count{0};
+		std::atomic<uint64_t> _tls_resumed_handshake_count{0};
+		std::atomic<uint64_t> _tls_failed_handshake_count{0};
+
 		std::mutex _map_guard;
 		std::map<uint32_t, std::shared_ptr<ApplicationMetrics>> _applications;
 	};
@@ -14,6 +14,13 @@ namespace mon
 			auto &host = t.second;
 			host->ShowInfo();
 		}
+
+		logts("%s", ov::DataPool::GetStatsString().CStr());
+	}
+
+	ov::DataPool::Stats Monitoring::GetDataPoolStats() const
+	{
+		return ov::DataPool::GetStats();
 	}
 	
 	bool Monitoring::OnHostCreated(const info::Host &host_info)
@@ -6,6 +6,7 @@
 
 #include "base/info/host.h"
 #include "base/info/info.h"
+#include "base/ovlibrary/data_pool.h"
 #include "host_metrics.h"
 
 #define HostMetrics(info)			mon::Monitoring::GetInstance()->GetHostMetrics(info);
@@ -25,6 +26,9 @@ namespace mon
 
 		void ShowInfo();
 
+		// Server-wide statistics of the buffer pool that backs ov::Data
+		ov::DataPool::Stats GetDataPoolStats() const;
+
 		bool OnHostCreated(const info::Host &host_info);
 		bool OnHostDeleted(const info::Host &host_info);
 		bool OnApplicationCreated(const info::Application &app_info);
@@ -23,6 +23,16 @@ namespace mon
 		out_str.Append("\n");
 		out_str.Append(CommonMetrics::GetInfoString());
 
+		auto stage_metrics_list = GetTranscodeStageMetricsList();
+		if (stage_metrics_list.empty() == false)
+		{
+			out_str.AppendFormat("\n\t\t>>>> By transcode stage\n");
+			for (auto &stage_metrics : stage_metrics_list)
+			{
+				out_str.Append(stage_metrics->GetInfoString());
+			}
+		}
+
 		return out_str;
 	}
 
@@ -145,4 +155,26 @@ namespace mon
 		}
 	}
 
+	void StreamMetrics::AddTranscodeStageMetrics(const std::shared_ptr<TranscodeStageMetrics> &stage_metrics)
+	{
+		std::lock_guard<std::mutex> lock(_transcode_stage_metrics_guard);
+		_transcode_stage_metrics.push_back(stage_metrics);
+	}
+
+	void StreamMetrics::RemoveTranscodeStageMetrics(const std::shared_ptr<TranscodeStageMetrics> &stage_metrics)
+	{
+		std::lock_guard<std::mutex> lock(_transcode_stage_metrics_guard);
+
+		auto item = std::find(_transcode_stage_metrics.begin(), _transcode_stage_metrics.end(), stage_metrics);
+		if (item != _transcode_stage_metrics.end())
+		{
+			_transcode_stage_metrics.erase(item);
+		}
+	}
+
+	std::vector<std::shared_ptr<TranscodeStageMetrics>> StreamMetrics::GetTranscodeStageMetricsList()
+	{
+		std::lock_guard<std::mutex> lock(_transcode_stage_metrics_guard);
+		return _transcode_stage_metrics;
+	}
 }  // namespace mon
\ No newline at end of file
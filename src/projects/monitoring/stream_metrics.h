@@ -9,6 +9,7 @@
 #include "base/info/info.h"
 #include "base/info/stream.h"
 #include "common_metrics.h"
+#include "transcode_stage_metrics.h"
 
 namespace mon
 {
@@ -42,11 +43,20 @@ namespace mon
 		void IncreaseBytesOut(PublisherType type, uint64_t value) override;
 		void OnSessionConnected(PublisherType type) override;
 		void OnSessionDisconnected(PublisherType type) override;
+
+		// Stages of the transcoder that takes this stream as an input
+		void AddTranscodeStageMetrics(const std::shared_ptr<TranscodeStageMetrics> &stage_metrics);
+		void RemoveTranscodeStageMetrics(const std::shared_ptr<TranscodeStageMetrics> &stage_metrics);
+		std::vector<std::shared_ptr<TranscodeStageMetrics>> GetTranscodeStageMetricsList();
+
 	private:
 		// Related to origin, From Provider
 		std::atomic<double> _request_time_to_origin_msec;
 		std::atomic<double> _response_time_from_origin_msec;
 
 		std::shared_ptr<ApplicationMetrics>	_app_metrics;
+
+		std::mutex _transcode_stage_metrics_guard;
+		std::vector<std::shared_ptr<TranscodeStageMetrics>> _transcode_stage_metrics;
 	};
 }
\ No newline at end of file
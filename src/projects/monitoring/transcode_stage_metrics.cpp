@@ -0,0 +1,87 @@
+#include "transcode_stage_metrics.h"
+#include "monitoring_private.h"
+
+namespace mon
+{
+	TranscodeStageMetrics::TranscodeStageMetrics(const ov::String &name)
+		: _name(name)
+	{
+	}
+
+	const ov::String &TranscodeStageMetrics::GetName() const
+	{
+		return _name;
+	}
+
+	ov::String TranscodeStageMetrics::GetInfoString()
+	{
+		return ov::String::FormatString(
+			"\t\t- %s : Queue(%u) Max queue(%u) Processed(%llu) Dropped(%llu) Latency(avg %.3f ms, max %.3f ms)\n",
+			_name.CStr(), GetQueueDepth(), GetMaxQueueDepth(), GetProcessedCount(), GetDroppedCount(),
+			GetAverageLatencyMSec(), GetMaxLatencyMSec());
+	}
+
+	uint32_t TranscodeStageMetrics::GetQueueDepth()
+	{
+		return _queue_depth;
+	}
+
+	uint32_t TranscodeStageMetrics::GetMaxQueueDepth()
+	{
+		return _max_queue_depth;
+	}
+
+	uint64_t TranscodeStageMetrics::GetProcessedCount()
+	{
+		return _processed_count;
+	}
+
+	uint64_t TranscodeStageMetrics::GetDroppedCount()
+	{
+		return _dropped_count;
+	}
+
+	double TranscodeStageMetrics::GetAverageLatencyMSec()
+	{
+		uint64_t processed_count = _processed_count;
+
+		if (processed_count == 0)
+		{
+			return 0.0;
+		}
+
+		return static_cast<double>(_total_latency_usec) / processed_count / 1000.0;
+	}
+
+	double TranscodeStageMetrics::GetMaxLatencyMSec()
+	{
+		return static_cast<double>(_max_latency_usec) / 1000.0;
+	}
+
+	void TranscodeStageMetrics::OnEnqueued(uint32_t queue_depth)
+	{
+		_queue_depth = queue_depth;
+
+		uint32_t max_queue_depth = _max_queue_depth;
+		while ((queue_depth > max_queue_depth) && (_max_queue_depth.compare_exchange_weak(max_queue_depth, queue_depth) == false))
+		{
+		}
+	}
+
+	void TranscodeStageMetrics::OnDropped()
+	{
+		_dropped_count++;
+	}
+
+	void TranscodeStageMetrics::OnProcessed(uint32_t queue_depth, int64_t latency_usec)
+	{
+		_queue_depth = queue_depth;
+		_processed_count++;
+		_total_latency_usec += latency_usec;
+
+		int64_t max_latency_usec = _max_latency_usec;
+		while ((latency_usec > max_latency_usec) && (_max_latency_usec.compare_exchange_weak(max_latency_usec, latency_usec) == false))
+		{
+		}
+	}
+}  // namespace mon
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+
+#include "base/common_types.h"
+
+namespace mon
+{
+	// Statistics of one stage (decoder, filter or encoder) of the transcoding pipeline
+	class TranscodeStageMetrics
+	{
+	public:
+		TranscodeStageMetrics(const ov::String &name);
+
+		const ov::String &GetName() const;
+
+		ov::String GetInfoString();
+
+		uint32_t GetQueueDepth();
+		uint32_t GetMaxQueueDepth();
+		uint64_t GetProcessedCount();
+		uint64_t GetDroppedCount();
+		// The time an item has spent in the queue and the stage
+		double GetAverageLatencyMSec();
+		double GetMaxLatencyMSec();
+
+		void OnEnqueued(uint32_t queue_depth);
+		void OnDropped();
+		void OnProcessed(uint32_t queue_depth, int64_t latency_usec);
+
+	private:
+		ov::String _name;
+
+		std::atomic<uint32_t> _queue_depth{0};
+		std::atomic<uint32_t> _max_queue_depth{0};
+		std::atomic<uint64_t> _processed_count{0};
+		std::atomic<uint64_t> _dropped_count{0};
+		std::atomic<int64_t> _total_latency_usec{0};
+		std::atomic<int64_t> _max_latency_usec{0};
+	};
+}  // namespace mon
@@ -0,0 +1,203 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "domain_resolver.h"
+
+bool DomainResolver::HasWildcard(const std::string &label)
+{
+	return label.find_first_of("*?") != std::string::npos;
+}
+
+void DomainResolver::UpdatePriority(ssize_t *priority, ssize_t new_priority)
+{
+	if ((*priority == NoMatch) || (new_priority < *priority))
+	{
+		*priority = new_priority;
+	}
+}
+
+void DomainResolver::AddPattern(const ov::String &pattern, const std::regex &regex, const ov::String &vhost_name)
+{
+	auto priority = static_cast<ssize_t>(_vhost_name_list.size());
+	_vhost_name_list.push_back(vhost_name);
+
+	std::string name(pattern.CStr(), pattern.GetLength());
+
+	if (name == "*")
+	{
+		UpdatePriority(&_match_all_priority, priority);
+		return;
+	}
+
+	// Split the pattern into the labels
+	std::vector<std::string> label_list;
+	size_t start = 0;
+
+	while (true)
+	{
+		auto dot = name.find('.', start);
+
+		if (dot == std::string::npos)
+		{
+			label_list.push_back(name.substr(start));
+			break;
+		}
+
+		label_list.push_back(name.substr(start, dot - start));
+		start = dot + 1;
+	}
+
+	// Only "*" of the first label can be expressed with the trie ("*.airensoft.com")
+	bool is_wildcard = (label_list.size() > 1) && (label_list.front() == "*");
+
+	for (size_t index = (is_wildcard ? 1 : 0); index < label_list.size(); index++)
+	{
+		if (HasWildcard(label_list[index]))
+		{
+			_regex_pattern_list.push_back({priority, regex});
+			return;
+		}
+	}
+
+	auto node = &_root;
+
+	for (auto label = label_list.rbegin(); label != label_list.rend(); ++label)
+	{
+		if (is_wildcard && (label == (label_list.rend() - 1)))
+		{
+			break;
+		}
+
+		auto &child = node->children[*label];
+
+		if (child == nullptr)
+		{
+			child = std::make_unique<Node>();
+		}
+
+		node = child.get();
+	}
+
+	UpdatePriority(is_wildcard ? &(node->wildcard_priority) : &(node->exact_priority), priority);
+}
+
+ssize_t DomainResolver::FindFromTrie(const std::string &domain_name) const
+{
+	ssize_t priority = _match_all_priority;
+	auto node = &_root;
+	// The labels are visited from the end of the domain
+	size_t end = domain_name.size();
+
+	while (true)
+	{
+		auto dot = (end > 0) ? domain_name.rfind('.', end - 1) : std::string::npos;
+		size_t start = (dot == std::string::npos) ? 0 : (dot + 1);
+
+		auto child = node->children.find(domain_name.substr(start, end - start));
+
+		if (child == node->children.end())
+		{
+			break;
+		}
+
+		node = child->second.get();
+
+		if (dot == std::string::npos)
+		{
+			// All the labels are visited
+			if (node->exact_priority != NoMatch)
+			{
+				UpdatePriority(&priority, node->exact_priority);
+			}
+
+			break;
+		}
+
+		// There are more labels, so "*." + suffix matches the domain
+		if (node->wildcard_priority != NoMatch)
+		{
+			UpdatePriority(&priority, node->wildcard_priority);
+		}
+
+		end = dot;
+	}
+
+	return priority;
+}
+
+ssize_t DomainResolver::FindFromRegex(const std::string &domain_name, ssize_t limit) const
+{
+	{
+		std::lock_guard<std::mutex> lock_guard(_cache_mutex);
+
+		auto item = _cache_map.find(domain_name);
+
+		if (item != _cache_map.end())
+		{
+			_cache_list.splice(_cache_list.begin(), _cache_list, item->second);
+			return item->second->second;
+		}
+	}
+
+	ssize_t priority = NoMatch;
+
+	for (auto &pattern : _regex_pattern_list)
+	{
+		if ((limit != NoMatch) && (pattern.priority >= limit))
+		{
+			break;
+		}
+
+		if (std::regex_match(domain_name, pattern.regex))
+		{
+			priority = pattern.priority;
+			break;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock_guard(_cache_mutex);
+
+	if (_cache_map.find(domain_name) == _cache_map.end())
+	{
+		_cache_list.emplace_front(domain_name, priority);
+		_cache_map[domain_name] = _cache_list.begin();
+
+		if (_cache_list.size() > DOMAIN_RESOLVER_CACHE_SIZE)
+		{
+			_cache_map.erase(_cache_list.back().first);
+			_cache_list.pop_back();
+		}
+	}
+
+	return priority;
+}
+
+ov::String DomainResolver::Resolve(const ov::String &domain_name) const
+{
+	if (domain_name.IsEmpty())
+	{
+		return "";
+	}
+
+	std::string name(domain_name.CStr(), domain_name.GetLength());
+
+	auto priority = FindFromTrie(name);
+
+	// Most of the domains are resolved here, without the regex and the lock of the cache
+	if ((_regex_pattern_list.empty() == false) &&
+		((priority == NoMatch) || (_regex_pattern_list.front().priority < priority)))
+	{
+		auto regex_priority = FindFromRegex(name, priority);
+
+		if (regex_priority != NoMatch)
+		{
+			UpdatePriority(&priority, regex_priority);
+		}
+	}
+
+	return (priority != NoMatch) ? _vhost_name_list[priority] : "";
+}
@@ -0,0 +1,83 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Number of the results of the regex patterns cached by DomainResolver
+#define DOMAIN_RESOLVER_CACHE_SIZE (1024)
+
+// Finds the name of the VirtualHost from the domain name
+//
+// The domain patterns are compiled into a trie of the labels in reverse order
+// ("*.airensoft.com" => "com" -> "airensoft" -> "*"), so a domain is resolved by walking its labels once,
+// instead of matching the regex of every pattern.
+// The patterns that cannot be expressed with the labels (e.g. "ome-*.airensoft.com") are matched by the regex,
+// and the results of them are cached in a bounded LRU.
+//
+// DomainResolver is not modified once it is built, so it can be published as a snapshot
+// (The cache is the only mutable part, and it is discarded with the snapshot)
+class DomainResolver
+{
+public:
+	// The patterns must be added in the order of the priority (the first pattern that matches the domain wins)
+	void AddPattern(const ov::String &pattern, const std::regex &regex, const ov::String &vhost_name);
+
+	// @return An empty string if there is no matching pattern
+	ov::String Resolve(const ov::String &domain_name) const;
+
+protected:
+	static constexpr ssize_t NoMatch = -1;
+
+	struct Node
+	{
+		// key: label
+		std::unordered_map<std::string, std::unique_ptr<Node>> children;
+
+		// Priority of the pattern that ends at this node (e.g. "airensoft.com")
+		ssize_t exact_priority = NoMatch;
+		// Priority of the pattern that is "*." + this node (e.g. "*.airensoft.com")
+		ssize_t wildcard_priority = NoMatch;
+	};
+
+	struct RegexPattern
+	{
+		ssize_t priority;
+		std::regex regex;
+	};
+
+	static bool HasWildcard(const std::string &label);
+	static void UpdatePriority(ssize_t *priority, ssize_t new_priority);
+
+	ssize_t FindFromTrie(const std::string &domain_name) const;
+	// @param limit Only the patterns that have higher priority than limit are matched
+	ssize_t FindFromRegex(const std::string &domain_name, ssize_t limit) const;
+
+	// index: priority
+	std::vector<ov::String> _vhost_name_list;
+
+	Node _root;
+	// Priority of the "*" pattern
+	ssize_t _match_all_priority = NoMatch;
+
+	// Ordered by the priority
+	std::vector<RegexPattern> _regex_pattern_list;
+
+	// LRU cache of FindFromRegex() (key: domain name, value: priority)
+	mutable std::mutex _cache_mutex;
+	mutable std::list<std::pair<std::string, ssize_t>> _cache_list;
+	mutable std::unordered_map<std::string, std::list<std::pair<std::string, ssize_t>>::iterator> _cache_map;
+};
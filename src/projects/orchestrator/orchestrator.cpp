@@ -274,11 +274,32 @@ bool Orchestrator::ApplyOriginMap(const std::vector<info::Host> &host_list)
 		}
 	}
 
+	UpdateDomainResolver();
+
 	logtd("All items are applied");
 
 	return result;
 }
 
+void Orchestrator::UpdateDomainResolver()
+{
+	auto resolver = std::make_shared<DomainResolver>();
+
+	// CAUTION: This code is important to order, so don't use _virtual_host_map
+	for (auto &vhost_item : _virtual_host_list)
+	{
+		for (auto &domain_item : vhost_item->domain_list)
+		{
+			if (domain_item.state != ItemState::Delete)
+			{
+				resolver->AddPattern(domain_item.name, domain_item.regex_for_domain, vhost_item->name);
+			}
+		}
+	}
+
+	std::atomic_store(&_domain_resolver, std::shared_ptr<const DomainResolver>(std::move(resolver)));
+}
+
 const std::vector<std::shared_ptr<Orchestrator::VirtualHost>>& Orchestrator::GetVirtualHostList()
 {
 	return _virtual_host_list;
@@ -534,25 +555,12 @@ bool Orchestrator::UnregisterModule(const std::shared_ptr<OrchestratorModuleInte
 
 ov::String Orchestrator::GetVhostNameFromDomain(const ov::String &domain_name)
 {
-	// TODO(dimiden): I think it would be nice to create a VHost cache for performance
+	// The snapshot is looked up without locking _virtual_host_map_mutex, since it is called for every request
+	auto resolver = std::atomic_load(&_domain_resolver);
 
-	if (domain_name.IsEmpty() == false)
+	if ((resolver != nullptr) && (domain_name.IsEmpty() == false))
 	{
-		std::lock_guard<decltype(_virtual_host_map_mutex)> lock_guard(_virtual_host_map_mutex);
-
-		// Search for the domain corresponding to domain_name
-
-		// CAUTION: This code is important to order, so don't use _virtual_host_map
-		for (auto &vhost_item : _virtual_host_list)
-		{
-			for (auto &domain_item : vhost_item->domain_list)
-			{
-				if (std::regex_match(domain_name.CStr(), domain_item.regex_for_domain))
-				{
-					return vhost_item->name;
-				}
-			}
-		}
+		return resolver->Resolve(domain_name);
 	}
 
 	return "";
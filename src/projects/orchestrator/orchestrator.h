@@ -9,6 +9,7 @@
 #pragma once
 
 #include "data_structure.h"
+#include "domain_resolver.h"
 #include "base/info/host.h"
 #include <regex>
 
@@ -399,6 +400,10 @@ protected:
 	Orchestrator() = default;
 
 	bool ApplyForVirtualHost(const std::shared_ptr<VirtualHost> &virtual_host);
+	/// Builds a DomainResolver from _virtual_host_list, and replaces _domain_resolver with it
+	///
+	/// CAUTION: _virtual_host_map_mutex must be locked
+	void UpdateDomainResolver();
 
 	/// Compares a list of domains and adds them to added_domain_list if a new entry is found
 	///
@@ -461,4 +466,7 @@ protected:
 	std::map<ov::String, std::shared_ptr<VirtualHost>> _virtual_host_map;
 	// ordered vhost list
 	std::vector<std::shared_ptr<VirtualHost>> _virtual_host_list;
+
+	// Snapshot of the domains of _virtual_host_list (It is replaced when the origin map is applied)
+	std::shared_ptr<const DomainResolver> _domain_resolver;
 };
\ No newline at end of file
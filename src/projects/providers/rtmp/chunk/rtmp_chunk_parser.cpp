@@ -14,7 +14,11 @@ off_t RtmpChunkParser::Parse(const std::map<uint32_t, std::shared_ptr<const Rtmp
 	off_t total_parsed_bytes = 0LL;
 	off_t parsed_bytes = 0LL;
 
-	while (stream.IsEmpty() == false)
+	// The message header (T3) and the extended timestamp may have no bytes to read,
+	// so they are parsed even if the data ends, to complete the header without waiting for the next data
+	while ((stream.IsEmpty() == false) ||
+		   (_parse_status == ParseStatus::MessageHeader) ||
+		   (_parse_status == ParseStatus::ExtendedTimestamp))
 	{
 		switch (_parse_status)
 		{
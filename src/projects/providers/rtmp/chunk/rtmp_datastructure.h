@@ -46,13 +46,9 @@ struct RtmpChunkHeader
 
 	uint32_t basic_header_size = 0U;
 	uint32_t message_header_size = 0U;
-	// The payload size that NOT including type 3 messages
+	// The payload size of the message (NOT including type 3 chunk headers)
 	uint32_t payload_size = 0U;
 
-	uint32_t expected_type_3_header{};
-	// The payload size that including type 3 messages
-	uint32_t expected_payload_size = 0U;
-
 	// Basic Header
 	struct
 	{
@@ -199,7 +195,7 @@ struct RtmpChunkHeader
 					result.AppendFormat(", Extended TS: %u", extended_timestamp);
 				}
 
-				result.AppendFormat(", Payload: %u bytes (With Type 3: %u)", payload_size, expected_payload_size);
+				result.AppendFormat(", Payload: %u bytes", payload_size);
 			}
 			else
 			{
@@ -21,44 +21,95 @@ RtmpImportChunk::~RtmpImportChunk()
 	Destroy();
 }
 
-int RtmpImportChunk::Import(const std::shared_ptr<const ov::Data> &data, bool *is_completed)
+int RtmpImportChunk::Import(const void *data, size_t length, bool *is_completed)
 {
-	off_t parsed_bytes = 0LL;
-	std::shared_ptr<const RtmpChunkHeader> last_chunk_header;
+	auto current = static_cast<const uint8_t *>(data);
+	size_t consumed_bytes = 0;
 
 	*is_completed = false;
 
-	ov::ByteStream stream(data.get());
-
-	if (_parser.IsParseCompleted() == false)
+	while ((consumed_bytes < length) && (*is_completed == false))
 	{
-		// TODO(dimiden): Need to refactor because referencing _chunk_map in _parser isn't a good idea
-		parsed_bytes = _parser.Parse(_chunk_map, stream);
-
-		if (parsed_bytes < 0LL)
+		if (_current_message == nullptr)
 		{
-			// An error occurred
-			return static_cast<int>(parsed_bytes);
+			int header_bytes = ImportHeader(current + consumed_bytes, length - consumed_bytes, is_completed);
+
+			if (header_bytes < 0)
+			{
+				return header_bytes;
+			}
+
+			consumed_bytes += header_bytes;
 		}
-		else if (_parser.IsParseCompleted() == false)
+		else
 		{
-			// Need more data
-			OV_ASSERT2(parsed_bytes >= 0);
-
-			return static_cast<int>(parsed_bytes);
+			consumed_bytes += ImportPayload(current + consumed_bytes, length - consumed_bytes, is_completed);
 		}
+	}
+
+	return static_cast<int>(consumed_bytes);
+}
+
+int RtmpImportChunk::ImportHeader(const uint8_t *data, size_t length, bool *is_completed)
+{
+	// The header is always parsed from the beginning, because it is small enough (up to 18 bytes)
+	size_t copy_bytes = std::min(length, sizeof(_header_buffer) - _header_length);
+	::memcpy(_header_buffer + _header_length, data, copy_bytes);
+
+	ov::Data header_data(_header_buffer, _header_length + copy_bytes, true);
+	ov::ByteStream stream(&header_data);
+
+	_parser.Reset();
+
+	if (_parser.Parse(_chunk_map, stream) < 0LL)
+	{
+		return -1;
+	}
+
+	if (_parser.IsParseCompleted() == false)
+	{
+		// Need more data - keep the incomplete header
+		OV_ASSERT2(copy_bytes == length);
+
+		_header_length += copy_bytes;
+		return static_cast<int>(copy_bytes);
+	}
+
+	auto chunk_header = _parser.GetParsedChunkHeader();
+	_parser.Reset();
+
+	if (chunk_header == nullptr)
+	{
+		// chunk_header cannot be nullptr
+		OV_ASSERT2(false);
+		return -1;
+	}
+
+	OV_ASSERT2(chunk_header->header_size > _header_length);
 
-		// Need to parse the payload
-		auto chunk_header = _parser.GetParsedChunkHeader();
+	// Bytes of the header that are not in _header_buffer yet
+	int consumed_bytes = static_cast<int>(chunk_header->header_size - _header_length);
+	_header_length = 0;
 
-		if (chunk_header == nullptr)
+	auto chunk_stream_id = chunk_header->basic_header.stream_id;
+	auto &message = _message_map[chunk_stream_id];
+
+	if ((chunk_header->basic_header.format_type == RtmpChunkType::T3) && (message.payload != nullptr))
+	{
+		// The message is split into chunks, and this is the next chunk of the message
+		logtd("RTMP chunk is parsed: %s", chunk_header->ToString().CStr());
+	}
+	else
+	{
+		if (message.payload != nullptr)
 		{
-			// chunk_header cannot be nullptr
-			OV_ASSERT2(false);
-			return -1LL;
+			logte("A new message is started before the previous message is completed (chunk stream: %u, %zu/%u bytes received)",
+				  chunk_stream_id, message.payload->GetLength(), message.header->payload_size);
+			return -1;
 		}
 
-		auto item = _chunk_map.find(chunk_header->basic_header.stream_id);
+		std::shared_ptr<const RtmpChunkHeader> last_chunk_header;
+		auto item = _chunk_map.find(chunk_stream_id);
 
 		if (item != _chunk_map.end())
 		{
@@ -69,62 +120,67 @@ int RtmpImportChunk::Import(const std::shared_ptr<const ov::Data> &data, bool *i
 			// This is the first chunk
 		}
 
-		logtd("RTMP header is parsed: %s", chunk_header->ToString().CStr());
-
 		if (ProcessChunkHeader(chunk_header, last_chunk_header) == false)
 		{
-			return -1LL;
+			return -1;
 		}
 
-		_chunk_map[chunk_header->basic_header.stream_id] = chunk_header;
-		last_chunk_header = std::move(chunk_header);
-	}
-	else
-	{
-		// Try to parse the payload using last chunk header
-		auto chunk_header = _parser.GetParsedChunkHeader();
+		logtd("RTMP header is parsed: %s", chunk_header->ToString().CStr());
 
-		if (chunk_header == nullptr)
-		{
-			// chunk_header cannot be nullptr
-			OV_ASSERT2(false);
-			return -1LL;
-		}
+		_chunk_map[chunk_stream_id] = chunk_header;
 
-		auto item = _chunk_map.find(chunk_header->basic_header.stream_id);
+		message.header = chunk_header;
+		// Allocate the whole payload at once
+		message.payload = std::make_shared<ov::Data>(chunk_header->payload_size);
+	}
 
-		if (item == _chunk_map.end())
-		{
-			logte("Could not find stream for stream_id: %u", chunk_header->basic_header.stream_id);
-			return -1LL;
-		}
+	_current_message = &message;
+	_chunk_remained = std::min(_chunk_size, static_cast<size_t>(message.header->payload_size - message.payload->GetLength()));
 
-		last_chunk_header = item->second;
+	if (_chunk_remained == 0)
+	{
+		// An empty message
+		ImportPayload(nullptr, 0, is_completed);
 	}
 
-	if (stream.IsRemained(last_chunk_header->expected_payload_size) == false)
-	{
-		// Need more data
-		OV_ASSERT2(parsed_bytes >= 0);
+	return consumed_bytes;
+}
 
-		return parsed_bytes;
-	}
+size_t RtmpImportChunk::ImportPayload(const uint8_t *data, size_t length, bool *is_completed)
+{
+	OV_ASSERT2(_current_message != nullptr);
 
-	auto message = FinalizeMessage(last_chunk_header, stream);
+	auto &payload = _current_message->payload;
+	size_t copy_bytes = std::min(length, _chunk_remained);
 
-	if (message == nullptr)
+	if (copy_bytes > 0)
 	{
-		return -1LL;
+		payload->Append(data, copy_bytes);
+		_chunk_remained -= copy_bytes;
 	}
 
-	logtd("Finalized message: %s", message->header->ToString().CStr());
+	if (_chunk_remained == 0)
+	{
+		// Current chunk is completed
+		if (payload->GetLength() == _current_message->header->payload_size)
+		{
+			auto message = std::make_shared<RtmpMessage>(_current_message->header, std::move(payload));
 
-	_message_queue.push_back(message);
+			logtd("Finalized message: %s", message->header->ToString().CStr());
 
-	*is_completed = true;
-	_parser.Reset();
+			_message_queue.push_back(std::move(message));
+
+			_current_message->header = nullptr;
+			_current_message->payload = nullptr;
+
+			*is_completed = true;
+		}
 
-	return parsed_bytes + last_chunk_header->expected_payload_size;
+		// The next data is a chunk header
+		_current_message = nullptr;
+	}
+
+	return copy_bytes;
 }
 
 int64_t RtmpImportChunk::CalculateRolledTimestamp(int64_t last_timestamp, int64_t parsed_timestamp)
@@ -251,147 +307,19 @@ bool RtmpImportChunk::ProcessChunkHeader(const std::shared_ptr<RtmpChunkHeader>
 		}
 	}
 
-	chunk_header->message_header_size = sizeof(RtmpChunkHeader::completed);
 	chunk_header->payload_size = chunk_header->completed.length;
 
-	chunk_header->RecalculateHeaderSize();
-
 	if (chunk_header->payload_size > RTMP_MAX_PACKET_SIZE)
 	{
 		logte("RTMP packet size is too large: %d (threshold: %d)", chunk_header->payload_size, RTMP_MAX_PACKET_SIZE);
 		return false;
 	}
 
-	// When the transfered data larger than _chunk_size, type 3 header is in the middle
-	if (CalculateForType3Header(chunk_header) == false)
-	{
-		logte("Could not calculate type 3 headers");
-		return false;
-	}
-
 	OV_ASSERT2(chunk_header->basic_header_size >= 0);
-	OV_ASSERT2(chunk_header->payload_size <= chunk_header->expected_payload_size);
 
 	return true;
 }
 
-bool RtmpImportChunk::CalculateForType3Header(const std::shared_ptr<RtmpChunkHeader> &chunk_header)
-{
-	// In the middle, the chunk stream id of the type 3 message is the same as that of type 0
-	uint8_t *expected_type_3_header = reinterpret_cast<uint8_t *>(&(chunk_header->expected_type_3_header));
-
-	expected_type_3_header[0] = static_cast<uint32_t>(RtmpChunkType::T3);
-
-	switch (chunk_header->basic_header_size)
-	{
-		case 1:
-			// Chunk stream ID's range: 2-63
-			expected_type_3_header[0] |= (chunk_header->basic_header.stream_id & 0b00111111);
-			break;
-
-		case 2:
-			// Chunk stream ID's range: 64-319
-			expected_type_3_header[0] |= 0b00000000;
-			expected_type_3_header[1] = chunk_header->basic_header.stream_id - 64;
-			break;
-
-		case 3:
-		{
-			// Chunk stream ID's range: 64-65599
-			auto stream_id = chunk_header->basic_header.stream_id - 64;
-
-			expected_type_3_header[0] |= 0b00000001;
-			expected_type_3_header[1] = stream_id & 0xFF;
-			stream_id >>= 16;
-			expected_type_3_header[2] = stream_id & 0xFF;
-			break;
-		}
-
-		default:
-			OV_ASSERT2(false);
-			return false;
-	}
-
-	int type_3_count = (chunk_header->payload_size - 1) / _chunk_size;
-	int expected_type_3_size = chunk_header->basic_header_size + (chunk_header->is_extended ? sizeof(RtmpChunkHeader::extended_timestamp) : 0);
-	chunk_header->expected_payload_size = chunk_header->payload_size + (type_3_count * expected_type_3_size);
-
-	OV_ASSERT2(type_3_count >= 0);
-
-	return (type_3_count >= 0);
-}
-
-std::shared_ptr<const RtmpMessage> RtmpImportChunk::FinalizeMessage(const std::shared_ptr<const RtmpChunkHeader> &chunk_header, ov::ByteStream &stream)
-{
-	// We need to exclude the type 3 headers
-	int index = 0;
-	int basic_header_size = chunk_header->basic_header_size;
-	size_t payload_size = chunk_header->expected_payload_size;
-	const auto *expected_type_3_header = &(chunk_header->expected_type_3_header);
-	auto payload_data = std::make_shared<ov::Data>(chunk_header->payload_size);
-	const uint8_t *current = stream.GetRemainData()->GetDataAs<uint8_t>();
-	int extended_header_size = 0;
-
-	if (chunk_header->is_extended)
-	{
-		extended_header_size = sizeof(RtmpChunkHeader::extended_timestamp);
-	}
-
-	while (payload_size > 0)
-	{
-		if (index > 0)
-		{
-			if (payload_size < static_cast<size_t>(basic_header_size + extended_header_size))
-			{
-				logte("Not enough data: %zu bytes, expected: %zu bytes", payload_size, basic_header_size + extended_header_size);
-				return nullptr;
-			}
-
-			// Make sure that the message type of payload is type 3 and matches what was expected
-			if (::memcmp(current, expected_type_3_header, basic_header_size) != 0)
-			{
-				logte("Invalid message is received: offset: %lld\nexpected:\n%s\nbut:\n%s",
-					  (chunk_header->expected_payload_size - payload_size),
-					  ov::Dump(expected_type_3_header, basic_header_size).CStr(),
-					  ov::Dump(current, basic_header_size).CStr());
-
-				return nullptr;
-			}
-
-			// skip type 3 header
-			current += basic_header_size + extended_header_size;
-			payload_size -= basic_header_size + extended_header_size;
-		}
-
-		size_t read_size = std::min(_chunk_size, payload_size);
-
-		if (payload_size < read_size)
-		{
-			logte("Not enough data: %zu bytes, expected: %zu bytes", payload_size, read_size);
-			return nullptr;
-		}
-
-		payload_data->Append(current, read_size);
-
-		index++;
-
-		current += read_size;
-		payload_size -= read_size;
-	}
-
-	if (payload_data->GetLength() != chunk_header->payload_size)
-	{
-		OV_ASSERT(
-			payload_data->GetLength() != chunk_header->payload_size,
-			"Payload length: %zu, Expected: %zu", payload_data->GetLength(), chunk_header->payload_size);
-		return nullptr;
-	}
-
-	auto message = std::make_shared<RtmpMessage>(chunk_header, std::move(payload_data));
-
-	return std::move(message);
-}
-
 std::shared_ptr<const RtmpMessage> RtmpImportChunk::GetMessage()
 {
 	if (_message_queue.empty())
@@ -413,7 +341,12 @@ size_t RtmpImportChunk::GetMessageCount() const
 void RtmpImportChunk::Destroy()
 {
 	_chunk_map.clear();
+	_message_map.clear();
 	_message_queue.clear();
 
 	_parser.Reset();
+
+	_header_length = 0;
+	_current_message = nullptr;
+	_chunk_remained = 0;
 }
\ No newline at end of file
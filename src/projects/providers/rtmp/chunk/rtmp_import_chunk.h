@@ -17,13 +17,26 @@
 #include "rtmp_mux_util.h"
 #include "rtmp_datastructure.h"
 
+// Basic header (3) + Message header (11) + Extended timestamp (4)
+#define RTMP_MAX_CHUNK_HEADER_SIZE (3 + 11 + 4)
+
+// Incremental RTMP chunk parser
+//
+// The received data is consumed as it arrives: the payload of each chunk is copied once into the message it belongs to
+// (allocated with the message length), and only an incomplete chunk header is kept until the next data arrives.
+// Since the messages of each chunk stream are assembled independently, the chunks of different chunk streams can be interleaved.
 class RtmpImportChunk : public RtmpMuxUtil
 {
 public:
 	RtmpImportChunk(int chunk_size);
 	~RtmpImportChunk() override;
 
-	int Import(const std::shared_ptr<const ov::Data> &data, bool *is_completed);
+	// Consumes the data until a message is completed
+	//
+	// Return values:
+	//  <0: An error occurred while parsing
+	// >=0: Number of bytes consumed (is_completed is true if a message is completed, then the message can be obtained using GetMessage())
+	int Import(const void *data, size_t length, bool *is_completed);
 
 	std::shared_ptr<const RtmpMessage> GetMessage();
 	size_t GetMessageCount() const;
@@ -36,15 +49,37 @@ public:
 	void Destroy();
 
 private:
+	// State of the message that is being received through a chunk stream
+	struct ChunkStreamMessage
+	{
+		std::shared_ptr<const RtmpChunkHeader> header;
+		std::shared_ptr<ov::Data> payload;
+	};
+
 	int64_t CalculateRolledTimestamp(int64_t last_timestamp, int64_t parsed_timestamp);
 
+	// Returns the number of bytes consumed for the header (an incomplete header is kept in _header_buffer)
+	int ImportHeader(const uint8_t *data, size_t length, bool *is_completed);
+	// Returns the number of bytes consumed for the payload of current chunk
+	size_t ImportPayload(const uint8_t *data, size_t length, bool *is_completed);
+
 	bool ProcessChunkHeader(const std::shared_ptr<RtmpChunkHeader> &chunk_header, const std::shared_ptr<const RtmpChunkHeader> &last_chunk_header);
-	bool CalculateForType3Header(const std::shared_ptr<RtmpChunkHeader> &chunk_header);
-	std::shared_ptr<const RtmpMessage> FinalizeMessage(const std::shared_ptr<const RtmpChunkHeader> &chunk_header, ov::ByteStream &stream);
 
+	// The last header that starts a message for each chunk stream
 	std::map<uint32_t, std::shared_ptr<const RtmpChunkHeader>> _chunk_map;
+	// Messages that are not completed yet for each chunk stream
+	std::map<uint32_t, ChunkStreamMessage> _message_map;
 	std::deque<std::shared_ptr<const RtmpMessage>> _message_queue;
 	size_t _chunk_size;
 
 	RtmpChunkParser _parser;
+
+	// Incomplete chunk header
+	uint8_t _header_buffer[RTMP_MAX_CHUNK_HEADER_SIZE];
+	size_t _header_length = 0;
+
+	// The message that the payload of current chunk belongs to (nullptr while parsing a header)
+	ChunkStreamMessage *_current_message = nullptr;
+	// Remaining bytes of the payload of current chunk
+	size_t _chunk_remained = 0;
 };
@@ -176,69 +176,75 @@ bool RtmpChunkStream::SendData(int data_size, uint8_t *data)
 
 int32_t RtmpChunkStream::OnDataReceived(const std::shared_ptr<const ov::Data> &data)
 {
-	if ((_remained_data == nullptr) || _remained_data->IsEmpty())
-	{
-		_remained_data = data->Clone();
-	}
-	else
-	{
-		_remained_data->Append(data);
-	}
-
 	if (_stat_stop_watch.IsElapsed(5000) && _stat_stop_watch.Update())
 	{
-		logts("Stats for RtmpChunkStream: Message Q: %zu, Remained bytes: %zu",
-			  _import_chunk->GetMessageCount(),
-			  _remained_data->GetAllocatedDataSize());
+		logts("Stats for RtmpChunkStream: Message Q: %zu",
+			  _import_chunk->GetMessageCount());
 	}
 
-	if (_remained_data->GetLength() > RTMP_MAX_PACKET_SIZE)
-	{
-		logte("The packet is ignored because the size is too large: [%s/%s] (%u/%u), packet size: %zu, threshold: %d",
-			  _app_name.CStr(), _stream_name.CStr(),
-			  _app_id, _stream_id,
-			  _remained_data->GetLength(),
-			  RTMP_MAX_PACKET_SIZE);
-
-		return -1;
-	}
+	logtp("Trying to parse data\n%s", data->Dump(data->GetLength()).CStr());
 
-	logtp("Trying to parse data\n%s", _remained_data->Dump(_remained_data->GetLength()).CStr());
+	auto current = data->GetDataAs<uint8_t>();
+	size_t remained = data->GetLength();
 
-	while(true)
+	if (_handshake_state != RtmpHandshakeState::Complete)
 	{
-		int32_t process_size = 0;
-
-		if (_handshake_state == RtmpHandshakeState::Complete)
+		// Handshake packets (C0+C1, C2) are small, so they are accumulated until they are completed
+		if ((_remained_data == nullptr) || _remained_data->IsEmpty())
 		{
-			process_size = ReceiveChunkPacket(_remained_data);
+			_remained_data = data->Clone();
 		}
 		else
 		{
-			process_size = ReceiveHandshakePacket(_remained_data);
+			_remained_data->Append(data);
 		}
 
-		if (process_size < 0)
+		while (_handshake_state != RtmpHandshakeState::Complete)
 		{
-			logte("Could not parse RTMP packet: [%s/%s] (%u/%u), size: %zu bytes, returns: %d",
-				_app_name.CStr(), _stream_name.CStr(),
-				_app_id, _stream_id,
-				_remained_data->GetLength(),
-				process_size);
+			auto process_size = ReceiveHandshakePacket(_remained_data);
+
+			if (process_size < 0)
+			{
+				logte("Could not parse RTMP handshake packet: [%s/%s] (%u/%u), size: %zu bytes, returns: %d",
+					  _app_name.CStr(), _stream_name.CStr(),
+					  _app_id, _stream_id,
+					  _remained_data->GetLength(),
+					  process_size);
+
+				return process_size;
+			}
+			else if (process_size == 0)
+			{
+				// Need more data
+				return data->GetLength();
+			}
 
-			return process_size;
+			_remained_data = _remained_data->Subdata(process_size);
 		}
-		else if(process_size == 0)
+
+		// The data after the handshake is chunks
+		auto chunk_data = std::move(_remained_data);
+		_remained_data = nullptr;
+
+		if ((chunk_data->IsEmpty() == false) && (ReceiveChunkPacket(chunk_data->GetDataAs<uint8_t>(), chunk_data->GetLength()) < 0))
 		{
-			// Need more data
-			// logtd("Not enough data");
-			break;
+			return -1;
 		}
 
-		_remained_data = _remained_data->Subdata(process_size);
+		return data->GetLength();
+	}
+
+	// The data is consumed immediately, because the socket reuses the buffer of data
+	if (ReceiveChunkPacket(current, remained) < 0)
+	{
+		logte("Could not parse RTMP packet: [%s/%s] (%u/%u), size: %zu bytes",
+			  _app_name.CStr(), _stream_name.CStr(),
+			  _app_id, _stream_id,
+			  remained);
+
+		return -1;
 	}
-	
-	// All data are already appended to _remained_data
+
 	return data->GetLength();
 }
 
@@ -389,44 +395,43 @@ bool RtmpChunkStream::SendHandshake(const std::shared_ptr<const ov::Data> &data)
 	return true;
 }
 
-int32_t RtmpChunkStream::ReceiveChunkPacket(const std::shared_ptr<const ov::Data> &data)
+int32_t RtmpChunkStream::ReceiveChunkPacket(const uint8_t *data, size_t length)
 {
 	int32_t process_size = 0;
 	int32_t import_size = 0;
-	std::shared_ptr<const ov::Data> current_data = data;
 
-	while (current_data->IsEmpty() == false)
+	while (static_cast<size_t>(process_size) < length)
 	{
 		bool is_completed = false;
 
-		import_size = _import_chunk->Import(current_data, &is_completed);
+		import_size = _import_chunk->Import(data + process_size, length - process_size, &is_completed);
 
-		if (import_size == 0)
-		{
-			// Need more data
-			break;
-		}
-		else if (import_size < 0)
+		if (import_size < 0)
 		{
 			logte("An error occurred while parse RTMP data: %d", import_size);
 			return import_size;
 		}
 
+		// A message must be processed before parsing the next chunk, because it may change the chunk size
 		if (is_completed)
 		{
 			if (ReceiveChunkMessage() == false)
 			{
 				logte("ReceiveChunkMessage Fail");
-				logtp("Failed to import packet\n%s", current_data->Dump(current_data->GetLength()).CStr());
+				logtp("Failed to import packet\n%s", ov::Dump(data + process_size, import_size).CStr());
 
 				return -1LL;
 			}
 		}
+		else if (import_size == 0)
+		{
+			OV_ASSERT2(false);
+			break;
+		}
 
-		logtp("Imported\n%s", current_data->Dump(import_size).CStr());
+		logtp("Imported\n%s", ov::Dump(data + process_size, import_size).CStr());
 
 		process_size += import_size;
-		current_data = current_data->Subdata(import_size);
 	}
 
 	// Accumulate processed bytes for acknowledgement
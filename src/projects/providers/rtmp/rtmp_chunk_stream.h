@@ -106,7 +106,7 @@ private:
 	off_t ReceiveHandshakePacket(const std::shared_ptr<const ov::Data> &data);
 
 	// This function will called after OnMetaData
-	int32_t ReceiveChunkPacket(const std::shared_ptr<const ov::Data> &data);
+	int32_t ReceiveChunkPacket(const uint8_t *data, size_t length);
 
 	bool SendHandshake(const std::shared_ptr<const ov::Data> &data);
 
@@ -174,6 +174,7 @@ protected:
 	uint32_t _stream_id;
 	ov::String _device_string;
 
+	// Used until the handshake is completed
 	std::shared_ptr<ov::Data> _remained_data;
 	RtmpHandshakeState _handshake_state;
 	std::shared_ptr<RtmpImportChunk> _import_chunk;
@@ -47,7 +47,8 @@ bool RtmpProvider::Start()
 	// Get Server & Host configuration
 	auto server = GetServerConfig();
 
-	auto rtmp_address = ov::SocketAddress(server.GetIp(), static_cast<uint16_t>(server.GetBind().GetProviders().GetRtmpPort()));
+	auto &rtmp_port = server.GetBind().GetProviders().GetRtmp();
+	auto rtmp_address = ov::SocketAddress(server.GetIp(), static_cast<uint16_t>(rtmp_port.GetPort()));
 
 	// Create RtmpServer
 	_rtmp_server = std::make_shared<RtmpServer>();
@@ -55,7 +56,7 @@ bool RtmpProvider::Start()
 	// Connect RtmpServer to Observer
 	_rtmp_server->AddObserver(RtmpObserver::GetSharedPtr());
 
-	if (!_rtmp_server->Start(rtmp_address))
+	if (!_rtmp_server->Start(rtmp_address, rtmp_port.GetWorkerCount()))
 	{
 		return false;
 	}
@@ -18,7 +18,7 @@ RtmpServer::~RtmpServer()
 	OV_ASSERT2(_physical_port == nullptr);
 }
 
-bool RtmpServer::Start(const ov::SocketAddress &address)
+bool RtmpServer::Start(const ov::SocketAddress &address, int worker_count)
 {
 	if (_physical_port != nullptr)
 	{
@@ -26,7 +26,7 @@ bool RtmpServer::Start(const ov::SocketAddress &address)
 		return false;
 	}
 
-	_physical_port = PhysicalPortManager::Instance()->CreatePort(ov::SocketType::Tcp, address);
+	_physical_port = PhysicalPortManager::Instance()->CreatePort(ov::SocketType::Tcp, address, worker_count);
 
 	if (_physical_port == nullptr)
 	{
@@ -43,8 +43,6 @@ bool RtmpServer::Start(const ov::SocketAddress &address)
 	// Start the timer
 	_garbage_check_timer.Start();
 
-	_stat_stop_watch.Start();
-
 	return true;
 }
 
@@ -105,20 +103,40 @@ bool RtmpServer::RemoveObserver(const std::shared_ptr<RtmpObserver> &observer)
 
 bool RtmpServer::Disconnect(const ov::String &app_name, uint32_t stream_id)
 {
-	std::unique_lock<std::recursive_mutex> lock(_chunk_context_list_mutex);
+	ov::Socket *remote = nullptr;
 
-	for (auto item = _chunk_context_list.begin(); item != _chunk_context_list.end(); ++item)
 	{
-		auto &chunk_stream = item->second;
+		std::unique_lock<std::recursive_mutex> lock(_chunk_context_list_mutex);
 
-		if (chunk_stream->GetAppName() == app_name && chunk_stream->GetStreamId() == stream_id)
+		for (auto item = _chunk_context_list.begin(); item != _chunk_context_list.end(); ++item)
 		{
-			_physical_port->DisconnectClient(dynamic_cast<ov::ClientSocket *>(item->first));
-			return true;
+			auto &chunk_stream = item->second->chunk_stream;
+
+			if (chunk_stream->GetAppName() == app_name && chunk_stream->GetStreamId() == stream_id)
+			{
+				remote = item->first;
+				break;
+			}
 		}
 	}
 
-	return false;
+	if (remote == nullptr)
+	{
+		return false;
+	}
+
+	_physical_port->DisconnectClient(dynamic_cast<ov::ClientSocket *>(remote));
+
+	return true;
+}
+
+std::shared_ptr<RtmpServer::ChunkContext> RtmpServer::FindChunkContext(ov::Socket *remote)
+{
+	std::unique_lock<std::recursive_mutex> lock(_chunk_context_list_mutex);
+
+	auto item = _chunk_context_list.find(remote);
+
+	return (item != _chunk_context_list.end()) ? item->second : nullptr;
 }
 
 void RtmpServer::OnConnected(const std::shared_ptr<ov::Socket> &remote)
@@ -127,23 +145,32 @@ void RtmpServer::OnConnected(const std::shared_ptr<ov::Socket> &remote)
 
 	std::unique_lock<std::recursive_mutex> lock(_chunk_context_list_mutex);
 
-	_chunk_context_list.emplace(remote.get(), std::make_shared<RtmpChunkStream>(dynamic_cast<ov::ClientSocket *>(remote.get()), this));
+	_chunk_context_list.emplace(remote.get(), std::make_shared<ChunkContext>(std::make_shared<RtmpChunkStream>(dynamic_cast<ov::ClientSocket *>(remote.get()), this)));
 } 
 
 void RtmpServer::OnDataReceived(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddress &address, const std::shared_ptr<const ov::Data> &data)
 {
-	if(_stat_stop_watch.IsElapsed(5000) && _stat_stop_watch.Update())
+	auto current_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	auto last_stat_time = _last_stat_time.load();
+
+	// Only the worker that wins the exchange logs the stats
+	if ((current_time - last_stat_time >= 5000) && _last_stat_time.compare_exchange_strong(last_stat_time, current_time))
 	{
 		logts("Stats for RTMP socket %s: %s", remote->ToString().CStr(), remote->GetStat().CStr());
 	}
 
-	std::unique_lock<std::recursive_mutex> lock(_chunk_context_list_mutex);
+	auto chunk_context = FindChunkContext(remote.get());
+
+	if (chunk_context == nullptr)
+	{
+		return;
+	}
 
-	auto item = _chunk_context_list.find(remote.get());
+	auto &chunk_stream = chunk_context->chunk_stream;
+	bool succeeded = true;
 
-	if (item != _chunk_context_list.end())
 	{
-		auto &chunk_stream = item->second;
+		std::unique_lock<std::recursive_mutex> lock(chunk_context->mutex);
 
 		if (remote->GetState() != ov::SocketState::Connected)
 		{
@@ -151,66 +178,57 @@ void RtmpServer::OnDataReceived(const std::shared_ptr<ov::Socket> &remote, const
 			return;
 		}
 
-		auto current_data = data->Clone();
-		bool succeeded = true;
-
-		while (current_data->IsEmpty() == false)
-		{
-			int32_t parsed_bytes = chunk_stream->OnDataReceived(data);
-
-			if (parsed_bytes < 0)
-			{
-				succeeded = false;
-				break;
-			}
-
-			current_data = current_data->Subdata(parsed_bytes);
-
-			if (parsed_bytes == 0)
-			{
-				OV_ASSERT2(current_data->IsEmpty());
-				break;
-			}
-		}
+		// RtmpChunkStream consumes all the data at once
+		succeeded = (chunk_stream->OnDataReceived(data) >= 0);
+	}
 
-		if (succeeded == false)
-		{
-			logti("An error occurred while process the RTMP packet: [%s/%s] (%u/%u), remote: %s, Disconnecting...",
-				  chunk_stream->GetAppName().CStr(), chunk_stream->GetStreamName().CStr(),
-				  chunk_stream->GetAppId(), chunk_stream->GetStreamId(),
-				  remote->ToString().CStr());
+	if (succeeded == false)
+	{
+		logti("An error occurred while process the RTMP packet: [%s/%s] (%u/%u), remote: %s, Disconnecting...",
+			  chunk_stream->GetAppName().CStr(), chunk_stream->GetStreamName().CStr(),
+			  chunk_stream->GetAppId(), chunk_stream->GetStreamId(),
+			  remote->ToString().CStr());
 
-			_physical_port->DisconnectClient(chunk_stream->GetRemoteSocket());
-		}
+		_physical_port->DisconnectClient(chunk_stream->GetRemoteSocket());
 	}
 }
 
 void RtmpServer::OnDisconnected(const std::shared_ptr<ov::Socket> &remote, PhysicalPortDisconnectReason reason, const std::shared_ptr<const ov::Error> &error)
 {
-	std::unique_lock<std::recursive_mutex> lock(_chunk_context_list_mutex);
+	std::shared_ptr<ChunkContext> chunk_context;
 
-	auto item = _chunk_context_list.find(remote.get());
-
-	if (item != _chunk_context_list.end())
 	{
-		auto &chunk_stream = item->second;
+		std::unique_lock<std::recursive_mutex> lock(_chunk_context_list_mutex);
 
-		// logte("chunk_stream->GetAppId() : %u, chunk_stream->GetStreamId() : %u", chunk_stream->GetAppId(), chunk_stream->GetStreamId());
-		// Stream Delete
-		if (chunk_stream->GetAppId() != info::InvalidApplicationId && chunk_stream->GetStreamId() != info::InvalidStreamId)
-		{
-			logti("The RTMP client is disconnected: [%s/%s] (%u/%u), remote: %s",
-			  chunk_stream->GetAppName().CStr(), chunk_stream->GetStreamName().CStr(),
-			  chunk_stream->GetAppId(), chunk_stream->GetStreamId(),
-			  remote->ToString().CStr());
+		auto item = _chunk_context_list.find(remote.get());
 
-			OnDeleteStream(chunk_stream->GetRemoteSocket(),
-						   chunk_stream->GetAppName(), chunk_stream->GetStreamName(),
-						   chunk_stream->GetAppId(), chunk_stream->GetStreamId());
+		if (item == _chunk_context_list.end())
+		{
+			return;
 		}
 
+		chunk_context = item->second;
 		_chunk_context_list.erase(item);
 	}
+
+	// Waits until the worker that is parsing the data of this client finishes
+	std::unique_lock<std::recursive_mutex> lock(chunk_context->mutex);
+
+	auto &chunk_stream = chunk_context->chunk_stream;
+
+	// logte("chunk_stream->GetAppId() : %u, chunk_stream->GetStreamId() : %u", chunk_stream->GetAppId(), chunk_stream->GetStreamId());
+	// Stream Delete
+	if (chunk_stream->GetAppId() != info::InvalidApplicationId && chunk_stream->GetStreamId() != info::InvalidStreamId)
+	{
+		logti("The RTMP client is disconnected: [%s/%s] (%u/%u), remote: %s",
+		  chunk_stream->GetAppName().CStr(), chunk_stream->GetStreamName().CStr(),
+		  chunk_stream->GetAppId(), chunk_stream->GetStreamId(),
+		  remote->ToString().CStr());
+
+		OnDeleteStream(chunk_stream->GetRemoteSocket(),
+					   chunk_stream->GetAppName(), chunk_stream->GetStreamName(),
+					   chunk_stream->GetAppId(), chunk_stream->GetStreamId());
+	}
 }
 
 bool RtmpServer::OnChunkStreamReady(ov::ClientSocket *remote,
@@ -226,6 +244,8 @@ bool RtmpServer::OnChunkStreamReady(ov::ClientSocket *remote,
 		  remote->ToString().CStr());
 
 
+	std::unique_lock<std::recursive_mutex> lock(_stream_event_mutex);
+
 	// Notify the ready stream event to the observers
 	for (auto &observer : _observers)
 	{
@@ -288,6 +308,8 @@ bool RtmpServer::OnDeleteStream(ov::ClientSocket *remote,
 								ov::String &app_name, ov::String &stream_name,
 								info::application_id_t application_id, uint32_t stream_id)
 {
+	std::unique_lock<std::recursive_mutex> lock(_stream_event_mutex);
+
 	// Notify the delete stream event to the observers
 	for (auto &observer : _observers)
 	{
@@ -322,7 +344,7 @@ ov::DelayQueueAction RtmpServer::OnGarbageCheck(void *parameter)
 
 		for (auto &item : _chunk_context_list)
 		{
-			auto &chunk_stream = item.second;
+			auto &chunk_stream = item.second->chunk_stream;
 			auto elapsed = current_time - chunk_stream->GetLastPacketTime();
 
 			if (elapsed > MAX_STREAM_PACKET_GAP)
@@ -332,7 +354,7 @@ ov::DelayQueueAction RtmpServer::OnGarbageCheck(void *parameter)
 					  chunk_stream->GetAppId(), chunk_stream->GetStreamId(),
 					  elapsed, MAX_STREAM_PACKET_GAP);
 
-				garbage_list.emplace(item);
+				garbage_list.emplace(item.first, chunk_stream);
 			}
 		}
 	}
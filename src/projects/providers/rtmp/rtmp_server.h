@@ -11,7 +11,9 @@
 #include "rtmp_chunk_stream.h"
 #include "rtmp_observer.h"
 
+#include <atomic>
 #include <map>
+#include <mutex>
 
 #include <base/ovsocket/ovsocket.h>
 #include <modules/physical_port/physical_port_manager.h>
@@ -22,7 +24,7 @@ public:
     RtmpServer() = default;
     virtual ~RtmpServer();
 
-    bool Start(const ov::SocketAddress &address);
+    bool Start(const ov::SocketAddress &address, int worker_count = 1);
     bool Stop();
     bool AddObserver(const std::shared_ptr<RtmpObserver> &observer);
     bool RemoveObserver(const std::shared_ptr<RtmpObserver> &observer);
@@ -74,10 +76,31 @@ private:
 
 	std::vector<std::shared_ptr<RtmpObserver>> _observers;
 
+	struct ChunkContext
+	{
+		ChunkContext(const std::shared_ptr<RtmpChunkStream> &chunk_stream)
+			: chunk_stream(chunk_stream)
+		{
+		}
+
+		std::shared_ptr<RtmpChunkStream> chunk_stream;
+		// Serializes the parsing of a connection with its disconnection (recursive, since a callback of the parser can disconnect the client)
+		std::recursive_mutex mutex;
+	};
+
+	std::shared_ptr<ChunkContext> FindChunkContext(ov::Socket *remote);
+
+	// Guards only the lookup/insertion/deletion of _chunk_context_list, so the workers of the shards parse the chunks in parallel
 	std::recursive_mutex _chunk_context_list_mutex;
-	std::map<ov::Socket *, std::shared_ptr<RtmpChunkStream>> _chunk_context_list;
+	std::map<ov::Socket *, std::shared_ptr<ChunkContext>> _chunk_context_list;
+
+	// The stream ready/delete events are called from the workers of all shards at the same time.
+	// They are serialized, since the observers check the duplicated stream name and create the stream in one step.
+	// (Recursive, since an observer can disconnect the other client of the duplicated stream name)
+	std::recursive_mutex _stream_event_mutex;
 
 	ov::DelayQueue _garbage_check_timer;
 
-	ov::StopWatch _stat_stop_watch;
+	// The last time the socket stats were logged (in milliseconds, shared by the workers of all shards)
+	std::atomic<int64_t> _last_stat_time{0};
 };
@@ -194,7 +194,7 @@ public:
                     // something has gone wrong
                     return 0;
                 }
-                T::rtsp_server_.OnAudioData(T::stream_id_,
+                T::observer_.OnAudioData(T::stream_id_,
                     T::track_id_,
                     fragmented_access_unit_timestamp_ - T::first_timestamp_,
                     fragmented_access_unit_);
@@ -214,7 +214,7 @@ public:
             auto media_packet = std::make_shared<std::vector<uint8_t>>(frame_size);
             memcpy(media_packet->data(), &adts_header_, sizeof(adts_header_));
             memcpy(media_packet->data() + sizeof(adts_header_), access_unit_payload, access_unit.size_);
-            T::rtsp_server_.OnAudioData(T::stream_id_,
+            T::observer_.OnAudioData(T::stream_id_,
                 T::track_id_,
                 base_timestamp + access_unit.index_ * constant_duration_,
                 media_packet);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../rtsp_library.h"
+#include "../rtsp.h"
 #include "rtp.h"
 
 #include <modules/h264/h264.h>
@@ -159,7 +160,7 @@ protected:
                             In some scenarios a STAP-A packet can contain multiple slices, if so, push them up
                             as separate media packets
                         */
-                       T::rtsp_server_.OnVideoData(T::stream_id_,
+                       T::observer_.OnVideoData(T::stream_id_,
                             T::track_id_,
                             rtp_packet_header.timestamp_ - T::first_timestamp_,
                             media_packet,
@@ -273,7 +274,7 @@ protected:
         }
         if (media_packet && media_packet->empty() == false)
         {
-            T::rtsp_server_.OnVideoData(T::stream_id_,
+            T::observer_.OnVideoData(T::stream_id_,
                 T::track_id_,
                 rtp_packet_header.timestamp_ - T::first_timestamp_,
                 media_packet,
@@ -0,0 +1,160 @@
+#include "rtp_jitter_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+RtpJitterBuffer::RtpJitterBuffer(uint32_t clock_frequency, bool discard_incomplete_frames) : clock_frequency_(clock_frequency),
+    discard_incomplete_frames_(discard_incomplete_frames)
+{
+    statistics_.target_delay_msec_ = target_delay_msec_;
+}
+
+void RtpJitterBuffer::AddPacket(const Packet &rtp_packet, Clock::time_point arrival_time, std::vector<Packet> &released_packets)
+{
+    if (rtp_packet->size() < RtpPacketHeaderSize)
+    {
+        return;
+    }
+    const uint8_t (&rtp_header_bytes)[RtpPacketHeaderSize] = reinterpret_cast<const uint8_t(&)[RtpPacketHeaderSize]>(*rtp_packet->data());
+    const auto rtp_packet_header = RtpPacketHeaderFromData(rtp_header_bytes);
+
+    statistics_.received_packets_++;
+
+    int64_t sequence_number = rtp_packet_header.sequence_number_;
+    if (first_packet_ || rtp_packet_header.ssrc_ != ssrc_)
+    {
+        Reset(sequence_number, rtp_packet_header.ssrc_, released_packets);
+    }
+    else
+    {
+        // Distance from the highest sequence number, considering the wraparound
+        const int32_t delta = static_cast<int16_t>(static_cast<uint16_t>(rtp_packet_header.sequence_number_ - static_cast<uint16_t>(highest_sequence_number_)));
+        if (delta > max_dropout || delta < -max_misorder)
+        {
+            Reset(sequence_number, rtp_packet_header.ssrc_, released_packets);
+        }
+        else
+        {
+            sequence_number = highest_sequence_number_ + delta;
+        }
+    }
+
+    if (sequence_number < next_sequence_number_)
+    {
+        statistics_.late_packets_++;
+        return;
+    }
+    if (packets_.find(sequence_number) != packets_.end())
+    {
+        statistics_.duplicated_packets_++;
+        return;
+    }
+
+    if (sequence_number < highest_sequence_number_)
+    {
+        statistics_.reordered_packets_++;
+    }
+    else
+    {
+        highest_sequence_number_ = sequence_number;
+        // Reordered packets are excluded from the jitter, since their delay is not the variation of the network
+        UpdateJitter(rtp_packet_header.timestamp_, arrival_time);
+    }
+
+    packets_.emplace(sequence_number, Entry { rtp_packet, rtp_packet_header.marker_ == 1, arrival_time });
+    ReleasePackets(arrival_time, false, released_packets);
+}
+
+void RtpJitterBuffer::Flush(Clock::time_point now, std::vector<Packet> &released_packets)
+{
+    ReleasePackets(now, false, released_packets);
+}
+
+const RtpJitterBuffer::Statistics &RtpJitterBuffer::GetStatistics() const
+{
+    return statistics_;
+}
+
+void RtpJitterBuffer::Reset(int64_t sequence_number, uint32_t ssrc, std::vector<Packet> &released_packets)
+{
+    // The packets of the previous sequence are older than the new one
+    ReleasePackets(Clock::time_point(), true, released_packets);
+
+    first_packet_ = false;
+    ssrc_ = ssrc;
+    highest_sequence_number_ = sequence_number;
+    next_sequence_number_ = sequence_number;
+    discarding_frame_ = false;
+    has_last_arrival_ = false;
+}
+
+void RtpJitterBuffer::UpdateJitter(uint32_t timestamp, Clock::time_point arrival_time)
+{
+    if (clock_frequency_ == 0)
+    {
+        return;
+    }
+
+    if (has_last_arrival_ == false)
+    {
+        base_time_ = arrival_time;
+    }
+
+    // Arrival time in timestamp units
+    const int64_t arrival = std::chrono::duration_cast<std::chrono::microseconds>(arrival_time - base_time_).count() * clock_frequency_ / 1000000;
+
+    if (has_last_arrival_)
+    {
+        // D(i-1, i) = (Rj - Ri) - (Sj - Si)
+        const int64_t difference = (arrival - last_arrival_) - static_cast<int32_t>(timestamp - last_timestamp_);
+        jitter_ += (std::abs(static_cast<double>(difference)) - jitter_) / 16.0;
+
+        statistics_.jitter_msec_ = jitter_ * 1000.0 / clock_frequency_;
+        target_delay_msec_ = static_cast<uint32_t>(std::clamp(statistics_.jitter_msec_ * delay_factor, static_cast<double>(min_delay_msec), static_cast<double>(max_delay_msec)));
+        statistics_.target_delay_msec_ = target_delay_msec_;
+    }
+
+    has_last_arrival_ = true;
+    last_arrival_ = arrival;
+    last_timestamp_ = timestamp;
+}
+
+void RtpJitterBuffer::ReleasePackets(Clock::time_point now, bool release_all, std::vector<Packet> &released_packets)
+{
+    while (packets_.empty() == false)
+    {
+        auto item = packets_.begin();
+        if (item->first != next_sequence_number_)
+        {
+            // Waits for the missing packets
+            if (release_all == false &&
+                packets_.size() < max_packets &&
+                now - item->second.arrival_time_ < std::chrono::milliseconds(target_delay_msec_))
+            {
+                break;
+            }
+            statistics_.lost_packets_ += item->first - next_sequence_number_;
+            next_sequence_number_ = item->first;
+            if (discard_incomplete_frames_)
+            {
+                discarding_frame_ = true;
+            }
+        }
+
+        auto entry = std::move(item->second);
+        packets_.erase(item);
+        next_sequence_number_++;
+
+        if (discarding_frame_)
+        {
+            statistics_.discarded_packets_++;
+            // The next packet starts a new frame
+            if (entry.marker_)
+            {
+                discarding_frame_ = false;
+            }
+            continue;
+        }
+        released_packets.emplace_back(std::move(entry.packet_));
+    }
+}
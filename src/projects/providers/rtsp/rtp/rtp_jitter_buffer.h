@@ -0,0 +1,97 @@
+#pragma once
+
+#include "rtp_packet_header.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+/*
+    Reorders the RTP packets received over UDP by the sequence number before they are depacketized.
+
+    Packets are released as soon as they are in order. When a sequence number is missing, the packets after it wait up to
+    the target delay, which adapts to the interarrival jitter (RFC 3550 6.4.1). After that the missing packets are counted
+    as lost, and for video the rest of the damaged frame is discarded up to the marker bit, so that the depacketizer
+    restarts from the next frame instead of producing a corrupted one.
+
+    The timeout is checked when a packet is added, and by Flush() which the owner calls from a timer (RtpUdpTrack uses
+    a timer shared by all the tracks, and RtspcClient uses the timer of its event loop), so that the packets after a lost
+    one are not held until the next packet arrives.
+*/
+class RtpJitterBuffer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Packet = std::shared_ptr<std::vector<uint8_t>>;
+
+    struct Statistics
+    {
+        uint64_t received_packets_ = 0;
+        uint64_t lost_packets_ = 0;
+        // Arrived after a packet with a higher sequence number
+        uint64_t reordered_packets_ = 0;
+        uint64_t duplicated_packets_ = 0;
+        // Arrived after its sequence number was counted as lost
+        uint64_t late_packets_ = 0;
+        // Discarded since they belong to a frame that lost packets
+        uint64_t discarded_packets_ = 0;
+        double jitter_msec_ = 0.0;
+        uint32_t target_delay_msec_ = 0;
+    };
+
+    static constexpr uint32_t min_delay_msec = 20;
+    static constexpr uint32_t max_delay_msec = 500;
+    // Target delay = jitter * delay_factor
+    static constexpr double delay_factor = 4.0;
+    // If more packets than this are waiting, the missing packets are counted as lost without waiting for the target delay
+    static constexpr size_t max_packets = 1024;
+    // A jump of the sequence number larger than these is regarded as the restart of the sender (RFC 3550 A.1)
+    static constexpr int32_t max_dropout = 3000;
+    static constexpr int32_t max_misorder = 100;
+
+    RtpJitterBuffer(uint32_t clock_frequency, bool discard_incomplete_frames);
+    RtpJitterBuffer(const RtpJitterBuffer&) = delete;
+
+    // Appends the packets that can be depacketized to released_packets in order
+    void AddPacket(const Packet &rtp_packet, Clock::time_point arrival_time, std::vector<Packet> &released_packets);
+    // Releases the packets whose missing packets are timed out
+    void Flush(Clock::time_point now, std::vector<Packet> &released_packets);
+
+    const Statistics &GetStatistics() const;
+
+private:
+    struct Entry
+    {
+        Packet packet_;
+        bool marker_;
+        Clock::time_point arrival_time_;
+    };
+
+    void Reset(int64_t sequence_number, uint32_t ssrc, std::vector<Packet> &released_packets);
+    void UpdateJitter(uint32_t timestamp, Clock::time_point arrival_time);
+    void ReleasePackets(Clock::time_point now, bool release_all, std::vector<Packet> &released_packets);
+
+private:
+    uint32_t clock_frequency_;
+    bool discard_incomplete_frames_;
+
+    bool first_packet_ = true;
+    uint32_t ssrc_ = 0;
+    // Sequence numbers below are extended to 64 bits, so they do not wrap around
+    int64_t highest_sequence_number_ = 0;
+    int64_t next_sequence_number_ = 0;
+    std::map<int64_t, Entry> packets_;
+    bool discarding_frame_ = false;
+
+    // RFC 3550 6.4.1 (in timestamp units)
+    Clock::time_point base_time_;
+    bool has_last_arrival_ = false;
+    int64_t last_arrival_ = 0;
+    uint32_t last_timestamp_ = 0;
+    double jitter_ = 0.0;
+    uint32_t target_delay_msec_ = min_delay_msec;
+
+    Statistics statistics_;
+};
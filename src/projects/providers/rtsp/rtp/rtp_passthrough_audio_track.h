@@ -11,7 +11,7 @@ public:
     {
         if (rtp_payload_length)
         {
-            T::rtsp_server_.OnAudioData(T::stream_id_,
+            T::observer_.OnAudioData(T::stream_id_,
                 T::track_id_,
                 rtp_packet_header.timestamp_ - T::first_timestamp_,
                 std::make_shared<std::vector<uint8_t>>(rtp_payload, rtp_payload + rtp_payload_length));
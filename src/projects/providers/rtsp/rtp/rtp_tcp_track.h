@@ -8,12 +8,10 @@
 
 #include <memory>
 
-class RtspServer;
-
 class RtpTcpTrack : public RtpTrack
 {
 public:
-    RtpTcpTrack(RtspServer& rtsp_server,
+    RtpTcpTrack(RtpTrackObserver &observer,
         common::MediaType media_type,
         common::MediaCodecId media_codec_id,
         uint32_t stream_id,
@@ -25,7 +23,7 @@ public:
     bool AddPacket(uint8_t channel, const std::shared_ptr<std::vector<uint8_t>> &packet);
 
     template<typename U>
-    static std::unique_ptr<U> Create(RtspServer &rtsp_server,
+    static std::unique_ptr<U> Create(RtpTrackObserver &observer,
         common::MediaType media_type,
         common::MediaCodecId media_codec_id,
         uint32_t stream_id,
@@ -34,7 +32,7 @@ public:
         uint16_t rtp_channel,
         uint16_t rtcp_channel)
     {
-        return std::make_unique<U>(rtsp_server, media_type, media_codec_id, stream_id, track_id, clock_frequency, rtp_channel, rtcp_channel);
+        return std::make_unique<U>(observer, media_type, media_codec_id, stream_id, track_id, clock_frequency, rtp_channel, rtcp_channel);
     }
 
 private:
@@ -2,18 +2,17 @@
 
 #include "../rtsp_library.h"
 #include "rtp_packet_header.h"
+#include "rtp_track_observer.h"
 
 #include <base/common_types.h>
 #include <base/info/media_track.h>
 
 #include <optional>
 
-class RtspServer;
-
 class RtpTrack
 {
 public:
-    RtpTrack(RtspServer &rtsp_server_, common::MediaType media_type, common::MediaCodecId media_codec_id, uint32_t stream_id, uint8_t track_id, uint32_t clock_frequency);
+    RtpTrack(RtpTrackObserver &observer, common::MediaType media_type, common::MediaCodecId media_codec_id, uint32_t stream_id, uint8_t track_id, uint32_t clock_frequency);
     RtpTrack(const RtpTrack&) = delete;
 
     virtual ~RtpTrack() = default;
@@ -29,7 +28,7 @@ protected:
     virtual bool AddRtpPayload(const RtpPacketHeader &rtp_packet_header, uint8_t *rtp_payload, size_t rtp_payload_length) = 0;
 
 protected:
-    RtspServer &rtsp_server_;
+    RtpTrackObserver &observer_;
     common::MediaType media_type_;
     common::MediaCodecId media_codec_id_; 
     uint32_t stream_id_;
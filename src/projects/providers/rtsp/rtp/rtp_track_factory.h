@@ -0,0 +1,134 @@
+#pragma once
+
+#include "../rtsp_library.h"
+#include "../sdp_format_parameters.h"
+#include "rtp_track_observer.h"
+#include "rtp_h264_track.h"
+#include "rtp_opus_track.h"
+#include "rtp_mpeg4_track.h"
+#include "rtp_aac_track.h"
+
+#include <base/info/media_track.h>
+#include <modules/h264/h264_nal_unit_types.h>
+
+#include <memory>
+
+/*
+    Creates the depacketizer of the codec of media_track on top of the transport T (RtpTcpTrack or RtpUdpTrack),
+    args are passed to T::Create() after the common track parameters
+*/
+template<typename T, typename ... Args>
+std::unique_ptr<T> CreateRtpTrack(const MediaTrack &media_track,
+    const std::shared_ptr<SdpFormatParameters> &sdp_format_parameters,
+    uint32_t stream_id,
+    RtpTrackObserver &observer,
+    Args && ... args)
+{
+    std::unique_ptr<T> rtp_track;
+    const auto media_type = media_track.GetMediaType();
+    const auto media_codec = media_track.GetCodecId();
+    OV_ASSERT2(media_track.GetTimeBase().GetNum() == 1);
+    if (media_track.GetTimeBase().GetNum() != 1)
+    {
+        return nullptr;
+    }
+    int32_t clock_frequency = media_track.GetTimeBase().GetDen();
+    OV_ASSERT2(clock_frequency > 0);
+    if (clock_frequency <= 0)
+    {
+        return nullptr;
+    }
+    switch (media_type)
+    {
+    case common::MediaType::Video:
+    case common::MediaType::Audio:
+        switch (media_codec)
+        {
+        case common::MediaCodecId::H264:
+            {
+                using TrackType = RtpH264Track<T>;
+                auto rtp_h264_track = TrackType::template Create<TrackType>(observer,
+                    media_type,
+                    media_codec,
+                    stream_id,
+                    media_track.GetId(),
+                    static_cast<uint32_t>(clock_frequency),
+                    std::forward<Args>(args) ...);
+                if (rtp_h264_track &&
+                    sdp_format_parameters &&
+                    sdp_format_parameters->GetType() == SdpFormatParameters::Type::H264)
+                {
+                    auto const &h264_sdp_format_parameters = *static_cast<H264SdpFormatParameters*>(sdp_format_parameters.get());
+                    auto &h264_sps_pps_tracker = rtp_h264_track->GetH264SpsPpsTracker();
+#if defined(PARANOID_STREAM_VALIDATION)
+                    auto &h264_bitstream_analyzer = rtp_h264_track->GetH264BitstreamAnalyzer();
+#endif
+                    {
+                        const auto &sps = h264_sdp_format_parameters.sps_;
+                        if (sps.empty() == false)
+                        {
+                            h264_sps_pps_tracker.AddSps(sps.data(), sps.size());
+#if defined(PARANOID_STREAM_VALIDATION)
+                            h264_bitstream_analyzer.ValidateNalUnit(sps.data() + 1, sps.size() - 1, H264NalUnitType::Sps, *sps.data());
+#endif
+                        }
+                    }
+                    {
+                        const auto &pps = h264_sdp_format_parameters.pps_;
+                        if (pps.empty() == false)
+                        {
+                            h264_sps_pps_tracker.AddPps(pps.data(), pps.size());
+#if defined(PARANOID_STREAM_VALIDATION)
+                            h264_bitstream_analyzer.ValidateNalUnit(pps.data() + 1, pps.size() - 1, H264NalUnitType::Pps, *pps.data());
+#endif
+                        }
+                    }
+                }
+                rtp_track.reset(static_cast<T*>(rtp_h264_track.release()));
+            }
+            break;
+        case common::MediaCodecId::Opus:
+            {
+                using TrackType = RtpOpusTrack<T>;
+                rtp_track = TrackType::template Create<TrackType>(observer,
+                    media_type,
+                    media_codec,
+                    stream_id,
+                    media_track.GetId(),
+                    static_cast<uint32_t>(clock_frequency),
+                    std::forward<Args>(args) ...);
+            }
+            break;
+        case common::MediaCodecId::Aac:
+            {
+                using TrackType = RtpAacTrack<T>;
+                auto rtp_aac_track = TrackType::template Create<TrackType>(observer,
+                    media_type,
+                    media_codec,
+                    stream_id,
+                    media_track.GetId(),
+                    static_cast<uint32_t>(clock_frequency),
+                    std::forward<Args>(args) ...);
+                if (rtp_aac_track &&
+                    sdp_format_parameters &&
+                    sdp_format_parameters->GetType() == SdpFormatParameters::Type::Mpeg4)
+                {
+                    auto const &aac_sdp_format_parameters = *static_cast<Mpeg4SdpFormatParameters*>(sdp_format_parameters.get());
+                    rtp_aac_track->SetSdpFormatParameters(aac_sdp_format_parameters);
+                }
+                rtp_track.reset(static_cast<T*>(rtp_aac_track.release()));
+            }
+            break;
+        default:
+            break;
+        }
+        break;
+    default:
+        break;
+    }
+    if (rtp_track && rtp_track->Initialize(media_track) == false)
+    {
+        rtp_track.reset();
+    }
+    return rtp_track;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../rtcp/rtcp_packet_header.h"
+
+#include <base/common_types.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+    Receives the depacketized media of the RTP tracks, so that the tracks can be used by both
+    the RTSP server (ANNOUNCE/RECORD) and the RTSP pull client
+*/
+class RtpTrackObserver
+{
+public:
+    virtual ~RtpTrackObserver() = default;
+
+    virtual bool OnVideoData(uint32_t stream_id,
+        uint8_t track_id,
+        uint32_t timestamp,
+        const std::shared_ptr<std::vector<uint8_t>> &data,
+        uint8_t flags,
+        std::unique_ptr<FragmentationHeader> fragmentation_header) = 0;
+    virtual bool OnAudioData(uint32_t stream_id,
+        uint8_t track_id,
+        uint32_t timestamp,
+        const std::shared_ptr<std::vector<uint8_t>> &data) = 0;
+    virtual void OnRtcpSenderReport(uint32_t stream_id,
+        uint8_t track_id,
+        const RtcpSenderReport &rtcp_sender_report) = 0;
+};
@@ -1,7 +1,74 @@
+#define OV_LOG_TAG "RtpUdpTrack"
+
 #include "rtp_udp_track.h"
 
 #include <modules/physical_port/physical_port_manager.h>
 
+#include <base/ovlibrary/delay_queue.h>
+
+#include <cinttypes>
+#include <unordered_set>
+
+namespace
+{
+    /*
+        Flushes the jitter buffers of all the RtpUdpTracks with one timer, so that the packets after a lost one are released
+        when the target delay expires, instead of waiting for the next packet of the track.
+    */
+    class RtpUdpTrackFlusher
+    {
+    public:
+        // Less than the minimum delay of RtpJitterBuffer
+        static constexpr int flush_interval_msec = RtpJitterBuffer::min_delay_msec / 2;
+
+        static RtpUdpTrackFlusher &Instance()
+        {
+            // Never released, since the timer can run while the static objects are being destroyed
+            static auto instance = new RtpUdpTrackFlusher();
+            return *instance;
+        }
+
+        void Add(RtpUdpTrack *track)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tracks_.insert(track);
+
+            if (is_started_ == false)
+            {
+                delay_queue_.Push([this](void *parameter) -> ov::DelayQueueAction {
+                    Flush();
+                    return ov::DelayQueueAction::Repeat;
+                }, flush_interval_msec);
+                delay_queue_.Start();
+                is_started_ = true;
+            }
+        }
+
+        // The track is not flushed after this returns
+        void Remove(RtpUdpTrack *track)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tracks_.erase(track);
+        }
+
+    private:
+        void Flush()
+        {
+            const auto now = RtpJitterBuffer::Clock::now();
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto *track : tracks_)
+            {
+                track->FlushJitterBuffer(now);
+            }
+        }
+
+        std::mutex mutex_;
+        std::unordered_set<RtpUdpTrack *> tracks_;
+        ov::DelayQueue delay_queue_;
+        bool is_started_ = false;
+    };
+}
+
 RtpUdpTrack::ConnectionObserver::ConnectionObserver(RtpUdpTrack &track) : track_(track)
 {
 }
@@ -21,9 +88,8 @@ void RtpUdpTrack::RtpConnectionObserver::OnDataReceived(const std::shared_ptr<ov
     const std::shared_ptr<const ov::Data> &data)
 
 {
-    // TODO(rubu): Add jitter buffer for UDP packet reordering
     const auto *rtp_packet = data->GetDataAs<uint8_t>();
-    track_.AddRtpPacket(std::make_shared<std::vector<uint8_t>>(rtp_packet, rtp_packet + data->GetLength()));
+    track_.AddReceivedRtpPacket(std::make_shared<std::vector<uint8_t>>(rtp_packet, rtp_packet + data->GetLength()));
 }
 
 void RtpUdpTrack::RtcpConnectionObserver::OnDataReceived(const std::shared_ptr<ov::Socket> &remote,
@@ -32,26 +98,83 @@ void RtpUdpTrack::RtcpConnectionObserver::OnDataReceived(const std::shared_ptr<o
 {
 }
 
+void RtpUdpTrack::AddReceivedRtpPacket(const std::shared_ptr<std::vector<uint8_t>> &rtp_packet)
+{
+    // UDP packets can be reordered or lost, so they are depacketized after passing through the jitter buffer
+    const auto now = RtpJitterBuffer::Clock::now();
+    std::lock_guard<std::mutex> lock(jitter_buffer_mutex_);
+    released_packets_.clear();
+    jitter_buffer_.AddPacket(rtp_packet, now, released_packets_);
+    AddReleasedPackets(now);
+}
+
+void RtpUdpTrack::FlushJitterBuffer(RtpJitterBuffer::Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(jitter_buffer_mutex_);
+    released_packets_.clear();
+    jitter_buffer_.Flush(now, released_packets_);
+    AddReleasedPackets(now);
+}
+
+RtpJitterBuffer::Statistics RtpUdpTrack::GetJitterBufferStatistics()
+{
+    std::lock_guard<std::mutex> lock(jitter_buffer_mutex_);
+    return jitter_buffer_.GetStatistics();
+}
+
+void RtpUdpTrack::AddReleasedPackets(RtpJitterBuffer::Clock::time_point now)
+{
+    for (const auto &released_packet : released_packets_)
+    {
+        AddRtpPacket(released_packet);
+    }
+
+    if (now - last_statistics_time_ >= statistics_interval)
+    {
+        const auto &statistics = jitter_buffer_.GetStatistics();
+        logts("Stream %u track %u: received %" PRIu64 ", lost %" PRIu64 ", reordered %" PRIu64 ", duplicated %" PRIu64 ", late %" PRIu64 ", discarded %" PRIu64 ", jitter %.2fms, delay %ums",
+            stream_id_,
+            track_id_,
+            statistics.received_packets_,
+            statistics.lost_packets_,
+            statistics.reordered_packets_,
+            statistics.duplicated_packets_,
+            statistics.late_packets_,
+            statistics.discarded_packets_,
+            statistics.jitter_msec_,
+            statistics.target_delay_msec_);
+        last_statistics_time_ = now;
+    }
+}
+
 void RtpUdpTrack::GetServerPorts(uint16_t &rtp_port, uint16_t &rtcp_port)
 {
     rtp_port = rtp_physical_port_->GetAddress().Port();
     rtcp_port = rtcp_physical_port_->GetAddress().Port();
 }
 
-RtpUdpTrack::RtpUdpTrack(RtspServer &rtsp_server,
+RtpUdpTrack::RtpUdpTrack(RtpTrackObserver &observer,
     common::MediaType media_type,
     common::MediaCodecId media_codec_id,
     uint32_t stream_id,
     uint8_t track_id,
     uint32_t clock_frequency,
     std::shared_ptr<PhysicalPort> rtp_physical_port,
-    std::shared_ptr<PhysicalPort> rtcp_physical_port) : RtpTrack(rtsp_server, media_type, media_codec_id, stream_id, track_id, clock_frequency),
+    std::shared_ptr<PhysicalPort> rtcp_physical_port) : RtpTrack(observer, media_type, media_codec_id, stream_id, track_id, clock_frequency),
     rtp_physical_port_(rtp_physical_port),
     rtcp_physical_port_(rtcp_physical_port),
     rtp_observer_(*this),
-    rtcp_observer_(*this)
+    rtcp_observer_(*this),
+    jitter_buffer_(clock_frequency, media_type == common::MediaType::Video),
+    last_statistics_time_(RtpJitterBuffer::Clock::now())
 {
     rtp_physical_port_->AddObserver(&rtp_observer_);
     rtcp_physical_port_->AddObserver(&rtcp_observer_);
+    RtpUdpTrackFlusher::Instance().Add(this);
+}
+
+RtpUdpTrack::~RtpUdpTrack()
+{
+    RtpUdpTrackFlusher::Instance().Remove(this);
 }
 
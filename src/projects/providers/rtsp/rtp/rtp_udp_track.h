@@ -1,12 +1,13 @@
 #pragma once
 
 #include "rtp_track.h"
+#include "rtp_jitter_buffer.h"
 
 #include <modules/physical_port/physical_port.h>
 #include <modules/physical_port/physical_port_manager.h>
 #include <base/ovsocket/port_range.h>
 
-class RtspServer;
+#include <mutex>
 
 class RtpUdpTrack : public RtpTrack
 {
@@ -49,7 +50,7 @@ class RtpUdpTrack : public RtpTrack
     };
 
 public:
-    RtpUdpTrack(RtspServer &rtsp_server,
+    RtpUdpTrack(RtpTrackObserver &observer,
         common::MediaType media_type,
         common::MediaCodecId media_codec_id,
         uint32_t stream_id,
@@ -58,12 +59,16 @@ public:
         std::shared_ptr<PhysicalPort> rtp_physical_port,
         std::shared_ptr<PhysicalPort> rtcp_physical_port);
     RtpUdpTrack(const RtpUdpTrack&) = delete;
+    ~RtpUdpTrack();
 
 public:
     void GetServerPorts(uint16_t &rtp_port, uint16_t &rtcp_port);
+    // Releases the packets whose missing packets are timed out (called by the timer of RtpUdpTrackFlusher)
+    void FlushJitterBuffer(RtpJitterBuffer::Clock::time_point now);
+    RtpJitterBuffer::Statistics GetJitterBufferStatistics();
 
     template< typename U, ov::SocketType socket_type>
-    static std::unique_ptr<U> Create(RtspServer &rtsp_server,
+    static std::unique_ptr<U> Create(RtpTrackObserver &observer,
         common::MediaType media_type,
         common::MediaCodecId media_codec_id,
         uint32_t stream_id,
@@ -96,14 +101,27 @@ public:
 
         if (rtp_physical_port && rtcp_physical_port)
         {
-            return std::make_unique<U>(rtsp_server, media_type, media_codec_id, stream_id, track_id, clock_frequency, rtp_physical_port, rtcp_physical_port);
+            return std::make_unique<U>(observer, media_type, media_codec_id, stream_id, track_id, clock_frequency, rtp_physical_port, rtcp_physical_port);
         }
         return nullptr;
     }
 
 private:
+    void AddReceivedRtpPacket(const std::shared_ptr<std::vector<uint8_t>> &rtp_packet);
+    // Called with jitter_buffer_mutex_
+    void AddReleasedPackets(RtpJitterBuffer::Clock::time_point now);
+
+private:
+    // Interval of logging the statistics of the jitter buffer
+    static constexpr auto statistics_interval = std::chrono::seconds(10);
+
     std::shared_ptr<PhysicalPort> rtp_physical_port_;
     std::shared_ptr<PhysicalPort> rtcp_physical_port_;
     RtpConnectionObserver rtp_observer_;
     RtcpConnectionObserver rtcp_observer_;
+    // The jitter buffer is used by the thread of the physical port and the timer
+    std::mutex jitter_buffer_mutex_;
+    RtpJitterBuffer jitter_buffer_;
+    std::vector<RtpJitterBuffer::Packet> released_packets_;
+    RtpJitterBuffer::Clock::time_point last_statistics_time_;
 };
\ No newline at end of file
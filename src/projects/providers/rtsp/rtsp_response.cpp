@@ -1,6 +1,137 @@
 #include "rtsp_response.h"
 
-RtspResponse::RtspResponse(uint16_t status, uint32_t cseq) : status_(status),
-    cseq_(cseq)
+#include <base/ovlibrary/stl.h>
+
+#include <string>
+#include <cstring>
+
+RtspResponse::RtspResponse(std::vector<uint8_t> data) : data_(std::move(data))
+{
+}
+
+const std::vector<uint8_t> &RtspResponse::GetData() const
+{
+    return data_;
+}
+
+uint16_t RtspResponse::GetStatus() const
+{
+    return status_;
+}
+
+const std::string_view &RtspResponse::GetReason() const
+{
+    return reason_;
+}
+
+uint32_t RtspResponse::GetCSeq() const
+{
+    return cseq_;
+}
+
+size_t RtspResponse::GetContentLength() const
+{
+    return content_length_;
+}
+
+const std::vector<uint8_t> &RtspResponse::GetBody() const
+{
+    return body_;
+}
+
+void RtspResponse::SetBody(std::vector<uint8_t> body)
+{
+    body_ = std::move(body);
+}
+
+std::string_view RtspResponse::GetHeader(const std::string_view &header_name) const
+{
+    for (const auto &header : headers_)
+    {
+        if (CaseInsensitiveEqual(header.first, header_name))
+        {
+            return header.second;
+        }
+    }
+    return std::string_view();
+}
+
+const std::unordered_map<std::string_view, std::string_view> &RtspResponse::GetHeaders() const
+{
+    return headers_;
+}
+
+std::unique_ptr<RtspResponse> RtspResponse::Parse(std::vector<uint8_t> data)
 {
-}
\ No newline at end of file
+    auto rtsp_response = std::make_unique<RtspResponse>(std::move(data));
+    constexpr char line_end_marker[] = {'\r', '\n'};
+    const uint8_t *line_start_position = rtsp_response->data_.data(),
+        *response_end_position = rtsp_response->data_.data() + rtsp_response->data_.size(),
+        *line_end_position = nullptr;
+    bool is_status_line = true;
+    bool continue_parsing = true;
+    while (continue_parsing)
+    {
+        line_end_position = reinterpret_cast<const uint8_t*>(memmem(line_start_position, response_end_position - line_start_position, line_end_marker, sizeof(line_end_marker)));
+        if (line_end_position == nullptr)
+        {
+            line_end_position = response_end_position;
+            continue_parsing = false;
+        }
+        std::string_view line(reinterpret_cast<const char*>(line_start_position), line_end_position - line_start_position);
+        if (is_status_line)
+        {
+            // RTSP/1.0 <status code> <reason phrase>
+            constexpr char version_prefix[] = { 'R', 'T', 'S', 'P', '/' };
+            if (HasSubstring(line, 0, version_prefix) == false)
+            {
+                return nullptr;
+            }
+            auto space_position = line.find(' ');
+            if (space_position == std::string_view::npos)
+            {
+                return nullptr;
+            }
+            const auto status_start_position = line.find_first_not_of(' ', space_position + 1);
+            if (status_start_position == std::string_view::npos)
+            {
+                return nullptr;
+            }
+            space_position = line.find(' ', status_start_position);
+            auto status = line.substr(status_start_position, space_position == std::string_view::npos ? std::string_view::npos : space_position - status_start_position);
+            if (Stoi(std::string(status.data(), status.size()), rtsp_response->status_) == false)
+            {
+                return nullptr;
+            }
+            if (space_position != std::string_view::npos)
+            {
+                rtsp_response->reason_ = Trim(line.substr(space_position + 1));
+            }
+            is_status_line = false;
+        }
+        else
+        {
+            auto colon_position = line.find(':');
+            if (colon_position != std::string_view::npos)
+            {
+                std::string_view header_name = Trim(line.substr(0, colon_position));
+                std::string_view header_value = Trim(line.substr(colon_position + 1));
+                if (CaseInsensitiveEqual(header_name, "CSeq"))
+                {
+                    Stoi(std::string(header_value.data(), header_value.size()), rtsp_response->cseq_);
+                }
+                else if (CaseInsensitiveEqual(header_name, "Content-Length"))
+                {
+                    Stoi(std::string(header_value.data(), header_value.size()), rtsp_response->content_length_);
+                }
+                rtsp_response->headers_[header_name] = header_value;
+            }
+        }
+        line_start_position = line_end_position + sizeof(line_end_marker);
+        if (line_start_position >= response_end_position)
+        {
+            continue_parsing = false;
+        }
+    }
+    return rtsp_response;
+}
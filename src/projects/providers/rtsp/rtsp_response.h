@@ -1,13 +1,42 @@
 #pragma once
 
+#include <string_view>
+#include <unordered_map>
 #include <cstdint>
+#include <vector>
+#include <memory>
 
+/*
+    A response to the requests sent by the RTSP pull client, the header part is parsed by Parse() and
+    the body (Content-Length bytes after the empty line) is attached with SetBody()
+*/
 class RtspResponse
 {
 public:
-    RtspResponse(uint16_t status, uint32_t cseq);
+    RtspResponse(std::vector<uint8_t> data);
+    RtspResponse(const RtspResponse&) = delete;
+
+    // Returns nullptr if data does not start with a valid status line (e.g. RTSP/1.0 200 OK)
+    static std::unique_ptr<RtspResponse> Parse(std::vector<uint8_t> data);
+
+    const std::vector<uint8_t> &GetData() const;
+    uint16_t GetStatus() const;
+    const std::string_view &GetReason() const;
+    uint32_t GetCSeq() const;
+    size_t GetContentLength() const;
+    // The header names are compared case insensitively, since some devices send "Cseq" or "Content-length"
+    std::string_view GetHeader(const std::string_view &header_name) const;
+    const std::unordered_map<std::string_view, std::string_view> &GetHeaders() const;
+    const std::vector<uint8_t> &GetBody() const;
+    void SetBody(std::vector<uint8_t> body);
 
 private:
-    uint16_t status_;
-    uint32_t cseq_;
+    // The string views below point into data_, so it must not be modified after parsing
+    const std::vector<uint8_t> data_;
+    uint16_t status_ = 0;
+    std::string_view reason_;
+    uint32_t cseq_ = 0;
+    std::unordered_map<std::string_view, std::string_view> headers_;
+    size_t content_length_ = 0;
+    std::vector<uint8_t> body_;
 };
@@ -3,10 +3,7 @@
 #include "rtsp_library.h"
 #include "rtsp_server.h"
 #include "rtp/rtp_udp_track.h"
-#include "rtp/rtp_h264_track.h"
-#include "rtp/rtp_opus_track.h"
-#include "rtp/rtp_mpeg4_track.h"
-#include "rtp/rtp_aac_track.h"
+#include "rtp/rtp_track_factory.h"
 
 #include <modules/h264/h264_nal_unit_types.h>
 
@@ -14,118 +11,6 @@
 
 constexpr char RtspServer::ClassName[];
 
-template<typename T, typename ... Args>
-std::unique_ptr<T> CreateTrack(const RtspServer::StreamTrackInfo *stream_track, RtspServer &rtsp_server, Args && ... args)
-{
-    std::unique_ptr<T> rtp_track;
-    const auto media_type = stream_track->media_track_.GetMediaType();
-    const auto media_codec = stream_track->media_track_.GetCodecId();
-    OV_ASSERT2(stream_track->media_track_.GetTimeBase().GetNum() == 1);
-    if (stream_track->media_track_.GetTimeBase().GetNum() != 1)
-    {
-        return nullptr;
-    }
-    int32_t clock_frequency = stream_track->media_track_.GetTimeBase().GetDen();
-    OV_ASSERT2(clock_frequency > 0);
-    if (clock_frequency <= 0)
-    {
-        return nullptr;
-    }
-    switch (media_type)
-    {
-    case common::MediaType::Video:
-    case common::MediaType::Audio:
-        switch (media_codec)
-        {
-        case common::MediaCodecId::H264:
-            {
-                using TrackType = RtpH264Track<T>;
-                auto rtp_h264_track = TrackType::template Create<TrackType>(rtsp_server,
-                    media_type,
-                    media_codec,
-                    stream_track->stream_id_,
-                    stream_track->media_track_.GetId(),
-                    static_cast<uint32_t>(clock_frequency),
-                    std::forward<Args>(args) ...);
-                if (rtp_h264_track &&
-                    stream_track->sdp_format_parameters_ &&
-                    stream_track->sdp_format_parameters_->GetType() == SdpFormatParameters::Type::H264)
-                {
-                    auto const &h264_sdp_format_parameters = *static_cast<H264SdpFormatParameters*>(stream_track->sdp_format_parameters_.get());
-                    auto &h264_sps_pps_tracker = rtp_h264_track->GetH264SpsPpsTracker();
-#if defined(PARANOID_STREAM_VALIDATION)
-                    auto &h264_bitstream_analyzer = rtp_h264_track->GetH264BitstreamAnalyzer();
-#endif
-                    {
-                        const auto &sps = h264_sdp_format_parameters.sps_;
-                        if (sps.empty() == false)
-                        {
-                            h264_sps_pps_tracker.AddSps(sps.data(), sps.size());
-#if defined(PARANOID_STREAM_VALIDATION)
-                            h264_bitstream_analyzer.ValidateNalUnit(sps.data() + 1, sps.size() - 1, H264NalUnitType::Sps, *sps.data());
-#endif
-                        }
-                    }
-                    {
-                        const auto &pps = h264_sdp_format_parameters.pps_;
-                        if (pps.empty() == false)
-                        {
-                            h264_sps_pps_tracker.AddPps(pps.data(), pps.size());
-#if defined(PARANOID_STREAM_VALIDATION)
-                            h264_bitstream_analyzer.ValidateNalUnit(pps.data() + 1, pps.size() - 1, H264NalUnitType::Pps, *pps.data());
-#endif
-                        }
-                    }
-                }
-                rtp_track.reset(static_cast<T*>(rtp_h264_track.release()));
-            }
-            break;
-        case common::MediaCodecId::Opus:
-            {
-                using TrackType = RtpOpusTrack<T>;
-                rtp_track = TrackType::template Create<TrackType>(rtsp_server,
-                    media_type,
-                    media_codec,
-                    stream_track->stream_id_,
-                    stream_track->media_track_.GetId(),
-                    static_cast<uint32_t>(clock_frequency),
-                    std::forward<Args>(args) ...);
-            }
-            break;
-        case common::MediaCodecId::Aac:
-            {
-                using TrackType = RtpAacTrack<T>;
-                auto rtp_aac_track = TrackType::template Create<TrackType>(rtsp_server,
-                    media_type,
-                    media_codec,
-                    stream_track->stream_id_,
-                    stream_track->media_track_.GetId(),
-                    static_cast<uint32_t>(clock_frequency),
-                    std::forward<Args>(args) ...);
-                if (rtp_aac_track &&
-                    stream_track->sdp_format_parameters_ &&
-                    stream_track->sdp_format_parameters_->GetType() == SdpFormatParameters::Type::Mpeg4)
-                {
-                    auto const &aac_sdp_format_parameters = *static_cast<Mpeg4SdpFormatParameters*>(stream_track->sdp_format_parameters_.get());
-                    rtp_aac_track->SetSdpFormatParameters(aac_sdp_format_parameters);
-                }
-                rtp_track.reset(static_cast<T*>(rtp_aac_track.release()));
-            }
-            break;
-        default:
-            break;
-        }
-        break;
-    default:
-        break;
-    }
-    if (rtp_track && rtp_track->Initialize(stream_track->media_track_) == false)
-    {
-        rtp_track.reset();
-    }
-    return rtp_track;
-}
-
 void RtspServer::OnConnected(const std::shared_ptr<ov::Socket> &remote)
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -282,7 +167,7 @@ bool RtspServer::OnUdpStreamTrackSetup(const std::string_view &rtsp_uri,
         return false;
     }
 
-    auto rtp_udp_track = CreateTrack<RtpUdpTrack>(stream_track, *this, rtp_udp_port_range_);
+    auto rtp_udp_track = CreateRtpTrack<RtpUdpTrack>(stream_track->media_track_, stream_track->sdp_format_parameters_, stream_track->stream_id_, *this, rtp_udp_port_range_);
     if (rtp_udp_track == nullptr)
     {
         return false;
@@ -316,7 +201,7 @@ bool RtspServer::OnTcpStreamTrackSetup(const std::string_view &rtsp_uri,
         return false;
     }
 
-    std::unique_ptr<RtpTcpTrack> rtp_tcp_track = CreateTrack<RtpTcpTrack>(stream_track, *this, rtp_channel, rtcp_channel);
+    std::unique_ptr<RtpTcpTrack> rtp_tcp_track = CreateRtpTrack<RtpTcpTrack>(stream_track->media_track_, stream_track->sdp_format_parameters_, stream_track->stream_id_, *this, rtp_channel, rtcp_channel);
     if (rtp_tcp_track == nullptr)
     {
         return false;
@@ -6,6 +6,7 @@
 #include "rtp/rtp_track.h"
 #include "rtp/rtp_udp_track.h"
 #include "rtp/rtp_tcp_track.h"
+#include "rtp/rtp_track_observer.h"
 #include "rtcp/rtcp_packet_header.h"
 
 #include <map>
@@ -17,7 +18,7 @@
 #include <unordered_map>
 #include <mutex>
 
-class RtspServer : public ServerBase<RtspServer, ov::SocketType::Tcp>, public ObservableBase<RtspServer, RtspObserver>
+class RtspServer : public ServerBase<RtspServer, ov::SocketType::Tcp>, public ObservableBase<RtspServer, RtspObserver>, public RtpTrackObserver
 {
 public:
     /*
@@ -70,19 +71,21 @@ public:
         RtpTcpTrack **track);
     bool OnStreamTeardown(const std::string_view &app_name, 
         const std::string_view &stream_name);
+
+    // RtpTrackObserver
     bool OnVideoData(uint32_t stream_id,
         uint8_t track_id,
         uint32_t timestamp,
         const std::shared_ptr<std::vector<uint8_t>> &data,
         uint8_t flags, 
-        std::unique_ptr<FragmentationHeader> fragmentation_header);
+        std::unique_ptr<FragmentationHeader> fragmentation_header) override;
     bool OnAudioData(uint32_t stream_id,
         uint8_t track_id,
         uint32_t timestamp,
-        const std::shared_ptr<std::vector<uint8_t>> &data);
+        const std::shared_ptr<std::vector<uint8_t>> &data) override;
     void OnRtcpSenderReport(uint32_t stream_id,
         uint8_t track_id,
-        const RtcpSenderReport &rtcp_sender_report);
+        const RtcpSenderReport &rtcp_sender_report) override;
 
 protected:
     // PhysicalPortObserver
@@ -0,0 +1,1335 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#define OV_LOG_TAG "RtspcClient"
+
+#include "rtspc_client.h"
+
+#include <base/ovcrypto/base_64.h>
+#include <base/ovcrypto/message_digest.h>
+#include <base/ovlibrary/stl.h>
+#include <base/ovsocket/socket.h>
+#include <base/ovsocket/socket_address.h>
+#include <providers/rtsp/rtp/rtp_track_factory.h>
+#include <providers/rtsp/rtsp_request.h>
+#include <providers/rtsp/sdp.h>
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cinttypes>
+
+// Size of the buffer of recv()
+#define RTSPC_RECEIVE_BUFFER_SIZE (64 * 1024)
+// Maximum number of recv() per event, so that a busy camera does not starve the other clients in the loop
+#define RTSPC_MAX_RECEIVE_COUNT_PER_EVENT (16)
+// If the header of a response is larger than this, the server is considered broken
+#define RTSPC_MAX_HEADER_SIZE (64 * 1024)
+// Size of SO_RCVBUF of the UDP sockets (for the bursts of the key frames)
+#define RTSPC_UDP_RECEIVE_BUFFER_SIZE (1024 * 1024)
+// Interval of checking the receive timeout and the keepalive
+#define RTSPC_KEEPALIVE_CHECK_INTERVAL (1000)
+// Interval of flushing the jitter buffers (less than the minimum delay of RtpJitterBuffer)
+#define RTSPC_JITTER_BUFFER_FLUSH_INTERVAL (RtpJitterBuffer::min_delay_msec / 2)
+
+namespace pvd
+{
+	static int CreateNonBlockingSocket(int family, int type)
+	{
+#if defined(__APPLE__)
+		// macOS does not support SOCK_NONBLOCK/SOCK_CLOEXEC
+		int socket = ::socket(family, type, 0);
+
+		if (socket != -1)
+		{
+			::fcntl(socket, F_SETFL, ::fcntl(socket, F_GETFL, 0) | O_NONBLOCK);
+			::fcntl(socket, F_SETFD, FD_CLOEXEC);
+		}
+
+		return socket;
+#else   // defined(__APPLE__)
+		return ::socket(family, type | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+#endif  // defined(__APPLE__)
+	}
+
+	// @param port 0 to accept any port of the address
+	static bool IsFromAddress(const sockaddr_storage &source, const ov::SocketAddress &address, uint16_t port)
+	{
+		if (source.ss_family != static_cast<sa_family_t>(address.GetFamily()))
+		{
+			return false;
+		}
+
+		if (source.ss_family == AF_INET6)
+		{
+			auto source_ipv6 = reinterpret_cast<const sockaddr_in6 *>(&source);
+
+			return (::memcmp(&(source_ipv6->sin6_addr), address.AddrInForIPv6(), sizeof(in6_addr)) == 0) &&
+				   ((port == 0) || (ntohs(source_ipv6->sin6_port) == port));
+		}
+
+		auto source_ipv4 = reinterpret_cast<const sockaddr_in *>(&source);
+
+		return (source_ipv4->sin_addr.s_addr == address.AddrInForIPv4()->s_addr) &&
+			   ((port == 0) || (ntohs(source_ipv4->sin_port) == port));
+	}
+
+	static ov::String ToMd5String(const ov::String &input)
+	{
+		uint8_t digest[16];
+
+		if (ov::MessageDigest::ComputeDigest(ov::CryptoAlgorithm::Md5, input.CStr(), input.GetLength(), digest, sizeof(digest)) == false)
+		{
+			return "";
+		}
+
+		ov::String result;
+
+		for (auto byte : digest)
+		{
+			result.AppendFormat("%02x", byte);
+		}
+
+		return result;
+	}
+
+	// Gets the value of a parameter of WWW-Authenticate (realm="...", nonce="...", ...)
+	static ov::String GetAuthenticateParameter(const std::string_view &header, const std::string_view &name)
+	{
+		size_t position = 0;
+
+		while (position < header.size())
+		{
+			auto equal_position = header.find('=', position);
+
+			if (equal_position == std::string_view::npos)
+			{
+				break;
+			}
+
+			// The name is the last word before '=' (The first one follows "Digest ")
+			auto name_start = header.find_last_of(" ,", equal_position);
+			name_start = (name_start == std::string_view::npos || name_start < position) ? position : (name_start + 1);
+			auto parameter_name = Trim(header.substr(name_start, equal_position - name_start));
+
+			size_t value_start = equal_position + 1;
+			size_t value_end;
+			std::string_view value;
+
+			if ((value_start < header.size()) && (header[value_start] == '"'))
+			{
+				value_end = header.find('"', value_start + 1);
+				value_end = (value_end == std::string_view::npos) ? header.size() : value_end;
+				value = header.substr(value_start + 1, value_end - value_start - 1);
+				value_end = header.find(',', value_end);
+			}
+			else
+			{
+				value_end = header.find(',', value_start);
+				value = Trim(header.substr(value_start, (value_end == std::string_view::npos) ? std::string_view::npos : (value_end - value_start)));
+			}
+
+			if (CaseInsensitiveEqual(parameter_name, name))
+			{
+				return ov::String(value.data(), value.size());
+			}
+
+			if (value_end == std::string_view::npos)
+			{
+				break;
+			}
+
+			position = value_end + 1;
+		}
+
+		return "";
+	}
+
+	std::shared_ptr<RtspcClient> RtspcClient::Create(const std::shared_ptr<RtspcEventLoop> &event_loop,
+													 const std::shared_ptr<const ov::Url> &url,
+													 RtspcTransport transport,
+													 uint32_t stream_id,
+													 RtspcClientObserver &observer)
+	{
+		if ((event_loop == nullptr) || (url == nullptr))
+		{
+			return nullptr;
+		}
+
+		return std::make_shared<RtspcClient>(event_loop, url, transport, stream_id, observer);
+	}
+
+	RtspcClient::RtspcClient(const std::shared_ptr<RtspcEventLoop> &event_loop,
+							 const std::shared_ptr<const ov::Url> &url,
+							 RtspcTransport transport,
+							 uint32_t stream_id,
+							 RtspcClientObserver &observer)
+		: _event_loop(event_loop),
+		  _url(url),
+		  _request_url(url->ToUrlString()),
+		  _transport(transport),
+		  _stream_id(stream_id),
+		  _observer(observer)
+	{
+	}
+
+	RtspcClient::~RtspcClient()
+	{
+		Stop();
+	}
+
+	void RtspcClient::Start()
+	{
+		_event_loop->Invoke([this]() {
+			if (_state == State::Stopped)
+			{
+				_has_played = false;
+				_reconnect_delay = RTSPC_RECONNECT_MIN_DELAY;
+
+				Connect();
+			}
+		});
+	}
+
+	void RtspcClient::Stop()
+	{
+		_event_loop->Invoke([this]() {
+			if (_state == State::Stopped)
+			{
+				return;
+			}
+
+			if (_state == State::Playing)
+			{
+				// Best effort: the connection is closed right after this, so the response is not waited for
+				SendRequest("TEARDOWN", _content_base, "", false);
+			}
+
+			CloseConnection();
+			CancelTimers();
+
+			_state = State::Stopped;
+		});
+	}
+
+	void RtspcClient::Connect()
+	{
+		_state = State::Connecting;
+		_connect_start_time = RtspcEventLoop::GetCurrentMilliseconds();
+		_is_authorization_sent = false;
+
+		logti("Connecting to %s (transport: %s)", _request_url.CStr(), (_transport == RtspcTransport::Tcp) ? "TCP" : "UDP");
+
+		// NOTE: The hostname is resolved synchronously in the loop, so the address of the camera should be an IP address or a local name
+		ov::SocketAddress address(_url->Domain(), static_cast<uint16_t>((_url->Port() > 0) ? _url->Port() : 554));
+
+		if (address.GetFamily() == ov::SocketFamily::Unknown)
+		{
+			Fail("Could not resolve the address");
+			return;
+		}
+
+		_socket_family = static_cast<int>(address.GetFamily());
+		_server_address = address;
+		_socket = CreateNonBlockingSocket(_socket_family, SOCK_STREAM);
+
+		if (_socket == -1)
+		{
+			Fail("Could not create a socket");
+			return;
+		}
+
+		int no_delay = 1;
+		::setsockopt(_socket, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+
+		if ((::connect(_socket, address.Address(), address.AddressLength()) == -1) && (errno != EINPROGRESS))
+		{
+			Fail("Could not connect to the server");
+			return;
+		}
+
+		// The connection is completed when the socket becomes writable
+		_socket_handler_id = _event_loop->AddHandler(_socket, EPOLLIN | EPOLLOUT, [this](uint32_t events) {
+			OnSocketEvent(events);
+		});
+
+		if (_socket_handler_id == 0)
+		{
+			Fail("Could not watch the socket");
+			return;
+		}
+
+		StartResponseTimer();
+	}
+
+	void RtspcClient::Fail(const ov::String &reason)
+	{
+		if ((_state == State::Stopped) || (_state == State::WaitingForReconnection))
+		{
+			return;
+		}
+
+		bool will_reconnect = _has_played;
+
+		CloseConnection();
+		CancelTimers();
+
+		if (will_reconnect)
+		{
+			logtw("%s: %s, reconnecting in %" PRId64 " ms", _request_url.CStr(), reason.CStr(), _reconnect_delay);
+
+			_state = State::WaitingForReconnection;
+			_reconnect_timer_id = _event_loop->AddTimer(_reconnect_delay, [this]() {
+				_reconnect_timer_id = 0;
+				Connect();
+			});
+
+			_reconnect_delay = std::min<int64_t>(_reconnect_delay * 2, RTSPC_RECONNECT_MAX_DELAY);
+		}
+		else
+		{
+			logte("%s: %s", _request_url.CStr(), reason.CStr());
+
+			_state = State::Stopped;
+		}
+
+		_observer.OnRtspcClosed(will_reconnect);
+	}
+
+	void RtspcClient::CloseConnection()
+	{
+		// Invalidates the buffers that are being processed
+		_connection_id++;
+
+		if (_socket_handler_id != 0)
+		{
+			_event_loop->RemoveHandler(_socket_handler_id);
+			_socket_handler_id = 0;
+		}
+
+		if (_socket != -1)
+		{
+			::close(_socket);
+			_socket = -1;
+		}
+
+		for (auto &setup_track : _setup_track_list)
+		{
+			for (auto handler_id : {setup_track.rtp_handler_id, setup_track.rtcp_handler_id})
+			{
+				if (handler_id != 0)
+				{
+					_event_loop->RemoveHandler(handler_id);
+				}
+			}
+
+			for (auto socket : {setup_track.rtp_socket, setup_track.rtcp_socket})
+			{
+				if (socket != -1)
+				{
+					::close(socket);
+				}
+			}
+		}
+
+		// The demuxer refers to the tracks
+		_rtp_demuxer.reset();
+		_is_demuxing_rtp = false;
+		_track_list.clear();
+		_jitter_buffer_list.clear();
+		_setup_track_list.clear();
+		_setup_index = 0;
+
+		_send_buffer.clear();
+		_receive_buffer.clear();
+		_pending_response.reset();
+		_skip_length = 0;
+
+		_request_cseq = 0;
+		_session_id = "";
+		_session_timeout = RTSPC_DEFAULT_SESSION_TIMEOUT;
+	}
+
+	void RtspcClient::OnSocketEvent(uint32_t events)
+	{
+		if (_state == State::Connecting)
+		{
+			if (events & (EPOLLOUT | EPOLLERR | EPOLLHUP))
+			{
+				int error = 0;
+				socklen_t length = sizeof(error);
+
+				if ((::getsockopt(_socket, SOL_SOCKET, SO_ERROR, &error, &length) == -1) || (error != 0))
+				{
+					Fail("Could not connect to the server");
+					return;
+				}
+
+				OnConnected();
+			}
+
+			return;
+		}
+
+		auto connection_id = _connection_id;
+
+		if (events & EPOLLIN)
+		{
+			if ((ReceiveData() == false) || (connection_id != _connection_id))
+			{
+				return;
+			}
+		}
+		else if (events & (EPOLLERR | EPOLLHUP))
+		{
+			Fail("Connection is closed");
+			return;
+		}
+
+		if (events & EPOLLOUT)
+		{
+			FlushSendBuffer();
+		}
+	}
+
+	void RtspcClient::OnConnected()
+	{
+		_connect_time_msec = RtspcEventLoop::GetCurrentMilliseconds() - _connect_start_time;
+		_last_received_time = RtspcEventLoop::GetCurrentMilliseconds();
+
+		_event_loop->ModifyHandler(_socket_handler_id, EPOLLIN);
+
+		if (_transport == RtspcTransport::Tcp)
+		{
+			_rtp_demuxer = std::make_unique<RtspRtpDemuxer>();
+		}
+
+		_state = State::Options;
+		SendRequest("OPTIONS", _request_url);
+	}
+
+	bool RtspcClient::ReceiveData()
+	{
+		uint8_t buffer[RTSPC_RECEIVE_BUFFER_SIZE];
+
+		for (int count = 0; count < RTSPC_MAX_RECEIVE_COUNT_PER_EVENT; count++)
+		{
+			auto read_bytes = ::recv(_socket, buffer, sizeof(buffer), 0);
+
+			if (read_bytes > 0)
+			{
+				_receive_buffer.insert(_receive_buffer.end(), buffer, buffer + read_bytes);
+
+				if (static_cast<size_t>(read_bytes) < sizeof(buffer))
+				{
+					break;
+				}
+
+				continue;
+			}
+
+			if (read_bytes == 0)
+			{
+				Fail("Connection is closed by the server");
+				return false;
+			}
+
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+			{
+				break;
+			}
+
+			Fail("Could not receive the data");
+			return false;
+		}
+
+		_last_received_time = RtspcEventLoop::GetCurrentMilliseconds();
+
+		return ProcessReceivedData();
+	}
+
+	bool RtspcClient::ProcessReceivedData()
+	{
+		constexpr uint8_t header_end_marker[] = {'\r', '\n', '\r', '\n'};
+		auto connection_id = _connection_id;
+		size_t offset = 0;
+
+		while (offset < _receive_buffer.size())
+		{
+			const uint8_t *data = _receive_buffer.data() + offset;
+			size_t remaining = _receive_buffer.size() - offset;
+
+			if (_skip_length > 0)
+			{
+				auto skip_length = std::min(_skip_length, remaining);
+				_skip_length -= skip_length;
+				offset += skip_length;
+				continue;
+			}
+
+			if (_pending_response != nullptr)
+			{
+				auto content_length = _pending_response->GetContentLength();
+
+				if (remaining < content_length)
+				{
+					break;
+				}
+
+				auto response = std::move(_pending_response);
+				response->SetBody(std::vector<uint8_t>(data, data + content_length));
+				offset += content_length;
+
+				OnResponse(*response);
+			}
+			else if (_is_demuxing_rtp || (*data == '$'))
+			{
+				// '$' + channel (1 byte) + length (2 bytes) + RTP/RTCP packet
+				if (_rtp_demuxer == nullptr)
+				{
+					Fail("Received an interleaved packet without TCP transport");
+					return false;
+				}
+
+				size_t consumed_bytes = 0;
+
+				if (_rtp_demuxer->AppendMuxedData(data, remaining, consumed_bytes, _is_demuxing_rtp) == false)
+				{
+					Fail("Could not demux the interleaved packet");
+					return false;
+				}
+
+				offset += consumed_bytes;
+			}
+			else
+			{
+				auto header_end = static_cast<const uint8_t *>(::memmem(data, remaining, header_end_marker, sizeof(header_end_marker)));
+
+				if (header_end == nullptr)
+				{
+					if (remaining > RTSPC_MAX_HEADER_SIZE)
+					{
+						Fail("The header of the response is too large");
+						return false;
+					}
+
+					break;
+				}
+
+				offset += (header_end - data) + sizeof(header_end_marker);
+
+				auto response = RtspResponse::Parse(std::vector<uint8_t>(data, header_end));
+
+				if (response == nullptr)
+				{
+					// Some servers send the requests (e.g. SET_PARAMETER, ANNOUNCE) to the client, they are ignored
+					auto request = RtspRequest::Parse(std::vector<uint8_t>(data, header_end));
+
+					if (request == nullptr)
+					{
+						Fail("Received an invalid response");
+						return false;
+					}
+
+					logtd("%s: %s request from the server is ignored", _request_url.CStr(), std::string(request->GetMethod()).c_str());
+
+					_skip_length = request->GetContentLength();
+				}
+				else if (response->GetContentLength() > 0)
+				{
+					_pending_response = std::move(response);
+				}
+				else
+				{
+					OnResponse(*response);
+				}
+			}
+
+			// The connection can be closed (and the buffer is cleared) in the callbacks
+			if (connection_id != _connection_id)
+			{
+				return false;
+			}
+		}
+
+		_receive_buffer.erase(_receive_buffer.begin(), _receive_buffer.begin() + offset);
+
+		return true;
+	}
+
+	bool RtspcClient::FlushSendBuffer()
+	{
+		size_t offset = 0;
+
+		while (offset < _send_buffer.size())
+		{
+			auto sent_bytes = ::send(_socket, _send_buffer.data() + offset, _send_buffer.size() - offset, MSG_NOSIGNAL);
+
+			if (sent_bytes >= 0)
+			{
+				offset += sent_bytes;
+				continue;
+			}
+
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+			{
+				break;
+			}
+
+			Fail("Could not send the request");
+			return false;
+		}
+
+		_send_buffer.erase(_send_buffer.begin(), _send_buffer.begin() + offset);
+
+		// Waits for EPOLLOUT only while there is something to send
+		_event_loop->ModifyHandler(_socket_handler_id, _send_buffer.empty() ? EPOLLIN : (EPOLLIN | EPOLLOUT));
+
+		return true;
+	}
+
+	bool RtspcClient::SendRequest(const ov::String &method, const ov::String &uri, const ov::String &extra_headers, bool wait_for_response)
+	{
+		if (_socket == -1)
+		{
+			return false;
+		}
+
+		_cseq++;
+
+		ov::String request;
+
+		request.AppendFormat("%s %s RTSP/1.0\r\n", method.CStr(), uri.CStr());
+		request.AppendFormat("CSeq: %u\r\n", _cseq);
+		request.Append("User-Agent: OvenMediaEngine\r\n");
+
+		auto authorization = MakeAuthorization(method, uri);
+
+		if (authorization.IsEmpty() == false)
+		{
+			request.AppendFormat("Authorization: %s\r\n", authorization.CStr());
+		}
+
+		if (_session_id.IsEmpty() == false)
+		{
+			request.AppendFormat("Session: %s\r\n", _session_id.CStr());
+		}
+
+		request.Append(extra_headers);
+		request.Append("\r\n");
+
+		if (wait_for_response)
+		{
+			_request_cseq = _cseq;
+			_last_request = Request{method, uri, extra_headers};
+
+			StartResponseTimer();
+		}
+
+		_send_buffer.insert(_send_buffer.end(), request.CStr(), request.CStr() + request.GetLength());
+
+		return FlushSendBuffer();
+	}
+
+	void RtspcClient::OnResponse(const RtspResponse &response)
+	{
+		if ((_request_cseq == 0) || (response.GetCSeq() != _request_cseq))
+		{
+			// Responses of the keepalives
+			return;
+		}
+
+		_request_cseq = 0;
+
+		_event_loop->CancelTimer(_response_timer_id);
+		_response_timer_id = 0;
+
+		if (response.GetStatus() == 401)
+		{
+			if (UpdateAuthorization(response))
+			{
+				SendRequest(_last_request.method, _last_request.uri, _last_request.extra_headers);
+			}
+			else
+			{
+				Fail("Unauthorized");
+			}
+
+			return;
+		}
+
+		switch (_state)
+		{
+			case State::Options:
+				OnOptionsResponse(response);
+				break;
+
+			case State::Describe:
+				OnDescribeResponse(response);
+				break;
+
+			case State::Setup:
+				OnSetupResponse(response);
+				break;
+
+			case State::Play:
+				OnPlayResponse(response);
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	void RtspcClient::OnOptionsResponse(const RtspResponse &response)
+	{
+		// OPTIONS is only used to know whether GET_PARAMETER can be used for the keepalive, so the errors are ignored
+		auto public_header = response.GetHeader("Public");
+		_is_get_parameter_supported = (response.GetStatus() == 200) && (public_header.find("GET_PARAMETER") != std::string_view::npos);
+
+		_state = State::Describe;
+		SendRequest("DESCRIBE", _request_url, "Accept: application/sdp\r\n");
+	}
+
+	void RtspcClient::OnDescribeResponse(const RtspResponse &response)
+	{
+		if (response.GetStatus() != 200)
+		{
+			Fail(ov::String::FormatString("DESCRIBE failed with %u", response.GetStatus()));
+			return;
+		}
+
+		auto content_base = response.GetHeader("Content-Base");
+
+		if (content_base.empty())
+		{
+			content_base = response.GetHeader("Content-Location");
+		}
+
+		_content_base = content_base.empty() ? _request_url : ov::String(content_base.data(), content_base.size());
+
+		_media_info = RtspMediaInfo();
+
+		if (ParseSdp(response.GetBody(), _media_info) == false)
+		{
+			Fail("Could not parse the SDP");
+			return;
+		}
+
+		_setup_track_list.clear();
+
+		for (const auto &track : _media_info.tracks_)
+		{
+			auto payload = _media_info.payloads_.find(track.second);
+
+			// The session level control ("*") has no payload
+			if (payload == _media_info.payloads_.end())
+			{
+				continue;
+			}
+
+			// Creates the track to check whether the codec can be depacketized, since the tracks that are SETUP must be received
+			auto media_track = payload->second;
+			media_track.SetId(track.second);
+
+			if (CreateRtpTrack<RtpTcpTrack>(media_track, GetFormatParameters(_media_info, track.second), _stream_id, _observer, 0, 1) == nullptr)
+			{
+				logtw("%s: Track %s (payload type: %u) is ignored since the codec is not supported", _request_url.CStr(), track.first.c_str(), track.second);
+				continue;
+			}
+
+			SetupTrack setup_track;
+			ov::String control(track.first.c_str());
+
+			if (control.LowerCaseString().HasPrefix("rtsp://"))
+			{
+				setup_track.control_uri = control;
+			}
+			else
+			{
+				setup_track.control_uri = _content_base;
+
+				if (setup_track.control_uri.HasSuffix("/") == false)
+				{
+					setup_track.control_uri.Append("/");
+				}
+
+				setup_track.control_uri.Append(control);
+			}
+
+			setup_track.payload_type = track.second;
+
+			_setup_track_list.push_back(setup_track);
+		}
+
+		if (_setup_track_list.empty())
+		{
+			Fail("There is no track to receive");
+			return;
+		}
+
+		std::sort(_setup_track_list.begin(), _setup_track_list.end(), [](const SetupTrack &first, const SetupTrack &second) -> bool {
+			return first.payload_type < second.payload_type;
+		});
+
+		std::vector<std::shared_ptr<MediaTrack>> track_list;
+
+		for (const auto &setup_track : _setup_track_list)
+		{
+			auto media_track = std::make_shared<MediaTrack>(_media_info.payloads_[setup_track.payload_type]);
+			media_track->SetId(setup_track.payload_type);
+
+			track_list.push_back(media_track);
+		}
+
+		if (_observer.OnRtspcDescribed(track_list) == false)
+		{
+			Fail("The stream is rejected");
+			return;
+		}
+
+		_setup_index = 0;
+		SendNextSetup();
+	}
+
+	bool RtspcClient::SendNextSetup()
+	{
+		auto &setup_track = _setup_track_list[_setup_index];
+		ov::String transport;
+
+		if (_transport == RtspcTransport::Tcp)
+		{
+			transport.Format("Transport: RTP/AVP/TCP;unicast;interleaved=%zu-%zu\r\n", _setup_index * 2, (_setup_index * 2) + 1);
+		}
+		else
+		{
+			if (OpenUdpSockets(setup_track) == false)
+			{
+				Fail("Could not open the UDP sockets");
+				return false;
+			}
+
+			transport.Format("Transport: RTP/AVP;unicast;client_port=%u-%u\r\n", setup_track.rtp_port, setup_track.rtp_port + 1);
+		}
+
+		_state = State::Setup;
+
+		return SendRequest("SETUP", setup_track.control_uri, transport);
+	}
+
+	void RtspcClient::OnSetupResponse(const RtspResponse &response)
+	{
+		if (response.GetStatus() != 200)
+		{
+			Fail(ov::String::FormatString("SETUP failed with %u", response.GetStatus()));
+			return;
+		}
+
+		// Session: <session id>[;timeout=<seconds>]
+		auto session = Split(response.GetHeader("Session"), ';');
+
+		if (session.empty() == false)
+		{
+			auto session_id = Trim(session[0]);
+			_session_id = ov::String(session_id.data(), session_id.size());
+
+			for (size_t index = 1; index < session.size(); index++)
+			{
+				auto parameter = Split(Trim(session[index]), '=');
+
+				if ((parameter.size() == 2) && CaseInsensitiveEqual(parameter[0], "timeout"))
+				{
+					int timeout = 0;
+
+					if (Stoi(std::string(parameter[1].data(), parameter[1].size()), timeout) && (timeout > 0))
+					{
+						_session_timeout = timeout;
+					}
+				}
+			}
+		}
+
+		auto &setup_track = _setup_track_list[_setup_index];
+		uint8_t rtp_channel = static_cast<uint8_t>(_setup_index * 2);
+		uint8_t rtcp_channel = rtp_channel + 1;
+
+		if (_transport == RtspcTransport::Tcp)
+		{
+			// The server can choose the other channels
+			for (const auto &parameter : Split(response.GetHeader("Transport"), ';'))
+			{
+				auto key_value = Split(Trim(parameter), '=');
+
+				if ((key_value.size() == 2) && (key_value[0] == "interleaved"))
+				{
+					auto channels = Split(key_value[1], '-');
+
+					if (channels.size() == 2)
+					{
+						Stoi(std::string(channels[0].data(), channels[0].size()), rtp_channel);
+						Stoi(std::string(channels[1].data(), channels[1].size()), rtcp_channel);
+					}
+				}
+			}
+		}
+		else
+		{
+			// Only the packets from these ports of the server are accepted
+			for (const auto &parameter : Split(response.GetHeader("Transport"), ';'))
+			{
+				auto key_value = Split(Trim(parameter), '=');
+
+				if ((key_value.size() == 2) && (key_value[0] == "server_port"))
+				{
+					auto ports = Split(key_value[1], '-');
+
+					if (ports.empty() || (Stoi(std::string(ports[0].data(), ports[0].size()), setup_track.server_rtp_port) == false))
+					{
+						continue;
+					}
+
+					setup_track.server_rtcp_port = setup_track.server_rtp_port + 1;
+
+					if (ports.size() == 2)
+					{
+						Stoi(std::string(ports[1].data(), ports[1].size()), setup_track.server_rtcp_port);
+					}
+				}
+			}
+		}
+
+		if (CreateTrack(setup_track, rtp_channel, rtcp_channel) == false)
+		{
+			Fail("Could not create the RTP track");
+			return;
+		}
+
+		_setup_index++;
+
+		if (_setup_index < _setup_track_list.size())
+		{
+			SendNextSetup();
+			return;
+		}
+
+		_state = State::Play;
+		SendRequest("PLAY", _content_base, "Range: npt=0.000-\r\n");
+	}
+
+	void RtspcClient::OnPlayResponse(const RtspResponse &response)
+	{
+		if (response.GetStatus() != 200)
+		{
+			Fail(ov::String::FormatString("PLAY failed with %u", response.GetStatus()));
+			return;
+		}
+
+		_state = State::Playing;
+		_has_played = true;
+		_reconnect_delay = RTSPC_RECONNECT_MIN_DELAY;
+		_negotiation_time_msec = RtspcEventLoop::GetCurrentMilliseconds() - _connect_start_time - _connect_time_msec;
+		_last_keepalive_time = RtspcEventLoop::GetCurrentMilliseconds();
+
+		logti("%s is playing (%zu tracks, session timeout: %d)", _request_url.CStr(), _track_list.size(), _session_timeout);
+
+		StartKeepaliveTimer();
+
+		if (_transport == RtspcTransport::Udp)
+		{
+			StartJitterBufferTimer();
+		}
+
+		_observer.OnRtspcPlaying();
+	}
+
+	bool RtspcClient::CreateTrack(const SetupTrack &setup_track, uint8_t rtp_channel, uint8_t rtcp_channel)
+	{
+		auto payload = _media_info.payloads_.find(setup_track.payload_type);
+
+		if (payload == _media_info.payloads_.end())
+		{
+			return false;
+		}
+
+		auto media_track = payload->second;
+		media_track.SetId(setup_track.payload_type);
+
+		// The UDP packets are also fed to RtpTcpTrack (by AddRtpPacket()/AddRtcpPacket()), since RtpUdpTrack receives
+		// from the PhysicalPorts of the RTSP server, which have their own threads
+		auto track = CreateRtpTrack<RtpTcpTrack>(media_track, GetFormatParameters(_media_info, setup_track.payload_type), _stream_id, _observer, rtp_channel, rtcp_channel);
+
+		if (track == nullptr)
+		{
+			return false;
+		}
+
+		if (_rtp_demuxer != nullptr)
+		{
+			_rtp_demuxer->AddInterleavedTrack(rtp_channel, track.get());
+			_rtp_demuxer->AddInterleavedTrack(rtcp_channel, track.get());
+		}
+
+		if (_transport == RtspcTransport::Udp)
+		{
+			_jitter_buffer_list.push_back(std::make_unique<RtpJitterBuffer>(media_track.GetTimeBase().GetDen(), media_track.GetMediaType() == common::MediaType::Video));
+		}
+
+		_track_list.push_back(std::move(track));
+
+		return true;
+	}
+
+	bool RtspcClient::OpenUdpSockets(SetupTrack &setup_track)
+	{
+		auto open_socket = [this](uint16_t port) -> int {
+			int socket = CreateNonBlockingSocket(_socket_family, SOCK_DGRAM);
+
+			if (socket == -1)
+			{
+				return -1;
+			}
+
+			sockaddr_storage address{};
+			socklen_t address_length;
+
+			if (_socket_family == AF_INET6)
+			{
+				auto address_ipv6 = reinterpret_cast<sockaddr_in6 *>(&address);
+				address_ipv6->sin6_family = AF_INET6;
+				address_ipv6->sin6_addr = in6addr_any;
+				address_ipv6->sin6_port = htons(port);
+				address_length = sizeof(sockaddr_in6);
+			}
+			else
+			{
+				auto address_ipv4 = reinterpret_cast<sockaddr_in *>(&address);
+				address_ipv4->sin_family = AF_INET;
+				address_ipv4->sin_addr.s_addr = htonl(INADDR_ANY);
+				address_ipv4->sin_port = htons(port);
+				address_length = sizeof(sockaddr_in);
+			}
+
+			int receive_buffer_size = RTSPC_UDP_RECEIVE_BUFFER_SIZE;
+			::setsockopt(socket, SOL_SOCKET, SO_RCVBUF, &receive_buffer_size, sizeof(receive_buffer_size));
+
+			if (::bind(socket, reinterpret_cast<sockaddr *>(&address), address_length) == -1)
+			{
+				::close(socket);
+				return -1;
+			}
+
+			return socket;
+		};
+
+		auto get_port = [](int socket) -> uint16_t {
+			sockaddr_storage address{};
+			socklen_t address_length = sizeof(address);
+
+			if (::getsockname(socket, reinterpret_cast<sockaddr *>(&address), &address_length) == -1)
+			{
+				return 0;
+			}
+
+			return ntohs((address.ss_family == AF_INET6) ? reinterpret_cast<sockaddr_in6 *>(&address)->sin6_port : reinterpret_cast<sockaddr_in *>(&address)->sin_port);
+		};
+
+		// RTP uses an even port, and RTCP uses the next one (RFC 3550 11)
+		for (int attempt = 0; attempt < 16; attempt++)
+		{
+			int rtp_socket = open_socket(0);
+
+			if (rtp_socket == -1)
+			{
+				return false;
+			}
+
+			auto rtp_port = get_port(rtp_socket);
+
+			if ((rtp_port == 0) || (rtp_port % 2 != 0))
+			{
+				::close(rtp_socket);
+				continue;
+			}
+
+			int rtcp_socket = open_socket(rtp_port + 1);
+
+			if (rtcp_socket == -1)
+			{
+				::close(rtp_socket);
+				continue;
+			}
+
+			auto setup_index = _setup_index;
+
+			setup_track.rtp_socket = rtp_socket;
+			setup_track.rtcp_socket = rtcp_socket;
+			setup_track.rtp_port = rtp_port;
+			setup_track.rtp_handler_id = _event_loop->AddHandler(rtp_socket, EPOLLIN, [this, setup_index](uint32_t events) {
+				OnUdpSocketEvent(setup_index, true, events);
+			});
+			setup_track.rtcp_handler_id = _event_loop->AddHandler(rtcp_socket, EPOLLIN, [this, setup_index](uint32_t events) {
+				OnUdpSocketEvent(setup_index, false, events);
+			});
+
+			return (setup_track.rtp_handler_id != 0) && (setup_track.rtcp_handler_id != 0);
+		}
+
+		return false;
+	}
+
+	void RtspcClient::OnUdpSocketEvent(size_t setup_index, bool is_rtp, uint32_t events)
+	{
+		if (setup_index >= _setup_track_list.size())
+		{
+			return;
+		}
+
+		const auto &setup_track = _setup_track_list[setup_index];
+		int socket = is_rtp ? setup_track.rtp_socket : setup_track.rtcp_socket;
+		// The track is created when the response of SETUP is received, the packets before that are dropped
+		RtpTrack *track = (setup_index < _track_list.size()) ? _track_list[setup_index].get() : nullptr;
+		RtpJitterBuffer *jitter_buffer = (setup_index < _jitter_buffer_list.size()) ? _jitter_buffer_list[setup_index].get() : nullptr;
+		auto connection_id = _connection_id;
+
+		uint16_t server_port = is_rtp ? setup_track.server_rtp_port : setup_track.server_rtcp_port;
+
+		uint8_t buffer[RTSPC_RECEIVE_BUFFER_SIZE];
+
+		for (int count = 0; count < RTSPC_MAX_RECEIVE_COUNT_PER_EVENT; count++)
+		{
+			sockaddr_storage source{};
+			socklen_t source_length = sizeof(source);
+
+			auto read_bytes = ::recvfrom(socket, buffer, sizeof(buffer), 0, reinterpret_cast<sockaddr *>(&source), &source_length);
+
+			if (read_bytes < 0)
+			{
+				break;
+			}
+
+			if (track == nullptr)
+			{
+				continue;
+			}
+
+			// Anyone can send to the port, so the packets that are not from the server are dropped
+			// (They are not counted as received, otherwise they would hide the timeout of the session)
+			if (IsFromAddress(source, _server_address, server_port) == false)
+			{
+				logtd("[%s] A UDP packet from the unknown address is dropped (%zd bytes)", _request_url.CStr(), read_bytes);
+				continue;
+			}
+
+			_last_received_time = RtspcEventLoop::GetCurrentMilliseconds();
+
+			auto packet = std::make_shared<std::vector<uint8_t>>(buffer, buffer + read_bytes);
+
+			if (is_rtp)
+			{
+				_released_packets.clear();
+				jitter_buffer->AddPacket(packet, RtpJitterBuffer::Clock::now(), _released_packets);
+
+				if (AddReleasedPackets(track) == false)
+				{
+					return;
+				}
+			}
+			else
+			{
+				track->AddRtcpPacket(packet);
+			}
+
+			if (connection_id != _connection_id)
+			{
+				break;
+			}
+		}
+	}
+
+	bool RtspcClient::AddReleasedPackets(RtpTrack *track)
+	{
+		auto connection_id = _connection_id;
+
+		for (const auto &released_packet : _released_packets)
+		{
+			track->AddRtpPacket(released_packet);
+
+			// The observer can stop the client
+			if (connection_id != _connection_id)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool RtspcClient::UpdateAuthorization(const RtspResponse &response)
+	{
+		if (_url->Id().IsEmpty())
+		{
+			return false;
+		}
+
+		auto authenticate = response.GetHeader("WWW-Authenticate");
+
+		if (authenticate.empty())
+		{
+			return false;
+		}
+
+		// If the credentials are already sent, retries only when the nonce is expired
+		if (_is_authorization_sent && (CaseInsensitiveEqual(GetAuthenticateParameter(authenticate, "stale").CStr(), "true") == false))
+		{
+			return false;
+		}
+
+		_is_digest = CaseInsensitiveEqual(authenticate.substr(0, 6), "Digest");
+
+		if (_is_digest)
+		{
+			_realm = GetAuthenticateParameter(authenticate, "realm");
+			_nonce = GetAuthenticateParameter(authenticate, "nonce");
+			_opaque = GetAuthenticateParameter(authenticate, "opaque");
+			_is_qop_auth = GetAuthenticateParameter(authenticate, "qop").IndexOf("auth") >= 0;
+			_nonce_count = 0;
+		}
+
+		_is_authorization_sent = true;
+
+		return true;
+	}
+
+	ov::String RtspcClient::MakeAuthorization(const ov::String &method, const ov::String &uri) const
+	{
+		if (_is_authorization_sent == false)
+		{
+			return "";
+		}
+
+		if (_is_digest == false)
+		{
+			auto credentials = ov::String::FormatString("%s:%s", _url->Id().CStr(), _url->Password().CStr());
+
+			return ov::String::FormatString("Basic %s", ov::Base64::Encode(credentials.ToData(false)).CStr());
+		}
+
+		// RFC 2617 3.2.2
+		auto ha1 = ToMd5String(ov::String::FormatString("%s:%s:%s", _url->Id().CStr(), _realm.CStr(), _url->Password().CStr()));
+		auto ha2 = ToMd5String(ov::String::FormatString("%s:%s", method.CStr(), uri.CStr()));
+
+		ov::String authorization;
+
+		authorization.AppendFormat(R"(Digest username="%s", realm="%s", nonce="%s", uri="%s")", _url->Id().CStr(), _realm.CStr(), _nonce.CStr(), uri.CStr());
+
+		if (_is_qop_auth)
+		{
+			auto nonce_count = ov::String::FormatString("%08x", ++_nonce_count);
+			auto cnonce = ov::String::FormatString("%08x", ov::Random::GenerateUInt32());
+			auto response = ToMd5String(ov::String::FormatString("%s:%s:%s:%s:auth:%s", ha1.CStr(), _nonce.CStr(), nonce_count.CStr(), cnonce.CStr(), ha2.CStr()));
+
+			authorization.AppendFormat(R"(, response="%s", qop=auth, nc=%s, cnonce="%s")", response.CStr(), nonce_count.CStr(), cnonce.CStr());
+		}
+		else
+		{
+			authorization.AppendFormat(R"(, response="%s")", ToMd5String(ov::String::FormatString("%s:%s:%s", ha1.CStr(), _nonce.CStr(), ha2.CStr())).CStr());
+		}
+
+		if (_opaque.IsEmpty() == false)
+		{
+			authorization.AppendFormat(R"(, opaque="%s")", _opaque.CStr());
+		}
+
+		return authorization;
+	}
+
+	void RtspcClient::StartResponseTimer()
+	{
+		_event_loop->CancelTimer(_response_timer_id);
+
+		_response_timer_id = _event_loop->AddTimer(RTSPC_RESPONSE_TIMEOUT, [this]() {
+			_response_timer_id = 0;
+			Fail((_state == State::Connecting) ? "Connection timed out" : "Response timed out");
+		});
+	}
+
+	void RtspcClient::StartKeepaliveTimer()
+	{
+		_event_loop->CancelTimer(_keepalive_timer_id);
+
+		_keepalive_timer_id = _event_loop->AddTimer(RTSPC_KEEPALIVE_CHECK_INTERVAL, [this]() {
+			_keepalive_timer_id = 0;
+
+			auto current = RtspcEventLoop::GetCurrentMilliseconds();
+
+			if ((current - _last_received_time) > RTSPC_RECEIVE_TIMEOUT)
+			{
+				Fail("No data is received");
+				return;
+			}
+
+			// Refreshes the session at the half of the timeout
+			if ((current - _last_keepalive_time) >= (_session_timeout * 1000 / 2))
+			{
+				_last_keepalive_time = current;
+				SendRequest(_is_get_parameter_supported ? "GET_PARAMETER" : "OPTIONS", _content_base, "", false);
+			}
+
+			StartKeepaliveTimer();
+		});
+	}
+
+	void RtspcClient::StartJitterBufferTimer()
+	{
+		_event_loop->CancelTimer(_jitter_buffer_timer_id);
+
+		_jitter_buffer_timer_id = _event_loop->AddTimer(RTSPC_JITTER_BUFFER_FLUSH_INTERVAL, [this]() {
+			_jitter_buffer_timer_id = 0;
+
+			auto now = RtpJitterBuffer::Clock::now();
+
+			for (size_t index = 0; (index < _jitter_buffer_list.size()) && (index < _track_list.size()); index++)
+			{
+				_released_packets.clear();
+				_jitter_buffer_list[index]->Flush(now, _released_packets);
+
+				if (AddReleasedPackets(_track_list[index].get()) == false)
+				{
+					return;
+				}
+			}
+
+			StartJitterBufferTimer();
+		});
+	}
+
+	void RtspcClient::CancelTimers()
+	{
+		for (auto timer_id : {&_response_timer_id, &_keepalive_timer_id, &_jitter_buffer_timer_id, &_reconnect_timer_id})
+		{
+			if (*timer_id != 0)
+			{
+				_event_loop->CancelTimer(*timer_id);
+				*timer_id = 0;
+			}
+		}
+	}
+}  // namespace pvd
@@ -0,0 +1,238 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "rtspc_event_loop.h"
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <base/ovlibrary/url.h>
+#include <base/ovsocket/socket_address.h>
+#include <providers/rtsp/rtp/rtp_jitter_buffer.h>
+#include <providers/rtsp/rtp/rtp_track_observer.h>
+#include <providers/rtsp/rtp/rtp_tcp_track.h>
+#include <providers/rtsp/rtsp_media_info.h>
+#include <providers/rtsp/rtsp_response.h>
+#include <providers/rtsp/rtsp_rtp_demuxer.h>
+
+#include <memory>
+#include <vector>
+
+// Timeout of the TCP connection and each response of the RTSP server
+#define RTSPC_RESPONSE_TIMEOUT (10 * 1000)
+// If no RTP/RTSP data is received for this time while playing, the client reconnects
+#define RTSPC_RECEIVE_TIMEOUT (10 * 1000)
+// The delay of the reconnection starts from RTSPC_RECONNECT_MIN_DELAY, and doubles up to RTSPC_RECONNECT_MAX_DELAY
+#define RTSPC_RECONNECT_MIN_DELAY (1 * 1000)
+#define RTSPC_RECONNECT_MAX_DELAY (30 * 1000)
+// Session timeout when the server does not specify it (RFC 2326 12.37)
+#define RTSPC_DEFAULT_SESSION_TIMEOUT (60)
+
+namespace pvd
+{
+	enum class RtspcTransport
+	{
+		Tcp,
+		Udp
+	};
+
+	// All the callbacks are called in the event loop of the client
+	class RtspcClientObserver : public RtpTrackObserver
+	{
+	public:
+		// Called when DESCRIBE is succeeded (also after every reconnection)
+		// track_list contains the tracks to be received (The id of the track is the payload type)
+		// @return false to stop the client
+		virtual bool OnRtspcDescribed(const std::vector<std::shared_ptr<MediaTrack>> &track_list) = 0;
+		// Called when PLAY is succeeded (also after every reconnection)
+		virtual void OnRtspcPlaying() = 0;
+		// Called when the connection is closed by an error
+		// will_reconnect is false if the session has never been played, and the client is stopped
+		virtual void OnRtspcClosed(bool will_reconnect) = 0;
+	};
+
+	// RTSP client that pulls a stream from a camera in an RtspcEventLoop
+	//
+	// OPTIONS -> DESCRIBE -> SETUP (for each track) -> PLAY, and then the RTP packets are depacketized by
+	// the RTP tracks of the RTSP provider. After PLAY is succeeded, the session is kept alive with GET_PARAMETER (or OPTIONS),
+	// and reconnected with an exponential backoff when the connection is lost.
+	class RtspcClient : public std::enable_shared_from_this<RtspcClient>
+	{
+	public:
+		static std::shared_ptr<RtspcClient> Create(const std::shared_ptr<RtspcEventLoop> &event_loop,
+												   const std::shared_ptr<const ov::Url> &url,
+												   RtspcTransport transport,
+												   uint32_t stream_id,
+												   RtspcClientObserver &observer);
+
+		RtspcClient(const std::shared_ptr<RtspcEventLoop> &event_loop,
+					const std::shared_ptr<const ov::Url> &url,
+					RtspcTransport transport,
+					uint32_t stream_id,
+					RtspcClientObserver &observer);
+		~RtspcClient();
+
+		// Starts to connect to the server in the event loop
+		void Start();
+		// Sends TEARDOWN and closes the connection. The observer is not called after Stop() returns
+		void Stop();
+
+		// These are valid after OnRtspcPlaying() is called
+		int64_t GetConnectTimeMSec() const
+		{
+			return _connect_time_msec;
+		}
+
+		int64_t GetNegotiationTimeMSec() const
+		{
+			return _negotiation_time_msec;
+		}
+
+	protected:
+		enum class State
+		{
+			Stopped,
+			Connecting,
+			Options,
+			Describe,
+			Setup,
+			Play,
+			Playing,
+			WaitingForReconnection
+		};
+
+		struct Request
+		{
+			ov::String method;
+			ov::String uri;
+			ov::String extra_headers;
+		};
+
+		struct SetupTrack
+		{
+			ov::String control_uri;
+			uint8_t payload_type;
+
+			// Used when the transport is UDP
+			int rtp_socket = -1;
+			int rtcp_socket = -1;
+			RtspcEventLoop::HandlerId rtp_handler_id = 0;
+			RtspcEventLoop::HandlerId rtcp_handler_id = 0;
+			uint16_t rtp_port = 0;
+			// server_port of the Transport header of the SETUP response (0 if the server does not specify it)
+			uint16_t server_rtp_port = 0;
+			uint16_t server_rtcp_port = 0;
+		};
+
+		// Methods below are called in the event loop
+
+		void Connect();
+		// Closes the connection, and reconnects if the session has been played
+		void Fail(const ov::String &reason);
+		void CloseConnection();
+
+		void OnSocketEvent(uint32_t events);
+		void OnConnected();
+		bool ReceiveData();
+		bool ProcessReceivedData();
+		bool FlushSendBuffer();
+
+		// If wait_for_response is false, the response is ignored (keepalive, TEARDOWN)
+		bool SendRequest(const ov::String &method, const ov::String &uri, const ov::String &extra_headers = "", bool wait_for_response = true);
+		void OnResponse(const RtspResponse &response);
+		void OnOptionsResponse(const RtspResponse &response);
+		void OnDescribeResponse(const RtspResponse &response);
+		void OnSetupResponse(const RtspResponse &response);
+		void OnPlayResponse(const RtspResponse &response);
+
+		bool SendNextSetup();
+		bool OpenUdpSockets(SetupTrack &setup_track);
+		void OnUdpSocketEvent(size_t setup_index, bool is_rtp, uint32_t events);
+		// Depacketizes _released_packets
+		// @return false if the client is stopped or closed by the observer
+		bool AddReleasedPackets(RtpTrack *track);
+		bool CreateTrack(const SetupTrack &setup_track, uint8_t rtp_channel, uint8_t rtcp_channel);
+
+		bool UpdateAuthorization(const RtspResponse &response);
+		ov::String MakeAuthorization(const ov::String &method, const ov::String &uri) const;
+
+		void StartResponseTimer();
+		void StartKeepaliveTimer();
+		// Releases the packets of the jitter buffers whose missing packets are timed out, even when no packet arrives
+		void StartJitterBufferTimer();
+		void CancelTimers();
+
+		std::shared_ptr<RtspcEventLoop> _event_loop;
+		std::shared_ptr<const ov::Url> _url;
+		// The URL without the credentials
+		ov::String _request_url;
+		RtspcTransport _transport;
+		uint32_t _stream_id;
+		RtspcClientObserver &_observer;
+
+		State _state = State::Stopped;
+		bool _has_played = false;
+
+		int _socket = -1;
+		// AF_INET or AF_INET6 (The UDP sockets use the same family)
+		int _socket_family = 0;
+		// The UDP packets from the other addresses are dropped
+		ov::SocketAddress _server_address;
+		RtspcEventLoop::HandlerId _socket_handler_id = 0;
+		// Increased whenever the connection is closed, to detect it in the middle of processing the received data
+		uint64_t _connection_id = 0;
+		std::vector<uint8_t> _send_buffer;
+		std::vector<uint8_t> _receive_buffer;
+		// A response whose body is not received yet
+		std::unique_ptr<RtspResponse> _pending_response;
+		// Decides the tracks of the interleaved RTP/RTCP ('$' + channel + length)
+		std::unique_ptr<RtspRtpDemuxer> _rtp_demuxer;
+		// Whether the demuxer is in the middle of an interleaved packet
+		bool _is_demuxing_rtp = false;
+		// Length of the body of a request from the server, which is ignored
+		size_t _skip_length = 0;
+
+		uint32_t _cseq = 0;
+		// CSeq of the request that the state machine waits for (The responses of the keepalives are ignored)
+		uint32_t _request_cseq = 0;
+		Request _last_request;
+		bool _is_get_parameter_supported = false;
+
+		ov::String _content_base;
+		ov::String _session_id;
+		int _session_timeout = RTSPC_DEFAULT_SESSION_TIMEOUT;
+
+		RtspMediaInfo _media_info;
+		std::vector<SetupTrack> _setup_track_list;
+		size_t _setup_index = 0;
+		std::vector<std::unique_ptr<RtpTcpTrack>> _track_list;
+		// Reorders the RTP packets of each track when the transport is UDP (same index as _track_list)
+		std::vector<std::unique_ptr<RtpJitterBuffer>> _jitter_buffer_list;
+		std::vector<RtpJitterBuffer::Packet> _released_packets;
+
+		// Authentication
+		bool _is_digest = false;
+		bool _is_authorization_sent = false;
+		ov::String _realm;
+		ov::String _nonce;
+		ov::String _opaque;
+		bool _is_qop_auth = false;
+		mutable uint32_t _nonce_count = 0;
+
+		RtspcEventLoop::TimerId _response_timer_id = 0;
+		RtspcEventLoop::TimerId _keepalive_timer_id = 0;
+		RtspcEventLoop::TimerId _jitter_buffer_timer_id = 0;
+		RtspcEventLoop::TimerId _reconnect_timer_id = 0;
+		int64_t _reconnect_delay = RTSPC_RECONNECT_MIN_DELAY;
+
+		int64_t _connect_start_time = 0;
+		int64_t _last_received_time = 0;
+		int64_t _last_keepalive_time = 0;
+		int64_t _connect_time_msec = 0;
+		int64_t _negotiation_time_msec = 0;
+	};
+}  // namespace pvd
@@ -0,0 +1,522 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "rtspc_event_loop.h"
+
+#include <base/ovsocket/socket.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#	include <sys/event.h>
+#else
+#	include <sys/eventfd.h>
+#endif  // defined(__APPLE__)
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+
+#define OV_LOG_TAG "RtspcEventLoop"
+
+// Maximum number of the events that are processed by one epoll_wait()/kevent()
+#define RTSPC_EVENT_LOOP_MAX_EVENTS (64)
+
+namespace pvd
+{
+	// Handler id 0 is not issued, so it is used for the wakeup event
+	constexpr RtspcEventLoop::HandlerId WakeupHandlerId = 0;
+
+#if defined(__APPLE__)
+	// Registers both filters of the fd (kqueue has a filter per event), and enables the ones in events
+	static int UpdateKqueueHandler(int kqueue_fd, int fd, uint64_t handler_id, uint32_t events, uint16_t flags)
+	{
+		struct kevent changes[2];
+
+		EV_SET(&changes[0], fd, EVFILT_READ, flags | (OV_CHECK_FLAG(events, EPOLLIN) ? EV_ENABLE : EV_DISABLE), 0, 0, reinterpret_cast<void *>(handler_id));
+		EV_SET(&changes[1], fd, EVFILT_WRITE, flags | (OV_CHECK_FLAG(events, EPOLLOUT) ? EV_ENABLE : EV_DISABLE), 0, 0, reinterpret_cast<void *>(handler_id));
+
+		return ::kevent(kqueue_fd, changes, 2, nullptr, 0, nullptr);
+	}
+#endif  // defined(__APPLE__)
+
+	int64_t RtspcEventLoop::GetCurrentMilliseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	RtspcEventLoop::~RtspcEventLoop()
+	{
+		Stop();
+	}
+
+	bool RtspcEventLoop::Start()
+	{
+		if (_is_running)
+		{
+			return true;
+		}
+
+#if defined(__APPLE__)
+		_poll_fd = ::kqueue();
+
+		if (_poll_fd == -1)
+		{
+			logte("Could not create kqueue: %s", ov::Error::CreateErrorFromErrno()->ToString().CStr());
+			return false;
+		}
+
+		struct kevent change;
+		EV_SET(&change, 0, EVFILT_USER, EV_ADD | EV_CLEAR, 0, 0, reinterpret_cast<void *>(WakeupHandlerId));
+
+		if (::kevent(_poll_fd, &change, 1, nullptr, 0, nullptr) == -1)
+		{
+			logte("Could not add the wakeup event to kqueue: %s", ov::Error::CreateErrorFromErrno()->ToString().CStr());
+
+			::close(_poll_fd);
+			_poll_fd = -1;
+			return false;
+		}
+#else   // defined(__APPLE__)
+		_poll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+
+		if (_poll_fd == -1)
+		{
+			logte("Could not create epoll: %s", ov::Error::CreateErrorFromErrno()->ToString().CStr());
+			return false;
+		}
+
+		_event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+		if (_event_fd == -1)
+		{
+			logte("Could not create eventfd: %s", ov::Error::CreateErrorFromErrno()->ToString().CStr());
+
+			::close(_poll_fd);
+			_poll_fd = -1;
+			return false;
+		}
+
+		epoll_event event{};
+		event.events = EPOLLIN;
+		event.data.u64 = WakeupHandlerId;
+		::epoll_ctl(_poll_fd, EPOLL_CTL_ADD, _event_fd, &event);
+#endif  // defined(__APPLE__)
+
+		_is_running = true;
+		_thread = std::thread(&RtspcEventLoop::LoopThread, this);
+
+		return true;
+	}
+
+	bool RtspcEventLoop::Stop()
+	{
+		if (_is_running == false)
+		{
+			return true;
+		}
+
+		{
+			// Invoke() checks _is_running with this lock, so no task is posted after the tasks below are run
+			std::lock_guard<std::mutex> lock_guard(_task_mutex);
+			_is_running = false;
+		}
+
+		Wakeup();
+
+		if (_thread.joinable())
+		{
+			_thread.join();
+		}
+
+		// Runs the tasks that are posted while stopping, since the callers of Invoke() are waiting for them
+		RunTasks();
+
+		_handler_map.clear();
+		_timer_map.clear();
+		_timer_due_map.clear();
+
+#if !defined(__APPLE__)
+		::close(_event_fd);
+		_event_fd = -1;
+#endif  // !defined(__APPLE__)
+		::close(_poll_fd);
+		_poll_fd = -1;
+
+		return true;
+	}
+
+	bool RtspcEventLoop::IsLoopThread() const
+	{
+		return std::this_thread::get_id() == _thread_id;
+	}
+
+	void RtspcEventLoop::Post(Task task)
+	{
+		{
+			std::lock_guard<std::mutex> lock_guard(_task_mutex);
+			_task_list.push_back(std::move(task));
+		}
+
+		Wakeup();
+	}
+
+	void RtspcEventLoop::Invoke(const Task &task)
+	{
+		if (IsLoopThread())
+		{
+			task();
+			return;
+		}
+
+		std::promise<void> promise;
+		auto future = promise.get_future();
+		bool is_posted = false;
+
+		{
+			std::lock_guard<std::mutex> lock_guard(_task_mutex);
+
+			if (_is_running)
+			{
+				_task_list.push_back([&task, &promise]() {
+					task();
+					promise.set_value();
+				});
+
+				is_posted = true;
+			}
+		}
+
+		if (is_posted == false)
+		{
+			task();
+			return;
+		}
+
+		Wakeup();
+		future.wait();
+	}
+
+	void RtspcEventLoop::Wakeup()
+	{
+#if defined(__APPLE__)
+		struct kevent change;
+		EV_SET(&change, 0, EVFILT_USER, 0, NOTE_TRIGGER, 0, reinterpret_cast<void *>(WakeupHandlerId));
+
+		::kevent(_poll_fd, &change, 1, nullptr, 0, nullptr);
+#else   // defined(__APPLE__)
+		uint64_t value = 1;
+
+		if (::write(_event_fd, &value, sizeof(value)) == -1)
+		{
+			// The counter of eventfd is full, so the loop will wake up anyway
+		}
+#endif  // defined(__APPLE__)
+	}
+
+	RtspcEventLoop::HandlerId RtspcEventLoop::AddHandler(int fd, uint32_t events, EventHandler handler)
+	{
+		OV_ASSERT2(IsLoopThread() || (_is_running == false));
+
+		auto handler_id = ++_last_handler_id;
+
+#if defined(__APPLE__)
+		if (UpdateKqueueHandler(_poll_fd, fd, handler_id, events, EV_ADD) == -1)
+#else   // defined(__APPLE__)
+		epoll_event event{};
+		event.events = events;
+		event.data.u64 = handler_id;
+
+		if (::epoll_ctl(_poll_fd, EPOLL_CTL_ADD, fd, &event) == -1)
+#endif  // defined(__APPLE__)
+		{
+			logte("Could not add fd %d to the event loop: %s", fd, ov::Error::CreateErrorFromErrno()->ToString().CStr());
+			return 0;
+		}
+
+		_handler_map[handler_id] = Handler{fd, std::move(handler)};
+
+		return handler_id;
+	}
+
+	bool RtspcEventLoop::ModifyHandler(HandlerId handler_id, uint32_t events)
+	{
+		auto item = _handler_map.find(handler_id);
+
+		if (item == _handler_map.end())
+		{
+			return false;
+		}
+
+#if defined(__APPLE__)
+		return UpdateKqueueHandler(_poll_fd, item->second.fd, handler_id, events, 0) == 0;
+#else   // defined(__APPLE__)
+		epoll_event event{};
+		event.events = events;
+		event.data.u64 = handler_id;
+
+		return ::epoll_ctl(_poll_fd, EPOLL_CTL_MOD, item->second.fd, &event) == 0;
+#endif  // defined(__APPLE__)
+	}
+
+	void RtspcEventLoop::RemoveHandler(HandlerId handler_id)
+	{
+		auto item = _handler_map.find(handler_id);
+
+		if (item == _handler_map.end())
+		{
+			return;
+		}
+
+		if (_poll_fd != -1)
+		{
+#if defined(__APPLE__)
+			UpdateKqueueHandler(_poll_fd, item->second.fd, handler_id, 0, EV_DELETE);
+#else   // defined(__APPLE__)
+			::epoll_ctl(_poll_fd, EPOLL_CTL_DEL, item->second.fd, nullptr);
+#endif  // defined(__APPLE__)
+		}
+
+		_handler_map.erase(item);
+	}
+
+	RtspcEventLoop::TimerId RtspcEventLoop::AddTimer(int64_t delay_msec, Task task)
+	{
+		OV_ASSERT2(IsLoopThread() || (_is_running == false));
+
+		auto timer_id = ++_last_timer_id;
+		auto due_time = GetCurrentMilliseconds() + std::max<int64_t>(delay_msec, 0);
+
+		_timer_map.emplace(std::make_pair(due_time, timer_id), std::move(task));
+		_timer_due_map[timer_id] = due_time;
+
+		return timer_id;
+	}
+
+	void RtspcEventLoop::CancelTimer(TimerId timer_id)
+	{
+		auto item = _timer_due_map.find(timer_id);
+
+		if (item == _timer_due_map.end())
+		{
+			return;
+		}
+
+		_timer_map.erase(std::make_pair(item->second, timer_id));
+		_timer_due_map.erase(item);
+	}
+
+	void RtspcEventLoop::RunTasks()
+	{
+		std::vector<Task> task_list;
+
+		{
+			std::lock_guard<std::mutex> lock_guard(_task_mutex);
+			task_list.swap(_task_list);
+		}
+
+		for (auto &task : task_list)
+		{
+			task();
+		}
+	}
+
+	int RtspcEventLoop::RunTimers()
+	{
+		auto current = GetCurrentMilliseconds();
+
+		while (_timer_map.empty() == false)
+		{
+			auto item = _timer_map.begin();
+			auto due_time = item->first.first;
+
+			if (due_time > current)
+			{
+				return static_cast<int>(due_time - current);
+			}
+
+			// The task can add/cancel the timers, so it is removed from the map before calling
+			auto task = std::move(item->second);
+			_timer_due_map.erase(item->first.second);
+			_timer_map.erase(item);
+
+			task();
+		}
+
+		return -1;
+	}
+
+	void RtspcEventLoop::CallHandler(HandlerId handler_id, uint32_t events)
+	{
+		// The handler can be removed by the previous handler
+		auto item = _handler_map.find(handler_id);
+
+		if (item != _handler_map.end())
+		{
+			// Copies the handler, since it can remove itself
+			auto handler = item->second.handler;
+			handler(events);
+		}
+	}
+
+	void RtspcEventLoop::WaitForEvents(int timeout_msec)
+	{
+#if defined(__APPLE__)
+		struct kevent events[RTSPC_EVENT_LOOP_MAX_EVENTS];
+		timespec timeout{timeout_msec / 1000, (timeout_msec % 1000) * 1000 * 1000};
+
+		int count = ::kevent(_poll_fd, nullptr, 0, events, RTSPC_EVENT_LOOP_MAX_EVENTS, (timeout_msec == -1) ? nullptr : &timeout);
+#else   // defined(__APPLE__)
+		epoll_event events[RTSPC_EVENT_LOOP_MAX_EVENTS];
+
+		int count = ::epoll_wait(_poll_fd, events, RTSPC_EVENT_LOOP_MAX_EVENTS, timeout_msec);
+#endif  // defined(__APPLE__)
+
+		if (count == -1)
+		{
+			if (errno != EINTR)
+			{
+				logte("Could not wait for the events: %s", ov::Error::CreateErrorFromErrno()->ToString().CStr());
+			}
+
+			return;
+		}
+
+		for (int index = 0; index < count; index++)
+		{
+#if defined(__APPLE__)
+			auto &event = events[index];
+			auto handler_id = static_cast<HandlerId>(reinterpret_cast<uintptr_t>(event.udata));
+
+			if (event.filter == EVFILT_USER)
+			{
+				// EV_CLEAR resets the trigger
+				continue;
+			}
+
+			// Converts to the epoll events, which the handlers expect
+			uint32_t handler_events = (event.filter == EVFILT_READ) ? EPOLLIN : EPOLLOUT;
+
+			if (OV_CHECK_FLAG(event.flags, EV_ERROR))
+			{
+				handler_events |= EPOLLERR;
+			}
+
+			if (OV_CHECK_FLAG(event.flags, EV_EOF))
+			{
+				handler_events |= (event.fflags != 0) ? EPOLLERR : EPOLLHUP;
+			}
+
+			CallHandler(handler_id, handler_events);
+#else   // defined(__APPLE__)
+			auto handler_id = events[index].data.u64;
+
+			if (handler_id == WakeupHandlerId)
+			{
+				uint64_t value;
+
+				if (::read(_event_fd, &value, sizeof(value)) == -1)
+				{
+					// Another wakeup has already consumed the counter
+				}
+
+				continue;
+			}
+
+			CallHandler(handler_id, events[index].events);
+#endif  // defined(__APPLE__)
+		}
+	}
+
+	void RtspcEventLoop::LoopThread()
+	{
+		_thread_id = std::this_thread::get_id();
+
+		logtd("Event loop is started");
+
+		while (_is_running)
+		{
+			WaitForEvents(RunTimers());
+
+			RunTasks();
+		}
+
+		logtd("Event loop is stopped");
+	}
+
+	RtspcEventLoopPool *RtspcEventLoopPool::GetInstance()
+	{
+		static auto instance = new RtspcEventLoopPool();
+
+		return instance;
+	}
+
+	bool RtspcEventLoopPool::Start()
+	{
+		std::lock_guard<std::mutex> lock_guard(_loop_list_mutex);
+
+		if (_loop_list.empty() == false)
+		{
+			return true;
+		}
+
+		auto count = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, RTSPC_EVENT_LOOP_MAX_COUNT);
+
+		for (size_t index = 0; index < count; index++)
+		{
+			auto loop = std::make_shared<RtspcEventLoop>();
+
+			if (loop->Start() == false)
+			{
+				for (auto &started_loop : _loop_list)
+				{
+					started_loop->Stop();
+				}
+
+				_loop_list.clear();
+				return false;
+			}
+
+			_loop_list.push_back(loop);
+		}
+
+		logti("%zu event loops are started for the RTSP pull clients", count);
+
+		return true;
+	}
+
+	bool RtspcEventLoopPool::Stop()
+	{
+		std::vector<std::shared_ptr<RtspcEventLoop>> loop_list;
+
+		{
+			std::lock_guard<std::mutex> lock_guard(_loop_list_mutex);
+			loop_list.swap(_loop_list);
+		}
+
+		for (auto &loop : loop_list)
+		{
+			loop->Stop();
+		}
+
+		return true;
+	}
+
+	std::shared_ptr<RtspcEventLoop> RtspcEventLoopPool::GetEventLoop()
+	{
+		std::lock_guard<std::mutex> lock_guard(_loop_list_mutex);
+
+		if (_loop_list.empty())
+		{
+			return nullptr;
+		}
+
+		auto loop = _loop_list[_next_loop_index % _loop_list.size()];
+		_next_loop_index++;
+
+		return loop;
+	}
+}  // namespace pvd
@@ -0,0 +1,126 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Maximum number of the event loops of RtspcEventLoopPool
+#define RTSPC_EVENT_LOOP_MAX_COUNT (4)
+
+namespace pvd
+{
+	// A thread that waits for the events of the sockets of many RTSP clients with one epoll (kqueue on macOS),
+	// so that the number of the threads does not grow with the number of the cameras.
+	//
+	// All the callbacks (socket events, timers, posted tasks) are called in the thread of the loop,
+	// so the state of a client that lives in a loop does not need a lock
+	class RtspcEventLoop
+	{
+	public:
+		using Task = std::function<void()>;
+		// events: EPOLLIN, EPOLLOUT, EPOLLERR, EPOLLHUP (base/ovsocket/socket.h defines them on macOS)
+		using EventHandler = std::function<void(uint32_t events)>;
+		using TimerId = uint64_t;
+		using HandlerId = uint64_t;
+
+		~RtspcEventLoop();
+
+		// Milliseconds of the monotonic clock, which is used by the timers
+		static int64_t GetCurrentMilliseconds();
+
+		bool Start();
+		bool Stop();
+
+		bool IsLoopThread() const;
+
+		// Can be called from any thread
+		void Post(Task task);
+		// Runs the task in the loop and waits for it to finish (The task is called directly if the caller is the loop thread, or the loop is not running)
+		void Invoke(const Task &task);
+
+		// The methods below must be called in the loop thread
+
+		// @return 0 if an error occurred
+		HandlerId AddHandler(int fd, uint32_t events, EventHandler handler);
+		bool ModifyHandler(HandlerId handler_id, uint32_t events);
+		void RemoveHandler(HandlerId handler_id);
+
+		// The task is called once after delay_msec
+		TimerId AddTimer(int64_t delay_msec, Task task);
+		void CancelTimer(TimerId timer_id);
+
+	protected:
+		struct Handler
+		{
+			int fd;
+			EventHandler handler;
+		};
+
+		void LoopThread();
+		// Calls the handlers of the events that occur within timeout_msec (-1: infinite)
+		void WaitForEvents(int timeout_msec);
+		void CallHandler(HandlerId handler_id, uint32_t events);
+
+		void Wakeup();
+		void RunTasks();
+		// @return Time until the nearest timer in milliseconds (-1 if there is no timer)
+		int RunTimers();
+
+		// epoll (Linux) or kqueue (macOS)
+		int _poll_fd = -1;
+#if !defined(__APPLE__)
+		// Used to wake up epoll_wait() when a task is posted (kqueue uses EVFILT_USER instead)
+		int _event_fd = -1;
+#endif  // !defined(__APPLE__)
+
+		std::atomic<bool> _is_running{false};
+		std::thread _thread;
+		std::atomic<std::thread::id> _thread_id;
+
+		std::mutex _task_mutex;
+		std::vector<Task> _task_list;
+
+		HandlerId _last_handler_id = 0;
+		// key: handler id (The id is stored in epoll_event/kevent instead of fd, since fd can be reused while the events are being processed)
+		std::unordered_map<HandlerId, Handler> _handler_map;
+
+		TimerId _last_timer_id = 0;
+		// key: <due time (msec), timer id>
+		std::map<std::pair<int64_t, TimerId>, Task> _timer_map;
+		// key: timer id, value: due time (msec)
+		std::unordered_map<TimerId, int64_t> _timer_due_map;
+	};
+
+	class RtspcEventLoopPool
+	{
+	public:
+		static RtspcEventLoopPool *GetInstance();
+
+		// The number of the loops is the number of the CPUs (up to RTSPC_EVENT_LOOP_MAX_COUNT)
+		bool Start();
+		bool Stop();
+
+		// Returns the loops in round-robin
+		std::shared_ptr<RtspcEventLoop> GetEventLoop();
+
+	protected:
+		RtspcEventLoopPool() = default;
+
+		std::mutex _loop_list_mutex;
+		std::vector<std::shared_ptr<RtspcEventLoop>> _loop_list;
+		size_t _next_loop_index = 0;
+	};
+}  // namespace pvd
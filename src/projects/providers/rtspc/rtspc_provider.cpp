@@ -39,12 +39,23 @@ namespace pvd
 
 	bool RtspcProvider::Start()
 	{
+		// All the RTSP pull streams share a few event loops instead of a thread per stream
+		if (RtspcEventLoopPool::GetInstance()->Start() == false)
+		{
+			logte("Could not start the event loops of RTSP pull streams");
+			return false;
+		}
+
 		return pvd::Provider::Start();
 	}
 
 	bool RtspcProvider::Stop()
 	{
-		return pvd::Provider::Stop();
+		auto result = pvd::Provider::Stop();
+
+		RtspcEventLoopPool::GetInstance()->Stop();
+
+		return result;
 	}
 
 	// Pull Stream
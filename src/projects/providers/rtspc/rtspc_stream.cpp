@@ -2,12 +2,17 @@
 // Created by soulk on 20. 1. 20.
 //
 
+#define OV_LOG_TAG "RtspcStream"
 
-#include "media_router/bitstream/avc_video_packet_fragmentizer.h"
 #include "base/info/application.h"
 #include "rtspc_stream.h"
 
-#define OV_LOG_TAG "RtspcStream"
+#include <providers/rtsp/rtsp.h>
+
+#include <chrono>
+
+// Time to wait for the first PLAY in Start() (connection + OPTIONS/DESCRIBE/SETUP/PLAY)
+#define RTSPC_START_TIMEOUT (RTSPC_RESPONSE_TIMEOUT * 2)
 
 namespace pvd
 {
@@ -33,13 +38,7 @@ namespace pvd
 	RtspcStream::RtspcStream(const std::shared_ptr<pvd::Application> &application, const info::Stream &stream_info, const std::vector<ov::String> &url_list)
 			: pvd::Stream(application, stream_info)
 	{
-		av_register_all(); 
-		avcodec_register_all(); 
-		avformat_network_init(); 
-
-		_stop_thread_flag = false;
 		_state = State::IDLE;
-		_format_context = 0;
 
 		for(auto &url : url_list)
 		{
@@ -54,377 +53,285 @@ namespace pvd
 		{
 			_curr_url = _url_list[0];
 		}
+	}
 
+	RtspcStream::~RtspcStream()
+	{
+		Stop();
+	}
 
-// For Test
-#if 0
-		// -------------------------------------------------------------------------------
-		// TODO(soulk): It is a temporary code. Import the RTSP URL from the bash script.
-		// -------------------------------------------------------------------------------
-		// Below is sample code for GET_URL.SH.
-		//	
-		// 		#!/bin/bash
-		// 		RTSP_URL=$(wget -qO- http://211.235.108.156:50202/rtsp/record1)
-		// 		echo $RTSP_URL
-
-		FILE* file_stream = popen( "/home/getroot/get_url.sh", "r" );
-
-		std::ostringstream output;
+	RtspcTransport RtspcStream::GetTransport() const
+	{
+		auto provider_info = _application->GetProvider<cfg::RtspPullProvider>();
 
-		while ( !feof(file_stream) && !ferror(file_stream) )
+		if ((provider_info != nullptr) && (provider_info->GetTransport().UpperCaseString() == "UDP"))
 		{
-			char buf[128];
-			int32_t bytesRead = fread( buf, 1, 128, file_stream );
-			output.write( buf, bytesRead );
+			return RtspcTransport::Udp;
 		}
 
-		ov::String result = output.str().c_str();
-		result = result.Replace("\n", "");
-
-		_curr_url = ov::Url::Parse(result.CStr());
-#endif
-	}
-
-	RtspcStream::~RtspcStream()
-	{
-		Stop();
+		return RtspcTransport::Tcp;
 	}
 
 	bool RtspcStream::Start()
 	{
-		if (_stop_thread_flag)
+		if(_state != State::IDLE && _state != State::ERROR)
 		{
 			return false;
 		}
 
-		auto begin = std::chrono::steady_clock::now();
-		if (!ConnectTo())
+		if(_curr_url == nullptr)
 		{
+			logte("There is no valid URL to pull [%s] stream", GetName().CStr());
+			_state = State::ERROR;
 			return false;
 		}
 
-		auto end = std::chrono::steady_clock::now();
-		std::chrono::duration<double, std::milli> elapsed = end - begin;
-		auto origin_request_time_msec = elapsed.count();
-
-		begin = std::chrono::steady_clock::now();
-		if (!RequestDescribe())
+		auto event_loop = RtspcEventLoopPool::GetInstance()->GetEventLoop();
+		if(event_loop == nullptr)
 		{
+			logte("There is no event loop to pull [%s] stream", GetName().CStr());
+			_state = State::ERROR;
 			return false;
 		}
 
-		if (!RequestPlay())
 		{
-			return false;
+			std::lock_guard<std::mutex> lock_guard(_start_mutex);
+			_is_start_completed = false;
+			_is_start_succeeded = false;
+			_track_list.clear();
 		}
 
-		end = std::chrono::steady_clock::now();
-		elapsed = end - begin;
-		auto origin_response_time_msec = elapsed.count();
+		_client = RtspcClient::Create(event_loop, _curr_url, GetTransport(), GetId(), *this);
+		_client->Start();
 
-		_stop_thread_flag = false;
-		_worker_thread = std::thread(&RtspcStream::WorkerThread, this);
-		_worker_thread.detach();
+		bool is_succeeded = false;
 
-		_stream_metrics = StreamMetrics(*std::static_pointer_cast<info::Stream>(GetSharedPtr()));
-		if(_stream_metrics != nullptr)
 		{
-			_stream_metrics->SetOriginRequestTimeMSec(origin_request_time_msec);
-			_stream_metrics->SetOriginResponseTimeMSec(origin_response_time_msec);
-		}
-
-		return pvd::Stream::Start();
-	}
+			std::unique_lock<std::mutex> lock(_start_mutex);
 
-	bool RtspcStream::Stop()
-	{
-		RequestStop();
+			_start_condition.wait_for(lock, std::chrono::milliseconds(RTSPC_START_TIMEOUT), [this]() -> bool {
+				return _is_start_completed;
+			});
 
-		return pvd::Stream::Stop();
-	}
+			is_succeeded = _is_start_completed && _is_start_succeeded;
+		}
 
-	bool RtspcStream::ConnectTo()
-	{
-		if(_state != State::IDLE && _state != State::ERROR)
+		if(is_succeeded == false)
 		{
-			return false;
-		}
+			logte("Could not pull [%s] stream from %s", GetName().CStr(), _curr_url->Source().CStr());
 
-		logti("Requested url[%d] : %s", strlen(_curr_url->Source().CStr()), _curr_url->Source().CStr() );
+			_client->Stop();
+			_client.reset();
 
-		_format_context = avformat_alloc_context(); 
-		if(_format_context == nullptr)
-		{
 			_state = State::ERROR;
-			logte("Canot create context");
-			
 			return false;
 		}
 
-		// Interrupt Callback for session termination.
-		_format_context->interrupt_callback.callback = InterruptCallback;
-		_format_context->interrupt_callback.opaque = this;
-
-		AVDictionary *options = NULL;
-		::av_dict_set(&options, "rtsp_transport", "tcp", 0);
-
-
-		int err = 0;
-    	if ( (err = ::avformat_open_input(&_format_context, _curr_url->Source().CStr(), NULL, &options))  < 0) 
+		// The tracks are not changed after Start() is completed
+		for(auto &track : _track_list)
 		{
-        	_state = State::ERROR;
-        	
-			char errbuf[256];
-			av_strerror(err, errbuf, sizeof(errbuf));
-
-			logte("Cannot open input file. error : %s", errbuf);
+			AddTrack(track);
+		}
 
-        	return false;
-    	}
+		_stream_metrics = StreamMetrics(*std::static_pointer_cast<info::Stream>(GetSharedPtr()));
+		if(_stream_metrics != nullptr)
+		{
+			_stream_metrics->SetOriginRequestTimeMSec(_client->GetConnectTimeMSec());
+			_stream_metrics->SetOriginResponseTimeMSec(_client->GetNegotiationTimeMSec());
+		}
 
-		_state = State::CONNECTED;
+		_state = State::PLAYING;
+		_is_playing = true;
 
-		return true;
+		return pvd::Stream::Start();
 	}
 
-	bool RtspcStream::RequestDescribe()
+	bool RtspcStream::Stop()
 	{
-		if(_state != State::CONNECTED)
-		{
-			return false;
-		}
+		_is_playing = false;
 
-		if (::avformat_find_stream_info(_format_context, NULL) < 0) 
+		if(_client != nullptr)
 		{
-        	_state = State::ERROR;        	
-        	logte("Could not find stream information");
-
-        	return false;
-        }
+			// The observer is not called after RtspcClient::Stop() returns
+			_client->Stop();
+			_client.reset();
+		}
 
-		for (uint32_t track_id = 0; track_id < _format_context->nb_streams; track_id++)
+		if(_state != State::IDLE && _state != State::ERROR)
 		{
-			AVStream *stream = _format_context->streams[track_id];
-
-			logtd("[%d] media_type[%d] codec_id[%d], extradata_size[%d]", track_id, stream->codecpar->codec_type, stream->codecpar->codec_id, stream->codecpar->extradata_size);
+			_state = State::STOPPED;
+		}
 
-			auto new_track = std::make_shared<MediaTrack>();
+		return pvd::Stream::Stop();
+	}
 
-			common::MediaType media_type = 	(stream->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)?common::MediaType::Video:
-											(stream->codecpar->codec_type == AVMEDIA_TYPE_AUDIO)?common::MediaType::Audio:
-											common::MediaType::Unknown;
+	bool RtspcStream::OnRtspcDescribed(const std::vector<std::shared_ptr<MediaTrack>> &track_list)
+	{
+		std::lock_guard<std::mutex> lock_guard(_start_mutex);
 
-			common::MediaCodecId media_codec = (stream->codecpar->codec_id == AV_CODEC_ID_H264)?common::MediaCodecId::H264:
-											   (stream->codecpar->codec_id == AV_CODEC_ID_VP8)?common::MediaCodecId::Vp8:
-											   (stream->codecpar->codec_id == AV_CODEC_ID_VP9)?common::MediaCodecId::Vp9:
-											   (stream->codecpar->codec_id == AV_CODEC_ID_FLV1)?common::MediaCodecId::Flv:
-											   (stream->codecpar->codec_id == AV_CODEC_ID_AAC)?common::MediaCodecId::Aac:
-											   (stream->codecpar->codec_id == AV_CODEC_ID_MP3)?common::MediaCodecId::Mp3:
-											   (stream->codecpar->codec_id == AV_CODEC_ID_OPUS)?common::MediaCodecId::Opus:
-											   common::MediaCodecId::None;
+		if(_is_start_completed == false)
+		{
+			_track_list = track_list;
+			return true;
+		}
 
+		// After the reconnection, the camera must provide the same tracks
+		if(track_list.size() != _track_list.size())
+		{
+			logte("[%s] stream: The tracks are changed after the reconnection (%zu -> %zu)", GetName().CStr(), _track_list.size(), track_list.size());
+			return false;
+		}
 
-			if (media_type == common::MediaType::Unknown || media_codec == common::MediaCodecId::None)
+		for(size_t index = 0; index < track_list.size(); index++)
+		{
+			if((track_list[index]->GetId() != _track_list[index]->GetId()) ||
+			   (track_list[index]->GetCodecId() != _track_list[index]->GetCodecId()))
 			{
-				logtp("Unknown media type or codec_id. media_type(%d), media_codec(%d)", media_type, media_codec);
-
-				continue;
+				logte("[%s] stream: The tracks are changed after the reconnection", GetName().CStr());
+				return false;
 			}
+		}
 
-			new_track->SetId(track_id);
-			new_track->SetCodecId(media_codec);
-			new_track->SetMediaType(media_type);
-			new_track->SetTimeBase(stream->time_base.num, stream->time_base.den);
-			new_track->SetBitrate(stream->codecpar->bit_rate);
-			new_track->SetStartFrameTime(0);
-			new_track->SetLastFrameTime(0);
+		return true;
+	}
+
+	void RtspcStream::OnRtspcPlaying()
+	{
+		{
+			std::lock_guard<std::mutex> lock_guard(_start_mutex);
 
-			// Video Specific parameters
-			if (media_type == common::MediaType::Video)
+			if(_is_start_completed)
 			{
-				new_track->SetFrameRate(av_q2d(stream->r_frame_rate));
-				new_track->SetWidth(stream->codecpar->width);
-				new_track->SetHeight(stream->codecpar->height);
+				logti("[%s] stream is reconnected to %s", GetName().CStr(), _curr_url->Source().CStr());
 			}
-			// Audio Specific parameters
-			else if(media_type == common::MediaType::Audio)
+			else
 			{
-				new_track->SetSampleRate(stream->codecpar->sample_rate);
-				new_track->GetSample().SetFormat(static_cast<common::AudioSample::Format>(common::AudioSample::Format::S16P));
-				new_track->GetChannel().SetLayout(static_cast<common::AudioChannel::Layout>(common::AudioChannel::Layout::LayoutStereo));
-
-				// Do not crate an audio track.
-				continue;
+				_is_start_completed = true;
+				_is_start_succeeded = true;
 			}
-
-			AddTrack(new_track);
 		}
 
-		_state = State::DESCRIBED;
-
-		return true;
+		_start_condition.notify_all();
 	}
 
-	bool RtspcStream::RequestPlay()
+	void RtspcStream::OnRtspcClosed(bool will_reconnect)
 	{
-		if(_state != State::DESCRIBED)
+		// RTP timestamps of the new session are not related to the previous ones
+		for(auto &item : _track_timestamp_map)
 		{
-			return false;
+			item.second.is_rebase_needed = true;
 		}
 
-		_state = State::PLAYING;
-
-		return true;
-	}
-
-	bool RtspcStream::RequestStop()
-	{
-		if (_state != State::PLAYING)
+		if(will_reconnect)
 		{
-			return false;
+			logtw("[%s] stream is disconnected, and will be reconnected", GetName().CStr());
+			return;
 		}
 
-		_state = State::STOPPING;
-		_stop_thread_flag = true;
-
-		return true;
-	}
-
-	bool RtspcStream::IsStopThread()
-	{
-		return _stop_thread_flag;
-	}
-
-	int RtspcStream::InterruptCallback(void *ctx)
-	{
-		if(ctx != nullptr)
 		{
-			auto obj = (RtspcStream*)ctx;
+			std::lock_guard<std::mutex> lock_guard(_start_mutex);
 
-			if(obj->IsStopThread() == true)				
+			if(_is_start_completed)
 			{
-				return true;
+				// Never happens, since the client always reconnects after PLAY is succeeded
+				return;
 			}
+
+			_is_start_completed = true;
+			_is_start_succeeded = false;
 		}
 
-	    return false;
+		_start_condition.notify_all();
 	}
 
-	void RtspcStream::WorkerThread()
+	int64_t RtspcStream::AdjustTimestamp(uint8_t track_id, uint32_t rtp_timestamp)
 	{
-		AVPacket packet;
-		packet.size = 0;
-		packet.data = nullptr;
+		auto &track_timestamp = _track_timestamp_map[track_id];
 
-		bool is_eof = false;
-		bool is_received_first_packet = false;
+		if(track_timestamp.is_rebase_needed)
+		{
+			// Continues from the last timestamp, so that the timestamps do not go back after the reconnection
+			track_timestamp.last_timestamp++;
+			track_timestamp.is_rebase_needed = false;
+		}
+		else
+		{
+			// Handles the wraparound of the 32-bit RTP timestamp
+			track_timestamp.last_timestamp += static_cast<int32_t>(rtp_timestamp - track_timestamp.last_rtp_timestamp);
+		}
 
+		track_timestamp.last_rtp_timestamp = rtp_timestamp;
 
+		return track_timestamp.last_timestamp;
+	}
 
-		while (!IsStopThread())
+	bool RtspcStream::OnVideoData(uint32_t stream_id,
+								  uint8_t track_id,
+								  uint32_t timestamp,
+								  const std::shared_ptr<std::vector<uint8_t>> &data,
+								  uint8_t flags,
+								  std::unique_ptr<FragmentationHeader> fragmentation_header)
+	{
+		if(_is_playing == false)
 		{
-			int32_t ret = ::av_read_frame(_format_context, &packet);
-			if ( ret < 0 )
-			{
-				if ( (ret == AVERROR_EOF || ::avio_feof(_format_context->pb)) && !is_eof)
-				{
-					// If EOF is not receiving packets anymore, end thread.
-					logtd("End of file");
-					_state = State::STOPPING;
-					is_eof = true;
-					break;
-				}
-
-				if (_format_context->pb && _format_context->pb->error)
-				{
-					// If the connection is broken, terminate the thread.
-					logte("Connection is broken");
-					_state = State::ERROR;
-					break;
-				}
-
-				if(IsStopThread())
-				{
-					logtd("Interrupted by end flag");
-					_state = State::STOPPING;
-					break;
-				}
-
-				logtw("Packet read timeout. retry");
-				continue;
-			}
-			else
-			{
-				is_eof = false;
-			}
-
-			// If the first packet is received as NOPTS_VALUE, reset the PTS value to zero.
-			if (!is_received_first_packet)
-			{
-				if (packet.pts == AV_NOPTS_VALUE)
-				{
-					packet.pts = 0;
-				}
-				if (packet.dts == AV_NOPTS_VALUE)
-				{	
-					packet.dts = 0;
-				}
-
-				is_received_first_packet = true;
-			}
-			
-			if(_stream_metrics != nullptr)
-			{
-				_stream_metrics->IncreaseBytesIn(packet.size);
-			}
+			return true;
+		}
 
-			auto track = GetTrack(packet.stream_index);
-			if(track == nullptr)
-			{
-				::av_packet_unref(&packet);
-				continue;
-			}
+		if(_stream_metrics != nullptr)
+		{
+			_stream_metrics->IncreaseBytesIn(data->size());
+		}
 
+		auto adjusted_timestamp = AdjustTimestamp(track_id, timestamp);
 
-			auto media_type = track->GetMediaType();
-			auto codec_id = track->GetCodecId();
-			auto flag = (packet.flags & AV_PKT_FLAG_KEY) ? MediaPacketFlag::Key : MediaPacketFlag::NoFlag;
+		auto media_packet = std::make_unique<MediaPacket>(common::MediaType::Video,
+			track_id,
+			data->data(),
+			data->size(),
+			adjusted_timestamp,
+			adjusted_timestamp,
+			-1LL,
+			flags & static_cast<uint8_t>(RtpVideoFlags::Keyframe) ?  MediaPacketFlag::Key : MediaPacketFlag::NoFlag);
+		media_packet->SetFragHeader(fragmentation_header.get());
 
-			// Make MediaPacket from AVPacket
-			auto media_packet = std::make_shared<MediaPacket>(track->GetMediaType(), track->GetId(), packet.data, packet.size, packet.pts, packet.dts, packet.duration, flag);
+		_application->SendFrame(GetSharedPtrAs<info::Stream>(), std::move(media_packet));
 
-			// SPS/PPS Insject from Extra Data
-			if(media_type == common::MediaType::Video && codec_id == common::MediaCodecId::H264)
-			{
-				AVStream *stream = _format_context->streams[packet.stream_index];
-
-				if(stream->codecpar->extradata != nullptr && stream->codecpar->extradata_size > 0)
-				{
-					if(flag == MediaPacketFlag::Key)
-					{
-						media_packet->GetData()->Insert(stream->codecpar->extradata, 0, stream->codecpar->extradata_size);
-						logtp("Injected SPS/PPS data. length:%d", stream->codecpar->extradata_size);
-					}
-				}
-			}
+		return true;
+	}
 
-			media_packet->GetData();
+	bool RtspcStream::OnAudioData(uint32_t stream_id,
+								  uint8_t track_id,
+								  uint32_t timestamp,
+								  const std::shared_ptr<std::vector<uint8_t>> &data)
+	{
+		if(_is_playing == false)
+		{
+			return true;
+		}
 
-			_application->SendFrame(GetSharedPtrAs<info::Stream>(), media_packet);
+		if(_stream_metrics != nullptr)
+		{
+			_stream_metrics->IncreaseBytesIn(data->size());
+		}
 
-			// logtp("track_id(%d), flags(%d), pts(%10lld), dts(%10lld), size(%d)", packet.stream_index, packet.flags, packet.pts, packet.dts, packet.size);
+		auto adjusted_timestamp = AdjustTimestamp(track_id, timestamp);
 
-			::av_packet_unref(&packet);
-		}
+		auto media_packet = std::make_unique<MediaPacket>(common::MediaType::Audio,
+			track_id,
+			data->data(),
+			data->size(),
+			adjusted_timestamp,
+			adjusted_timestamp,
+			-1LL,
+			MediaPacketFlag::Key);
 
-		if (_format_context)
-    	{
-        	avformat_close_input(&_format_context);
-        	_format_context = nullptr;
-    	}
+		_application->SendFrame(GetSharedPtrAs<info::Stream>(), std::move(media_packet));
 
-		_state = State::STOPPED;
+		return true;
+	}
 
-		logtd("terminated [%s] stream thread", GetName().CStr());
+	void RtspcStream::OnRtcpSenderReport(uint32_t stream_id, uint8_t track_id, const RtcpSenderReport &rtcp_sender_report)
+	{
+		// Each track is timestamped independently
 	}
-}
\ No newline at end of file
+}
@@ -4,26 +4,21 @@
 
 #pragma once
 
+#include "rtspc_client.h"
+
 #include <base/common_types.h>
 #include <base/ovlibrary/url.h>
 
 #include <base/provider/stream.h>
-#include <base/ovlibrary/semaphore.h>
 #include <base/provider/application.h>
-#include <modules/ovt_packetizer/ovt_packet.h>
-#include <modules/ovt_packetizer/ovt_depacketizer.h>
 
-extern "C"
-{
-#include <libavformat/avformat.h>
-#include <libavcodec/avcodec.h>
-#include <libavutil/pixdesc.h>
-#include <libavutil/opt.h>
-}
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
 
 namespace pvd
 {
-	class RtspcStream : public pvd::Stream
+	class RtspcStream : public pvd::Stream, public RtspcClientObserver
 	{
 	public:
 		static std::shared_ptr<RtspcStream>
@@ -33,24 +28,60 @@ namespace pvd
 
 		~RtspcStream() final;
 
+		// RtspcClientObserver
+		bool OnRtspcDescribed(const std::vector<std::shared_ptr<MediaTrack>> &track_list) override;
+		void OnRtspcPlaying() override;
+		void OnRtspcClosed(bool will_reconnect) override;
+
+		// RtpTrackObserver
+		bool OnVideoData(uint32_t stream_id,
+						 uint8_t track_id,
+						 uint32_t timestamp,
+						 const std::shared_ptr<std::vector<uint8_t>> &data,
+						 uint8_t flags,
+						 std::unique_ptr<FragmentationHeader> fragmentation_header) override;
+		bool OnAudioData(uint32_t stream_id,
+						 uint8_t track_id,
+						 uint32_t timestamp,
+						 const std::shared_ptr<std::vector<uint8_t>> &data) override;
+		void OnRtcpSenderReport(uint32_t stream_id,
+								uint8_t track_id,
+								const RtcpSenderReport &rtcp_sender_report) override;
+
 	private:
+		struct TrackTimestamp
+		{
+			uint32_t last_rtp_timestamp = 0;
+			int64_t last_timestamp = 0;
+			// The next RTP timestamp starts a new sequence (first packet, or after the reconnection)
+			bool is_rebase_needed = true;
+		};
+
 		bool Start() override;
 		bool Stop() override;
-		bool IsStopThread();
-		void WorkerThread();
-		bool ConnectTo();
-		bool RequestDescribe();
-		bool RequestPlay();
-		bool RequestStop();
+
+		RtspcTransport GetTransport() const;
+		// Converts the 32-bit RTP timestamp to the 64-bit timestamp that increases monotonically across the reconnections
+		int64_t AdjustTimestamp(uint8_t track_id, uint32_t rtp_timestamp);
 
 		std::vector<std::shared_ptr<const ov::Url>> _url_list;
 		std::shared_ptr<const ov::Url>				_curr_url;
-		bool _stop_thread_flag;
-		std::thread _worker_thread;
 
-		AVFormatContext *_format_context = NULL;
-		static int InterruptCallback(void *ctx);
+		std::shared_ptr<RtspcClient> _client;
+
+		// Signaled from the event loop while Start() is waiting for the first PLAY
+		std::mutex _start_mutex;
+		std::condition_variable _start_condition;
+		bool _is_start_completed = false;
+		bool _is_start_succeeded = false;
+		std::vector<std::shared_ptr<MediaTrack>> _track_list;
+
+		// Frames are dropped until the tracks are added
+		std::atomic<bool> _is_playing{false};
+
+		// key: track id (Accessed only in the event loop)
+		std::unordered_map<uint8_t, TrackTimestamp> _track_timestamp_map;
 
 		std::shared_ptr<mon::StreamMetrics> _stream_metrics;
 	};
-}
\ No newline at end of file
+}
@@ -43,7 +43,7 @@ bool OvtPublisher::Start()
 			const ov::String &ip = server_config.GetIp();
 			ov::SocketAddress address = ov::SocketAddress(ip.IsEmpty() ? nullptr : ip.CStr(), static_cast<uint16_t>(port));
 
-			_server_port = PhysicalPortManager::Instance()->CreatePort(origin.GetSocketType(), address);
+			_server_port = PhysicalPortManager::Instance()->CreatePort(origin.GetSocketType(), address, origin.GetWorkerCount());
 			if (_server_port != nullptr)
 			{
 				logti("Ovt Publisher has started listening on %s", address.ToString().CStr());
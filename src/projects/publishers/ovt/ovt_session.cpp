@@ -1,6 +1,7 @@
 #include "base/info/stream.h"
 #include "base/ovlibrary/byte_io.h"
 #include "base/publisher/stream.h"
+#include "modules/ovt_packetizer/ovt_packet.h"
 #include "ovt_session.h"
 #include "ovt_private.h"
 
@@ -46,7 +47,7 @@ bool OvtSession::Stop()
 	return Session::Stop();
 }
 
-bool OvtSession::SendOutgoingData(uint32_t packet_type, const std::shared_ptr<ov::Data> &packet)
+bool OvtSession::SendOutgoingData(uint32_t packet_type, const std::shared_ptr<const ov::Data> &packet)
 {
 	// packet_type in OvtSession means marker of OVT Packet
 	// OvtSession should send full packet so it will start to send from next packet of marker packet.
@@ -60,12 +61,26 @@ bool OvtSession::SendOutgoingData(uint32_t packet_type, const std::shared_ptr<ov
 		return false;
 	}
 
+	if(packet->GetLength() < OVT_FIXED_HEADER_SIZE)
+	{
+		return false;
+	}
+
 	// Set OVT Session ID into packet
 	// It is also possible to use OvtPacket::Load, but for performance, as follows.
-	auto buffer = packet->GetWritableDataAs<uint8_t>();
+	// The packet is shared with the other sessions, so only the header is copied and the payload is sent as it is.
+	auto header = std::make_shared<ov::Data>(packet->GetData(), OVT_FIXED_HEADER_SIZE);
+	auto buffer = header->GetWritableDataAs<uint8_t>();
 	ByteWriter<uint32_t>::WriteBigEndian(&buffer[12], GetId());
 
-	_connector->Send(packet->GetData(), packet->GetLength());
+	if(packet->GetLength() == OVT_FIXED_HEADER_SIZE)
+	{
+		_connector->Send(header);
+	}
+	else
+	{
+		_connector->Send({header, packet->Subdata(OVT_FIXED_HEADER_SIZE)});
+	}
 
 	return true;
 }
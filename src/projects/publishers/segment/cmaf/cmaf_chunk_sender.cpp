@@ -0,0 +1,299 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "cmaf_chunk_sender.h"
+#include "cmaf_private.h"
+
+#include <algorithm>
+
+CmafChunkSender::~CmafChunkSender()
+{
+	Stop();
+}
+
+bool CmafChunkSender::Start(int thread_count)
+{
+	if (_is_running.exchange(true))
+	{
+		logtw("Chunk sender is already running");
+		return false;
+	}
+
+	thread_count = std::max(thread_count, 1);
+
+	for (int index = 0; index < thread_count; index++)
+	{
+		auto worker = std::make_unique<Worker>();
+
+		worker->thread = std::thread(&CmafChunkSender::WorkerThread, this, worker.get());
+
+		_worker_list.push_back(std::move(worker));
+	}
+
+	return true;
+}
+
+bool CmafChunkSender::Stop()
+{
+	if (_is_running.exchange(false) == false)
+	{
+		return false;
+	}
+
+	for (auto &worker : _worker_list)
+	{
+		worker->queue.Stop();
+	}
+
+	for (auto &worker : _worker_list)
+	{
+		if (worker->thread.joinable())
+		{
+			worker->thread.join();
+		}
+	}
+
+	_worker_list.clear();
+
+	return true;
+}
+
+void CmafChunkSender::Push(const std::shared_ptr<CmafChunkedClient> &client, const std::shared_ptr<const CmafHttpChunk> &chunk)
+{
+	bool need_to_schedule = false;
+	bool need_to_close = false;
+
+	{
+		std::lock_guard<std::mutex> lock_guard(client->_mutex);
+
+		if (client->_is_closed)
+		{
+			return;
+		}
+
+		if (client->_is_waiting_for_independent_chunk)
+		{
+			if (chunk->is_independent == false)
+			{
+				client->_skipped_chunk_count++;
+				return;
+			}
+
+			client->_is_waiting_for_independent_chunk = false;
+		}
+
+		client->_pending_chunk_list.push_back(chunk);
+
+		if (client->_pending_chunk_list.size() > client->_max_pending_chunks)
+		{
+			auto remote = client->_client->GetResponse()->GetRemote();
+
+			switch (client->_policy)
+			{
+				case CmafLaggingClientPolicy::SkipToLive:
+					SkipToLive(client);
+
+					logtd("[%s] The client is lagging, %zu chunks are skipped so far", remote->ToString().CStr(), client->_skipped_chunk_count);
+					break;
+
+				case CmafLaggingClientPolicy::Disconnect:
+					logtw("[%s] The client is lagging (%zu chunks are pending), disconnecting...", remote->ToString().CStr(), client->_pending_chunk_list.size());
+
+					client->_pending_chunk_list.clear();
+					client->_is_closed = true;
+					need_to_close = true;
+					break;
+			}
+		}
+
+		if ((need_to_close == false) && (client->_is_scheduled == false))
+		{
+			client->_is_scheduled = true;
+			need_to_schedule = true;
+		}
+	}
+
+	if (need_to_close)
+	{
+		client->_client->GetResponse()->Close();
+	}
+	else if (need_to_schedule)
+	{
+		Schedule(client);
+	}
+}
+
+void CmafChunkSender::SkipToLive(const std::shared_ptr<CmafChunkedClient> &client)
+{
+	auto &pending_chunk_list = client->_pending_chunk_list;
+
+	// Dropping an inter frame breaks the frames that depend on it until the next key frame,
+	// so the client continues from the latest chunk that starts with a key frame
+	auto independent_chunk = std::find_if(pending_chunk_list.rbegin(), pending_chunk_list.rend(), [](const auto &chunk) -> bool {
+		return chunk->is_independent;
+	});
+
+	if (independent_chunk == pending_chunk_list.rend())
+	{
+		// Wait for the next key frame (or the next segment, which always starts with a key frame)
+		client->_skipped_chunk_count += pending_chunk_list.size();
+		pending_chunk_list.clear();
+		client->_is_waiting_for_independent_chunk = true;
+
+		return;
+	}
+
+	auto first_chunk_to_send = std::prev(independent_chunk.base());
+	client->_skipped_chunk_count += std::distance(pending_chunk_list.begin(), first_chunk_to_send);
+	pending_chunk_list.erase(pending_chunk_list.begin(), first_chunk_to_send);
+}
+
+void CmafChunkSender::Complete(const std::shared_ptr<CmafChunkedClient> &client)
+{
+	bool need_to_schedule = false;
+
+	{
+		std::lock_guard<std::mutex> lock_guard(client->_mutex);
+
+		client->_is_completed = true;
+
+		if ((client->_is_closed == false) && (client->_is_scheduled == false))
+		{
+			client->_is_scheduled = true;
+			need_to_schedule = true;
+		}
+	}
+
+	if (need_to_schedule)
+	{
+		Schedule(client);
+	}
+}
+
+void CmafChunkSender::Schedule(const std::shared_ptr<CmafChunkedClient> &client)
+{
+	if ((_is_running == false) || _worker_list.empty())
+	{
+		return;
+	}
+
+	// The flushes of a client are always done by the same worker
+	auto worker_index = static_cast<size_t>(client->_client->GetResponse()->GetRemote()->GetId());
+
+	_worker_list[worker_index % _worker_list.size()]->queue.Enqueue(std::shared_ptr<CmafChunkedClient>(client));
+}
+
+void CmafChunkSender::WorkerThread(Worker *worker)
+{
+	while (true)
+	{
+		auto client = worker->queue.Dequeue();
+
+		if (client.has_value() == false)
+		{
+			if (worker->queue.IsStopped())
+			{
+				break;
+			}
+
+			continue;
+		}
+
+		Flush(client.value());
+	}
+}
+
+void CmafChunkSender::Flush(const std::shared_ptr<CmafChunkedClient> &client)
+{
+	auto response = client->_client->GetResponse();
+	auto remote = response->GetRemote();
+
+	while (true)
+	{
+		std::shared_ptr<const CmafHttpChunk> chunk;
+		bool is_congested = false;
+
+		{
+			std::lock_guard<std::mutex> lock_guard(client->_mutex);
+
+			if ((client->_is_closed == false) && (remote->GetState() != ov::SocketState::Connected))
+			{
+				// The client is disconnected (e.g. while the socket was congested)
+				client->_pending_chunk_list.clear();
+				client->_is_closed = true;
+			}
+
+			if (client->_is_closed)
+			{
+				client->_is_scheduled = false;
+				return;
+			}
+
+			if (client->_pending_chunk_list.empty())
+			{
+				if (client->_is_completed == false)
+				{
+					// Wait for the next chunk (Push() will schedule the client again)
+					client->_is_scheduled = false;
+					return;
+				}
+
+				client->_is_closed = true;
+			}
+			else if (remote->IsSendQueueCongested())
+			{
+				// Keep _is_scheduled, so Push() does not schedule the client until the socket is relieved
+				is_congested = true;
+			}
+			else
+			{
+				chunk = std::move(client->_pending_chunk_list.front());
+				client->_pending_chunk_list.pop_front();
+			}
+		}
+
+		if (is_congested)
+		{
+			std::weak_ptr<CmafChunkedClient> weak_client = client;
+
+			remote->CallWhenSendQueueRelieved([this, weak_client]() {
+				auto client = weak_client.lock();
+
+				if (client != nullptr)
+				{
+					Schedule(client);
+				}
+			});
+
+			return;
+		}
+
+		if (chunk == nullptr)
+		{
+			// All the chunks of the segment are sent
+			if (response->SendChunkedData(nullptr) == false)
+			{
+				logtw("[%s] Could not response the CMAF chunk", remote->ToString().CStr());
+			}
+
+			response->Close();
+			return;
+		}
+
+		if (response->Send(chunk->data_list) == false)
+		{
+			logtd("[%s] Failed to send the chunked data", remote->ToString().CStr());
+
+			std::lock_guard<std::mutex> lock_guard(client->_mutex);
+
+			client->_pending_chunk_list.clear();
+			client->_is_closed = true;
+			client->_is_scheduled = false;
+			return;
+		}
+	}
+}
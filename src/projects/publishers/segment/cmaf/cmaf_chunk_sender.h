@@ -0,0 +1,107 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <http_server/http_client.h>
+
+#include <deque>
+#include <thread>
+
+// What to do with a client that cannot receive the chunks as fast as they are created
+enum class CmafLaggingClientPolicy
+{
+	// Drop the chunks that are not sent yet, and continue from the latest chunk that starts with a key frame
+	// (or the next segment). Each chunk is a complete moof/mdat pair, so the player only sees a gap
+	SkipToLive,
+	// Disconnect the client
+	Disconnect
+};
+
+// A chunk of the chunked transfer encoding ([size]\r\n, payload, \r\n), which is framed once and shared by the clients
+struct CmafHttpChunk
+{
+	CmafHttpChunk(std::vector<std::shared_ptr<const ov::Data>> data_list, bool is_independent)
+		: data_list(std::move(data_list)),
+		  is_independent(is_independent)
+	{
+	}
+
+	std::vector<std::shared_ptr<const ov::Data>> data_list;
+	// The sample of the chunk is a key frame (or audio), so the player can decode it without the previous chunks
+	bool is_independent;
+};
+
+// A client that is receiving a CMAF segment being created
+class CmafChunkedClient
+{
+public:
+	friend class CmafChunkSender;
+
+	CmafChunkedClient(const std::shared_ptr<HttpClient> &client, CmafLaggingClientPolicy policy, size_t max_pending_chunks)
+		: _client(client),
+		  _policy(policy),
+		  _max_pending_chunks(max_pending_chunks)
+	{
+	}
+
+	const std::shared_ptr<HttpClient> &GetHttpClient() const
+	{
+		return _client;
+	}
+
+protected:
+	std::shared_ptr<HttpClient> _client;
+	CmafLaggingClientPolicy _policy;
+	size_t _max_pending_chunks;
+
+	std::mutex _mutex;
+	std::deque<std::shared_ptr<const CmafHttpChunk>> _pending_chunk_list;
+	size_t _skipped_chunk_count = 0;
+	// The chunks are skipped until a chunk that starts with a key frame is pushed
+	bool _is_waiting_for_independent_chunk = false;
+	// The last chunk of the segment is queued
+	bool _is_completed = false;
+	// The client is queued to the sender (or waiting for the socket to be relieved)
+	bool _is_scheduled = false;
+	bool _is_closed = false;
+};
+
+// Sends the chunks of the CMAF segments to the clients, instead of the packetizer thread
+//
+// The packetizer only queues the chunk to the clients, and the sender threads send it
+// (including the TLS encryption). A client is flushed only while the send queue of its socket is not congested,
+// and is flushed again when the socket is relieved. So a slow client does not delay the packetizer or the other clients.
+class CmafChunkSender
+{
+public:
+	CmafChunkSender() = default;
+	~CmafChunkSender();
+
+	bool Start(int thread_count);
+	bool Stop();
+
+	void Push(const std::shared_ptr<CmafChunkedClient> &client, const std::shared_ptr<const CmafHttpChunk> &chunk);
+	// Finishes the response after the pending chunks are sent
+	void Complete(const std::shared_ptr<CmafChunkedClient> &client);
+
+protected:
+	struct Worker
+	{
+		ov::Queue<std::shared_ptr<CmafChunkedClient>> queue;
+		std::thread thread;
+	};
+
+	void Schedule(const std::shared_ptr<CmafChunkedClient> &client);
+	// Skips the pending chunks up to the last independent chunk (called with the lock of the client)
+	void SkipToLive(const std::shared_ptr<CmafChunkedClient> &client);
+	void WorkerThread(Worker *worker);
+	void Flush(const std::shared_ptr<CmafChunkedClient> &client);
+
+	std::vector<std::unique_ptr<Worker>> _worker_list;
+	std::atomic<bool> _is_running{false};
+};
@@ -84,7 +84,7 @@ bool CmafPacketizer::AppendVideoFrame(std::shared_ptr<PacketizerFrameData> &fram
 		if (chunk_data != nullptr && _chunked_transfer != nullptr)
 		{
 			// Response chunk data to HTTP client
-			_chunked_transfer->OnCmafChunkDataPush(_app_name, _stream_name, GetFileName(-1LL, common::MediaType::Video), true, chunk_data);
+			_chunked_transfer->OnCmafChunkDataPush(_app_name, _stream_name, GetFileName(-1LL, common::MediaType::Video), true, frame->type == PacketizerFrameType::VideoKeyFrame, chunk_data);
 		}
 
 		_last_video_pts = data->timestamp;
@@ -104,7 +104,7 @@ bool CmafPacketizer::AppendAudioFrame(std::shared_ptr<PacketizerFrameData> &fram
 		if (chunk_data != nullptr && _chunked_transfer != nullptr)
 		{
 			// Response chunk data to HTTP client
-			_chunked_transfer->OnCmafChunkDataPush(_app_name, _stream_name, GetFileName(-1LL, common::MediaType::Audio), false, chunk_data);
+			_chunked_transfer->OnCmafChunkDataPush(_app_name, _stream_name, GetFileName(-1LL, common::MediaType::Audio), false, true, chunk_data);
 		}
 
 		_last_audio_pts = data->timestamp;
@@ -330,9 +330,7 @@ bool CmafPacketizer::UpdatePlayList()
 					 //  << "\t<UTCTiming schemeIdUri=\"urn:mpeg:dash:utc:direct:2014\" value=\"%s\"/>\n"
 					 << "</MPD>\n";
 
-	ov::String play_list = play_list_stream.str().c_str();
-
-	SetPlayList(play_list);
+	SetPlayList(play_list_stream.str().c_str());
 
 	return true;
 }
@@ -16,9 +16,11 @@ class ICmafChunkedTransfer
 {
 public:
 	// This callback will be called when each frame is received
+	// is_key_frame: the chunk can be decoded without the previous chunks (always true for audio)
 	virtual void OnCmafChunkDataPush(const ov::String &app_name, const ov::String &stream_name,
 									 const ov::String &file_name,
 									 bool is_video,
+									 bool is_key_frame,
 									 std::shared_ptr<ov::Data> &chunk_data) = 0;
 
 	virtual void OnCmafChunkedComplete(const ov::String &app_name, const ov::String &stream_name,
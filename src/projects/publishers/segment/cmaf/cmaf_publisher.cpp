@@ -44,5 +44,25 @@ std::shared_ptr<pub::Application> CmafPublisher::OnCreatePublisherApplication(co
 	}
 	*/
 
-	return CmafApplication::Create(application_info, std::static_pointer_cast<CmafStreamServer>(_stream_server));
+	auto stream_server = std::static_pointer_cast<CmafStreamServer>(_stream_server);
+	auto publisher_info = application_info.GetPublisher<cfg::LlDashPublisher>();
+
+	if (publisher_info != nullptr)
+	{
+		auto policy = CmafLaggingClientPolicy::SkipToLive;
+		auto &policy_name = publisher_info->GetLaggingClientPolicy();
+
+		if (policy_name.UpperCaseString() == "DISCONNECT")
+		{
+			policy = CmafLaggingClientPolicy::Disconnect;
+		}
+		else if (policy_name.UpperCaseString() != "SKIPTOLIVE")
+		{
+			logtw("Unknown lagging client policy: %s, SkipToLive will be used", policy_name.CStr());
+		}
+
+		stream_server->SetLaggingClientPolicy(application_info.GetName(), policy, publisher_info->GetMaxPendingChunks());
+	}
+
+	return CmafApplication::Create(application_info, stream_server);
 }
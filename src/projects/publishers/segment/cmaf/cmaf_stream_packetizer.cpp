@@ -65,7 +65,7 @@ bool CmafStreamPacketizer::AppendAudioFrame(std::shared_ptr<PacketizerFrameData>
 // Get PlayList
 // - MPD
 //====================================================================================================
-bool CmafStreamPacketizer::GetPlayList(ov::String &play_list)
+bool CmafStreamPacketizer::GetPlayList(std::shared_ptr<const ov::Data> &play_list)
 {
 	return _packetizer->GetPlayList(play_list);
 }
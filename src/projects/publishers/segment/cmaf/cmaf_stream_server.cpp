@@ -11,6 +11,27 @@
 #include "cmaf_packetizer.h"
 #include "cmaf_private.h"
 
+// Number of the threads that send the chunks to the clients
+#define CMAF_CHUNK_SENDER_THREAD_COUNT (4)
+#define CMAF_DEFAULT_MAX_PENDING_CHUNKS (60)
+
+CmafStreamServer::CmafStreamServer()
+{
+	_chunk_sender.Start(CMAF_CHUNK_SENDER_THREAD_COUNT);
+}
+
+CmafStreamServer::~CmafStreamServer()
+{
+	_chunk_sender.Stop();
+}
+
+void CmafStreamServer::SetLaggingClientPolicy(const ov::String &app_name, CmafLaggingClientPolicy policy, size_t max_pending_chunks)
+{
+	std::unique_lock<std::mutex> lock(_http_chunk_guard);
+
+	_lagging_client_policy_map[app_name] = {policy, max_pending_chunks};
+}
+
 HttpConnection CmafStreamServer::ProcessSegmentRequest(const std::shared_ptr<HttpClient> &client,
 												  const ov::String &app_name, const ov::String &stream_name,
 												  const ov::String &file_name,
@@ -46,7 +67,16 @@ HttpConnection CmafStreamServer::ProcessSegmentRequest(const std::shared_ptr<Htt
 			response->AppendData(chunk_item->second->chunked_data);
 			response->Response();
 
-			chunk_item->second->client_list.push_back(client);
+			// The next chunks are sent by the chunk sender
+			LaggingClientPolicy policy{CmafLaggingClientPolicy::SkipToLive, CMAF_DEFAULT_MAX_PENDING_CHUNKS};
+			auto policy_item = _lagging_client_policy_map.find(app_name);
+
+			if (policy_item != _lagging_client_policy_map.end())
+			{
+				policy = policy_item->second;
+			}
+
+			chunk_item->second->client_list.push_back(std::make_shared<CmafChunkedClient>(client, policy.policy, policy.max_pending_chunks));
 
 			return HttpConnection::KeepAlive;
 		}
@@ -58,6 +88,7 @@ HttpConnection CmafStreamServer::ProcessSegmentRequest(const std::shared_ptr<Htt
 void CmafStreamServer::OnCmafChunkDataPush(const ov::String &app_name, const ov::String &stream_name,
 										   const ov::String &file_name,
 										   bool is_video,
+										   bool is_key_frame,
 										   std::shared_ptr<ov::Data> &chunk_data)
 {
 	auto key = ov::String::FormatString("%s/%s/%s", app_name.CStr(), stream_name.CStr(), file_name.CStr());
@@ -75,14 +106,17 @@ void CmafStreamServer::OnCmafChunkDataPush(const ov::String &app_name, const ov:
 
 	chunk_item->second->AddChunkData(chunk_data);
 
-	for (auto client : chunk_item->second->client_list)
+	if (chunk_item->second->client_list.empty())
 	{
-		auto response = client->GetResponse();
+		return;
+	}
 
-		if (response->SendChunkedData(chunk_data) == false)
-		{
-			logtd("Failed to send the chunked data for [%s/%s, %s] to %s (%zu bytes)", app_name.CStr(), stream_name.CStr(), file_name.CStr(), response->GetRemote()->ToString().CStr(), chunk_data->GetLength());
-		}
+	// Make the chunk once, and queue it to the clients (The chunk sender sends it)
+	auto chunk = std::make_shared<const CmafHttpChunk>(HttpResponse::MakeChunk(chunk_data), is_key_frame);
+
+	for (auto &client : chunk_item->second->client_list)
+	{
+		_chunk_sender.Push(client, chunk);
 	}
 }
 
@@ -113,16 +147,9 @@ void CmafStreamServer::OnCmafChunkedComplete(const ov::String &app_name, const o
 
 	logtd("The chunk is completed [%s/%s, %s]", app_name.CStr(), stream_name.CStr(), file_name.CStr());
 
-	for (auto client : chunked_data->client_list)
+	for (auto &client : chunked_data->client_list)
 	{
-		auto response = client->GetResponse();
-
-		if (response->SendChunkedData(nullptr) == false)
-		{
-			logtw("[%s] Could not response the CMAF chunk: [%s/%s, %s]",
-				  response->GetRemote()->ToString().CStr(), app_name.CStr(), stream_name.CStr(), file_name.CStr());
-		}
-
-		response->Close();
+		// The response is finished after the pending chunks are sent
+		_chunk_sender.Complete(client);
 	}
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 //==============================================================================
 #pragma once
 
+#include "cmaf_chunk_sender.h"
 #include "cmaf_interceptor.h"
 #include "cmaf_packetizer.h"
 
@@ -16,6 +17,9 @@
 class CmafStreamServer : public DashStreamServer, public ICmafChunkedTransfer
 {
 public:
+	CmafStreamServer();
+	~CmafStreamServer() override;
+
 	PublisherType GetPublisherType() const noexcept override
 	{
 		return PublisherType::LlDash;
@@ -31,6 +35,9 @@ public:
 		return std::make_shared<CmafInterceptor>();
 	}
 
+	// Sets how to handle the lagging clients of the application
+	void SetLaggingClientPolicy(const ov::String &app_name, CmafLaggingClientPolicy policy, size_t max_pending_chunks);
+
 protected:
 	struct CmafHttpChunkedData
 	{
@@ -47,7 +54,13 @@ protected:
 		}
 
 		std::shared_ptr<ov::Data> chunked_data;
-		std::vector<std::shared_ptr<HttpClient>> client_list;
+		std::vector<std::shared_ptr<CmafChunkedClient>> client_list;
+	};
+
+	struct LaggingClientPolicy
+	{
+		CmafLaggingClientPolicy policy;
+		size_t max_pending_chunks;
 	};
 
 	//--------------------------------------------------------------------
@@ -64,6 +77,7 @@ protected:
 	void OnCmafChunkDataPush(const ov::String &app_name, const ov::String &stream_name,
 							 const ov::String &file_name,
 							 bool is_video,
+							 bool is_key_frame,
 							 std::shared_ptr<ov::Data> &chunk_data) override;
 
 	void OnCmafChunkedComplete(const ov::String &app_name, const ov::String &stream_name,
@@ -74,4 +88,9 @@ protected:
 	// Key: [app name]/[stream name]/[file name]
 	std::map<ov::String, std::shared_ptr<CmafHttpChunkedData>> _http_chunk_list;
 	std::mutex _http_chunk_guard;
+
+	// Key: app name
+	std::map<ov::String, LaggingClientPolicy> _lagging_client_policy_map;
+
+	CmafChunkSender _chunk_sender;
 };
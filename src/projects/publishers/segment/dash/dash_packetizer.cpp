@@ -10,6 +10,8 @@
 #include "dash_define.h"
 #include "dash_private.h"
 
+#include <modules/h264/h264_nal_unit_scanner.h>
+
 #include <algorithm>
 #include <iomanip>
 #include <numeric>
@@ -143,39 +145,14 @@ ov::String DashPacketizer::GetFileName(int64_t start_timestamp, common::MediaTyp
 bool DashPacketizer::WriteVideoInitInternal(const std::shared_ptr<ov::Data> &frame, const ov::String &init_file_name)
 {
 	const uint8_t* srcData = frame->GetDataAs<uint8_t>();
-	size_t dataOffset = 0;
 	size_t dataSize = frame->GetLength();
 
-	std::vector<std::pair<size_t, size_t>> offset_list;
-
 	// int total_start_pattern_size = 0;
 	int nal_packet_header_length = 3;
 
 	// Stage 1 - Extract the Offset and Lengh value of the NAL Packet
-
-	while ( dataOffset < dataSize )
-	{
-		size_t remainDataSize = dataSize - dataOffset;
-		const uint8_t* data = srcData + dataOffset;
-
-		if (remainDataSize >= 3 && 0x00 == data[0] && 0x00 == data[1] && 0x01 == data[2])
-		{
-			nal_packet_header_length = 3;
-			offset_list.emplace_back(dataOffset, 3); // Offset, SIZEOF(START_CODE[3])
-			dataOffset += 3;
-		}
-		else if (remainDataSize >= 4 && 0x00 == data[0] &&  0x00 == data[1] && 0x00 == data[2] && 0x01 == data[3])
-		{
-			nal_packet_header_length = 4;
-			offset_list.emplace_back(dataOffset, 4); // Offset, SIZEOF(START_CODE[4])
-			dataOffset += 4;
-		}
-		else
-		{
-			dataOffset += 1;
-		}
-	}
-
+	FragmentationHeader nal_unit_index;
+	H264NalUnitScanner::MakeNalUnitIndex(srcData, dataSize, &nal_unit_index);
 
 	// Stage 2  : Get position for SPS and PPS type
 
@@ -184,22 +161,13 @@ bool DashPacketizer::WriteVideoInitInternal(const std::shared_ptr<ov::Data> &fra
 	int pps_start_index = -1;
 	int pps_length = -1;
 
-	for (size_t index = 0; index < offset_list.size(); ++index)
+	for (size_t index = 0; index < nal_unit_index.GetCount(); ++index)
 	{
-		size_t nalu_offset = 0;
-		size_t nalu_data_len = 0;
-
-		if (index != offset_list.size() - 1)
-		{
-			nalu_offset = offset_list[index].first + offset_list[index].second;
-			nalu_data_len = offset_list[index + 1].first - nalu_offset ;
-		}
-		else
-		{
-			nalu_offset = offset_list[index].first + offset_list[index].second;
-			nalu_data_len = dataSize - nalu_offset;
-		}
+		size_t nalu_offset = nal_unit_index.fragmentation_offset[index];
+		size_t nalu_data_len = nal_unit_index.fragmentation_length[index];
 
+		// 00 00 00 01 or 00 00 01
+		nal_packet_header_length = ((nalu_offset >= 4) && (srcData[nalu_offset - 4] == 0x00)) ? 4 : 3;
 
 		// [Difinition of NAL_UNIT_TYPE]
 
@@ -229,11 +197,10 @@ bool DashPacketizer::WriteVideoInitInternal(const std::shared_ptr<ov::Data> &fra
 		uint8_t nal_ref_idc = (nalu_header >> 5)  & 0x03;
 		if ( (nal_unit_type == (uint8_t)5) || (nal_unit_type == (uint8_t)6) || (nal_unit_type == (uint8_t)7) || (nal_unit_type == (uint8_t)8))
 		{
-			logte("[%d] nal_ref_idc:%2d, nal_unit_type:%2d => offset:%d, nalu_size:%d, nalu_offset:%d, nalu_length:%d"
+			logte("[%d] nal_ref_idc:%2d, nal_unit_type:%2d => start_code_size:%d, nalu_offset:%d, nalu_length:%d"
 				, index
 				, nal_ref_idc, nal_unit_type
-				, offset_list[index].first
-				, offset_list[index].second
+				, nal_packet_header_length
 				, nalu_offset
 				, nalu_data_len);
 		}
@@ -860,28 +827,8 @@ const std::shared_ptr<SegmentData> DashPacketizer::GetSegmentData(const ov::Stri
 	switch (file_type)
 	{
 		case DashFileType::VideoSegment:
-		{
-			std::unique_lock<std::mutex> lock(_video_segment_guard);
-
-			auto item = std::find_if(_video_segment_datas.begin(), _video_segment_datas.end(),
-									 [&](std::shared_ptr<SegmentData> const &value) -> bool {
-										 return value != nullptr ? value->file_name == file_name : false;
-									 });
-
-			return (item != _video_segment_datas.end()) ? (*item) : nullptr;
-		}
-
 		case DashFileType::AudioSegment:
-		{
-			std::unique_lock<std::mutex> lock(_audio_segment_guard);
-
-			auto item = std::find_if(_audio_segment_datas.begin(), _audio_segment_datas.end(),
-									 [&](std::shared_ptr<SegmentData> const &value) -> bool {
-										 return value != nullptr ? value->file_name == file_name : false;
-									 });
-
-			return (item != _audio_segment_datas.end()) ? (*item) : nullptr;
-		}
+			return FindSegment(file_name);
 
 		case DashFileType::VideoInit:
 			return _video_init_file;
@@ -948,6 +895,8 @@ bool DashPacketizer::SetSegmentData(ov::String file_name, uint64_t duration, int
 			break;
 	}
 
+	UpdateSegmentIndex();
+
 	if ((IsReadyForStreaming() == false) && (((_video_track == nullptr) || (_video_segment_count >= _segment_count)) &&
 											 ((_audio_track == nullptr) || (_audio_segment_count >= _segment_count))))
 	{
@@ -967,7 +916,7 @@ void DashPacketizer::SetReadyForStreaming() noexcept
 	Packetizer::SetReadyForStreaming();
 }
 
-bool DashPacketizer::GetPlayList(ov::String &play_list)
+bool DashPacketizer::GetPlayList(std::shared_ptr<const ov::Data> &play_list)
 {
 	if (IsReadyForStreaming() == false)
 	{
@@ -975,9 +924,34 @@ bool DashPacketizer::GetPlayList(ov::String &play_list)
 		return false;
 	}
 
+	auto play_list_template = GetPlayListSnapshot();
+
+	if (play_list_template == nullptr)
+	{
+		return false;
+	}
+
+	// The playlist has a placeholder (%s) of <UTCTiming> that must be replaced with the current time
+	auto buffer = play_list_template->GetDataAs<char>();
+	auto length = play_list_template->GetLength();
+	auto placeholder = static_cast<const char *>(::memmem(buffer, length, "%s", 2));
+
+	if (placeholder == nullptr)
+	{
+		// Serve the snapshot as is
+		play_list = play_list_template;
+		return true;
+	}
+
 	ov::String current_time = MakeUtcMillisecond();
+	auto placeholder_offset = static_cast<size_t>(placeholder - buffer);
+
+	auto data = std::make_shared<ov::Data>(length + current_time.GetLength());
+	data->Append(buffer, placeholder_offset);
+	data->Append(current_time.CStr(), current_time.GetLength());
+	data->Append(placeholder + 2, length - placeholder_offset - 2);
 
-	play_list = ov::String::FormatString(_play_list.CStr(), current_time.CStr());
+	play_list = data;
 
 	return true;
 }
@@ -47,7 +47,7 @@ public:
 	const std::shared_ptr<SegmentData> GetSegmentData(const ov::String &file_name) override;
 	bool SetSegmentData(ov::String file_name, uint64_t duration, int64_t timestamp, std::shared_ptr<ov::Data> &data) override;
 
-	bool GetPlayList(ov::String &play_list) override;
+	bool GetPlayList(std::shared_ptr<const ov::Data> &play_list) override;
 
 protected:
 	using DataCallback = std::function<void(const std::shared_ptr<const SampleData> &data, bool new_segment_written)>;
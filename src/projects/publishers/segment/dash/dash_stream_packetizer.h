@@ -33,7 +33,7 @@ public :
     // Implement StreamPacketizer Interface
     bool AppendVideoFrame(std::shared_ptr<PacketizerFrameData> &data) override;
     bool AppendAudioFrame(std::shared_ptr<PacketizerFrameData> &data) override;
-    bool GetPlayList(ov::String &play_list) override;
+    bool GetPlayList(std::shared_ptr<const ov::Data> &play_list) override;
 	std::shared_ptr<SegmentData> GetSegmentData(const ov::String &file_name) override;
 
 private :
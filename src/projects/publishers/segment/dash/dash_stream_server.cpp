@@ -39,7 +39,7 @@ HttpConnection DashStreamServer::ProcessPlayListRequest(const std::shared_ptr<Ht
 {
 	auto response = client->GetResponse();
 
-	ov::String play_list;
+	std::shared_ptr<const ov::Data> play_list;
 
 	auto item = std::find_if(_observers.begin(), _observers.end(),
 							 [&client, &app_name, &stream_name, &file_name, &play_list](auto &observer) -> bool {
@@ -55,7 +55,7 @@ HttpConnection DashStreamServer::ProcessPlayListRequest(const std::shared_ptr<Ht
 		return HttpConnection::Closed;
 	}
 
-	if(response->GetStatusCode() != HttpStatusCode::OK || play_list.IsEmpty())
+	if(response->GetStatusCode() != HttpStatusCode::OK || (play_list == nullptr) || (play_list->GetLength() == 0))
 	{
 		response->Response();
 		return HttpConnection::Closed;
@@ -67,7 +67,7 @@ HttpConnection DashStreamServer::ProcessPlayListRequest(const std::shared_ptr<Ht
 	response->SetHeader("Pragma", "no-cache");
 	response->SetHeader("Expires", "0");
 		
-	response->AppendString(play_list);
+	response->AppendData(play_list);
 	response->Response();
 
 	return HttpConnection::Closed;
@@ -219,8 +219,7 @@ bool HlsPacketizer::UpdatePlayList()
 					 << m3u8_play_list.str();
 
 	// Playlist 설정
-	ov::String play_list = play_list_stream.str().c_str();
-	SetPlayList(play_list);
+	SetPlayList(play_list_stream.str().c_str());
 
 	if ((_stream_type == PacketizerStreamType::Common) && IsReadyForStreaming())
 	{
@@ -245,20 +244,7 @@ const std::shared_ptr<SegmentData> HlsPacketizer::GetSegmentData(const ov::Strin
 		return nullptr;
 	}
 
-	// video segment mutex
-	std::unique_lock<std::mutex> lock(_video_segment_guard);
-
-	auto item = std::find_if(_video_segment_datas.begin(),
-							 _video_segment_datas.end(), [&](std::shared_ptr<SegmentData> const &value) -> bool {
-								 return value != nullptr ? value->file_name == file_name : false;
-							 });
-
-	if (item == _video_segment_datas.end())
-	{
-		return nullptr;
-	}
-
-	return (*item);
+	return FindSegment(file_name);
 }
 
 bool HlsPacketizer::SetSegmentData(ov::String file_name,
@@ -274,16 +260,20 @@ bool HlsPacketizer::SetSegmentData(ov::String file_name,
 		duration,
 		data);
 
-	// video segment mutex
-	std::unique_lock<std::mutex> lock(_video_segment_guard);
+	{
+		// video segment mutex
+		std::unique_lock<std::mutex> lock(_video_segment_guard);
 
-	_video_segment_datas[_current_video_index++] = segment_data;
+		_video_segment_datas[_current_video_index++] = segment_data;
 
-	if (_segment_save_count <= _current_video_index)
-	{
-		_current_video_index = 0;
+		if (_segment_save_count <= _current_video_index)
+		{
+			_current_video_index = 0;
+		}
 	}
 
+	UpdateSegmentIndex();
+
 	if ((IsReadyForStreaming() == false) && (_sequence_number > _segment_count))
 	{
 		SetReadyForStreaming();
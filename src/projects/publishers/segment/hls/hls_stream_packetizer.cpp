@@ -63,7 +63,7 @@ bool HlsStreamPacketizer::AppendAudioFrame(std::shared_ptr<PacketizerFrameData>
 // Get PlayList
 // - M3U8
 //====================================================================================================
-bool HlsStreamPacketizer::GetPlayList(ov::String &play_list)
+bool HlsStreamPacketizer::GetPlayList(std::shared_ptr<const ov::Data> &play_list)
 {
     return _packetizer->GetPlayList(play_list);
 }
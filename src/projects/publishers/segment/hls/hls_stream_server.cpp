@@ -39,7 +39,7 @@ HttpConnection HlsStreamServer::ProcessPlayListRequest(const std::shared_ptr<Htt
 {
 	auto response = client->GetResponse();
 
-	ov::String play_list;
+	std::shared_ptr<const ov::Data> play_list;
 	std::shared_ptr<info::Stream> stream_info;
 
 	auto item = std::find_if(_observers.begin(), _observers.end(),
@@ -59,7 +59,7 @@ HttpConnection HlsStreamServer::ProcessPlayListRequest(const std::shared_ptr<Htt
 		return HttpConnection::Closed;
 	}
 
-	if(response->GetStatusCode() != HttpStatusCode::OK || play_list.IsEmpty())
+	if(response->GetStatusCode() != HttpStatusCode::OK || (play_list == nullptr) || (play_list->GetLength() == 0))
 	{
 		logte("Could not find a %s playlist for [%s/%s], %s : %d", GetPublisherName(), app_name.CStr(), stream_name.CStr(), file_name.CStr(), response->GetStatusCode());
 		response->Response();
@@ -72,7 +72,7 @@ HttpConnection HlsStreamServer::ProcessPlayListRequest(const std::shared_ptr<Htt
 	response->SetHeader("Pragma", "no-cache");
 	response->SetHeader("Expires", "0");
 
-	response->AppendString(play_list);
+	response->AppendData(play_list);
 	auto sent_bytes = response->Response();
 
 	if (stream_info != nullptr)
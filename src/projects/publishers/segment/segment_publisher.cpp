@@ -47,7 +47,7 @@ bool SegmentPublisher::Start(std::map<int, std::shared_ptr<HttpServer>> &http_se
 
 	// Start the DASH Server
 	if (stream_server->Start(has_port ? &address : nullptr, has_tls_port ? &tls_address : nullptr,
-							 http_server_manager, DEFAULT_SEGMENT_WORKER_THREAD_COUNT) == false)
+							 http_server_manager, DEFAULT_SEGMENT_WORKER_THREAD_COUNT, port_config.GetWorkerCount(), port_config.IsKernelTlsEnabled()) == false)
 	{
 		logte("An error occurred while start %s Publisher", GetPublisherName());
 		return false;
@@ -73,7 +73,7 @@ bool SegmentPublisher::GetMonitoringCollectionData(std::vector<std::shared_ptr<p
 bool SegmentPublisher::OnPlayListRequest(const std::shared_ptr<HttpClient> &client,
 										 const ov::String &app_name, const ov::String &stream_name,
 										 const ov::String &file_name,
-										 ov::String &play_list)
+										 std::shared_ptr<const ov::Data> &play_list)
 {
 	auto request = client->GetRequest();
 	auto uri = request->GetUri();
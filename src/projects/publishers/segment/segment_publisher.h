@@ -206,7 +206,7 @@ protected:
 	bool OnPlayListRequest(const std::shared_ptr<HttpClient> &client,
 						   const ov::String &app_name, const ov::String &stream_name,
 						   const ov::String &file_name,
-						   ov::String &play_list) override;
+						   std::shared_ptr<const ov::Data> &play_list) override;
 
 	bool OnSegmentRequest(const std::shared_ptr<HttpClient> &client,
 						  const ov::String &app_name, const ov::String &stream_name,
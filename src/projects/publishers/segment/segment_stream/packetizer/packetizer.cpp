@@ -134,11 +134,16 @@ uint64_t Packetizer::ConvertTimeScale(uint64_t time, const common::Timebase &fro
 	return (uint64_t)((double)time * ratio);
 }
 
-void Packetizer::SetPlayList(ov::String &play_list)
+void Packetizer::SetPlayList(const ov::String &play_list)
 {
-	std::unique_lock<std::mutex> lock(_play_list_guard);
+	std::shared_ptr<const ov::Data> play_list_data = play_list.ToData(false);
 
-	_play_list = play_list;
+	std::atomic_store(&_play_list, play_list_data);
+}
+
+std::shared_ptr<const ov::Data> Packetizer::GetPlayListSnapshot() const
+{
+	return std::atomic_load(&_play_list);
 }
 
 bool Packetizer::IsReadyForStreaming() const noexcept
@@ -151,18 +156,61 @@ void Packetizer::SetReadyForStreaming() noexcept
 	_streaming_start = true;
 }
 
-bool Packetizer::GetPlayList(ov::String &play_list)
+bool Packetizer::GetPlayList(std::shared_ptr<const ov::Data> &play_list)
 {
 	if (IsReadyForStreaming() == false)
 	{
 		return false;
 	}
 
-	std::unique_lock<std::mutex> lock(_play_list_guard);
+	play_list = GetPlayListSnapshot();
+
+	return (play_list != nullptr);
+}
 
-	play_list = _play_list;
+void Packetizer::UpdateSegmentIndex()
+{
+	auto segment_index = std::make_shared<SegmentIndex>();
 
-	return true;
+	{
+		std::unique_lock<std::mutex> lock(_video_segment_guard);
+
+		for (const auto &segment_data : _video_segment_datas)
+		{
+			if (segment_data != nullptr)
+			{
+				(*segment_index)[segment_data->file_name] = segment_data;
+			}
+		}
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(_audio_segment_guard);
+
+		for (const auto &segment_data : _audio_segment_datas)
+		{
+			if (segment_data != nullptr)
+			{
+				(*segment_index)[segment_data->file_name] = segment_data;
+			}
+		}
+	}
+
+	std::atomic_store(&_segment_index, std::shared_ptr<const SegmentIndex>(segment_index));
+}
+
+std::shared_ptr<SegmentData> Packetizer::FindSegment(const ov::String &file_name) const
+{
+	auto segment_index = std::atomic_load(&_segment_index);
+
+	if (segment_index == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto item = segment_index->find(file_name);
+
+	return (item != segment_index->end()) ? item->second : nullptr;
 }
 
 bool Packetizer::GetVideoPlaySegments(std::vector<std::shared_ptr<SegmentData>> &segment_datas)
@@ -13,6 +13,8 @@
 #include <base/info/application.h>
 #include <base/ovlibrary/ovlibrary.h>
 
+#include <unordered_map>
+
 class Packetizer
 {
 public:
@@ -44,10 +46,12 @@ public:
 	//   +--------+---------+--------+-----------+
 	static uint64_t ConvertTimeScale(uint64_t time, const common::Timebase &from_timebase, const common::Timebase &to_timebase);
 
-	void SetPlayList(ov::String &play_list);
+	// The playlist is serialized once here, and the same snapshot is served to all requests until the next update
+	void SetPlayList(const ov::String &play_list);
 
 	virtual bool IsReadyForStreaming() const noexcept;
-	virtual bool GetPlayList(ov::String &play_list);
+	// Returns the current snapshot without locking or copying (The snapshot must not be modified)
+	virtual bool GetPlayList(std::shared_ptr<const ov::Data> &play_list);
 
 	bool GetVideoPlaySegments(std::vector<std::shared_ptr<SegmentData>> &segment_datas);
 	bool GetAudioPlaySegments(std::vector<std::shared_ptr<SegmentData>> &segment_datas);
@@ -60,8 +64,18 @@ public:
 	static int64_t GetCurrentTick();
 
 protected:
+	// [FILE_NAME, SEGMENT]
+	typedef std::unordered_map<ov::String, std::shared_ptr<SegmentData>> SegmentIndex;
+
 	virtual void SetReadyForStreaming() noexcept;
 
+	std::shared_ptr<const ov::Data> GetPlayListSnapshot() const;
+
+	// Rebuilds the index from _video_segment_datas/_audio_segment_datas, must be called after the segments are changed
+	void UpdateSegmentIndex();
+	// Finds a segment in O(1) without locking
+	std::shared_ptr<SegmentData> FindSegment(const ov::String &file_name) const;
+
 	ov::String _app_name;
 	ov::String _stream_name;
 	PacketizerType _packetizer_type;
@@ -78,7 +92,10 @@ protected:
 
 	uint32_t _sequence_number = 1U;
 	bool _streaming_start = false;
-	ov::String _play_list;
+
+	// These are replaced as a whole by the packetizer, and read with std::atomic_load() by the request handlers (copy-on-write)
+	std::shared_ptr<const ov::Data> _play_list;
+	std::shared_ptr<const SegmentIndex> _segment_index;
 
 	bool _video_init = false;
 	bool _audio_init = false;
@@ -89,7 +106,7 @@ protected:
 	std::vector<std::shared_ptr<SegmentData>> _video_segment_datas;  // m4s : video , ts : video+audio
 	std::vector<std::shared_ptr<SegmentData>> _audio_segment_datas;  // m4s : audio
 
+	// Only the packetizer uses these guards since the request handlers look up _segment_index
 	std::mutex _video_segment_guard;
 	std::mutex _audio_segment_guard;
-	std::mutex _play_list_guard;
 };
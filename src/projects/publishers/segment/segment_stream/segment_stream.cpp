@@ -138,7 +138,7 @@ void SegmentStream::SendAudioFrame(const std::shared_ptr<MediaPacket> &media_pac
 // GetPlayList
 // - M3U8/MPD
 //====================================================================================================
-bool SegmentStream::GetPlayList(ov::String &play_list)
+bool SegmentStream::GetPlayList(std::shared_ptr<const ov::Data> &play_list)
 {
 	if (_stream_packetizer != nullptr)
 	{
@@ -23,7 +23,7 @@ public:
 	virtual bool OnPlayListRequest(const std::shared_ptr<HttpClient> &client,
 								   const ov::String &app_name, const ov::String &stream_name,
 								   const ov::String &file_name,
-								   ov::String &play_list) = 0;
+								   std::shared_ptr<const ov::Data> &play_list) = 0;
 
 	// Called when the client requests a segment (such as .ts, .m4s)
 	virtual bool OnSegmentRequest(const std::shared_ptr<HttpClient> &client,
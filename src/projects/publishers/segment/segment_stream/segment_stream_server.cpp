@@ -62,7 +62,9 @@ static std::shared_ptr<Thttp_server> CreateHttpServerIfNeeded(std::map<int, std:
 bool SegmentStreamServer::Start(const ov::SocketAddress *address,
 								const ov::SocketAddress *tls_address,
 								std::map<int, std::shared_ptr<HttpServer>> &http_server_manager,
-								int thread_count)
+								int thread_count,
+								int worker_count,
+								bool use_kernel_tls)
 {
 	if ((_http_server != nullptr) || (_https_server != nullptr))
 	{
@@ -104,6 +106,12 @@ bool SegmentStreamServer::Start(const ov::SocketAddress *address,
 		{
 			auto vhost_list = Orchestrator::GetInstance()->GetVirtualHostList();
 			_https_server->SetVirtualHostList(vhost_list);
+
+			if (use_kernel_tls)
+			{
+				// The server can be shared with other publishers, so it is only turned on here
+				_https_server->SetKernelTlsEnabled(true);
+			}
 			_https_server->AddInterceptor(segment_stream_interceptor);
 		}
 		else
@@ -116,8 +124,8 @@ bool SegmentStreamServer::Start(const ov::SocketAddress *address,
 		// TLS is disabled
 	}
 
-	result = result && ((need_to_start_http_server == false) || (_http_server == nullptr) || _http_server->Start(*address));
-	result = result && ((need_to_start_https_server == false) || (_https_server == nullptr) || _https_server->Start(*tls_address));
+	result = result && ((need_to_start_http_server == false) || (_http_server == nullptr) || _http_server->Start(*address, worker_count));
+	result = result && ((need_to_start_https_server == false) || (_https_server == nullptr) || _https_server->Start(*tls_address, worker_count));
 
 	if (result)
 	{
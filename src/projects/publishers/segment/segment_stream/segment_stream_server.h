@@ -29,7 +29,9 @@ public:
 		const ov::SocketAddress *address,
 		const ov::SocketAddress *tls_address,
 		std::map<int, std::shared_ptr<HttpServer>> &http_server_manager,
-		int thread_count);
+		int thread_count,
+		int worker_count = 1,
+		bool use_kernel_tls = false);
 	bool Stop();
 	
 	bool AddObserver(const std::shared_ptr<SegmentStreamObserver> &observer);
@@ -154,7 +154,6 @@ bool SegmentWorkerManager::Stop()
 //====================================================================================================
 // Worker Add
 //====================================================================================================
-#define MAX_WORKER_INDEX 100000000
 bool SegmentWorkerManager::AddWork(const std::shared_ptr<HttpClient> &response,
 								   const ov::String &request_target,
 								   const ov::String &origin_url)
@@ -162,12 +161,12 @@ bool SegmentWorkerManager::AddWork(const std::shared_ptr<HttpClient> &response,
 	auto work_info = std::make_shared<SegmentWorkInfo>(response, request_target, origin_url);
 
 	// insert thread
-	_workers[(_worker_index % _worker_count)]->AddWorkInfo(work_info);
+	//
+	// The requests of a connection are always handled by the same worker, so the responses of the pipelined requests
+	// are sent in the order of the requests
+	auto worker_index = static_cast<size_t>(response->GetRequest()->GetRemote()->GetId());
 
-	if (_worker_index < MAX_WORKER_INDEX)
-		_worker_index++;
-	else
-		_worker_index = 0;
+	_workers[(worker_index % _worker_count)]->AddWorkInfo(work_info);
 
 	return true;
 }
@@ -77,7 +77,6 @@ public :
 
 private:
     int _worker_count = 0;
-    int _worker_index = 0;
 
     std::vector<std::shared_ptr<SegmentWorker>> _workers;
 };
\ No newline at end of file
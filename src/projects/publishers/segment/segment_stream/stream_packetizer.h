@@ -46,7 +46,7 @@ public:
 	// Child must implement this functions
 	virtual bool AppendVideoFrame(std::shared_ptr<PacketizerFrameData> &dEncodedFrameata) = 0;
 	virtual bool AppendAudioFrame(std::shared_ptr<PacketizerFrameData> &data) = 0;
-	virtual bool GetPlayList(ov::String &play_list) = 0;
+	virtual bool GetPlayList(std::shared_ptr<const ov::Data> &play_list) = 0;
 	virtual std::shared_ptr<SegmentData> GetSegmentData(const ov::String &file_name) = 0;
 
 protected:
@@ -107,6 +107,74 @@ bool RtcSession::Start()
     // RTP RTCP 생성
 	_rtp_rtcp = std::make_shared<RtpRtcp>((uint32_t)pub::SessionNodeType::Rtp, session, ssrc_list);
 
+	// Retransmission (NACK, RTX) for the video if the peer supports
+	for(size_t i = 0; i < peer_media_desc_list.size(); i++)
+	{
+		auto peer_media_desc = peer_media_desc_list[i];
+		auto offer_media_desc = offer_media_desc_list[i];
+
+		if(peer_media_desc->GetMediaType() != MediaDescription::MediaType::Video)
+		{
+			continue;
+		}
+
+		// a=rtcp-fb:100 nack
+		auto peer_payload = peer_media_desc->GetFirstPayload();
+		if(peer_payload->IsRtcpFbEnabled(PayloadAttr::RtcpFbType::Nack) == false)
+		{
+			continue;
+		}
+
+		// a=rtpmap:101 rtx/90000
+		// a=fmtp:101 apt=100
+		std::map<uint8_t, uint8_t> rtx_payload_types;
+		for(const auto &payload : offer_media_desc->GetPayloadList())
+		{
+			auto fmtp = payload->GetFmtp();
+
+			if((payload->GetCodecStr().UpperCaseString() != "RTX") || (fmtp.HasPrefix("apt=") == false))
+			{
+				continue;
+			}
+
+			// RTX is used only if the peer accepts it
+			if(peer_media_desc->GetPayload(payload->GetId()) == nullptr)
+			{
+				continue;
+			}
+
+			auto origin_payload_type = static_cast<uint8_t>(ov::Converter::ToInt32(fmtp.Substring(4)));
+			rtx_payload_types[origin_payload_type] = payload->GetId();
+		}
+
+		logtd("Retransmission is enabled: ssrc(%u) rtx ssrc(%u) rtx payload types(%zu)",
+			  offer_media_desc->GetSsrc(), offer_media_desc->GetRtxSsrc(), rtx_payload_types.size());
+
+		_rtp_rtcp->EnableRetransmission(offer_media_desc->GetSsrc(), offer_media_desc->GetRtxSsrc(), rtx_payload_types);
+	}
+
+	// Transport-wide congestion control if the peer supports
+	for(size_t i = 0; i < peer_media_desc_list.size(); i++)
+	{
+		auto peer_media_desc = peer_media_desc_list[i];
+		auto offer_media_desc = offer_media_desc_list[i];
+
+		// a=extmap:3 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01
+		// a=rtcp-fb:100 transport-cc
+		auto extension_id = peer_media_desc->GetExtmapId(TRANSPORT_CC_EXTENSION_URI);
+		auto peer_payload = peer_media_desc->GetFirstPayload();
+
+		if((extension_id == 0) || (peer_payload->IsRtcpFbEnabled(PayloadAttr::RtcpFbType::TransportCc) == false))
+		{
+			continue;
+		}
+
+		logtd("Transport-cc is enabled: ssrc(%u) extension id(%d)", offer_media_desc->GetSsrc(), extension_id);
+
+		_transport_cc_enabled = true;
+		_rtp_rtcp->EnableTransportCc(offer_media_desc->GetSsrc(), extension_id);
+	}
+
 	// SRTP 생성
 	_srtp_transport = std::make_shared<SrtpTransport>((uint32_t)pub::SessionNodeType::Srtp, session);
 
@@ -194,7 +262,7 @@ void RtcSession::OnPacketReceived(const std::shared_ptr<info::Session> &session_
 	_dtls_ice_transport->OnDataReceived(pub::SessionNodeType::None, data);
 }
 
-bool RtcSession::SendOutgoingData(uint32_t packet_type, const std::shared_ptr<ov::Data> &packet)
+bool RtcSession::SendOutgoingData(uint32_t packet_type, const std::shared_ptr<const ov::Data> &packet)
 {
 	auto rtp_payload_type = static_cast<uint8_t>(packet_type & 0xFF);
 	auto red_block_pt = static_cast<uint8_t>((packet_type & 0xFF00) >> 8);
@@ -217,4 +285,14 @@ bool RtcSession::SendOutgoingData(uint32_t packet_type, const std::shared_ptr<ov
 	_sent_bytes += packet->GetLength();
 
 	return _rtp_rtcp->SendOutgoingData(packet);
+}
+
+uint32_t RtcSession::GetEstimatedBitrate()
+{
+	if((_rtp_rtcp == nullptr) || (_transport_cc_enabled == false))
+	{
+		return 0;
+	}
+
+	return _rtp_rtcp->GetEstimatedBitrate();
 }
\ No newline at end of file
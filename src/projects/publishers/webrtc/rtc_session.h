@@ -67,7 +67,11 @@ public:
 	const std::shared_ptr<SessionDescription>& GetOfferSDP();
 	const std::shared_ptr<WebSocketClient>& GetWSClient();
 
-	bool SendOutgoingData(uint32_t packet_type, const std::shared_ptr<ov::Data> &packet) override;
+	bool SendOutgoingData(uint32_t packet_type, const std::shared_ptr<const ov::Data> &packet) override;
+
+	// Estimated bandwidth to the player (bps), 0 if it is not available (the player doesn't support transport-cc)
+	// It can be used to select a rendition that fits the bandwidth
+	uint32_t GetEstimatedBitrate();
 	void OnPacketReceived(const std::shared_ptr<info::Session> &session_info, const std::shared_ptr<const ov::Data> &data) override;
 
 private:
@@ -84,4 +88,5 @@ private:
 	uint8_t 							_red_block_pt = 0;
 	uint8_t                             _video_payload_type = 0;
 	uint8_t                             _audio_payload_type = 0;
+	bool                                _transport_cc_enabled = false;
 };
\ No newline at end of file
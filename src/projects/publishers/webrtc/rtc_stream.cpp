@@ -24,6 +24,13 @@ RtcStream::RtcStream(const std::shared_ptr<pub::Application> application,
 {
 	_certificate = application->GetSharedPtrAs<RtcApplication>()->GetCertificate();
 	_vp8_picture_id = 0x8000; // 1 {000 0000 0000 0000} 1 is marker for 15 bit length
+
+	auto publisher_info = application->GetPublisher<cfg::WebrtcPublisher>();
+
+	if((publisher_info != nullptr) && (publisher_info->GetFecMask().UpperCaseString() == "INTERLEAVED"))
+	{
+		_fec_mask_type = UlpfecMaskType::Interleaved;
+	}
 }
 
 RtcStream::~RtcStream()
@@ -139,15 +146,33 @@ bool RtcStream::Start(uint32_t worker_count)
 					video_media_desc->SetDirection(MediaDescription::Direction::SendOnly);
 					video_media_desc->SetMediaType(MediaDescription::MediaType::Video);
 					video_media_desc->SetCname(ov::Random::GenerateUInt32(), ov::Random::GenerateString(16));
+					// The lost packets are retransmitted with this SSRC
+					video_media_desc->SetRtxSsrc(ov::Random::GenerateUInt32());
+					video_media_desc->AddExtmap(TRANSPORT_CC_EXTENSION_ID, TRANSPORT_CC_EXTENSION_URI);
 					_offer_sdp->AddMedia(video_media_desc);
 					first_video_desc = false;
 				}
 
 				//TODO(getroot): WEBRTC에서는 TIMEBASE를 무조건 90000을 쓰는 것으로 보임, 정확히 알아볼것
 				payload->SetRtpmap(payload_type_num++, codec, 90000);
+				payload->EnableRtcpFb(PayloadAttr::RtcpFbType::Nack, true);
+				// Key frame requests are delivered to the encoder (See pub::Stream::RequestKeyFrame())
+				payload->EnableRtcpFb(PayloadAttr::RtcpFbType::NackPli, true);
+				payload->EnableRtcpFb(PayloadAttr::RtcpFbType::CcmFir, true);
+				// The bandwidth is estimated using the transport-wide feedback (See RtpRtcp::EnableTransportCc())
+				payload->EnableRtcpFb(PayloadAttr::RtcpFbType::TransportCc, true);
 
 				video_media_desc->AddPayload(payload);
 
+				// RTX (RFC 4588) for the payload
+				{
+					auto rtx_payload = std::make_shared<PayloadAttr>();
+					rtx_payload->SetRtpmap(payload_type_num++, "rtx", 90000);
+					rtx_payload->SetFmtp(ov::String::FormatString("apt=%d", payload->GetId()));
+
+					video_media_desc->AddPayload(rtx_payload);
+				}
+
 				// RTP Packetizer를 추가한다.
 				AddPacketizer(track->GetCodecId(), track->GetId(), payload->GetId(), video_media_desc->GetSsrc());
 
@@ -194,12 +219,14 @@ bool RtcStream::Start(uint32_t worker_count)
 					audio_media_desc->SetDirection(MediaDescription::Direction::SendOnly);
 					audio_media_desc->SetMediaType(MediaDescription::MediaType::Audio);
 					audio_media_desc->SetCname(ov::Random::GenerateUInt32(), ov::Random::GenerateString(16));
+					audio_media_desc->AddExtmap(TRANSPORT_CC_EXTENSION_ID, TRANSPORT_CC_EXTENSION_URI);
 					_offer_sdp->AddMedia(audio_media_desc);
 					first_audio_desc = false;
 				}
 
 				payload->SetRtpmap(payload_type_num++, codec, static_cast<uint32_t>(track->GetSample().GetRateNum()),
 								   std::to_string(track->GetChannel().GetCounts()).c_str());
+				payload->EnableRtcpFb(PayloadAttr::RtcpFbType::TransportCc, true);
 
 				audio_media_desc->AddPayload(payload);
 
@@ -224,8 +251,14 @@ bool RtcStream::Start(uint32_t worker_count)
         auto ulpfec_payload = std::make_shared<PayloadAttr>();
         ulpfec_payload->SetRtpmap(ULPFEC_PAYLOAD_TYPE, "ulpfec", 90000);
 
+        // RTX for RED
+        auto red_rtx_payload = std::make_shared<PayloadAttr>();
+        red_rtx_payload->SetRtpmap(RED_RTX_PAYLOAD_TYPE, "rtx", 90000);
+        red_rtx_payload->SetFmtp(ov::String::FormatString("apt=%d", RED_PAYLOAD_TYPE));
+
         video_media_desc->AddPayload(red_payload);
         video_media_desc->AddPayload(ulpfec_payload);
+        video_media_desc->AddPayload(red_rtx_payload);
     }
 
 	logtd("Stream is created : %s/%u", GetName().CStr(), GetId());
@@ -414,11 +447,11 @@ void RtcStream::AddPacketizer(common::MediaCodecId codec_id, uint32_t id, uint8_
 	{
 		case MediaCodecId::Vp8:
 			packetizer->SetVideoCodec(RtpVideoCodecType::Vp8);
-			packetizer->SetUlpfec(RED_PAYLOAD_TYPE, ULPFEC_PAYLOAD_TYPE);
+			packetizer->SetUlpfec(RED_PAYLOAD_TYPE, ULPFEC_PAYLOAD_TYPE, _fec_mask_type);
 			break;
 		case MediaCodecId::H264:
 			packetizer->SetVideoCodec(RtpVideoCodecType::H264);
-			packetizer->SetUlpfec(RED_PAYLOAD_TYPE, ULPFEC_PAYLOAD_TYPE);
+			packetizer->SetUlpfec(RED_PAYLOAD_TYPE, ULPFEC_PAYLOAD_TYPE, _fec_mask_type);
 			break;
 		case MediaCodecId::Opus:
 			packetizer->SetAudioCodec(RtpAudioCodecType::Opus);
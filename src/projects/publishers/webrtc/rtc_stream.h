@@ -11,10 +11,16 @@
 #include "rtc_session.h"
 
 #define PAYLOAD_TYPE_OFFSET		100
+// RTX (RFC 4588) for RED
+#define RED_RTX_PAYLOAD_TYPE	122
 #define RED_PAYLOAD_TYPE		123
 #define	ULPFEC_PAYLOAD_TYPE		124
 #define RTCP_PACKET_TYPE		125 // For internal use
 
+// Transport-wide sequence number (a=extmap) for the congestion control
+#define TRANSPORT_CC_EXTENSION_ID	3
+#define TRANSPORT_CC_EXTENSION_URI	"http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01"
+
 class RtcStream : public pub::Stream, public RtpRtcpPacketizerInterface
 {
 public:
@@ -50,6 +56,7 @@ private:
 	uint16_t _vp8_picture_id;
 	std::shared_ptr<SessionDescription> _offer_sdp;
 	std::shared_ptr<Certificate> _certificate;
+	UlpfecMaskType _fec_mask_type = UlpfecMaskType::Consecutive;
 
 	// Packetizing을 위해 RtpSender를 이용한다.
 	std::map<uint32_t, std::shared_ptr<RtpPacketizer>> _packetizers;
@@ -63,7 +63,7 @@ bool WebRtcPublisher::Start()
 	// Initialize RtcSignallingServer
 	_signalling_server = std::make_shared<RtcSignallingServer>(server_config);
 	_signalling_server->AddObserver(RtcSignallingObserver::GetSharedPtr());
-	if (_signalling_server->Start(has_port ? &signalling_address : nullptr, has_tls_port ? &signalling_tls_address : nullptr) == false)
+	if (_signalling_server->Start(has_port ? &signalling_address : nullptr, has_tls_port ? &signalling_tls_address : nullptr, webrtc_port_info.GetSignalling().GetWorkerCount()) == false)
 	{
 		return false;
 	}
@@ -0,0 +1,7 @@
+LOCAL_PATH := $(call get_local_path)
+
+# Each sub directory is a standalone test (or benchmark) program, which returns non-zero on failure.
+# They are built only by "make tests", so the normal build does not depend on them.
+ifneq ($(filter tests,$(MAKECMDGOALS)),)
+include $(BUILD_SUB_AMS)
+endif
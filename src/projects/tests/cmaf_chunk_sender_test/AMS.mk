@@ -0,0 +1,21 @@
+LOCAL_PATH := $(call get_local_path)
+include $(DEFAULT_VARIABLES)
+
+LOCAL_STATIC_LIBRARIES := \
+	segment_publishers \
+	http_server \
+	physical_port \
+	ovcrypto \
+	socket \
+	ovlibrary
+
+LOCAL_LDFLAGS := -lpthread
+
+$(call add_pkg_config,srt)
+$(call add_pkg_config,openssl)
+
+LOCAL_TARGET := cmaf_chunk_sender_test
+
+include $(BUILD_EXECUTABLE)
+
+TEST_TARGET_LIST += $(BUILD_TARGET_WITH_PATH)
@@ -0,0 +1,526 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <arpa/inet.h>
+#include <http_server/http_server.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <publishers/segment/cmaf/cmaf_chunk_sender.h>
+#include <sys/socket.h>
+#include <tests/test_common.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <thread>
+
+// The players of the test: each request is answered with the chunked response header, as CmafStreamServer does
+// for a segment that is being created, and its client is handed over to the test
+class TestInterceptor : public HttpRequestInterceptor
+{
+public:
+	bool IsInterceptorForRequest(const std::shared_ptr<const HttpClient> &client) override
+	{
+		return true;
+	}
+
+	HttpInterceptorResult OnHttpPrepare(const std::shared_ptr<HttpClient> &client) override
+	{
+		auto response = client->GetResponse();
+
+		// Smaller than the default, so a client that does not read is congested after a few chunks
+		response->GetRemote()->SetSendQueueLimit(64 * 1024, 256 * 1024, 32 * 1024 * 1024, ov::SendQueuePolicy::Disconnect);
+
+		response->SetHeader("Content-Type", "video/mp4");
+		response->SetKeepAlive();
+		response->SetChunkedTransfer();
+		response->Response();
+
+		{
+			std::lock_guard<std::mutex> lock_guard(_mutex);
+			_client_list.push_back(client);
+		}
+
+		_condition.notify_all();
+
+		return HttpInterceptorResult::Keep;
+	}
+
+	HttpInterceptorResult OnHttpData(const std::shared_ptr<HttpClient> &client, const std::shared_ptr<const ov::Data> &data) override
+	{
+		return HttpInterceptorResult::Keep;
+	}
+
+	void OnHttpError(const std::shared_ptr<HttpClient> &client, HttpStatusCode status_code) override
+	{
+	}
+
+	void OnHttpClosed(const std::shared_ptr<HttpClient> &client) override
+	{
+	}
+
+	// Waits for the requests of count clients, in the order of the requests
+	std::vector<std::shared_ptr<HttpClient>> WaitForClients(size_t count)
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		OV_TEST_ASSERT(_condition.wait_for(lock, std::chrono::seconds(5), [&]() { return _client_list.size() >= count; }));
+
+		std::vector<std::shared_ptr<HttpClient>> client_list(_client_list.begin(), _client_list.begin() + count);
+		_client_list.erase(_client_list.begin(), _client_list.begin() + count);
+
+		return client_list;
+	}
+
+private:
+	std::mutex _mutex;
+	std::condition_variable _condition;
+	std::vector<std::shared_ptr<HttpClient>> _client_list;
+};
+
+static std::shared_ptr<HttpServer> http_server;
+static std::shared_ptr<TestInterceptor> interceptor;
+static uint16_t http_port;
+
+// A port that nobody listens to
+static uint16_t GetFreePort()
+{
+	int socket = ::socket(AF_INET, SOCK_STREAM, 0);
+	sockaddr_in address{};
+	socklen_t address_length = sizeof(address);
+
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	OV_TEST_ASSERT(::bind(socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0);
+	OV_TEST_ASSERT(::getsockname(socket, reinterpret_cast<sockaddr *>(&address), &address_length) == 0);
+	::close(socket);
+
+	return ntohs(address.sin_port);
+}
+
+// A player that requests the segment, and reads the response into _received
+class TestPlayer
+{
+public:
+	// receive_buffer_size: a small buffer makes the player slow (when it doesn't read)
+	explicit TestPlayer(int receive_buffer_size = 0)
+	{
+		_socket = ::socket(AF_INET, SOCK_STREAM, 0);
+
+		if (receive_buffer_size > 0)
+		{
+			::setsockopt(_socket, SOL_SOCKET, SO_RCVBUF, &receive_buffer_size, sizeof(receive_buffer_size));
+		}
+
+		timeval timeout{10, 0};
+		::setsockopt(_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+		sockaddr_in address{};
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		address.sin_port = htons(http_port);
+
+		OV_TEST_ASSERT(::connect(_socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0);
+
+		ov::String request = "GET /app/stream/chunk_video_1.m4s HTTP/1.1\r\nHost: localhost\r\n\r\n";
+		OV_TEST_ASSERT(::send(_socket, request.CStr(), request.GetLength(), 0) == static_cast<ssize_t>(request.GetLength()));
+	}
+
+	~TestPlayer()
+	{
+		::close(_socket);
+	}
+
+	// Reads until the server closes the connection
+	void ReadAll()
+	{
+		char buffer[65536];
+		ssize_t length;
+
+		while ((length = ::recv(_socket, buffer, sizeof(buffer), 0)) > 0)
+		{
+			_received.Append(buffer, length);
+		}
+	}
+
+	// Reads what has arrived so far
+	bool ReadAvailable()
+	{
+		char buffer[65536];
+		ssize_t length;
+		bool is_closed = false;
+
+		while (true)
+		{
+			length = ::recv(_socket, buffer, sizeof(buffer), MSG_DONTWAIT);
+
+			if (length <= 0)
+			{
+				is_closed = (length == 0);
+				break;
+			}
+
+			_received.Append(buffer, length);
+		}
+
+		return is_closed;
+	}
+
+	int GetSocket() const
+	{
+		return _socket;
+	}
+
+	// Decodes the chunked body: the payloads of the chunks, and whether the last (empty) chunk has arrived
+	std::vector<ov::Data> GetChunks(bool *is_completed) const
+	{
+		std::vector<ov::Data> chunk_list;
+		auto text = static_cast<const char *>(_received.GetData());
+		size_t length = _received.GetLength();
+
+		auto header_end = ::memmem(text, length, "\r\n\r\n", 4);
+		OV_TEST_ASSERT(header_end != nullptr);
+		OV_TEST_ASSERT(::strncmp(text, "HTTP/1.1 200", 12) == 0);
+
+		size_t offset = static_cast<const char *>(header_end) - text + 4;
+		*is_completed = false;
+
+		while (offset < length)
+		{
+			auto line_end = static_cast<const char *>(::memmem(text + offset, length - offset, "\r\n", 2));
+			OV_TEST_ASSERT(line_end != nullptr);
+
+			size_t chunk_size = ::strtoul(text + offset, nullptr, 16);
+			offset = (line_end - text) + 2;
+
+			OV_TEST_ASSERT(offset + chunk_size + 2 <= length);
+			OV_TEST_ASSERT(::memcmp(text + offset + chunk_size, "\r\n", 2) == 0);
+
+			if (chunk_size == 0)
+			{
+				*is_completed = true;
+				OV_TEST_ASSERT(offset + 2 == length);
+				break;
+			}
+
+			chunk_list.emplace_back(text + offset, chunk_size);
+			offset += chunk_size + 2;
+		}
+
+		return chunk_list;
+	}
+
+private:
+	int _socket = -1;
+	ov::Data _received;
+};
+
+// A chunk starts with its index, and whether it starts with a key frame
+static std::shared_ptr<const CmafHttpChunk> MakeChunk(uint32_t index, bool is_independent, size_t length)
+{
+	auto data = std::make_shared<ov::Data>(length);
+	data->SetLength(length);
+
+	auto bytes = data->GetWritableDataAs<uint8_t>();
+	::memset(bytes, static_cast<int>(index), length);
+	::memcpy(bytes, &index, sizeof(index));
+	bytes[sizeof(index)] = is_independent ? 1 : 0;
+
+	return std::make_shared<const CmafHttpChunk>(HttpResponse::MakeChunk(data), is_independent);
+}
+
+static uint32_t GetIndex(const ov::Data &chunk)
+{
+	uint32_t index;
+	::memcpy(&index, chunk.GetData(), sizeof(index));
+
+	return index;
+}
+
+static bool IsIndependent(const ov::Data &chunk)
+{
+	return chunk.GetDataAs<uint8_t>()[sizeof(uint32_t)] == 1;
+}
+
+// Every player receives all the chunks in order, and the response is finished after them
+static void TestChunksInOrder()
+{
+	constexpr uint32_t CHUNK_COUNT = 100;
+
+	CmafChunkSender sender;
+	OV_TEST_ASSERT(sender.Start(2));
+
+	std::vector<std::unique_ptr<TestPlayer>> players;
+	std::vector<std::shared_ptr<CmafChunkedClient>> chunked_clients;
+
+	for (int index = 0; index < 5; index++)
+	{
+		players.push_back(std::make_unique<TestPlayer>());
+
+		for (auto &client : interceptor->WaitForClients(1))
+		{
+			chunked_clients.push_back(std::make_shared<CmafChunkedClient>(client, CmafLaggingClientPolicy::SkipToLive, 1000));
+		}
+	}
+
+	for (uint32_t index = 0; index < CHUNK_COUNT; index++)
+	{
+		auto chunk = MakeChunk(index, (index % 10) == 0, 1000 + index);
+
+		for (auto &client : chunked_clients)
+		{
+			sender.Push(client, chunk);
+		}
+	}
+
+	for (auto &client : chunked_clients)
+	{
+		sender.Complete(client);
+	}
+
+	for (auto &player : players)
+	{
+		player->ReadAll();
+
+		bool is_completed = false;
+		auto chunk_list = player->GetChunks(&is_completed);
+
+		OV_TEST_ASSERT(is_completed);
+		OV_TEST_ASSERT(chunk_list.size() == CHUNK_COUNT);
+
+		for (uint32_t index = 0; index < chunk_list.size(); index++)
+		{
+			OV_TEST_ASSERT(GetIndex(chunk_list[index]) == index);
+			OV_TEST_ASSERT(chunk_list[index].GetLength() == 1000 + index);
+		}
+	}
+
+	sender.Stop();
+}
+
+// A player that does not read is skipped to the live edge, while the others receive all the chunks
+static void TestLaggingClient(CmafLaggingClientPolicy policy)
+{
+	constexpr uint32_t CHUNK_COUNT = 300;
+	constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+	CmafChunkSender sender;
+	OV_TEST_ASSERT(sender.Start(2));
+
+	TestPlayer fast_player;
+	auto fast_client = std::make_shared<CmafChunkedClient>(interceptor->WaitForClients(1)[0], policy, 8);
+
+	TestPlayer slow_player(16 * 1024);
+	auto slow_client = std::make_shared<CmafChunkedClient>(interceptor->WaitForClients(1)[0], policy, 8);
+
+	std::thread fast_reader([&]() {
+		fast_player.ReadAll();
+	});
+
+	for (uint32_t index = 0; index < CHUNK_COUNT; index++)
+	{
+		auto chunk = MakeChunk(index, (index % 10) == 0, CHUNK_SIZE);
+
+		sender.Push(fast_client, chunk);
+		sender.Push(slow_client, chunk);
+
+		// A chunk per 2ms: faster than the slow player, which doesn't read at all
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+
+	sender.Complete(fast_client);
+	sender.Complete(slow_client);
+
+	fast_reader.join();
+
+	// The slow player starts reading now
+	slow_player.ReadAll();
+
+	bool is_completed = false;
+	auto chunk_list = fast_player.GetChunks(&is_completed);
+
+	OV_TEST_ASSERT(is_completed);
+	OV_TEST_ASSERT(chunk_list.size() == CHUNK_COUNT);
+
+	chunk_list = slow_player.GetChunks(&is_completed);
+
+	switch (policy)
+	{
+		case CmafLaggingClientPolicy::SkipToLive: {
+			OV_TEST_ASSERT(is_completed);
+			OV_TEST_ASSERT(chunk_list.size() < CHUNK_COUNT);
+
+			// A gap is always followed by a chunk that starts with a key frame
+			for (size_t index = 1; index < chunk_list.size(); index++)
+			{
+				auto previous_index = GetIndex(chunk_list[index - 1]);
+				auto current_index = GetIndex(chunk_list[index]);
+
+				OV_TEST_ASSERT(current_index > previous_index);
+				OV_TEST_ASSERT((current_index == previous_index + 1) || IsIndependent(chunk_list[index]));
+			}
+
+			::printf("  SkipToLive: the slow player received %zu/%u chunks\n", chunk_list.size(), CHUNK_COUNT);
+			break;
+		}
+
+		case CmafLaggingClientPolicy::Disconnect:
+			// Disconnected without the last chunk, after a part of the chunks
+			OV_TEST_ASSERT(is_completed == false);
+			OV_TEST_ASSERT(chunk_list.size() < CHUNK_COUNT);
+
+			for (size_t index = 0; index < chunk_list.size(); index++)
+			{
+				OV_TEST_ASSERT(GetIndex(chunk_list[index]) == index);
+			}
+
+			::printf("  Disconnect: the slow player received %zu/%u chunks before it was disconnected\n", chunk_list.size(), CHUNK_COUNT);
+			break;
+	}
+
+	sender.Stop();
+}
+
+static void TestSkipToLive()
+{
+	TestLaggingClient(CmafLaggingClientPolicy::SkipToLive);
+}
+
+static void TestDisconnect()
+{
+	TestLaggingClient(CmafLaggingClientPolicy::Disconnect);
+}
+
+// Time of the packetizer thread per chunk, to deliver it to the players:
+// SendChunkedData() for every player (as OnCmafChunkDataPush() did) vs Push() to the sender
+static void BenchPush()
+{
+	constexpr int PLAYER_COUNT = 100;
+	constexpr uint32_t CHUNK_COUNT = 500;
+	constexpr size_t CHUNK_SIZE = 16 * 1024;
+
+	auto measure = [&](const char *name, bool use_sender, bool with_slow_player) {
+		CmafChunkSender sender;
+		OV_TEST_ASSERT(sender.Start(2));
+
+		std::vector<std::unique_ptr<TestPlayer>> players;
+		std::vector<std::shared_ptr<CmafChunkedClient>> chunked_clients;
+
+		for (int index = 0; index < PLAYER_COUNT; index++)
+		{
+			// The last player does not read
+			bool is_slow = with_slow_player && (index == (PLAYER_COUNT - 1));
+
+			players.push_back(std::make_unique<TestPlayer>(is_slow ? 16 * 1024 : 0));
+			chunked_clients.push_back(std::make_shared<CmafChunkedClient>(interceptor->WaitForClients(1)[0], CmafLaggingClientPolicy::SkipToLive, 8));
+		}
+
+		std::atomic<bool> stop{false};
+
+		// The players read everything as it arrives
+		std::thread reader([&]() {
+			std::vector<pollfd> poll_fd_list;
+
+			for (int index = 0; index < (with_slow_player ? PLAYER_COUNT - 1 : PLAYER_COUNT); index++)
+			{
+				poll_fd_list.push_back({players[index]->GetSocket(), POLLIN, 0});
+			}
+
+			while (stop.load() == false)
+			{
+				if (::poll(poll_fd_list.data(), poll_fd_list.size(), 10) > 0)
+				{
+					for (size_t index = 0; index < poll_fd_list.size(); index++)
+					{
+						if (poll_fd_list[index].revents != 0)
+						{
+							players[index]->ReadAvailable();
+						}
+					}
+				}
+			}
+		});
+
+		double elapsed = 0.0;
+
+		for (uint32_t index = 0; index < CHUNK_COUNT; index++)
+		{
+			auto data = std::make_shared<ov::Data>(CHUNK_SIZE);
+			data->SetLength(CHUNK_SIZE);
+
+			elapsed += ov::test::MeasureMilliseconds([&]() {
+				if (use_sender)
+				{
+					auto chunk = std::make_shared<const CmafHttpChunk>(HttpResponse::MakeChunk(data), (index % 10) == 0);
+
+					for (auto &client : chunked_clients)
+					{
+						sender.Push(client, chunk);
+					}
+				}
+				else
+				{
+					for (auto &client : chunked_clients)
+					{
+						client->GetHttpClient()->GetResponse()->SendChunkedData(data);
+					}
+				}
+			});
+
+			// 300 chunks per second (10 renditions of 30 fps, a chunk per frame)
+			std::this_thread::sleep_for(std::chrono::microseconds(1000000 / 30 / 10));
+		}
+
+		for (auto &client : chunked_clients)
+		{
+			if (use_sender)
+			{
+				sender.Complete(client);
+			}
+			else
+			{
+				client->GetHttpClient()->GetResponse()->SendChunkedData(nullptr);
+				client->GetHttpClient()->GetResponse()->Close();
+			}
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		stop = true;
+		reader.join();
+
+		sender.Stop();
+
+		::printf("  %-40s %.3f ms/chunk for %d players\n", name, elapsed / CHUNK_COUNT, PLAYER_COUNT);
+	};
+
+	measure("SendChunkedData() per player:", false, false);
+	measure("CmafChunkSender::Push():", true, false);
+	measure("SendChunkedData(), 1 player not reading:", false, true);
+	measure("Push(), 1 player not reading:", true, true);
+}
+
+int main()
+{
+	// HttpServer logs every request, and the players that are disconnected on purpose are logged as warnings
+	ov_log_set_level(OVLogLevelError);
+
+	http_port = GetFreePort();
+	http_server = std::make_shared<HttpServer>();
+	interceptor = std::make_shared<TestInterceptor>();
+
+	OV_TEST_ASSERT(http_server->AddInterceptor(interceptor));
+	OV_TEST_ASSERT(http_server->Start(ov::SocketAddress("127.0.0.1", http_port), 2));
+
+	OV_TEST_RUN(TestChunksInOrder);
+	OV_TEST_RUN(TestSkipToLive);
+	OV_TEST_RUN(TestDisconnect);
+	OV_TEST_RUN(BenchPush);
+
+	http_server->Stop();
+
+	return 0;
+}
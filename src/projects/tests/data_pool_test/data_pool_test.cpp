@@ -0,0 +1,276 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <base/ovlibrary/ovlibrary.h>
+#include <tests/test_common.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Sizes of the packets/frames that are allocated most frequently
+static const size_t TYPICAL_SIZES[] = {188, 1316, 1500, 4096, 16384, 65536};
+
+static void TestAllocationSize()
+{
+	// Power-of-two classes from 256B to 64KB
+	OV_TEST_ASSERT(ov::DataPool::GetAllocationSize(1) == 256);
+	OV_TEST_ASSERT(ov::DataPool::GetAllocationSize(256) == 256);
+	OV_TEST_ASSERT(ov::DataPool::GetAllocationSize(257) == 512);
+	OV_TEST_ASSERT(ov::DataPool::GetAllocationSize(1500) == 2048);
+	OV_TEST_ASSERT(ov::DataPool::GetAllocationSize(32768) == 32768);
+	OV_TEST_ASSERT(ov::DataPool::GetAllocationSize(32769) == 65536);
+	OV_TEST_ASSERT(ov::DataPool::GetAllocationSize(65536) == 65536);
+
+	// Bigger blocks are not pooled, so they are allocated as is
+	OV_TEST_ASSERT(ov::DataPool::GetAllocationSize(65537) == 65537);
+	OV_TEST_ASSERT(ov::DataPool::GetAllocationSize(1024 * 1024) == 1024 * 1024);
+
+	// A block never wastes more than half of its size
+	for (size_t size = 1; size <= 65536; size++)
+	{
+		auto allocation_size = ov::DataPool::GetAllocationSize(size);
+
+		OV_TEST_ASSERT(allocation_size >= size);
+		OV_TEST_ASSERT((size <= 256) || (allocation_size < size * 2));
+	}
+}
+
+static void TestReuse()
+{
+	auto block = ov::DataPool::Allocate(1000);
+	ov::DataPool::Free(block, 1000);
+
+	auto stats = ov::DataPool::GetStats();
+
+	// The block of the same class is reused from the cache of the thread
+	auto reused_block = ov::DataPool::Allocate(1024);
+	OV_TEST_ASSERT(reused_block == block);
+	OV_TEST_ASSERT(ov::DataPool::GetStats().hit_count == stats.hit_count + 1);
+
+	ov::DataPool::Free(reused_block, 1024);
+}
+
+static void TestBytesInUse()
+{
+	auto in_use = ov::DataPool::GetStats().bytes_in_use;
+
+	std::vector<std::pair<void *, size_t>> block_list;
+
+	for (auto size : {100, 300, 5000, 70000})
+	{
+		block_list.emplace_back(ov::DataPool::Allocate(size), size);
+	}
+
+	OV_TEST_ASSERT(ov::DataPool::GetStats().bytes_in_use == in_use + 256 + 512 + 8192 + 70000);
+
+	for (auto &block : block_list)
+	{
+		ov::DataPool::Free(block.first, block.second);
+	}
+
+	OV_TEST_ASSERT(ov::DataPool::GetStats().bytes_in_use == in_use);
+}
+
+static void TestDataCapacity()
+{
+	// The capacity is exactly what is requested, although the block is rounded up to the class
+	ov::Data data(1000);
+	OV_TEST_ASSERT(data.GetCapacity() == 1000);
+
+	data.Reserve(3000);
+	OV_TEST_ASSERT(data.GetCapacity() == 3000);
+
+	uint8_t buffer[1500] = {};
+	OV_TEST_ASSERT(data.Append(buffer, sizeof(buffer)));
+	OV_TEST_ASSERT(data.GetLength() == sizeof(buffer));
+}
+
+static void TestCrossThreadFree()
+{
+	auto in_use = ov::DataPool::GetStats().bytes_in_use;
+
+	// The blocks allocated by a thread are freed by another thread, like the packets passed between the threads
+	std::vector<void *> block_list;
+
+	std::thread producer([&block_list]() {
+		for (int index = 0; index < 10000; index++)
+		{
+			block_list.push_back(ov::DataPool::Allocate(1316));
+		}
+	});
+	producer.join();
+
+	std::thread consumer([&block_list]() {
+		for (auto block : block_list)
+		{
+			ov::DataPool::Free(block, 1316);
+		}
+	});
+	consumer.join();
+
+	OV_TEST_ASSERT(ov::DataPool::GetStats().bytes_in_use == in_use);
+
+	// The blocks cached by the exited threads are reused through the shared list
+	auto stats = ov::DataPool::GetStats();
+
+	std::thread reuser([]() {
+		for (int index = 0; index < 100; index++)
+		{
+			ov::DataPool::Free(ov::DataPool::Allocate(1316), 1316);
+		}
+	});
+	reuser.join();
+
+	OV_TEST_ASSERT(ov::DataPool::GetStats().miss_count == stats.miss_count);
+}
+
+static void TestStatsOfLiveThreads()
+{
+	// The counters are kept by each thread, and GetStats() adds up the counters of the live threads
+	auto stats = ov::DataPool::GetStats();
+
+	std::mutex mutex;
+	std::condition_variable event;
+	bool is_allocated = false;
+	bool is_checked = false;
+	void *block = nullptr;
+
+	std::thread worker([&]() {
+		ov::DataPool::Free(ov::DataPool::Allocate(2000), 2000);
+		block = ov::DataPool::Allocate(2000);
+
+		std::unique_lock<std::mutex> lock(mutex);
+		is_allocated = true;
+		event.notify_all();
+		event.wait(lock, [&]() { return is_checked; });
+	});
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		event.wait(lock, [&]() { return is_allocated; });
+	}
+
+	auto live_stats = ov::DataPool::GetStats();
+
+	OV_TEST_ASSERT(live_stats.hit_count + live_stats.miss_count == stats.hit_count + stats.miss_count + 2);
+	OV_TEST_ASSERT(live_stats.bytes_in_use == stats.bytes_in_use + 2048);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		is_checked = true;
+		event.notify_all();
+	}
+
+	worker.join();
+
+	// The counters of the exited thread are kept, and the block is freed by another thread
+	ov::DataPool::Free(block, 2000);
+
+	auto exited_stats = ov::DataPool::GetStats();
+
+	OV_TEST_ASSERT(exited_stats.hit_count + exited_stats.miss_count == stats.hit_count + stats.miss_count + 2);
+	OV_TEST_ASSERT(exited_stats.bytes_in_use == stats.bytes_in_use);
+}
+
+static void BenchAllocation()
+{
+	constexpr int COUNT = 1000000;
+
+	for (auto size : TYPICAL_SIZES)
+	{
+		auto malloc_time = ov::test::MeasureMilliseconds([size]() {
+			for (int index = 0; index < COUNT; index++)
+			{
+				auto block = ::malloc(size);
+				// Prevents the pair from being optimized out
+				static_cast<volatile uint8_t *>(block)[0] = 0;
+				::free(block);
+			}
+		});
+
+		auto pool_time = ov::test::MeasureMilliseconds([size]() {
+			for (int index = 0; index < COUNT; index++)
+			{
+				auto block = ov::DataPool::Allocate(size);
+				static_cast<volatile uint8_t *>(block)[0] = 0;
+				ov::DataPool::Free(block, size);
+			}
+		});
+
+		::printf("  %6zu bytes x %d: malloc %.2fms, pool %.2fms\n", size, COUNT, malloc_time, pool_time);
+	}
+
+	::printf("  %s\n", ov::DataPool::GetStatsString().CStr());
+}
+
+// Each thread keeps a few packets alive at once, like the threads that receive and relay the packets
+static void BenchThreads()
+{
+	constexpr int COUNT = 1000000;
+	constexpr size_t SIZE = 1316;
+	constexpr int BATCH_COUNT = 32;
+
+	auto run = [](int thread_count, void *(*allocate)(size_t), void (*free)(void *, size_t)) -> double {
+		return ov::test::MeasureMilliseconds([=]() {
+			std::vector<std::thread> thread_list;
+
+			for (int thread_index = 0; thread_index < thread_count; thread_index++)
+			{
+				thread_list.emplace_back([=]() {
+					void *block_list[BATCH_COUNT];
+
+					for (int index = 0; index < COUNT; index += BATCH_COUNT)
+					{
+						for (auto &block : block_list)
+						{
+							block = allocate(SIZE);
+							static_cast<volatile uint8_t *>(block)[0] = 0;
+						}
+
+						for (auto block : block_list)
+						{
+							free(block, SIZE);
+						}
+					}
+				});
+			}
+
+			for (auto &thread : thread_list)
+			{
+				thread.join();
+			}
+		});
+	};
+
+	for (int thread_count : {1, 4, 8})
+	{
+		auto malloc_time = run(
+			thread_count,
+			[](size_t size) -> void * { return ::malloc(size); },
+			[](void *block, size_t) { ::free(block); });
+
+		auto pool_time = run(thread_count, ov::DataPool::Allocate, ov::DataPool::Free);
+
+		::printf("  %zu bytes x %d x %d threads: malloc %.2fms, pool %.2fms\n", SIZE, COUNT, thread_count, malloc_time, pool_time);
+	}
+}
+
+int main()
+{
+	OV_TEST_RUN(TestAllocationSize);
+	OV_TEST_RUN(TestReuse);
+	OV_TEST_RUN(TestBytesInUse);
+	OV_TEST_RUN(TestDataCapacity);
+	OV_TEST_RUN(TestCrossThreadFree);
+	OV_TEST_RUN(TestStatsOfLiveThreads);
+	OV_TEST_RUN(BenchAllocation);
+	OV_TEST_RUN(BenchThreads);
+
+	return 0;
+}
@@ -0,0 +1,17 @@
+LOCAL_PATH := $(call get_local_path)
+include $(DEFAULT_VARIABLES)
+
+LOCAL_STATIC_LIBRARIES := \
+	socket \
+	ovlibrary
+
+LOCAL_LDFLAGS := -lpthread
+
+$(call add_pkg_config,srt)
+$(call add_pkg_config,openssl)
+
+LOCAL_TARGET := datagram_socket_test
+
+include $(BUILD_EXECUTABLE)
+
+TEST_TARGET_LIST += $(BUILD_TARGET_WITH_PATH)
@@ -0,0 +1,367 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <base/ovsocket/ovsocket.h>
+#include <tests/test_common.h>
+
+#include <sys/socket.h>
+
+#include <cstring>
+#include <vector>
+
+// Exposes the GSO switch, to measure the batches with and without GSO
+class TestDatagramSocket : public ov::DatagramSocket
+{
+public:
+	void SetGsoEnabled(bool is_enabled)
+	{
+		_is_gso_enabled = is_enabled;
+	}
+
+	bool IsGsoEnabled() const
+	{
+		return _is_gso_enabled;
+	}
+};
+
+static std::shared_ptr<TestDatagramSocket> CreateSocket()
+{
+	auto socket = std::make_shared<TestDatagramSocket>();
+
+	// An ephemeral port of the loopback
+	OV_TEST_ASSERT(socket->Prepare(ov::SocketAddress("127.0.0.1", 0)));
+	// Room for all datagrams of a test (the kernel caps it to net.core.rmem_max, and doubles it)
+	OV_TEST_ASSERT(socket->SetSockOpt<int>(SO_RCVBUF, 1024 * 1024));
+
+	return socket;
+}
+
+static ov::SocketAddress GetAddress(const std::shared_ptr<TestDatagramSocket> &socket)
+{
+	// The port that the kernel has picked (GetLocalAddress() returns the address to bind)
+	sockaddr_in address{};
+	socklen_t address_length = sizeof(address);
+
+	OV_TEST_ASSERT(::getsockname(socket->GetId(), reinterpret_cast<sockaddr *>(&address), &address_length) == 0);
+
+	return ov::SocketAddress(address);
+}
+
+// The first byte is the index of the packet, and the others are derived from it
+static std::shared_ptr<const ov::Data> MakePacket(uint32_t index, size_t length)
+{
+	auto data = std::make_shared<ov::Data>(length);
+	data->SetLength(length);
+
+	auto bytes = data->GetWritableDataAs<uint8_t>();
+
+	for (size_t offset = 0; offset < length; offset++)
+	{
+		bytes[offset] = static_cast<uint8_t>(index + offset);
+	}
+
+	return data;
+}
+
+static bool IsPacket(const std::shared_ptr<const ov::Data> &data, uint32_t index, size_t length)
+{
+	return data->IsEqual(MakePacket(index, length).get());
+}
+
+// Receives the datagrams until count of them have arrived or nothing arrives for 500ms
+static std::vector<std::shared_ptr<ov::Data>> Receive(const std::shared_ptr<TestDatagramSocket> &socket, size_t count)
+{
+	std::vector<std::shared_ptr<ov::Data>> data_list;
+
+	while (data_list.size() < count)
+	{
+		auto previous_count = data_list.size();
+
+		OV_TEST_ASSERT(socket->DispatchEvent([&](const std::shared_ptr<ov::DatagramSocket> &client, const ov::SocketAddress &remote_address, const std::shared_ptr<ov::Data> &data) {
+			// Keeps the buffers of the ring, so the next datagrams must not overwrite them
+			data_list.push_back(data);
+		},
+											 500));
+
+		if (data_list.size() == previous_count)
+		{
+			break;
+		}
+	}
+
+	return data_list;
+}
+
+static void TestSendBatch(bool is_gso_enabled)
+{
+	auto sender = CreateSocket();
+	auto receiver = CreateSocket();
+	auto address = GetAddress(receiver);
+
+	sender->SetGsoEnabled(is_gso_enabled);
+
+	// Runs of the same size (coalesced if GSO is enabled) with a shorter packet at the end, a larger packet,
+	// and more packets than a sendmmsg() carries
+	std::vector<size_t> length_list;
+
+	for (uint32_t index = 0; index < 100; index++)
+	{
+		length_list.push_back(((index % 10) == 9) ? 300 : (((index % 25) == 24) ? 1400 : 1200));
+	}
+
+	std::vector<ov::DatagramPacket> packet_list;
+
+	for (uint32_t index = 0; index < length_list.size(); index++)
+	{
+		packet_list.push_back({address, MakePacket(index, length_list[index])});
+	}
+
+	OV_TEST_ASSERT(sender->SendTo(packet_list) == packet_list.size());
+
+	// The boundaries of the datagrams are kept
+	auto data_list = Receive(receiver, packet_list.size());
+	OV_TEST_ASSERT(data_list.size() == packet_list.size());
+
+	for (uint32_t index = 0; index < data_list.size(); index++)
+	{
+		OV_TEST_ASSERT(IsPacket(data_list[index], index, length_list[index]));
+	}
+
+	sender->Close();
+	receiver->Close();
+}
+
+static void TestSendBatchWithGso()
+{
+	TestSendBatch(true);
+}
+
+static void TestSendBatchWithoutGso()
+{
+	TestSendBatch(false);
+}
+
+static void TestSendBatchToManyAddresses()
+{
+	auto sender = CreateSocket();
+	std::vector<std::shared_ptr<TestDatagramSocket>> receivers = {CreateSocket(), CreateSocket(), CreateSocket()};
+	std::vector<ov::DatagramPacket> packet_list;
+
+	// Some packets in a row to the same address, then to the next address
+	for (uint32_t index = 0; index < 90; index++)
+	{
+		packet_list.push_back({GetAddress(receivers[(index / 5) % receivers.size()]), MakePacket(index, 1000)});
+	}
+
+	OV_TEST_ASSERT(sender->SendTo(packet_list) == packet_list.size());
+
+	for (uint32_t receiver_index = 0; receiver_index < receivers.size(); receiver_index++)
+	{
+		auto data_list = Receive(receivers[receiver_index], 30);
+		OV_TEST_ASSERT(data_list.size() == 30);
+
+		for (uint32_t index = 0; index < data_list.size(); index++)
+		{
+			auto packet_index = ((index / 5) * receivers.size() + receiver_index) * 5 + (index % 5);
+
+			OV_TEST_ASSERT(IsPacket(data_list[index], packet_index, 1000));
+		}
+
+		receivers[receiver_index]->Close();
+	}
+
+	sender->Close();
+}
+
+static void TestSendBatchScope()
+{
+	auto sender = CreateSocket();
+	auto receiver = CreateSocket();
+	auto address = GetAddress(receiver);
+
+	{
+		ov::DatagramSendBatch batch;
+
+		for (uint32_t index = 0; index < 10; index++)
+		{
+			OV_TEST_ASSERT(ov::DatagramSendBatch::SendTo(sender, address, MakePacket(index, 500)) == 500);
+		}
+
+		{
+			// A nested batch does not flush
+			ov::DatagramSendBatch nested_batch;
+
+			OV_TEST_ASSERT(ov::DatagramSendBatch::SendTo(sender, address, MakePacket(10, 500)) == 500);
+		}
+
+		OV_TEST_ASSERT(Receive(receiver, 1).empty());
+	}
+
+	auto data_list = Receive(receiver, 11);
+	OV_TEST_ASSERT(data_list.size() == 11);
+
+	for (uint32_t index = 0; index < data_list.size(); index++)
+	{
+		OV_TEST_ASSERT(IsPacket(data_list[index], index, 500));
+	}
+
+	{
+		ov::DatagramSendBatch batch;
+
+		// A batch does not hold more packets than one sendmmsg() carries
+		for (uint32_t index = 0; index < ov::DatagramBatchCount; index++)
+		{
+			ov::DatagramSendBatch::SendTo(sender, address, MakePacket(index, 500));
+		}
+
+		OV_TEST_ASSERT(Receive(receiver, ov::DatagramBatchCount).size() == static_cast<size_t>(ov::DatagramBatchCount));
+	}
+
+	// Without a batch, the packet is sent immediately
+	OV_TEST_ASSERT(ov::DatagramSendBatch::SendTo(sender, address, MakePacket(0, 500)) == 500);
+	OV_TEST_ASSERT(Receive(receiver, 1).size() == 1);
+
+	sender->Close();
+	receiver->Close();
+}
+
+// Packets per second that a thread sends to a few sessions: 1200 bytes, 8 packets in a row per session
+// (a video frame), in bursts of 32 packets as StreamWorker hands them over
+static void BenchSend()
+{
+	constexpr uint32_t COUNT = 200000;
+	constexpr uint32_t BURST_COUNT = 32;
+
+	auto sender = CreateSocket();
+	std::vector<std::shared_ptr<TestDatagramSocket>> receivers = {CreateSocket(), CreateSocket(), CreateSocket(), CreateSocket()};
+	std::vector<ov::DatagramPacket> burst;
+
+	for (uint32_t index = 0; index < BURST_COUNT; index++)
+	{
+		burst.push_back({GetAddress(receivers[(index / 8) % receivers.size()]), MakePacket(index, 1200)});
+	}
+
+	// Nobody reads the receivers: the datagrams are dropped when their buffers are full, and the sends still succeed
+	auto per_packet_elapsed = ov::test::MeasureMilliseconds([&]() {
+		for (uint32_t index = 0; index < COUNT; index += BURST_COUNT)
+		{
+			for (auto &packet : burst)
+			{
+				sender->Socket::SendTo(packet.address, packet.data);
+			}
+		}
+	});
+
+	auto measure_batch = [&](bool is_gso_enabled) -> double {
+		sender->SetGsoEnabled(is_gso_enabled);
+
+		return ov::test::MeasureMilliseconds([&]() {
+			for (uint32_t index = 0; index < COUNT; index += BURST_COUNT)
+			{
+				sender->SendTo(burst);
+			}
+		});
+	};
+
+	auto batch_elapsed = measure_batch(false);
+	auto gso_elapsed = measure_batch(true);
+
+	auto packets_per_second = [&](double elapsed) -> double {
+		return COUNT / (elapsed / 1000.0) / 1000000.0;
+	};
+
+	::printf("  sendto() per packet: %.2fM packets/s\n", packets_per_second(per_packet_elapsed));
+	::printf("  sendmmsg(): %.2fM packets/s\n", packets_per_second(batch_elapsed));
+	::printf("  sendmmsg() + GSO: %.2fM packets/s (GSO %s)\n", packets_per_second(gso_elapsed), sender->IsGsoEnabled() ? "available" : "not available");
+
+	sender->Close();
+
+	for (auto &receiver : receivers)
+	{
+		receiver->Close();
+	}
+}
+
+// Packets per second that a thread receives, excluding the time to send them
+static void BenchReceive()
+{
+	constexpr uint32_t COUNT = 100000;
+	constexpr uint32_t BURST_COUNT = 32;
+
+	auto sender = CreateSocket();
+	auto receiver = CreateSocket();
+	std::vector<ov::DatagramPacket> burst;
+
+	for (uint32_t index = 0; index < BURST_COUNT; index++)
+	{
+		burst.push_back({GetAddress(receiver), MakePacket(index, 1200)});
+	}
+
+	double per_packet_elapsed = 0.0;
+	double batch_elapsed = 0.0;
+	uint32_t received_count = 0;
+
+	for (uint32_t index = 0; index < COUNT; index += BURST_COUNT)
+	{
+		OV_TEST_ASSERT(sender->SendTo(burst) == BURST_COUNT);
+
+		// A RecvFrom() per datagram until the socket buffer is drained, as DispatchEvent() did before
+		per_packet_elapsed += ov::test::MeasureMilliseconds([&]() {
+			uint32_t count = 0;
+
+			while (true)
+			{
+				auto data = std::make_shared<ov::Data>(ov::UdpBufferSize);
+				std::shared_ptr<ov::SocketAddress> remote;
+
+				OV_TEST_ASSERT(receiver->RecvFrom(data, &remote) == nullptr);
+
+				if (data->GetLength() == 0)
+				{
+					break;
+				}
+
+				count++;
+			}
+
+			OV_TEST_ASSERT(count == BURST_COUNT);
+		});
+
+		OV_TEST_ASSERT(sender->SendTo(burst) == BURST_COUNT);
+
+		batch_elapsed += ov::test::MeasureMilliseconds([&]() {
+			receiver->DispatchEvent([&](const std::shared_ptr<ov::DatagramSocket> &client, const ov::SocketAddress &remote_address, const std::shared_ptr<ov::Data> &data) {
+				received_count++;
+			},
+									0);
+		});
+	}
+
+	OV_TEST_ASSERT(received_count == COUNT + (BURST_COUNT - (COUNT % BURST_COUNT)) % BURST_COUNT);
+
+	auto packets_per_second = [&](double elapsed) -> double {
+		return received_count / (elapsed / 1000.0) / 1000000.0;
+	};
+
+	::printf("  RecvFrom() per packet: %.2fM packets/s\n", packets_per_second(per_packet_elapsed));
+	::printf("  DispatchEvent() with recvmmsg(): %.2fM packets/s\n", packets_per_second(batch_elapsed));
+
+	sender->Close();
+	receiver->Close();
+}
+
+int main()
+{
+	OV_TEST_RUN(TestSendBatchWithGso);
+	OV_TEST_RUN(TestSendBatchWithoutGso);
+	OV_TEST_RUN(TestSendBatchToManyAddresses);
+	OV_TEST_RUN(TestSendBatchScope);
+	OV_TEST_RUN(BenchSend);
+	OV_TEST_RUN(BenchReceive);
+
+	return 0;
+}
@@ -0,0 +1,277 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <orchestrator/orchestrator.h>
+#include <tests/test_common.h>
+
+#include <random>
+
+struct TestVirtualHost
+{
+	ov::String name;
+	std::vector<Orchestrator::Domain> domain_list;
+};
+
+using TestVirtualHostList = std::vector<TestVirtualHost>;
+
+// Same as Orchestrator::UpdateDomainResolver()
+static std::shared_ptr<DomainResolver> CreateResolver(const TestVirtualHostList &vhost_list)
+{
+	auto resolver = std::make_shared<DomainResolver>();
+
+	for (auto &vhost : vhost_list)
+	{
+		for (auto &domain : vhost.domain_list)
+		{
+			resolver->AddPattern(domain.name, domain.regex_for_domain, vhost.name);
+		}
+	}
+
+	return resolver;
+}
+
+// The previous implementation of Orchestrator::GetVhostNameFromDomain(), which matches the regex of every domain in order
+static ov::String ResolveByRegex(const TestVirtualHostList &vhost_list, const ov::String &domain_name)
+{
+	if (domain_name.IsEmpty() == false)
+	{
+		for (auto &vhost : vhost_list)
+		{
+			for (auto &domain : vhost.domain_list)
+			{
+				if (std::regex_match(domain_name.CStr(), domain.regex_for_domain))
+				{
+					return vhost.name;
+				}
+			}
+		}
+	}
+
+	return "";
+}
+
+static TestVirtualHostList CreateVirtualHostList(const std::vector<std::vector<ov::String>> &domain_name_list)
+{
+	TestVirtualHostList vhost_list;
+
+	for (auto &names : domain_name_list)
+	{
+		TestVirtualHost vhost{ov::String::FormatString("vhost%zu", vhost_list.size()), {}};
+
+		for (auto &name : names)
+		{
+			vhost.domain_list.emplace_back(name);
+		}
+
+		vhost_list.push_back(std::move(vhost));
+	}
+
+	return vhost_list;
+}
+
+static void TestPatterns()
+{
+	auto vhost_list = CreateVirtualHostList({
+		{"airensoft.com", "www.airensoft.com"},
+		{"*.airensoft.com"},
+		{"ome-*.example.com", "edge?.example.com"},
+		{"*.example.com", "192.168.0.1"},
+		{"*"},
+	});
+
+	auto resolver = CreateResolver(vhost_list);
+
+	struct
+	{
+		const char *domain_name;
+		const char *vhost_name;
+	} test_list[] = {
+		{"airensoft.com", "vhost0"},
+		{"www.airensoft.com", "vhost0"},
+		{"api.airensoft.com", "vhost1"},
+		{"a.b.airensoft.com", "vhost1"},
+		{"ome-1.example.com", "vhost2"},
+		{"edge1.example.com", "vhost2"},
+		{"edge.example.com", "vhost2"},
+		{"edge12.example.com", "vhost3"},
+		{"www.example.com", "vhost3"},
+		{"example.com", "vhost4"},
+		{"192.168.0.1", "vhost3"},
+		{"192.168.0.10", "vhost4"},
+		{"localhost", "vhost4"},
+		{"", ""},
+	};
+
+	for (auto &test : test_list)
+	{
+		// Resolved twice to check the cached result
+		OV_TEST_ASSERT(resolver->Resolve(test.domain_name) == test.vhost_name);
+		OV_TEST_ASSERT(resolver->Resolve(test.domain_name) == test.vhost_name);
+		OV_TEST_ASSERT(ResolveByRegex(vhost_list, test.domain_name) == test.vhost_name);
+	}
+}
+
+static void TestPriority()
+{
+	// The first pattern wins, even if a later pattern is more specific
+	auto vhost_list = CreateVirtualHostList({
+		{"*.airensoft.com"},
+		{"www.airensoft.com"},
+		{"ome-*.airensoft.com"},
+	});
+
+	auto resolver = CreateResolver(vhost_list);
+
+	OV_TEST_ASSERT(resolver->Resolve("www.airensoft.com") == "vhost0");
+	OV_TEST_ASSERT(resolver->Resolve("ome-1.airensoft.com") == "vhost0");
+	OV_TEST_ASSERT(resolver->Resolve("airensoft.com") == "");
+
+	// A regex pattern that has higher priority than the trie
+	vhost_list = CreateVirtualHostList({
+		{"ome-*.airensoft.com"},
+		{"*.airensoft.com"},
+		{"*"},
+	});
+
+	resolver = CreateResolver(vhost_list);
+
+	OV_TEST_ASSERT(resolver->Resolve("ome-1.airensoft.com") == "vhost0");
+	OV_TEST_ASSERT(resolver->Resolve("www.airensoft.com") == "vhost1");
+	OV_TEST_ASSERT(resolver->Resolve("localhost") == "vhost2");
+}
+
+// Compares the results with the regex loop, using the random patterns and domains that are made of the same labels
+static void TestEquivalenceWithRegex()
+{
+	const char *label_list[] = {"com", "net", "airensoft", "example", "www", "api", "ome", "edge1", "a", ""};
+	const char *wildcard_label_list[] = {"*", "?", "ome-*", "edge?", "*1", "w*w"};
+
+	constexpr size_t LABEL_COUNT = OV_COUNTOF(label_list);
+	constexpr size_t WILDCARD_LABEL_COUNT = OV_COUNTOF(wildcard_label_list);
+
+	for (uint32_t seed = 0; seed < 200; seed++)
+	{
+		std::mt19937 random(seed);
+
+		auto random_index = [&random](size_t count) -> size_t {
+			return std::uniform_int_distribution<size_t>(0, count - 1)(random);
+		};
+
+		auto make_name = [&](bool is_pattern) -> ov::String {
+			ov::String name;
+			auto label_count = random_index(4) + 1;
+
+			for (size_t index = 0; index < label_count; index++)
+			{
+				if (index > 0)
+				{
+					name.Append('.');
+				}
+
+				if (is_pattern && (random_index(4) == 0))
+				{
+					name.Append(wildcard_label_list[random_index(WILDCARD_LABEL_COUNT)]);
+				}
+				else
+				{
+					name.Append(label_list[random_index(LABEL_COUNT)]);
+				}
+			}
+
+			return name;
+		};
+
+		std::vector<std::vector<ov::String>> domain_name_list(random_index(8) + 1);
+
+		for (auto &names : domain_name_list)
+		{
+			names.resize(random_index(4) + 1);
+
+			for (auto &name : names)
+			{
+				// "*" matches all, so it is rarely added
+				name = (random_index(50) == 0) ? "*" : make_name(true);
+			}
+		}
+
+		auto vhost_list = CreateVirtualHostList(domain_name_list);
+		auto resolver = CreateResolver(vhost_list);
+
+		// More domains than the cache can hold, so the cached results are evicted
+		for (int count = 0; count < DOMAIN_RESOLVER_CACHE_SIZE * 2; count++)
+		{
+			auto domain_name = make_name(false);
+			auto expected = ResolveByRegex(vhost_list, domain_name);
+
+			if (resolver->Resolve(domain_name) != expected)
+			{
+				::fprintf(stderr, "Mismatch (seed: %u): %s => %s (expected: %s)\n", seed, domain_name.CStr(), resolver->Resolve(domain_name).CStr(), expected.CStr());
+				OV_TEST_ASSERT(false);
+			}
+
+			// The patterns themselves are also resolved as domains
+			auto &names = domain_name_list[random_index(domain_name_list.size())];
+			auto &pattern = names[random_index(names.size())];
+
+			OV_TEST_ASSERT(resolver->Resolve(pattern) == ResolveByRegex(vhost_list, pattern));
+		}
+	}
+}
+
+static void BenchResolve()
+{
+	// 50 virtual hosts that have an exact domain and a wildcard domain
+	TestVirtualHostList vhost_list;
+
+	for (int index = 0; index < 50; index++)
+	{
+		TestVirtualHost vhost{ov::String::FormatString("vhost%d", index), {}};
+
+		vhost.domain_list.emplace_back(ov::String::FormatString("host%d.airensoft.com", index));
+		vhost.domain_list.emplace_back(ov::String::FormatString("*.host%d.example.com", index));
+
+		vhost_list.push_back(std::move(vhost));
+	}
+
+	auto resolver = CreateResolver(vhost_list);
+
+	constexpr int COUNT = 20000;
+	std::vector<ov::String> domain_name_list;
+
+	for (int index = 0; index < COUNT; index++)
+	{
+		domain_name_list.push_back((index % 2 == 0)
+									   ? ov::String::FormatString("host%d.airensoft.com", index % 50)
+									   : ov::String::FormatString("edge%d.host%d.example.com", index % 7, index % 50));
+	}
+
+	auto regex_time = ov::test::MeasureMilliseconds([&]() {
+		for (auto &domain_name : domain_name_list)
+		{
+			OV_TEST_ASSERT(ResolveByRegex(vhost_list, domain_name).IsEmpty() == false);
+		}
+	});
+
+	auto resolver_time = ov::test::MeasureMilliseconds([&]() {
+		for (auto &domain_name : domain_name_list)
+		{
+			OV_TEST_ASSERT(resolver->Resolve(domain_name).IsEmpty() == false);
+		}
+	});
+
+	::printf("  %d lookups of 100 domains: regex %.2fms, resolver %.2fms\n", COUNT, regex_time, resolver_time);
+}
+
+int main()
+{
+	OV_TEST_RUN(TestPatterns);
+	OV_TEST_RUN(TestPriority);
+	OV_TEST_RUN(TestEquivalenceWithRegex);
+	OV_TEST_RUN(BenchResolve);
+
+	return 0;
+}
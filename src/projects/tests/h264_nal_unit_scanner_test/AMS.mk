@@ -0,0 +1,16 @@
+LOCAL_PATH := $(call get_local_path)
+include $(DEFAULT_VARIABLES)
+
+LOCAL_STATIC_LIBRARIES := \
+	h264 \
+	ovlibrary
+
+LOCAL_LDFLAGS := -lpthread
+
+$(call add_pkg_config,openssl)
+
+LOCAL_TARGET := h264_nal_unit_scanner_test
+
+include $(BUILD_EXECUTABLE)
+
+TEST_TARGET_LIST += $(BUILD_TARGET_WITH_PATH)
@@ -0,0 +1,289 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <modules/h264/h264_nal_unit_scanner.h>
+#include <tests/test_common.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+// The byte-by-byte scans that the scanner replaces, used as the reference of the results
+namespace reference
+{
+	static size_t FindStartCode(const uint8_t *bitstream, size_t length)
+	{
+		for (size_t offset = 0; offset + 2 < length; offset++)
+		{
+			if ((bitstream[offset] == 0x00) && (bitstream[offset + 1] == 0x00) && (bitstream[offset + 2] == 0x01))
+			{
+				return offset;
+			}
+		}
+
+		return length;
+	}
+
+	static size_t MakeNalUnitIndex(const uint8_t *bitstream, size_t length, FragmentationHeader *header)
+	{
+		size_t count = 0;
+		size_t nal_unit_offset = 0;
+
+		for (size_t offset = 0; offset + 2 < length; offset++)
+		{
+			if ((bitstream[offset] != 0x00) || (bitstream[offset + 1] != 0x00) || (bitstream[offset + 2] != 0x01))
+			{
+				continue;
+			}
+
+			if (count > 0)
+			{
+				size_t nal_unit_end = ((offset > nal_unit_offset) && (bitstream[offset - 1] == 0x00)) ? (offset - 1) : offset;
+
+				header->fragmentation_offset.emplace_back(nal_unit_offset);
+				header->fragmentation_length.emplace_back(nal_unit_end - nal_unit_offset);
+			}
+
+			nal_unit_offset = offset + 3;
+			count++;
+			offset += 2;
+		}
+
+		if (count > 0)
+		{
+			header->fragmentation_offset.emplace_back(nal_unit_offset);
+			header->fragmentation_length.emplace_back(length - nal_unit_offset);
+		}
+
+		return count;
+	}
+
+	// 7.3.1 NAL unit syntax
+	static size_t RemoveEmulationPrevention(const uint8_t *nal_unit, size_t length, uint8_t *rbsp)
+	{
+		size_t rbsp_length = 0;
+
+		for (size_t offset = 0; offset < length; offset++)
+		{
+			if ((offset + 2 < length) && (nal_unit[offset] == 0x00) && (nal_unit[offset + 1] == 0x00) && (nal_unit[offset + 2] == 0x03))
+			{
+				rbsp[rbsp_length++] = nal_unit[offset];
+				rbsp[rbsp_length++] = nal_unit[offset + 1];
+				offset += 2;
+			}
+			else
+			{
+				rbsp[rbsp_length++] = nal_unit[offset];
+			}
+		}
+
+		return rbsp_length;
+	}
+}  // namespace reference
+
+// Mostly 00, 01 and 03, so that the patterns appear everywhere (including across the 16/32 bytes blocks)
+static std::vector<uint8_t> MakeDenseBytes(std::mt19937 &random, size_t length)
+{
+	static const uint8_t BYTES[] = {0x00, 0x00, 0x00, 0x01, 0x03, 0x02, 0xFF};
+	std::uniform_int_distribution<size_t> distribution(0, sizeof(BYTES) - 1);
+	std::vector<uint8_t> bytes(length);
+
+	for (auto &byte : bytes)
+	{
+		byte = BYTES[distribution(random)];
+	}
+
+	return bytes;
+}
+
+// Annex-B stream like an encoder makes it: random payloads, escaped with 03, after 4 bytes start codes
+static std::vector<uint8_t> MakeAnnexB(std::mt19937 &random, size_t nal_unit_count, size_t nal_unit_length)
+{
+	std::uniform_int_distribution<int> distribution(0, 255);
+	std::vector<uint8_t> stream;
+
+	for (size_t index = 0; index < nal_unit_count; index++)
+	{
+		stream.insert(stream.end(), {0x00, 0x00, 0x00, 0x01, 0x65});
+
+		size_t zero_count = 0;
+
+		for (size_t offset = 0; offset < nal_unit_length; offset++)
+		{
+			// Zeros are more frequent than the other bytes in the entropy coded data
+			auto byte = static_cast<uint8_t>((distribution(random) < 32) ? 0x00 : distribution(random));
+
+			if ((zero_count >= 2) && (byte <= 0x03))
+			{
+				stream.push_back(0x03);
+				zero_count = 0;
+			}
+
+			stream.push_back(byte);
+			zero_count = (byte == 0x00) ? (zero_count + 1) : 0;
+		}
+
+		// rbsp_trailing_bits
+		stream.push_back(0x80);
+	}
+
+	return stream;
+}
+
+static void TestFindStartCode()
+{
+	std::mt19937 random(1);
+
+	// All lengths and alignments around the block sizes of SSE2/AVX2
+	for (size_t length = 0; length < 160; length++)
+	{
+		for (size_t alignment = 0; alignment < 4; alignment++)
+		{
+			auto bytes = MakeDenseBytes(random, length + alignment);
+			auto bitstream = bytes.data() + alignment;
+
+			OV_TEST_ASSERT(H264NalUnitScanner::FindStartCode(bitstream, length) == reference::FindStartCode(bitstream, length));
+		}
+	}
+
+	// A start code at every position of a long bitstream without other patterns
+	std::vector<uint8_t> bytes(300, 0xAB);
+
+	for (size_t offset = 0; offset + 2 < bytes.size(); offset++)
+	{
+		auto bitstream = bytes;
+		bitstream[offset] = 0x00;
+		bitstream[offset + 1] = 0x00;
+		bitstream[offset + 2] = 0x01;
+
+		OV_TEST_ASSERT(H264NalUnitScanner::FindStartCode(bitstream.data(), bitstream.size()) == offset);
+		// A start code that is cut by the end of the bitstream is not found
+		OV_TEST_ASSERT(H264NalUnitScanner::FindStartCode(bitstream.data(), offset + 2) == offset + 2);
+	}
+}
+
+static void TestMakeNalUnitIndex()
+{
+	std::mt19937 random(2);
+
+	for (int count = 0; count < 2000; count++)
+	{
+		auto bytes = MakeDenseBytes(random, random() % 400);
+
+		FragmentationHeader header;
+		FragmentationHeader reference_header;
+
+		OV_TEST_ASSERT(H264NalUnitScanner::MakeNalUnitIndex(bytes.data(), bytes.size(), &header) ==
+					   reference::MakeNalUnitIndex(bytes.data(), bytes.size(), &reference_header));
+		OV_TEST_ASSERT(header == reference_header);
+	}
+
+	// 4 bytes and 3 bytes start codes
+	const uint8_t bitstream[] = {0xFF, 0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x00, 0x00, 0x01, 0x68, 0xCE, 0x00, 0x00, 0x00, 0x01, 0x65};
+	FragmentationHeader header;
+
+	OV_TEST_ASSERT(H264NalUnitScanner::MakeNalUnitIndex(bitstream, sizeof(bitstream), &header) == 3);
+	OV_TEST_ASSERT((header.fragmentation_offset == std::vector<size_t>{5, 10, 16}));
+	OV_TEST_ASSERT((header.fragmentation_length == std::vector<size_t>{2, 2, 1}));
+}
+
+static void TestRemoveEmulationPrevention()
+{
+	std::mt19937 random(3);
+
+	for (int count = 0; count < 2000; count++)
+	{
+		auto nal_unit = MakeDenseBytes(random, random() % 400);
+		std::vector<uint8_t> rbsp(nal_unit.size());
+		std::vector<uint8_t> reference_rbsp(nal_unit.size());
+
+		auto length = H264NalUnitScanner::RemoveEmulationPrevention(nal_unit.data(), nal_unit.size(), rbsp.data());
+		auto reference_length = reference::RemoveEmulationPrevention(nal_unit.data(), nal_unit.size(), reference_rbsp.data());
+
+		OV_TEST_ASSERT(length == reference_length);
+		OV_TEST_ASSERT(::memcmp(rbsp.data(), reference_rbsp.data(), length) == 0);
+
+		// In-place
+		OV_TEST_ASSERT(H264NalUnitScanner::RemoveEmulationPrevention(nal_unit.data(), nal_unit.size(), nal_unit.data()) == reference_length);
+		OV_TEST_ASSERT(::memcmp(nal_unit.data(), reference_rbsp.data(), length) == 0);
+	}
+
+	// 00 00 03 03 => 00 00 03
+	const uint8_t nal_unit[] = {0x65, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00, 0x03};
+	uint8_t rbsp[sizeof(nal_unit)];
+
+	OV_TEST_ASSERT(H264NalUnitScanner::RemoveEmulationPrevention(nal_unit, sizeof(nal_unit), rbsp) == 6);
+	OV_TEST_ASSERT(::memcmp(rbsp, "\x65\x00\x00\x03\x00\x00", 6) == 0);
+}
+
+static void BenchScanner()
+{
+	constexpr int COUNT = 100;
+
+	std::mt19937 random(4);
+	// About the size of a 1080p key frame, in slices
+	auto stream = MakeAnnexB(random, 8, 40000);
+	std::vector<uint8_t> rbsp(stream.size());
+
+	size_t nal_unit_count = 0;
+	size_t rbsp_length = 0;
+
+	auto reference_index_time = ov::test::MeasureMilliseconds([&]() {
+		for (int index = 0; index < COUNT; index++)
+		{
+			FragmentationHeader header;
+			nal_unit_count = reference::MakeNalUnitIndex(stream.data(), stream.size(), &header);
+		}
+	});
+
+	auto index_time = ov::test::MeasureMilliseconds([&]() {
+		for (int index = 0; index < COUNT; index++)
+		{
+			FragmentationHeader header;
+			OV_TEST_ASSERT(H264NalUnitScanner::MakeNalUnitIndex(stream.data(), stream.size(), &header) == nal_unit_count);
+		}
+	});
+
+	auto reference_rbsp_time = ov::test::MeasureMilliseconds([&]() {
+		for (int index = 0; index < COUNT; index++)
+		{
+			rbsp_length = reference::RemoveEmulationPrevention(stream.data(), stream.size(), rbsp.data());
+		}
+	});
+
+	auto rbsp_time = ov::test::MeasureMilliseconds([&]() {
+		for (int index = 0; index < COUNT; index++)
+		{
+			OV_TEST_ASSERT(H264NalUnitScanner::RemoveEmulationPrevention(stream.data(), stream.size(), rbsp.data()) == rbsp_length);
+		}
+	});
+
+	OV_TEST_ASSERT(nal_unit_count == 8);
+
+	auto throughput = [&](double elapsed) -> double {
+		return (stream.size() * COUNT / (1024.0 * 1024.0)) / (elapsed / 1000.0);
+	};
+
+#if defined(__x86_64__)
+	::printf("  AVX2: %s\n", __builtin_cpu_supports("avx2") ? "yes" : "no (SSE2)");
+#endif
+	::printf("  %zu bytes x %d\n", stream.size(), COUNT);
+	::printf("  MakeNalUnitIndex: byte loop %.2fms (%.2f MB/s), scanner %.2fms (%.2f MB/s)\n",
+			 reference_index_time, throughput(reference_index_time), index_time, throughput(index_time));
+	::printf("  RemoveEmulationPrevention: byte loop %.2fms (%.2f MB/s), scanner %.2fms (%.2f MB/s)\n",
+			 reference_rbsp_time, throughput(reference_rbsp_time), rbsp_time, throughput(rbsp_time));
+}
+
+int main()
+{
+	OV_TEST_RUN(TestFindStartCode);
+	OV_TEST_RUN(TestMakeNalUnitIndex);
+	OV_TEST_RUN(TestRemoveEmulationPrevention);
+	OV_TEST_RUN(BenchScanner);
+
+	return 0;
+}
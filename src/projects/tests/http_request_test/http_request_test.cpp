@@ -0,0 +1,397 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <base/ovsocket/ovsocket.h>
+#include <http_server/http_request.h>
+#include <tests/test_common.h>
+
+#include <functional>
+#include <random>
+
+// The requests are not bound to a connection, but HttpRequest needs a socket
+//
+// The socket is never released, since ClientSocket asserts that its dispatch thread is running when it is destroyed
+static std::shared_ptr<ov::ClientSocket> GetClientSocket()
+{
+	static auto server_socket = new ov::ServerSocket();
+	static auto client_socket = new std::shared_ptr<ov::ClientSocket>(std::make_shared<ov::ClientSocket>(server_socket));
+
+	return *client_socket;
+}
+
+static std::shared_ptr<HttpRequest> CreateRequest()
+{
+	return std::make_shared<HttpRequest>(GetClientSocket(), nullptr);
+}
+
+static std::shared_ptr<const ov::Data> ToData(const ov::String &string)
+{
+	return std::make_shared<ov::Data>(string.CStr(), string.GetLength());
+}
+
+// Parses the header in the pieces of next_split_size() bytes
+//
+// @return The number of bytes that are consumed, or -1 if an error occurred
+static ssize_t ParseRequest(const std::shared_ptr<HttpRequest> &request, const ov::String &message, const std::function<size_t()> &next_split_size)
+{
+	auto data = ToData(message);
+	size_t offset = 0;
+
+	while ((offset < data->GetLength()) && (request->ParseStatus() == HttpStatusCode::PartialContent))
+	{
+		auto length = std::min(next_split_size(), data->GetLength() - offset);
+		auto result = request->ProcessData(data->Subdata(offset, length));
+
+		if (result < 0L)
+		{
+			return -1L;
+		}
+
+		offset += result;
+	}
+
+	return static_cast<ssize_t>(offset);
+}
+
+static void TestRequestLine()
+{
+	ov::String message =
+		"GET /app/stream/playlist.m3u8?token=abc HTTP/1.1\r\n"
+		"Host: ome.example.com:8080\r\n"
+		"User-Agent: test\r\n"
+		"\r\n";
+
+	auto request = CreateRequest();
+
+	OV_TEST_ASSERT(ParseRequest(request, message, [&message]() -> size_t { return message.GetLength(); }) == static_cast<ssize_t>(message.GetLength()));
+	OV_TEST_ASSERT(request->ParseStatus() == HttpStatusCode::OK);
+	OV_TEST_ASSERT(request->GetMethod() == HttpMethod::Get);
+	OV_TEST_ASSERT(request->GetRequestTarget() == "/app/stream/playlist.m3u8?token=abc");
+	OV_TEST_ASSERT(request->GetUri() == "http://ome.example.com:8080/app/stream/playlist.m3u8?token=abc");
+	OV_TEST_ASSERT(request->GetHttpVersion() == "HTTP/1.1");
+	OV_TEST_ASSERT(request->GetHttpVersionAsNumber() == 1.1);
+	OV_TEST_ASSERT(request->GetContentLength() == 0L);
+}
+
+static void TestHeaders()
+{
+	ov::String message =
+		"GET / HTTP/1.1\r\n"
+		"Host: localhost\r\n"
+		"X-Empty:\r\n"
+		"X-Spaces:   value with spaces   \r\n";
+
+	// More headers than the inline list can hold
+	for (int index = 0; index < HTTP_INLINE_HEADER_COUNT * 2; index++)
+	{
+		message.AppendFormat("X-Header-%d: %d\r\n", index, index);
+	}
+
+	message.Append("\r\n");
+
+	auto request = CreateRequest();
+
+	OV_TEST_ASSERT(ParseRequest(request, message, []() -> size_t { return 100; }) == static_cast<ssize_t>(message.GetLength()));
+	OV_TEST_ASSERT(request->ParseStatus() == HttpStatusCode::OK);
+	OV_TEST_ASSERT(request->GetHeaderCount() == 3 + HTTP_INLINE_HEADER_COUNT * 2);
+
+	// The names are case-insensitive, and the value is trimmed
+	OV_TEST_ASSERT(request->GetHeaderView("host") == "localhost");
+	OV_TEST_ASSERT(request->GetHeader("HOST") == "localhost");
+	OV_TEST_ASSERT(request->GetHeader("x-spaces") == "value with spaces");
+	OV_TEST_ASSERT(request->IsHeaderExists("X-Empty"));
+	OV_TEST_ASSERT(request->GetHeaderView("X-Empty").empty());
+	OV_TEST_ASSERT(request->IsHeaderExists("X-Not-Exists") == false);
+	OV_TEST_ASSERT(request->GetHeader("X-Not-Exists", "default") == "default");
+
+	for (int index = 0; index < HTTP_INLINE_HEADER_COUNT * 2; index++)
+	{
+		auto &field = request->GetHeaderField(3 + index);
+
+		OV_TEST_ASSERT(field.name == ov::String::FormatString("X-Header-%d", index).CStr());
+		OV_TEST_ASSERT(request->GetHeader(ov::String::FormatString("x-header-%d", index)) == ov::String::FormatString("%d", index));
+	}
+}
+
+static void TestSplitHeader()
+{
+	ov::String message =
+		"POST /app/stream HTTP/1.1\r\n"
+		"Host: localhost\r\n"
+		"Content-Length: 5\r\n"
+		"\r\n";
+
+	// The header (including "\r\n\r\n") is split at every possible position
+	for (size_t split_size = 1; split_size <= message.GetLength(); split_size++)
+	{
+		auto request = CreateRequest();
+
+		OV_TEST_ASSERT(ParseRequest(request, message, [split_size]() -> size_t { return split_size; }) == static_cast<ssize_t>(message.GetLength()));
+		OV_TEST_ASSERT(request->ParseStatus() == HttpStatusCode::OK);
+		OV_TEST_ASSERT(request->GetMethod() == HttpMethod::Post);
+		OV_TEST_ASSERT(request->GetContentLength() == 5L);
+		OV_TEST_ASSERT(request->GetRemainingBodyLength() == 5);
+	}
+
+	for (size_t position = 1; position < message.GetLength(); position++)
+	{
+		auto request = CreateRequest();
+		bool is_first = true;
+
+		OV_TEST_ASSERT(ParseRequest(request, message, [&]() -> size_t {
+						   auto size = is_first ? position : message.GetLength();
+						   is_first = false;
+						   return size;
+					   }) == static_cast<ssize_t>(message.GetLength()));
+		OV_TEST_ASSERT(request->ParseStatus() == HttpStatusCode::OK);
+	}
+}
+
+static void TestInvalidRequests()
+{
+	// Binary data
+	{
+		ov::String message = "GET / HTTP/1.1\r\nHost: local";
+		message.Append('\x01');
+		message.Append("host\r\n\r\n");
+
+		auto request = CreateRequest();
+
+		OV_TEST_ASSERT(ParseRequest(request, message, []() -> size_t { return 1000; }) < 0L);
+		OV_TEST_ASSERT(request->ParseStatus() == HttpStatusCode::BadRequest);
+	}
+
+	// Too large header
+	{
+		ov::String message = "GET / HTTP/1.1\r\nHost: localhost\r\nX-Large: ";
+
+		while (message.GetLength() <= HTTP_MAX_HEADER_SIZE)
+		{
+			message.Append("0123456789abcdef");
+		}
+
+		message.Append("\r\n\r\n");
+
+		auto request = CreateRequest();
+
+		OV_TEST_ASSERT(ParseRequest(request, message, []() -> size_t { return 4096; }) < 0L);
+		OV_TEST_ASSERT(request->ParseStatus() == HttpStatusCode::BadRequest);
+	}
+
+	// Invalid Content-Length
+	for (auto content_length : {"abc", "-1", "10x", ""})
+	{
+		ov::String message = ov::String::FormatString("POST / HTTP/1.1\r\nHost: localhost\r\nContent-Length: %s\r\n\r\n", content_length);
+
+		auto request = CreateRequest();
+		auto result = ParseRequest(request, message, []() -> size_t { return 1000; });
+
+		if (content_length[0] == '\0')
+		{
+			// An empty value is treated as no body
+			OV_TEST_ASSERT(result == static_cast<ssize_t>(message.GetLength()));
+			OV_TEST_ASSERT(request->GetContentLength() == 0L);
+		}
+		else
+		{
+			OV_TEST_ASSERT(result < 0L);
+		}
+	}
+}
+
+static void TestKeepAlive()
+{
+	struct
+	{
+		const char *version;
+		const char *connection;
+		bool is_keep_alive;
+	} test_list[] = {
+		{"1.1", nullptr, true},
+		{"1.1", "keep-alive", true},
+		{"1.1", "Close", false},
+		{"1.0", nullptr, false},
+		{"1.0", "Keep-Alive", true},
+		{"1.0", "close", false},
+	};
+
+	for (auto &test : test_list)
+	{
+		ov::String message = ov::String::FormatString("GET / HTTP/%s\r\nHost: localhost\r\n", test.version);
+
+		if (test.connection != nullptr)
+		{
+			message.AppendFormat("Connection: %s\r\n", test.connection);
+		}
+
+		message.Append("\r\n");
+
+		auto request = CreateRequest();
+
+		OV_TEST_ASSERT(ParseRequest(request, message, []() -> size_t { return 1000; }) == static_cast<ssize_t>(message.GetLength()));
+		OV_TEST_ASSERT(request->IsKeepAlive() == test.is_keep_alive);
+	}
+
+	// The connection is taken over by the WebSocket
+	ov::String message = "GET /app/stream HTTP/1.1\r\nHost: localhost\r\nConnection: Upgrade\r\nUpgrade: websocket\r\n\r\n";
+	auto request = CreateRequest();
+
+	OV_TEST_ASSERT(ParseRequest(request, message, []() -> size_t { return 1000; }) == static_cast<ssize_t>(message.GetLength()));
+	OV_TEST_ASSERT(request->IsKeepAlive() == false);
+}
+
+struct ReceivedRequest
+{
+	HttpMethod method;
+	ov::String target;
+	ov::String body;
+};
+
+// Processes the received data in the same way as HttpServer::ProcessData():
+// the header of a request is parsed, then its body is received, and the next request starts after the body
+static std::vector<ReceivedRequest> ReceivePipelinedRequests(const ov::String &stream, const std::function<size_t()> &next_split_size)
+{
+	std::vector<ReceivedRequest> request_list;
+	std::shared_ptr<HttpRequest> request = CreateRequest();
+	auto data = ToData(stream);
+	size_t offset = 0;
+
+	while (offset < data->GetLength())
+	{
+		auto remained_data = data->Subdata(offset, std::min(next_split_size(), data->GetLength() - offset));
+		offset += remained_data->GetLength();
+
+		while (remained_data->GetLength() > 0)
+		{
+			if (request->ParseStatus() == HttpStatusCode::PartialContent)
+			{
+				auto processed_length = request->ProcessData(remained_data);
+
+				OV_TEST_ASSERT(processed_length >= 0L);
+				remained_data = remained_data->Subdata(processed_length);
+
+				if (request->ParseStatus() == HttpStatusCode::OK)
+				{
+					request_list.push_back({request->GetMethod(), request->GetRequestTarget(), ""});
+				}
+
+				continue;
+			}
+
+			OV_TEST_ASSERT(request->ParseStatus() == HttpStatusCode::OK);
+
+			auto remaining_body_length = request->GetRemainingBodyLength();
+
+			if (remaining_body_length > 0)
+			{
+				auto length = std::min(remaining_body_length, remained_data->GetLength());
+
+				request->OnBodyReceived(length);
+				request_list.back().body.Append(remained_data->GetDataAs<char>(), length);
+				remained_data = remained_data->Subdata(length);
+			}
+			else
+			{
+				OV_TEST_ASSERT(request->IsKeepAlive());
+
+				// The next request of the persistent connection
+				request = CreateRequest();
+			}
+		}
+	}
+
+	return request_list;
+}
+
+static void TestPipelining()
+{
+	ov::String stream =
+		"GET /app/stream/playlist.m3u8 HTTP/1.1\r\nHost: localhost\r\n\r\n"
+		"POST /v1/vhosts HTTP/1.1\r\nHost: localhost\r\nContent-Length: 13\r\n\r\n{\"name\":\"a\"}\n"
+		"GET /app/stream/chunklist.m3u8 HTTP/1.1\r\nHost: localhost\r\n\r\n"
+		// The body looks like a header, but must not be parsed
+		"PUT /upload HTTP/1.1\r\nHost: localhost\r\nContent-Length: 20\r\n\r\nGET / HTTP/1.1\r\n\r\n\r\n"
+		"GET /app/stream/segment_1.ts HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+
+	std::vector<ReceivedRequest> expected_list = {
+		{HttpMethod::Get, "/app/stream/playlist.m3u8", ""},
+		{HttpMethod::Post, "/v1/vhosts", "{\"name\":\"a\"}\n"},
+		{HttpMethod::Get, "/app/stream/chunklist.m3u8", ""},
+		{HttpMethod::Put, "/upload", "GET / HTTP/1.1\r\n\r\n\r\n"},
+		{HttpMethod::Get, "/app/stream/segment_1.ts", ""},
+	};
+
+	auto verify = [&expected_list](const std::vector<ReceivedRequest> &request_list) {
+		OV_TEST_ASSERT(request_list.size() == expected_list.size());
+
+		for (size_t index = 0; index < expected_list.size(); index++)
+		{
+			OV_TEST_ASSERT(request_list[index].method == expected_list[index].method);
+			OV_TEST_ASSERT(request_list[index].target == expected_list[index].target);
+			OV_TEST_ASSERT(request_list[index].body == expected_list[index].body);
+		}
+	};
+
+	// All the requests are received at once
+	verify(ReceivePipelinedRequests(stream, [&stream]() -> size_t { return stream.GetLength(); }));
+
+	// Byte by byte
+	verify(ReceivePipelinedRequests(stream, []() -> size_t { return 1; }));
+
+	for (uint32_t seed = 0; seed < 100; seed++)
+	{
+		std::mt19937 random(seed);
+		std::uniform_int_distribution<size_t> distribution(1, 64);
+
+		verify(ReceivePipelinedRequests(stream, [&]() -> size_t { return distribution(random); }));
+	}
+}
+
+static void BenchParse()
+{
+	// A typical request of a player
+	ov::String message =
+		"GET /app/stream/chunklist_0_video_llhls.m3u8?_HLS_msn=1234&_HLS_part=3 HTTP/1.1\r\n"
+		"Host: ome.example.com:3333\r\n"
+		"User-Agent: Mozilla/5.0 (Macintosh; Intel Mac OS X 10_15_7) AppleWebKit/605.1.15 (KHTML, like Gecko) Version/14.0 Safari/605.1.15\r\n"
+		"Accept: */*\r\n"
+		"Accept-Language: en-US,en;q=0.9\r\n"
+		"Accept-Encoding: gzip, deflate, br\r\n"
+		"Origin: https://player.example.com\r\n"
+		"Referer: https://player.example.com/\r\n"
+		"Connection: keep-alive\r\n"
+		"\r\n";
+
+	constexpr int COUNT = 200000;
+	auto data = ToData(message);
+	auto client_socket = GetClientSocket();
+
+	auto elapsed = ov::test::MeasureMilliseconds([&]() {
+		for (int index = 0; index < COUNT; index++)
+		{
+			HttpRequest request(client_socket, nullptr);
+
+			request.ProcessData(data);
+			OV_TEST_ASSERT(request.GetHeaderView("Host").empty() == false);
+		}
+	});
+
+	::printf("  %d requests in %.2fms: %.2f requests/s\n", COUNT, elapsed, COUNT / (elapsed / 1000.0));
+}
+
+int main()
+{
+	OV_TEST_RUN(TestRequestLine);
+	OV_TEST_RUN(TestHeaders);
+	OV_TEST_RUN(TestSplitHeader);
+	OV_TEST_RUN(TestInvalidRequests);
+	OV_TEST_RUN(TestKeepAlive);
+	OV_TEST_RUN(TestPipelining);
+	OV_TEST_RUN(BenchParse);
+
+	return 0;
+}
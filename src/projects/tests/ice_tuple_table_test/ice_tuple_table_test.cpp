@@ -0,0 +1,310 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <arpa/inet.h>
+#include <modules/ice/ice_tuple_table.h>
+#include <tests/test_common.h>
+
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
+
+struct TestSession
+{
+	explicit TestSession(uint32_t id)
+		: id(id)
+	{
+	}
+
+	uint32_t id;
+};
+
+static ov::SocketAddress MakeIPv4Address(uint32_t ip, uint16_t port)
+{
+	sockaddr_in address{};
+
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(ip);
+	address.sin_port = htons(port);
+
+	return ov::SocketAddress(address);
+}
+
+// Address of the index-th client (10.0.0.0/8, a few ports per host)
+static ov::SocketAddress MakeClientAddress(uint32_t index)
+{
+	return MakeIPv4Address(0x0A000000 + (index / 4), static_cast<uint16_t>(50000 + (index % 4)));
+}
+
+static void TestKey()
+{
+	auto address = MakeIPv4Address(0xC0A80001, 5000);
+
+	OV_TEST_ASSERT(IceTupleKey(nullptr, address) == IceTupleKey(nullptr, MakeIPv4Address(0xC0A80001, 5000)));
+	OV_TEST_ASSERT(IceTupleKey(nullptr, address).Hash() == IceTupleKey(nullptr, MakeIPv4Address(0xC0A80001, 5000)).Hash());
+
+	// The port and the address are parts of the key
+	OV_TEST_ASSERT((IceTupleKey(nullptr, address) == IceTupleKey(nullptr, MakeIPv4Address(0xC0A80001, 5001))) == false);
+	OV_TEST_ASSERT((IceTupleKey(nullptr, address) == IceTupleKey(nullptr, MakeIPv4Address(0xC0A80002, 5000))) == false);
+
+	// An IPv4 address is the same as its IPv4-mapped IPv6 address
+	sockaddr_in6 mapped_address{};
+	mapped_address.sin6_family = AF_INET6;
+	mapped_address.sin6_port = htons(5000);
+	OV_TEST_ASSERT(::inet_pton(AF_INET6, "::ffff:192.168.0.1", &mapped_address.sin6_addr) == 1);
+
+	OV_TEST_ASSERT(IceTupleKey(nullptr, address) == IceTupleKey(nullptr, ov::SocketAddress(mapped_address)));
+
+	sockaddr_in6 ipv6_address = mapped_address;
+	OV_TEST_ASSERT(::inet_pton(AF_INET6, "2001:db8::1", &ipv6_address.sin6_addr) == 1);
+
+	OV_TEST_ASSERT((IceTupleKey(nullptr, address) == IceTupleKey(nullptr, ov::SocketAddress(ipv6_address))) == false);
+}
+
+static void TestInsertFindErase()
+{
+	IceTupleTable<TestSession> table;
+	std::vector<std::shared_ptr<TestSession>> sessions;
+
+	for (uint32_t index = 0; index < 1000; index++)
+	{
+		sessions.push_back(std::make_shared<TestSession>(index));
+		table.Insert(IceTupleKey(nullptr, MakeClientAddress(index)), sessions.back());
+	}
+
+	for (uint32_t index = 0; index < 1000; index++)
+	{
+		OV_TEST_ASSERT(table.Find(IceTupleKey(nullptr, MakeClientAddress(index))) == sessions[index]);
+	}
+
+	OV_TEST_ASSERT(table.Find(IceTupleKey(nullptr, MakeClientAddress(1000))) == nullptr);
+
+	// Replaced (e.g. the client has reconnected from the same address)
+	auto key = IceTupleKey(nullptr, MakeClientAddress(0));
+	auto new_session = std::make_shared<TestSession>(1000);
+
+	table.Insert(key, new_session);
+	OV_TEST_ASSERT(table.Find(key) == new_session);
+
+	// The old session must not remove the entry of the new session
+	OV_TEST_ASSERT(table.Erase(key, sessions[0]) == false);
+	OV_TEST_ASSERT(table.Find(key) == new_session);
+
+	OV_TEST_ASSERT(table.Erase(key, new_session));
+	OV_TEST_ASSERT(table.Find(key) == nullptr);
+	OV_TEST_ASSERT(table.Erase(key) == false);
+
+	OV_TEST_ASSERT(table.Erase(IceTupleKey(nullptr, MakeClientAddress(1))));
+	OV_TEST_ASSERT(table.Find(IceTupleKey(nullptr, MakeClientAddress(1))) == nullptr);
+
+	table.Clear();
+
+	for (uint32_t index = 0; index < 1000; index++)
+	{
+		OV_TEST_ASSERT(table.Find(IceTupleKey(nullptr, MakeClientAddress(index))) == nullptr);
+	}
+}
+
+static void TestConcurrentReaders()
+{
+	constexpr uint32_t STABLE_COUNT = 1000;
+
+	IceTupleTable<TestSession> table;
+	std::vector<std::shared_ptr<TestSession>> sessions;
+
+	for (uint32_t index = 0; index < STABLE_COUNT; index++)
+	{
+		sessions.push_back(std::make_shared<TestSession>(index));
+		table.Insert(IceTupleKey(nullptr, MakeClientAddress(index)), sessions.back());
+	}
+
+	std::atomic<bool> stop{false};
+	std::vector<std::thread> readers;
+
+	// The stable sessions are always found while the other sessions come and go
+	for (int reader_index = 0; reader_index < 4; reader_index++)
+	{
+		readers.emplace_back([&]() {
+			uint32_t index = 0;
+
+			while (stop.load() == false)
+			{
+				auto session = table.Find(IceTupleKey(nullptr, MakeClientAddress(index)));
+
+				OV_TEST_ASSERT((session != nullptr) && (session->id == index));
+
+				index = (index + 1) % STABLE_COUNT;
+			}
+		});
+	}
+
+	for (uint32_t index = STABLE_COUNT; index < STABLE_COUNT + 20000; index++)
+	{
+		auto key = IceTupleKey(nullptr, MakeClientAddress(index));
+		auto session = std::make_shared<TestSession>(index);
+
+		table.Insert(key, session);
+		OV_TEST_ASSERT(table.Find(key) == session);
+		OV_TEST_ASSERT(table.Erase(key, session));
+	}
+
+	stop = true;
+
+	for (auto &reader : readers)
+	{
+		reader.join();
+	}
+}
+
+// The lookup that IcePort used before: std::map keyed by the remote address, under a mutex shared with the session setup
+class MutexMap
+{
+public:
+	void Insert(const ov::SocketAddress &address, const std::shared_ptr<TestSession> &session)
+	{
+		std::lock_guard<std::mutex> lock_guard(_mutex);
+		_map[address] = session;
+	}
+
+	void Erase(const ov::SocketAddress &address)
+	{
+		std::lock_guard<std::mutex> lock_guard(_mutex);
+		_map.erase(address);
+	}
+
+	std::shared_ptr<TestSession> Find(const ov::SocketAddress &address) const
+	{
+		std::lock_guard<std::mutex> lock_guard(_mutex);
+
+		auto item = _map.find(address);
+
+		return (item != _map.end()) ? item->second : nullptr;
+	}
+
+private:
+	mutable std::mutex _mutex;
+	std::map<ov::SocketAddress, std::shared_ptr<TestSession>> _map;
+};
+
+// Lookups per second of reader_count threads (the threads that receive the packets),
+// while another thread connects/disconnects a session every millisecond if with_churn is true
+template <typename Find, typename Churn>
+static double MeasureLookups(const std::vector<ov::SocketAddress> &addresses, int reader_count, uint32_t lookup_count, bool with_churn, Find find, Churn churn)
+{
+	std::atomic<bool> stop{false};
+	std::thread churn_thread;
+
+	if (with_churn)
+	{
+		churn_thread = std::thread([&]() {
+			for (uint32_t index = 0; stop.load() == false; index++)
+			{
+				churn(index);
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		});
+	}
+
+	auto elapsed = ov::test::MeasureMilliseconds([&]() {
+		std::vector<std::thread> readers;
+
+		for (int reader_index = 0; reader_index < reader_count; reader_index++)
+		{
+			readers.emplace_back([&, reader_index]() {
+				// Packets of the sessions arrive interleaved
+				size_t index = (reader_index * 7919) % addresses.size();
+
+				for (uint32_t count = 0; count < lookup_count; count++)
+				{
+					OV_TEST_ASSERT(find(addresses[index]) != nullptr);
+
+					index = (index + 7919) % addresses.size();
+				}
+			});
+		}
+
+		for (auto &reader : readers)
+		{
+			reader.join();
+		}
+	});
+
+	stop = true;
+
+	if (churn_thread.joinable())
+	{
+		churn_thread.join();
+	}
+
+	return (static_cast<double>(reader_count) * lookup_count) / (elapsed / 1000.0);
+}
+
+static void BenchLookup()
+{
+	constexpr uint32_t SESSION_COUNT = 10000;
+	constexpr uint32_t LOOKUP_COUNT = 2000000;
+
+	std::vector<ov::SocketAddress> addresses;
+	IceTupleTable<TestSession> table;
+	MutexMap mutex_map;
+
+	for (uint32_t index = 0; index < SESSION_COUNT; index++)
+	{
+		auto session = std::make_shared<TestSession>(index);
+
+		addresses.push_back(MakeClientAddress(index));
+
+		table.Insert(IceTupleKey(nullptr, addresses.back()), session);
+		mutex_map.Insert(addresses.back(), session);
+	}
+
+	// Sessions out of the looked up ones
+	auto churn_address = [](uint32_t index) -> ov::SocketAddress {
+		return MakeClientAddress(SESSION_COUNT + (index % 100));
+	};
+
+	::printf("  %u CPU(s), %u sessions\n", std::thread::hardware_concurrency(), SESSION_COUNT);
+
+	for (int reader_count : {1, 4})
+	{
+		for (bool with_churn : {false, true})
+		{
+			auto mutex_map_lookups = MeasureLookups(
+				addresses, reader_count, LOOKUP_COUNT / reader_count, with_churn,
+				[&](const ov::SocketAddress &address) { return mutex_map.Find(address); },
+				[&](uint32_t index) {
+					mutex_map.Insert(churn_address(index), std::make_shared<TestSession>(index));
+					mutex_map.Erase(churn_address(index));
+				});
+
+			// The key is made for each packet, as IcePort does
+			auto table_lookups = MeasureLookups(
+				addresses, reader_count, LOOKUP_COUNT / reader_count, with_churn,
+				[&](const ov::SocketAddress &address) { return table.Find(IceTupleKey(nullptr, address)); },
+				[&](uint32_t index) {
+					auto key = IceTupleKey(nullptr, churn_address(index));
+
+					table.Insert(key, std::make_shared<TestSession>(index));
+					table.Erase(key);
+				});
+
+			::printf("  %d reader(s)%s: std::map + mutex %.2fM lookups/s, IceTupleTable %.2fM lookups/s\n",
+					 reader_count, with_churn ? ", 1 session change/ms" : "", mutex_map_lookups / 1000000.0, table_lookups / 1000000.0);
+		}
+	}
+}
+
+int main()
+{
+	OV_TEST_RUN(TestKey);
+	OV_TEST_RUN(TestInsertFindErase);
+	OV_TEST_RUN(TestConcurrentReaders);
+	OV_TEST_RUN(BenchLookup);
+
+	return 0;
+}
@@ -0,0 +1,343 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <arpa/inet.h>
+#include <base/ovcrypto/ovcrypto.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <tests/test_common.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <thread>
+
+// The cipher list of HttpsServer
+#define CIPHER_LIST "ECDHE-ECDSA-CHACHA20-POLY1305:ECDHE-RSA-CHACHA20-POLY1305:ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-RSA-AES128-GCM-SHA256:ECDHE-ECDSA-AES256-GCM-SHA384:ECDHE-RSA-AES256-GCM-SHA384"
+
+static double GetThreadCpuMilliseconds()
+{
+	timespec time{};
+	::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+
+	return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+}
+
+static bool SendAll(int socket, const void *data, size_t length)
+{
+	auto bytes = static_cast<const uint8_t *>(data);
+
+	while (length > 0)
+	{
+		auto sent_bytes = ::send(socket, bytes, length, MSG_NOSIGNAL);
+
+		if (sent_bytes <= 0)
+		{
+			return false;
+		}
+
+		bytes += sent_bytes;
+		length -= sent_bytes;
+	}
+
+	return true;
+}
+
+// A TCP connection over the loopback, and a TLS session of which the server is ov::TlsData (as HttpsServer uses it)
+// and the client is OpenSSL
+class Connection
+{
+public:
+	// If use_kernel_tls is true, the server passes the socket to TlsData, as HttpsServer does when <KernelTLS> is enabled
+	Connection(const std::shared_ptr<ov::TlsContext> &tls_context, bool use_kernel_tls)
+	{
+		int listen_socket = ::socket(AF_INET, SOCK_STREAM, 0);
+		sockaddr_in address{};
+		socklen_t address_length = sizeof(address);
+
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+		OV_TEST_ASSERT(::bind(listen_socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0);
+		OV_TEST_ASSERT(::listen(listen_socket, 1) == 0);
+		OV_TEST_ASSERT(::getsockname(listen_socket, reinterpret_cast<sockaddr *>(&address), &address_length) == 0);
+
+		_client_socket = ::socket(AF_INET, SOCK_STREAM, 0);
+		OV_TEST_ASSERT(::connect(_client_socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0);
+
+		_server_socket = ::accept(listen_socket, nullptr, nullptr);
+		OV_TEST_ASSERT(_server_socket >= 0);
+
+		::close(listen_socket);
+
+		server = std::make_unique<ov::TlsData>(tls_context, use_kernel_tls ? _server_socket : -1);
+
+		// The handshake records (if kTLS is used, OpenSSL writes them to the socket instead)
+		server->SetWriteCallback([this](const void *data, int64_t length) -> ssize_t {
+			return SendAll(_server_socket, data, length) ? length : -1;
+		});
+
+		_client_ctx = ::SSL_CTX_new(TLS_client_method());
+		client = ::SSL_new(_client_ctx);
+		::SSL_set_fd(client, _client_socket);
+		::SSL_set_connect_state(client);
+	}
+
+	~Connection()
+	{
+		::SSL_free(client);
+		::SSL_CTX_free(_client_ctx);
+
+		server.reset();
+
+		::close(_client_socket);
+		::close(_server_socket);
+	}
+
+	// Runs the handshake in this thread: the client socket is non-blocking until the handshake is completed
+	bool Handshake()
+	{
+		::fcntl(_client_socket, F_SETFL, ::fcntl(_client_socket, F_GETFL) | O_NONBLOCK);
+
+		bool is_client_connected = false;
+
+		for (int round = 0; (round < 1000) && ((is_client_connected == false) || (server->GetState() != ov::TlsData::State::Accepted)); round++)
+		{
+			if (is_client_connected == false)
+			{
+				int result = ::SSL_do_handshake(client);
+
+				if ((result != 1) && (::SSL_get_error(client, result) != SSL_ERROR_WANT_READ))
+				{
+					return false;
+				}
+
+				is_client_connected = (result == 1);
+			}
+
+			// HttpsServer passes what the socket has received to TlsData
+			if (ReceiveToServer(nullptr) == false)
+			{
+				return false;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		::fcntl(_client_socket, F_SETFL, ::fcntl(_client_socket, F_GETFL) & ~O_NONBLOCK);
+
+		return is_client_connected && (server->GetState() == ov::TlsData::State::Accepted);
+	}
+
+	bool ReceiveToServer(std::shared_ptr<const ov::Data> *plain_data)
+	{
+		uint8_t buffer[16384];
+		ssize_t length;
+
+		while ((length = ::recv(_server_socket, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0)
+		{
+			std::shared_ptr<const ov::Data> decrypted;
+
+			if (server->Decrypt(std::make_shared<ov::Data>(buffer, length), &decrypted) == false)
+			{
+				return false;
+			}
+
+			if ((plain_data != nullptr) && (decrypted != nullptr) && (decrypted->GetLength() > 0))
+			{
+				*plain_data = decrypted;
+			}
+		}
+
+		return true;
+	}
+
+	// As HttpResponse does: encrypts the data (or not, if kTLS is enabled) and sends it to the socket
+	bool SendFromServer(const std::shared_ptr<const ov::Data> &data)
+	{
+		std::shared_ptr<const ov::Data> cipher_data;
+
+		if (server->Encrypt(data, &cipher_data) == false)
+		{
+			return false;
+		}
+
+		return SendAll(_server_socket, cipher_data->GetData(), cipher_data->GetLength());
+	}
+
+	bool ReadFromClient(size_t length, ov::Data *data)
+	{
+		char buffer[16384];
+
+		while (data->GetLength() < length)
+		{
+			int read_bytes = ::SSL_read(client, buffer, sizeof(buffer));
+
+			if (read_bytes <= 0)
+			{
+				return false;
+			}
+
+			data->Append(buffer, read_bytes);
+		}
+
+		return true;
+	}
+
+	std::unique_ptr<ov::TlsData> server;
+	SSL *client = nullptr;
+
+private:
+	int _server_socket = -1;
+	int _client_socket = -1;
+	SSL_CTX *_client_ctx = nullptr;
+};
+
+static std::shared_ptr<ov::TlsContext> CreateContext()
+{
+	auto certificate = std::make_shared<Certificate>();
+	OV_TEST_ASSERT(certificate->Generate() == nullptr);
+
+	auto tls_context = ov::TlsContext::CreateServerContext(TLS_server_method(), certificate, nullptr, CIPHER_LIST);
+	OV_TEST_ASSERT(tls_context != nullptr);
+
+	return tls_context;
+}
+
+static std::shared_ptr<ov::Data> MakeData(size_t length)
+{
+	auto data = std::make_shared<ov::Data>(length);
+	data->SetLength(length);
+
+	auto bytes = data->GetWritableDataAs<uint8_t>();
+
+	for (size_t offset = 0; offset < length; offset++)
+	{
+		bytes[offset] = static_cast<uint8_t>(offset * 7);
+	}
+
+	return data;
+}
+
+// Both directions work after the handshake, whether or not the kernel has taken over the encryption
+static void TestTransfer(bool use_kernel_tls)
+{
+	auto tls_context = CreateContext();
+	Connection connection(tls_context, use_kernel_tls);
+
+	OV_TEST_ASSERT(connection.Handshake());
+
+	if ((use_kernel_tls == false) || (ov::Tls::IsKernelTlsSupported() == false))
+	{
+		OV_TEST_ASSERT(connection.server->IsKernelTlsEnabled() == false);
+	}
+
+	// Client -> server (always decrypted by OpenSSL)
+	ov::String request = "GET /app/stream/playlist.m3u8 HTTP/1.1\r\n\r\n";
+	std::shared_ptr<const ov::Data> plain_data;
+
+	OV_TEST_ASSERT(::SSL_write(connection.client, request.CStr(), static_cast<int>(request.GetLength())) == static_cast<int>(request.GetLength()));
+
+	for (int round = 0; (round < 100) && (plain_data == nullptr); round++)
+	{
+		OV_TEST_ASSERT(connection.ReceiveToServer(&plain_data));
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	OV_TEST_ASSERT((plain_data != nullptr) && plain_data->IsEqual(request.CStr(), request.GetLength()));
+
+	// Server -> client: a segment larger than a TLS record
+	auto segment = MakeData(1024 * 1024 + 123);
+	ov::Data received;
+
+	std::thread reader([&]() {
+		OV_TEST_ASSERT(connection.ReadFromClient(segment->GetLength(), &received));
+	});
+
+	OV_TEST_ASSERT(connection.SendFromServer(segment));
+	reader.join();
+
+	OV_TEST_ASSERT(received.IsEqual(segment.get()));
+}
+
+static void TestTransferWithKernelTls()
+{
+	TestTransfer(true);
+}
+
+static void TestTransferWithoutKernelTls()
+{
+	TestTransfer(false);
+}
+
+// CPU time of the server thread (including the time in the kernel) to send segments,
+// and the throughput while the client decrypts them in another thread
+static void BenchSend()
+{
+	constexpr size_t SEGMENT_SIZE = 2 * 1024 * 1024;
+	constexpr int SEGMENT_COUNT = 128;
+
+	auto tls_context = CreateContext();
+	auto segment = MakeData(SEGMENT_SIZE);
+
+	auto measure = [&](const char *name, bool use_kernel_tls) {
+		Connection connection(tls_context, use_kernel_tls);
+		OV_TEST_ASSERT(connection.Handshake());
+
+		std::thread reader([&]() {
+			char buffer[16384];
+			size_t remaining = SEGMENT_SIZE * SEGMENT_COUNT;
+
+			while (remaining > 0)
+			{
+				int read_bytes = ::SSL_read(connection.client, buffer, sizeof(buffer));
+				OV_TEST_ASSERT(read_bytes > 0);
+
+				remaining -= read_bytes;
+			}
+		});
+
+		double server_milliseconds = 0.0;
+
+		auto elapsed = ov::test::MeasureMilliseconds([&]() {
+			auto start = GetThreadCpuMilliseconds();
+
+			for (int index = 0; index < SEGMENT_COUNT; index++)
+			{
+				OV_TEST_ASSERT(connection.SendFromServer(segment));
+			}
+
+			server_milliseconds = GetThreadCpuMilliseconds() - start;
+
+			reader.join();
+		});
+
+		double megabytes = static_cast<double>(SEGMENT_SIZE) * SEGMENT_COUNT / (1024.0 * 1024.0);
+
+		::printf("  %-20s kTLS %-3s  server CPU %.2f ms/MB, %.0f MB/s (%s)\n",
+				 name, connection.server->IsKernelTlsEnabled() ? "on" : "off",
+				 server_milliseconds / megabytes, megabytes / (elapsed / 1000.0), ::SSL_get_cipher_name(connection.client));
+	};
+
+	::printf("  OpenSSL kTLS support: %s\n", ov::Tls::IsKernelTlsSupported() ? "yes" : "no");
+
+	measure("OpenSSL:", false);
+	// Falls back to OpenSSL if the kernel doesn't have the tls module
+	measure("<KernelTLS> enabled:", true);
+}
+
+int main()
+{
+	// TlsData logs every accepted connection
+	ov_log_set_level(OVLogLevelWarning);
+
+	OV_TEST_RUN(TestTransferWithKernelTls);
+	OV_TEST_RUN(TestTransferWithoutKernelTls);
+	OV_TEST_RUN(BenchSend);
+
+	return 0;
+}
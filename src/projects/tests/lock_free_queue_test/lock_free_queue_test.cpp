@@ -0,0 +1,292 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <base/ovlibrary/ovlibrary.h>
+#include <tests/test_common.h>
+
+#include <thread>
+#include <vector>
+
+// An item carries the index of its producer and its sequence number, so that the consumer can check the order
+static uint64_t MakeItem(uint32_t producer_index, uint32_t sequence)
+{
+	return (static_cast<uint64_t>(producer_index) << 32) | sequence;
+}
+
+static void TestSpscQueue()
+{
+	// The capacity is rounded up to a power of two
+	ov::SpscQueue<int> queue(5);
+	OV_TEST_ASSERT(queue.GetCapacity() == 8);
+	OV_TEST_ASSERT(queue.IsEmpty());
+	OV_TEST_ASSERT(queue.TryDequeue().has_value() == false);
+
+	for (int index = 0; index < 8; index++)
+	{
+		OV_TEST_ASSERT(queue.Enqueue(int(index)));
+	}
+
+	// Full: the new item is rejected
+	OV_TEST_ASSERT(queue.Enqueue(100) == false);
+	OV_TEST_ASSERT(queue.GetRejectedCount() == 1);
+	OV_TEST_ASSERT(queue.Size() == 8);
+	OV_TEST_ASSERT(queue.GetHighWaterMark() == 8);
+
+	for (int index = 0; index < 8; index++)
+	{
+		auto item = queue.TryDequeue();
+
+		OV_TEST_ASSERT(item.has_value());
+		OV_TEST_ASSERT(item.value() == index);
+	}
+
+	OV_TEST_ASSERT(queue.IsEmpty());
+
+	// The positions wrap around the ring
+	for (int index = 0; index < 100; index++)
+	{
+		OV_TEST_ASSERT(queue.Enqueue(int(index)));
+		OV_TEST_ASSERT(queue.Dequeue(0).value() == index);
+	}
+}
+
+static void TestMpscQueueDropOldest()
+{
+	ov::MpscQueue<int> queue(4, ov::QueueOverflowPolicy::DropOldest);
+
+	for (int index = 0; index < 6; index++)
+	{
+		OV_TEST_ASSERT(queue.Enqueue(int(index)));
+	}
+
+	// The oldest items are dropped to keep the latency bounded
+	OV_TEST_ASSERT(queue.GetDroppedCount() == 2);
+	OV_TEST_ASSERT(queue.GetRejectedCount() == 0);
+	OV_TEST_ASSERT(queue.Size() == 4);
+
+	for (int index = 2; index < 6; index++)
+	{
+		OV_TEST_ASSERT(queue.TryDequeue().value() == index);
+	}
+
+	OV_TEST_ASSERT(queue.IsEmpty());
+}
+
+static void TestMpscQueueRejectNewest()
+{
+	ov::MpscQueue<int> queue(2);
+
+	OV_TEST_ASSERT(queue.Enqueue(1));
+	OV_TEST_ASSERT(queue.Enqueue(2));
+	OV_TEST_ASSERT(queue.Enqueue(3) == false);
+	OV_TEST_ASSERT(queue.GetRejectedCount() == 1);
+	OV_TEST_ASSERT(queue.GetDroppedCount() == 0);
+
+	OV_TEST_ASSERT(queue.TryDequeue().value() == 1);
+	OV_TEST_ASSERT(queue.TryDequeue().value() == 2);
+}
+
+static void TestSharedPtrIsReleased()
+{
+	// A dequeued slot must not keep the item alive (e.g. a packet of a stream that has been deleted)
+	auto item = std::make_shared<int>(1);
+	std::weak_ptr<int> weak_item = item;
+
+	ov::MpscQueue<std::shared_ptr<int>> queue(4);
+	OV_TEST_ASSERT(queue.Enqueue(std::move(item)));
+
+	queue.TryDequeue();
+
+	OV_TEST_ASSERT(weak_item.expired());
+}
+
+static void TestDequeueTimeout()
+{
+	ov::SpscQueue<int> queue(4);
+
+	auto elapsed = ov::test::MeasureMilliseconds([&]() {
+		OV_TEST_ASSERT(queue.Dequeue(50).has_value() == false);
+	});
+
+	OV_TEST_ASSERT(elapsed >= 45.0);
+}
+
+static void TestStopWakesConsumer()
+{
+	ov::MpscQueue<int> queue(4);
+
+	std::thread consumer([&]() {
+		// Sleeps until the queue is stopped
+		OV_TEST_ASSERT(queue.Dequeue().has_value() == false);
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	queue.Stop();
+	consumer.join();
+
+	OV_TEST_ASSERT(queue.IsStopped());
+	OV_TEST_ASSERT(queue.Enqueue(1) == false);
+}
+
+// The producers retry the rejected items, so that all items are delivered
+template <typename QueueType>
+static void Produce(QueueType &queue, uint32_t producer_index, uint32_t count)
+{
+	for (uint32_t sequence = 0; sequence < count; sequence++)
+	{
+		while (queue.Enqueue(MakeItem(producer_index, sequence)) == false)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+static void TestSpscQueueThreads()
+{
+	constexpr uint32_t COUNT = 1000000;
+
+	ov::SpscQueue<uint64_t> queue(256);
+
+	std::thread producer([&]() {
+		Produce(queue, 0, COUNT);
+	});
+
+	for (uint32_t sequence = 0; sequence < COUNT; sequence++)
+	{
+		auto item = queue.Dequeue();
+
+		OV_TEST_ASSERT(item.has_value());
+		OV_TEST_ASSERT(item.value() == MakeItem(0, sequence));
+	}
+
+	producer.join();
+
+	OV_TEST_ASSERT(queue.IsEmpty());
+}
+
+static void TestMpscQueueThreads()
+{
+	constexpr uint32_t PRODUCER_COUNT = 4;
+	constexpr uint32_t COUNT = 250000;
+
+	ov::MpscQueue<uint64_t> queue(256);
+	std::vector<std::thread> producers;
+
+	for (uint32_t producer_index = 0; producer_index < PRODUCER_COUNT; producer_index++)
+	{
+		producers.emplace_back([&, producer_index]() {
+			Produce(queue, producer_index, COUNT);
+		});
+	}
+
+	// Each producer's items arrive in order, and none is lost or duplicated
+	std::vector<uint32_t> next_sequences(PRODUCER_COUNT, 0);
+
+	for (uint32_t index = 0; index < PRODUCER_COUNT * COUNT; index++)
+	{
+		auto item = queue.Dequeue();
+		OV_TEST_ASSERT(item.has_value());
+
+		auto producer_index = static_cast<uint32_t>(item.value() >> 32);
+		auto sequence = static_cast<uint32_t>(item.value());
+
+		OV_TEST_ASSERT(producer_index < PRODUCER_COUNT);
+		OV_TEST_ASSERT(sequence == next_sequences[producer_index]);
+
+		next_sequences[producer_index]++;
+	}
+
+	for (auto &producer : producers)
+	{
+		producer.join();
+	}
+
+	OV_TEST_ASSERT(queue.IsEmpty());
+}
+
+// Items per second from producer_count threads to one consumer
+template <typename QueueType>
+static double MeasureThroughput(QueueType &queue, uint32_t producer_count, uint32_t count)
+{
+	auto elapsed = ov::test::MeasureMilliseconds([&]() {
+		std::vector<std::thread> producers;
+
+		for (uint32_t producer_index = 0; producer_index < producer_count; producer_index++)
+		{
+			producers.emplace_back([&, producer_index]() {
+				Produce(queue, producer_index, count);
+			});
+		}
+
+		for (uint32_t index = 0; index < producer_count * count; index++)
+		{
+			OV_TEST_ASSERT(queue.Dequeue().has_value());
+		}
+
+		for (auto &producer : producers)
+		{
+			producer.join();
+		}
+	});
+
+	return (producer_count * count) / (elapsed / 1000.0);
+}
+
+// ov::Queue is not bounded and never rejects an item, so it gets an adapter with the same Enqueue()
+class MutexQueue : public ov::Queue<uint64_t>
+{
+public:
+	bool Enqueue(uint64_t &&item)
+	{
+		ov::Queue<uint64_t>::Enqueue(std::move(item));
+		return true;
+	}
+};
+
+static void BenchQueues()
+{
+	constexpr uint32_t COUNT = 1000000;
+
+	::printf("  %u CPU(s), %u items per producer\n", std::thread::hardware_concurrency(), COUNT);
+
+	{
+		MutexQueue mutex_queue;
+		ov::SpscQueue<uint64_t> spsc_queue(1024);
+
+		auto mutex_throughput = MeasureThroughput(mutex_queue, 1, COUNT);
+		auto spsc_throughput = MeasureThroughput(spsc_queue, 1, COUNT);
+
+		::printf("  1 producer: ov::Queue %.2fM items/s, SpscQueue %.2fM items/s\n", mutex_throughput / 1000000.0, spsc_throughput / 1000000.0);
+	}
+
+	for (uint32_t producer_count : {1, 4, 8})
+	{
+		MutexQueue mutex_queue;
+		ov::MpscQueue<uint64_t> mpsc_queue(1024);
+
+		auto mutex_throughput = MeasureThroughput(mutex_queue, producer_count, COUNT / producer_count);
+		auto mpsc_throughput = MeasureThroughput(mpsc_queue, producer_count, COUNT / producer_count);
+
+		::printf("  %u producer(s): ov::Queue %.2fM items/s, MpscQueue %.2fM items/s\n", producer_count, mutex_throughput / 1000000.0, mpsc_throughput / 1000000.0);
+	}
+}
+
+int main()
+{
+	OV_TEST_RUN(TestSpscQueue);
+	OV_TEST_RUN(TestMpscQueueDropOldest);
+	OV_TEST_RUN(TestMpscQueueRejectNewest);
+	OV_TEST_RUN(TestSharedPtrIsReleased);
+	OV_TEST_RUN(TestDequeueTimeout);
+	OV_TEST_RUN(TestStopWakesConsumer);
+	OV_TEST_RUN(TestSpscQueueThreads);
+	OV_TEST_RUN(TestMpscQueueThreads);
+	OV_TEST_RUN(BenchQueues);
+
+	return 0;
+}
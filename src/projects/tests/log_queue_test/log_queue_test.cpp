@@ -0,0 +1,206 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <base/ovlibrary/log_internal.h>
+#include <base/ovlibrary/ovlibrary.h>
+#include <tests/test_common.h>
+
+#include <unistd.h>
+
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#define TEST_THREAD_COUNT (8)
+
+// The logs are written to the files of this directory
+static std::string _log_path;
+
+static std::vector<std::string> ReadLines(const std::string &file_name)
+{
+	std::ifstream stream(_log_path + "/" + file_name);
+	std::vector<std::string> line_list;
+	std::string line;
+
+	while (std::getline(stream, line))
+	{
+		line_list.push_back(line);
+	}
+
+	return line_list;
+}
+
+// Checks that the logs of each thread are written once and in order ("<thread index> <sequence>")
+static void VerifyLines(const std::vector<std::string> &line_list, int thread_count, int count_per_thread)
+{
+	std::vector<int> next_sequence_list(thread_count, 0);
+
+	for (auto &line : line_list)
+	{
+		int thread_index = -1;
+		int sequence = -1;
+
+		OV_TEST_ASSERT(::sscanf(line.c_str(), "%d %d", &thread_index, &sequence) == 2);
+		OV_TEST_ASSERT((thread_index >= 0) && (thread_index < thread_count));
+		OV_TEST_ASSERT(sequence == next_sequence_list[thread_index]);
+
+		next_sequence_list[thread_index]++;
+	}
+
+	for (auto next_sequence : next_sequence_list)
+	{
+		OV_TEST_ASSERT(next_sequence == count_per_thread);
+	}
+}
+
+static void TestNoLossUnderContention()
+{
+	// Less than the capacity of the queue of a thread, so no log is dropped even if the writer is slow
+	constexpr int COUNT_PER_THREAD = OV_LOG_QUEUE_SIZE / 2;
+	std::vector<std::thread> thread_list;
+
+	for (int thread_index = 0; thread_index < TEST_THREAD_COUNT; thread_index++)
+	{
+		thread_list.emplace_back([thread_index]() {
+			for (int sequence = 0; sequence < COUNT_PER_THREAD; sequence++)
+			{
+				stat_log(STAT_LOG_HLS_EDGE_REQUEST, "%d %d", thread_index, sequence);
+			}
+		});
+	}
+
+	for (auto &thread : thread_list)
+	{
+		thread.join();
+	}
+
+	// The logs of the terminated threads are also written
+	ov::LogQueue::GetInstance()->Flush();
+
+	VerifyLines(ReadLines(OV_STAT3_LOG_FILE), TEST_THREAD_COUNT, COUNT_PER_THREAD);
+}
+
+// Stalls the writer to fill the queue
+class StalledLogQueue : public ov::LogQueue
+{
+public:
+	std::mutex &GetDrainMutex()
+	{
+		return _drain_mutex;
+	}
+
+	uint64_t GetRejectedCountOfThread()
+	{
+		return GetThreadQueue()->queue.GetRejectedCount();
+	}
+};
+
+static void TestDropWhenFull()
+{
+	ov::LogInternal log_internal("log_queue_test.log");
+	log_internal.SetLogPath(_log_path.c_str());
+
+	// Never released, since the writer thread is detached
+	auto log_queue = new StalledLogQueue();
+	constexpr int COUNT = OV_LOG_QUEUE_SIZE + 1000;
+
+	uint64_t rejected_count = 0;
+
+	{
+		std::lock_guard<std::mutex> lock_guard(log_queue->GetDrainMutex());
+
+		// A new thread has its own queue (The queue of a thread is shared by all the LogQueues)
+		std::thread producer([&]() {
+			for (int sequence = 0; sequence < COUNT; sequence++)
+			{
+				ov::LogRecord record;
+
+				record.target = &log_internal;
+				record.level = OVLogLevelInformation;
+				record.log.Format("0 %d", sequence);
+
+				// The producer is never blocked, even if the writer is stalled
+				OV_TEST_ASSERT(log_queue->Push(std::move(record)));
+			}
+
+			rejected_count = log_queue->GetRejectedCountOfThread();
+		});
+
+		producer.join();
+	}
+
+	OV_TEST_ASSERT(rejected_count == COUNT - OV_LOG_QUEUE_SIZE);
+
+	// The newest logs are dropped, and the queued logs are written in order
+	log_queue->Flush();
+
+	VerifyLines(ReadLines("log_queue_test.log"), 1, OV_LOG_QUEUE_SIZE);
+}
+
+static void BenchLog()
+{
+	// Fits in the queue of a thread, so the latency of the callers does not include the dropped logs
+	constexpr int COUNT_PER_THREAD = OV_LOG_QUEUE_SIZE;
+
+	for (int thread_count : {1, 4, TEST_THREAD_COUNT, TEST_THREAD_COUNT * 4})
+	{
+		std::vector<double> elapsed_list(thread_count);
+		std::vector<std::thread> thread_list;
+
+		for (int thread_index = 0; thread_index < thread_count; thread_index++)
+		{
+			thread_list.emplace_back([thread_index, &elapsed_list]() {
+				elapsed_list[thread_index] = ov::test::MeasureMilliseconds([thread_index]() {
+					for (int sequence = 0; sequence < COUNT_PER_THREAD; sequence++)
+					{
+						stat_log(STAT_LOG_HLS_EDGE_REQUEST, "%d %d", thread_index, sequence);
+					}
+				});
+			});
+		}
+
+		for (auto &thread : thread_list)
+		{
+			thread.join();
+		}
+
+		auto flush_time = ov::test::MeasureMilliseconds([]() {
+			ov::LogQueue::GetInstance()->Flush();
+		});
+
+		double total_elapsed = 0.0;
+
+		for (auto elapsed : elapsed_list)
+		{
+			total_elapsed += elapsed;
+		}
+
+		::printf("  %d threads x %d logs: %.3fus per log (caller), flush %.2fms\n",
+				 thread_count, COUNT_PER_THREAD, (total_elapsed * 1000.0) / (thread_count * COUNT_PER_THREAD), flush_time);
+	}
+}
+
+int main()
+{
+	char path[] = "/tmp/log_queue_test_XXXXXX";
+
+	OV_TEST_ASSERT(::mkdtemp(path) != nullptr);
+	_log_path = path;
+
+	// The stat logs are written to the file only (not to the console)
+	ov_stat_log_set_path(STAT_LOG_HLS_EDGE_REQUEST, _log_path.c_str());
+
+	OV_TEST_RUN(TestNoLossUnderContention);
+	OV_TEST_RUN(TestDropWhenFull);
+	OV_TEST_RUN(BenchLog);
+
+	::unlink((_log_path + "/" OV_STAT3_LOG_FILE).c_str());
+	::unlink((_log_path + "/log_queue_test.log").c_str());
+	::rmdir(_log_path.c_str());
+
+	return 0;
+}
@@ -0,0 +1,282 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <providers/rtmp/chunk/rtmp_export_chunk.h>
+#include <providers/rtmp/chunk/rtmp_import_chunk.h>
+#include <tests/test_common.h>
+
+#include <functional>
+#include <random>
+
+#define TEST_CHUNK_SIZE (128)
+
+struct TestMessage
+{
+	uint32_t chunk_stream_id;
+	uint32_t timestamp;
+	uint8_t type_id;
+	uint32_t stream_id;
+	std::shared_ptr<std::vector<uint8_t>> payload;
+};
+
+static std::shared_ptr<std::vector<uint8_t>> MakePayload(size_t length, uint8_t seed)
+{
+	auto payload = std::make_shared<std::vector<uint8_t>>(length);
+
+	for (size_t index = 0; index < length; index++)
+	{
+		(*payload)[index] = static_cast<uint8_t>(seed + index * 7);
+	}
+
+	return payload;
+}
+
+// Video/audio messages of two chunk streams, which use all the types of the chunk headers
+static std::vector<TestMessage> MakeMessages(uint32_t base_timestamp, int count)
+{
+	std::vector<TestMessage> message_list;
+
+	for (int index = 0; index < count; index++)
+	{
+		// The size of the video varies (T1), the size of the audio is constant (T2), and a message larger than the chunk size continues with T3
+		message_list.push_back({8, base_timestamp + index * 33, 9, 1, MakePayload(100 + (index * 397) % 5000, index)});
+		message_list.push_back({6, base_timestamp + index * 21, 8, 1, MakePayload(200, index + 1)});
+	}
+
+	return message_list;
+}
+
+static std::vector<uint8_t> ExportMessages(const std::vector<TestMessage> &message_list)
+{
+	RtmpExportChunk export_chunk(true, TEST_CHUNK_SIZE);
+	std::vector<uint8_t> stream;
+
+	for (auto &message : message_list)
+	{
+		auto header = std::make_shared<RtmpMuxMessageHeader>(message.chunk_stream_id, message.timestamp, message.type_id, message.stream_id, message.payload->size());
+		auto payload = message.payload;
+		auto chunks = export_chunk.ExportStreamData(header, payload);
+
+		stream.insert(stream.end(), chunks->begin(), chunks->end());
+	}
+
+	return stream;
+}
+
+// Imports the stream in the pieces of next_split_size() bytes, and returns the messages
+static std::vector<std::shared_ptr<const RtmpMessage>> ImportMessages(const std::vector<uint8_t> &stream, const std::function<size_t()> &next_split_size)
+{
+	RtmpImportChunk import_chunk(TEST_CHUNK_SIZE);
+	std::vector<std::shared_ptr<const RtmpMessage>> message_list;
+
+	size_t offset = 0;
+
+	while (offset < stream.size())
+	{
+		auto length = std::min(next_split_size(), stream.size() - offset);
+		size_t consumed = 0;
+
+		// The receiver calls Import() until the received data is consumed
+		while (consumed < length)
+		{
+			bool is_completed = false;
+			int result = import_chunk.Import(stream.data() + offset + consumed, length - consumed, &is_completed);
+
+			OV_TEST_ASSERT(result > 0);
+			consumed += result;
+
+			if (is_completed)
+			{
+				while (import_chunk.GetMessageCount() > 0)
+				{
+					message_list.push_back(import_chunk.GetMessage());
+				}
+			}
+		}
+
+		offset += length;
+	}
+
+	return message_list;
+}
+
+static void VerifyMessages(const std::vector<TestMessage> &expected_list, const std::vector<std::shared_ptr<const RtmpMessage>> &message_list)
+{
+	OV_TEST_ASSERT(expected_list.size() == message_list.size());
+
+	for (size_t index = 0; index < expected_list.size(); index++)
+	{
+		auto &expected = expected_list[index];
+		auto &message = message_list[index];
+
+		OV_TEST_ASSERT(message->header->basic_header.stream_id == expected.chunk_stream_id);
+		OV_TEST_ASSERT(message->header->completed.timestamp == expected.timestamp);
+		OV_TEST_ASSERT(message->header->completed.type_id == expected.type_id);
+		OV_TEST_ASSERT(message->header->completed.stream_id == expected.stream_id);
+		OV_TEST_ASSERT(message->payload->GetLength() == expected.payload->size());
+		OV_TEST_ASSERT(::memcmp(message->payload->GetData(), expected.payload->data(), expected.payload->size()) == 0);
+	}
+}
+
+static void TestWholeStream()
+{
+	auto expected_list = MakeMessages(0, 50);
+	auto stream = ExportMessages(expected_list);
+
+	VerifyMessages(expected_list, ImportMessages(stream, [&stream]() -> size_t { return stream.size(); }));
+}
+
+static void TestByteByByte()
+{
+	// Every header and payload is split at every possible position
+	auto expected_list = MakeMessages(0, 20);
+	auto stream = ExportMessages(expected_list);
+
+	VerifyMessages(expected_list, ImportMessages(stream, []() -> size_t { return 1; }));
+}
+
+static void TestRandomSplit()
+{
+	auto expected_list = MakeMessages(1000, 200);
+	auto stream = ExportMessages(expected_list);
+
+	for (uint32_t seed = 0; seed < 20; seed++)
+	{
+		std::mt19937 random(seed);
+		std::uniform_int_distribution<size_t> distribution(1, 3000);
+
+		VerifyMessages(expected_list, ImportMessages(stream, [&]() -> size_t { return distribution(random); }));
+	}
+}
+
+static void TestExtendedTimestamp()
+{
+	// The timestamps over 0xFFFFFF are sent in the extended timestamp field (also in the T3 chunks)
+	auto expected_list = MakeMessages(RTMP_EXTEND_TIMESTAMP - 100, 10);
+	auto stream = ExportMessages(expected_list);
+
+	VerifyMessages(expected_list, ImportMessages(stream, []() -> size_t { return 7; }));
+}
+
+// Appends a message as chunks of the chunk stream (T0 + T3...) so that the test can interleave them
+static std::vector<std::vector<uint8_t>> MakeChunks(const TestMessage &message)
+{
+	std::vector<std::vector<uint8_t>> chunk_list;
+	auto &payload = *message.payload;
+
+	for (size_t offset = 0; offset < payload.size(); offset += TEST_CHUNK_SIZE)
+	{
+		std::vector<uint8_t> chunk;
+
+		if (offset == 0)
+		{
+			chunk = {
+				static_cast<uint8_t>(static_cast<uint8_t>(RtmpChunkType::T0) | message.chunk_stream_id),
+				static_cast<uint8_t>(message.timestamp >> 16), static_cast<uint8_t>(message.timestamp >> 8), static_cast<uint8_t>(message.timestamp),
+				static_cast<uint8_t>(payload.size() >> 16), static_cast<uint8_t>(payload.size() >> 8), static_cast<uint8_t>(payload.size()),
+				message.type_id,
+				// The message stream id is little endian
+				static_cast<uint8_t>(message.stream_id), static_cast<uint8_t>(message.stream_id >> 8), static_cast<uint8_t>(message.stream_id >> 16), static_cast<uint8_t>(message.stream_id >> 24)};
+		}
+		else
+		{
+			chunk = {static_cast<uint8_t>(static_cast<uint8_t>(RtmpChunkType::T3) | message.chunk_stream_id)};
+		}
+
+		auto length = std::min<size_t>(TEST_CHUNK_SIZE, payload.size() - offset);
+		chunk.insert(chunk.end(), payload.begin() + offset, payload.begin() + offset + length);
+
+		chunk_list.push_back(std::move(chunk));
+	}
+
+	return chunk_list;
+}
+
+static void TestInterleavedChunkStreams()
+{
+	TestMessage video{8, 1000, 9, 1, MakePayload(1000, 1)};
+	TestMessage audio{6, 1010, 8, 1, MakePayload(500, 2)};
+
+	auto video_chunks = MakeChunks(video);
+	auto audio_chunks = MakeChunks(audio);
+
+	// The chunks of the audio are sent between the chunks of the video
+	std::vector<uint8_t> stream;
+
+	for (size_t index = 0; index < std::max(video_chunks.size(), audio_chunks.size()); index++)
+	{
+		if (index < video_chunks.size())
+		{
+			stream.insert(stream.end(), video_chunks[index].begin(), video_chunks[index].end());
+		}
+
+		if (index < audio_chunks.size())
+		{
+			stream.insert(stream.end(), audio_chunks[index].begin(), audio_chunks[index].end());
+		}
+	}
+
+	// The audio is completed first, since it has fewer chunks
+	VerifyMessages({audio, video}, ImportMessages(stream, []() -> size_t { return 13; }));
+}
+
+static void TestHeaderAtEndOfData()
+{
+	// An empty message is completed by the header, even if no more data follows the header
+	TestMessage message{8, 1000, 9, 1, MakePayload(0, 0)};
+
+	std::vector<uint8_t> stream = {
+		static_cast<uint8_t>(static_cast<uint8_t>(RtmpChunkType::T0) | message.chunk_stream_id),
+		0x00, 0x03, 0xE8,
+		0x00, 0x00, 0x00,
+		message.type_id,
+		0x01, 0x00, 0x00, 0x00};
+
+	RtmpImportChunk import_chunk(TEST_CHUNK_SIZE);
+	bool is_completed = false;
+
+	OV_TEST_ASSERT(import_chunk.Import(stream.data(), stream.size(), &is_completed) == static_cast<int>(stream.size()));
+	OV_TEST_ASSERT(is_completed);
+	OV_TEST_ASSERT(import_chunk.GetMessageCount() == 1);
+
+	VerifyMessages({message}, {import_chunk.GetMessage()});
+}
+
+static void BenchImport()
+{
+	std::vector<TestMessage> message_list;
+
+	for (int index = 0; index < 2000; index++)
+	{
+		message_list.push_back({8, static_cast<uint32_t>(index * 33), 9, 1, MakePayload((index % 30 == 0) ? 100000 : 8000, index)});
+	}
+
+	auto stream = ExportMessages(message_list);
+	size_t message_count = 0;
+
+	auto elapsed = ov::test::MeasureMilliseconds([&]() {
+		// Typical size of a recv() of a TCP socket
+		message_count = ImportMessages(stream, []() -> size_t { return 1460; }).size();
+	});
+
+	OV_TEST_ASSERT(message_count == message_list.size());
+
+	::printf("  %zu bytes (%zu messages) in %.2fms: %.2f MB/s\n", stream.size(), message_count, elapsed, (stream.size() / (1024.0 * 1024.0)) / (elapsed / 1000.0));
+}
+
+int main()
+{
+	OV_TEST_RUN(TestWholeStream);
+	OV_TEST_RUN(TestByteByByte);
+	OV_TEST_RUN(TestRandomSplit);
+	OV_TEST_RUN(TestExtendedTimestamp);
+	OV_TEST_RUN(TestInterleavedChunkStreams);
+	OV_TEST_RUN(TestHeaderAtEndOfData);
+	OV_TEST_RUN(BenchImport);
+
+	return 0;
+}
@@ -0,0 +1,377 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <providers/rtsp/rtp/rtp_jitter_buffer.h>
+#include <tests/test_common.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <random>
+
+#define TEST_CLOCK_FREQUENCY (90000)
+#define TEST_SSRC (0x12345678)
+
+using Clock = RtpJitterBuffer::Clock;
+using Packet = RtpJitterBuffer::Packet;
+
+// The index of the packet is stored in the payload, to identify the packet regardless of the wraparound
+static Packet MakePacket(uint16_t sequence_number, uint32_t timestamp, bool marker, uint32_t index, uint32_t ssrc = TEST_SSRC)
+{
+	return std::make_shared<std::vector<uint8_t>>(std::vector<uint8_t>{
+		0x80, static_cast<uint8_t>((marker ? 0x80 : 0x00) | 96),
+		static_cast<uint8_t>(sequence_number >> 8), static_cast<uint8_t>(sequence_number),
+		static_cast<uint8_t>(timestamp >> 24), static_cast<uint8_t>(timestamp >> 16), static_cast<uint8_t>(timestamp >> 8), static_cast<uint8_t>(timestamp),
+		static_cast<uint8_t>(ssrc >> 24), static_cast<uint8_t>(ssrc >> 16), static_cast<uint8_t>(ssrc >> 8), static_cast<uint8_t>(ssrc),
+		static_cast<uint8_t>(index >> 24), static_cast<uint8_t>(index >> 16), static_cast<uint8_t>(index >> 8), static_cast<uint8_t>(index)});
+}
+
+static uint32_t GetIndex(const Packet &packet)
+{
+	auto &data = *packet;
+
+	return (data[12] << 24) | (data[13] << 16) | (data[14] << 8) | data[15];
+}
+
+static std::vector<uint32_t> GetIndexList(const std::vector<Packet> &packet_list)
+{
+	std::vector<uint32_t> index_list;
+
+	for (auto &packet : packet_list)
+	{
+		index_list.push_back(GetIndex(packet));
+	}
+
+	return index_list;
+}
+
+// Adds the packets of the indices (sequence number = base + index) at the same time
+// They have the same timestamp, so the jitter is 0 and the target delay is min_delay_msec
+static std::vector<uint32_t> AddPackets(RtpJitterBuffer &jitter_buffer, uint16_t base_sequence_number, const std::vector<uint32_t> &index_list, Clock::time_point arrival_time)
+{
+	std::vector<Packet> released_packets;
+
+	for (auto index : index_list)
+	{
+		jitter_buffer.AddPacket(MakePacket(static_cast<uint16_t>(base_sequence_number + index), 0, true, index), arrival_time, released_packets);
+	}
+
+	return GetIndexList(released_packets);
+}
+
+static std::vector<uint32_t> Flush(RtpJitterBuffer &jitter_buffer, Clock::time_point now)
+{
+	std::vector<Packet> released_packets;
+
+	jitter_buffer.Flush(now, released_packets);
+
+	return GetIndexList(released_packets);
+}
+
+static void TestInOrder()
+{
+	RtpJitterBuffer jitter_buffer(TEST_CLOCK_FREQUENCY, true);
+	auto now = Clock::now();
+
+	// The packets in order are released immediately
+	OV_TEST_ASSERT(AddPackets(jitter_buffer, 1000, {0, 1, 2, 3}, now) == std::vector<uint32_t>({0, 1, 2, 3}));
+
+	auto &statistics = jitter_buffer.GetStatistics();
+
+	OV_TEST_ASSERT(statistics.received_packets_ == 4);
+	OV_TEST_ASSERT(statistics.lost_packets_ == 0);
+	OV_TEST_ASSERT(statistics.reordered_packets_ == 0);
+	OV_TEST_ASSERT(statistics.target_delay_msec_ == RtpJitterBuffer::min_delay_msec);
+}
+
+static void TestReorder()
+{
+	RtpJitterBuffer jitter_buffer(TEST_CLOCK_FREQUENCY, true);
+	auto now = Clock::now();
+
+	OV_TEST_ASSERT(AddPackets(jitter_buffer, 1000, {0, 2, 3}, now) == std::vector<uint32_t>({0}));
+	// The missing packet arrives within the target delay
+	OV_TEST_ASSERT(AddPackets(jitter_buffer, 1000, {1}, now + std::chrono::milliseconds(5)) == std::vector<uint32_t>({1, 2, 3}));
+
+	auto &statistics = jitter_buffer.GetStatistics();
+
+	OV_TEST_ASSERT(statistics.reordered_packets_ == 1);
+	OV_TEST_ASSERT(statistics.lost_packets_ == 0);
+}
+
+static void TestDuplicate()
+{
+	RtpJitterBuffer jitter_buffer(TEST_CLOCK_FREQUENCY, true);
+	auto now = Clock::now();
+
+	// Duplicate of a released packet (late), and of a waiting packet
+	OV_TEST_ASSERT(AddPackets(jitter_buffer, 1000, {0, 0, 2, 2}, now) == std::vector<uint32_t>({0}));
+	OV_TEST_ASSERT(AddPackets(jitter_buffer, 1000, {1}, now) == std::vector<uint32_t>({1, 2}));
+
+	auto &statistics = jitter_buffer.GetStatistics();
+
+	OV_TEST_ASSERT(statistics.late_packets_ == 1);
+	OV_TEST_ASSERT(statistics.duplicated_packets_ == 1);
+}
+
+static void TestLossTimeout()
+{
+	RtpJitterBuffer jitter_buffer(TEST_CLOCK_FREQUENCY, false);
+	auto now = Clock::now();
+
+	OV_TEST_ASSERT(AddPackets(jitter_buffer, 1000, {0, 1, 3, 4}, now) == std::vector<uint32_t>({0, 1}));
+
+	// The packets after the missing one wait for the target delay, even if no packet arrives
+	OV_TEST_ASSERT(Flush(jitter_buffer, now + std::chrono::milliseconds(RtpJitterBuffer::min_delay_msec - 1)).empty());
+	OV_TEST_ASSERT(Flush(jitter_buffer, now + std::chrono::milliseconds(RtpJitterBuffer::min_delay_msec)) == std::vector<uint32_t>({3, 4}));
+
+	// The lost packet arrives too late
+	OV_TEST_ASSERT(AddPackets(jitter_buffer, 1000, {2}, now + std::chrono::milliseconds(100)).empty());
+
+	auto &statistics = jitter_buffer.GetStatistics();
+
+	OV_TEST_ASSERT(statistics.lost_packets_ == 1);
+	OV_TEST_ASSERT(statistics.late_packets_ == 1);
+	OV_TEST_ASSERT(statistics.discarded_packets_ == 0);
+}
+
+static void TestDiscardIncompleteFrame()
+{
+	RtpJitterBuffer jitter_buffer(TEST_CLOCK_FREQUENCY, true);
+	auto now = Clock::now();
+	std::vector<Packet> released_packets;
+
+	// Frame 0: 0-2, Frame 1: 3-5 (4 is lost), Frame 2: 6-8
+	for (uint32_t index = 0; index < 9; index++)
+	{
+		if (index != 4)
+		{
+			jitter_buffer.AddPacket(MakePacket(static_cast<uint16_t>(65530 + index), (index / 3) * 3000, (index % 3) == 2, index), now, released_packets);
+		}
+	}
+
+	OV_TEST_ASSERT(GetIndexList(released_packets) == std::vector<uint32_t>({0, 1, 2, 3}));
+
+	// The rest of the damaged frame is discarded up to the marker, and the next frame is released
+	// (The sequence numbers wrap around in the middle of the frames)
+	OV_TEST_ASSERT(Flush(jitter_buffer, now + std::chrono::milliseconds(RtpJitterBuffer::max_delay_msec)) == std::vector<uint32_t>({6, 7, 8}));
+
+	auto &statistics = jitter_buffer.GetStatistics();
+
+	OV_TEST_ASSERT(statistics.lost_packets_ == 1);
+	OV_TEST_ASSERT(statistics.discarded_packets_ == 1);
+}
+
+static void TestWraparound()
+{
+	RtpJitterBuffer jitter_buffer(TEST_CLOCK_FREQUENCY, true);
+	auto now = Clock::now();
+
+	// 65534, 65535, 0, 1, ... (reordered across the wraparound)
+	OV_TEST_ASSERT(AddPackets(jitter_buffer, 65534, {0, 1, 3, 2, 4}, now) == std::vector<uint32_t>({0, 1, 2, 3, 4}));
+
+	auto &statistics = jitter_buffer.GetStatistics();
+
+	OV_TEST_ASSERT(statistics.lost_packets_ == 0);
+	OV_TEST_ASSERT(statistics.reordered_packets_ == 1);
+}
+
+static void TestRestart()
+{
+	RtpJitterBuffer jitter_buffer(TEST_CLOCK_FREQUENCY, false);
+	auto now = Clock::now();
+	std::vector<Packet> released_packets;
+
+	OV_TEST_ASSERT(AddPackets(jitter_buffer, 1000, {0, 2}, now) == std::vector<uint32_t>({0}));
+
+	// The packets of the previous SSRC are released before the packets of the new one
+	jitter_buffer.AddPacket(MakePacket(5000, 0, true, 100, TEST_SSRC + 1), now, released_packets);
+	OV_TEST_ASSERT(GetIndexList(released_packets) == std::vector<uint32_t>({2, 100}));
+
+	// A jump larger than max_dropout is regarded as the restart of the sender
+	released_packets.clear();
+	jitter_buffer.AddPacket(MakePacket(5000 + RtpJitterBuffer::max_dropout + 1, 0, true, 101, TEST_SSRC + 1), now, released_packets);
+	OV_TEST_ASSERT(GetIndexList(released_packets) == std::vector<uint32_t>({101}));
+}
+
+static void TestMaxPackets()
+{
+	RtpJitterBuffer jitter_buffer(TEST_CLOCK_FREQUENCY, false);
+	auto now = Clock::now();
+	std::vector<uint32_t> index_list;
+
+	// The packet 1 is missing
+	for (uint32_t index = 2; index <= RtpJitterBuffer::max_packets; index++)
+	{
+		index_list.push_back(index);
+	}
+
+	OV_TEST_ASSERT(AddPackets(jitter_buffer, 1000, {0}, now).size() == 1);
+	OV_TEST_ASSERT(AddPackets(jitter_buffer, 1000, index_list, now).empty());
+
+	// Too many packets are waiting for the missing one, so they are released without waiting for the target delay
+	OV_TEST_ASSERT(AddPackets(jitter_buffer, 1000, {static_cast<uint32_t>(RtpJitterBuffer::max_packets + 1)}, now).size() == RtpJitterBuffer::max_packets);
+	OV_TEST_ASSERT(jitter_buffer.GetStatistics().lost_packets_ == 1);
+}
+
+static void TestJitter()
+{
+	RtpJitterBuffer jitter_buffer(TEST_CLOCK_FREQUENCY, false);
+	auto now = Clock::now();
+	std::vector<Packet> released_packets;
+
+	// The packets arrive at the interval of the timestamps
+	for (uint32_t index = 0; index < 100; index++)
+	{
+		jitter_buffer.AddPacket(MakePacket(index, index * 3000, true, index), now + std::chrono::microseconds(index * 33333), released_packets);
+	}
+
+	OV_TEST_ASSERT(jitter_buffer.GetStatistics().jitter_msec_ < 1.0);
+	OV_TEST_ASSERT(jitter_buffer.GetStatistics().target_delay_msec_ == RtpJitterBuffer::min_delay_msec);
+
+	// The packets arrive in bursts, so the target delay grows up to the limit
+	for (uint32_t index = 100; index < 200; index++)
+	{
+		auto arrival_time = now + std::chrono::milliseconds((index / 10) * 2000);
+
+		jitter_buffer.AddPacket(MakePacket(index, index * 3000, true, index), arrival_time, released_packets);
+	}
+
+	OV_TEST_ASSERT(jitter_buffer.GetStatistics().jitter_msec_ > 100.0);
+	OV_TEST_ASSERT(jitter_buffer.GetStatistics().target_delay_msec_ == RtpJitterBuffer::max_delay_msec);
+	OV_TEST_ASSERT(released_packets.size() == 200);
+}
+
+// Replays a stream through a network that delays, reorders, loses and duplicates the packets
+static void TestReplay()
+{
+	constexpr uint32_t FRAME_COUNT = 3000;
+	constexpr uint32_t PACKETS_PER_FRAME = 5;
+	constexpr uint32_t PACKET_COUNT = FRAME_COUNT * PACKETS_PER_FRAME;
+
+	for (uint32_t seed = 0; seed < 20; seed++)
+	{
+		std::mt19937 random(seed);
+		std::uniform_int_distribution<int> percent(0, 99);
+		std::uniform_int_distribution<int> network_delay(5000, 5000 + static_cast<int>(seed) * 3000);
+
+		struct Arrival
+		{
+			int64_t arrival_usec;
+			uint32_t index;
+		};
+
+		std::vector<Arrival> arrival_list;
+		std::vector<bool> is_lost_list(PACKET_COUNT, false);
+
+		for (uint32_t index = 0; index < PACKET_COUNT; index++)
+		{
+			// 30fps, the packets of a frame are sent in a burst
+			int64_t send_usec = (index / PACKETS_PER_FRAME) * 33333 + (index % PACKETS_PER_FRAME) * 100;
+
+			// The first and the last packets are always received, so every loss is detected
+			if ((index > 0) && (index < PACKET_COUNT - 1) && (percent(random) < 2))
+			{
+				is_lost_list[index] = true;
+				continue;
+			}
+
+			// The first packet arrives first, since it decides the base of the sequence numbers
+			arrival_list.push_back({send_usec + ((index == 0) ? 5000 : network_delay(random)), index});
+
+			if ((index > 0) && (percent(random) < 1))
+			{
+				arrival_list.push_back({send_usec + network_delay(random), index});
+			}
+		}
+
+		std::stable_sort(arrival_list.begin(), arrival_list.end(), [](const Arrival &arrival1, const Arrival &arrival2) -> bool {
+			return arrival1.arrival_usec < arrival2.arrival_usec;
+		});
+
+		RtpJitterBuffer jitter_buffer(TEST_CLOCK_FREQUENCY, true);
+		auto base_time = Clock::now();
+		std::vector<Packet> released_packets;
+		int64_t next_flush_usec = 0;
+
+		for (auto &arrival : arrival_list)
+		{
+			// The owner flushes the buffer every 10ms
+			for (; next_flush_usec < arrival.arrival_usec; next_flush_usec += 10000)
+			{
+				jitter_buffer.Flush(base_time + std::chrono::microseconds(next_flush_usec), released_packets);
+			}
+
+			auto index = arrival.index;
+			// The sequence numbers wrap around several times
+			auto packet = MakePacket(static_cast<uint16_t>(60000 + index), (index / PACKETS_PER_FRAME) * 3000, (index % PACKETS_PER_FRAME) == (PACKETS_PER_FRAME - 1), index);
+
+			jitter_buffer.AddPacket(packet, base_time + std::chrono::microseconds(arrival.arrival_usec), released_packets);
+		}
+
+		jitter_buffer.Flush(base_time + std::chrono::microseconds(next_flush_usec) + std::chrono::seconds(10), released_packets);
+
+		auto index_list = GetIndexList(released_packets);
+		auto &statistics = jitter_buffer.GetStatistics();
+
+		// Released in order, once
+		for (size_t position = 1; position < index_list.size(); position++)
+		{
+			OV_TEST_ASSERT(index_list[position - 1] < index_list[position]);
+		}
+
+		// A released packet is never after a lost packet of the same frame
+		std::vector<bool> is_released_list(PACKET_COUNT, false);
+
+		for (auto index : index_list)
+		{
+			is_released_list[index] = true;
+		}
+
+		for (auto index : index_list)
+		{
+			for (auto previous = index - (index % PACKETS_PER_FRAME); previous < index; previous++)
+			{
+				OV_TEST_ASSERT(is_released_list[previous]);
+			}
+		}
+
+		// Every received packet is released, discarded, too late or duplicated
+		OV_TEST_ASSERT(statistics.received_packets_ == arrival_list.size());
+		OV_TEST_ASSERT(statistics.received_packets_ == index_list.size() + statistics.discarded_packets_ + statistics.late_packets_ + statistics.duplicated_packets_);
+
+		// Every sequence number is released, discarded or counted as lost (a lost packet may arrive later)
+		uint64_t lost_count = std::count(is_lost_list.begin(), is_lost_list.end(), true);
+
+		OV_TEST_ASSERT(index_list.size() + statistics.discarded_packets_ + statistics.lost_packets_ == PACKET_COUNT);
+		OV_TEST_ASSERT(statistics.lost_packets_ >= lost_count);
+		OV_TEST_ASSERT(statistics.lost_packets_ - lost_count <= statistics.late_packets_);
+
+		if (seed % 5 == 0)
+		{
+			::printf("  max network delay %5.1fms: lost %4" PRIu64 ", late %3" PRIu64 ", reordered %5" PRIu64 ", discarded %4" PRIu64 ", jitter %6.2fms, target delay %3ums\n",
+					 (5000 + seed * 3000) / 1000.0,
+					 statistics.lost_packets_, statistics.late_packets_, statistics.reordered_packets_, statistics.discarded_packets_,
+					 statistics.jitter_msec_, statistics.target_delay_msec_);
+		}
+	}
+}
+
+int main()
+{
+	OV_TEST_RUN(TestInOrder);
+	OV_TEST_RUN(TestReorder);
+	OV_TEST_RUN(TestDuplicate);
+	OV_TEST_RUN(TestLossTimeout);
+	OV_TEST_RUN(TestDiscardIncompleteFrame);
+	OV_TEST_RUN(TestWraparound);
+	OV_TEST_RUN(TestRestart);
+	OV_TEST_RUN(TestMaxPackets);
+	OV_TEST_RUN(TestJitter);
+	OV_TEST_RUN(TestReplay);
+
+	return 0;
+}
@@ -0,0 +1,585 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <modules/rtp_rtcp/rtp_bandwidth_estimator.h>
+#include <modules/rtp_rtcp/rtp_pacer.h>
+#include <tests/test_common.h>
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <vector>
+
+#define PACKET_SIZE (1200)
+// Interval of the transport-wide feedback of the receiver
+#define FEEDBACK_INTERVAL_US (50 * 1000)
+// Interval of RtpPacerScheduler
+#define PACER_INTERVAL_US (5 * 1000)
+// The clock of the receiver is not the clock of the sender
+#define RECEIVER_CLOCK_OFFSET_US (123456789)
+
+static std::shared_ptr<const ov::Data> MakePacket(size_t size)
+{
+	auto packet = std::make_shared<ov::Data>(size);
+	packet->SetLength(size);
+
+	return packet;
+}
+
+// A bottleneck: a drop-tail queue that is drained at the capacity, a propagation delay and random losses
+class SimulatedLink
+{
+public:
+	SimulatedLink(uint32_t capacity, int64_t propagation_delay_us, size_t buffer_bytes, double loss_ratio)
+		: _capacity(capacity),
+		  _propagation_delay_us(propagation_delay_us),
+		  _buffer_bytes(buffer_bytes),
+		  _loss_ratio(loss_ratio),
+		  _random(1)
+	{
+	}
+
+	// Returns the arrival time of the packet (the clock of the sender), or -1 if it is lost
+	int64_t Send(size_t size, int64_t send_time_us)
+	{
+		_sent_count++;
+
+		int64_t queue_time_us = std::max<int64_t>(_free_time_us - send_time_us, 0);
+		auto queued_bytes = static_cast<size_t>(queue_time_us * _capacity / 8 / 1000000);
+
+		if (queued_bytes + size > _buffer_bytes)
+		{
+			_overflow_count++;
+			return -1;
+		}
+
+		_free_time_us = std::max(_free_time_us, send_time_us) + static_cast<int64_t>(size * 8 * 1000000 / _capacity);
+		_queue_delay_sum_us += _free_time_us - send_time_us;
+		_queue_delay_count++;
+
+		if (std::uniform_real_distribution<double>(0.0, 1.0)(_random) < _loss_ratio)
+		{
+			_random_loss_count++;
+			return -1;
+		}
+
+		return _free_time_us + _propagation_delay_us;
+	}
+
+	// Only the packets from now on are counted
+	void ResetStatistics()
+	{
+		_sent_count = 0;
+		_overflow_count = 0;
+		_random_loss_count = 0;
+		_queue_delay_sum_us = 0;
+		_queue_delay_count = 0;
+	}
+
+	double GetOverflowPercent() const
+	{
+		return (_sent_count > 0) ? (_overflow_count * 100.0 / _sent_count) : 0.0;
+	}
+
+	// Time in the queue, including the transmission
+	double GetAverageQueueDelayMs() const
+	{
+		return (_queue_delay_count > 0) ? (_queue_delay_sum_us / 1000.0 / _queue_delay_count) : 0.0;
+	}
+
+	int64_t GetPropagationDelayUs() const
+	{
+		return _propagation_delay_us;
+	}
+
+private:
+	uint32_t _capacity;
+	int64_t _propagation_delay_us;
+	size_t _buffer_bytes;
+	double _loss_ratio;
+	std::mt19937 _random;
+
+	// The time when the last queued packet leaves the link
+	int64_t _free_time_us = 0;
+
+	size_t _sent_count = 0;
+	size_t _overflow_count = 0;
+	size_t _random_loss_count = 0;
+	int64_t _queue_delay_sum_us = 0;
+	size_t _queue_delay_count = 0;
+};
+
+// Sends the packets through the link, and makes the transport-wide feedback of the receiver
+class SimulatedSession
+{
+public:
+	SimulatedSession(SimulatedLink &link, uint32_t initial_bitrate)
+		: _link(link),
+		  _estimator(initial_bitrate, 100000, 20000000)
+	{
+	}
+
+	void Send(size_t size, int64_t now_us)
+	{
+		auto arrival_time_us = _link.Send(size, now_us);
+
+		_estimator.OnPacketSent(_sequence_number, size, now_us);
+		_in_flight.push_back({_sequence_number, arrival_time_us});
+
+		_sequence_number++;
+	}
+
+	// The link is FIFO, so the packets are reported in order: the lost packets are reported with the next arrived one
+	void SendFeedback(int64_t now_us)
+	{
+		RtcpTransportFeedback feedback;
+
+		while (_in_flight.empty() == false)
+		{
+			auto &packet = _in_flight.front();
+
+			if ((packet.arrival_time_us >= 0) && (packet.arrival_time_us + _link.GetPropagationDelayUs() > now_us))
+			{
+				// The feedback of this packet is not received yet
+				break;
+			}
+
+			RtcpTransportFeedback::PacketResult result;
+
+			result.sequence_number = packet.sequence_number;
+			result.received = (packet.arrival_time_us >= 0);
+			result.arrival_time_us = result.received ? (packet.arrival_time_us + RECEIVER_CLOCK_OFFSET_US) : 0;
+
+			feedback.packet_results.push_back(result);
+			_in_flight.pop_front();
+		}
+
+		if (feedback.packet_results.empty() == false)
+		{
+			_estimator.OnTransportFeedback(feedback, now_us);
+		}
+	}
+
+	uint32_t GetEstimatedBitrate() const
+	{
+		return _estimator.GetEstimatedBitrate();
+	}
+
+private:
+	struct InFlightPacket
+	{
+		uint16_t sequence_number;
+		int64_t arrival_time_us;
+	};
+
+	SimulatedLink &_link;
+	RtpBandwidthEstimator _estimator;
+
+	uint16_t _sequence_number = 0;
+	std::deque<InFlightPacket> _in_flight;
+};
+
+struct AdaptiveResult
+{
+	// Time until the estimate reaches 80% of the capacity (-1 if it never does)
+	double convergence_seconds = -1.0;
+	// Over the second half of the simulation
+	double average_estimate = 0.0;
+	double average_queue_delay_ms = 0.0;
+	double overflow_percent = 0.0;
+	uint32_t final_estimate = 0;
+};
+
+// A sender that sends as much as the estimate (as an encoder that follows the estimate would)
+static AdaptiveResult RunAdaptiveSession(uint32_t capacity, double loss_ratio, uint32_t initial_bitrate, int seconds)
+{
+	// 100ms of the buffer
+	SimulatedLink link(capacity, 20 * 1000, capacity / 8 / 10, loss_ratio);
+	SimulatedSession session(link, initial_bitrate);
+	AdaptiveResult result;
+
+	int64_t end_time_us = seconds * 1000000LL;
+	int64_t next_send_time_us = 0;
+	double estimate_sum = 0.0;
+	int estimate_count = 0;
+
+	for (int64_t now_us = 0; now_us < end_time_us; now_us += 1000)
+	{
+		if (now_us == end_time_us / 2)
+		{
+			link.ResetStatistics();
+		}
+
+		while (next_send_time_us <= now_us)
+		{
+			session.Send(PACKET_SIZE, next_send_time_us);
+			next_send_time_us += PACKET_SIZE * 8 * 1000000LL / session.GetEstimatedBitrate();
+		}
+
+		if ((now_us % FEEDBACK_INTERVAL_US) == 0)
+		{
+			session.SendFeedback(now_us);
+
+			auto estimate = session.GetEstimatedBitrate();
+
+			if ((result.convergence_seconds < 0.0) && (estimate >= capacity * 0.8))
+			{
+				result.convergence_seconds = now_us / 1000000.0;
+			}
+
+			if (now_us >= end_time_us / 2)
+			{
+				estimate_sum += estimate;
+				estimate_count++;
+			}
+		}
+	}
+
+	result.average_estimate = estimate_sum / estimate_count;
+	result.average_queue_delay_ms = link.GetAverageQueueDelayMs();
+	result.overflow_percent = link.GetOverflowPercent();
+	result.final_estimate = session.GetEstimatedBitrate();
+
+	return result;
+}
+
+struct KeyFrameResult
+{
+	double overflow_percent = 0.0;
+	double average_queue_delay_ms = 0.0;
+};
+
+// A video of 30 fps with a key frame every 2 seconds (10 times of a delta frame) over a 2 Mbps link with 120ms of the buffer
+static KeyFrameResult RunKeyFrameSession(bool with_pacer, int seconds)
+{
+	constexpr uint32_t CAPACITY = 2000000;
+	constexpr size_t DELTA_FRAME_SIZE = 4000;
+	constexpr size_t KEY_FRAME_SIZE = 40000;
+
+	SimulatedLink link(CAPACITY, 20 * 1000, CAPACITY / 8 * 120 / 1000, 0.0);
+	SimulatedSession session(link, 1000000);
+	RtpPacer pacer(1000000, 100000);
+
+	auto send_paced_packets = [&](int64_t now_us) {
+		while (auto packet = pacer.Pop(now_us))
+		{
+			session.Send(packet->GetLength(), now_us);
+		}
+	};
+
+	int64_t end_time_us = seconds * 1000000LL;
+	int frame_index = 0;
+
+	for (int64_t now_us = 0; now_us < end_time_us; now_us += 1000)
+	{
+		if (now_us >= frame_index * 1000000LL / 30)
+		{
+			size_t frame_size = ((frame_index % 60) == 0) ? KEY_FRAME_SIZE : DELTA_FRAME_SIZE;
+
+			for (size_t offset = 0; offset < frame_size; offset += PACKET_SIZE)
+			{
+				auto size = std::min<size_t>(PACKET_SIZE, frame_size - offset);
+
+				if (with_pacer)
+				{
+					pacer.Push(MakePacket(size), now_us);
+				}
+				else
+				{
+					session.Send(size, now_us);
+				}
+			}
+
+			// The packets are sent by the thread that pushes them as much as the budget allows
+			send_paced_packets(now_us);
+
+			frame_index++;
+		}
+
+		if ((now_us % PACER_INTERVAL_US) == 0)
+		{
+			send_paced_packets(now_us);
+		}
+
+		if ((now_us % FEEDBACK_INTERVAL_US) == 0)
+		{
+			session.SendFeedback(now_us);
+			pacer.SetEstimatedBitrate(session.GetEstimatedBitrate());
+		}
+	}
+
+	return {link.GetOverflowPercent(), link.GetAverageQueueDelayMs()};
+}
+
+static void TestPacerBurst()
+{
+	// 1 Mbps * 2.5 = 312.5 bytes/ms
+	RtpPacer pacer(1000000, 100000);
+	OV_TEST_ASSERT(pacer.GetPacingRate() == 2500000);
+
+	for (int index = 0; index < 100; index++)
+	{
+		pacer.Push(MakePacket(1000), 0);
+	}
+
+	OV_TEST_ASSERT(pacer.GetQueuedBytes() == 100000);
+
+	// Only the first burst (3000 bytes) is sent at once
+	int count = 0;
+
+	while (pacer.Pop(0) != nullptr)
+	{
+		count++;
+	}
+
+	OV_TEST_ASSERT(count == 3);
+
+	// The rest is drained at the pacing rate: 97000 bytes in 310ms
+	int64_t now_us = 0;
+
+	while (pacer.IsEmpty() == false)
+	{
+		now_us += 1000;
+
+		while (pacer.Pop(now_us) != nullptr)
+		{
+		}
+	}
+
+	OV_TEST_ASSERT((now_us >= 300 * 1000) && (now_us <= 320 * 1000));
+	OV_TEST_ASSERT(pacer.GetQueuedBytes() == 0);
+}
+
+static void TestPacerRate()
+{
+	RtpPacer pacer(1000000, 200000);
+
+	// The estimate lowers the rate, but not below the minimum bitrate
+	pacer.SetEstimatedBitrate(400000);
+	OV_TEST_ASSERT(pacer.GetPacingRate() == 1000000);
+
+	pacer.SetEstimatedBitrate(10000);
+	OV_TEST_ASSERT(pacer.GetPacingRate() == 500000);
+
+	// ... nor below the bitrate of the media (2 Mbps for a second)
+	for (int64_t now_us = 0; now_us <= 1000000; now_us += 4000)
+	{
+		pacer.Push(MakePacket(1000), now_us);
+
+		while (pacer.Pop(now_us) != nullptr)
+		{
+		}
+	}
+
+	OV_TEST_ASSERT((pacer.GetPacingRate() >= 1990000) && (pacer.GetPacingRate() <= 2010000));
+}
+
+static void TestPacerMaxQueueTime()
+{
+	// 25 kbps: 20000 bytes would take more than 5 seconds
+	RtpPacer pacer(10000, 10000);
+
+	for (int index = 0; index < 20; index++)
+	{
+		pacer.Push(MakePacket(1000), 0);
+	}
+
+	for (int64_t now_us = 0; now_us < 500 * 1000; now_us += 1000)
+	{
+		while (pacer.Pop(now_us) != nullptr)
+		{
+		}
+	}
+
+	OV_TEST_ASSERT(pacer.IsEmpty() == false);
+
+	// The packets that have waited for 500ms are sent regardless of the budget
+	while (pacer.Pop(500 * 1000) != nullptr)
+	{
+	}
+
+	OV_TEST_ASSERT(pacer.IsEmpty());
+}
+
+static void TestPacerConsume()
+{
+	RtpPacer pacer(1000000, 100000);
+
+	// Retransmissions take the first burst (3000 bytes) and 3000 bytes more
+	pacer.Consume(6000, 0);
+	pacer.Push(MakePacket(1000), 0);
+
+	OV_TEST_ASSERT(pacer.Pop(0) == nullptr);
+	OV_TEST_ASSERT(pacer.Pop(5000) == nullptr);
+	// 312.5 bytes/ms
+	OV_TEST_ASSERT(pacer.Pop(10000) != nullptr);
+}
+
+static void TestEstimatorUnknownPackets()
+{
+	RtpBandwidthEstimator estimator(1000000, 100000, 10000000);
+	RtcpTransportFeedback feedback;
+
+	estimator.OnPacketSent(1, PACKET_SIZE, 0);
+
+	// Packets that are not sent, and a packet that is sent 4096 packets before (overwritten in the history)
+	for (uint16_t sequence_number : {2, 3, 4097})
+	{
+		feedback.packet_results.push_back({sequence_number, true, 1000});
+	}
+
+	OV_TEST_ASSERT(estimator.OnTransportFeedback(feedback, 1000) == false);
+	OV_TEST_ASSERT(estimator.GetEstimatedBitrate() == 1000000);
+}
+
+static void TestEstimatorUnderusedLink()
+{
+	// 8% per second for 10 seconds
+	auto result = RunAdaptiveSession(10000000, 0.0, 300000, 10);
+
+	OV_TEST_ASSERT(result.final_estimate > 550000);
+	OV_TEST_ASSERT(result.overflow_percent == 0.0);
+}
+
+static void TestEstimatorConvergesToCapacity()
+{
+	auto result = RunAdaptiveSession(2000000, 0.0, 300000, 60);
+
+	OV_TEST_ASSERT((result.convergence_seconds > 0.0) && (result.convergence_seconds < 40.0));
+	OV_TEST_ASSERT((result.average_estimate > 2000000 * 0.6) && (result.average_estimate < 2000000 * 1.2));
+	// The queue of the bottleneck does not stay full (100ms)
+	OV_TEST_ASSERT(result.average_queue_delay_ms < 80.0);
+}
+
+static void TestEstimatorLoss()
+{
+	// The link is not congested, but loses 20% of the packets
+	auto result = RunAdaptiveSession(10000000, 0.2, 2000000, 5);
+
+	// Measured over several feedbacks: a feedback of 50ms reports about 10 packets at 2 Mbps
+	OV_TEST_ASSERT(result.final_estimate < 1000000);
+
+	// A low loss ratio does not stop the increase
+	result = RunAdaptiveSession(10000000, 0.02, 1000000, 5);
+
+	OV_TEST_ASSERT(result.final_estimate > 1000000);
+}
+
+static void TestPacerKeyFrameLoss()
+{
+	auto unpaced = RunKeyFrameSession(false, 20);
+	auto paced = RunKeyFrameSession(true, 20);
+
+	// A key frame (40000 bytes) overflows the buffer (30000 bytes) if it is sent in a burst
+	OV_TEST_ASSERT(unpaced.overflow_percent > 1.0);
+	OV_TEST_ASSERT(paced.overflow_percent < unpaced.overflow_percent / 4);
+}
+
+static void BenchPacer()
+{
+	constexpr int COUNT = 1000000;
+
+	RtpPacer pacer(1000000000, 100000);
+	std::vector<std::shared_ptr<const ov::Data>> packets;
+
+	for (int index = 0; index < 64; index++)
+	{
+		packets.push_back(MakePacket(PACKET_SIZE));
+	}
+
+	int popped_count = 0;
+
+	// A frame of 16 packets every millisecond
+	auto elapsed = ov::test::MeasureMilliseconds([&]() {
+		for (int index = 0; index < COUNT; index++)
+		{
+			int64_t now_us = (index / 16) * 1000;
+
+			pacer.Push(packets[index % packets.size()], now_us);
+
+			while (pacer.Pop(now_us) != nullptr)
+			{
+				popped_count++;
+			}
+		}
+	});
+
+	OV_TEST_ASSERT(popped_count > COUNT / 2);
+
+	::printf("  Push + Pop: %.1f ns/packet (%d packets, %d sent)\n", elapsed * 1000000.0 / COUNT, COUNT, popped_count);
+}
+
+static void BenchEstimator()
+{
+	constexpr int FEEDBACK_COUNT = 20000;
+	constexpr int PACKETS_PER_FEEDBACK = 50;
+
+	RtpBandwidthEstimator estimator(1000000, 100000, 10000000);
+	RtcpTransportFeedback feedback;
+	uint16_t sequence_number = 0;
+	int64_t now_us = 0;
+	double elapsed = 0.0;
+
+	for (int feedback_index = 0; feedback_index < FEEDBACK_COUNT; feedback_index++)
+	{
+		feedback.packet_results.clear();
+
+		for (int index = 0; index < PACKETS_PER_FEEDBACK; index++)
+		{
+			estimator.OnPacketSent(sequence_number, PACKET_SIZE, now_us);
+			feedback.packet_results.push_back({sequence_number, (index % 50) != 49, now_us + 20000 + (index % 7) * 100});
+
+			sequence_number++;
+			now_us += 1000;
+		}
+
+		elapsed += ov::test::MeasureMilliseconds([&]() {
+			estimator.OnTransportFeedback(feedback, now_us);
+		});
+	}
+
+	::printf("  OnTransportFeedback: %.1f ns/packet (%d feedbacks of %d packets)\n",
+			 elapsed * 1000000.0 / (FEEDBACK_COUNT * PACKETS_PER_FEEDBACK), FEEDBACK_COUNT, PACKETS_PER_FEEDBACK);
+}
+
+static void BenchSimulatedLink()
+{
+	::printf("  Adaptive sender, from 300 kbps, 60 seconds, 20ms + 100ms of the buffer:\n");
+
+	for (uint32_t capacity : {1000000, 2000000, 5000000})
+	{
+		auto result = RunAdaptiveSession(capacity, 0.0, 300000, 60);
+
+		::printf("    %u kbps: 80%% of the capacity in %.1fs, estimate %.0f kbps, queue delay %.1fms, overflow %.2f%%\n",
+				 capacity / 1000, result.convergence_seconds, result.average_estimate / 1000.0, result.average_queue_delay_ms, result.overflow_percent);
+	}
+
+	auto unpaced = RunKeyFrameSession(false, 60);
+	auto paced = RunKeyFrameSession(true, 60);
+
+	::printf("  Key frames over 2 Mbps + 120ms of the buffer, 60 seconds:\n");
+	::printf("    unpaced: overflow %.2f%%, queue delay %.1fms\n", unpaced.overflow_percent, unpaced.average_queue_delay_ms);
+	::printf("    paced: overflow %.2f%%, queue delay %.1fms\n", paced.overflow_percent, paced.average_queue_delay_ms);
+}
+
+int main()
+{
+	OV_TEST_RUN(TestPacerBurst);
+	OV_TEST_RUN(TestPacerRate);
+	OV_TEST_RUN(TestPacerMaxQueueTime);
+	OV_TEST_RUN(TestPacerConsume);
+	OV_TEST_RUN(TestEstimatorUnknownPackets);
+	OV_TEST_RUN(TestEstimatorUnderusedLink);
+	OV_TEST_RUN(TestEstimatorConvergesToCapacity);
+	OV_TEST_RUN(TestEstimatorLoss);
+	OV_TEST_RUN(TestPacerKeyFrameLoss);
+	OV_TEST_RUN(BenchPacer);
+	OV_TEST_RUN(BenchEstimator);
+	OV_TEST_RUN(BenchSimulatedLink);
+
+	return 0;
+}
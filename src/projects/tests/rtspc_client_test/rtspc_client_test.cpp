@@ -0,0 +1,761 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <openssl/evp.h>
+#include <poll.h>
+#include <providers/rtsp/rtsp.h>
+#include <providers/rtspc/rtspc_client.h>
+#include <sys/socket.h>
+#include <tests/test_common.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+
+#define CAMERA_REALM "Camera"
+#define CAMERA_NONCE "5f0a1c3e7b9d2468"
+// A payload of FU-A, so that a frame is split into the packets of a usual MTU
+#define CAMERA_MAX_RTP_PAYLOAD_SIZE 1400
+
+static double GetCpuMilliseconds(clockid_t clock_id)
+{
+	timespec time{};
+	::clock_gettime(clock_id, &time);
+
+	return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+}
+
+static ov::String ToMd5String(const ov::String &text)
+{
+	uint8_t digest[EVP_MAX_MD_SIZE];
+	unsigned int digest_length = 0;
+
+	OV_TEST_ASSERT(::EVP_Digest(text.CStr(), text.GetLength(), digest, &digest_length, ::EVP_md5(), nullptr) == 1);
+
+	// RFC 2617 uses the lower case hex digits
+	return ov::ToHexString(digest, digest_length).LowerCaseString();
+}
+
+// Returns the value of the header (name must include the colon), or an empty string
+static ov::String GetHeader(const ov::String &request, const char *name)
+{
+	auto position = request.IndexOf(name);
+
+	if (position < 0)
+	{
+		return "";
+	}
+
+	auto value = request.Substring(position + ::strlen(name));
+	auto line_end = value.IndexOf("\r\n");
+
+	return ((line_end >= 0) ? value.Substring(0, line_end) : value).Trim();
+}
+
+// Returns the value of key="value" of the Authorization header
+static ov::String GetAuthorizationParameter(const ov::String &authorization, const char *key)
+{
+	auto prefix = ov::String::FormatString("%s=\"", key);
+	auto position = authorization.IndexOf(prefix);
+
+	if (position < 0)
+	{
+		return "";
+	}
+
+	auto value = authorization.Substring(position + prefix.GetLength());
+
+	return value.Substring(0, value.IndexOf("\""));
+}
+
+// An H.264 camera that serves a stream over RTSP (RTP interleaved in the TCP connection)
+class FakeCamera
+{
+public:
+	struct Options
+	{
+		int fps = 30;
+		size_t frame_size = 5000;
+		int gop = 30;
+		int session_timeout = 60;
+		// If not empty, the requests except OPTIONS need the Digest authorization
+		ov::String password;
+		// The first connection is closed after this number of frames (e.g. the camera reboots), 0: never
+		int close_first_connection_after = 0;
+	};
+
+	explicit FakeCamera(const Options &options)
+		: _options(options)
+	{
+		_listen_socket = ::socket(AF_INET, SOCK_STREAM, 0);
+
+		sockaddr_in address{};
+		socklen_t address_length = sizeof(address);
+
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+		OV_TEST_ASSERT(::bind(_listen_socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0);
+		OV_TEST_ASSERT(::listen(_listen_socket, 1024) == 0);
+		OV_TEST_ASSERT(::getsockname(_listen_socket, reinterpret_cast<sockaddr *>(&address), &address_length) == 0);
+
+		_port = ntohs(address.sin_port);
+
+		_thread = std::thread(&FakeCamera::Loop, this);
+	}
+
+	~FakeCamera()
+	{
+		_is_running = false;
+		_thread.join();
+
+		for (auto &connection : _connection_list)
+		{
+			::close(connection.socket);
+		}
+
+		::close(_listen_socket);
+	}
+
+	ov::String GetUrl(const char *credentials = nullptr) const
+	{
+		return ov::String::FormatString("rtsp://%s%s127.0.0.1:%u/stream", (credentials != nullptr) ? credentials : "", (credentials != nullptr) ? "@" : "", _port);
+	}
+
+	// CPU time of the camera thread (the thread is only valid while the camera is running)
+	double GetCpuMilliseconds() const
+	{
+		return _cpu_milliseconds;
+	}
+
+	std::atomic<int> connection_count{0};
+	std::atomic<int> unauthorized_count{0};
+	std::atomic<int> play_count{0};
+	std::atomic<int> keepalive_count{0};
+	std::atomic<int> teardown_count{0};
+	std::atomic<int64_t> sent_frame_count{0};
+
+protected:
+	struct Connection
+	{
+		int socket;
+		ov::String received;
+		bool is_playing = false;
+		int64_t frame_count = 0;
+		uint16_t sequence_number = 0;
+		uint32_t timestamp = 0;
+	};
+
+	void Loop()
+	{
+		auto frame_interval = std::chrono::microseconds(1000000 / _options.fps);
+		auto next_frame_time = std::chrono::steady_clock::now();
+		clockid_t clock_id;
+
+		::pthread_getcpuclockid(::pthread_self(), &clock_id);
+
+		while (_is_running)
+		{
+			std::vector<pollfd> poll_fd_list;
+			poll_fd_list.push_back({_listen_socket, POLLIN, 0});
+
+			for (auto &connection : _connection_list)
+			{
+				poll_fd_list.push_back({connection.socket, POLLIN, 0});
+			}
+
+			auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(next_frame_time - std::chrono::steady_clock::now()).count();
+
+			if (::poll(poll_fd_list.data(), poll_fd_list.size(), std::max<int>(timeout, 0)) > 0)
+			{
+				if (poll_fd_list[0].revents & POLLIN)
+				{
+					int socket = ::accept(_listen_socket, nullptr, nullptr);
+
+					if (socket >= 0)
+					{
+						_connection_list.push_back({socket});
+						connection_count++;
+					}
+				}
+
+				for (size_t index = 1; index < poll_fd_list.size(); index++)
+				{
+					if (poll_fd_list[index].revents != 0)
+					{
+						OnReadable(_connection_list[index - 1]);
+					}
+				}
+
+				RemoveClosedConnections();
+			}
+
+			if (std::chrono::steady_clock::now() >= next_frame_time)
+			{
+				next_frame_time += frame_interval;
+
+				for (auto &connection : _connection_list)
+				{
+					if (connection.is_playing)
+					{
+						SendFrame(connection);
+					}
+				}
+
+				RemoveClosedConnections();
+			}
+
+			_cpu_milliseconds = ::GetCpuMilliseconds(clock_id);
+		}
+	}
+
+	void RemoveClosedConnections()
+	{
+		for (auto connection = _connection_list.begin(); connection != _connection_list.end();)
+		{
+			if (connection->socket < 0)
+			{
+				connection = _connection_list.erase(connection);
+			}
+			else
+			{
+				++connection;
+			}
+		}
+	}
+
+	void Close(Connection &connection)
+	{
+		::close(connection.socket);
+		connection.socket = -1;
+		connection.is_playing = false;
+	}
+
+	void OnReadable(Connection &connection)
+	{
+		char buffer[4096];
+		auto length = ::recv(connection.socket, buffer, sizeof(buffer), MSG_DONTWAIT);
+
+		if (length <= 0)
+		{
+			Close(connection);
+			return;
+		}
+
+		connection.received.Append(buffer, length);
+
+		while (connection.received.GetLength() > 0)
+		{
+			if (connection.received[0] == '$')
+			{
+				// RTCP of the client
+				if (connection.received.GetLength() < 4)
+				{
+					break;
+				}
+
+				size_t packet_length = 4 + ((static_cast<uint8_t>(connection.received[2]) << 8) | static_cast<uint8_t>(connection.received[3]));
+
+				if (connection.received.GetLength() < packet_length)
+				{
+					break;
+				}
+
+				connection.received = connection.received.Substring(packet_length);
+				continue;
+			}
+
+			auto header_end = connection.received.IndexOf("\r\n\r\n");
+
+			if (header_end < 0)
+			{
+				break;
+			}
+
+			auto request = connection.received.Substring(0, header_end + 2);
+			connection.received = connection.received.Substring(header_end + 4);
+
+			OnRequest(connection, request);
+
+			if (connection.socket < 0)
+			{
+				break;
+			}
+		}
+	}
+
+	bool IsAuthorized(const ov::String &method, const ov::String &request)
+	{
+		if (_options.password.IsEmpty() || (method == "OPTIONS"))
+		{
+			return true;
+		}
+
+		auto authorization = GetHeader(request, "Authorization:");
+
+		if (authorization.HasPrefix("Digest ") == false)
+		{
+			return false;
+		}
+
+		auto username = GetAuthorizationParameter(authorization, "username");
+		auto uri = GetAuthorizationParameter(authorization, "uri");
+
+		auto ha1 = ToMd5String(ov::String::FormatString("%s:%s:%s", username.CStr(), CAMERA_REALM, _options.password.CStr()));
+		auto ha2 = ToMd5String(ov::String::FormatString("%s:%s", method.CStr(), uri.CStr()));
+
+		return GetAuthorizationParameter(authorization, "response") == ToMd5String(ov::String::FormatString("%s:%s:%s", ha1.CStr(), CAMERA_NONCE, ha2.CStr()));
+	}
+
+	void OnRequest(Connection &connection, const ov::String &request)
+	{
+		auto method = request.Substring(0, request.IndexOf(" "));
+		auto cseq = GetHeader(request, "CSeq:");
+		ov::String response;
+
+		if (IsAuthorized(method, request) == false)
+		{
+			unauthorized_count++;
+
+			response.Format("RTSP/1.0 401 Unauthorized\r\nCSeq: %s\r\nWWW-Authenticate: Digest realm=\"%s\", nonce=\"%s\"\r\n\r\n", cseq.CStr(), CAMERA_REALM, CAMERA_NONCE);
+			Send(connection, response.CStr(), response.GetLength());
+
+			return;
+		}
+
+		response.Format("RTSP/1.0 200 OK\r\nCSeq: %s\r\n", cseq.CStr());
+
+		if (method == "OPTIONS")
+		{
+			response.Append("Public: OPTIONS, DESCRIBE, SETUP, PLAY, GET_PARAMETER, TEARDOWN\r\n\r\n");
+		}
+		else if (method == "DESCRIBE")
+		{
+			ov::String sdp;
+
+			sdp.Append("v=0\r\n");
+			sdp.Append("o=- 1 1 IN IP4 127.0.0.1\r\n");
+			sdp.Append("s=Camera\r\n");
+			sdp.Append("t=0 0\r\n");
+			sdp.Append("a=control:*\r\n");
+			sdp.Append("m=video 0 RTP/AVP 96\r\n");
+			sdp.Append("a=rtpmap:96 H264/90000\r\n");
+			sdp.Append("a=fmtp:96 packetization-mode=1;profile-level-id=42e01f;sprop-parameter-sets=Z0LgH9kAoC/yAA==,aM4G4g==\r\n");
+			sdp.Append("a=control:trackID=1\r\n");
+
+			response.AppendFormat("Content-Base: %s/\r\nContent-Type: application/sdp\r\nContent-Length: %zu\r\n\r\n", GetUrl().CStr(), sdp.GetLength());
+			response.Append(sdp);
+		}
+		else if (method == "SETUP")
+		{
+			response.AppendFormat("Transport: RTP/AVP/TCP;unicast;interleaved=0-1\r\nSession: 12345678;timeout=%d\r\n\r\n", _options.session_timeout);
+		}
+		else if (method == "PLAY")
+		{
+			response.Append("Session: 12345678\r\n\r\n");
+			connection.is_playing = true;
+			play_count++;
+		}
+		else if (method == "GET_PARAMETER")
+		{
+			response.Append("Session: 12345678\r\n\r\n");
+			keepalive_count++;
+		}
+		else if (method == "TEARDOWN")
+		{
+			response.Append("\r\n");
+			connection.is_playing = false;
+			teardown_count++;
+		}
+		else
+		{
+			response.Format("RTSP/1.0 501 Not Implemented\r\nCSeq: %s\r\n\r\n", cseq.CStr());
+		}
+
+		Send(connection, response.CStr(), response.GetLength());
+	}
+
+	void Send(Connection &connection, const void *data, size_t length)
+	{
+		if ((connection.socket >= 0) && (::send(connection.socket, data, length, MSG_NOSIGNAL) != static_cast<ssize_t>(length)))
+		{
+			Close(connection);
+		}
+	}
+
+	// A frame is an IDR or a non-IDR slice, in FU-A packets
+	void SendFrame(Connection &connection)
+	{
+		if ((_options.close_first_connection_after > 0) && (play_count == 1) && (connection.frame_count == _options.close_first_connection_after))
+		{
+			Close(connection);
+			return;
+		}
+
+		bool is_key_frame = (connection.frame_count % _options.gop) == 0;
+		// NAL header, then first_mb_in_slice = 0, slice_type = 7 (I) or 0 (P), pic_parameter_set_id = 0
+		std::vector<uint8_t> nal_unit(_options.frame_size, static_cast<uint8_t>(connection.frame_count));
+		nal_unit[0] = is_key_frame ? 0x65 : 0x41;
+		nal_unit[1] = is_key_frame ? 0x88 : 0xE0;
+		nal_unit[2] = is_key_frame ? 0x80 : nal_unit[2];
+
+		std::vector<uint8_t> packets;
+		size_t offset = 1;
+
+		while (offset < nal_unit.size())
+		{
+			size_t payload_size = std::min<size_t>(nal_unit.size() - offset, CAMERA_MAX_RTP_PAYLOAD_SIZE);
+			bool is_first = (offset == 1);
+			bool is_last = (offset + payload_size == nal_unit.size());
+			size_t rtp_length = 12 + 2 + payload_size;
+
+			// Interleaved frame: '$', channel, length
+			packets.push_back('$');
+			packets.push_back(0);
+			packets.push_back(static_cast<uint8_t>(rtp_length >> 8));
+			packets.push_back(static_cast<uint8_t>(rtp_length));
+
+			// RTP header
+			packets.push_back(0x80);
+			packets.push_back(static_cast<uint8_t>((is_last ? 0x80 : 0x00) | 96));
+			packets.push_back(static_cast<uint8_t>(connection.sequence_number >> 8));
+			packets.push_back(static_cast<uint8_t>(connection.sequence_number));
+			connection.sequence_number++;
+
+			for (int shift = 24; shift >= 0; shift -= 8)
+			{
+				packets.push_back(static_cast<uint8_t>(connection.timestamp >> shift));
+			}
+
+			for (int shift = 24; shift >= 0; shift -= 8)
+			{
+				packets.push_back(static_cast<uint8_t>(0x12345678 >> shift));
+			}
+
+			// FU indicator and FU header
+			packets.push_back(static_cast<uint8_t>((nal_unit[0] & 0xE0) | 28));
+			packets.push_back(static_cast<uint8_t>((is_first ? 0x80 : 0x00) | (is_last ? 0x40 : 0x00) | (nal_unit[0] & 0x1F)));
+			packets.insert(packets.end(), nal_unit.begin() + offset, nal_unit.begin() + offset + payload_size);
+
+			offset += payload_size;
+		}
+
+		Send(connection, packets.data(), packets.size());
+
+		connection.frame_count++;
+		connection.timestamp += 90000 / _options.fps;
+		sent_frame_count++;
+	}
+
+	Options _options;
+	int _listen_socket = -1;
+	uint16_t _port = 0;
+
+	std::atomic<bool> _is_running{true};
+	std::thread _thread;
+	std::atomic<double> _cpu_milliseconds{0.0};
+
+	// Only used in the thread of the camera
+	std::vector<Connection> _connection_list;
+};
+
+// Counts what the client reports (called in the event loop)
+class TestObserver : public pvd::RtspcClientObserver
+{
+public:
+	bool OnRtspcDescribed(const std::vector<std::shared_ptr<MediaTrack>> &track_list) override
+	{
+		OV_TEST_ASSERT(track_list.size() == 1);
+		OV_TEST_ASSERT(track_list[0]->GetCodecId() == common::MediaCodecId::H264);
+
+		described_count++;
+
+		return true;
+	}
+
+	void OnRtspcPlaying() override
+	{
+		playing_count++;
+	}
+
+	void OnRtspcClosed(bool will_reconnect) override
+	{
+		(will_reconnect ? closed_to_reconnect_count : closed_count)++;
+	}
+
+	bool OnVideoData(uint32_t stream_id, uint8_t track_id, uint32_t timestamp, const std::shared_ptr<std::vector<uint8_t>> &data, uint8_t flags, std::unique_ptr<FragmentationHeader> fragmentation_header) override
+	{
+		OV_TEST_ASSERT(track_id == 96);
+
+		if (flags & static_cast<uint8_t>(RtpVideoFlags::Keyframe))
+		{
+			key_frame_count++;
+		}
+		else
+		{
+			// Start code and the reassembled NAL unit
+			OV_TEST_ASSERT(data->size() == (3 + frame_size));
+			OV_TEST_ASSERT((*data)[3] == 0x41);
+		}
+
+		frame_count++;
+
+		return true;
+	}
+
+	bool OnAudioData(uint32_t stream_id, uint8_t track_id, uint32_t timestamp, const std::shared_ptr<std::vector<uint8_t>> &data) override
+	{
+		return true;
+	}
+
+	void OnRtcpSenderReport(uint32_t stream_id, uint8_t track_id, const RtcpSenderReport &rtcp_sender_report) override
+	{
+	}
+
+	// Waits until condition is true, up to timeout_msec
+	static bool WaitFor(const std::function<bool()> &condition, int timeout_msec)
+	{
+		for (int elapsed = 0; elapsed < timeout_msec; elapsed += 10)
+		{
+			if (condition())
+			{
+				return true;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+
+		return condition();
+	}
+
+	size_t frame_size = 5000;
+
+	std::atomic<int> described_count{0};
+	std::atomic<int> playing_count{0};
+	std::atomic<int> closed_count{0};
+	std::atomic<int> closed_to_reconnect_count{0};
+	std::atomic<int64_t> frame_count{0};
+	std::atomic<int64_t> key_frame_count{0};
+};
+
+static std::shared_ptr<pvd::RtspcEventLoop> CreateEventLoop()
+{
+	auto event_loop = std::make_shared<pvd::RtspcEventLoop>();
+	OV_TEST_ASSERT(event_loop->Start());
+
+	return event_loop;
+}
+
+static void TestPlay()
+{
+	FakeCamera camera({});
+	TestObserver observer;
+	auto event_loop = CreateEventLoop();
+	auto client = pvd::RtspcClient::Create(event_loop, ov::Url::Parse(camera.GetUrl().CStr()), pvd::RtspcTransport::Tcp, 1, observer);
+
+	OV_TEST_ASSERT(client != nullptr);
+	client->Start();
+
+	// 2 seconds of the stream
+	OV_TEST_ASSERT(TestObserver::WaitFor([&]() { return observer.frame_count >= 60; }, 5000));
+
+	OV_TEST_ASSERT(observer.described_count == 1);
+	OV_TEST_ASSERT(observer.playing_count == 1);
+	OV_TEST_ASSERT(observer.key_frame_count >= 2);
+	OV_TEST_ASSERT((observer.closed_count == 0) && (observer.closed_to_reconnect_count == 0));
+
+	client->Stop();
+
+	OV_TEST_ASSERT(TestObserver::WaitFor([&]() { return camera.teardown_count == 1; }, 1000));
+
+	// The observer is not called after Stop()
+	auto frame_count = observer.frame_count.load();
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	OV_TEST_ASSERT(observer.frame_count == frame_count);
+
+	event_loop->Stop();
+}
+
+static void TestDigestAuthentication()
+{
+	FakeCamera::Options options;
+	options.password = "secret";
+
+	FakeCamera camera(options);
+	auto event_loop = CreateEventLoop();
+
+	{
+		TestObserver observer;
+		auto client = pvd::RtspcClient::Create(event_loop, ov::Url::Parse(camera.GetUrl("admin:secret").CStr()), pvd::RtspcTransport::Tcp, 1, observer);
+
+		client->Start();
+
+		OV_TEST_ASSERT(TestObserver::WaitFor([&]() { return observer.frame_count >= 10; }, 5000));
+		// Only the first DESCRIBE is rejected
+		OV_TEST_ASSERT(camera.unauthorized_count == 1);
+
+		client->Stop();
+	}
+
+	{
+		// The client is stopped, since it has never played
+		TestObserver observer;
+		auto client = pvd::RtspcClient::Create(event_loop, ov::Url::Parse(camera.GetUrl("admin:wrong").CStr()), pvd::RtspcTransport::Tcp, 1, observer);
+
+		client->Start();
+
+		OV_TEST_ASSERT(TestObserver::WaitFor([&]() { return observer.closed_count == 1; }, 5000));
+		OV_TEST_ASSERT(observer.playing_count == 0);
+		OV_TEST_ASSERT(observer.closed_to_reconnect_count == 0);
+		OV_TEST_ASSERT(camera.play_count == 1);
+
+		client->Stop();
+	}
+
+	event_loop->Stop();
+}
+
+// The camera drops the connection after 1 second, and the client reconnects after RTSPC_RECONNECT_MIN_DELAY
+static void TestReconnect()
+{
+	FakeCamera::Options options;
+	options.close_first_connection_after = 30;
+
+	FakeCamera camera(options);
+	TestObserver observer;
+	auto event_loop = CreateEventLoop();
+	auto client = pvd::RtspcClient::Create(event_loop, ov::Url::Parse(camera.GetUrl().CStr()), pvd::RtspcTransport::Tcp, 1, observer);
+
+	client->Start();
+
+	OV_TEST_ASSERT(TestObserver::WaitFor([&]() { return observer.closed_to_reconnect_count == 1; }, 5000));
+	auto closed_time = pvd::RtspcEventLoop::GetCurrentMilliseconds();
+
+	OV_TEST_ASSERT(TestObserver::WaitFor([&]() { return observer.playing_count == 2; }, 5000));
+	auto reconnect_delay = pvd::RtspcEventLoop::GetCurrentMilliseconds() - closed_time;
+
+	OV_TEST_ASSERT(reconnect_delay >= RTSPC_RECONNECT_MIN_DELAY - 100);
+	OV_TEST_ASSERT(camera.connection_count == 2);
+	OV_TEST_ASSERT(observer.described_count == 2);
+
+	// The stream continues
+	auto frame_count = observer.frame_count.load();
+	OV_TEST_ASSERT(TestObserver::WaitFor([&]() { return observer.frame_count >= frame_count + 30; }, 5000));
+	OV_TEST_ASSERT(observer.closed_count == 0);
+
+	client->Stop();
+	event_loop->Stop();
+}
+
+// The session is refreshed at the half of its timeout
+static void TestKeepalive()
+{
+	FakeCamera::Options options;
+	options.session_timeout = 2;
+
+	FakeCamera camera(options);
+	TestObserver observer;
+	auto event_loop = CreateEventLoop();
+	auto client = pvd::RtspcClient::Create(event_loop, ov::Url::Parse(camera.GetUrl().CStr()), pvd::RtspcTransport::Tcp, 1, observer);
+
+	client->Start();
+
+	OV_TEST_ASSERT(TestObserver::WaitFor([&]() { return camera.keepalive_count >= 2; }, 5000));
+	OV_TEST_ASSERT(observer.playing_count == 1);
+
+	client->Stop();
+	event_loop->Stop();
+}
+
+// Many cameras pulled by the event loops of the pool: the threads, the CPU time of the clients,
+// and the frames that are delivered
+static void BenchCameras()
+{
+	auto pool = pvd::RtspcEventLoopPool::GetInstance();
+	OV_TEST_ASSERT(pool->Start());
+
+	for (int camera_count : {50, 200})
+	{
+		FakeCamera camera({});
+		std::vector<std::unique_ptr<TestObserver>> observers;
+		std::vector<std::shared_ptr<pvd::RtspcClient>> clients;
+
+		for (int index = 0; index < camera_count; index++)
+		{
+			observers.push_back(std::make_unique<TestObserver>());
+			clients.push_back(pvd::RtspcClient::Create(pool->GetEventLoop(), ov::Url::Parse(camera.GetUrl().CStr()), pvd::RtspcTransport::Tcp, index, *observers.back()));
+			clients.back()->Start();
+		}
+
+		OV_TEST_ASSERT(TestObserver::WaitFor([&]() {
+			return std::all_of(observers.begin(), observers.end(), [](const auto &observer) { return observer->playing_count == 1; });
+		},
+											  10000));
+
+		int64_t connect_time = 0;
+		int64_t negotiation_time = 0;
+
+		for (auto &client : clients)
+		{
+			connect_time += client->GetConnectTimeMSec();
+			negotiation_time += client->GetNegotiationTimeMSec();
+		}
+
+		auto count_frames = [&]() -> int64_t {
+			int64_t frame_count = 0;
+
+			for (auto &observer : observers)
+			{
+				frame_count += observer->frame_count;
+			}
+
+			return frame_count;
+		};
+
+		// 5 seconds of the streams (the frames in flight at both ends make the two counts differ slightly)
+		auto start_frame_count = count_frames();
+		auto start_sent_frame_count = camera.sent_frame_count.load();
+		auto start_process_cpu = GetCpuMilliseconds(CLOCK_PROCESS_CPUTIME_ID);
+		auto start_camera_cpu = camera.GetCpuMilliseconds();
+
+		std::this_thread::sleep_for(std::chrono::seconds(5));
+
+		auto client_cpu = (GetCpuMilliseconds(CLOCK_PROCESS_CPUTIME_ID) - start_process_cpu) - (camera.GetCpuMilliseconds() - start_camera_cpu);
+		auto received_frame_count = count_frames() - start_frame_count;
+		auto sent_frame_count = camera.sent_frame_count - start_sent_frame_count;
+
+		::printf("  %3d cameras (30 fps, %zu B/frame): %zu loop thread(s), client CPU %.1f%% (%.3f%% per camera), %" PRId64 "/%" PRId64 " frames received, setup %.1f ms (connect %.1f ms)\n",
+				 camera_count, observers[0]->frame_size, std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), RTSPC_EVENT_LOOP_MAX_COUNT),
+				 client_cpu / 5000.0 * 100.0, client_cpu / 5000.0 * 100.0 / camera_count,
+				 received_frame_count, sent_frame_count,
+				 static_cast<double>(connect_time + negotiation_time) / camera_count, static_cast<double>(connect_time) / camera_count);
+
+		for (auto &client : clients)
+		{
+			client->Stop();
+		}
+	}
+
+	pool->Stop();
+}
+
+int main()
+{
+	// Every connection is logged, and the failures of the tests are logged as errors on purpose
+	ov_log_set_level(OVLogLevelCritical);
+
+	OV_TEST_RUN(TestPlay);
+	OV_TEST_RUN(TestDigestAuthentication);
+	OV_TEST_RUN(TestReconnect);
+	OV_TEST_RUN(TestKeepalive);
+	OV_TEST_RUN(BenchCameras);
+
+	return 0;
+}
@@ -0,0 +1,444 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <base/publisher/stream_worker_pool.h>
+#include <tests/test_common.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Runs a function on the pool, and records the core that ran it
+class TestTask : public pub::StreamWorkerTask
+{
+public:
+	explicit TestTask(std::function<void()> function = nullptr)
+		: _function(std::move(function))
+	{
+	}
+
+	void Run() override
+	{
+		if (_function != nullptr)
+		{
+			_function();
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		_core_index = pub::StreamWorkerPool::GetCurrentCoreIndex();
+		_is_done = true;
+		_event.notify_all();
+	}
+
+	// Returns the index of the core that ran the task, or -1 on timeout
+	int32_t WaitForDone()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		if (_event.wait_for(lock, std::chrono::seconds(5), [this]() { return _is_done; }) == false)
+		{
+			return -1;
+		}
+
+		return _core_index;
+	}
+
+	bool IsDone()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _is_done;
+	}
+
+private:
+	std::function<void()> _function;
+
+	std::mutex _mutex;
+	std::condition_variable _event;
+	bool _is_done = false;
+	int32_t _core_index = -1;
+};
+
+// Blocks a core until Release() is called
+class Blocker
+{
+public:
+	std::shared_ptr<TestTask> CreateTask()
+	{
+		return std::make_shared<TestTask>([this]() {
+			std::unique_lock<std::mutex> lock(_mutex);
+			_is_running = true;
+			_event.notify_all();
+			_event.wait(lock, [this]() { return _is_released; });
+		});
+	}
+
+	void WaitForRunning()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_event.wait(lock, [this]() { return _is_running; });
+	}
+
+	void Release()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_is_released = true;
+		_event.notify_all();
+	}
+
+private:
+	std::mutex _mutex;
+	std::condition_variable _event;
+	bool _is_running = false;
+	bool _is_released = false;
+};
+
+static void TestHomeCore()
+{
+	auto pool = pub::StreamWorkerPool::Instance();
+
+	OV_TEST_ASSERT(pool->Start(4, false));
+	OV_TEST_ASSERT(pool->GetCoreCount() == 4);
+	OV_TEST_ASSERT(pub::StreamWorkerPool::GetCurrentCoreIndex() == -1);
+
+	// A task always runs on its home core
+	for (uint32_t core_index = 0; core_index < 8; core_index++)
+	{
+		auto task = std::make_shared<TestTask>();
+
+		pool->Schedule(core_index, task);
+		OV_TEST_ASSERT(task->WaitForDone() == static_cast<int32_t>(core_index % 4));
+	}
+
+	OV_TEST_ASSERT(pool->Stop());
+	OV_TEST_ASSERT(pool->Stop());
+}
+
+static void TestWithoutStealing()
+{
+	auto pool = pub::StreamWorkerPool::Instance();
+
+	OV_TEST_ASSERT(pool->Start(2, false));
+
+	Blocker blocker;
+	pool->Schedule(0, blocker.CreateTask());
+	blocker.WaitForRunning();
+
+	// The tasks wait for the busy home core, although the other core is idle
+	std::vector<std::shared_ptr<TestTask>> task_list;
+
+	for (int index = 0; index < 10; index++)
+	{
+		task_list.push_back(std::make_shared<TestTask>());
+		pool->Schedule(0, task_list.back());
+	}
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+	for (auto &task : task_list)
+	{
+		OV_TEST_ASSERT(task->IsDone() == false);
+	}
+
+	blocker.Release();
+
+	for (auto &task : task_list)
+	{
+		OV_TEST_ASSERT(task->WaitForDone() == 0);
+	}
+
+	OV_TEST_ASSERT(pool->Stop());
+}
+
+static void TestWorkStealing()
+{
+	auto pool = pub::StreamWorkerPool::Instance();
+
+	OV_TEST_ASSERT(pool->Start(2, true));
+
+	Blocker blocker;
+	pool->Schedule(0, blocker.CreateTask());
+	blocker.WaitForRunning();
+
+	// The idle core steals the tasks queued on the busy core
+	std::vector<std::shared_ptr<TestTask>> task_list;
+
+	for (int index = 0; index < 10; index++)
+	{
+		task_list.push_back(std::make_shared<TestTask>());
+		pool->Schedule(0, task_list.back());
+	}
+
+	for (auto &task : task_list)
+	{
+		OV_TEST_ASSERT(task->WaitForDone() == 1);
+	}
+
+	blocker.Release();
+
+	// A stolen task goes back to its home core when it is scheduled again
+	auto task = std::make_shared<TestTask>();
+	pool->Schedule(0, task);
+	OV_TEST_ASSERT(task->WaitForDone() == 0);
+
+	OV_TEST_ASSERT(pool->Stop());
+}
+
+// A stream that delivers its packets to the sessions, like pub::StreamWorker
+struct FanOutStream
+{
+	static constexpr int SESSION_COUNT = 10;
+	static constexpr size_t PACKET_SIZE = 1316;
+
+	void Deliver(Clock::time_point queued_time)
+	{
+		// Each session writes the packet into its own buffer (like SRTP/RTP header rewriting)
+		for (auto &buffer : session_buffer_list)
+		{
+			::memcpy(buffer, payload, PACKET_SIZE);
+			buffer[0] ^= static_cast<uint8_t>(latency_list.size());
+		}
+
+		latency_list.push_back(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - queued_time).count());
+		delivered_count.fetch_add(1, std::memory_order_release);
+	}
+
+	uint8_t payload[PACKET_SIZE] = {};
+	uint8_t session_buffer_list[SESSION_COUNT][PACKET_SIZE] = {};
+
+	// Deliver() is called by one thread at a time, and the benchmark waits for delivered_count
+	std::vector<int64_t> latency_list;
+	std::atomic<uint32_t> delivered_count{0};
+};
+
+// The previous model: every stream has its own thread that waits for the packets
+class ThreadStreamWorker
+{
+public:
+	ThreadStreamWorker()
+	{
+		_thread = std::thread([this]() {
+			while (true)
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_event.wait(lock, [this]() { return _stop_flag || (_queue.empty() == false); });
+
+				if (_queue.empty())
+				{
+					break;
+				}
+
+				auto queued_time = _queue.front();
+				_queue.pop();
+				lock.unlock();
+
+				stream.Deliver(queued_time);
+			}
+		});
+	}
+
+	void Send()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_queue.push(Clock::now());
+		_event.notify_one();
+	}
+
+	void Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop_flag = true;
+			_event.notify_one();
+		}
+
+		_thread.join();
+	}
+
+	FanOutStream stream;
+
+private:
+	std::thread _thread;
+	std::mutex _mutex;
+	std::condition_variable _event;
+	std::queue<Clock::time_point> _queue;
+	bool _stop_flag = false;
+};
+
+// The pooled model: the stream is scheduled onto its home core when a packet is queued (same as pub::StreamWorker)
+class PooledStreamWorker : public pub::StreamWorkerTask, public ov::EnableSharedFromThis<PooledStreamWorker>
+{
+public:
+	explicit PooledStreamWorker(uint32_t home_core)
+		: _home_core(home_core)
+	{
+	}
+
+	void Send()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_queue.push(Clock::now());
+		}
+
+		if (_scheduled.exchange(true) == false)
+		{
+			pub::StreamWorkerPool::Instance()->Schedule(_home_core, GetSharedPtr());
+		}
+	}
+
+	void Run() override
+	{
+		while (true)
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+
+			if (_queue.empty())
+			{
+				break;
+			}
+
+			auto queued_time = _queue.front();
+			_queue.pop();
+			lock.unlock();
+
+			stream.Deliver(queued_time);
+		}
+
+		_scheduled = false;
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		bool has_packet = (_queue.empty() == false);
+		lock.unlock();
+
+		if (has_packet && (_scheduled.exchange(true) == false))
+		{
+			pub::StreamWorkerPool::Instance()->Schedule(_home_core, GetSharedPtr());
+		}
+	}
+
+	FanOutStream stream;
+
+private:
+	uint32_t _home_core;
+
+	std::mutex _mutex;
+	std::queue<Clock::time_point> _queue;
+	std::atomic<bool> _scheduled{false};
+};
+
+// Sends the packets of the rounds to all streams, and waits until they are delivered to the sessions
+template <typename Worker>
+static void SendRounds(const std::vector<Worker> &worker_list, int round_count, std::chrono::milliseconds interval)
+{
+	uint32_t expected_count = worker_list.front()->stream.delivered_count + round_count;
+
+	for (int round = 0; round < round_count; round++)
+	{
+		auto round_start = Clock::now();
+
+		for (auto &worker : worker_list)
+		{
+			worker->Send();
+		}
+
+		std::this_thread::sleep_until(round_start + interval);
+	}
+
+	for (auto &worker : worker_list)
+	{
+		while (worker->stream.delivered_count.load(std::memory_order_acquire) < expected_count)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+// 1k streams x 10 sessions
+// - Latency: every stream receives a packet every 10ms (like the video/audio of all streams)
+// - Throughput: the packets are sent as fast as possible
+template <typename Worker>
+static void BenchModel(const char *name, const std::vector<Worker> &worker_list)
+{
+	constexpr int PACED_ROUND_COUNT = 50;
+	constexpr int BURST_ROUND_COUNT = 100;
+
+	SendRounds(worker_list, PACED_ROUND_COUNT, std::chrono::milliseconds(10));
+
+	std::vector<int64_t> latency_list;
+
+	for (auto &worker : worker_list)
+	{
+		latency_list.insert(latency_list.end(), worker->stream.latency_list.begin(), worker->stream.latency_list.end());
+	}
+
+	std::sort(latency_list.begin(), latency_list.end());
+
+	auto elapsed = ov::test::MeasureMilliseconds([&]() {
+		SendRounds(worker_list, BURST_ROUND_COUNT, std::chrono::milliseconds(0));
+	});
+
+	auto session_packet_count = static_cast<double>(worker_list.size()) * BURST_ROUND_COUNT * FanOutStream::SESSION_COUNT;
+
+	::printf("  %-22s %zu streams x %d sessions: %.0f session packets/s, p99 latency %" PRId64 "us\n",
+			 name, worker_list.size(), FanOutStream::SESSION_COUNT, session_packet_count / (elapsed / 1000.0),
+			 latency_list[latency_list.size() * 99 / 100]);
+}
+
+static void BenchFanOut()
+{
+	constexpr int STREAM_COUNT = 1000;
+
+	{
+		std::vector<std::unique_ptr<ThreadStreamWorker>> worker_list;
+
+		for (int index = 0; index < STREAM_COUNT; index++)
+		{
+			worker_list.push_back(std::make_unique<ThreadStreamWorker>());
+		}
+
+		BenchModel("thread per stream:", worker_list);
+
+		for (auto &worker : worker_list)
+		{
+			worker->Stop();
+		}
+	}
+
+	for (bool work_stealing : {false, true})
+	{
+		auto pool = pub::StreamWorkerPool::Instance();
+		OV_TEST_ASSERT(pool->Start(0, work_stealing));
+
+		std::vector<std::shared_ptr<PooledStreamWorker>> worker_list;
+
+		for (int index = 0; index < STREAM_COUNT; index++)
+		{
+			worker_list.push_back(std::make_shared<PooledStreamWorker>(index % pool->GetCoreCount()));
+		}
+
+		BenchModel(work_stealing ? "pool (work stealing):" : "pool:", worker_list);
+
+		OV_TEST_ASSERT(pool->Stop());
+	}
+}
+
+int main()
+{
+	OV_TEST_RUN(TestHomeCore);
+	OV_TEST_RUN(TestWithoutStealing);
+	OV_TEST_RUN(TestWorkStealing);
+	OV_TEST_RUN(BenchFanOut);
+
+	return 0;
+}
@@ -0,0 +1,52 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// Helpers of the standalone tests in projects/tests
+//
+// A test is a function that is called by OV_TEST_RUN(), and the program exits with 1 at the first failed assertion.
+
+#define OV_TEST_ASSERT(condition)                                                                   \
+	do                                                                                              \
+	{                                                                                               \
+		if (!(condition))                                                                           \
+		{                                                                                           \
+			::fprintf(stderr, "%s:%d: Assertion failed: %s\n", __FILE__, __LINE__, #condition); \
+			::exit(1);                                                                          \
+		}                                                                                           \
+	} while (false)
+
+#define OV_TEST_RUN(test_function)                       \
+	do                                                   \
+	{                                                    \
+		::printf("[ RUN  ] %s\n", #test_function);      \
+		::fflush(stdout);                                \
+		test_function();                                 \
+		::printf("[  OK  ] %s\n", #test_function);      \
+	} while (false)
+
+namespace ov
+{
+	namespace test
+	{
+		// Returns the elapsed time of the function in milliseconds (for the benchmarks)
+		template <typename Function>
+		double MeasureMilliseconds(Function function)
+		{
+			auto start = std::chrono::steady_clock::now();
+
+			function();
+
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+	}  // namespace test
+}  // namespace ov
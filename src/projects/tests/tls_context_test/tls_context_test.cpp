@@ -0,0 +1,422 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <base/ovcrypto/ovcrypto.h>
+#include <tests/test_common.h>
+
+#include <time.h>
+
+#include <vector>
+
+// The cipher list of HttpsServer
+#define CIPHER_LIST "ECDHE-ECDSA-CHACHA20-POLY1305:ECDHE-RSA-CHACHA20-POLY1305:ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-RSA-AES128-GCM-SHA256:ECDHE-ECDSA-AES256-GCM-SHA384:ECDHE-RSA-AES256-GCM-SHA384"
+
+static std::shared_ptr<Certificate> CreateCertificate()
+{
+	auto certificate = std::make_shared<Certificate>();
+	OV_TEST_ASSERT(certificate->Generate() == nullptr);
+
+	return certificate;
+}
+
+static std::shared_ptr<ov::TlsContext> CreateContext(const std::shared_ptr<Certificate> &certificate)
+{
+	auto tls_context = ov::TlsContext::CreateServerContext(TLS_server_method(), certificate, nullptr, CIPHER_LIST);
+	OV_TEST_ASSERT(tls_context != nullptr);
+
+	return tls_context;
+}
+
+static double GetThreadCpuMilliseconds()
+{
+	timespec time{};
+	::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+
+	return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+}
+
+// A client (a browser) that talks to ov::TlsData over memory BIOs
+class TestClient
+{
+public:
+	struct Options
+	{
+		int max_version = TLS1_3_VERSION;
+		bool use_ticket = true;
+		const char *server_name = nullptr;
+		SSL_SESSION *session = nullptr;
+	};
+
+	explicit TestClient(const Options &options)
+	{
+		_ssl_ctx = ::SSL_CTX_new(TLS_client_method());
+		::SSL_CTX_set_max_proto_version(_ssl_ctx, options.max_version);
+
+		if (options.use_ticket == false)
+		{
+			::SSL_CTX_set_options(_ssl_ctx, SSL_OP_NO_TICKET);
+		}
+
+		_ssl = ::SSL_new(_ssl_ctx);
+		_read_bio = ::BIO_new(::BIO_s_mem());
+		_write_bio = ::BIO_new(::BIO_s_mem());
+
+		::SSL_set_bio(_ssl, _read_bio, _write_bio);
+		::SSL_set_connect_state(_ssl);
+
+		if (options.server_name != nullptr)
+		{
+			::SSL_set_tlsext_host_name(_ssl, options.server_name);
+		}
+
+		if (options.session != nullptr)
+		{
+			::SSL_set_session(_ssl, options.session);
+		}
+	}
+
+	~TestClient()
+	{
+		// Closes the connection cleanly, otherwise OpenSSL marks the session as not resumable
+		::SSL_shutdown(_ssl);
+		::SSL_free(_ssl);
+		::SSL_CTX_free(_ssl_ctx);
+	}
+
+	SSL *GetSsl()
+	{
+		return _ssl;
+	}
+
+	// Runs the handshake with the server (the server writes to the client with the write callback)
+	bool Connect(ov::TlsData &server, std::shared_ptr<ov::Data> &to_client)
+	{
+		for (int round = 0; round < 10; round++)
+		{
+			int result = ::SSL_do_handshake(_ssl);
+
+			if ((result != 1) && (::SSL_get_error(_ssl, result) != SSL_ERROR_WANT_READ))
+			{
+				return false;
+			}
+
+			if (SendTo(server) == false)
+			{
+				return false;
+			}
+
+			ReceiveFrom(to_client);
+
+			if ((result == 1) && (server.GetState() == ov::TlsData::State::Accepted))
+			{
+				// Reads the session tickets that are sent after the handshake (TLS 1.3)
+				char buffer[16];
+				::SSL_read(_ssl, buffer, sizeof(buffer));
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool Write(const ov::String &text)
+	{
+		return ::SSL_write(_ssl, text.CStr(), static_cast<int>(text.GetLength())) == static_cast<int>(text.GetLength());
+	}
+
+	ov::String Read(std::shared_ptr<ov::Data> &to_client)
+	{
+		ReceiveFrom(to_client);
+
+		char buffer[1024];
+		int length = ::SSL_read(_ssl, buffer, sizeof(buffer));
+
+		return (length > 0) ? ov::String(buffer, length) : "";
+	}
+
+	// The records that the client has written are passed to the server
+	bool SendTo(ov::TlsData &server, std::shared_ptr<const ov::Data> *plain_data = nullptr)
+	{
+		char buffer[16384];
+		int length;
+
+		while ((length = ::BIO_read(_write_bio, buffer, sizeof(buffer))) > 0)
+		{
+			std::shared_ptr<const ov::Data> decrypted;
+
+			if (server.Decrypt(std::make_shared<ov::Data>(buffer, length), &decrypted) == false)
+			{
+				return false;
+			}
+
+			if ((plain_data != nullptr) && (decrypted != nullptr) && (decrypted->GetLength() > 0))
+			{
+				*plain_data = decrypted;
+			}
+		}
+
+		return true;
+	}
+
+	void ReceiveFrom(std::shared_ptr<ov::Data> &to_client)
+	{
+		if (to_client->GetLength() > 0)
+		{
+			::BIO_write(_read_bio, to_client->GetData(), static_cast<int>(to_client->GetLength()));
+			to_client->Clear();
+		}
+	}
+
+	// The caller must free the session
+	SSL_SESSION *GetSession()
+	{
+		return ::SSL_get1_session(_ssl);
+	}
+
+private:
+	SSL_CTX *_ssl_ctx = nullptr;
+	SSL *_ssl = nullptr;
+	BIO *_read_bio = nullptr;
+	BIO *_write_bio = nullptr;
+};
+
+// A connection from a client to the server that uses tls_context
+struct Connection
+{
+	explicit Connection(const std::shared_ptr<ov::TlsContext> &tls_context, const TestClient::Options &options = {})
+		: server(tls_context),
+		  client(options)
+	{
+		to_client = std::make_shared<ov::Data>();
+
+		server.SetWriteCallback([this](const void *data, int64_t length) -> ssize_t {
+			to_client->Append(data, length);
+			return length;
+		});
+	}
+
+	bool Connect()
+	{
+		return client.Connect(server, to_client);
+	}
+
+	ov::TlsData server;
+	std::shared_ptr<ov::Data> to_client;
+	TestClient client;
+};
+
+static void TestHandshakeAndData()
+{
+	auto tls_context = CreateContext(CreateCertificate());
+	Connection connection(tls_context);
+
+	OV_TEST_ASSERT(connection.Connect());
+	OV_TEST_ASSERT(connection.server.IsSessionReused() == false);
+	OV_TEST_ASSERT(connection.server.GetTlsContext() == tls_context);
+
+	// Client -> server
+	std::shared_ptr<const ov::Data> plain_data;
+
+	OV_TEST_ASSERT(connection.client.Write("GET / HTTP/1.1\r\n\r\n"));
+	OV_TEST_ASSERT(connection.client.SendTo(connection.server, &plain_data));
+	OV_TEST_ASSERT((plain_data != nullptr) && plain_data->IsEqual("GET / HTTP/1.1\r\n\r\n", 18));
+
+	// Server -> client
+	std::shared_ptr<const ov::Data> cipher_data;
+	ov::String response = "HTTP/1.1 200 OK\r\n\r\n";
+
+	OV_TEST_ASSERT(connection.server.Encrypt(std::make_shared<ov::Data>(response.CStr(), response.GetLength()), &cipher_data));
+	connection.to_client->Append(cipher_data.get());
+
+	OV_TEST_ASSERT(connection.client.Read(connection.to_client) == response);
+}
+
+// A client reconnects with the session of the previous connection
+static bool Resume(const std::shared_ptr<ov::TlsContext> &first_context, const std::shared_ptr<ov::TlsContext> &second_context, TestClient::Options options)
+{
+	SSL_SESSION *session = nullptr;
+
+	{
+		Connection connection(first_context, options);
+
+		OV_TEST_ASSERT(connection.Connect());
+		OV_TEST_ASSERT(connection.server.IsSessionReused() == false);
+
+		session = connection.client.GetSession();
+		OV_TEST_ASSERT(session != nullptr);
+	}
+
+	options.session = session;
+
+	Connection connection(second_context, options);
+	OV_TEST_ASSERT(connection.Connect());
+
+	bool is_reused = connection.server.IsSessionReused();
+
+	OV_TEST_ASSERT(is_reused == (::SSL_session_reused(connection.client.GetSsl()) == 1));
+
+	::SSL_SESSION_free(session);
+
+	return is_reused;
+}
+
+static void TestSessionResumption()
+{
+	auto certificate = CreateCertificate();
+	auto tls_context = CreateContext(certificate);
+
+	// TLS 1.3 (ticket), TLS 1.2 with a ticket, and TLS 1.2 with the session cache of the server
+	OV_TEST_ASSERT(Resume(tls_context, tls_context, {TLS1_3_VERSION, true}));
+	OV_TEST_ASSERT(Resume(tls_context, tls_context, {TLS1_2_VERSION, true}));
+	OV_TEST_ASSERT(Resume(tls_context, tls_context, {TLS1_2_VERSION, false}));
+
+	// The ticket keys are shared by the contexts, so a ticket is still valid after the contexts are recreated
+	// (e.g. the virtual hosts are reloaded). The session cache belongs to the context, so the session ID is not
+	auto recreated_context = CreateContext(certificate);
+
+	OV_TEST_ASSERT(Resume(tls_context, recreated_context, {TLS1_3_VERSION, true}));
+	OV_TEST_ASSERT(Resume(tls_context, recreated_context, {TLS1_2_VERSION, true}));
+	OV_TEST_ASSERT(Resume(tls_context, recreated_context, {TLS1_2_VERSION, false}) == false);
+}
+
+static void TestServerNameIndication()
+{
+	auto default_certificate = CreateCertificate();
+	auto other_certificate = CreateCertificate();
+
+	auto default_context = CreateContext(default_certificate);
+	auto other_context = CreateContext(other_certificate);
+
+	default_context->SetServerNameResolver([&](const ov::String &server_name) -> std::shared_ptr<ov::TlsContext> {
+		return (server_name == "other.example.com") ? other_context : nullptr;
+	});
+
+	auto connect = [&](const char *server_name, const std::shared_ptr<Certificate> &expected_certificate, const std::shared_ptr<ov::TlsContext> &expected_context) {
+		TestClient::Options options;
+		options.server_name = server_name;
+
+		Connection connection(default_context, options);
+		OV_TEST_ASSERT(connection.Connect());
+		OV_TEST_ASSERT(connection.server.GetTlsContext() == expected_context);
+
+		X509 *peer_certificate = ::SSL_get1_peer_certificate(connection.client.GetSsl());
+		OV_TEST_ASSERT(peer_certificate != nullptr);
+		OV_TEST_ASSERT(::X509_cmp(peer_certificate, expected_certificate->GetX509()) == 0);
+		::X509_free(peer_certificate);
+	};
+
+	connect("other.example.com", other_certificate, other_context);
+	// Unknown or no server name: the default certificate
+	connect("unknown.example.com", default_certificate, default_context);
+	connect(nullptr, default_certificate, default_context);
+}
+
+// CPU time of the server per connection (the handshake of the client is not counted)
+static void BenchHandshake()
+{
+	constexpr int COUNT = 300;
+
+	auto certificate = CreateCertificate();
+	auto tls_context = CreateContext(certificate);
+
+	auto measure = [&](const char *name, std::function<std::unique_ptr<ov::TlsData>()> create_server, const TestClient::Options &options) {
+		double server_milliseconds = 0.0;
+		int reused_count = 0;
+
+		for (int index = 0; index < COUNT; index++)
+		{
+			TestClient client(options);
+			auto to_client = std::make_shared<ov::Data>();
+
+			auto start = GetThreadCpuMilliseconds();
+			auto server = create_server();
+			server_milliseconds += GetThreadCpuMilliseconds() - start;
+
+			server->SetWriteCallback([&](const void *data, int64_t length) -> ssize_t {
+				to_client->Append(data, length);
+				return length;
+			});
+
+			// The client writes and reads outside of the measured time
+			for (int round = 0; (round < 10) && (server->GetState() != ov::TlsData::State::Accepted); round++)
+			{
+				::SSL_do_handshake(client.GetSsl());
+
+				start = GetThreadCpuMilliseconds();
+				OV_TEST_ASSERT(client.SendTo(*server));
+				server_milliseconds += GetThreadCpuMilliseconds() - start;
+
+				client.ReceiveFrom(to_client);
+			}
+
+			OV_TEST_ASSERT(server->GetState() == ov::TlsData::State::Accepted);
+
+			reused_count += server->IsSessionReused() ? 1 : 0;
+		}
+
+		::printf("  %-50s %.3f ms/connection (%d/%d resumed)\n", name, server_milliseconds / COUNT, reused_count, COUNT);
+	};
+
+	auto get_session = [&](int max_version) -> SSL_SESSION * {
+		TestClient::Options options;
+		options.max_version = max_version;
+
+		Connection connection(tls_context, options);
+		OV_TEST_ASSERT(connection.Connect());
+
+		return connection.client.GetSession();
+	};
+
+	TestClient::Options tls13_options;
+	TestClient::Options tls12_options;
+	tls12_options.max_version = TLS1_2_VERSION;
+
+	measure(
+		"SSL_CTX per connection, full handshake:", [&]() {
+			return std::make_unique<ov::TlsData>(ov::TlsData::Method::TlsServerMethod, certificate, nullptr, CIPHER_LIST);
+		},
+		tls13_options);
+
+	measure(
+		"shared TlsContext, full handshake:", [&]() {
+			return std::make_unique<ov::TlsData>(tls_context);
+		},
+		tls13_options);
+
+	// TLS 1.3 resumption still runs ECDHE (psk_dhe_ke), TLS 1.2 resumption does not
+	tls13_options.session = get_session(TLS1_3_VERSION);
+	tls12_options.session = get_session(TLS1_2_VERSION);
+
+	measure(
+		"shared TlsContext, TLS 1.3 resumed with a ticket:", [&]() {
+			return std::make_unique<ov::TlsData>(tls_context);
+		},
+		tls13_options);
+
+	measure(
+		"shared TlsContext, TLS 1.2 resumed with a ticket:", [&]() {
+			return std::make_unique<ov::TlsData>(tls_context);
+		},
+		tls12_options);
+
+	::SSL_SESSION_free(tls13_options.session);
+	::SSL_SESSION_free(tls12_options.session);
+}
+
+int main()
+{
+	// TlsData logs every accepted connection
+	ov_log_set_level(OVLogLevelWarning);
+
+	OV_TEST_RUN(TestHandshakeAndData);
+	OV_TEST_RUN(TestSessionResumption);
+	OV_TEST_RUN(TestServerNameIndication);
+	OV_TEST_RUN(BenchHandshake);
+
+	return 0;
+}
@@ -0,0 +1,426 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <tests/test_common.h>
+#include <transcode/transcode_stage.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct TestItem
+{
+	TestItem(uint32_t producer_index, uint32_t sequence)
+		: producer_index(producer_index),
+		  sequence(sequence)
+	{
+	}
+
+	uint32_t producer_index;
+	uint32_t sequence;
+};
+
+using TestStage = TranscodeStage<TestItem>;
+
+// Blocks a handler until Release() is called
+class Gate
+{
+public:
+	void Enter()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_is_entered = true;
+		_event.notify_all();
+		_event.wait(lock, [this]() { return _is_released; });
+	}
+
+	void WaitForEntered()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_event.wait(lock, [this]() { return _is_entered; });
+	}
+
+	void Release()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_is_released = true;
+		_event.notify_all();
+	}
+
+private:
+	std::mutex _mutex;
+	std::condition_variable _event;
+	bool _is_entered = false;
+	bool _is_released = false;
+};
+
+static void WaitFor(const std::atomic<uint32_t> &counter, uint32_t count)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	while (counter.load() < count)
+	{
+		OV_TEST_ASSERT((std::chrono::steady_clock::now() - start) < std::chrono::seconds(10));
+		std::this_thread::yield();
+	}
+}
+
+// Keeps a thread busy, as a decoder/filter/encoder would
+static uint32_t Work(uint32_t amount)
+{
+	uint32_t value = amount;
+
+	for (uint32_t index = 0; index < amount; index++)
+	{
+		value = value * 1664525 + 1013904223;
+		asm volatile("" : "+r"(value));
+	}
+
+	return value;
+}
+
+static void TestOrderAndExclusivity()
+{
+	constexpr uint32_t PRODUCER_COUNT = 4;
+	constexpr uint32_t COUNT = 20000;
+
+	std::vector<uint32_t> next_sequences(PRODUCER_COUNT, 0);
+	std::atomic<int> running_count{0};
+	std::atomic<uint32_t> processed_count{0};
+
+	// The handler is never run by two threads at once, so it does not need a lock
+	auto stage = std::make_shared<TestStage>("order", 256, TranscodeStageDropPolicy::RejectNewest, [&](std::shared_ptr<TestItem> item) {
+		OV_TEST_ASSERT(running_count.fetch_add(1) == 0);
+
+		OV_TEST_ASSERT(item->sequence == next_sequences[item->producer_index]);
+		next_sequences[item->producer_index]++;
+
+		running_count.fetch_sub(1);
+		processed_count++;
+	});
+
+	OV_TEST_ASSERT(stage->Start());
+
+	std::vector<std::thread> producers;
+
+	for (uint32_t producer_index = 0; producer_index < PRODUCER_COUNT; producer_index++)
+	{
+		producers.emplace_back([&, producer_index]() {
+			for (uint32_t sequence = 0; sequence < COUNT; sequence++)
+			{
+				// Retry the rejected items, so that all items are delivered
+				while (stage->Push(std::make_shared<TestItem>(producer_index, sequence)) == false)
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	for (auto &producer : producers)
+	{
+		producer.join();
+	}
+
+	WaitFor(processed_count, PRODUCER_COUNT * COUNT);
+
+	OV_TEST_ASSERT(stage->GetMetrics()->GetProcessedCount() == PRODUCER_COUNT * COUNT);
+	OV_TEST_ASSERT(stage->GetQueueHighWaterMark() <= 256);
+
+	stage->Stop();
+}
+
+static void TestStagesRunInParallel()
+{
+	constexpr uint32_t COUNT = 10;
+
+	std::atomic<uint32_t> processed_count{0};
+	auto handler = [&](std::shared_ptr<TestItem> item) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		processed_count++;
+	};
+
+	auto decoder_stage = std::make_shared<TestStage>("decoder", 16, TranscodeStageDropPolicy::RejectNewest, handler);
+	auto encoder_stage = std::make_shared<TestStage>("encoder", 16, TranscodeStageDropPolicy::RejectNewest, handler);
+
+	decoder_stage->Start();
+	encoder_stage->Start();
+
+	// 400ms if the stages were run one after another
+	auto elapsed = ov::test::MeasureMilliseconds([&]() {
+		for (uint32_t sequence = 0; sequence < COUNT; sequence++)
+		{
+			OV_TEST_ASSERT(decoder_stage->Push(std::make_shared<TestItem>(0, sequence)));
+			OV_TEST_ASSERT(encoder_stage->Push(std::make_shared<TestItem>(0, sequence)));
+		}
+
+		WaitFor(processed_count, COUNT * 2);
+	});
+
+	OV_TEST_ASSERT(elapsed < 320.0);
+}
+
+static void TestDropOldest()
+{
+	Gate gate;
+	std::vector<uint32_t> processed_sequences;
+	std::atomic<uint32_t> processed_count{0};
+
+	auto stage = std::make_shared<TestStage>("drop", 4, TranscodeStageDropPolicy::DropOldest, [&](std::shared_ptr<TestItem> item) {
+		if (item->sequence == 0)
+		{
+			gate.Enter();
+		}
+
+		processed_sequences.push_back(item->sequence);
+		processed_count++;
+	});
+
+	stage->Start();
+
+	OV_TEST_ASSERT(stage->Push(std::make_shared<TestItem>(0, 0)));
+	gate.WaitForEntered();
+
+	// While the handler is busy, the queue keeps only the latest 4 items
+	for (uint32_t sequence = 1; sequence <= 10; sequence++)
+	{
+		OV_TEST_ASSERT(stage->Push(std::make_shared<TestItem>(0, sequence)));
+	}
+
+	OV_TEST_ASSERT(stage->GetQueueSize() == 4);
+	OV_TEST_ASSERT(stage->GetMetrics()->GetDroppedCount() == 6);
+
+	gate.Release();
+	WaitFor(processed_count, 5);
+
+	OV_TEST_ASSERT((processed_sequences == std::vector<uint32_t>{0, 7, 8, 9, 10}));
+
+	stage->Stop();
+}
+
+static void TestStopWaitsForHandler()
+{
+	Gate gate;
+	std::atomic<bool> is_handler_done{false};
+
+	auto stage = std::make_shared<TestStage>("stop", 4, TranscodeStageDropPolicy::RejectNewest, [&](std::shared_ptr<TestItem> item) {
+		gate.Enter();
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		is_handler_done = true;
+	});
+
+	stage->Start();
+	OV_TEST_ASSERT(stage->Push(std::make_shared<TestItem>(0, 0)));
+	OV_TEST_ASSERT(stage->Push(std::make_shared<TestItem>(0, 1)));
+
+	gate.WaitForEntered();
+	gate.Release();
+
+	// The resources of the handler (e.g. the codec context) can be released after Stop()
+	stage->Stop();
+
+	OV_TEST_ASSERT(is_handler_done);
+	OV_TEST_ASSERT(stage->GetQueueSize() == 0);
+	OV_TEST_ASSERT(stage->Push(std::make_shared<TestItem>(0, 2)) == false);
+}
+
+static void TestPoolRestart()
+{
+	auto pool = TranscodeWorkerPool::Instance();
+
+	pool->Stop();
+	OV_TEST_ASSERT(pool->Start(1));
+
+	Gate gate;
+	std::atomic<uint32_t> processed_count{0};
+
+	auto blocker_stage = std::make_shared<TestStage>("blocker", 4, TranscodeStageDropPolicy::RejectNewest, [&](std::shared_ptr<TestItem> item) {
+		gate.Enter();
+	});
+	auto stage = std::make_shared<TestStage>("restart", 4, TranscodeStageDropPolicy::RejectNewest, [&](std::shared_ptr<TestItem> item) {
+		processed_count++;
+	});
+
+	blocker_stage->Start();
+	stage->Start();
+
+	// The only thread of the pool is busy, so the stage stays in the run queue
+	OV_TEST_ASSERT(blocker_stage->Push(std::make_shared<TestItem>(0, 0)));
+	gate.WaitForEntered();
+	OV_TEST_ASSERT(stage->Push(std::make_shared<TestItem>(0, 0)));
+
+	std::thread releaser([&]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		gate.Release();
+	});
+
+	// The stage is removed from the run queue before it runs
+	OV_TEST_ASSERT(pool->Stop());
+	releaser.join();
+
+	OV_TEST_ASSERT(processed_count == 0);
+	OV_TEST_ASSERT(stage->GetQueueSize() == 1);
+
+	// After the restart, the next item schedules the stage again, and the item left in the queue is processed too
+	OV_TEST_ASSERT(pool->Start(4));
+	OV_TEST_ASSERT(stage->Push(std::make_shared<TestItem>(0, 1)));
+
+	WaitFor(processed_count, 2);
+
+	blocker_stage->Stop();
+	stage->Stop();
+}
+
+// Time that an item takes to go through a stage with an empty handler
+static void BenchStageHop()
+{
+	constexpr uint32_t COUNT = 1000000;
+	constexpr int STAGE_COUNT = 3;
+
+	std::atomic<uint32_t> processed_count{0};
+	std::vector<std::shared_ptr<TestStage>> stages(STAGE_COUNT);
+
+	for (int index = STAGE_COUNT - 1; index >= 0; index--)
+	{
+		auto next_stage = (index + 1 < STAGE_COUNT) ? stages[index + 1] : nullptr;
+
+		stages[index] = std::make_shared<TestStage>("hop", 1024, TranscodeStageDropPolicy::RejectNewest, [&, next_stage](std::shared_ptr<TestItem> item) {
+			if (next_stage != nullptr)
+			{
+				while (next_stage->Push(item) == false)
+				{
+					std::this_thread::yield();
+				}
+			}
+			else
+			{
+				processed_count++;
+			}
+		});
+
+		stages[index]->Start();
+	}
+
+	auto elapsed = ov::test::MeasureMilliseconds([&]() {
+		for (uint32_t sequence = 0; sequence < COUNT; sequence++)
+		{
+			while (stages[0]->Push(std::make_shared<TestItem>(0, sequence)) == false)
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		WaitFor(processed_count, COUNT);
+	});
+
+	::printf("  %u threads, %d stages: %.0f ns/item per stage\n",
+			 TranscodeWorkerPool::Instance()->GetThreadCount(), STAGE_COUNT, elapsed * 1000000.0 / COUNT / STAGE_COUNT);
+
+	for (auto &stage : stages)
+	{
+		stage->Stop();
+	}
+}
+
+// A stream with 3 renditions: decode (2 units), scale (1 unit per rendition) and encode (3, 2, 1 units)
+// - serial: one thread runs all steps of a frame, as TranscodeStream did before
+// - staged: the steps run as the stages of the pipeline on the pool
+static void BenchPipeline()
+{
+	constexpr uint32_t FRAME_COUNT = 500;
+	constexpr uint32_t UNIT = 200000;
+	constexpr int RENDITION_COUNT = 3;
+
+	std::atomic<uint32_t> sink{0};
+
+	auto serial_elapsed = ov::test::MeasureMilliseconds([&]() {
+		for (uint32_t frame = 0; frame < FRAME_COUNT; frame++)
+		{
+			sink += Work(2 * UNIT);
+
+			for (int rendition = 0; rendition < RENDITION_COUNT; rendition++)
+			{
+				sink += Work(UNIT);
+				sink += Work((RENDITION_COUNT - rendition) * UNIT);
+			}
+		}
+	});
+
+	std::atomic<uint32_t> encoded_count{0};
+	std::vector<std::shared_ptr<TestStage>> encoder_stages;
+	std::vector<std::shared_ptr<TestStage>> filter_stages;
+
+	for (int rendition = 0; rendition < RENDITION_COUNT; rendition++)
+	{
+		auto encoder_stage = std::make_shared<TestStage>("encoder", 1024, TranscodeStageDropPolicy::RejectNewest, [&, rendition](std::shared_ptr<TestItem> item) {
+			sink += Work((RENDITION_COUNT - rendition) * UNIT);
+			encoded_count++;
+		});
+
+		auto filter_stage = std::make_shared<TestStage>("filter", 1024, TranscodeStageDropPolicy::RejectNewest, [&, encoder_stage](std::shared_ptr<TestItem> item) {
+			sink += Work(UNIT);
+			encoder_stage->Push(item);
+		});
+
+		encoder_stage->Start();
+		filter_stage->Start();
+
+		encoder_stages.push_back(encoder_stage);
+		filter_stages.push_back(filter_stage);
+	}
+
+	auto decoder_stage = std::make_shared<TestStage>("decoder", 1024, TranscodeStageDropPolicy::RejectNewest, [&](std::shared_ptr<TestItem> item) {
+		sink += Work(2 * UNIT);
+
+		for (auto &filter_stage : filter_stages)
+		{
+			filter_stage->Push(item);
+		}
+	});
+
+	decoder_stage->Start();
+
+	auto staged_elapsed = ov::test::MeasureMilliseconds([&]() {
+		for (uint32_t frame = 0; frame < FRAME_COUNT; frame++)
+		{
+			OV_TEST_ASSERT(decoder_stage->Push(std::make_shared<TestItem>(0, frame)));
+		}
+
+		WaitFor(encoded_count, FRAME_COUNT * RENDITION_COUNT);
+	});
+
+	::printf("  %u CPU(s), %u pool threads, %u frames\n",
+			 std::thread::hardware_concurrency(), TranscodeWorkerPool::Instance()->GetThreadCount(), FRAME_COUNT);
+	::printf("  serial: %.0f fps, staged: %.0f fps\n",
+			 FRAME_COUNT / (serial_elapsed / 1000.0), FRAME_COUNT / (staged_elapsed / 1000.0));
+
+	decoder_stage->Stop();
+
+	for (int rendition = 0; rendition < RENDITION_COUNT; rendition++)
+	{
+		filter_stages[rendition]->Stop();
+		encoder_stages[rendition]->Stop();
+	}
+}
+
+int main()
+{
+	OV_TEST_ASSERT(TranscodeWorkerPool::Instance()->Start(4));
+
+	OV_TEST_RUN(TestOrderAndExclusivity);
+	OV_TEST_RUN(TestStagesRunInParallel);
+	OV_TEST_RUN(TestDropOldest);
+	OV_TEST_RUN(TestStopWaitsForHandler);
+	OV_TEST_RUN(TestPoolRestart);
+	OV_TEST_RUN(BenchStageHop);
+	OV_TEST_RUN(BenchPipeline);
+
+	TranscodeWorkerPool::Instance()->Stop();
+
+	return 0;
+}
@@ -0,0 +1,404 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <modules/rtp_rtcp/fec_xor.h>
+#include <modules/rtp_rtcp/ulpfec_generator.h>
+#include <tests/test_common.h>
+
+#include <cstring>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#define TEST_PAYLOAD_TYPE (100)
+#define TEST_RED_PAYLOAD_TYPE (96)
+#define TEST_TIMESTAMP (0x12345678)
+
+// Offsets in the FEC packet (RFC 5109)
+#define FEC_HEADER_SIZE (10)
+#define FEC_L_BIT (0x40)
+
+struct FecPacket
+{
+	uint8_t m_pt_recovery;
+	uint16_t sn_base;
+	uint32_t ts_recovery;
+	uint16_t length_recovery;
+	uint16_t protection_length;
+	// Sequence numbers of the protected media packets
+	std::vector<uint16_t> protected_sequence_numbers;
+	std::vector<uint8_t> payload;
+};
+
+static uint16_t ReadUint16(const uint8_t *data)
+{
+	return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+static uint32_t ReadUint32(const uint8_t *data)
+{
+	return (static_cast<uint32_t>(ReadUint16(data)) << 16) | ReadUint16(data + 2);
+}
+
+static FecPacket ParseFecPacket(const uint8_t *data, size_t length)
+{
+	FecPacket packet;
+
+	bool l_bit = (data[0] & FEC_L_BIT) != 0;
+	size_t mask_length = l_bit ? 6 : 2;
+
+	packet.m_pt_recovery = data[1];
+	packet.sn_base = ReadUint16(data + 2);
+	packet.ts_recovery = ReadUint32(data + 4);
+	packet.length_recovery = ReadUint16(data + 8);
+	packet.protection_length = ReadUint16(data + FEC_HEADER_SIZE);
+
+	auto mask = data + FEC_HEADER_SIZE + 2;
+
+	for (size_t bit = 0; bit < mask_length * 8; bit++)
+	{
+		if (mask[bit / 8] & (0x80 >> (bit % 8)))
+		{
+			packet.protected_sequence_numbers.push_back(static_cast<uint16_t>(packet.sn_base + bit));
+		}
+	}
+
+	size_t header_length = FEC_HEADER_SIZE + 2 + mask_length;
+	OV_TEST_ASSERT(length == header_length + packet.protection_length);
+
+	packet.payload.assign(data + header_length, data + length);
+
+	return packet;
+}
+
+// A frame of media packets with random payloads of various sizes (the last one has the marker bit)
+static std::vector<std::shared_ptr<RedRtpPacket>> MakeFrame(std::mt19937 &random, uint16_t first_sequence_number, size_t packet_count)
+{
+	std::uniform_int_distribution<int> byte_distribution(0, 255);
+	std::uniform_int_distribution<size_t> size_distribution(100, 1200);
+	std::vector<std::shared_ptr<RedRtpPacket>> frame;
+
+	for (size_t index = 0; index < packet_count; index++)
+	{
+		std::vector<uint8_t> payload(size_distribution(random));
+
+		for (auto &byte : payload)
+		{
+			byte = static_cast<uint8_t>(byte_distribution(random));
+		}
+
+		RtpPacket packet;
+
+		packet.SetPayloadType(TEST_PAYLOAD_TYPE);
+		packet.SetSsrc(0x1234);
+		packet.SetSequenceNumber(static_cast<uint16_t>(first_sequence_number + index));
+		packet.SetTimestamp(TEST_TIMESTAMP);
+		packet.SetMarker(index == packet_count - 1);
+		packet.SetPayload(payload.data(), payload.size());
+
+		frame.push_back(std::make_shared<RedRtpPacket>(TEST_RED_PAYLOAD_TYPE, packet));
+	}
+
+	return frame;
+}
+
+static std::vector<FecPacket> GenerateFec(UlpfecMaskType mask_type, const std::vector<std::shared_ptr<RedRtpPacket>> &frame)
+{
+	UlpfecGenerator generator;
+	std::vector<FecPacket> fec_packets;
+
+	generator.SetMaskType(mask_type);
+
+	for (auto &packet : frame)
+	{
+		generator.AddRtpPacketAndGenerateFec(packet);
+	}
+
+	while (generator.IsAvailableFecPackets())
+	{
+		RtpPacket fec_packet;
+
+		OV_TEST_ASSERT(generator.NextPacket(&fec_packet));
+
+		fec_packets.push_back(ParseFecPacket(fec_packet.Payload(), fec_packet.PayloadSize()));
+	}
+
+	return fec_packets;
+}
+
+// Recovers each protected packet from the FEC packet and the other protected packets, as the receiver does
+static void VerifyRecovery(const FecPacket &fec_packet, const std::map<uint16_t, std::shared_ptr<RedRtpPacket>> &packets)
+{
+	for (auto lost_sequence_number : fec_packet.protected_sequence_numbers)
+	{
+		uint8_t m_pt = fec_packet.m_pt_recovery;
+		uint32_t timestamp = fec_packet.ts_recovery;
+		uint16_t length = fec_packet.length_recovery;
+		auto payload = fec_packet.payload;
+
+		for (auto sequence_number : fec_packet.protected_sequence_numbers)
+		{
+			if (sequence_number == lost_sequence_number)
+			{
+				continue;
+			}
+
+			auto &packet = packets.at(sequence_number);
+
+			m_pt ^= static_cast<uint8_t>((packet->Marker() ? 0x80 : 0x00) | TEST_PAYLOAD_TYPE);
+			timestamp ^= packet->Timestamp();
+			length ^= static_cast<uint16_t>(packet->PayloadSize());
+
+			OV_TEST_ASSERT(packet->PayloadSize() <= payload.size());
+
+			for (size_t offset = 0; offset < packet->PayloadSize(); offset++)
+			{
+				payload[offset] ^= packet->Payload()[offset];
+			}
+		}
+
+		auto &lost_packet = packets.at(lost_sequence_number);
+
+		OV_TEST_ASSERT(m_pt == ((lost_packet->Marker() ? 0x80 : 0x00) | TEST_PAYLOAD_TYPE));
+		OV_TEST_ASSERT(timestamp == lost_packet->Timestamp());
+		OV_TEST_ASSERT(length == lost_packet->PayloadSize());
+		OV_TEST_ASSERT(::memcmp(payload.data(), lost_packet->Payload(), length) == 0);
+	}
+}
+
+// Every media packet is protected by exactly one FEC packet, and can be recovered from it
+static void VerifyFrame(const std::vector<std::shared_ptr<RedRtpPacket>> &frame, const std::vector<FecPacket> &fec_packets)
+{
+	std::map<uint16_t, std::shared_ptr<RedRtpPacket>> packets;
+	std::multiset<uint16_t> protected_sequence_numbers;
+
+	for (auto &packet : frame)
+	{
+		packets[packet->SequenceNumber()] = packet;
+	}
+
+	for (auto &fec_packet : fec_packets)
+	{
+		OV_TEST_ASSERT(fec_packet.protected_sequence_numbers.empty() == false);
+		OV_TEST_ASSERT(fec_packet.protected_sequence_numbers.front() == fec_packet.sn_base);
+
+		protected_sequence_numbers.insert(fec_packet.protected_sequence_numbers.begin(), fec_packet.protected_sequence_numbers.end());
+
+		VerifyRecovery(fec_packet, packets);
+	}
+
+	OV_TEST_ASSERT(protected_sequence_numbers.size() == frame.size());
+
+	for (auto &packet : frame)
+	{
+		OV_TEST_ASSERT(protected_sequence_numbers.count(packet->SequenceNumber()) == 1);
+	}
+}
+
+// Returns true if all packets of the burst are protected by different FEC packets (so that all of them can be recovered)
+static bool IsBurstRecoverable(const std::vector<FecPacket> &fec_packets, uint16_t first_sequence_number, size_t burst_length)
+{
+	for (auto &fec_packet : fec_packets)
+	{
+		size_t lost_count = 0;
+
+		for (auto sequence_number : fec_packet.protected_sequence_numbers)
+		{
+			if (static_cast<uint16_t>(sequence_number - first_sequence_number) < burst_length)
+			{
+				lost_count++;
+			}
+		}
+
+		if (lost_count > 1)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void TestXor()
+{
+	std::mt19937 random(1);
+	std::uniform_int_distribution<int> distribution(0, 255);
+
+	::printf("  Implementation: %s\n", FecXor::GetImplementationName());
+
+	// All lengths around the block sizes, with unaligned buffers
+	for (size_t length = 0; length < 300; length++)
+	{
+		for (size_t alignment = 0; alignment < 4; alignment++)
+		{
+			std::vector<uint8_t> destination(length + alignment + 1);
+			std::vector<uint8_t> source(length + alignment);
+
+			for (auto &byte : destination)
+			{
+				byte = static_cast<uint8_t>(distribution(random));
+			}
+
+			for (auto &byte : source)
+			{
+				byte = static_cast<uint8_t>(distribution(random));
+			}
+
+			auto expected = destination;
+
+			for (size_t offset = 0; offset < length; offset++)
+			{
+				expected[alignment + 1 + offset] ^= source[alignment + offset];
+			}
+
+			FecXor::Xor(destination.data() + alignment + 1, source.data() + alignment, length);
+
+			OV_TEST_ASSERT(destination == expected);
+		}
+	}
+}
+
+static void TestConsecutive()
+{
+	std::mt19937 random(2);
+	// The sequence numbers wrap around in the frame
+	auto frame = MakeFrame(random, 65530, 30);
+	auto fec_packets = GenerateFec(UlpfecMaskType::Consecutive, frame);
+
+	// 1 FEC packet per 10 media packets
+	OV_TEST_ASSERT(fec_packets.size() == 3);
+
+	VerifyFrame(frame, fec_packets);
+
+	for (auto &fec_packet : fec_packets)
+	{
+		auto &sequence_numbers = fec_packet.protected_sequence_numbers;
+
+		OV_TEST_ASSERT(static_cast<uint16_t>(sequence_numbers.back() - sequence_numbers.front()) == sequence_numbers.size() - 1);
+	}
+
+	// A burst in a group cannot be recovered
+	OV_TEST_ASSERT(IsBurstRecoverable(fec_packets, 65530, 2) == false);
+}
+
+static void TestInterleaved()
+{
+	std::mt19937 random(3);
+	auto frame = MakeFrame(random, 65530, 30);
+	auto fec_packets = GenerateFec(UlpfecMaskType::Interleaved, frame);
+
+	OV_TEST_ASSERT(fec_packets.size() == 3);
+
+	VerifyFrame(frame, fec_packets);
+
+	// A burst of up to 3 (the number of FEC packets) media packets can be recovered anywhere in the frame
+	for (size_t index = 0; index + 3 <= frame.size(); index++)
+	{
+		OV_TEST_ASSERT(IsBurstRecoverable(fec_packets, static_cast<uint16_t>(65530 + index), 3));
+	}
+
+	// Larger frames are split into windows that fit in the mask (48 packets, L=1)
+	for (size_t packet_count : {1, 9, 16, 17, 48, 49, 100, 150})
+	{
+		auto frame = MakeFrame(random, 1000, packet_count);
+
+		VerifyFrame(frame, GenerateFec(UlpfecMaskType::Interleaved, frame));
+	}
+}
+
+// The loop that UlpfecGenerator::XorFecPacket() used to have (not inlined, so that it is compiled like it was)
+static void __attribute__((noinline)) XorByteLoop(uint8_t *destination, const uint8_t *source, size_t length)
+{
+	for (size_t offset = 0; offset < length; offset++)
+	{
+		destination[offset] ^= source[offset];
+	}
+}
+
+static void BenchXor()
+{
+	constexpr int COUNT = 1000000;
+	// A typical payload of a video packet
+	constexpr size_t LENGTH = 1200;
+
+	std::vector<uint8_t> destination(LENGTH + 1, 0x5A);
+	std::vector<uint8_t> source(LENGTH + 1, 0xA5);
+
+	auto byte_loop_time = ov::test::MeasureMilliseconds([&]() {
+		for (int index = 0; index < COUNT; index++)
+		{
+			// Unaligned, like the payloads in the packets
+			XorByteLoop(destination.data() + 1, source.data() + (index & 1), LENGTH);
+		}
+	});
+
+	auto xor_time = ov::test::MeasureMilliseconds([&]() {
+		for (int index = 0; index < COUNT; index++)
+		{
+			FecXor::Xor(destination.data() + 1, source.data() + (index & 1), LENGTH);
+		}
+	});
+
+	// The buffer is XORed with 0xA5 for 2 * COUNT times
+	OV_TEST_ASSERT(destination[1] == 0x5A);
+
+	auto throughput = [&](double elapsed) -> double {
+		return (static_cast<double>(LENGTH) * COUNT / (1024.0 * 1024.0 * 1024.0)) / (elapsed / 1000.0);
+	};
+
+	::printf("  %zu bytes x %d: byte loop %.2fms (%.2f GB/s), %s %.2fms (%.2f GB/s)\n",
+			 LENGTH, COUNT, byte_loop_time, throughput(byte_loop_time), FecXor::GetImplementationName(), xor_time, throughput(xor_time));
+}
+
+static void BenchGenerator()
+{
+	constexpr int COUNT = 2000;
+
+	std::mt19937 random(4);
+	// About a 1080p key frame
+	auto frame = MakeFrame(random, 0, 100);
+
+	for (auto mask_type : {UlpfecMaskType::Consecutive, UlpfecMaskType::Interleaved})
+	{
+		UlpfecGenerator generator;
+		RtpPacket fec_packet;
+		size_t fec_packet_count = 0;
+
+		generator.SetMaskType(mask_type);
+
+		auto elapsed = ov::test::MeasureMilliseconds([&]() {
+			for (int index = 0; index < COUNT; index++)
+			{
+				for (auto &packet : frame)
+				{
+					generator.AddRtpPacketAndGenerateFec(packet);
+				}
+
+				while (generator.NextPacket(&fec_packet))
+				{
+					fec_packet_count++;
+				}
+			}
+		});
+
+		::printf("  %s: %d frames of %zu packets in %.2fms (%.2f us/frame, %zu FEC packets)\n",
+				 (mask_type == UlpfecMaskType::Consecutive) ? "Consecutive" : "Interleaved",
+				 COUNT, frame.size(), elapsed, elapsed * 1000.0 / COUNT, fec_packet_count);
+	}
+}
+
+int main()
+{
+	OV_TEST_RUN(TestXor);
+	OV_TEST_RUN(TestConsecutive);
+	OV_TEST_RUN(TestInterleaved);
+	OV_TEST_RUN(BenchXor);
+	OV_TEST_RUN(BenchGenerator);
+
+	return 0;
+}
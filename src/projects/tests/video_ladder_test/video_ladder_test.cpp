@@ -0,0 +1,438 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include <tests/test_common.h>
+#include <time.h>
+#include <transcode/filter/media_filter_rescaler.h>
+#include <transcode/transcode_filter.h>
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+#define TEST_INPUT_WIDTH (1920)
+#define TEST_INPUT_HEIGHT (1080)
+#define TEST_FRAME_RATE (30.0f)
+#define TEST_FRAME_DURATION (90000 / 30)
+#define TEST_FRAME_COUNT (300)
+// The number of the frames waiting for a rendition (like the queue of a stage)
+#define TEST_QUEUE_SIZE (8)
+
+struct Rendition
+{
+	const char *name;
+	uint32_t width;
+	uint32_t height;
+};
+
+// 1080p in, 720/480/360 out
+static const std::vector<Rendition> kLadder = {
+	{"720p", 1280, 720},
+	{"480p", 854, 480},
+	{"360p", 640, 360},
+};
+
+static std::shared_ptr<TranscodeContext> MakeContext(uint32_t width, uint32_t height, float frame_rate)
+{
+	return std::make_shared<TranscodeContext>(true, common::MediaCodecId::H264, 1000000, width, height, frame_rate);
+}
+
+static double ThreadCpuMilliseconds()
+{
+	timespec ts{};
+
+	::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// Frames are passed between the threads like between the stages of a stream, but nothing is dropped
+class FrameQueue
+{
+public:
+	void Push(std::shared_ptr<MediaFrame> frame)
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		_condition.wait(lock, [this]() { return _queue.size() < TEST_QUEUE_SIZE; });
+
+		_queue.push_back(std::move(frame));
+		_condition.notify_all();
+	}
+
+	// Returns nullptr after Close()
+	std::shared_ptr<MediaFrame> Pop()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		_condition.wait(lock, [this]() { return (_queue.empty() == false) || _closed; });
+
+		if (_queue.empty())
+		{
+			return nullptr;
+		}
+
+		auto frame = std::move(_queue.front());
+		_queue.pop_front();
+		_condition.notify_all();
+
+		return frame;
+	}
+
+	void Close()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_closed = true;
+		_condition.notify_all();
+	}
+
+private:
+	std::mutex _mutex;
+	std::condition_variable _condition;
+	std::deque<std::shared_ptr<MediaFrame>> _queue;
+	bool _closed = false;
+};
+
+class Ladder
+{
+public:
+	// parents: the rendition to scale each rendition from, or -1 to scale from the input frame (See MediaFilterRescaler::MakeCascade())
+	explicit Ladder(const std::vector<ssize_t> &parents)
+		: _parents(parents)
+	{
+		_input_track = std::make_shared<MediaTrack>();
+		_input_track->SetId(0);
+		_input_track->SetMediaType(common::MediaType::Video);
+		_input_track->SetWidth(TEST_INPUT_WIDTH);
+		_input_track->SetHeight(TEST_INPUT_HEIGHT);
+		_input_track->SetFormat(AV_PIX_FMT_YUV420P);
+		_input_track->SetTimeBase(1, 90000);
+
+		_input_context = std::make_shared<TranscodeContext>(false, common::MediaCodecId::H264, 0, TEST_INPUT_WIDTH, TEST_INPUT_HEIGHT, TEST_FRAME_RATE);
+
+		for (auto &rendition : kLadder)
+		{
+			_output_contexts.push_back(MakeContext(rendition.width, rendition.height, TEST_FRAME_RATE));
+		}
+
+		for (size_t index = 0; index < kLadder.size(); index++)
+		{
+			auto input_track = _input_track;
+			auto input_context = _input_context;
+
+			// Same as TranscodeStream::CreateFilters()
+			if (_parents[index] >= 0)
+			{
+				auto &parent_context = _output_contexts[_parents[index]];
+
+				input_track = std::make_shared<MediaTrack>(*_input_track);
+				input_track->SetWidth(parent_context->GetVideoWidth());
+				input_track->SetHeight(parent_context->GetVideoHeight());
+				input_track->SetFormat(AV_PIX_FMT_YUV420P);
+				input_track->SetTimeBase(parent_context->GetTimeBase().GetNum(), parent_context->GetTimeBase().GetDen());
+
+				input_context = parent_context;
+			}
+
+			auto filter = std::make_shared<TranscodeFilter>();
+			OV_TEST_ASSERT(filter->Configure(input_track, input_context, _output_contexts[index]));
+
+			_filters.push_back(filter);
+		}
+
+		_frame_counts.resize(kLadder.size(), 0);
+		_cpu_milliseconds.resize(kLadder.size(), 0.0);
+
+		for (int pattern = 0; pattern < 4; pattern++)
+		{
+			std::vector<uint8_t> plane(TEST_INPUT_WIDTH * TEST_INPUT_HEIGHT);
+
+			for (size_t offset = 0; offset < plane.size(); offset++)
+			{
+				plane[offset] = static_cast<uint8_t>((offset % TEST_INPUT_WIDTH) + (offset / TEST_INPUT_WIDTH) * pattern);
+			}
+
+			_patterns.push_back(std::move(plane));
+		}
+	}
+
+	// All renditions are scaled in one thread, like on one stage
+	void RunSerially()
+	{
+		for (int index = 0; index < TEST_FRAME_COUNT; index++)
+		{
+			auto frame = MakeInputFrame(index);
+
+			for (size_t rendition = 0; rendition < kLadder.size(); rendition++)
+			{
+				if (_parents[rendition] < 0)
+				{
+					Scale(rendition, frame);
+				}
+			}
+		}
+	}
+
+	// Each rendition is scaled in its own thread, like on its own stage
+	void RunInParallel()
+	{
+		std::vector<std::shared_ptr<FrameQueue>> queues;
+		std::vector<std::thread> threads;
+
+		for (size_t rendition = 0; rendition < kLadder.size(); rendition++)
+		{
+			queues.push_back(std::make_shared<FrameQueue>());
+		}
+
+		for (size_t rendition = 0; rendition < kLadder.size(); rendition++)
+		{
+			threads.emplace_back([&, rendition]() {
+				double start = ThreadCpuMilliseconds();
+
+				while (true)
+				{
+					auto frame = queues[rendition]->Pop();
+
+					if (frame == nullptr)
+					{
+						break;
+					}
+
+					FilterFrame(rendition, std::move(frame), [&](size_t child, std::shared_ptr<MediaFrame> output_frame) {
+						queues[child]->Push(std::move(output_frame));
+					});
+				}
+
+				// The children get no more frames
+				for (size_t child = 0; child < kLadder.size(); child++)
+				{
+					if (_parents[child] == static_cast<ssize_t>(rendition))
+					{
+						queues[child]->Close();
+					}
+				}
+
+				_cpu_milliseconds[rendition] = ThreadCpuMilliseconds() - start;
+			});
+		}
+
+		for (int index = 0; index < TEST_FRAME_COUNT; index++)
+		{
+			// The input frame is only read by the renditions, so it is shared (See TranscodeStream::DoFilters())
+			auto frame = MakeInputFrame(index);
+
+			for (size_t rendition = 0; rendition < kLadder.size(); rendition++)
+			{
+				if (_parents[rendition] < 0)
+				{
+					queues[rendition]->Push(frame);
+				}
+			}
+		}
+
+		for (size_t rendition = 0; rendition < kLadder.size(); rendition++)
+		{
+			if (_parents[rendition] < 0)
+			{
+				queues[rendition]->Close();
+			}
+		}
+
+		for (auto &thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	const std::vector<size_t> &GetFrameCounts() const
+	{
+		return _frame_counts;
+	}
+
+	const std::vector<double> &GetCpuMilliseconds() const
+	{
+		return _cpu_milliseconds;
+	}
+
+private:
+	std::shared_ptr<MediaFrame> MakeInputFrame(int index)
+	{
+		auto &pattern = _patterns[index % _patterns.size()];
+		auto frame = std::make_shared<MediaFrame>();
+
+		frame->SetMediaType(common::MediaType::Video);
+		frame->SetTrackId(0);
+		frame->SetFormat(AV_PIX_FMT_YUV420P);
+		frame->SetWidth(TEST_INPUT_WIDTH);
+		frame->SetHeight(TEST_INPUT_HEIGHT);
+		frame->SetPts(static_cast<int64_t>(index) * TEST_FRAME_DURATION);
+		frame->SetDuration(TEST_FRAME_DURATION);
+
+		frame->SetStride(TEST_INPUT_WIDTH, 0);
+		frame->SetStride(TEST_INPUT_WIDTH / 2, 1);
+		frame->SetStride(TEST_INPUT_WIDTH / 2, 2);
+
+		frame->SetBuffer(pattern.data(), TEST_INPUT_WIDTH * TEST_INPUT_HEIGHT, 0);
+		frame->SetBuffer(pattern.data(), TEST_INPUT_WIDTH * TEST_INPUT_HEIGHT / 4, 1);
+		frame->SetBuffer(pattern.data(), TEST_INPUT_WIDTH * TEST_INPUT_HEIGHT / 4, 2);
+
+		return frame;
+	}
+
+	// Scales the frame, and passes the results to the children of the rendition
+	template <typename Push>
+	void FilterFrame(size_t rendition, std::shared_ptr<MediaFrame> frame, Push push)
+	{
+		auto &filter = _filters[rendition];
+
+		filter->SendBuffer(std::move(frame));
+
+		while (true)
+		{
+			TranscodeResult result;
+			auto output_frame = filter->RecvBuffer(&result);
+
+			if (result != TranscodeResult::DataReady)
+			{
+				break;
+			}
+
+			OV_TEST_ASSERT(output_frame->GetWidth() == static_cast<int32_t>(kLadder[rendition].width));
+			OV_TEST_ASSERT(output_frame->GetHeight() == static_cast<int32_t>(kLadder[rendition].height));
+
+			_frame_counts[rendition]++;
+
+			for (size_t child = 0; child < kLadder.size(); child++)
+			{
+				if (_parents[child] == static_cast<ssize_t>(rendition))
+				{
+					push(child, output_frame);
+				}
+			}
+		}
+	}
+
+	// Used by RunSerially(): the children are scaled right away, and the time of each rendition is measured separately
+	void Scale(size_t rendition, std::shared_ptr<MediaFrame> frame)
+	{
+		std::vector<std::pair<size_t, std::shared_ptr<MediaFrame>>> children;
+
+		double start = ThreadCpuMilliseconds();
+
+		FilterFrame(rendition, std::move(frame), [&](size_t child, std::shared_ptr<MediaFrame> output_frame) {
+			children.emplace_back(child, std::move(output_frame));
+		});
+
+		_cpu_milliseconds[rendition] += ThreadCpuMilliseconds() - start;
+
+		for (auto &child : children)
+		{
+			Scale(child.first, std::move(child.second));
+		}
+	}
+
+	std::vector<ssize_t> _parents;
+
+	std::shared_ptr<MediaTrack> _input_track;
+	std::shared_ptr<TranscodeContext> _input_context;
+	std::vector<std::shared_ptr<TranscodeContext>> _output_contexts;
+	std::vector<std::shared_ptr<TranscodeFilter>> _filters;
+
+	std::vector<std::vector<uint8_t>> _patterns;
+
+	std::vector<size_t> _frame_counts;
+	std::vector<double> _cpu_milliseconds;
+};
+
+static std::vector<ssize_t> MakeLadderCascade()
+{
+	std::vector<std::shared_ptr<TranscodeContext>> output_contexts;
+
+	for (auto &rendition : kLadder)
+	{
+		output_contexts.push_back(MakeContext(rendition.width, rendition.height, TEST_FRAME_RATE));
+	}
+
+	return MediaFilterRescaler::MakeCascade(output_contexts);
+}
+
+static void TestMakeCascade()
+{
+	// Each rendition is scaled from the next larger one
+	OV_TEST_ASSERT(MakeLadderCascade() == (std::vector<ssize_t>{-1, 0, 1}));
+
+	// The order of the renditions does not matter
+	OV_TEST_ASSERT(MediaFilterRescaler::MakeCascade({MakeContext(640, 360, 30.0f), MakeContext(1920, 1080, 30.0f), MakeContext(1280, 720, 30.0f)}) ==
+				   (std::vector<ssize_t>{2, -1, 1}));
+
+	// A rendition with more frames than the larger one is scaled from the input frame
+	OV_TEST_ASSERT(MediaFilterRescaler::MakeCascade({MakeContext(1280, 720, 30.0f), MakeContext(854, 480, 60.0f)}) ==
+				   (std::vector<ssize_t>{-1, -1}));
+
+	// So is a rendition with another timebase
+	auto context = MakeContext(854, 480, 30.0f);
+	context->SetTimeBase(1, 1000);
+
+	OV_TEST_ASSERT(MediaFilterRescaler::MakeCascade({MakeContext(1280, 720, 30.0f), context}) == (std::vector<ssize_t>{-1, -1}));
+
+	// A rendition with the other aspect ratio is not scaled from a narrower one
+	OV_TEST_ASSERT(MediaFilterRescaler::MakeCascade({MakeContext(1280, 720, 30.0f), MakeContext(720, 720, 30.0f)}) == (std::vector<ssize_t>{-1, 0}));
+	OV_TEST_ASSERT(MediaFilterRescaler::MakeCascade({MakeContext(1280, 720, 30.0f), MakeContext(480, 800, 30.0f)}) == (std::vector<ssize_t>{-1, -1}));
+}
+
+static void RunBench(const char *name, const std::vector<ssize_t> &parents, bool in_parallel)
+{
+	Ladder ladder(parents);
+
+	auto elapsed = ov::test::MeasureMilliseconds([&]() {
+		if (in_parallel)
+		{
+			ladder.RunInParallel();
+		}
+		else
+		{
+			ladder.RunSerially();
+		}
+	});
+
+	::printf("  %s: %d frames in %.2fms (%.2f fps)\n", name, TEST_FRAME_COUNT, elapsed, TEST_FRAME_COUNT / (elapsed / 1000.0));
+
+	for (size_t rendition = 0; rendition < kLadder.size(); rendition++)
+	{
+		auto frame_count = ladder.GetFrameCounts()[rendition];
+		auto cpu = ladder.GetCpuMilliseconds()[rendition];
+
+		// The fps filter may keep the last frame
+		OV_TEST_ASSERT(frame_count + 2 >= TEST_FRAME_COUNT);
+
+		::printf("    %s (from %s): %.2f fps, CPU %.2fms (%.3fms/frame)\n",
+				 kLadder[rendition].name, (parents[rendition] < 0) ? "input" : kLadder[parents[rendition]].name,
+				 frame_count / (elapsed / 1000.0), cpu, cpu / frame_count);
+	}
+}
+
+static void BenchLadder()
+{
+	std::vector<ssize_t> independent(kLadder.size(), -1);
+	auto cascade = MakeLadderCascade();
+
+	::printf("  %zu CPU(s)\n", static_cast<size_t>(std::thread::hardware_concurrency()));
+
+	RunBench("Independent, stage per rendition", independent, true);
+	// Same as the previous "Scaler" stage, which scaled all renditions of a track
+	RunBench("Cascade, one stage", cascade, false);
+	RunBench("Cascade, stage per rendition", cascade, true);
+}
+
+int main()
+{
+	OV_TEST_RUN(TestMakeCascade);
+	OV_TEST_RUN(BenchLadder);
+
+	return 0;
+}
@@ -68,7 +68,7 @@ bool OvenCodecImplAvcodecEncAVC::Configure(std::shared_ptr<TranscodeContext> con
 	AVRational codec_timebase = ::av_inv_q(::av_mul_q(::av_d2q(_output_context->GetFrameRate(), AV_TIME_BASE), (AVRational){_context->ticks_per_frame, 1}));
 	_context->time_base = codec_timebase;
 
-	_context->gop_size = _context->framerate.num / _context->framerate.den;
+	_context->gop_size = std::max(static_cast<int>(_output_context->GetFrameRate() * TRANSCODE_KEY_FRAME_INTERVAL), 1);
 	_context->max_b_frames = 0;
 	_context->pix_fmt = AV_PIX_FMT_YUV420P;
 	_context->width = _output_context->GetVideoWidth();
@@ -90,7 +90,10 @@ bool OvenCodecImplAvcodecEncAVC::Configure(std::shared_ptr<TranscodeContext> con
 	::av_opt_set(_context->priv_data, "tune", "zerolatency", 0);
 
 	// 인코딩 딜레이에서 sliced-thread 옵션 제거. MAC 환경에서 브라우저 호환성
-	::av_opt_set(_context->priv_data, "x264opts", "bframes=0:sliced-threads=0:b-adapt=1:no-scenecut:keyint=30:min-keyint=30", 0);
+	::av_opt_set(_context->priv_data, "x264opts", ov::String::FormatString("bframes=0:sliced-threads=0:b-adapt=1:no-scenecut:keyint=%d:min-keyint=%d", _context->gop_size, _context->gop_size).CStr(), 0);
+
+	// The key frame that is requested by a viewer (AV_PICTURE_TYPE_I) must be an IDR, otherwise the viewer cannot start decoding
+	::av_opt_set(_context->priv_data, "forced-idr", "1", 0);
 	// ::av_opt_set(_context->priv_data, "x264opts", "bframes=0:sliced-threads=0:b-adapt=1", 0);
 
 	// CBR 옵션 / bitrate는 kbps 단위 / *문제는 MAC 크롬에서 재생이 안된다. 그래서 maxrate 값만 지정해줌.
@@ -186,6 +189,9 @@ void OvenCodecImplAvcodecEncAVC::ThreadEncode()
 		::memcpy(_frame->data[1], frame->GetBuffer(1), frame->GetBufferSize(1));
 		::memcpy(_frame->data[2], frame->GetBuffer(2), frame->GetBufferSize(2));
 
+		// A viewer requested a key frame
+		_frame->pict_type = IsKeyFrameRequested() ? AV_PICTURE_TYPE_I : AV_PICTURE_TYPE_NONE;
+
 		int ret = ::avcodec_send_frame(_context, _frame);
 		// int ret = 0;
 		::av_frame_unref(_frame);
@@ -49,7 +49,7 @@ bool OvenCodecImplAvcodecEncVP8::Configure(std::shared_ptr<TranscodeContext> con
 	_context->sample_aspect_ratio = (AVRational){1, 1};
 	_context->time_base = TimebaseToAVRational(_output_context->GetTimeBase());
 	_context->framerate = ::av_d2q(_output_context->GetFrameRate(), AV_TIME_BASE);
-	_context->gop_size = _output_context->GetFrameRate() * 1;  // create keyframes every second
+	_context->gop_size = std::max(static_cast<int>(_output_context->GetFrameRate() * TRANSCODE_KEY_FRAME_INTERVAL), 1);
 	_context->max_b_frames = 0;
 	_context->pix_fmt = AV_PIX_FMT_YUV420P;
 	_context->width = _output_context->GetVideoWidth();
@@ -154,6 +154,9 @@ void OvenCodecImplAvcodecEncVP8::ThreadEncode()
 		::memcpy(_frame->data[1], frame->GetBuffer(1), frame->GetBufferSize(1));
 		::memcpy(_frame->data[2], frame->GetBuffer(2), frame->GetBufferSize(2));
 
+		// A viewer requested a key frame
+		_frame->pict_type = IsKeyFrameRequested() ? AV_PICTURE_TYPE_I : AV_PICTURE_TYPE_NONE;
+
 		int ret = ::avcodec_send_frame(_context, _frame);
 		// int ret = 0;
 		::av_frame_unref(_frame);
@@ -101,6 +101,16 @@ std::shared_ptr<TranscodeContext>& TranscodeEncoder::GetContext()
 	return _output_context;
 }
 
+void TranscodeEncoder::RequestKeyFrame()
+{
+	_key_frame_requested = true;
+}
+
+bool TranscodeEncoder::IsKeyFrameRequested()
+{
+	return _key_frame_requested.exchange(false);
+}
+
 void TranscodeEncoder::ThreadEncode()
 {
 	// nothing...
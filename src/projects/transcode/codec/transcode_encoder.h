@@ -10,6 +10,10 @@
 
 #include "transcode_base.h"
 
+// Interval of the periodic key frames of video encoders (in seconds)
+// The viewers that join mid-GOP (or lose packets) request a key frame (See RequestKeyFrame()), so a long GOP does not delay them
+#define TRANSCODE_KEY_FRAME_INTERVAL 2
+
 class TranscodeEncoder : public TranscodeBase<MediaFrame, MediaPacket>
 {
 public:
@@ -28,7 +32,14 @@ public:
 
 	virtual void Stop();
 
+	// The next frame will be encoded as a key frame (IDR)
+	// The requests that are made before the next frame is encoded are merged into one key frame
+	void RequestKeyFrame();
+
 protected:
+	// Returns true if the frame should be encoded as a key frame (called by the encoding thread)
+	bool IsKeyFrameRequested();
+
 	std::shared_ptr<TranscodeContext> _output_context = nullptr;
 
 	AVCodecContext *_context = nullptr;
@@ -43,6 +54,7 @@ protected:
 	int _decoded_frame_num = 0;
 
 	bool _kill_flag = false;
+	std::atomic<bool> _key_frame_requested{false};
 	std::mutex _mutex;
 	std::thread _thread_work;
 	ov::Semaphore _queue_event;
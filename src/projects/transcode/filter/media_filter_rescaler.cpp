@@ -29,14 +29,15 @@ MediaFilterRescaler::MediaFilterRescaler()
 
 MediaFilterRescaler::~MediaFilterRescaler()
 {
-	Stop();
-
 	OV_SAFE_FUNC(_frame, nullptr, ::av_frame_free, &);
 
 	OV_SAFE_FUNC(_inputs, nullptr, ::avfilter_inout_free, &);
 	OV_SAFE_FUNC(_outputs, nullptr, ::avfilter_inout_free, &);
 
 	OV_SAFE_FUNC(_filter_graph, nullptr, ::avfilter_graph_free, &);
+
+	_input_buffer.clear();
+	_output_buffer.clear();
 }
 
 bool MediaFilterRescaler::Configure(const std::shared_ptr<MediaTrack> &input_media_track, const std::shared_ptr<TranscodeContext> &input_context, const std::shared_ptr<TranscodeContext> &output_context)
@@ -71,7 +72,9 @@ bool MediaFilterRescaler::Configure(const std::shared_ptr<MediaTrack> &input_med
 	// Prepare filters
 	//
 	// Filter graph:
-	//     [buffer] -> [fps] -> [scale] -> [settb] -> [buffersink]
+	//     [buffer] -> [format] -> [fps] -> [scale] -> [settb] -> [buffersink]
+	//
+	// The input of a cascaded output is already yuv420p (See MakeCascade()), so [format] passes it through
 
 	// Prepare the input filter
 
@@ -96,8 +99,6 @@ bool MediaFilterRescaler::Configure(const std::shared_ptr<MediaTrack> &input_med
 		input_media_track->GetTimeBase().GetNum(), input_media_track->GetTimeBase().GetDen(),
 		1, 1);
 
-
-
 	ret = ::avfilter_graph_create_filter(&_buffersrc_ctx, buffersrc, "in", input_args, nullptr, _filter_graph);
 	if (ret < 0)
 	{
@@ -107,6 +108,8 @@ bool MediaFilterRescaler::Configure(const std::shared_ptr<MediaTrack> &input_med
 
 	// Prepare output filters
 	std::vector<ov::String> filters = {
+		// "format" filter options
+		"format=pix_fmts=yuv420p",
 		// "fps" filter options
 		ov::String::FormatString("fps=fps=%.2f:0:round=near", output_context->GetFrameRate()),
 		// "scale" filter options
@@ -161,175 +164,139 @@ bool MediaFilterRescaler::Configure(const std::shared_ptr<MediaTrack> &input_med
 	_input_context = input_context;
 	_output_context = output_context;
 
-	// Generates a thread that reads and encodes frames in the input_buffer queue and places them in the output queue.
-	try
-	{
-		_kill_flag = false;
-
-		_thread_work = std::thread(&MediaFilterRescaler::ThreadEncode, this);
-	}
-	catch (const std::system_error &e)
-	{
-		_kill_flag = true;
-
-		logte("Failed to start transcode rescale filter thread.");
-	}
-
 	return true;
 }
 
-int32_t MediaFilterRescaler::SendBuffer(std::shared_ptr<MediaFrame> buffer)
+std::vector<ssize_t> MediaFilterRescaler::MakeCascade(const std::vector<std::shared_ptr<TranscodeContext>> &output_contexts)
 {
-	//logtp("Data before rescaling: %lld (%.0f)\n%s", buffer->GetPts(), buffer->GetPts() * _output_context->GetTimeBase().GetExpr() * 1000.0f, ov::Dump(buffer->GetBuffer(0), buffer->GetBufferSize(0), 32).CStr());
-	std::unique_lock<std::mutex> mlock(_mutex);
+	size_t output_count = output_contexts.size();
 
-	_input_buffer.push_back(std::move(buffer));
-	
-	mlock.unlock();
-	
-	_queue_event.Notify();;
+	// Larger outputs first
+	std::vector<size_t> order(output_count);
+	for (size_t index = 0; index < output_count; index++)
+	{
+		order[index] = index;
+	}
 
-	return 0;
-}
+	auto area = [&](size_t index) -> int64_t {
+		return static_cast<int64_t>(output_contexts[index]->GetVideoWidth()) * output_contexts[index]->GetVideoHeight();
+	};
 
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) -> bool {
+		if (area(a) != area(b))
+		{
+			return area(a) > area(b);
+		}
 
-void MediaFilterRescaler::Stop()
-{
-	_kill_flag = true;
+		return output_contexts[a]->GetFrameRate() > output_contexts[b]->GetFrameRate();
+	});
 
-	_queue_event.Notify();
+	std::vector<ssize_t> parents(output_count, -1);
 
-	if (_thread_work.joinable())
+	for (size_t position = 0; position < output_count; position++)
 	{
-		_thread_work.join();
-		logtd("Terminated transcode rescale filter thread.");
+		auto index = order[position];
+		auto &context = output_contexts[index];
+
+		for (size_t candidate_position = 0; candidate_position < position; candidate_position++)
+		{
+			auto candidate = order[candidate_position];
+			auto &candidate_context = output_contexts[candidate];
+
+			// The timestamps of the frames of the candidate are already in its timebase
+			if ((candidate_context->GetVideoWidth() >= context->GetVideoWidth()) &&
+				(candidate_context->GetVideoHeight() >= context->GetVideoHeight()) &&
+				(candidate_context->GetFrameRate() >= context->GetFrameRate()) &&
+				(::av_cmp_q(TimebaseToAVRational(candidate_context->GetTimeBase()), TimebaseToAVRational(context->GetTimeBase())) == 0))
+			{
+				// Outputs are sorted, so the last one found is the smallest
+				parents[index] = static_cast<ssize_t>(candidate);
+			}
+		}
 	}
+
+	return parents;
 }
 
-void MediaFilterRescaler::ThreadEncode()
+int32_t MediaFilterRescaler::SendBuffer(std::shared_ptr<MediaFrame> buffer)
 {
-	logtd("Start transcode rescaler filter thread.");
+	//logtp("Data before rescaling: %lld (%.0f)\n%s", buffer->GetPts(), buffer->GetPts() * _output_context->GetTimeBase().GetExpr() * 1000.0f, ov::Dump(buffer->GetBuffer(0), buffer->GetBufferSize(0), 32).CStr());
 
-	while(!_kill_flag)
+	// The planes are copied into the buffers of the pool, and return to the pool when the graph releases the frame
+	if (_frame_pool.FillFrame(_frame, buffer) == false)
 	{
-		_queue_event.Wait();
+		logte("Could not allocate the video frame data");
+		return -1;
+	}
 
-		std::unique_lock<std::mutex> mlock(_mutex);
+	_frame->pts = buffer->GetPts() * _scale;
+	_frame->pkt_duration = buffer->GetDuration();
 
-		if(_input_buffer.empty())
-		{
-			continue;
-		}
+	// The graph takes the ownership of the frame buffers
+	int ret = ::av_buffersrc_add_frame_flags(_buffersrc_ctx, _frame, 0);
+	if (ret < 0)
+	{
+		logte("An error occurred while feeding the video filtergraph: format: %d, pts: %lld, linesize: %d", _frame->format, _frame->pts, _frame->linesize[0]);
 
-		// Dequeue a packet
-		auto frame = std::move(_input_buffer.front());
-		_input_buffer.pop_front();
+		::av_frame_unref(_frame);
 
-		mlock.unlock();
+		return ret;
+	}
 
-		//logtp("Dequeued data for rescaling: %lld (%.0f)\n%s", frame->GetPts(), frame->GetPts() * _output_context->GetTimeBase().GetExpr() * 1000.0f, ov::Dump(frame->GetBuffer(0), frame->GetBufferSize(0), 32).CStr());
+	ReceiveFrames();
 
-		_frame->format = frame->GetFormat();
-		_frame->width = frame->GetWidth();
-		_frame->height = frame->GetHeight();
-		_frame->pts = frame->GetPts() * _scale;
-		_frame->pkt_duration = frame->GetDuration();
+	return 0;
+}
 
-		_frame->linesize[0] = frame->GetStride(0);
-		_frame->linesize[1] = frame->GetStride(1);
-		_frame->linesize[2] = frame->GetStride(2);
+void MediaFilterRescaler::ReceiveFrames()
+{
+	while (true)
+	{
+		// 출력될 프레임이 있는지 확인함
+		int ret = ::av_buffersink_get_frame(_buffersink_ctx, _frame);
 
-		int ret = ::av_frame_get_buffer(_frame, 32);
-		if (ret < 0)
+		if (ret == AVERROR(EAGAIN))
 		{
-			logte("Could not allocate the video frame data\n");
-
-			// *result = TranscodeResult::DataError;
+			// Need more data
 			break;
 		}
-
-		ret = ::av_frame_make_writable(_frame);
-		if (ret < 0)
+		else if (ret == AVERROR_EOF)
 		{
-			logte("Could not make writable frame: %d", ret);
-
-			// *result = TranscodeResult::DataError;
+			logte("End of file: %d", ret);
 			break;
 		}
-
-		// Copy data of frame to _frame
-		::memcpy(_frame->data[0], frame->GetBuffer(0), frame->GetBufferSize(0));
-		::memcpy(_frame->data[1], frame->GetBuffer(1), frame->GetBufferSize(1));
-		::memcpy(_frame->data[2], frame->GetBuffer(2), frame->GetBufferSize(2));
-
-		if (::av_buffersrc_add_frame_flags(_buffersrc_ctx, _frame, AV_BUFFERSRC_FLAG_KEEP_REF) < 0)
+		else if (ret < 0)
 		{
-			logte("An error occurred while feeding the audio filtergraph: format: %d, pts: %lld, linesize: %d, size: %d", _frame->format, _frame->pts, _frame->linesize[0], _input_buffer.size());
-		
-			std::unique_lock<std::mutex> mlock(_mutex);
-			_input_buffer.push_front(std::move(frame));
-			mlock.unlock();
-			_queue_event.Notify();
+			logte("Unknown error is occurred while get frame: %d", ret);
+			break;
 		}
 
-		::av_frame_unref(_frame);
-	
+		auto output_frame = std::make_shared<MediaFrame>();
 
-		while (true)
-		{
-			// 출력될 프레임이 있는지 확인함
-			int ret = ::av_buffersink_get_frame(_buffersink_ctx, _frame);
+		output_frame->SetFormat(_frame->format);
+		output_frame->SetWidth(_frame->width);
+		output_frame->SetHeight(_frame->height);
+		output_frame->SetPts((_frame->pts == AV_NOPTS_VALUE) ? -1LL : _frame->pts);
+		output_frame->SetDuration(_frame->pkt_duration * _scale);
 
-			if (ret == AVERROR(EAGAIN))
-			{
-				// Need more data
-				break;
-			}
-			else if (ret == AVERROR_EOF)
-			{
-				logte("End of file: %d", ret);
-				// *result = TranscodeResult::EndOfFile;
-				// return nullptr;
-				break;
-			}
-			else if (ret < 0)
-			{
-				logte("Unknown error is occurred while get frame: %d", ret);
-				// *result = TranscodeResult::DataError;
-				// return nullptr;
-				break;
-			}
-			else
-			{
-				auto output_frame = std::make_shared<MediaFrame>();
-
-				output_frame->SetFormat(_frame->format);
-				output_frame->SetWidth(_frame->width);
-				output_frame->SetHeight(_frame->height);
-				output_frame->SetPts((_frame->pts == AV_NOPTS_VALUE) ? -1LL : _frame->pts);
-				output_frame->SetDuration(_frame->pkt_duration * _scale);
+		output_frame->SetStride(_frame->linesize[0], 0);
+		output_frame->SetStride(_frame->linesize[1], 1);
+		output_frame->SetStride(_frame->linesize[2], 2);
 
-				output_frame->SetStride(_frame->linesize[0], 0);
-				output_frame->SetStride(_frame->linesize[1], 1);
-				output_frame->SetStride(_frame->linesize[2], 2);
+		output_frame->SetBuffer(_frame->data[0], output_frame->GetStride(0) * output_frame->GetHeight(), 0);	  // Y-Plane
+		output_frame->SetBuffer(_frame->data[1], output_frame->GetStride(1) * output_frame->GetHeight() / 2, 1);  // Cb Plane
+		output_frame->SetBuffer(_frame->data[2], output_frame->GetStride(2) * output_frame->GetHeight() / 2, 2);  // Cr Plane
 
-				output_frame->SetBuffer(_frame->data[0], output_frame->GetStride(0) * output_frame->GetHeight(), 0);	  // Y-Plane
-				output_frame->SetBuffer(_frame->data[1], output_frame->GetStride(1) * output_frame->GetHeight() / 2, 1);  // Cb Plane
-				output_frame->SetBuffer(_frame->data[2], output_frame->GetStride(2) * output_frame->GetHeight() / 2, 2);  // Cr Plane
+		//logtp("Rescaled data: %lld (%.0f)\n%s", output_frame->GetPts(), output_frame->GetPts() * _output_context->GetTimeBase().GetExpr() * 1000.0f, ov::Dump(_frame->data[0], _frame->linesize[0], 32).CStr());
 
-				//logtp("Rescaled data: %lld (%.0f)\n%s", output_frame->GetPts(), output_frame->GetPts() * _output_context->GetTimeBase().GetExpr() * 1000.0f, ov::Dump(_frame->data[0], _frame->linesize[0], 32).CStr());
-
-				::av_frame_unref(_frame);
-
-				std::unique_lock<std::mutex> mlock(_mutex);
-
-				_output_buffer.push_back(std::move(output_frame));
-			}
-		}
+		::av_frame_unref(_frame);
 
+		std::unique_lock<std::mutex> mlock(_mutex);
 
+		_output_buffer.push_back(std::move(output_frame));
 	}
 }
+
 std::shared_ptr<MediaFrame> MediaFilterRescaler::RecvBuffer(TranscodeResult *result)
 {
 	std::unique_lock<std::mutex> mlock(_mutex);
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "media_filter_impl.h"
+#include "video_frame_pool.h"
 #include "base/media_route/media_buffer.h"
 #include "base/media_route/media_type.h"
 
@@ -23,13 +24,18 @@ public:
 
 	bool Configure(const std::shared_ptr<MediaTrack> &input_media_track, const std::shared_ptr<TranscodeContext> &input_context, const std::shared_ptr<TranscodeContext> &output_context) override;
 
+	// The renditions of a ladder are scaled in cascade (e.g. 1080p -> 720p -> 480p):
+	// each output is scaled from the frames of the smallest output that is still larger than it (and has enough frames),
+	// instead of from the full resolution.
+	// Returns the index of the output to scale from for each of output_contexts, or -1 to scale from the input frame.
+	static std::vector<ssize_t> MakeCascade(const std::vector<std::shared_ptr<TranscodeContext>> &output_contexts);
+
+	// The frame is processed in the caller's thread, and the results are available from RecvBuffer() right after
 	int32_t SendBuffer(std::shared_ptr<MediaFrame> buffer) override;
 	std::shared_ptr<MediaFrame> RecvBuffer(TranscodeResult * result) override;
 
-	void ThreadEncode();
-
-	void Stop();
-
 protected:
+	void ReceiveFrames();
 
+	VideoFramePool _frame_pool;
 };
@@ -0,0 +1,109 @@
+//==============================================================================
+//
+//  Transcode
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+
+#include "video_frame_pool.h"
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#define OV_LOG_TAG "MediaFilter.FramePool"
+
+VideoFramePool::~VideoFramePool()
+{
+	ReleasePools();
+}
+
+void VideoFramePool::ReleasePools()
+{
+	for (int plane = 0; plane < VIDEO_FRAME_POOL_MAX_PLANES; plane++)
+	{
+		// The pool is freed when all the buffers taken from it are released
+		OV_SAFE_FUNC(_pools[plane], nullptr, ::av_buffer_pool_uninit, &);
+
+		_plane_sizes[plane] = 0;
+	}
+}
+
+bool VideoFramePool::PreparePools(const std::shared_ptr<MediaFrame> &frame)
+{
+	bool is_changed = false;
+
+	for (int plane = 0; plane < VIDEO_FRAME_POOL_MAX_PLANES; plane++)
+	{
+		if ((_pools[plane] == nullptr) || (_plane_sizes[plane] != frame->GetBufferSize(plane)))
+		{
+			is_changed = true;
+			break;
+		}
+	}
+
+	if (is_changed == false)
+	{
+		return true;
+	}
+
+	ReleasePools();
+
+	for (int plane = 0; plane < VIDEO_FRAME_POOL_MAX_PLANES; plane++)
+	{
+		_plane_sizes[plane] = frame->GetBufferSize(plane);
+
+		// Give the SIMD routines of the filters some room at the end of the plane
+		_pools[plane] = ::av_buffer_pool_init(static_cast<int>(_plane_sizes[plane]) + AV_INPUT_BUFFER_PADDING_SIZE, ::av_buffer_allocz);
+
+		if (_pools[plane] == nullptr)
+		{
+			logte("Could not allocate the buffer pool for plane %d (size: %zu)", plane, _plane_sizes[plane]);
+			ReleasePools();
+
+			return false;
+		}
+	}
+
+	_reallocation_count++;
+
+	logtd("Frame pool is (re-)created: %dx%d, planes: %zu/%zu/%zu",
+		  frame->GetWidth(), frame->GetHeight(), _plane_sizes[0], _plane_sizes[1], _plane_sizes[2]);
+
+	return true;
+}
+
+bool VideoFramePool::FillFrame(AVFrame *av_frame, const std::shared_ptr<MediaFrame> &frame)
+{
+	if (PreparePools(frame) == false)
+	{
+		return false;
+	}
+
+	av_frame->format = frame->GetFormat();
+	av_frame->width = frame->GetWidth();
+	av_frame->height = frame->GetHeight();
+
+	for (int plane = 0; plane < VIDEO_FRAME_POOL_MAX_PLANES; plane++)
+	{
+		AVBufferRef *buffer = ::av_buffer_pool_get(_pools[plane]);
+
+		if (buffer == nullptr)
+		{
+			logte("Could not get a buffer from the pool for plane %d", plane);
+			::av_frame_unref(av_frame);
+
+			return false;
+		}
+
+		if (_plane_sizes[plane] > 0)
+		{
+			::memcpy(buffer->data, frame->GetBuffer(plane), _plane_sizes[plane]);
+		}
+
+		av_frame->buf[plane] = buffer;
+		av_frame->data[plane] = buffer->data;
+		av_frame->linesize[plane] = frame->GetStride(plane);
+	}
+
+	return true;
+}
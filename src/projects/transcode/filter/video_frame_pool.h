@@ -0,0 +1,51 @@
+//==============================================================================
+//
+//  Transcode
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+extern "C"
+{
+#include <libavcodec/avcodec.h>
+#include <libavutil/buffer.h>
+#include <libavutil/frame.h>
+}
+
+#include <base/media_route/media_buffer.h>
+
+#define VIDEO_FRAME_POOL_MAX_PLANES 3
+
+// Reuses the plane buffers of the frames that are fed to a filter graph.
+// The planes go back to the pool when the filter graph releases the last reference of the frame,
+// so a filter does not allocate the planes for every frame anymore.
+class VideoFramePool
+{
+public:
+	VideoFramePool() = default;
+	~VideoFramePool();
+
+	// Fill av_frame with the properties and the planes of the frame. The planes are taken from the pool.
+	bool FillFrame(AVFrame *av_frame, const std::shared_ptr<MediaFrame> &frame);
+
+	// Number of times the pools have been (re-)created, because the size of the frame has been changed
+	uint32_t GetReallocationCount() const
+	{
+		return _reallocation_count;
+	}
+
+private:
+	bool PreparePools(const std::shared_ptr<MediaFrame> &frame);
+	void ReleasePools();
+
+	AVBufferPool *_pools[VIDEO_FRAME_POOL_MAX_PLANES] = {nullptr, nullptr, nullptr};
+	size_t _plane_sizes[VIDEO_FRAME_POOL_MAX_PLANES] = {0, 0, 0};
+
+	uint32_t _reallocation_count = 0;
+};
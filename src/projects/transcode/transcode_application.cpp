@@ -103,3 +103,19 @@ bool TranscodeApplication::OnSendFrame(const std::shared_ptr<info::Stream> &stre
 
 	return stream->Push(std::move(packet));
 }
+
+bool TranscodeApplication::OnRequestKeyFrame(const std::shared_ptr<info::Stream> &stream_info)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	// Find the TranscodeStream that creates the output stream
+	for (auto &stream_bucket : _streams)
+	{
+		if (stream_bucket.second->RequestKeyFrame(stream_info))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -60,6 +60,11 @@ public:
 
 	bool OnSendFrame(const std::shared_ptr<info::Stream> &stream, const std::shared_ptr<MediaPacket> &packet) override;
 
+	////////////////////////////////////////////////////////////////////////////////////////////////
+	// MediaRouteApplicationConnector Implementation
+	////////////////////////////////////////////////////////////////////////////////////////////////
+	bool OnRequestKeyFrame(const std::shared_ptr<info::Stream> &stream) override;
+
 private:
 	std::map<int32_t, std::shared_ptr<TranscodeStream>> _streams;
 	std::mutex _mutex;
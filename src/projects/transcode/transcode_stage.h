@@ -0,0 +1,191 @@
+//==============================================================================
+//
+//  TranscodeStage
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <monitoring/transcode_stage_metrics.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+#include "transcode_worker_pool.h"
+
+// Maximum number of items that a stage processes at once before yielding the thread to other stages
+#define TRANSCODE_STAGE_BATCH_COUNT 8
+
+// What to do when an item is pushed to a full stage
+using TranscodeStageDropPolicy = ov::QueueOverflowPolicy;
+
+// A step of the transcoding pipeline (decoder, filter or encoder) with its own bounded queue.
+//
+// Items are processed in the order they are pushed by one pool thread at a time,
+// while different stages of the same stream run in parallel on TranscodeWorkerPool.
+//
+// The queue is lock-free. Use ov::SpscQueue only if the items are pushed by one thread at a time.
+template <typename T, template <typename> class QueueType = ov::MpscQueue>
+class TranscodeStage : public TranscodeWorkerTask, public ov::EnableSharedFromThis<TranscodeStage<T, QueueType>>
+{
+public:
+	using Handler = std::function<void(std::shared_ptr<T> item)>;
+
+	TranscodeStage(const ov::String &name, size_t max_queue_size, TranscodeStageDropPolicy drop_policy, Handler handler)
+		: _handler(std::move(handler)),
+		  _queue(max_queue_size, drop_policy)
+	{
+		_metrics = std::make_shared<mon::TranscodeStageMetrics>(name);
+	}
+
+	~TranscodeStage() override
+	{
+		Stop();
+	}
+
+	bool Start()
+	{
+		_stop_flag = false;
+
+		return true;
+	}
+
+	bool Stop()
+	{
+		if (_stop_flag.exchange(true))
+		{
+			return true;
+		}
+
+		// If Run() is in progress on a pool thread, wait for the current item to be processed
+		std::lock_guard<std::mutex> run_lock(_run_guard);
+
+		_queue.Clear();
+
+		return true;
+	}
+
+	// Returns false if the item is rejected
+	bool Push(std::shared_ptr<T> item)
+	{
+		if (_stop_flag)
+		{
+			return false;
+		}
+
+		auto dropped_count = _queue.GetDroppedCount();
+
+		if (_queue.Enqueue({std::move(item), std::chrono::steady_clock::now()}) == false)
+		{
+			_metrics->OnDropped();
+			return false;
+		}
+
+		if (_queue.GetDroppedCount() != dropped_count)
+		{
+			// The oldest item is discarded to make room
+			_metrics->OnDropped();
+		}
+
+		_metrics->OnEnqueued(static_cast<uint32_t>(_queue.Size()));
+
+		// Pairs with the fence in Run(): either this thread sees _scheduled == false, or Run() sees the item
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (_scheduled.exchange(true) == false)
+		{
+			Schedule();
+		}
+
+		return true;
+	}
+
+	size_t GetQueueSize() const
+	{
+		return _queue.Size();
+	}
+
+	// The largest number of items that have been queued at once
+	size_t GetQueueHighWaterMark() const
+	{
+		return _queue.GetHighWaterMark();
+	}
+
+	const std::shared_ptr<mon::TranscodeStageMetrics> &GetMetrics() const
+	{
+		return _metrics;
+	}
+
+	// Called by TranscodeWorkerPool
+	void Run() override
+	{
+		{
+			std::lock_guard<std::mutex> run_lock(_run_guard);
+
+			for (int count = 0; (count < TRANSCODE_STAGE_BATCH_COUNT) && (_stop_flag == false); count++)
+			{
+				auto queued_item = _queue.TryDequeue();
+
+				if (queued_item.has_value() == false)
+				{
+					break;
+				}
+
+				auto queue_size = static_cast<uint32_t>(_queue.Size());
+
+				_handler(std::move(queued_item->item));
+
+				auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - queued_item->enqueued_time).count();
+				_metrics->OnProcessed(queue_size, latency);
+			}
+		}
+
+		_scheduled = false;
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		// An item may have been pushed after the last pop, while _scheduled was still true
+		if ((_queue.IsEmpty() == false) && (_stop_flag == false) && (_scheduled.exchange(true) == false))
+		{
+			Schedule();
+		}
+	}
+
+	// Called by TranscodeWorkerPool when it stops before running this stage
+	void OnCanceled() override
+	{
+		_scheduled = false;
+	}
+
+private:
+	// Must be called after _scheduled is changed to true
+	void Schedule()
+	{
+		if (TranscodeWorkerPool::Instance()->Schedule(this->GetSharedPtr()) == false)
+		{
+			// The pool is stopping, so the items remain in the queue until the next Push()
+			_scheduled = false;
+		}
+	}
+
+	struct QueuedItem
+	{
+		std::shared_ptr<T> item;
+		std::chrono::steady_clock::time_point enqueued_time;
+	};
+
+	Handler _handler;
+
+	QueueType<QueuedItem> _queue;
+
+	// Held while the handler is running, so that Stop() can wait for it
+	std::mutex _run_guard;
+
+	// true while this stage is in the run queue of the pool or is running
+	std::atomic<bool> _scheduled{false};
+	std::atomic<bool> _stop_flag{true};
+
+	std::shared_ptr<mon::TranscodeStageMetrics> _metrics;
+};
@@ -11,10 +11,15 @@
 #include "transcode_stream.h"
 
 #include <config/config_manager.h>
+#include <monitoring/monitoring.h>
+
+#include "filter/media_filter_rescaler.h"
 
 #define OV_LOG_TAG "TranscodeStream"
 
-#define ENABLE_SINGLE_THREAD 1
+// Maximum number of raw frames waiting for a filter or an encoder.
+// Raw frames are large, and a stage that cannot keep up drops the oldest frame rather than delaying the others.
+#define TRANSCODE_FRAME_QUEUE_SIZE 32
 
 TranscodeStream::TranscodeStream(const info::Application &application_info, const std::shared_ptr<info::Stream> &stream, TranscodeApplication *parent)
 	: _application_info(application_info)
@@ -34,29 +39,35 @@ TranscodeStream::TranscodeStream(const info::Application &application_info, cons
 
 	// for generating track ids
 	_last_transcode_id = 0;
+
+	_kill_flag = true;
 }
 
 TranscodeStream::~TranscodeStream()
 {
-	// The thread checked for non-termination and terminated
+	// The stages checked for non-termination and terminated
 	if (_kill_flag != true)
 	{
 		Stop();
 	}
 
+	_decoder_stages.clear();
+	_filter_stages.clear();
+	_encoder_stages.clear();
+
+	std::unique_lock<std::shared_mutex> key_frame_lock(_key_frame_guard);
+
 	_decoders.clear();
 	_filters.clear();
 	_encoders.clear();
 
-	_queue_input_packets.clear();
-	_queue_decoded_frames.clear();
-	_queue_filterd_frames.clear();
-
 	_stage_input_to_decoder.clear();
 	_stage_input_to_output.clear();
 	_stage_decoder_to_filter.clear();
 	_stage_filter_to_encoder.clear();
 	_stage_encoder_to_output.clear();
+	_stage_filter_to_cascaded_filter.clear();
+	_stage_cascaded_filter_to_parent.clear();
 
 	_stream_outputs.clear();
 }
@@ -88,21 +99,17 @@ bool TranscodeStream::Start()
 		logtw("No encoder generated");
 	}
 
-	// I will make and apply a packet drop policy.
+	// Maximum number of packets waiting for a decoder
 	_max_queue_size = 256;
 
-	// Create Data Processing Loop Threads
-	try
-	{
-		_kill_flag = false;
-		_thread_looptask = std::thread(&TranscodeStream::LoopTask, this);
-	}
-	catch (const std::system_error &e)
-	{
-		_kill_flag = true;
-		logte("Failed to start transcode stream thread");
-		return false;
-	}
+	CreateScalerCascade();
+
+	// Decoders, filters and encoders run in parallel on the transcoder thread pool
+	CreateStages();
+
+	CreateStreams();
+
+	_kill_flag = false;
 
 	logti("[%s/%s(%u)] Transcoder input stream has been started. Status : (%d) Decoders, (%d) Encoders", 
 						_application_info.GetName().CStr(), _stream_input->GetName().CStr(), _stream_input->GetId(), _decoders.size(), _encoders.size());
@@ -111,23 +118,85 @@ bool TranscodeStream::Start()
 	return true;
 }
 
-bool TranscodeStream::Stop()
+bool TranscodeStream::RequestKeyFrame(const std::shared_ptr<info::Stream> &output_stream)
 {
-	_kill_flag = true;
+	auto output_stream_id = output_stream->GetId();
 
-	logtd("Wait for terminated trancode stream thread. kill_flag(%s)", _kill_flag ? "true" : "false");
+	std::shared_lock<std::shared_mutex> key_frame_lock(_key_frame_guard);
 
-	_queue_input_packets.abort();
-	_queue_decoded_frames.abort();
-	_queue_filterd_frames.abort();
+	auto stream_item = std::find_if(_stream_outputs.begin(), _stream_outputs.end(), [output_stream_id](const auto &item) -> bool {
+		return item.second->GetId() == output_stream_id;
+	});
 
-	_queue_event.Notify();
+	if (stream_item == _stream_outputs.end())
+	{
+		return false;
+	}
 
-	if (_thread_looptask.joinable())
+	if (_kill_flag)
 	{
-		_thread_looptask.join();
+		return true;
 	}
 
+	// Encoder -> Output Tracks
+	for (auto &stage_item : _stage_encoder_to_output)
+	{
+		auto encoder_item = _encoders.find(stage_item.first);
+		if (encoder_item == _encoders.end())
+		{
+			continue;
+		}
+
+		for (auto &output_item : stage_item.second)
+		{
+			auto track = output_item.first->GetTrack(output_item.second);
+
+			if ((output_item.first->GetId() == output_stream_id) && (track != nullptr) && (track->GetMediaType() == common::MediaType::Video))
+			{
+				// Several renditions of an encoder are merged into one key frame
+				encoder_item->second->RequestKeyFrame();
+				break;
+			}
+		}
+	}
+
+	// Input Track -> Output Tracks (Bypass)
+	for (auto &stage_item : _stage_input_to_output)
+	{
+		auto input_track = _stream_input->GetTrack(stage_item.first);
+		if ((input_track == nullptr) || (input_track->GetMediaType() != common::MediaType::Video))
+		{
+			continue;
+		}
+
+		for (auto &output_item : stage_item.second)
+		{
+			if (output_item.first->GetId() == output_stream_id)
+			{
+				// The key frame cannot be generated here, so it is requested to the provider
+				_parent->RequestKeyFrame(_stream_input);
+				return true;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool TranscodeStream::Stop()
+{
+	if (_kill_flag.exchange(true))
+	{
+		return true;
+	}
+
+	logtd("Wait for terminated trancode stream stages");
+
+	// Wait for the stages running on the pool, so that no more packets are sent to the output streams
+	DeleteStages();
+
+	DeleteStreams();
+
 	logti("[%s/%s(%u)] Transcoder input stream has been stopped.", 
 						_application_info.GetName().CStr(), _stream_input->GetName().CStr(), _stream_input->GetId());
 
@@ -142,15 +211,52 @@ bool TranscodeStream::Push(std::shared_ptr<MediaPacket> packet)
 		return true;
 	}
 
-	if (_queue_input_packets.size() > _max_queue_size)
+	if (_kill_flag)
 	{
-		logti("Queue(stream) is full, please check your system: (queue: %zu > limit: %llu)", _queue_input_packets.size(), _max_queue_size);
 		return false;
 	}
 
-	_queue_input_packets.push(std::move(packet));
+	int32_t track_id = packet->GetTrackId();
 
-	_queue_event.Notify();
+	// Bypass: the packet does not need to wait for the decoder
+	auto stage_item_to_output = _stage_input_to_output.find(track_id);
+	if (stage_item_to_output != _stage_input_to_output.end())
+	{
+		auto &output_tracks = stage_item_to_output->second;
+
+		for (auto iter : output_tracks)
+		{
+			auto output_stream = iter.first;
+			auto output_track_id = iter.second;
+
+			auto clone_packet = packet->ClonePacket();
+
+			clone_packet->SetTrackId(output_track_id);
+
+			SendFrame(output_stream, std::move(clone_packet));
+		}
+	}
+
+	auto stage_item_decoder = _stage_input_to_decoder.find(track_id);
+	if (stage_item_decoder == _stage_input_to_decoder.end())
+	{
+		return true;
+	}
+
+	auto decoder_stage_item = _decoder_stages.find(stage_item_decoder->second);
+	if (decoder_stage_item == _decoder_stages.end())
+	{
+		return true;
+	}
+
+	auto &decoder_stage = decoder_stage_item->second;
+
+	// Compressed packets cannot be dropped without breaking the decoding, so the packet is rejected instead
+	if (decoder_stage->Push(std::move(packet)) == false)
+	{
+		logti("Queue(stream) is full, please check your system: (queue: %zu >= limit: %llu)", decoder_stage->GetQueueSize(), _max_queue_size);
+		return false;
+	}
 
 	return true;
 }
@@ -346,7 +452,10 @@ int32_t TranscodeStream::CreateOutputStream()
 		}
 
 		// Add to Output Stream List. The key is the output stream name.
-		_stream_outputs.insert(std::make_pair(stream_name, stream_output));
+		{
+			std::unique_lock<std::shared_mutex> key_frame_lock(_key_frame_guard);
+			_stream_outputs.insert(std::make_pair(stream_name, stream_output));
+		}
 
 		logti("[%s/%s(%u)] -> [%s/%s(%u)] Transcoder output stream has been created.", 
 						_application_info.GetName().CStr(), _stream_input->GetName().CStr(), _stream_input->GetId(),
@@ -435,7 +544,10 @@ int32_t TranscodeStream::CreateStageMapping()
 				_stage_filter_to_encoder[filter_id] = encoder_id;
 
 				// Map of Encoder -> OutputTrack
-				_stage_encoder_to_output[encoder_id].push_back(make_pair(stream, output_id));
+				{
+					std::unique_lock<std::shared_mutex> key_frame_lock(_key_frame_guard);
+					_stage_encoder_to_output[encoder_id].push_back(make_pair(stream, output_id));
+				}
 			}
 		}
 
@@ -657,7 +769,10 @@ bool TranscodeStream::CreateEncoder(int32_t encoder_track_id, std::shared_ptr<Me
 		return false;
 	}
 
-	_encoders[encoder_track_id] = std::move(encoder);
+	{
+		std::unique_lock<std::shared_mutex> key_frame_lock(_key_frame_guard);
+		_encoders[encoder_track_id] = std::move(encoder);
+	}
 
 	return true;
 }
@@ -673,27 +788,9 @@ void TranscodeStream::ChangeOutputFormat(MediaFrame *buffer)
 	CreateFilters(buffer);
 }
 
+// Called by the decoder stage
 TranscodeResult TranscodeStream::DecodePacket(int32_t track_id, std::shared_ptr<MediaPacket> packet)
 {
-	// 바이패스 처리
-	auto stage_item_to_output = _stage_input_to_output.find(track_id);
-	if (stage_item_to_output != _stage_input_to_output.end())
-	{
-		auto &output_tracks = stage_item_to_output->second;
-
-		for (auto iter : output_tracks)
-		{
-			auto output_stream = iter.first;
-			auto output_track_id = iter.second;
-
-			auto clone_packet = packet->ClonePacket();
-
-			clone_packet->SetTrackId(output_track_id);
-
-			SendFrame(output_stream, std::move(clone_packet));
-		}
-	}
-
 	// 디코더 처리
 	auto stage_item_decoder = _stage_input_to_decoder.find(track_id);
 	if (stage_item_decoder == _stage_input_to_decoder.end())
@@ -740,15 +837,7 @@ TranscodeResult TranscodeStream::DecodePacket(int32_t track_id, std::shared_ptr<
 
 				_stats_decoded_frame_count++;
 
-				if (_queue_decoded_frames.size() > _max_queue_size)
-				{
-					logti("Decoded frame queue is full, please check your system");
-					return result;
-				}
-
-				_queue_decoded_frames.push(std::move(decoded_frame));
-
-				_queue_event.Notify();
+				DoFilters(std::move(decoded_frame));
 
 				break;
 
@@ -762,15 +851,21 @@ TranscodeResult TranscodeStream::DecodePacket(int32_t track_id, std::shared_ptr<
 	return TranscodeResult::NoData;
 }
 
+// Called by the filter stage
 TranscodeResult TranscodeStream::FilterFrame(int32_t track_id, std::shared_ptr<MediaFrame> decoded_frame)
 {
+	std::unique_lock<std::mutex> filters_lock(_filters_guard);
+
 	auto filter_item = _filters.find(track_id);
 	if (filter_item == _filters.end())
 	{
 		return TranscodeResult::NoData;
 	}
 
-	auto filter = filter_item->second.get();
+	// Keep a reference, because the filter may be re-created by the decoder stage in the meantime
+	auto filter = filter_item->second;
+
+	filters_lock.unlock();
 
 	// logtp("[#%d] Trying to apply a filter to the frame (PTS: %lld)", track_id, decoded_frame->GetPts());
 	filter->SendBuffer(std::move(decoded_frame));
@@ -793,9 +888,7 @@ TranscodeResult TranscodeStream::FilterFrame(int32_t track_id, std::shared_ptr<M
 
 				// logtd("[#%d] A frame is filtered (PTS: %lld)", track_id, filtered_frame->GetPts());
 
-				_queue_filterd_frames.push(std::move(filtered_frame));
-
-				_queue_event.Notify();
+				PushFilteredFrame(track_id, std::move(filtered_frame));
 
 				break;
 
@@ -805,10 +898,48 @@ TranscodeResult TranscodeStream::FilterFrame(int32_t track_id, std::shared_ptr<M
 	}
 }
 
+void TranscodeStream::PushFilteredFrame(int32_t filter_id, std::shared_ptr<MediaFrame> frame)
+{
+	// The cascaded filters and the encoder only read the frame, so it is shared without being cloned
+	auto cascaded_filter_item = _stage_filter_to_cascaded_filter.find(filter_id);
+	if (cascaded_filter_item != _stage_filter_to_cascaded_filter.end())
+	{
+		for (auto cascaded_filter_id : cascaded_filter_item->second)
+		{
+			auto filter_stage_item = _filter_stages.find(cascaded_filter_id);
+			if (filter_stage_item != _filter_stages.end())
+			{
+				filter_stage_item->second->Push(frame);
+			}
+		}
+	}
+
+	auto encoder_id_item = _stage_filter_to_encoder.find(filter_id);
+	if (encoder_id_item == _stage_filter_to_encoder.end())
+	{
+		return;
+	}
+
+	auto encoder_stage_item = _encoder_stages.find(encoder_id_item->second);
+	if (encoder_stage_item == _encoder_stages.end())
+	{
+		return;
+	}
+
+	encoder_stage_item->second->Push(std::move(frame));
+}
+
+// Called by the encoder stage
 TranscodeResult TranscodeStream::EncodeFrame(int32_t filter_id, std::shared_ptr<const MediaFrame> frame)
 {
 	// 인코더 아이디 조회
-	auto encoder_id = _stage_filter_to_encoder[filter_id];
+	auto encoder_id_item = _stage_filter_to_encoder.find(filter_id);
+	if (encoder_id_item == _stage_filter_to_encoder.end())
+	{
+		return TranscodeResult::NoData;
+	}
+
+	auto encoder_id = encoder_id_item->second;
 
 	auto encoder_item = _encoders.find(encoder_id);
 	if (encoder_item == _encoders.end())
@@ -860,101 +991,177 @@ TranscodeResult TranscodeStream::EncodeFrame(int32_t filter_id, std::shared_ptr<
 	}
 }
 
-// 디코딩 & 인코딩 스레드
-void TranscodeStream::LoopTask()
+// The renditions of a video are scaled in cascade (e.g. 1080p -> 720p -> 480p), and each rendition is scaled on its own stage
+void TranscodeStream::CreateScalerCascade()
 {
-	logtd("Started transcode stream decode thread");
-
-	CreateStreams();
-
-	time_t base_time;
-	time(&base_time);
-
-	while (!_kill_flag)
+	for (auto &iter : _stage_decoder_to_filter)
 	{
-		_queue_event.Wait();
-
-		time_t curr_time;
-		time(&curr_time);
+		auto decoder_id = iter.first;
+		auto &input_track = _stream_input->GetTrack(decoder_id);
 
-		// for statistics
-		if (difftime(curr_time, base_time) >= 20)
+		if ((input_track == nullptr) || (input_track->GetMediaType() != common::MediaType::Video))
 		{
-			base_time = curr_time;
-
-			ov::String dbg_str = ov::String::FormatString("\nStatistics of Transcode Stream [%s/%s]\n", _application_info.GetName().CStr(), _stream_input->GetName().CStr());
+			continue;
+		}
 
-			
-			dbg_str.AppendFormat(" - Pipeline\n\tdecode.ready[%d], filter.ready[%d], encode.ready[%d]\n" , _queue_input_packets.size(), _queue_decoded_frames.size(), _queue_filterd_frames.size());
+		std::vector<MediaTrackId> filter_ids;
+		std::vector<std::shared_ptr<TranscodeContext>> output_contexts;
 
-			dbg_str.AppendFormat(" - Decoders\n");
-			for (auto &iter : _decoders)
+		for (auto filter_id : iter.second)
+		{
+			auto encoder_id_item = _stage_filter_to_encoder.find(filter_id);
+			if (encoder_id_item == _stage_filter_to_encoder.end())
 			{
-				auto track_id =iter.first; 
-				auto object = iter.second;
-				dbg_str.AppendFormat("\t[%d] track : input.q [%d], output.q [%d]\n", track_id, object->GetInputBufferSize(), object->GetOutputBufferSize());
+				continue;
 			}
 
-			dbg_str.AppendFormat(" - Filters\n");
-			for (auto &iter : _filters)
+			auto encoder_item = _encoders.find(encoder_id_item->second);
+			if (encoder_item == _encoders.end())
 			{
-				auto track_id =iter.first; 
-				auto object = iter.second;
-				dbg_str.AppendFormat("\t[%d] track : input.q [%d], output.q [%d]\n", track_id, object->GetInputBufferSize(), object->GetOutputBufferSize());
+				continue;
 			}
 
-			dbg_str.AppendFormat(" - Encoders\n");
-			for (auto &iter : _encoders)
+			auto output_context = encoder_item->second->GetContext();
+
+			// The size of the rendition is not known until the first frame is decoded, so it is scaled from the decoded frame
+			if ((output_context->GetVideoWidth() <= 0) || (output_context->GetVideoHeight() <= 0))
 			{
-				auto track_id =iter.first; 
-				auto object = iter.second;
-				dbg_str.AppendFormat("\t[%d] track : input.q [%d], output.q [%d]\n", track_id, object->GetInputBufferSize(), object->GetOutputBufferSize());
+				continue;
 			}
 
-			logts("%s", dbg_str.CStr() );
+			filter_ids.push_back(filter_id);
+			output_contexts.push_back(output_context);
 		}
 
+		auto parents = MediaFilterRescaler::MakeCascade(output_contexts);
 
-
-		if (_queue_input_packets.size() > 0)
+		for (size_t index = 0; index < parents.size(); index++)
 		{
-			auto packet = _queue_input_packets.pop_unique();
-			if (packet != nullptr)
+			if (parents[index] < 0)
 			{
-				int32_t track_id = packet->GetTrackId();
-
-				DecodePacket(track_id, std::move(packet));
+				continue;
 			}
+
+			auto filter_id = filter_ids[index];
+			auto parent_filter_id = filter_ids[parents[index]];
+
+			_stage_filter_to_cascaded_filter[parent_filter_id].push_back(filter_id);
+			_stage_cascaded_filter_to_parent[filter_id] = parent_filter_id;
+
+			logtd("[#%d] Filter #%d is fed by filter #%d", decoder_id, filter_id, parent_filter_id);
 		}
+	}
+}
+
+void TranscodeStream::CreateStages()
+{
+	auto stream_metrics = StreamMetrics(*_stream_input);
+
+	for (auto &iter : _decoders)
+	{
+		auto decoder_id = iter.first;
+
+		_decoder_stages[decoder_id] = std::make_shared<TranscodeStage<MediaPacket, ov::SpscQueue>>(
+			ov::String::FormatString("Decoder[%d]", decoder_id), _max_queue_size, TranscodeStageDropPolicy::RejectNewest,
+			[this, decoder_id](std::shared_ptr<MediaPacket> packet) {
+				DecodePacket(decoder_id, std::move(packet));
+			});
+	}
 
-		if (_queue_decoded_frames.size() > 0)
+	// Filters are created when the first frame is decoded, so the stages are created for the filters to be created
+	for (auto &iter : _stage_decoder_to_filter)
+	{
+		for (auto filter_id : iter.second)
 		{
-			auto frame = _queue_decoded_frames.pop_unique();
-			if (frame != nullptr)
-			{
-				DoFilters(std::move(frame));
-			}
+			_filter_stages[filter_id] = std::make_shared<TranscodeStage<MediaFrame>>(
+				ov::String::FormatString("Filter[%d]", filter_id), TRANSCODE_FRAME_QUEUE_SIZE, TranscodeStageDropPolicy::DropOldest,
+				[this, filter_id](std::shared_ptr<MediaFrame> frame) {
+					FilterFrame(filter_id, std::move(frame));
+				});
 		}
+	}
 
-		while ((_queue_filterd_frames.size() > 0) && (_queue_filterd_frames.IsAborted() == false))
-		{
-			auto frame = _queue_filterd_frames.pop_unique();
-			if (frame != nullptr)
-			{
+	for (auto &iter : _encoders)
+	{
+		auto encoder_id = iter.first;
+
+		_encoder_stages[encoder_id] = std::make_shared<TranscodeStage<MediaFrame>>(
+			ov::String::FormatString("Encoder[%d]", encoder_id), TRANSCODE_FRAME_QUEUE_SIZE, TranscodeStageDropPolicy::DropOldest,
+			[this](std::shared_ptr<MediaFrame> frame) {
+				// The track id of the filtered frame is the filter id
 				int32_t filter_id = frame->GetTrackId();
 
 				EncodeFrame(filter_id, std::move(frame));
-			}
+			});
+	}
+
+	// Start from the last stage, so that a stage never pushes to the next one that is not started yet
+	for (auto &iter : _encoder_stages)
+	{
+		iter.second->Start();
+
+		if (stream_metrics != nullptr)
+		{
+			stream_metrics->AddTranscodeStageMetrics(iter.second->GetMetrics());
 		}
+	}
 
-		// TODO(soulk) Packet이 존재하는 경우에만 Loop를 처리할 수 있는 방법은 없나?
-		// usleep(1);
+	for (auto &iter : _filter_stages)
+	{
+		iter.second->Start();
+
+		if (stream_metrics != nullptr)
+		{
+			stream_metrics->AddTranscodeStageMetrics(iter.second->GetMetrics());
+		}
 	}
 
-	// 스트림 삭제 전송
-	DeleteStreams();
+	for (auto &iter : _decoder_stages)
+	{
+		iter.second->Start();
 
-	logtd("Terminated transcode stream decode thread");
+		if (stream_metrics != nullptr)
+		{
+			stream_metrics->AddTranscodeStageMetrics(iter.second->GetMetrics());
+		}
+	}
+}
+
+void TranscodeStream::DeleteStages()
+{
+	// It may be nullptr if the input stream has already been removed from the monitoring module
+	auto stream_metrics = StreamMetrics(*_stream_input);
+
+	// Stop from the first stage, so that the stopped stages are not fed anymore
+	for (auto &iter : _decoder_stages)
+	{
+		iter.second->Stop();
+
+		if (stream_metrics != nullptr)
+		{
+			stream_metrics->RemoveTranscodeStageMetrics(iter.second->GetMetrics());
+		}
+	}
+
+	for (auto &iter : _filter_stages)
+	{
+		iter.second->Stop();
+
+		if (stream_metrics != nullptr)
+		{
+			stream_metrics->RemoveTranscodeStageMetrics(iter.second->GetMetrics());
+		}
+	}
+
+	for (auto &iter : _encoder_stages)
+	{
+		iter.second->Stop();
+
+		if (stream_metrics != nullptr)
+		{
+			stream_metrics->RemoveTranscodeStageMetrics(iter.second->GetMetrics());
+		}
+	}
 }
 
 void TranscodeStream::CreateStreams()
@@ -967,7 +1174,15 @@ void TranscodeStream::CreateStreams()
 
 void TranscodeStream::DeleteStreams()
 {
-	for (auto &iter : _stream_outputs)
+	std::map<ov::String, std::shared_ptr<info::Stream>> stream_outputs;
+
+	{
+		// Do not hold the lock while the streams are deleted
+		std::unique_lock<std::shared_mutex> key_frame_lock(_key_frame_guard);
+		stream_outputs.swap(_stream_outputs);
+	}
+
+	for (auto &iter : stream_outputs)
 	{
 		auto output = iter.second;
 		logti("[%s/%s(%u)] -> [%s/%s(%u)] Transcoder output stream has been deleted.", 
@@ -976,12 +1191,12 @@ void TranscodeStream::DeleteStreams()
 
 		_parent->DeleteStream(iter.second);
 	}
-
-	_stream_outputs.clear();
 }
 
 void TranscodeStream::SendFrame(std::shared_ptr<info::Stream> &stream, std::shared_ptr<MediaPacket> packet)
 {
+	std::lock_guard<std::mutex> lock_guard(_send_frame_guard);
+
 	_parent->SendFrame(stream, std::move(packet));
 }
 
@@ -1013,7 +1228,15 @@ void TranscodeStream::CreateFilters(MediaFrame *buffer)
 	}
 
 	// 2. due to structural problems I've already made the encoder's context... I checked and corrected it.
-	auto input_transcode_context = _decoders[decoder_id]->GetContext();
+	auto decoder_item = _decoders.find(decoder_id);
+	if (decoder_item == _decoders.end())
+	{
+		logte("cannot find decoder. decoder_id(%d)", decoder_id);
+
+		return;
+	}
+
+	auto input_transcode_context = decoder_item->second->GetContext();
 	if (buffer->GetMediaType() == common::MediaType::Video)
 	{
 	}
@@ -1033,21 +1256,57 @@ void TranscodeStream::CreateFilters(MediaFrame *buffer)
 
 	for (auto &filter_id : filter_item->second)
 	{
-		auto encoder_id = _stage_filter_to_encoder[filter_id];
+		// The stage maps are shared by all stages, so they must not be changed here (operator[] inserts a missing key)
+		auto encoder_id_item = _stage_filter_to_encoder.find(filter_id);
+		if (encoder_id_item == _stage_filter_to_encoder.end())
+		{
+			continue;
+		}
 
-		if(_encoders.find(encoder_id) == _encoders.end())
+		auto encoder_id = encoder_id_item->second;
+
+		auto encoder_item = _encoders.find(encoder_id);
+		if(encoder_item == _encoders.end())
 		{
 			logte("%d track encoder is not allocated", encoder_id);
 			continue;
 		}
 
-		auto output_transcode_context = _encoders[encoder_id]->GetContext();
+		auto output_transcode_context = encoder_item->second->GetContext();
+
+		auto filter_input_media_track = input_media_track;
+		auto filter_input_transcode_context = input_transcode_context;
+
+		// A cascaded filter is fed with the yuv420p frames of its parent rendition (See CreateScalerCascade())
+		auto parent_filter_item = _stage_cascaded_filter_to_parent.find(filter_id);
+		if (parent_filter_item != _stage_cascaded_filter_to_parent.end())
+		{
+			auto parent_encoder_item = _encoders.find(_stage_filter_to_encoder.at(parent_filter_item->second));
+			if (parent_encoder_item == _encoders.end())
+			{
+				logte("%d track encoder is not allocated", _stage_filter_to_encoder.at(parent_filter_item->second));
+				continue;
+			}
+
+			auto parent_transcode_context = parent_encoder_item->second->GetContext();
+			auto parent_timebase = parent_transcode_context->GetTimeBase();
+
+			filter_input_media_track = std::make_shared<MediaTrack>(*input_media_track);
+			filter_input_media_track->SetWidth(parent_transcode_context->GetVideoWidth());
+			filter_input_media_track->SetHeight(parent_transcode_context->GetVideoHeight());
+			filter_input_media_track->SetFormat(AV_PIX_FMT_YUV420P);
+			filter_input_media_track->SetTimeBase(parent_timebase.GetNum(), parent_timebase.GetDen());
+
+			filter_input_transcode_context = parent_transcode_context;
+		}
 
 		auto transcode_filter = std::make_shared<TranscodeFilter>();
 
-		bool ret = transcode_filter->Configure(input_media_track, input_transcode_context, output_transcode_context);
+		bool ret = transcode_filter->Configure(filter_input_media_track, filter_input_transcode_context, output_transcode_context);
 		if (ret == true)
 		{
+			std::lock_guard<std::mutex> lock_guard(_filters_guard);
+
 			_filters[filter_id] = transcode_filter;
 		}
 		else
@@ -1073,6 +1332,25 @@ void TranscodeStream::DoFilters(std::shared_ptr<MediaFrame> frame)
 
 	for (auto &filter_id : filter_item->second)
 	{
+		// A cascaded filter is fed by the filter of its parent rendition
+		if (_stage_cascaded_filter_to_parent.find(filter_id) != _stage_cascaded_filter_to_parent.end())
+		{
+			continue;
+		}
+
+		auto filter_stage_item = _filter_stages.find(filter_id);
+		if (filter_stage_item == _filter_stages.end())
+		{
+			continue;
+		}
+
+		// The rescaler copies the planes of the frame, so the video filters share the decoded frame
+		if (frame->GetMediaType() == common::MediaType::Video)
+		{
+			filter_stage_item->second->Push(frame);
+			continue;
+		}
+
 		auto frame_clone = frame->CloneFrame();
 		if (frame_clone == nullptr)
 		{
@@ -1080,7 +1358,7 @@ void TranscodeStream::DoFilters(std::shared_ptr<MediaFrame> frame)
 			continue;
 		}
 
-		FilterFrame(filter_id, std::move(frame_clone));
+		filter_stage_item->second->Push(std::move(frame_clone));
 	}
 }
 
@@ -13,16 +13,17 @@
 
 #include <cstdint>
 #include <memory>
+#include <shared_mutex>
 #include <vector>
 #include <queue>
 
 #include "base/media_route/media_buffer.h"
-#include "base/media_route/media_queue.h"
 #include "base/media_route/media_type.h"
 #include "base/info/stream.h"
 
 #include "transcode_context.h"
 #include "transcode_filter.h"
+#include "transcode_stage.h"
 
 #include "codec/transcode_encoder.h"
 #include "codec/transcode_decoder.h"
@@ -52,16 +53,20 @@ public:
 
 	bool Push(std::shared_ptr<MediaPacket> packet);
 
+	// Requests a key frame of the output stream to the video encoders.
+	// The key frame of a bypassed track is requested to the provider of the input stream.
+	//
+	// Returns false if the stream is not an output stream of this TranscodeStream
+	bool RequestKeyFrame(const std::shared_ptr<info::Stream> &output_stream);
+
 	// std::set<ov::String> _stream_list;
 
 	// For statistics
-	uint32_t _stats_decoded_frame_count;
+	std::atomic<uint32_t> _stats_decoded_frame_count;
 	uint8_t _stats_queue_full_count;
 	uint64_t _max_queue_size;
 
 private:
-	ov::Semaphore _queue_event;
-
 	const info::Application _application_info;
 
 	// Input Stream Info
@@ -71,6 +76,9 @@ private:
 	// [OUTPUT_STREAM_NAME, OUTPUT_stream]
 	std::map<ov::String, std::shared_ptr<info::Stream>> _stream_outputs;
 
+	// RequestKeyFrame() is called by the thread that receives RTCP, so _stream_outputs, _stage_encoder_to_output and _encoders
+	// are modified under the exclusive lock, and read under the shared lock from that thread
+	std::shared_mutex _key_frame_guard;
 
 	// Store information for track mapping by stage
 	void StoreStageContext(ov::String encode_profile_name, common::MediaType media_type,  std::shared_ptr<MediaTrack> input_track, std::shared_ptr<info::Stream> output_stream, std::shared_ptr<MediaTrack> output_track);
@@ -100,7 +108,17 @@ private:
 
 	// Filter
 	// FILTER_ID, FILTER
+	// Filters are re-created by the decoder stage when the format of decoded frames is changed
 	std::map<MediaTrackId, std::shared_ptr<TranscodeFilter>> _filters;
+	std::mutex _filters_guard;
+
+	// Video renditions are scaled in cascade (e.g. 1080p -> 720p -> 480p, See MediaFilterRescaler::MakeCascade()).
+	// A cascaded filter is fed with the frames of its parent filter instead of the decoded frames,
+	// and each filter still runs on its own stage, so the renditions are scaled in parallel.
+	// [FILTER_ID, FILTER_IDs fed by the filter]
+	std::map<MediaTrackId, std::vector<MediaTrackId>> _stage_filter_to_cascaded_filter;
+	// [FILTER_ID, PARENT FILTER_ID]
+	std::map<MediaTrackId, MediaTrackId> _stage_cascaded_filter_to_parent;
 
 	// Encoder
 	// ENCODER_ID, ENCODER
@@ -109,22 +127,21 @@ private:
 
 
 
-	// Buffer for encoded(input) media packets
-	MediaQueue<std::shared_ptr<MediaPacket>> _queue_input_packets;
-
-	// Buffer for decoded frames
-	MediaQueue<std::shared_ptr<MediaFrame>> _queue_decoded_frames;
-
-	// Buffer for filtered frames
-	MediaQueue<std::shared_ptr<MediaFrame>> _queue_filterd_frames;
+	// Pipeline stages. Each stage has its own bounded queue and runs on TranscodeWorkerPool.
+	// [DECODER_ID, STAGE] (packets are pushed by the thread of the media router only)
+	std::map<MediaTrackId, std::shared_ptr<TranscodeStage<MediaPacket, ov::SpscQueue>>> _decoder_stages;
+	// [FILTER_ID, STAGE]
+	std::map<MediaTrackId, std::shared_ptr<TranscodeStage<MediaFrame>>> _filter_stages;
+	// [ENCODER_ID, STAGE]
+	std::map<MediaTrackId, std::shared_ptr<TranscodeStage<MediaFrame>>> _encoder_stages;
 
 	// last generated output track id.
 	uint8_t _last_track_index = 0;
 
-	volatile bool _kill_flag;
+	std::atomic<bool> _kill_flag;
 
-	void LoopTask();
-	std::thread _thread_looptask;
+	// Encoder stages of different renditions send packets at the same time, but MediaRouter expects one sender per stream
+	std::mutex _send_frame_guard;
 
 	TranscodeApplication *_parent;
 
@@ -138,10 +155,18 @@ private:
 	int32_t CreateEncoders();
 	bool CreateEncoder(int32_t encoder_track_id, std::shared_ptr<MediaTrack> media_track, std::shared_ptr<TranscodeContext> output_context);
 
+	// Decide which video filters are fed by the other filters (must be called before the stages are created)
+	void CreateScalerCascade();
+
+	// Create a stage for each decoder, filter and encoder, and register them to the monitoring module
+	void CreateStages();
+	void DeleteStages();
+
 	// Called when formatting of decoded frames is analyzed or changed.
 	void ChangeOutputFormat(MediaFrame *buffer);
 
 	void CreateFilters(MediaFrame *buffer);
+	// Pass the decoded frame to the filter stages
 	void DoFilters(std::shared_ptr<MediaFrame> frame);
 
 	// There are 3 steps to process packet
@@ -149,6 +174,8 @@ private:
 	TranscodeResult DecodePacket(int32_t track_id, std::shared_ptr<MediaPacket> packet);
 	// Step 2: Filter (resample/rescale the decoded frame)
 	TranscodeResult FilterFrame(int32_t track_id, std::shared_ptr<MediaFrame> frame);
+	// Pass the filtered frame to the encoder stage, and to the stages of the cascaded filters
+	void PushFilteredFrame(int32_t filter_id, std::shared_ptr<MediaFrame> frame);
 	// Step 3: Encode (Encode the filtered frame to packets)
 	TranscodeResult EncodeFrame(int32_t track_id, std::shared_ptr<const MediaFrame> frame);
 
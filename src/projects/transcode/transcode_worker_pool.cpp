@@ -0,0 +1,148 @@
+//==============================================================================
+//
+//  TranscodeWorkerPool
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "transcode_worker_pool.h"
+
+#define OV_LOG_TAG "TranscodeWorkerPool"
+
+TranscodeWorkerPool::~TranscodeWorkerPool()
+{
+	Stop();
+}
+
+bool TranscodeWorkerPool::Start(uint32_t thread_count)
+{
+	std::lock_guard<std::mutex> lock(_start_guard);
+
+	if (_threads.empty() == false)
+	{
+		// Already started
+		return true;
+	}
+
+	if (thread_count == 0)
+	{
+		thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+	}
+
+	_stop_thread_flag = false;
+
+	try
+	{
+		for (uint32_t index = 0; index < thread_count; index++)
+		{
+			_threads.emplace_back(&TranscodeWorkerPool::WorkerThread, this);
+		}
+	}
+	catch (const std::system_error &e)
+	{
+		logte("Failed to start transcode worker thread (%u/%u)", static_cast<uint32_t>(_threads.size()), thread_count);
+
+		if (_threads.empty())
+		{
+			_stop_thread_flag = true;
+			return false;
+		}
+	}
+
+	logti("Transcode worker pool has started with %u threads", static_cast<uint32_t>(_threads.size()));
+
+	return true;
+}
+
+bool TranscodeWorkerPool::Stop()
+{
+	std::lock_guard<std::mutex> lock(_start_guard);
+
+	if (_threads.empty())
+	{
+		return true;
+	}
+
+	std::deque<std::shared_ptr<TranscodeWorkerTask>> canceled_tasks;
+
+	{
+		std::lock_guard<std::mutex> queue_lock(_queue_guard);
+		_stop_thread_flag = true;
+		canceled_tasks.swap(_run_queue);
+	}
+
+	_queue_event.notify_all();
+
+	// Let the tasks know that they are no longer scheduled, so that they can be scheduled again after a restart
+	for (auto &task : canceled_tasks)
+	{
+		task->OnCanceled();
+	}
+
+	for (auto &thread : _threads)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+
+	_threads.clear();
+
+	return true;
+}
+
+uint32_t TranscodeWorkerPool::GetThreadCount()
+{
+	std::lock_guard<std::mutex> lock(_start_guard);
+
+	return static_cast<uint32_t>(_threads.size());
+}
+
+bool TranscodeWorkerPool::Schedule(const std::shared_ptr<TranscodeWorkerTask> &task)
+{
+	if (_stop_thread_flag)
+	{
+		// Start the pool lazily with the default thread count
+		Start();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_queue_guard);
+
+		if (_stop_thread_flag)
+		{
+			return false;
+		}
+
+		_run_queue.push_back(task);
+	}
+
+	_queue_event.notify_one();
+
+	return true;
+}
+
+void TranscodeWorkerPool::WorkerThread()
+{
+	while (true)
+	{
+		std::unique_lock<std::mutex> lock(_queue_guard);
+
+		_queue_event.wait(lock, [this]() -> bool {
+			return _stop_thread_flag || (_run_queue.empty() == false);
+		});
+
+		if (_stop_thread_flag)
+		{
+			break;
+		}
+
+		auto task = std::move(_run_queue.front());
+		_run_queue.pop_front();
+
+		lock.unlock();
+
+		task->Run();
+	}
+}
@@ -0,0 +1,65 @@
+//==============================================================================
+//
+//  TranscodeWorkerPool
+//
+//  Copyright (c) 2026 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <vector>
+
+// A unit of work that can be scheduled onto TranscodeWorkerPool (See TranscodeStage)
+class TranscodeWorkerTask
+{
+public:
+	virtual ~TranscodeWorkerTask() = default;
+
+	virtual void Run() = 0;
+
+	// Called instead of Run() if the task is removed from the run queue because the pool stops
+	virtual void OnCanceled()
+	{
+	}
+};
+
+// Process-wide thread pool shared by the decoders, filters and encoders of all transcode streams.
+// Unlike the publisher's pool, tasks are not pinned: any idle thread takes the next task,
+// because a single encoder stage may keep a whole core busy.
+class TranscodeWorkerPool : public ov::Singleton<TranscodeWorkerPool>
+{
+public:
+	friend class ov::Singleton<TranscodeWorkerPool>;
+
+	~TranscodeWorkerPool() override;
+
+	// thread_count == 0 means the number of hardware threads
+	bool Start(uint32_t thread_count = 0);
+	bool Stop();
+
+	uint32_t GetThreadCount();
+
+	// Returns false if the task is not queued because the pool is stopping
+	bool Schedule(const std::shared_ptr<TranscodeWorkerTask> &task);
+
+protected:
+	TranscodeWorkerPool() = default;
+
+private:
+	void WorkerThread();
+
+	std::mutex _start_guard;
+	std::vector<std::thread> _threads;
+
+	std::mutex _queue_guard;
+	std::condition_variable _queue_event;
+	std::deque<std::shared_ptr<TranscodeWorkerTask>> _run_queue;
+
+	std::atomic<bool> _stop_thread_flag{true};
+};
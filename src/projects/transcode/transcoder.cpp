@@ -13,6 +13,7 @@
 #include <unistd.h>
 
 #include "transcoder.h"
+#include "transcode_worker_pool.h"
 #include "config/config_manager.h"
 
 #define OV_LOG_TAG "Transcoder"
@@ -35,12 +36,21 @@ Transcoder::Transcoder(std::shared_ptr<MediaRouteInterface> router)
 
 bool Transcoder::Start()
 {
+	// Decoders, filters and encoders of all streams share this pool
+	if (TranscodeWorkerPool::Instance()->Start() == false)
+	{
+		logte("Could not start the transcode worker pool");
+		return false;
+	}
+
 	logti("Transcoder has been started.");
 	return true;
 }
 
 bool Transcoder::Stop()
 {
+	TranscodeWorkerPool::Instance()->Stop();
+
 	logti("Transcoder has been stopped.");
 	return true;
 }